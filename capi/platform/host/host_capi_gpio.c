@@ -0,0 +1,579 @@
+/*
+ * Copyright (c) 2026 Analog Devices, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * @brief Host simulated GPIO port
+ */
+
+#include <capi_alloc.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <string.h>
+#include <capi_gpio.h>
+#include <host_capi_gpio_priv.h>
+#include <host_capi_irq.h>
+
+#define GPIO_HOST_MAX_PINS	64U
+
+static int capi_gpio_host_port_init(struct capi_gpio_port_handle **handle,
+				    const struct capi_gpio_port_config *config);
+static int capi_gpio_host_port_deinit(struct capi_gpio_port_handle **handle);
+static int capi_gpio_host_port_set_direction(struct capi_gpio_port_handle
+		*handle, uint64_t direction_bitmask);
+static int capi_gpio_host_port_get_direction(struct capi_gpio_port_handle
+		*handle, uint64_t *direction_bitmask);
+static int capi_gpio_host_port_set_value(struct capi_gpio_port_handle *handle,
+		uint64_t value_bitmask);
+static int capi_gpio_host_port_get_value(struct capi_gpio_port_handle *handle,
+		uint64_t *value_bitmask);
+static int capi_gpio_host_port_set_raw_value(struct capi_gpio_port_handle
+		*handle, uint64_t value_bitmask);
+static int capi_gpio_host_port_get_raw_value(struct capi_gpio_port_handle
+		*handle, uint64_t *value_bitmask);
+static int capi_gpio_host_port_toggle(struct capi_gpio_port_handle *handle,
+				      uint64_t pins_bitmask);
+static int capi_gpio_host_pin_set_direction(struct capi_gpio_pin *pin,
+		uint8_t direction);
+static int capi_gpio_host_pin_get_direction(struct capi_gpio_pin *pin,
+		uint8_t *direction);
+static int capi_gpio_host_pin_set_value(struct capi_gpio_pin *pin,
+					uint8_t value);
+static int capi_gpio_host_pin_get_value(struct capi_gpio_pin *pin,
+					uint8_t *value);
+static int capi_gpio_host_pin_set_raw_value(struct capi_gpio_pin *pin,
+		uint8_t value);
+static int capi_gpio_host_pin_get_raw_value(struct capi_gpio_pin *pin,
+		uint8_t *value);
+static int capi_gpio_host_pin_toggle(struct capi_gpio_pin *pin);
+
+const struct capi_gpio_ops capi_gpio_host_ops = {
+	.port_init = capi_gpio_host_port_init,
+	.port_deinit = capi_gpio_host_port_deinit,
+	.port_set_direction = capi_gpio_host_port_set_direction,
+	.port_get_direction = capi_gpio_host_port_get_direction,
+	.port_set_value = capi_gpio_host_port_set_value,
+	.port_get_value = capi_gpio_host_port_get_value,
+	.port_set_raw_value = capi_gpio_host_port_set_raw_value,
+	.port_get_raw_value = capi_gpio_host_port_get_raw_value,
+	.port_toggle = capi_gpio_host_port_toggle,
+	.pin_set_direction = capi_gpio_host_pin_set_direction,
+	.pin_get_direction = capi_gpio_host_pin_get_direction,
+	.pin_set_value = capi_gpio_host_pin_set_value,
+	.pin_get_value = capi_gpio_host_pin_get_value,
+	.pin_set_raw_value = capi_gpio_host_pin_set_raw_value,
+	.pin_get_raw_value = capi_gpio_host_pin_get_raw_value,
+	.pin_toggle = capi_gpio_host_pin_toggle,
+};
+
+static uint64_t gpio_pin_mask(uint8_t num_pins)
+{
+	if (num_pins >= GPIO_HOST_MAX_PINS)
+		return UINT64_MAX;
+
+	return (1ULL << num_pins) - 1;
+}
+
+static struct capi_gpio_host_port_handle *gpio_host_priv(
+	const struct capi_gpio_port_handle *handle)
+{
+	struct capi_gpio_host_port_handle *ph;
+
+	if (handle == NULL)
+		return NULL;
+
+	ph = handle->priv;
+	if (ph == NULL || !ph->initialized)
+		return NULL;
+
+	return ph;
+}
+
+static struct capi_gpio_host_port_handle *gpio_host_pin_priv(
+	const struct capi_gpio_pin *pin)
+{
+	struct capi_gpio_host_port_handle *ph;
+
+	if (pin == NULL)
+		return NULL;
+
+	ph = gpio_host_priv(pin->port_handle);
+	if (ph == NULL || pin->number >= ph->num_pins)
+		return NULL;
+
+	return ph;
+}
+
+static bool gpio_pin_active_low(const struct capi_gpio_host_port_handle *ph,
+				const struct capi_gpio_pin *pin)
+{
+	uint32_t flags = pin->flags;
+
+	if (ph->pin_flags != NULL)
+		flags |= ph->pin_flags[pin->number];
+
+	return flags & CAPI_GPIO_ACTIVE_LOW;
+}
+
+/**
+ * @brief Physical levels of all pins.
+ */
+static uint64_t gpio_host_levels(const struct capi_gpio_host_port_handle *ph)
+{
+	return (ph->output & ~ph->direction) | (ph->input & ph->direction);
+}
+
+/**
+ * @brief Apply a new direction and output latch, and report the output
+ *        pins whose level changed to the listener.
+ */
+static void gpio_host_update(struct capi_gpio_host_port_handle *ph,
+			     uint64_t direction, uint64_t output)
+{
+	uint64_t mask = gpio_pin_mask(ph->num_pins);
+	uint64_t before = gpio_host_levels(ph);
+	uint64_t changed;
+
+	ph->direction = direction & mask;
+	ph->output = output & mask;
+	changed = (before ^ gpio_host_levels(ph)) & ~ph->direction & mask;
+
+	for (uint32_t i = 0; changed && ph->listener != NULL; i++, changed >>= 1)
+		if (changed & 1ULL)
+			ph->listener(ph->listener_arg, i, (ph->output >> i) & 1ULL);
+}
+
+/**
+ * @brief Initialize a host GPIO port.
+ *
+ * @param[in,out] handle GPIO port handle pointer.
+ * @param[in] config Port configuration, num_pins 1..64.
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_gpio_host_port_init(struct capi_gpio_port_handle **handle,
+				    const struct capi_gpio_port_config *config)
+{
+	if (handle == NULL || config == NULL)
+		return -EINVAL;
+	if (config->num_pins == 0 || config->num_pins > GPIO_HOST_MAX_PINS)
+		return -EINVAL;
+	if (*handle != NULL &&
+	    ((*handle)->ops != NULL ||
+	     ((*handle)->priv != NULL &&
+	      ((struct capi_gpio_host_port_handle *)(*handle)->priv)->initialized)))
+		return -EBUSY;
+
+	bool alloc = (*handle == NULL);
+	struct capi_gpio_port_handle *h = *handle;
+	struct capi_gpio_host_port_handle *ph;
+
+	if (alloc) {
+		h = capi_calloc(1, sizeof(*h));
+		if (h == NULL)
+			return -ENOMEM;
+
+		ph = capi_malloc(sizeof(*ph));
+		if (ph == NULL) {
+			capi_free(h);
+			return -ENOMEM;
+		}
+		h->priv = ph;
+	} else {
+		ph = h->priv;
+		if (ph == NULL)
+			return -EINVAL;
+	}
+
+	memset(ph, 0, sizeof(*ph));
+	ph->pin_flags = capi_calloc(config->num_pins, sizeof(uint32_t));
+	if (ph->pin_flags == NULL) {
+		if (alloc) {
+			capi_free(ph);
+			capi_free(h);
+		}
+		return -ENOMEM;
+	}
+
+	if (config->flags != NULL)
+		memcpy(ph->pin_flags, config->flags, config->num_pins * sizeof(uint32_t));
+	for (uint8_t i = 0; i < config->num_pins; i++)
+		if (ph->pin_flags[i] & CAPI_GPIO_ACTIVE_LOW)
+			ph->active_low_mask |= 1ULL << i;
+
+	if (config->extra != NULL)
+		ph->cfg = *(const struct capi_gpio_host_config *)config->extra;
+	ph->num_pins = config->num_pins;
+	ph->direction = gpio_pin_mask(config->num_pins);
+	ph->initialized = true;
+
+	h->init_allocated = alloc;
+	h->ops = config->ops ? config->ops : &capi_gpio_host_ops;
+	*handle = h;
+
+	return 0;
+}
+
+/**
+ * @brief Deinitialize a host GPIO port.
+ *
+ * @param[in,out] handle GPIO port handle pointer, set to NULL if the
+ *                       driver owned it.
+ * @return 0 on success, -EINVAL if handle is NULL.
+ */
+static int capi_gpio_host_port_deinit(struct capi_gpio_port_handle **handle)
+{
+	if (handle == NULL || *handle == NULL)
+		return -EINVAL;
+
+	struct capi_gpio_port_handle *h = *handle;
+	struct capi_gpio_host_port_handle *ph = h->priv;
+	if (ph == NULL)
+		return -EINVAL;
+
+	capi_free(ph->pin_flags);
+	ph->pin_flags = NULL;
+	ph->initialized = false;
+
+	if (h->init_allocated) {
+		capi_free(ph);
+		capi_free(h);
+		*handle = NULL;
+	} else {
+		h->ops = NULL;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Set the port direction.
+ *
+ * @param[in] handle GPIO port handle.
+ * @param[in] direction_bitmask 1=input, 0=output per bit.
+ * @return 0 on success, -EINVAL.
+ */
+static int capi_gpio_host_port_set_direction(struct capi_gpio_port_handle
+		*handle, uint64_t direction_bitmask)
+{
+	struct capi_gpio_host_port_handle *ph = gpio_host_priv(handle);
+
+	if (ph == NULL)
+		return -EINVAL;
+
+	gpio_host_update(ph, direction_bitmask, ph->output);
+
+	return 0;
+}
+
+/**
+ * @brief Get the port direction.
+ *
+ * @param[in] handle GPIO port handle.
+ * @param[out] direction_bitmask 1=input, 0=output per bit.
+ * @return 0 on success, -EINVAL.
+ */
+static int capi_gpio_host_port_get_direction(struct capi_gpio_port_handle
+		*handle, uint64_t *direction_bitmask)
+{
+	struct capi_gpio_host_port_handle *ph = gpio_host_priv(handle);
+
+	if (ph == NULL || direction_bitmask == NULL)
+		return -EINVAL;
+
+	*direction_bitmask = ph->direction;
+
+	return 0;
+}
+
+/**
+ * @brief Set the port output latch (no ACTIVE_LOW inversion). Input pins
+ *        keep their latch.
+ *
+ * @param[in] handle GPIO port handle.
+ * @param[in] value_bitmask Raw value per bit.
+ * @return 0 on success, -EINVAL.
+ */
+static int capi_gpio_host_port_set_raw_value(struct capi_gpio_port_handle
+		*handle, uint64_t value_bitmask)
+{
+	struct capi_gpio_host_port_handle *ph = gpio_host_priv(handle);
+
+	if (ph == NULL)
+		return -EINVAL;
+
+	gpio_host_update(ph, ph->direction,
+			 (ph->output & ph->direction) |
+			 (value_bitmask & ~ph->direction));
+
+	return 0;
+}
+
+/**
+ * @brief Get the port levels (no ACTIVE_LOW inversion).
+ *
+ * @param[in] handle GPIO port handle.
+ * @param[out] value_bitmask Raw value per bit.
+ * @return 0 on success, -EINVAL.
+ */
+static int capi_gpio_host_port_get_raw_value(struct capi_gpio_port_handle
+		*handle, uint64_t *value_bitmask)
+{
+	struct capi_gpio_host_port_handle *ph = gpio_host_priv(handle);
+
+	if (ph == NULL || value_bitmask == NULL)
+		return -EINVAL;
+
+	*value_bitmask = gpio_host_levels(ph);
+
+	return 0;
+}
+
+/**
+ * @brief Set the port output value (applies ACTIVE_LOW inversion).
+ *
+ * @param[in] handle GPIO port handle.
+ * @param[in] value_bitmask Logical value per bit.
+ * @return 0 on success, -EINVAL.
+ */
+static int capi_gpio_host_port_set_value(struct capi_gpio_port_handle *handle,
+		uint64_t value_bitmask)
+{
+	struct capi_gpio_host_port_handle *ph = gpio_host_priv(handle);
+
+	if (ph == NULL)
+		return -EINVAL;
+
+	return capi_gpio_host_port_set_raw_value(handle,
+			value_bitmask ^ ph->active_low_mask);
+}
+
+/**
+ * @brief Get the port value (applies ACTIVE_LOW inversion).
+ *
+ * @param[in] handle GPIO port handle.
+ * @param[out] value_bitmask Logical value per bit.
+ * @return 0 on success, -EINVAL.
+ */
+static int capi_gpio_host_port_get_value(struct capi_gpio_port_handle *handle,
+		uint64_t *value_bitmask)
+{
+	struct capi_gpio_host_port_handle *ph = gpio_host_priv(handle);
+
+	if (ph == NULL || value_bitmask == NULL)
+		return -EINVAL;
+
+	*value_bitmask = (gpio_host_levels(ph) ^ ph->active_low_mask) &
+			 gpio_pin_mask(ph->num_pins);
+
+	return 0;
+}
+
+/**
+ * @brief Toggle output pins.
+ *
+ * @param[in] handle GPIO port handle.
+ * @param[in] pins_bitmask Pins to toggle; input pins are skipped.
+ * @return 0 on success, -EINVAL.
+ */
+static int capi_gpio_host_port_toggle(struct capi_gpio_port_handle *handle,
+				      uint64_t pins_bitmask)
+{
+	struct capi_gpio_host_port_handle *ph = gpio_host_priv(handle);
+
+	if (ph == NULL)
+		return -EINVAL;
+
+	gpio_host_update(ph, ph->direction,
+			 ph->output ^ (pins_bitmask & ~ph->direction));
+
+	return 0;
+}
+
+/**
+ * @brief Set the direction of a single pin.
+ *
+ * @return 0 on success, -EINVAL.
+ */
+static int capi_gpio_host_pin_set_direction(struct capi_gpio_pin *pin,
+		uint8_t direction)
+{
+	struct capi_gpio_host_port_handle *ph = gpio_host_pin_priv(pin);
+	uint64_t bit;
+
+	if (ph == NULL)
+		return -EINVAL;
+	if (direction != CAPI_GPIO_OUTPUT && direction != CAPI_GPIO_INPUT)
+		return -EINVAL;
+
+	bit = 1ULL << pin->number;
+	gpio_host_update(ph, direction == CAPI_GPIO_INPUT ?
+			 ph->direction | bit : ph->direction & ~bit, ph->output);
+
+	return 0;
+}
+
+/**
+ * @brief Get the direction of a single pin.
+ *
+ * @return 0 on success, -EINVAL.
+ */
+static int capi_gpio_host_pin_get_direction(struct capi_gpio_pin *pin,
+		uint8_t *direction)
+{
+	struct capi_gpio_host_port_handle *ph = gpio_host_pin_priv(pin);
+
+	if (ph == NULL || direction == NULL)
+		return -EINVAL;
+
+	*direction = (ph->direction >> pin->number) & 1ULL ?
+		     CAPI_GPIO_INPUT : CAPI_GPIO_OUTPUT;
+
+	return 0;
+}
+
+/**
+ * @brief Set the output latch of a single pin (no ACTIVE_LOW inversion).
+ *
+ * @return 0 on success, -EINVAL.
+ */
+static int capi_gpio_host_pin_set_raw_value(struct capi_gpio_pin *pin,
+		uint8_t value)
+{
+	struct capi_gpio_host_port_handle *ph = gpio_host_pin_priv(pin);
+	uint64_t bit;
+
+	if (ph == NULL)
+		return -EINVAL;
+
+	bit = 1ULL << pin->number;
+	gpio_host_update(ph, ph->direction,
+			 value ? ph->output | bit : ph->output & ~bit);
+
+	return 0;
+}
+
+/**
+ * @brief Get the level of a single pin (no ACTIVE_LOW inversion).
+ *
+ * @return 0 on success, -EINVAL.
+ */
+static int capi_gpio_host_pin_get_raw_value(struct capi_gpio_pin *pin,
+		uint8_t *value)
+{
+	struct capi_gpio_host_port_handle *ph = gpio_host_pin_priv(pin);
+
+	if (ph == NULL || value == NULL)
+		return -EINVAL;
+
+	*value = (gpio_host_levels(ph) >> pin->number) & 1ULL;
+
+	return 0;
+}
+
+/**
+ * @brief Set the output value of a single pin (applies ACTIVE_LOW
+ *        inversion).
+ *
+ * @return 0 on success, -EINVAL.
+ */
+static int capi_gpio_host_pin_set_value(struct capi_gpio_pin *pin,
+					uint8_t value)
+{
+	struct capi_gpio_host_port_handle *ph = gpio_host_pin_priv(pin);
+
+	if (ph == NULL)
+		return -EINVAL;
+
+	return capi_gpio_host_pin_set_raw_value(pin,
+			(value ? 1 : 0) ^ gpio_pin_active_low(ph, pin));
+}
+
+/**
+ * @brief Get the value of a single pin (applies ACTIVE_LOW inversion).
+ *
+ * @return 0 on success, -EINVAL.
+ */
+static int capi_gpio_host_pin_get_value(struct capi_gpio_pin *pin,
+					uint8_t *value)
+{
+	struct capi_gpio_host_port_handle *ph = gpio_host_pin_priv(pin);
+	int ret;
+
+	if (ph == NULL || value == NULL)
+		return -EINVAL;
+
+	ret = capi_gpio_host_pin_get_raw_value(pin, value);
+	if (ret)
+		return ret;
+
+	*value ^= gpio_pin_active_low(ph, pin);
+
+	return 0;
+}
+
+/**
+ * @brief Toggle a single output pin.
+ *
+ * @return 0 on success, -EINVAL.
+ */
+static int capi_gpio_host_pin_toggle(struct capi_gpio_pin *pin)
+{
+	struct capi_gpio_host_port_handle *ph = gpio_host_pin_priv(pin);
+
+	if (ph == NULL)
+		return -EINVAL;
+
+	return capi_gpio_host_port_toggle(pin->port_handle, 1ULL << pin->number);
+}
+
+int capi_gpio_host_set_listener(struct capi_gpio_port_handle *handle,
+				capi_gpio_host_listener listener, void *arg)
+{
+	struct capi_gpio_host_port_handle *ph = gpio_host_priv(handle);
+
+	if (ph == NULL)
+		return -EINVAL;
+
+	ph->listener = listener;
+	ph->listener_arg = arg;
+
+	return 0;
+}
+
+int capi_gpio_host_drive(struct capi_gpio_port_handle *handle, uint32_t pin,
+			 uint8_t level)
+{
+	struct capi_gpio_host_port_handle *ph = gpio_host_priv(handle);
+	uint64_t bit;
+
+	if (ph == NULL || pin >= ph->num_pins)
+		return -EINVAL;
+
+	bit = 1ULL << pin;
+	if (level)
+		ph->input |= bit;
+	else
+		ph->input &= ~bit;
+
+	if (ph->cfg.use_irq && (ph->direction & bit))
+		return capi_irq_host_set_line(ph->cfg.irq_base + pin, level != 0);
+
+	return 0;
+}
+
+int capi_gpio_host_get_level(struct capi_gpio_port_handle *handle,
+			     uint32_t pin, uint8_t *level)
+{
+	struct capi_gpio_host_port_handle *ph = gpio_host_priv(handle);
+
+	if (ph == NULL || level == NULL || pin >= ph->num_pins)
+		return -EINVAL;
+
+	*level = (gpio_host_levels(ph) >> pin) & 1ULL;
+
+	return 0;
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2026 Analog Devices, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * @brief Host platform simulated GPIO port for CAPI
+ *
+ * Backend (select via config.ops):
+ *   capi_gpio_host_ops  - simulated GPIO port of up to 64 pins
+ *
+ * Pins start as inputs, low. Output levels are reported to an optional
+ * listener so device models can follow reset, enable or chip select pins;
+ * models drive input pins with capi_gpio_host_drive(), which optionally
+ * raises host IRQ line irq_base + pin through the host IRQ controller.
+ * Levels here are physical levels; CAPI_GPIO_ACTIVE_LOW inversion applies
+ * to the logical pin and port value calls, as on the hardware ports.
+ * GPIO accesses do not advance the virtual clock.
+ */
+
+#ifndef _HOST_CAPI_GPIO_H_
+#define _HOST_CAPI_GPIO_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <capi_gpio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct capi_gpio_host_config
+ * @brief Optional host port configuration, passed via config->extra.
+ */
+struct capi_gpio_host_config {
+	/** Forward input pin levels to host IRQ lines */
+	bool use_irq;
+	/** Host IRQ line of pin 0, only valid if use_irq is true */
+	uint32_t irq_base;
+};
+
+/**
+ * @brief Output level listener.
+ * @param arg - Listener argument.
+ * @param pin - Pin number within the port.
+ * @param level - New physical level.
+ */
+typedef void (*capi_gpio_host_listener)(void *arg, uint32_t pin,
+					uint8_t level);
+
+/**
+ * @brief Register the listener called when an output pin changes level.
+ * @return 0 on success, negative errno on failure.
+ */
+int capi_gpio_host_set_listener(struct capi_gpio_port_handle *handle,
+				capi_gpio_host_listener listener, void *arg);
+
+/**
+ * @brief Drive the physical level of a pin from a device model. Visible
+ *        to the driver while the pin is an input.
+ * @return 0 on success, negative errno on failure.
+ */
+int capi_gpio_host_drive(struct capi_gpio_port_handle *handle, uint32_t pin,
+			 uint8_t level);
+
+/**
+ * @brief Get the physical level of a pin: the output latch for outputs,
+ *        the driven level for inputs.
+ * @return 0 on success, negative errno on failure.
+ */
+int capi_gpio_host_get_level(struct capi_gpio_port_handle *handle,
+			     uint32_t pin, uint8_t *level);
+
+/**
+ * @brief Host GPIO operations table.
+ */
+extern const struct capi_gpio_ops capi_gpio_host_ops;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _HOST_CAPI_GPIO_H_ */
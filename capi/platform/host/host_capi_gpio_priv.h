@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2026 Analog Devices, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * @brief Host platform GPIO private driver contract.
+ */
+
+#ifndef _HOST_CAPI_GPIO_PRIV_H_
+#define _HOST_CAPI_GPIO_PRIV_H_
+
+#include <host_capi_gpio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct capi_gpio_host_port_handle
+ * @brief Host GPIO private port state.
+ */
+struct capi_gpio_host_port_handle {
+	/** IRQ configuration */
+	struct capi_gpio_host_config cfg;
+	/** Number of pins in this port */
+	uint8_t num_pins;
+	/** True once init completed */
+	bool initialized;
+	/** Direction bitmask (CAPI: 0=output, 1=input) */
+	uint64_t direction;
+	/** Output latch, physical levels */
+	uint64_t output;
+	/** Levels driven by the device models, physical levels */
+	uint64_t input;
+	/** Per-pin flags array (malloc'd to num_pins size) */
+	uint32_t *pin_flags;
+	/** Cached active-low mask (computed once at init from pin_flags) */
+	uint64_t active_low_mask;
+	/** Output level listener */
+	capi_gpio_host_listener listener;
+	/** Listener argument */
+	void *listener_arg;
+};
+
+/**
+ * @brief Declare a stack-allocated host GPIO port handle.
+ *
+ * Declares `name` (struct capi_gpio_port_handle) with embedded private
+ * state. Pass &name to capi_gpio_port_init().
+ */
+#define CAPI_GPIO_PORT_HANDLE_HOST_DEFINE(name)                        \
+	struct capi_gpio_port_handle name = {                              \
+		.ops = NULL,                                                   \
+		.init_allocated = false,                                       \
+		.priv = &(struct capi_gpio_host_port_handle){0}                \
+	}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _HOST_CAPI_GPIO_PRIV_H_ */
@@ -0,0 +1,648 @@
+/*
+ * Copyright (c) 2026 Analog Devices, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * @brief Host simulated I2C controller (initiator mode only)
+ *
+ * Data is exchanged with the device model when a transfer starts; async
+ * transfers complete (callback, or the configured host IRQ line) once the
+ * virtual clock reaches the end of the modeled bus time. An async transfer
+ * that is NAKed still returns 0 and completes with CAPI_I2C_NAKD, as a
+ * controller only detects the NAK on the bus.
+ */
+
+#include <capi_alloc.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <string.h>
+#include <capi_i2c.h>
+#include <host_capi_i2c_priv.h>
+#include <host_capi_irq.h>
+
+#define I2C_HOST_7BIT_MAX_ADDR		0x7FU
+#define I2C_HOST_10BIT_MAX_ADDR		0x3FFU
+/* SCL periods per byte: 8 data bits and the acknowledge. */
+#define I2C_HOST_BYTE_BITS		9U
+/* Clocks sent by capi_i2c_recover_bus() to release a stuck target. */
+#define I2C_HOST_RECOVERY_CLOCKS	9U
+
+static int capi_i2c_host_init(struct capi_i2c_controller_handle **handle,
+			      const struct capi_i2c_config *config);
+static int capi_i2c_host_deinit(struct capi_i2c_controller_handle *handle);
+static int capi_i2c_host_transmit(struct capi_i2c_device *device,
+				  struct capi_i2c_transfer *transfer);
+static int capi_i2c_host_receive(struct capi_i2c_device *device,
+				 struct capi_i2c_transfer *transfer);
+static int capi_i2c_host_register_callback(struct capi_i2c_controller_handle
+		*handle,
+		capi_i2c_callback const callback, void *const callback_arg);
+static int capi_i2c_host_configure_bus_speed(struct capi_i2c_controller_handle
+		*handle,
+		enum capi_i2c_speed speed, uint8_t duty_cycle);
+static int capi_i2c_host_transmit_async(struct capi_i2c_device *device,
+					struct capi_i2c_transfer *transfer);
+static int capi_i2c_host_receive_async(struct capi_i2c_device *device,
+				       struct capi_i2c_transfer *transfer);
+static int capi_i2c_host_recover_bus(struct capi_i2c_controller_handle *handle);
+static int capi_i2c_host_register_target(struct capi_i2c_controller_handle
+		*handle, uint16_t addr);
+static int capi_i2c_host_unregister_target(struct capi_i2c_controller_handle
+		*handle);
+static void capi_i2c_host_isr(void *handle);
+
+const struct capi_i2c_ops capi_i2c_host_ops = {
+	.init = capi_i2c_host_init,
+	.deinit = capi_i2c_host_deinit,
+	.transmit = capi_i2c_host_transmit,
+	.receive = capi_i2c_host_receive,
+	.register_callback = capi_i2c_host_register_callback,
+	.configure_bus_speed = capi_i2c_host_configure_bus_speed,
+	.transmit_async = capi_i2c_host_transmit_async,
+	.receive_async = capi_i2c_host_receive_async,
+	.recover_bus = capi_i2c_host_recover_bus,
+	.register_target = capi_i2c_host_register_target,
+	.unregister_target = capi_i2c_host_unregister_target,
+	.isr = capi_i2c_host_isr,
+};
+
+static const uint32_t i2c_host_speed_hz[] = {
+	[CAPI_I2C_SPEED_STANDARD] = 100000,
+	[CAPI_I2C_SPEED_FAST] = 400000,
+	[CAPI_I2C_SPEED_FAST_PLUS] = 1000000,
+	[CAPI_I2C_SPEED_HIGH] = 3400000,
+	[CAPI_I2C_SPEED_ULTRA] = 5000000,
+};
+
+/**
+ * @struct i2c_host_cost
+ * @brief Bus time and bytes accumulated while running a transfer.
+ */
+struct i2c_host_cost {
+	uint64_t bits;
+	uint64_t stretch_ns;
+	uint32_t bytes;
+};
+
+static struct capi_i2c_host_handle *i2c_host_priv(
+	const struct capi_i2c_device *device)
+{
+	struct capi_i2c_host_handle *ih;
+
+	if (device == NULL || device->controller == NULL)
+		return NULL;
+
+	ih = device->controller->priv;
+	if (ih == NULL || !ih->initialized)
+		return NULL;
+
+	return ih;
+}
+
+static const struct capi_i2c_host_target *i2c_host_lookup(
+	const struct capi_i2c_host_handle *ih, uint16_t address)
+{
+	for (uint32_t i = 0; i < CAPI_I2C_HOST_MAX_TARGETS; i++)
+		if (ih->slots[i].target != NULL && ih->slots[i].address == address)
+			return ih->slots[i].target;
+
+	return NULL;
+}
+
+static uint32_t i2c_host_scl_hz(const struct capi_i2c_host_handle *ih,
+				enum capi_i2c_speed speed)
+{
+	uint32_t hz = i2c_host_speed_hz[speed];
+
+	if (ih->scl_hz && ih->scl_hz < hz)
+		hz = ih->scl_hz;
+
+	return hz;
+}
+
+static int i2c_host_start(const struct capi_i2c_host_target *target,
+			  bool b10addr, bool read, struct i2c_host_cost *cost)
+{
+	uint32_t addr_bytes = b10addr ? 2 : 1;
+
+	cost->bits += 1 + I2C_HOST_BYTE_BITS * addr_bytes;
+	cost->bytes += addr_bytes;
+
+	if (target == NULL)
+		return -EIO;
+	if (target->start != NULL && target->start(target->ctx, read) < 0)
+		return -EIO;
+
+	return 0;
+}
+
+static int i2c_host_data(const struct capi_i2c_host_target *target,
+			 uint8_t *buf, uint32_t len, bool read,
+			 struct i2c_host_cost *cost)
+{
+	int ret;
+
+	if (len == 0)
+		return 0;
+
+	if (read)
+		ret = target->read ? target->read(target->ctx, buf, len) : -EIO;
+	else
+		ret = target->write ? target->write(target->ctx, buf, len) : -EIO;
+
+	/* A NAKed write or a failed read still clocked the bytes. */
+	cost->bits += (uint64_t)I2C_HOST_BYTE_BITS * len;
+	cost->bytes += len;
+	if (ret < 0)
+		return -EIO;
+
+	cost->stretch_ns += (uint64_t)ret;
+
+	return 0;
+}
+
+static void i2c_host_stop(struct capi_i2c_host_handle *ih,
+			  const struct capi_i2c_host_target *target,
+			  struct i2c_host_cost *cost)
+{
+	cost->bits += 1;
+	if (target != NULL && target->stop != NULL)
+		target->stop(target->ctx);
+	ih->held = NULL;
+}
+
+/**
+ * @brief Run one transfer against the device model.
+ *
+ * transmit: S addr+W [sub_address] buf [P]
+ * receive:  [S addr+W sub_address (Sr | P S)] addr+R buf [P]
+ *
+ * A transfer following one that ended without STOP starts with a repeated
+ * START, which costs the same as a START.
+ *
+ * @param ns - Modeled bus time, set whenever the bus was used.
+ * @return 0 on success, negative errno on failure.
+ */
+static int i2c_host_run(struct capi_i2c_device *device,
+			struct capi_i2c_transfer *transfer, bool read,
+			uint32_t *bytes, uint64_t *ns)
+{
+	struct capi_i2c_host_handle *ih = device->controller->priv;
+	const struct capi_i2c_host_target *target;
+	struct i2c_host_cost cost = { 0 };
+	bool has_sub;
+	uint16_t addr;
+	int ret = 0;
+
+	*bytes = 0;
+	*ns = 0;
+
+	if ((uint32_t)device->speed > CAPI_I2C_SPEED_ULTRA)
+		return -EINVAL;
+	if (transfer->len > 0 && transfer->buf == NULL)
+		return -EINVAL;
+
+	addr = transfer->target_addr ? transfer->target_addr : device->address;
+	if (addr > (device->b10addr ? I2C_HOST_10BIT_MAX_ADDR :
+		    I2C_HOST_7BIT_MAX_ADDR))
+		return -EINVAL;
+
+	target = i2c_host_lookup(ih, addr);
+
+	/* A repeated START to another address ends the held transaction. */
+	if (ih->held != NULL && ih->held != target && ih->held->stop != NULL)
+		ih->held->stop(ih->held->ctx);
+	ih->held = NULL;
+
+	has_sub = transfer->sub_address != NULL && transfer->sub_address_len > 0;
+	if (!read || has_sub) {
+		ret = i2c_host_start(target, device->b10addr, false, &cost);
+		if (!ret && has_sub)
+			ret = i2c_host_data(target, transfer->sub_address,
+					    transfer->sub_address_len, false, &cost);
+		if (!ret && !read)
+			ret = i2c_host_data(target, transfer->buf, transfer->len,
+					    false, &cost);
+		if (!ret && read && !transfer->repeated_start)
+			i2c_host_stop(ih, target, &cost);
+	}
+
+	if (!ret && read) {
+		ret = i2c_host_start(target, device->b10addr, true, &cost);
+		if (!ret)
+			ret = i2c_host_data(target, transfer->buf, transfer->len, true,
+					    &cost);
+	}
+
+	if (ret || !transfer->no_stop)
+		i2c_host_stop(ih, target, &cost);
+	else
+		ih->held = target;
+
+	*bytes = cost.bytes;
+	*ns = capi_host_cycles_to_ns(cost.bits,
+				     i2c_host_scl_hz(ih, device->speed)) + cost.stretch_ns;
+
+	return ret;
+}
+
+static int i2c_host_sync(struct capi_i2c_device *device,
+			 struct capi_i2c_transfer *transfer, bool read)
+{
+	struct capi_i2c_host_handle *ih = i2c_host_priv(device);
+	uint32_t bytes;
+	uint64_t ns;
+	int ret;
+
+	if (ih == NULL || transfer == NULL)
+		return -EINVAL;
+	if (ih->async_in_progress)
+		return -EBUSY;
+
+	capi_host_sim_enter();
+	ret = i2c_host_run(device, transfer, read, &bytes, &ns);
+	if (ns)
+		capi_host_bus_charge(&ih->stats, bytes, ns, ret == 0);
+	capi_host_sim_exit();
+
+	return ret;
+}
+
+static void i2c_host_complete(struct capi_i2c_host_handle *ih)
+{
+	if (!ih->async_in_progress)
+		return;
+
+	ih->async_in_progress = false;
+	if (ih->callback != NULL)
+		ih->callback(ih->async_status ? CAPI_I2C_NAKD : CAPI_I2C_XFR_DONE,
+			     ih->callback_arg, ih->async_status);
+}
+
+static void i2c_host_event_fire(struct capi_host_event *event)
+{
+	struct capi_i2c_controller_handle *h = event->arg;
+	struct capi_i2c_host_handle *ih = h->priv;
+
+	if (ih->cfg.use_irq)
+		(void)capi_irq_host_set_pending(ih->cfg.irq_id);
+	else
+		i2c_host_complete(ih);
+}
+
+static int i2c_host_async(struct capi_i2c_device *device,
+			  struct capi_i2c_transfer *transfer, bool read)
+{
+	struct capi_i2c_host_handle *ih = i2c_host_priv(device);
+	uint32_t bytes;
+	uint64_t ns;
+	int ret;
+
+	if (ih == NULL || transfer == NULL)
+		return -EINVAL;
+	if (ih->async_in_progress)
+		return -EBUSY;
+
+	capi_host_sim_enter();
+	ret = i2c_host_run(device, transfer, read, &bytes, &ns);
+	if (ns == 0) {
+		capi_host_sim_exit();
+		return ret;
+	}
+
+	capi_host_bus_account(&ih->stats, bytes, ns, ret == 0);
+	ih->async_in_progress = true;
+	ih->async_status = ret;
+	ih->event.fire = i2c_host_event_fire;
+	ih->event.arg = device->controller;
+	capi_host_sim_schedule(&ih->event, capi_host_sim_now() + ns);
+	capi_host_sim_exit();
+
+	return 0;
+}
+
+/**
+ * @brief Initialize the CAPI backend instance.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_i2c_host_init(struct capi_i2c_controller_handle **handle,
+			      const struct capi_i2c_config *config)
+{
+	if (handle == NULL || config == NULL)
+		return -EINVAL;
+	if (*handle != NULL &&
+	    ((*handle)->ops != NULL ||
+	     ((*handle)->priv != NULL &&
+	      ((struct capi_i2c_host_handle *)(*handle)->priv)->initialized)))
+		return -EBUSY;
+	if (!config->initiator || config->dma_handle != NULL)
+		return -ENOTSUP;
+
+	bool alloc = (*handle == NULL);
+	struct capi_i2c_controller_handle *h = *handle;
+	struct capi_i2c_host_handle *ih;
+	int ret;
+
+	if (alloc) {
+		h = capi_calloc(1, sizeof(*h));
+		if (h == NULL)
+			return -ENOMEM;
+
+		ih = capi_malloc(sizeof(*ih));
+		if (ih == NULL) {
+			capi_free(h);
+			return -ENOMEM;
+		}
+		h->priv = ih;
+	} else {
+		ih = h->priv;
+		if (ih == NULL)
+			return -EINVAL;
+	}
+
+	memset(ih, 0, sizeof(*ih));
+	if (config->extra != NULL)
+		ih->cfg = *(const struct capi_i2c_host_config *)config->extra;
+	ih->scl_hz = config->clk_freq_hz;
+	ih->stats.since_ns = capi_host_sim_now();
+
+	if (ih->cfg.use_irq) {
+		ret = capi_irq_connect(ih->cfg.irq_id, capi_i2c_host_isr, h);
+		if (ret == 0)
+			ret = capi_irq_enable(ih->cfg.irq_id);
+		if (ret) {
+			if (alloc) {
+				capi_free(ih);
+				capi_free(h);
+			}
+			return ret;
+		}
+	}
+
+	h->init_allocated = alloc;
+	h->ops = config->ops ? config->ops : &capi_i2c_host_ops;
+	ih->initialized = true;
+	*handle = h;
+
+	return 0;
+}
+
+/**
+ * @brief Deinitialize the CAPI backend instance. An in-flight async
+ *        transfer is dropped without callback.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_i2c_host_deinit(struct capi_i2c_controller_handle *handle)
+{
+	struct capi_i2c_host_handle *ih;
+
+	if (handle == NULL || handle->priv == NULL)
+		return -EINVAL;
+
+	ih = handle->priv;
+	capi_host_sim_cancel(&ih->event);
+	if (ih->cfg.use_irq)
+		(void)capi_irq_disable(ih->cfg.irq_id);
+	ih->initialized = false;
+
+	if (handle->init_allocated) {
+		capi_free(ih);
+		capi_free(handle);
+	} else {
+		handle->ops = NULL;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Perform a blocking write, optionally preceded by a sub-address.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_i2c_host_transmit(struct capi_i2c_device *device,
+				  struct capi_i2c_transfer *transfer)
+{
+	return i2c_host_sync(device, transfer, false);
+}
+
+/**
+ * @brief Perform a blocking read, optionally preceded by a sub-address
+ *        write.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_i2c_host_receive(struct capi_i2c_device *device,
+				 struct capi_i2c_transfer *transfer)
+{
+	return i2c_host_sync(device, transfer, true);
+}
+
+/**
+ * @brief Register the CAPI asynchronous callback.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_i2c_host_register_callback(struct capi_i2c_controller_handle
+		*handle,
+		capi_i2c_callback const callback, void *const callback_arg)
+{
+	if (handle == NULL || handle->priv == NULL)
+		return -EINVAL;
+
+	struct capi_i2c_host_handle *ih = handle->priv;
+	ih->callback = callback;
+	ih->callback_arg = callback_arg;
+
+	return 0;
+}
+
+/**
+ * @brief Limit the SCL rate of the controller. The duty cycle does not
+ *        change the modeled bit time.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_i2c_host_configure_bus_speed(struct capi_i2c_controller_handle
+		*handle,
+		enum capi_i2c_speed speed, uint8_t duty_cycle)
+{
+	(void)duty_cycle;
+
+	if (handle == NULL || handle->priv == NULL)
+		return -EINVAL;
+	if ((uint32_t)speed > CAPI_I2C_SPEED_ULTRA)
+		return -EINVAL;
+
+	((struct capi_i2c_host_handle *)handle->priv)->scl_hz =
+		i2c_host_speed_hz[speed];
+
+	return 0;
+}
+
+/**
+ * @brief Start a write completing after its bus time.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_i2c_host_transmit_async(struct capi_i2c_device *device,
+					struct capi_i2c_transfer *transfer)
+{
+	return i2c_host_async(device, transfer, false);
+}
+
+/**
+ * @brief Start a read completing after its bus time.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_i2c_host_receive_async(struct capi_i2c_device *device,
+				       struct capi_i2c_transfer *transfer)
+{
+	return i2c_host_async(device, transfer, true);
+}
+
+/**
+ * @brief Clock out a stuck target and issue a STOP. Releases a bus held by
+ *        a transfer without STOP.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_i2c_host_recover_bus(struct capi_i2c_controller_handle *handle)
+{
+	struct capi_i2c_host_handle *ih;
+	struct i2c_host_cost cost = {
+		.bits = I2C_HOST_RECOVERY_CLOCKS,
+	};
+	uint64_t ns;
+
+	if (handle == NULL || handle->priv == NULL)
+		return -EINVAL;
+
+	ih = handle->priv;
+	if (!ih->initialized)
+		return -EINVAL;
+	if (ih->async_in_progress)
+		return -EBUSY;
+
+	capi_host_sim_enter();
+	i2c_host_stop(ih, ih->held, &cost);
+	ns = capi_host_cycles_to_ns(cost.bits,
+				    i2c_host_scl_hz(ih, CAPI_I2C_SPEED_STANDARD));
+	ih->stats.busy_ns += ns;
+	capi_host_sim_advance(ns);
+	capi_host_sim_exit();
+
+	return 0;
+}
+
+/**
+ * @brief Target mode is not simulated.
+ *
+ * @return -ENOTSUP.
+ */
+static int capi_i2c_host_register_target(struct capi_i2c_controller_handle
+		*handle, uint16_t addr)
+{
+	(void)handle;
+	(void)addr;
+
+	return -ENOTSUP;
+}
+
+/**
+ * @brief Target mode is not simulated.
+ *
+ * @return -ENOTSUP.
+ */
+static int capi_i2c_host_unregister_target(struct capi_i2c_controller_handle
+		*handle)
+{
+	(void)handle;
+
+	return -ENOTSUP;
+}
+
+/**
+ * @brief Complete the in-flight async transfer. Connected to the host IRQ
+ *        line when use_irq is set.
+ */
+static void capi_i2c_host_isr(void *handle)
+{
+	struct capi_i2c_controller_handle *h = handle;
+
+	if (h == NULL || h->priv == NULL)
+		return;
+
+	i2c_host_complete(h->priv);
+}
+
+int capi_i2c_host_attach(struct capi_i2c_controller_handle *handle,
+			 uint16_t address,
+			 const struct capi_i2c_host_target *target)
+{
+	struct capi_i2c_host_handle *ih;
+	struct capi_i2c_host_slot *free_slot = NULL;
+
+	if (handle == NULL || handle->priv == NULL)
+		return -EINVAL;
+	if (address > I2C_HOST_10BIT_MAX_ADDR)
+		return -EINVAL;
+
+	ih = handle->priv;
+	if (!ih->initialized)
+		return -EINVAL;
+
+	for (uint32_t i = 0; i < CAPI_I2C_HOST_MAX_TARGETS; i++) {
+		struct capi_i2c_host_slot *slot = &ih->slots[i];
+
+		if (slot->target != NULL && slot->address == address) {
+			slot->target = target;
+			return 0;
+		}
+		if (slot->target == NULL && free_slot == NULL)
+			free_slot = slot;
+	}
+
+	if (target == NULL)
+		return 0;
+	if (free_slot == NULL)
+		return -ENOMEM;
+
+	free_slot->address = address;
+	free_slot->target = target;
+
+	return 0;
+}
+
+int capi_i2c_host_get_stats(struct capi_i2c_controller_handle *handle,
+			    struct capi_host_bus_stats *stats)
+{
+	if (handle == NULL || handle->priv == NULL || stats == NULL)
+		return -EINVAL;
+
+	*stats = ((struct capi_i2c_host_handle *)handle->priv)->stats;
+
+	return 0;
+}
+
+int capi_i2c_host_reset_stats(struct capi_i2c_controller_handle *handle)
+{
+	struct capi_i2c_host_handle *ih;
+
+	if (handle == NULL || handle->priv == NULL)
+		return -EINVAL;
+
+	ih = handle->priv;
+	ih->stats = (struct capi_host_bus_stats) {
+		.since_ns = capi_host_sim_now(),
+	};
+
+	return 0;
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2026 Analog Devices, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * @brief Host platform simulated I2C controller for CAPI
+ *
+ * Backend (select via config.ops):
+ *   capi_i2c_host_ops  - simulated I2C controller, initiator mode
+ *
+ * Transfers are forwarded to device models attached by bus address with
+ * capi_i2c_host_attach() and charge the virtual clock of the simulation
+ * core (see host_capi_sim.h) with the modeled bus time. Every byte takes
+ * 9 SCL periods (8 data bits and the acknowledge), each START, repeated
+ * START and STOP condition one period. A 10-bit address takes two address
+ * bytes. The SCL rate is the device speed mode, limited by the controller
+ * rate (config->clk_freq_hz or capi_i2c_configure_bus_speed()). Models can
+ * stretch the clock by returning a positive number of nanoseconds.
+ *
+ * An address without a model, or a model rejecting the transfer, is a NAK
+ * and fails the transfer with -EIO.
+ */
+
+#ifndef _HOST_CAPI_I2C_H_
+#define _HOST_CAPI_I2C_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <capi_i2c.h>
+#include <host_capi_sim.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Number of device models per host controller */
+#define CAPI_I2C_HOST_MAX_TARGETS	16
+
+/**
+ * @struct capi_i2c_host_target
+ * @brief I2C device model. For each callback, a negative return is a NAK;
+ *        read and write may return a positive clock stretch time in ns.
+ */
+struct capi_i2c_host_target {
+	/** Optional. START or repeated START addressed to the target. */
+	int (*start)(void *ctx, bool read);
+	/** Bytes written by the controller. */
+	int (*write)(void *ctx, const uint8_t *buf, uint32_t len);
+	/** Bytes read by the controller. */
+	int (*read)(void *ctx, uint8_t *buf, uint32_t len);
+	/** Optional. STOP condition. */
+	void (*stop)(void *ctx);
+	/** Model context passed to the callbacks */
+	void *ctx;
+};
+
+/**
+ * @struct capi_i2c_host_config
+ * @brief Optional host controller configuration, passed via config->extra.
+ */
+struct capi_i2c_host_config {
+	/** Complete async transfers through the host IRQ controller */
+	bool use_irq;
+	/** Host IRQ line, only valid if use_irq is true */
+	uint32_t irq_id;
+};
+
+/**
+ * @brief Attach a device model to a bus address.
+ * @param handle - Initialized host I2C controller.
+ * @param address - 7-bit or 10-bit bus address, not shifted.
+ * @param target - Device model, NULL detaches. Must outlive the attachment.
+ * @return 0 on success, negative errno on failure.
+ */
+int capi_i2c_host_attach(struct capi_i2c_controller_handle *handle,
+			 uint16_t address,
+			 const struct capi_i2c_host_target *target);
+
+/**
+ * @brief Get the bus statistics of the controller.
+ * @return 0 on success, negative errno on failure.
+ */
+int capi_i2c_host_get_stats(struct capi_i2c_controller_handle *handle,
+			    struct capi_host_bus_stats *stats);
+
+/**
+ * @brief Reset the bus statistics of the controller.
+ * @return 0 on success, negative errno on failure.
+ */
+int capi_i2c_host_reset_stats(struct capi_i2c_controller_handle *handle);
+
+/**
+ * @brief Host I2C operations table.
+ */
+extern const struct capi_i2c_ops capi_i2c_host_ops;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _HOST_CAPI_I2C_H_ */
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2026 Analog Devices, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * @brief Host platform I2C private driver contract.
+ */
+
+#ifndef _HOST_CAPI_I2C_PRIV_H_
+#define _HOST_CAPI_I2C_PRIV_H_
+
+#include <host_capi_i2c.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct capi_i2c_host_slot
+ * @brief Device model attached to a bus address.
+ */
+struct capi_i2c_host_slot {
+	/** Bus address */
+	uint16_t address;
+	/** Device model, NULL if the slot is free */
+	const struct capi_i2c_host_target *target;
+};
+
+/**
+ * @struct capi_i2c_host_handle
+ * @brief Host I2C private controller state.
+ */
+struct capi_i2c_host_handle {
+	/** Attached device models */
+	struct capi_i2c_host_slot slots[CAPI_I2C_HOST_MAX_TARGETS];
+	/** IRQ configuration */
+	struct capi_i2c_host_config cfg;
+	/** Controller SCL limit, 0 if only the device speed applies */
+	uint32_t scl_hz;
+	/** True once init completed */
+	bool initialized;
+	/** Target addressed by a transfer that ended without STOP */
+	const struct capi_i2c_host_target *held;
+	/** User callback for async operations */
+	capi_i2c_callback callback;
+	/** User callback argument */
+	void *callback_arg;
+	/** Bus statistics */
+	struct capi_host_bus_stats stats;
+	/** True while an async transfer is in flight */
+	bool async_in_progress;
+	/** Result of the in-flight async transfer */
+	int async_status;
+	/** Async completion event */
+	struct capi_host_event event;
+};
+
+/**
+ * @brief Declare a stack-allocated host I2C controller handle.
+ *
+ * Declares `name` (struct capi_i2c_controller_handle) with embedded
+ * private state. Pass &name to capi_i2c_init().
+ */
+#define CAPI_I2C_HANDLE_HOST_DEFINE(name)                              \
+	struct capi_i2c_controller_handle name = {                         \
+		.ops = NULL,                                                   \
+		.init_allocated = false,                                       \
+		.priv = &(struct capi_i2c_host_handle){0}                      \
+	}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _HOST_CAPI_I2C_PRIV_H_ */
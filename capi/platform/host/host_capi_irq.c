@@ -0,0 +1,380 @@
+/*
+ * Copyright (c) 2026 Analog Devices, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * @brief Host platform software interrupt controller for CAPI.
+ */
+
+#include <errno.h>
+#include <stddef.h>
+#include <host_capi_irq.h>
+
+/** Priority of the code running outside of any handler */
+#define HOST_IRQ_THREAD_PRIORITY	UINT32_MAX
+
+struct host_irq_line {
+	capi_isr_callback_t isr;
+	void *arg;
+	uint32_t priority;
+	enum capi_irq_trig_level trigger;
+	bool enabled;
+	bool pending;
+	bool level;
+};
+
+static struct host_irq_line g_lines[CAPI_IRQ_HOST_NUM_IRQS];
+static bool g_initialized;
+static bool g_global_enabled;
+static uint32_t g_running_priority = HOST_IRQ_THREAD_PRIORITY;
+
+static bool host_irq_level_active(const struct host_irq_line *line)
+{
+	if (line->trigger == CAPI_IRQ_LEVEL_HIGH)
+		return line->level;
+	if (line->trigger == CAPI_IRQ_LEVEL_LOW)
+		return !line->level;
+
+	return false;
+}
+
+/**
+ * @brief Run the handlers of the pending lines that may preempt the
+ *        current priority, highest priority first.
+ */
+static void host_irq_dispatch(void)
+{
+	bool serviced[CAPI_IRQ_HOST_NUM_IRQS] = { false };
+	struct host_irq_line *line;
+	uint32_t saved_priority;
+	uint32_t best;
+	uint32_t i;
+
+	while (g_initialized && g_global_enabled) {
+		best = CAPI_IRQ_HOST_NUM_IRQS;
+		for (i = 0; i < CAPI_IRQ_HOST_NUM_IRQS; i++) {
+			line = &g_lines[i];
+			if (!line->pending || !line->enabled || serviced[i] ||
+			    line->priority >= g_running_priority)
+				continue;
+			if (best == CAPI_IRQ_HOST_NUM_IRQS ||
+			    line->priority < g_lines[best].priority)
+				best = i;
+		}
+		if (best == CAPI_IRQ_HOST_NUM_IRQS)
+			return;
+
+		line = &g_lines[best];
+		serviced[best] = true;
+		line->pending = false;
+		if (line->isr == NULL)
+			continue;
+
+		saved_priority = g_running_priority;
+		g_running_priority = line->priority;
+		line->isr(line->arg);
+		g_running_priority = saved_priority;
+
+		if (host_irq_level_active(line))
+			line->pending = true;
+	}
+}
+
+static int host_irq_validate(uint32_t irq)
+{
+	if (!g_initialized)
+		return -EINVAL;
+	if (irq >= CAPI_IRQ_HOST_NUM_IRQS)
+		return -EINVAL;
+
+	return 0;
+}
+
+/**
+ * @brief Initialize the software interrupt controller. All lines start
+ *        disabled, rising edge triggered, at priority 0.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+int capi_irq_init(struct capi_irq_config *config)
+{
+	uint32_t i;
+
+	if (config == NULL)
+		return -EINVAL;
+
+	if (g_initialized)
+		return -EBUSY;
+
+	for (i = 0; i < CAPI_IRQ_HOST_NUM_IRQS; i++)
+		g_lines[i] = (struct host_irq_line) {
+		.trigger = CAPI_IRQ_EDGE_RISING,
+	};
+
+	g_global_enabled = false;
+	g_running_priority = HOST_IRQ_THREAD_PRIORITY;
+	g_initialized = true;
+
+	return 0;
+}
+
+/**
+ * @brief Deinitialize the software interrupt controller.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+int capi_irq_deinit(void)
+{
+	if (!g_initialized)
+		return -EINVAL;
+
+	g_global_enabled = false;
+	g_initialized = false;
+
+	return 0;
+}
+
+/**
+ * @brief Enable interrupt dispatching. Lines that became pending while
+ *        dispatching was disabled run now.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+int capi_irq_global_enable(void)
+{
+	if (!g_initialized)
+		return -EINVAL;
+
+	g_global_enabled = true;
+	host_irq_dispatch();
+
+	return 0;
+}
+
+/**
+ * @brief Disable interrupt dispatching. Lines still latch pending.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+int capi_irq_global_disable(void)
+{
+	if (!g_initialized)
+		return -EINVAL;
+
+	g_global_enabled = false;
+
+	return 0;
+}
+
+/**
+ * @brief Connect a handler to an interrupt line.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+int capi_irq_connect(uint32_t irq, capi_isr_callback_t isr, void *arg)
+{
+	int ret;
+
+	ret = host_irq_validate(irq);
+	if (ret)
+		return ret;
+	if (isr == NULL)
+		return -EINVAL;
+
+	g_lines[irq].isr = isr;
+	g_lines[irq].arg = arg;
+
+	return 0;
+}
+
+/**
+ * @brief Enable an interrupt line.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+int capi_irq_enable(uint32_t irq)
+{
+	int ret;
+
+	ret = host_irq_validate(irq);
+	if (ret)
+		return ret;
+
+	g_lines[irq].enabled = true;
+	host_irq_dispatch();
+
+	return 0;
+}
+
+/**
+ * @brief Disable an interrupt line.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+int capi_irq_disable(uint32_t irq)
+{
+	int ret;
+
+	ret = host_irq_validate(irq);
+	if (ret)
+		return ret;
+
+	g_lines[irq].enabled = false;
+
+	return 0;
+}
+
+/**
+ * @brief Clear the pending state of an interrupt line. A level triggered
+ *        line that is still active becomes pending again.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+int capi_irq_clear_pending(uint32_t irq)
+{
+	int ret;
+
+	ret = host_irq_validate(irq);
+	if (ret)
+		return ret;
+
+	g_lines[irq].pending = host_irq_level_active(&g_lines[irq]);
+
+	return 0;
+}
+
+/**
+ * @brief Get the pending state of an interrupt line.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+int capi_irq_get_status(uint32_t irq, uint32_t *pactive)
+{
+	int ret;
+
+	ret = host_irq_validate(irq);
+	if (ret)
+		return ret;
+	if (pactive == NULL)
+		return -EINVAL;
+
+	*pactive = g_lines[irq].pending;
+
+	return 0;
+}
+
+/**
+ * @brief Set the priority of an interrupt line. Lower values preempt
+ *        higher ones.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+int capi_irq_set_priority(uint32_t irq, uint32_t priority)
+{
+	int ret;
+
+	ret = host_irq_validate(irq);
+	if (ret)
+		return ret;
+	if (priority == HOST_IRQ_THREAD_PRIORITY)
+		return -EINVAL;
+
+	g_lines[irq].priority = priority;
+
+	return 0;
+}
+
+/**
+ * @brief Get the priority of an interrupt line.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+int capi_irq_get_priority(uint32_t irq, uint32_t *priority)
+{
+	int ret;
+
+	ret = host_irq_validate(irq);
+	if (ret)
+		return ret;
+	if (priority == NULL)
+		return -EINVAL;
+
+	*priority = g_lines[irq].priority;
+
+	return 0;
+}
+
+/**
+ * @brief Configure the trigger of an interrupt line.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+int capi_irq_set_level_edge_trigger(uint32_t irq,
+				    enum capi_irq_trig_level trigger)
+{
+	int ret;
+
+	ret = host_irq_validate(irq);
+	if (ret)
+		return ret;
+	if (trigger > CAPI_IRQ_EDGE_BOTH)
+		return -EINVAL;
+
+	g_lines[irq].trigger = trigger;
+	g_lines[irq].pending = host_irq_level_active(&g_lines[irq]);
+	host_irq_dispatch();
+
+	return 0;
+}
+
+int capi_irq_host_set_line(uint32_t irq, bool level)
+{
+	struct host_irq_line *line;
+	bool rising, falling;
+	int ret;
+
+	ret = host_irq_validate(irq);
+	if (ret)
+		return ret;
+
+	line = &g_lines[irq];
+	rising = level && !line->level;
+	falling = !level && line->level;
+	line->level = level;
+
+	switch (line->trigger) {
+	case CAPI_IRQ_EDGE_RISING:
+		line->pending |= rising;
+		break;
+	case CAPI_IRQ_EDGE_FALLING:
+		line->pending |= falling;
+		break;
+	case CAPI_IRQ_EDGE_BOTH:
+		line->pending |= rising || falling;
+		break;
+	default:
+		line->pending = host_irq_level_active(line);
+		break;
+	}
+
+	host_irq_dispatch();
+
+	return 0;
+}
+
+int capi_irq_host_set_pending(uint32_t irq)
+{
+	int ret;
+
+	ret = host_irq_validate(irq);
+	if (ret)
+		return ret;
+
+	g_lines[irq].pending = true;
+	host_irq_dispatch();
+
+	return 0;
+}
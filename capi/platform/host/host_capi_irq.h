@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2026 Analog Devices, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * @brief Host platform software interrupt controller for CAPI.
+ *
+ * Implements the capi_irq_* API on top of a table of
+ * CAPI_IRQ_HOST_NUM_IRQS lines. Device models and the host backends raise
+ * lines with capi_irq_host_set_line() or capi_irq_host_set_pending(); an
+ * enabled, pending line is dispatched immediately, from inside the raising
+ * call, in priority order (lower value first). A higher priority line
+ * preempts a running handler, lines of equal or lower priority wait until
+ * it returns.
+ *
+ * Level triggered lines stay pending while the line is active. A handler
+ * that does not clear the source is not re-entered in the same dispatch
+ * pass, so a stuck line does not hang the simulation.
+ */
+
+#ifndef _HOST_CAPI_IRQ_H_
+#define _HOST_CAPI_IRQ_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <capi_irq.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Number of interrupt lines of the host controller */
+#define CAPI_IRQ_HOST_NUM_IRQS	128
+
+/**
+ * @brief Drive an interrupt line from a model. The configured trigger
+ *        decides whether the transition makes the line pending.
+ * @param irq - Interrupt line.
+ * @param level - New line level.
+ * @return 0 on success, negative errno on failure.
+ */
+int capi_irq_host_set_line(uint32_t irq, bool level);
+
+/**
+ * @brief Make a line pending regardless of its trigger configuration,
+ *        as a software triggered interrupt.
+ * @param irq - Interrupt line.
+ * @return 0 on success, negative errno on failure.
+ */
+int capi_irq_host_set_pending(uint32_t irq);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _HOST_CAPI_IRQ_H_ */
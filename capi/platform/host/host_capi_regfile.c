@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2026 Analog Devices, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * @brief Register file device model for the host SPI and I2C controllers.
+ */
+
+#include <capi_alloc.h>
+#include <errno.h>
+#include <string.h>
+#include <host_capi_regfile.h>
+
+static int regfile_read(struct capi_host_regfile *rf, uint8_t *val)
+{
+	int ret;
+
+	if (rf->pointer >= rf->config.num_regs) {
+		rf->out_of_range++;
+		*val = 0;
+		return 0;
+	}
+
+	*val = rf->regs[rf->pointer];
+	if (rf->config.on_read != NULL) {
+		ret = rf->config.on_read(rf->config.hook_arg, rf->pointer, val);
+		if (ret < 0)
+			return ret;
+	}
+	rf->reads++;
+
+	if (rf->config.auto_increment)
+		rf->pointer++;
+
+	return 0;
+}
+
+static int regfile_write(struct capi_host_regfile *rf, uint8_t val)
+{
+	int ret = 0;
+
+	if (rf->pointer >= rf->config.num_regs) {
+		rf->out_of_range++;
+		return 0;
+	}
+
+	if (rf->config.on_write != NULL) {
+		ret = rf->config.on_write(rf->config.hook_arg, rf->pointer, &val);
+		if (ret < 0)
+			return ret;
+	}
+	if (ret == 0)
+		rf->regs[rf->pointer] = val;
+	rf->writes++;
+
+	if (rf->config.auto_increment)
+		rf->pointer++;
+
+	return 0;
+}
+
+/**
+ * @brief Feed one byte of the address phase.
+ * @return true once the address is complete.
+ */
+static bool regfile_addr_byte(struct capi_host_regfile *rf, uint8_t byte)
+{
+	uint32_t mask;
+
+	rf->addr = (rf->addr << 8) | byte;
+	if (++rf->addr_pos < rf->config.addr_bytes)
+		return false;
+
+	mask = rf->config.addr_mask ? rf->config.addr_mask :
+	       (uint32_t)~rf->config.read_flag;
+	rf->read = (rf->addr & rf->config.read_flag) != 0;
+	rf->pointer = rf->addr & mask;
+
+	return true;
+}
+
+static void regfile_spi_select(void *ctx, bool selected)
+{
+	struct capi_host_regfile *rf = ctx;
+
+	if (selected) {
+		rf->addr_pos = 0;
+		rf->addr = 0;
+		rf->read = false;
+	}
+}
+
+static int regfile_spi_xfer(void *ctx, const uint8_t *tx, uint8_t *rx,
+			    uint32_t len)
+{
+	struct capi_host_regfile *rf = ctx;
+	int ret;
+
+	for (uint32_t i = 0; i < len; i++) {
+		rx[i] = 0;
+		if (rf->addr_pos < rf->config.addr_bytes) {
+			regfile_addr_byte(rf, tx[i]);
+			continue;
+		}
+
+		if (rf->read)
+			ret = regfile_read(rf, &rx[i]);
+		else
+			ret = regfile_write(rf, tx[i]);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+static int regfile_i2c_start(void *ctx, bool read)
+{
+	struct capi_host_regfile *rf = ctx;
+
+	/* A write transaction always begins with the register address. */
+	if (!read) {
+		rf->addr_pos = 0;
+		rf->addr = 0;
+	}
+
+	return 0;
+}
+
+static int regfile_i2c_write(void *ctx, const uint8_t *buf, uint32_t len)
+{
+	struct capi_host_regfile *rf = ctx;
+	int ret;
+
+	for (uint32_t i = 0; i < len; i++) {
+		if (rf->addr_pos < rf->config.addr_bytes) {
+			regfile_addr_byte(rf, buf[i]);
+			continue;
+		}
+
+		ret = regfile_write(rf, buf[i]);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+static int regfile_i2c_read(void *ctx, uint8_t *buf, uint32_t len)
+{
+	struct capi_host_regfile *rf = ctx;
+	int ret;
+
+	for (uint32_t i = 0; i < len; i++) {
+		ret = regfile_read(rf, &buf[i]);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+int capi_host_regfile_init(struct capi_host_regfile **regfile,
+			   const struct capi_host_regfile_config *config)
+{
+	struct capi_host_regfile *rf;
+
+	if (regfile == NULL || config == NULL || config->num_regs == 0)
+		return -EINVAL;
+	if (config->addr_bytes < 1 || config->addr_bytes > 2)
+		return -EINVAL;
+
+	rf = capi_calloc(1, sizeof(*rf));
+	if (rf == NULL)
+		return -ENOMEM;
+
+	rf->regs = capi_calloc(config->num_regs, sizeof(*rf->regs));
+	if (rf->regs == NULL) {
+		capi_free(rf);
+		return -ENOMEM;
+	}
+
+	rf->config = *config;
+	rf->spi = (struct capi_spi_host_target) {
+		.select = regfile_spi_select,
+		.xfer = regfile_spi_xfer,
+		.ctx = rf,
+	};
+	rf->i2c = (struct capi_i2c_host_target) {
+		.start = regfile_i2c_start,
+		.write = regfile_i2c_write,
+		.read = regfile_i2c_read,
+		.ctx = rf,
+	};
+	capi_host_regfile_reset(rf);
+
+	*regfile = rf;
+
+	return 0;
+}
+
+int capi_host_regfile_remove(struct capi_host_regfile *regfile)
+{
+	if (regfile == NULL)
+		return -EINVAL;
+
+	capi_free(regfile->regs);
+	capi_free(regfile);
+
+	return 0;
+}
+
+int capi_host_regfile_reset(struct capi_host_regfile *regfile)
+{
+	if (regfile == NULL)
+		return -EINVAL;
+
+	if (regfile->config.reset_values != NULL)
+		memcpy(regfile->regs, regfile->config.reset_values,
+		       regfile->config.num_regs);
+	else
+		memset(regfile->regs, 0, regfile->config.num_regs);
+
+	regfile->pointer = 0;
+	regfile->addr_pos = 0;
+	regfile->addr = 0;
+	regfile->read = false;
+	regfile->reads = 0;
+	regfile->writes = 0;
+	regfile->out_of_range = 0;
+
+	return 0;
+}
+
+int capi_host_regfile_set(struct capi_host_regfile *regfile, uint32_t reg,
+			  uint8_t val)
+{
+	if (regfile == NULL || reg >= regfile->config.num_regs)
+		return -EINVAL;
+
+	regfile->regs[reg] = val;
+
+	return 0;
+}
+
+int capi_host_regfile_get(struct capi_host_regfile *regfile, uint32_t reg,
+			  uint8_t *val)
+{
+	if (regfile == NULL || val == NULL || reg >= regfile->config.num_regs)
+		return -EINVAL;
+
+	*val = regfile->regs[reg];
+
+	return 0;
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2026 Analog Devices, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * @brief Register file device model for the host SPI and I2C controllers.
+ *
+ * Emulates the common register map protocol of SPI and I2C converters and
+ * sensors: an address phase of addr_bytes bytes, followed by data bytes
+ * read from or written to 8-bit registers, optionally auto-incrementing.
+ *
+ *   SPI: every chip select frame starts with the address phase. A read is
+ *        flagged by read_flag in the address (e.g. 0x80 or 0x8000); the
+ *        remaining bits, masked with addr_mask, select the register.
+ *   I2C: a write starts with the address phase and continues with data.
+ *        A read returns data from the current register pointer.
+ *
+ * Behavior beyond plain storage is scripted from C with the on_read and
+ * on_write hooks (clear-on-read status, data ready bits, FIFO registers,
+ * reset commands), and test code can preset or check registers with
+ * capi_host_regfile_set()/capi_host_regfile_get().
+ *
+ * Attach the model with:
+ *   capi_spi_host_attach(spi, cs, &regfile->spi);
+ *   capi_i2c_host_attach(i2c, address, &regfile->i2c);
+ */
+
+#ifndef _HOST_CAPI_REGFILE_H_
+#define _HOST_CAPI_REGFILE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <host_capi_spi.h>
+#include <host_capi_i2c.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Register access hook.
+ * @param arg - config->hook_arg.
+ * @param reg - Register being accessed.
+ * @param val - Value read out or written, may be changed by the hook.
+ * @return 0 to continue, 1 to skip the register update (writes only),
+ *         negative errno to fail the transfer.
+ */
+typedef int (*capi_host_regfile_hook)(void *arg, uint32_t reg, uint8_t *val);
+
+/**
+ * @struct capi_host_regfile_config
+ * @brief Register file model configuration.
+ */
+struct capi_host_regfile_config {
+	/** Number of 8-bit registers */
+	uint32_t num_regs;
+	/** Width of the register address on the bus, 1 or 2 bytes */
+	uint8_t addr_bytes;
+	/** SPI only: address bits flagging a read */
+	uint16_t read_flag;
+	/** Address bits selecting the register, 0 for all but read_flag */
+	uint16_t addr_mask;
+	/** Move to the next register after each data byte */
+	bool auto_increment;
+	/** Optional reset values, num_regs bytes */
+	const uint8_t *reset_values;
+	/** Optional. Called before a register is read out. */
+	capi_host_regfile_hook on_read;
+	/** Optional. Called before a register is written. */
+	capi_host_regfile_hook on_write;
+	/** Hook argument */
+	void *hook_arg;
+};
+
+/**
+ * @struct capi_host_regfile
+ * @brief Register file model instance.
+ */
+struct capi_host_regfile {
+	/** Configuration */
+	struct capi_host_regfile_config config;
+	/** Register contents */
+	uint8_t *regs;
+	/** Current register */
+	uint32_t pointer;
+	/** Address bytes received in the current address phase */
+	uint8_t addr_pos;
+	/** Address being assembled */
+	uint32_t addr;
+	/** Current SPI frame is a read */
+	bool read;
+	/** Register reads over the bus */
+	uint64_t reads;
+	/** Register writes over the bus */
+	uint64_t writes;
+	/** Accesses beyond num_regs (reads return 0, writes are dropped) */
+	uint64_t out_of_range;
+	/** SPI target interface, attach with capi_spi_host_attach() */
+	struct capi_spi_host_target spi;
+	/** I2C target interface, attach with capi_i2c_host_attach() */
+	struct capi_i2c_host_target i2c;
+};
+
+/**
+ * @brief Create a register file model.
+ * @param regfile - Created model.
+ * @param config - Model configuration.
+ * @return 0 on success, negative errno on failure.
+ */
+int capi_host_regfile_init(struct capi_host_regfile **regfile,
+			   const struct capi_host_regfile_config *config);
+
+/**
+ * @brief Free a register file model. Detach it from the controllers first.
+ * @return 0 on success, negative errno on failure.
+ */
+int capi_host_regfile_remove(struct capi_host_regfile *regfile);
+
+/**
+ * @brief Restore the reset values and clear the access counters.
+ * @return 0 on success, negative errno on failure.
+ */
+int capi_host_regfile_reset(struct capi_host_regfile *regfile);
+
+/**
+ * @brief Set a register without calling the hooks or counting an access.
+ * @return 0 on success, negative errno on failure.
+ */
+int capi_host_regfile_set(struct capi_host_regfile *regfile, uint32_t reg,
+			  uint8_t val);
+
+/**
+ * @brief Get a register without calling the hooks or counting an access.
+ * @return 0 on success, negative errno on failure.
+ */
+int capi_host_regfile_get(struct capi_host_regfile *regfile, uint32_t reg,
+			  uint8_t *val);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _HOST_CAPI_REGFILE_H_ */
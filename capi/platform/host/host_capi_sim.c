@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2026 Analog Devices, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * @brief Host platform simulation core.
+ */
+
+#include <errno.h>
+#include <stddef.h>
+#include <time.h>
+#include <host_capi_sim.h>
+
+static uint64_t g_now_ns;
+static struct capi_host_event *g_queue;
+static struct capi_host_sim_stats g_stats;
+static uint32_t g_cpu_scale;
+static uint64_t g_cpu_mark_ns;
+static uint32_t g_depth;
+
+static uint64_t host_cpu_time_ns(void)
+{
+	struct timespec ts;
+
+	if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts))
+		return 0;
+
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Fire the queued events due at or before the given time.
+ *
+ * The clock is moved to each event before it fires, so callbacks observe
+ * the completion time. A callback may advance the clock or queue new
+ * events; both are picked up by the loop.
+ */
+static void host_sim_run_until(uint64_t until_ns)
+{
+	struct capi_host_event *event;
+
+	while (g_queue != NULL && g_queue->when_ns <= until_ns) {
+		event = g_queue;
+		g_queue = event->next;
+		event->next = NULL;
+		event->queued = false;
+
+		if (event->when_ns > g_now_ns)
+			g_now_ns = event->when_ns;
+		event->fire(event);
+	}
+
+	if (until_ns > g_now_ns)
+		g_now_ns = until_ns;
+}
+
+int capi_host_sim_init(const struct capi_host_sim_config *config)
+{
+	struct capi_host_event *event;
+
+	while (g_queue != NULL) {
+		event = g_queue;
+		g_queue = event->next;
+		event->next = NULL;
+		event->queued = false;
+	}
+
+	g_now_ns = 0;
+	g_stats = (struct capi_host_sim_stats) {
+		0
+	};
+	g_cpu_scale = config ? config->cpu_scale_percent : 0;
+	g_cpu_mark_ns = host_cpu_time_ns();
+	g_depth = 0;
+
+	return 0;
+}
+
+uint64_t capi_host_sim_now(void)
+{
+	return g_now_ns;
+}
+
+void capi_host_sim_advance(uint64_t ns)
+{
+	host_sim_run_until(g_now_ns + ns);
+}
+
+int capi_host_sim_run_next(void)
+{
+	if (g_queue == NULL)
+		return -ENOENT;
+
+	host_sim_run_until(g_queue->when_ns);
+
+	return 0;
+}
+
+void capi_host_sim_schedule(struct capi_host_event *event, uint64_t when_ns)
+{
+	struct capi_host_event **pos;
+
+	if (event == NULL || event->fire == NULL)
+		return;
+
+	capi_host_sim_cancel(event);
+
+	/* Keep the queue sorted; equal times fire in scheduling order. */
+	event->when_ns = when_ns;
+	for (pos = &g_queue; *pos != NULL; pos = &(*pos)->next)
+		if ((*pos)->when_ns > when_ns)
+			break;
+
+	event->next = *pos;
+	*pos = event;
+	event->queued = true;
+}
+
+void capi_host_sim_cancel(struct capi_host_event *event)
+{
+	struct capi_host_event **pos;
+
+	if (event == NULL || !event->queued)
+		return;
+
+	for (pos = &g_queue; *pos != NULL; pos = &(*pos)->next) {
+		if (*pos == event) {
+			*pos = event->next;
+			break;
+		}
+	}
+
+	event->next = NULL;
+	event->queued = false;
+}
+
+void capi_host_sim_get_stats(struct capi_host_sim_stats *stats)
+{
+	if (stats == NULL)
+		return;
+
+	*stats = g_stats;
+	stats->now_ns = g_now_ns;
+}
+
+uint32_t capi_host_bus_utilization(const struct capi_host_bus_stats *stats)
+{
+	uint64_t elapsed;
+
+	if (stats == NULL || g_now_ns <= stats->since_ns)
+		return 0;
+
+	elapsed = g_now_ns - stats->since_ns;
+	if (stats->busy_ns >= elapsed)
+		return 10000;
+
+	return (uint32_t)(stats->busy_ns * 10000 / elapsed);
+}
+
+void capi_host_sim_enter(void)
+{
+	uint64_t cpu_ns;
+
+	if (g_depth++ || !g_cpu_scale)
+		return;
+
+	cpu_ns = (host_cpu_time_ns() - g_cpu_mark_ns) * g_cpu_scale / 100;
+	g_stats.cpu_ns += cpu_ns;
+	capi_host_sim_advance(cpu_ns);
+}
+
+void capi_host_sim_exit(void)
+{
+	if (g_depth == 0 || --g_depth)
+		return;
+
+	/* Time spent inside the simulator and the models is not charged. */
+	if (g_cpu_scale)
+		g_cpu_mark_ns = host_cpu_time_ns();
+}
+
+void capi_host_bus_account(struct capi_host_bus_stats *stats, uint32_t bytes,
+			   uint64_t ns, bool ok)
+{
+	if (stats == NULL)
+		return;
+
+	stats->busy_ns += ns;
+	if (ok) {
+		stats->transfers++;
+		stats->bytes += bytes;
+	} else {
+		stats->errors++;
+	}
+}
+
+void capi_host_bus_charge(struct capi_host_bus_stats *stats, uint32_t bytes,
+			  uint64_t ns, bool ok)
+{
+	capi_host_bus_account(stats, bytes, ns, ok);
+	capi_host_sim_advance(ns);
+}
+
+void capi_host_sim_wait(uint64_t ns)
+{
+	g_stats.wait_ns += ns;
+	capi_host_sim_advance(ns);
+}
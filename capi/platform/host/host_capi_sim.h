@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2026 Analog Devices, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * @brief Host platform simulation core: virtual clock, event queue and
+ *        bus statistics shared by the host CAPI backends.
+ *
+ * The host platform runs CAPI drivers on a workstation against device
+ * models. Nothing takes wall-clock time: every bus transfer and every
+ * capi_wait_us()/capi_wait_ms() advances a virtual nanosecond clock by the
+ * modeled duration, and asynchronous completions (SPI/I2C/UART async
+ * transfers, timer overflows and compares) are events that fire once the
+ * virtual clock reaches them. capi_uptime() returns the virtual clock.
+ *
+ * Optionally, the host CPU time a driver spends between two simulator calls
+ * is added to the virtual clock, scaled by cpu_scale_percent, to model the
+ * software overhead on the target. With the scale at zero the virtual clock
+ * only contains bus and wait time, which makes runs deterministic.
+ *
+ * The simulator is single threaded. Callbacks run from inside the call
+ * that advanced the clock, the same way an ISR preempts the driver.
+ * A driver that busy-polls a completion flag without calling any CAPI
+ * function never advances the clock; use capi_host_sim_run_next() there.
+ */
+
+#ifndef _HOST_CAPI_SIM_H_
+#define _HOST_CAPI_SIM_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct capi_host_sim_config
+ * @brief Simulation core configuration.
+ */
+struct capi_host_sim_config {
+	/**
+	 * Host CPU time spent by the caller between simulator calls is added
+	 * to the virtual clock multiplied by cpu_scale_percent / 100. Zero
+	 * disables CPU accounting.
+	 */
+	uint32_t cpu_scale_percent;
+};
+
+/**
+ * @struct capi_host_sim_stats
+ * @brief Global time accounting.
+ */
+struct capi_host_sim_stats {
+	/** Current virtual time */
+	uint64_t now_ns;
+	/** Virtual time charged for the caller's CPU time */
+	uint64_t cpu_ns;
+	/** Virtual time spent in capi_wait_us()/capi_wait_ms() */
+	uint64_t wait_ns;
+};
+
+/**
+ * @struct capi_host_bus_stats
+ * @brief Per controller bus accounting, kept by every host bus backend.
+ */
+struct capi_host_bus_stats {
+	/** Virtual time of the last statistics reset */
+	uint64_t since_ns;
+	/** Completed transfers (one per CS frame or per START..STOP) */
+	uint64_t transfers;
+	/**
+	 * Bytes on the bus: SPI clocked bytes, I2C address, sub-address and
+	 * data bytes, UART characters
+	 */
+	uint64_t bytes;
+	/** Time the bus was busy, including CS delays and protocol overhead */
+	uint64_t busy_ns;
+	/** Failed transfers (no target, NAK, model error) */
+	uint64_t errors;
+};
+
+/**
+ * @struct capi_host_event
+ * @brief Event in the virtual time queue. Owned by the scheduler of the
+ *        event, which must keep it alive while queued.
+ */
+struct capi_host_event {
+	/** Virtual time the event fires at */
+	uint64_t when_ns;
+	/** Called once the virtual clock reaches when_ns */
+	void (*fire)(struct capi_host_event *event);
+	/** Free for use by the owner */
+	void *arg;
+	/** Queue link, managed by the scheduler */
+	struct capi_host_event *next;
+	/** True while the event is queued */
+	bool queued;
+};
+
+/**
+ * @brief Reset the virtual clock, the global statistics and the event
+ *        queue.
+ * @param config - Configuration, may be NULL for defaults.
+ * @return 0 on success, negative errno on failure.
+ */
+int capi_host_sim_init(const struct capi_host_sim_config *config);
+
+/**
+ * @brief Current virtual time.
+ */
+uint64_t capi_host_sim_now(void);
+
+/**
+ * @brief Advance the virtual clock, firing the events that become due.
+ * @param ns - Duration to advance by.
+ */
+void capi_host_sim_advance(uint64_t ns);
+
+/**
+ * @brief Advance the virtual clock for a delay requested by the driver,
+ *        accounted as wait time.
+ * @param ns - Delay.
+ */
+void capi_host_sim_wait(uint64_t ns);
+
+/**
+ * @brief Advance the virtual clock to the next queued event and fire it.
+ * @return 0 if an event fired, -ENOENT if the queue is empty.
+ */
+int capi_host_sim_run_next(void);
+
+/**
+ * @brief Queue an event. An already queued event is moved.
+ * @param event - Event, event->fire must be set.
+ * @param when_ns - Absolute virtual time. Past times fire on the next
+ *                  advance.
+ */
+void capi_host_sim_schedule(struct capi_host_event *event, uint64_t when_ns);
+
+/**
+ * @brief Remove an event from the queue, if queued.
+ */
+void capi_host_sim_cancel(struct capi_host_event *event);
+
+/**
+ * @brief Get the global time accounting.
+ */
+void capi_host_sim_get_stats(struct capi_host_sim_stats *stats);
+
+/**
+ * @brief Bus utilization since the last statistics reset.
+ * @param stats - Bus statistics of a host controller.
+ * @return Busy time over elapsed time, in hundredths of a percent.
+ */
+uint32_t capi_host_bus_utilization(const struct capi_host_bus_stats *stats);
+
+/**
+ * @brief Mark the start and the end of a simulator call. Host CPU time
+ *        spent outside of these brackets is charged as driver time.
+ *        Used by the host backends; calls may nest.
+ */
+void capi_host_sim_enter(void);
+void capi_host_sim_exit(void);
+
+/**
+ * @brief Charge bus time: account it and advance the clock.
+ * @param stats - Bus statistics to update.
+ * @param bytes - Payload bytes of the transfer.
+ * @param ns - Modeled duration.
+ * @param ok - Whether the transfer succeeded.
+ */
+void capi_host_bus_charge(struct capi_host_bus_stats *stats, uint32_t bytes,
+			  uint64_t ns, bool ok);
+
+/**
+ * @brief Account bus time without advancing the clock, for asynchronous
+ *        transfers that complete through an event.
+ */
+void capi_host_bus_account(struct capi_host_bus_stats *stats, uint32_t bytes,
+			   uint64_t ns, bool ok);
+
+/**
+ * @brief Duration of a number of clock cycles, rounded up.
+ * @param cycles - Clock cycles.
+ * @param hz - Clock frequency, must be non-zero.
+ */
+static inline uint64_t capi_host_cycles_to_ns(uint64_t cycles, uint32_t hz)
+{
+	return (cycles * 1000000000ULL + hz - 1) / hz;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _HOST_CAPI_SIM_H_ */
@@ -0,0 +1,664 @@
+/*
+ * Copyright (c) 2026 Analog Devices, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * @brief Host simulated SPI controller (master mode only)
+ *
+ * Data is exchanged with the device model when a transfer starts; async
+ * transfers complete (callback, or the configured host IRQ line) once the
+ * virtual clock reaches the end of the modeled bus time.
+ */
+
+#include <capi_alloc.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <string.h>
+#include <capi_spi.h>
+#include <capi_gpio.h>
+#include <host_capi_spi_priv.h>
+#include <host_capi_irq.h>
+
+static int capi_spi_host_init(struct capi_spi_controller_handle **handle,
+			      const struct capi_spi_config *config);
+static int capi_spi_host_deinit(struct capi_spi_controller_handle *handle);
+static int capi_spi_host_transceive(struct capi_spi_device *device,
+				    struct capi_spi_transfer *transfer);
+static int capi_spi_host_transceive_async(struct capi_spi_device *device,
+		struct capi_spi_transfer *transfer, int timeout);
+static int capi_spi_host_read_command(struct capi_spi_device *device,
+				      struct capi_spi_transfer *transfer);
+static int capi_spi_host_read_command_async(struct capi_spi_device *device,
+		struct capi_spi_transfer *transfer);
+static int capi_spi_host_abort_async(struct capi_spi_device *device);
+static int capi_spi_host_register_callback(struct capi_spi_controller_handle
+		*handle,
+		capi_spi_callback_t const callback, void *callback_arg);
+static int capi_spi_host_set_cs(struct capi_spi_device *device,
+				enum capi_spi_cs_control cs);
+static void capi_spi_host_isr(void *handle);
+
+const struct capi_spi_ops capi_spi_host_ops = {
+	.init = capi_spi_host_init,
+	.deinit = capi_spi_host_deinit,
+	.transceive = capi_spi_host_transceive,
+	.transceive_async = capi_spi_host_transceive_async,
+	.read_command = capi_spi_host_read_command,
+	.read_command_async = capi_spi_host_read_command_async,
+	.abort_async = capi_spi_host_abort_async,
+	.register_callback = capi_spi_host_register_callback,
+	.set_cs = capi_spi_host_set_cs,
+	.isr = capi_spi_host_isr,
+};
+
+static struct capi_spi_host_handle *spi_host_priv(
+	const struct capi_spi_device *device)
+{
+	struct capi_spi_host_handle *sh;
+
+	if (device == NULL || device->controller == NULL)
+		return NULL;
+
+	sh = device->controller->priv;
+	if (sh == NULL || !sh->initialized)
+		return NULL;
+
+	return sh;
+}
+
+/* native_cs == 0 selects CS0. */
+static int spi_host_cs_index(uint16_t native_cs, uint8_t *index)
+{
+	uint8_t i;
+
+	if (native_cs == 0) {
+		*index = 0;
+		return 0;
+	}
+	if (native_cs & (native_cs - 1))
+		return -EINVAL;
+
+	for (i = 0; !(native_cs & 1U); i++)
+		native_cs >>= 1;
+	*index = i;
+
+	return 0;
+}
+
+static const struct capi_spi_host_target *spi_host_target(
+	const struct capi_spi_host_handle *sh,
+	const struct capi_spi_device *device)
+{
+	uint8_t index;
+
+	if (device->extra != NULL)
+		return device->extra;
+	if (device->cs_gpio_num > 0)
+		return NULL;
+	if (spi_host_cs_index(device->native_cs, &index))
+		return NULL;
+
+	return sh->targets[index];
+}
+
+static uint32_t spi_host_sclk_hz(const struct capi_spi_host_handle *sh,
+				 const struct capi_spi_device *device)
+{
+	uint32_t hz = device->max_speed_hz;
+
+	if (sh->clk_freq_hz && (!hz || sh->clk_freq_hz < hz))
+		hz = sh->clk_freq_hz;
+
+	return hz;
+}
+
+static int spi_host_select(const struct capi_spi_device *device,
+			   const struct capi_spi_host_target *target,
+			   bool selected)
+{
+	int first_error = 0;
+	int ret;
+
+	if (target != NULL && target->select != NULL)
+		target->select(target->ctx, selected);
+
+	/* GPIO chip selects are driven logically, like on the hardware ports. */
+	for (uint8_t i = 0; i < device->cs_gpio_num; i++) {
+		ret = capi_gpio_pin_set_value(&device->cs_gpio[i],
+					      selected ? CAPI_GPIO_HIGH : CAPI_GPIO_LOW);
+		if (ret && !first_error)
+			first_error = ret;
+	}
+
+	return first_error;
+}
+
+/**
+ * @brief Clock cycles of a frame of len bytes.
+ */
+static uint64_t spi_host_cycles(const struct capi_spi_device *device,
+				uint32_t len, uint8_t delay_cycles)
+{
+	const struct capi_spi_flow_ctl_params *flow = &device->flow_ctl_param;
+	uint64_t cycles = (uint64_t)len * 8U;
+
+	if (len == 0)
+		return 0;
+
+	cycles += (uint64_t)(len - 1) * delay_cycles;
+	if (flow->mode == CAPI_SPI_FLOW_CTL_TIMER && flow->burts_size)
+		cycles += (uint64_t)((len - 1) / flow->burts_size) * flow->wait_tmr;
+
+	return cycles;
+}
+
+/**
+ * @brief Run one transfer against the device model.
+ *
+ * @param device - SPI device.
+ * @param transfer - Transfer descriptor.
+ * @param read_command - Clock tx_size + rx_size bytes, RX after TX, instead
+ *                       of max(tx_size, rx_size) full duplex bytes.
+ * @param len - Bytes clocked on the bus.
+ * @param ns - Modeled bus time. Set whenever the bus was clocked, also if
+ *             the model failed the transfer.
+ * @return 0 on success, negative errno on failure.
+ */
+static int spi_host_run(struct capi_spi_device *device,
+			const struct capi_spi_transfer *transfer,
+			bool read_command, uint32_t *len, uint64_t *ns)
+{
+	struct capi_spi_host_handle *sh = device->controller->priv;
+	const struct capi_spi_host_target *target;
+	uint32_t frame_len, frames, off, n;
+	uint8_t *tx_wire, *rx_wire;
+	bool held;
+	uint32_t hz;
+	int ret = 0;
+
+	*len = 0;
+	*ns = 0;
+
+	if ((device->cs_gpio == NULL) != (device->cs_gpio_num == 0))
+		return -EINVAL;
+	if (device->flow_ctl_param.mode == CAPI_SPI_FLOW_CTL_RDY ||
+	    device->flow_ctl_param.mode == CAPI_SPI_FLOW_CTL_MISO)
+		return -ENOTSUP;
+
+	hz = spi_host_sclk_hz(sh, device);
+	if (hz == 0)
+		return -EINVAL;
+
+	target = spi_host_target(sh, device);
+	if (!sh->loopback && (target == NULL || target->xfer == NULL))
+		return -ENODEV;
+
+	if (read_command)
+		*len = (uint32_t)transfer->tx_size + transfer->rx_size;
+	else
+		*len = transfer->tx_size > transfer->rx_size ?
+		       transfer->tx_size : transfer->rx_size;
+	if (*len == 0)
+		return 0;
+
+	tx_wire = capi_calloc(2, *len);
+	if (tx_wire == NULL)
+		return -ENOMEM;
+	rx_wire = tx_wire + *len;
+	if (transfer->tx_buf != NULL)
+		memcpy(tx_wire, transfer->tx_buf, transfer->tx_size);
+
+	held = sh->manual_cs == device;
+	frame_len = (!held && device->non_continuous_mode) ? 1 : *len;
+	frames = held ? 0 : (*len + frame_len - 1) / frame_len;
+
+	*ns = capi_host_cycles_to_ns(spi_host_cycles(device, *len,
+					transfer->xfer_delay_clk_cycles), hz);
+	*ns += (uint64_t)frames * ((uint64_t)sh->cfg.cs_setup_ns +
+				   sh->cfg.cs_hold_ns + sh->cfg.cs_inactive_ns);
+
+	for (off = 0; off < *len; off += n) {
+		n = *len - off < frame_len ? *len - off : frame_len;
+
+		if (!held) {
+			ret = spi_host_select(device, target, true);
+			if (ret)
+				break;
+		}
+
+		if (sh->loopback)
+			memcpy(rx_wire + off, tx_wire + off, n);
+		else
+			ret = target->xfer(target->ctx, tx_wire + off, rx_wire + off, n);
+
+		if (!held) {
+			int cs_ret = spi_host_select(device, target, false);
+			if (!ret)
+				ret = cs_ret;
+		}
+		if (ret)
+			break;
+	}
+
+	if (!ret && transfer->rx_buf != NULL)
+		memcpy(transfer->rx_buf,
+		       rx_wire + (read_command ? transfer->tx_size : 0),
+		       transfer->rx_size);
+
+	capi_free(tx_wire);
+
+	return ret;
+}
+
+/**
+ * @brief Check if the bus is owned by another transfer or chip select.
+ *
+ * The bus is taken by an async transfer until it completes, and by a
+ * manually asserted chip select until it is released: transfers of the
+ * other devices of the controller are refused for the whole hold.
+ *
+ * @param sh - Host controller state.
+ * @param device - Device requesting the bus.
+ * @return true if the device cannot use the bus.
+ */
+static bool spi_host_bus_busy(const struct capi_spi_host_handle *sh,
+			      const struct capi_spi_device *device)
+{
+	return sh->async_in_progress ||
+	       (sh->manual_cs != NULL && sh->manual_cs != device);
+}
+
+static int spi_host_sync(struct capi_spi_device *device,
+			 struct capi_spi_transfer *transfer, bool read_command)
+{
+	struct capi_spi_host_handle *sh = spi_host_priv(device);
+	uint32_t len;
+	uint64_t ns;
+	int ret;
+
+	if (sh == NULL || transfer == NULL)
+		return -EINVAL;
+	if (spi_host_bus_busy(sh, device))
+		return -EBUSY;
+
+	capi_host_sim_enter();
+	ret = spi_host_run(device, transfer, read_command, &len, &ns);
+	if (ns)
+		capi_host_bus_charge(&sh->stats, len, ns, ret == 0);
+	capi_host_sim_exit();
+
+	return ret;
+}
+
+static void spi_host_complete(struct capi_spi_host_handle *sh)
+{
+	if (!sh->async_in_progress)
+		return;
+
+	sh->async_in_progress = false;
+	if (sh->callback != NULL)
+		sh->callback(CAPI_SPI_EVENT_XFR_DONE, sh->callback_arg, 0);
+}
+
+static void spi_host_event_fire(struct capi_host_event *event)
+{
+	struct capi_spi_controller_handle *h = event->arg;
+	struct capi_spi_host_handle *sh = h->priv;
+
+	if (sh->cfg.use_irq)
+		(void)capi_irq_host_set_pending(sh->cfg.irq_id);
+	else
+		spi_host_complete(sh);
+}
+
+static int spi_host_async(struct capi_spi_device *device,
+			  struct capi_spi_transfer *transfer, bool read_command)
+{
+	struct capi_spi_host_handle *sh = spi_host_priv(device);
+	uint32_t len;
+	uint64_t ns;
+	int ret;
+
+	if (sh == NULL || transfer == NULL)
+		return -EINVAL;
+	if (spi_host_bus_busy(sh, device))
+		return -EBUSY;
+
+	capi_host_sim_enter();
+	ret = spi_host_run(device, transfer, read_command, &len, &ns);
+	if (ret) {
+		if (ns)
+			capi_host_bus_charge(&sh->stats, len, ns, false);
+		capi_host_sim_exit();
+		return ret;
+	}
+
+	capi_host_bus_account(&sh->stats, len, ns, true);
+	sh->async_in_progress = true;
+	sh->event.fire = spi_host_event_fire;
+	sh->event.arg = device->controller;
+	capi_host_sim_schedule(&sh->event, capi_host_sim_now() + ns);
+	capi_host_sim_exit();
+
+	return 0;
+}
+
+/**
+ * @brief Initialize the CAPI backend instance.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_spi_host_init(struct capi_spi_controller_handle **handle,
+			      const struct capi_spi_config *config)
+{
+	if (handle == NULL || config == NULL)
+		return -EINVAL;
+	if (*handle != NULL &&
+	    ((*handle)->ops != NULL ||
+	     ((*handle)->priv != NULL &&
+	      ((struct capi_spi_host_handle *)(*handle)->priv)->initialized)))
+		return -EBUSY;
+	if (config->three_pin_mode || config->dma_handle != NULL)
+		return -ENOTSUP;
+
+	bool alloc = (*handle == NULL);
+	struct capi_spi_controller_handle *h = *handle;
+	struct capi_spi_host_handle *sh;
+	int ret;
+
+	if (alloc) {
+		h = capi_calloc(1, sizeof(*h));
+		if (h == NULL)
+			return -ENOMEM;
+
+		sh = capi_malloc(sizeof(*sh));
+		if (sh == NULL) {
+			capi_free(h);
+			return -ENOMEM;
+		}
+		h->priv = sh;
+	} else {
+		sh = h->priv;
+		if (sh == NULL)
+			return -EINVAL;
+	}
+
+	memset(sh, 0, sizeof(*sh));
+	if (config->extra != NULL)
+		sh->cfg = *(const struct capi_spi_host_config *)config->extra;
+	sh->clk_freq_hz = config->clk_freq_hz;
+	sh->loopback = config->loopback;
+	sh->stats.since_ns = capi_host_sim_now();
+
+	if (sh->cfg.use_irq) {
+		ret = capi_irq_connect(sh->cfg.irq_id, capi_spi_host_isr, h);
+		if (ret == 0)
+			ret = capi_irq_enable(sh->cfg.irq_id);
+		if (ret) {
+			if (alloc) {
+				capi_free(sh);
+				capi_free(h);
+			}
+			return ret;
+		}
+	}
+
+	h->init_allocated = alloc;
+	h->ops = config->ops ? config->ops : &capi_spi_host_ops;
+	sh->initialized = true;
+	*handle = h;
+
+	return 0;
+}
+
+/**
+ * @brief Deinitialize the CAPI backend instance. An in-flight async
+ *        transfer is dropped without callback.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_spi_host_deinit(struct capi_spi_controller_handle *handle)
+{
+	struct capi_spi_host_handle *sh;
+
+	if (handle == NULL || handle->priv == NULL)
+		return -EINVAL;
+
+	sh = handle->priv;
+	capi_host_sim_cancel(&sh->event);
+	if (sh->cfg.use_irq)
+		(void)capi_irq_disable(sh->cfg.irq_id);
+	sh->initialized = false;
+
+	if (handle->init_allocated) {
+		capi_free(sh);
+		capi_free(handle);
+	} else {
+		handle->ops = NULL;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Perform a blocking full duplex transfer of
+ *        max(tx_size, rx_size) bytes.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_spi_host_transceive(struct capi_spi_device *device,
+				    struct capi_spi_transfer *transfer)
+{
+	return spi_host_sync(device, transfer, false);
+}
+
+/**
+ * @brief Start a full duplex transfer completing after its bus time.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_spi_host_transceive_async(struct capi_spi_device *device,
+		struct capi_spi_transfer *transfer, int timeout)
+{
+	(void)timeout;
+
+	return spi_host_async(device, transfer, false);
+}
+
+/**
+ * @brief Perform a blocking transfer sending tx_size bytes, then receiving
+ *        rx_size bytes in the same frame.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_spi_host_read_command(struct capi_spi_device *device,
+				      struct capi_spi_transfer *transfer)
+{
+	return spi_host_sync(device, transfer, true);
+}
+
+/**
+ * @brief Start a read command transfer completing after its bus time.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_spi_host_read_command_async(struct capi_spi_device *device,
+		struct capi_spi_transfer *transfer)
+{
+	return spi_host_async(device, transfer, true);
+}
+
+/**
+ * @brief Abort an in-progress asynchronous operation. The bus time of the
+ *        aborted transfer stays accounted.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_spi_host_abort_async(struct capi_spi_device *device)
+{
+	struct capi_spi_host_handle *sh = spi_host_priv(device);
+
+	if (sh == NULL)
+		return -EINVAL;
+	if (!sh->async_in_progress)
+		return 0;
+
+	capi_host_sim_cancel(&sh->event);
+	sh->async_in_progress = false;
+
+	if (sh->callback)
+		sh->callback(CAPI_SPI_EVENT_ERROR, sh->callback_arg, 0);
+
+	return 0;
+}
+
+/**
+ * @brief Register the CAPI asynchronous callback.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_spi_host_register_callback(struct capi_spi_controller_handle
+		*handle,
+		capi_spi_callback_t const callback, void *callback_arg)
+{
+	if (handle == NULL || handle->priv == NULL)
+		return -EINVAL;
+
+	struct capi_spi_host_handle *sh = handle->priv;
+	sh->callback = callback;
+	sh->callback_arg = callback_arg;
+
+	return 0;
+}
+
+/**
+ * @brief Control the SPI chip select line.
+ *
+ * A manually asserted chip select spans the following transfers of the
+ * device, which are then charged for clock time only; the setup time is
+ * charged on assert, hold and inactive time on deassert. The device owns
+ * the bus until the chip select is released: transfers and chip select
+ * requests of the other devices fail with -EBUSY in the meantime.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_spi_host_set_cs(struct capi_spi_device *device,
+				enum capi_spi_cs_control cs)
+{
+	struct capi_spi_host_handle *sh = spi_host_priv(device);
+	const struct capi_spi_host_target *target;
+	uint64_t ns;
+	int ret;
+
+	if (sh == NULL)
+		return -EINVAL;
+	if ((device->cs_gpio == NULL) != (device->cs_gpio_num == 0))
+		return -EINVAL;
+
+	target = spi_host_target(sh, device);
+
+	switch (cs) {
+	case CAPI_SPI_CS_MANUAL_ASSERT:
+		if (sh->manual_cs == device)
+			return 0;
+		if (spi_host_bus_busy(sh, device))
+			return -EBUSY;
+
+		ret = spi_host_select(device, target, true);
+		if (ret)
+			return ret;
+		sh->manual_cs = device;
+		ns = sh->cfg.cs_setup_ns;
+		break;
+	case CAPI_SPI_CS_AUTO:
+	case CAPI_SPI_CS_MANUAL_DEASSERT:
+		if (sh->manual_cs != device)
+			return 0;
+		/* Keep the chip select until the device's transfer is done */
+		if (sh->async_in_progress)
+			return -EBUSY;
+
+		sh->manual_cs = NULL;
+		ret = spi_host_select(device, target, false);
+		ns = (uint64_t)sh->cfg.cs_hold_ns + sh->cfg.cs_inactive_ns;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	capi_host_sim_enter();
+	sh->stats.busy_ns += ns;
+	capi_host_sim_advance(ns);
+	capi_host_sim_exit();
+
+	return ret;
+}
+
+/**
+ * @brief Complete the in-flight async transfer. Connected to the host IRQ
+ *        line when use_irq is set.
+ */
+static void capi_spi_host_isr(void *handle)
+{
+	struct capi_spi_controller_handle *h = handle;
+
+	if (h == NULL || h->priv == NULL)
+		return;
+
+	spi_host_complete(h->priv);
+}
+
+int capi_spi_host_attach(struct capi_spi_controller_handle *handle,
+			 uint16_t native_cs,
+			 const struct capi_spi_host_target *target)
+{
+	struct capi_spi_host_handle *sh;
+	uint8_t index;
+	int ret;
+
+	if (handle == NULL || handle->priv == NULL)
+		return -EINVAL;
+
+	ret = spi_host_cs_index(native_cs, &index);
+	if (ret)
+		return ret;
+	if (index >= CAPI_SPI_HOST_NUM_CS)
+		return -EINVAL;
+
+	sh = handle->priv;
+	if (!sh->initialized)
+		return -EINVAL;
+	sh->targets[index] = target;
+
+	return 0;
+}
+
+int capi_spi_host_get_stats(struct capi_spi_controller_handle *handle,
+			    struct capi_host_bus_stats *stats)
+{
+	if (handle == NULL || handle->priv == NULL || stats == NULL)
+		return -EINVAL;
+
+	*stats = ((struct capi_spi_host_handle *)handle->priv)->stats;
+
+	return 0;
+}
+
+int capi_spi_host_reset_stats(struct capi_spi_controller_handle *handle)
+{
+	struct capi_spi_host_handle *sh;
+
+	if (handle == NULL || handle->priv == NULL)
+		return -EINVAL;
+
+	sh = handle->priv;
+	sh->stats = (struct capi_host_bus_stats) {
+		.since_ns = capi_host_sim_now(),
+	};
+
+	return 0;
+}
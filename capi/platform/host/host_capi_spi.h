@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2026 Analog Devices, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * @brief Host platform simulated SPI controller for CAPI
+ *
+ * Backend (select via config.ops):
+ *   capi_spi_host_ops  - simulated SPI controller, master mode
+ *
+ * Transfers are forwarded to device models attached with
+ * capi_spi_host_attach() and charge the virtual clock of the simulation
+ * core (see host_capi_sim.h) with the modeled bus time:
+ *
+ *   cs_setup_ns + cycles / f_sclk + cs_hold_ns + cs_inactive_ns
+ *
+ * f_sclk is the lower of device->max_speed_hz and config->clk_freq_hz.
+ * cycles counts 8 clocks per byte, xfer_delay_clk_cycles between bytes and,
+ * for timer flow control, wait_tmr clocks after every burts_size bytes.
+ * In non-continuous mode every byte is a separate CS frame.
+ *
+ * A device holding its chip select with CAPI_SPI_CS_MANUAL_ASSERT owns the
+ * bus until CAPI_SPI_CS_MANUAL_DEASSERT: transfers of the other devices of
+ * the controller fail with -EBUSY meanwhile, as during an async transfer.
+ */
+
+#ifndef _HOST_CAPI_SPI_H_
+#define _HOST_CAPI_SPI_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <capi_spi.h>
+#include <host_capi_sim.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Number of native chip selects of the host controller */
+#define CAPI_SPI_HOST_NUM_CS	16
+
+/**
+ * @struct capi_spi_host_target
+ * @brief SPI device model.
+ *
+ * Attach one per native chip select with capi_spi_host_attach(). Devices
+ * that use GPIO chip selects, or that need a model of their own on a
+ * shared chip select, pass the model through capi_spi_device.extra, which
+ * takes precedence over the native chip select table.
+ */
+struct capi_spi_host_target {
+	/** Optional. Called when the chip select is asserted or released. */
+	void (*select)(void *ctx, bool selected);
+	/**
+	 * Exchange len bytes in the current frame. tx always holds len bytes
+	 * (zeroes where the caller sent nothing); rx receives len bytes.
+	 * A negative return fails the transfer with that error.
+	 */
+	int (*xfer)(void *ctx, const uint8_t *tx, uint8_t *rx, uint32_t len);
+	/** Model context passed to the callbacks */
+	void *ctx;
+};
+
+/**
+ * @struct capi_spi_host_config
+ * @brief Optional host controller configuration, passed via config->extra.
+ */
+struct capi_spi_host_config {
+	/** Chip select assert to first clock edge */
+	uint32_t cs_setup_ns;
+	/** Last clock edge to chip select release */
+	uint32_t cs_hold_ns;
+	/** Minimum chip select inactive time between frames */
+	uint32_t cs_inactive_ns;
+	/** Complete async transfers through the host IRQ controller */
+	bool use_irq;
+	/** Host IRQ line, only valid if use_irq is true */
+	uint32_t irq_id;
+};
+
+/**
+ * @brief Attach a device model to a native chip select.
+ * @param handle - Initialized host SPI controller.
+ * @param native_cs - Chip select mask with a single bit set, 0 selects CS0.
+ * @param target - Device model, NULL detaches. Must outlive the attachment.
+ * @return 0 on success, negative errno on failure.
+ */
+int capi_spi_host_attach(struct capi_spi_controller_handle *handle,
+			 uint16_t native_cs,
+			 const struct capi_spi_host_target *target);
+
+/**
+ * @brief Get the bus statistics of the controller.
+ * @return 0 on success, negative errno on failure.
+ */
+int capi_spi_host_get_stats(struct capi_spi_controller_handle *handle,
+			    struct capi_host_bus_stats *stats);
+
+/**
+ * @brief Reset the bus statistics of the controller.
+ * @return 0 on success, negative errno on failure.
+ */
+int capi_spi_host_reset_stats(struct capi_spi_controller_handle *handle);
+
+/**
+ * @brief Host SPI operations table.
+ */
+extern const struct capi_spi_ops capi_spi_host_ops;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _HOST_CAPI_SPI_H_ */
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2026 Analog Devices, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * @brief Host platform SPI private driver contract.
+ */
+
+#ifndef _HOST_CAPI_SPI_PRIV_H_
+#define _HOST_CAPI_SPI_PRIV_H_
+
+#include <host_capi_spi.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct capi_spi_host_handle
+ * @brief Host SPI private controller state.
+ */
+struct capi_spi_host_handle {
+	/** Device models per native chip select */
+	const struct capi_spi_host_target *targets[CAPI_SPI_HOST_NUM_CS];
+	/** Chip select timing and IRQ configuration */
+	struct capi_spi_host_config cfg;
+	/** Controller clock limit, 0 if only the device limit applies */
+	uint32_t clk_freq_hz;
+	/** Loopback mode: RX mirrors TX, models are not consulted */
+	bool loopback;
+	/** True once init completed */
+	bool initialized;
+	/** User callback for async operations */
+	capi_spi_callback_t callback;
+	/** User callback argument */
+	void *callback_arg;
+	/** Bus statistics */
+	struct capi_host_bus_stats stats;
+	/** Device whose chip select is held by CAPI_SPI_CS_MANUAL_ASSERT */
+	struct capi_spi_device *manual_cs;
+	/** True while an async transfer is in flight */
+	bool async_in_progress;
+	/** Async completion event */
+	struct capi_host_event event;
+};
+
+/**
+ * @brief Declare a stack-allocated host SPI controller handle.
+ *
+ * Declares `name` (struct capi_spi_controller_handle) with embedded
+ * private state. Pass &name to capi_spi_init().
+ */
+#define CAPI_SPI_HANDLE_HOST_DEFINE(name)                              \
+	struct capi_spi_controller_handle name = {                         \
+		.ops = NULL,                                                   \
+		.init_allocated = false,                                       \
+		.priv = &(struct capi_spi_host_handle){0}                      \
+	}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _HOST_CAPI_SPI_PRIV_H_ */
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2026 Analog Devices, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * @brief Host strong implementations of capi_time weak hooks.
+ *
+ * Delays advance the virtual clock of the simulation core instead of
+ * sleeping, and capi_uptime_impl() reports the virtual clock. Events that
+ * become due during a delay (async completions, timer callbacks) fire from
+ * inside the delay call.
+ */
+
+#include <stddef.h>
+#include <errno.h>
+#include "capi_time.h"
+#include <host_capi_sim.h>
+
+void capi_wait_us_impl(uint32_t us)
+{
+	capi_host_sim_enter();
+	capi_host_sim_wait((uint64_t)us * 1000U);
+	capi_host_sim_exit();
+}
+
+void capi_wait_ms_impl(uint32_t ms)
+{
+	capi_host_sim_enter();
+	capi_host_sim_wait((uint64_t)ms * 1000000U);
+	capi_host_sim_exit();
+}
+
+int capi_uptime_impl(uint64_t *us)
+{
+	if (us == NULL)
+		return -EINVAL;
+
+	capi_host_sim_enter();
+	*us = capi_host_sim_now() / 1000U;
+	capi_host_sim_exit();
+
+	return 0;
+}
@@ -0,0 +1,993 @@
+/*
+ * Copyright (c) 2026 Analog Devices, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * @brief Host simulated timer
+ *
+ * The counter position counts ticks from the last counter configuration;
+ * the counter value is the position folded into [min, max] for the
+ * configured direction. Overflows happen when the position crosses a
+ * multiple of the period, compare matches when it reaches the compare
+ * value's offset within the period. Events are looked up in the position
+ * range that elapsed since they were last handled, so an event scheduled
+ * late (or a clock advanced past several periods) is never lost; several
+ * occurrences of the same event collapse into one, as with a hardware
+ * status flag.
+ */
+
+#include <capi_alloc.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <string.h>
+#include <capi_timer.h>
+#include <capi_irq.h>
+#include <host_capi_timer_priv.h>
+#include <host_capi_irq.h>
+
+#define CAPI_TIMER_NSEC_PER_SEC		1000000000ULL
+#define TIMER_HOST_DEFAULT_CLOCK_HZ	100000000ULL
+#define TIMER_HOST_POS_NONE		UINT64_MAX
+
+static int capi_timer_host_init(struct capi_timer_handle **handle,
+				const struct capi_timer_config *config);
+static int capi_timer_host_deinit(struct capi_timer_handle *handle);
+static int capi_timer_host_start(struct capi_timer_handle *handle);
+static int capi_timer_host_stop(struct capi_timer_handle *handle);
+static int capi_timer_host_counter_config(struct capi_timer_handle *handle,
+		const struct capi_timer_counter_config *config);
+static int capi_timer_host_counter_get(struct capi_timer_handle *handle,
+				       uint32_t *counter);
+static int capi_timer_host_event_irq_enable(struct capi_timer_handle *handle,
+		uint32_t event);
+static int capi_timer_host_event_irq_disable(struct capi_timer_handle *handle,
+		uint32_t event);
+static int capi_timer_host_register_event_callback(struct capi_timer_handle
+		*handle,
+		capi_timer_event_callback callback,
+		void *callback_arg);
+static int capi_timer_host_channel_init(struct capi_timer_handle *handle,
+					uint32_t chan);
+static int capi_timer_host_channel_deinit(struct capi_timer_handle *handle,
+		uint32_t chan);
+static int capi_timer_host_channel_config(struct capi_timer_handle *handle,
+		uint32_t chan,
+		const struct capi_timer_channel_config *ch_config);
+static int capi_timer_host_channel_enable(struct capi_timer_handle *handle,
+		uint32_t chan);
+static int capi_timer_host_channel_disable(struct capi_timer_handle *handle,
+		uint32_t chan);
+static int capi_timer_host_channel_compare_set(struct capi_timer_handle
+		*handle, uint32_t chan,
+		uint32_t compare);
+static int capi_timer_host_channel_compare_get(struct capi_timer_handle
+		*handle, uint32_t chan,
+		uint32_t *compare);
+static int capi_timer_host_channel_capture_get(struct capi_timer_handle
+		*handle, uint32_t chan,
+		uint32_t *capture);
+static int capi_timer_host_channel_irq_enable(struct capi_timer_handle
+		*handle, uint32_t chan,
+		uint32_t event);
+static int capi_timer_host_channel_irq_disable(struct capi_timer_handle
+		*handle, uint32_t chan,
+		uint32_t event);
+static int capi_timer_host_channel_register_callback(struct capi_timer_handle
+		*handle,
+		uint32_t chan,
+		capi_timer_channel_callback callback,
+		void *callback_arg);
+static int capi_timer_host_is_irq_pending(struct capi_timer_handle *handle,
+		bool *pending);
+static void capi_timer_host_isr(struct capi_timer_handle *handle);
+static int capi_timer_host_nsec_to_ticks(const struct capi_timer_handle
+		*handle,
+		uint64_t duration_ns, uint32_t *ticks);
+static int capi_timer_host_ticks_to_nsec(const struct capi_timer_handle
+		*handle, uint64_t ticks,
+		uint32_t *duration_ns);
+
+const struct capi_timer_ops capi_timer_host_ops = {
+	.init = capi_timer_host_init,
+	.deinit = capi_timer_host_deinit,
+	.start = capi_timer_host_start,
+	.stop = capi_timer_host_stop,
+	.counter_config = capi_timer_host_counter_config,
+	.counter_get = capi_timer_host_counter_get,
+	.event_irq_enable = capi_timer_host_event_irq_enable,
+	.event_irq_disable = capi_timer_host_event_irq_disable,
+	.register_event_callback = capi_timer_host_register_event_callback,
+	.channel_init = capi_timer_host_channel_init,
+	.channel_deinit = capi_timer_host_channel_deinit,
+	.channel_config = capi_timer_host_channel_config,
+	.channel_enable = capi_timer_host_channel_enable,
+	.channel_disable = capi_timer_host_channel_disable,
+	.channel_compare_set = capi_timer_host_channel_compare_set,
+	.channel_compare_get = capi_timer_host_channel_compare_get,
+	.channel_capture_get = capi_timer_host_channel_capture_get,
+	.channel_irq_enable = capi_timer_host_channel_irq_enable,
+	.channel_irq_disable = capi_timer_host_channel_irq_disable,
+	.channel_register_callback = capi_timer_host_channel_register_callback,
+	.is_irq_pending = capi_timer_host_is_irq_pending,
+	.isr = capi_timer_host_isr,
+	.nsec_to_ticks = capi_timer_host_nsec_to_ticks,
+	.ticks_to_nsec = capi_timer_host_ticks_to_nsec,
+};
+
+static struct capi_timer_host_handle *timer_host_priv(
+	const struct capi_timer_handle *handle)
+{
+	struct capi_timer_host_handle *th;
+
+	if (handle == NULL)
+		return NULL;
+
+	th = handle->priv;
+	if (th == NULL || !th->initialized)
+		return NULL;
+
+	return th;
+}
+
+static struct capi_timer_host_channel *timer_host_channel(
+	const struct capi_timer_handle *handle, uint32_t chan)
+{
+	struct capi_timer_host_handle *th = timer_host_priv(handle);
+
+	if (th == NULL || chan >= CAPI_TIMER_HOST_NUM_CHANNELS)
+		return NULL;
+
+	return &th->channels[chan];
+}
+
+/** Whole ticks elapsed in ns, split to avoid 64-bit overflow. */
+static uint64_t timer_host_ns_to_ticks(uint64_t ns, uint64_t hz)
+{
+	return ns / CAPI_TIMER_NSEC_PER_SEC * hz +
+	       ns % CAPI_TIMER_NSEC_PER_SEC * hz / CAPI_TIMER_NSEC_PER_SEC;
+}
+
+/** Time of the ticks-th tick, rounded up to the next ns. */
+static uint64_t timer_host_ticks_to_ns(uint64_t ticks, uint64_t hz)
+{
+	return ticks / hz * CAPI_TIMER_NSEC_PER_SEC +
+	       (ticks % hz * CAPI_TIMER_NSEC_PER_SEC + hz - 1) / hz;
+}
+
+static uint64_t timer_host_period(const struct capi_timer_host_handle *th)
+{
+	return (uint64_t)th->max - th->min + 1;
+}
+
+static uint64_t timer_host_pos(const struct capi_timer_host_handle *th)
+{
+	if (!th->running)
+		return th->origin_pos;
+
+	return th->origin_pos + timer_host_ns_to_ticks(capi_host_sim_now() -
+			th->origin_ns, th->tick_hz);
+}
+
+static uint32_t timer_host_value(const struct capi_timer_host_handle *th,
+				 uint64_t pos)
+{
+	uint64_t period = timer_host_period(th);
+
+	/* Without rollover the counter holds at its last value. */
+	if (!th->rollover && pos >= period)
+		pos = period - 1;
+	else
+		pos %= period;
+
+	if (th->direction == CAPI_TIMER_COUNT_DOWN)
+		return (uint32_t)(th->max - pos);
+
+	return (uint32_t)(th->min + pos);
+}
+
+/** First overflow after position pos. */
+static uint64_t timer_host_next_overflow(const struct capi_timer_host_handle
+		*th, uint64_t pos)
+{
+	uint64_t period = timer_host_period(th);
+
+	if (th->rollover)
+		return (pos / period + 1) * period;
+
+	return pos < period ? period : TIMER_HOST_POS_NONE;
+}
+
+/** First position after pos where the counter equals the compare value. */
+static uint64_t timer_host_next_match(const struct capi_timer_host_handle *th,
+				      const struct capi_timer_host_channel *ch, uint64_t pos)
+{
+	uint64_t period = timer_host_period(th);
+	uint64_t offset, match;
+
+	if (th->direction == CAPI_TIMER_COUNT_DOWN)
+		offset = th->max - ch->compare;
+	else
+		offset = ch->compare - th->min;
+
+	if (!th->rollover)
+		return offset > pos ? offset : TIMER_HOST_POS_NONE;
+
+	match = pos - pos % period + offset;
+	if (match <= pos)
+		match += period;
+
+	return match;
+}
+
+static bool timer_host_compare_armed(const struct capi_timer_host_channel *ch)
+{
+	return ch->enabled && ch->config.mode == CAPI_TIMER_COMPARE_MODE &&
+	       ((ch->irq_mask & (1U << CAPI_TIMER_CHANNEL_EVENT_COMPARE)) ||
+		ch->config.config.compare.stop_enabled);
+}
+
+static void timer_host_event_fire(struct capi_host_event *event);
+
+/**
+ * @brief Schedule the next overflow or compare match after checked_pos.
+ */
+static void timer_host_kick(struct capi_timer_host_handle *th,
+			    struct capi_timer_handle *h)
+{
+	uint64_t next = TIMER_HOST_POS_NONE;
+	uint64_t pos;
+
+	if (th->running) {
+		if (th->event_irq_enabled)
+			next = timer_host_next_overflow(th, th->checked_pos);
+
+		for (uint32_t i = 0; i < CAPI_TIMER_HOST_NUM_CHANNELS; i++) {
+			if (!timer_host_compare_armed(&th->channels[i]))
+				continue;
+			pos = timer_host_next_match(th, &th->channels[i], th->checked_pos);
+			if (pos < next)
+				next = pos;
+		}
+	}
+
+	if (next == TIMER_HOST_POS_NONE) {
+		capi_host_sim_cancel(&th->event);
+		return;
+	}
+
+	th->event.fire = timer_host_event_fire;
+	th->event.arg = h;
+	capi_host_sim_schedule(&th->event, th->origin_ns +
+			       timer_host_ticks_to_ns(next - th->origin_pos, th->tick_hz));
+}
+
+/**
+ * @brief Forget the events up to the current position, after a change
+ *        that must not raise past events.
+ */
+static void timer_host_sync(struct capi_timer_host_handle *th,
+			    struct capi_timer_handle *h)
+{
+	th->checked_pos = timer_host_pos(th);
+	timer_host_kick(th, h);
+}
+
+static void timer_host_dispatch(struct capi_timer_host_handle *th,
+				struct capi_timer_handle *h)
+{
+	if (th->cfg.use_irq)
+		(void)capi_irq_host_set_pending(th->cfg.irq_id);
+	else
+		capi_timer_host_isr(h);
+}
+
+static void timer_host_event_fire(struct capi_host_event *event)
+{
+	struct capi_timer_handle *h = event->arg;
+	struct capi_timer_host_handle *th = h->priv;
+	struct capi_timer_host_channel *ch;
+	uint64_t pos = timer_host_pos(th);
+	uint64_t match;
+	bool raised = false;
+
+	/* A compare match with stop_enabled freezes the counter. */
+	for (uint32_t i = 0; i < CAPI_TIMER_HOST_NUM_CHANNELS; i++) {
+		ch = &th->channels[i];
+		if (!timer_host_compare_armed(ch) ||
+		    !ch->config.config.compare.stop_enabled)
+			continue;
+		match = timer_host_next_match(th, ch, th->checked_pos);
+		if (match <= pos) {
+			pos = match;
+			th->running = false;
+			th->origin_pos = match;
+		}
+	}
+
+	if (th->event_irq_enabled &&
+	    timer_host_next_overflow(th, th->checked_pos) <= pos) {
+		th->overflow_pending = true;
+		raised = true;
+	}
+
+	for (uint32_t i = 0; i < CAPI_TIMER_HOST_NUM_CHANNELS; i++) {
+		ch = &th->channels[i];
+		if (!timer_host_compare_armed(ch) ||
+		    timer_host_next_match(th, ch, th->checked_pos) > pos)
+			continue;
+		ch->pending |= 1U << CAPI_TIMER_CHANNEL_EVENT_COMPARE;
+		raised = true;
+	}
+
+	th->checked_pos = pos;
+	if (raised)
+		timer_host_dispatch(th, h);
+	timer_host_kick(th, h);
+}
+
+static void irq_handler(void *ref)
+{
+	capi_timer_host_isr((struct capi_timer_handle *)ref);
+}
+
+/**
+ * @brief Initialize the CAPI timer backend instance.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_timer_host_init(struct capi_timer_handle **handle,
+				const struct capi_timer_config *config)
+{
+	if (!handle || !config)
+		return -EINVAL;
+	if (*handle != NULL &&
+	    ((*handle)->ops != NULL ||
+	     ((*handle)->priv != NULL &&
+	      ((struct capi_timer_host_handle *)(*handle)->priv)->initialized)))
+		return -EBUSY;
+
+	bool alloc_handle = (*handle == NULL);
+	struct capi_timer_handle *h = *handle;
+	struct capi_timer_host_handle *th;
+	uint64_t input_hz, div;
+	int ret;
+
+	if (alloc_handle) {
+		h = capi_calloc(1, sizeof(*h));
+		if (!h)
+			return -ENOMEM;
+
+		th = capi_malloc(sizeof(*th));
+		if (!th) {
+			capi_free(h);
+			return -ENOMEM;
+		}
+		h->priv = th;
+	} else {
+		th = h->priv;
+		if (!th)
+			return -EINVAL;
+	}
+
+	memset(th, 0, sizeof(*th));
+	if (config->extra != NULL)
+		th->cfg = *(const struct capi_timer_host_config *)config->extra;
+
+	/* Smallest prescaler not exceeding the requested rate or 1 GHz. */
+	input_hz = config->input_clock_hz ? config->input_clock_hz :
+		   TIMER_HOST_DEFAULT_CLOCK_HZ;
+	div = 1;
+	if (config->output_freq_hz > 0 && config->output_freq_hz < input_hz)
+		div = (input_hz + config->output_freq_hz - 1) / config->output_freq_hz;
+	if (input_hz / div > CAPI_TIMER_NSEC_PER_SEC)
+		div = (input_hz + CAPI_TIMER_NSEC_PER_SEC - 1) / CAPI_TIMER_NSEC_PER_SEC;
+	th->tick_hz = input_hz / div;
+
+	th->direction = CAPI_TIMER_COUNT_UP;
+	th->max = UINT32_MAX;
+	th->rollover = true;
+
+	if (th->cfg.use_irq) {
+		ret = capi_irq_connect(th->cfg.irq_id, irq_handler, h);
+		if (ret == 0)
+			ret = capi_irq_enable(th->cfg.irq_id);
+		if (ret) {
+			if (alloc_handle) {
+				capi_free(th);
+				capi_free(h);
+			}
+			return ret;
+		}
+	}
+
+	th->initialized = true;
+	h->init_allocated = alloc_handle;
+	h->ops = config->ops ? config->ops : &capi_timer_host_ops;
+	*handle = h;
+
+	return 0;
+}
+
+/**
+ * @brief Deinitialize the CAPI timer backend instance.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_timer_host_deinit(struct capi_timer_handle *handle)
+{
+	if (!handle)
+		return -EINVAL;
+
+	struct capi_timer_host_handle *th = handle->priv;
+	if (!th)
+		return -EINVAL;
+
+	capi_host_sim_cancel(&th->event);
+	if (th->cfg.use_irq)
+		(void)capi_irq_disable(th->cfg.irq_id);
+	th->initialized = false;
+
+	if (handle->init_allocated) {
+		capi_free(th);
+		capi_free(handle);
+	} else {
+		handle->ops = NULL;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Start the timer counter from its current value. A counter without
+ *        rollover that reached its end restarts from the beginning.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_timer_host_start(struct capi_timer_handle *handle)
+{
+	struct capi_timer_host_handle *th = timer_host_priv(handle);
+
+	if (!th)
+		return -EINVAL;
+	if (th->running)
+		return 0;
+
+	if (!th->rollover && th->origin_pos >= timer_host_period(th) - 1)
+		th->origin_pos = 0;
+	th->origin_ns = capi_host_sim_now();
+	th->running = true;
+	timer_host_sync(th, handle);
+
+	return 0;
+}
+
+/**
+ * @brief Stop the timer counter, keeping its value.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_timer_host_stop(struct capi_timer_handle *handle)
+{
+	struct capi_timer_host_handle *th = timer_host_priv(handle);
+
+	if (!th)
+		return -EINVAL;
+
+	th->origin_pos = timer_host_pos(th);
+	th->running = false;
+	timer_host_sync(th, handle);
+
+	return 0;
+}
+
+/**
+ * @brief Configure the timer counter. The counter restarts from min when
+ *        counting up, from max when counting down.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_timer_host_counter_config(struct capi_timer_handle *handle,
+		const struct capi_timer_counter_config *config)
+{
+	struct capi_timer_host_handle *th = timer_host_priv(handle);
+
+	if (!th || !config)
+		return -EINVAL;
+	if (config->extra != NULL)
+		return -ENOTSUP;
+	if (config->direction >= CAPI_TIMER_COUNTER_DIRECTION_LIMIT)
+		return -ENOTSUP;
+	if (config->min > config->max)
+		return -EINVAL;
+
+	th->direction = config->direction;
+	th->min = config->min;
+	th->max = config->max;
+	th->rollover = config->rollover;
+	th->origin_pos = 0;
+	th->origin_ns = capi_host_sim_now();
+	timer_host_sync(th, handle);
+
+	return 0;
+}
+
+/**
+ * @brief Read the timer counter value.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_timer_host_counter_get(struct capi_timer_handle *handle,
+				       uint32_t *counter)
+{
+	struct capi_timer_host_handle *th = timer_host_priv(handle);
+
+	if (!th || !counter)
+		return -EINVAL;
+
+	*counter = timer_host_value(th, timer_host_pos(th));
+
+	return 0;
+}
+
+/**
+ * @brief Enable timer global event interrupts.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_timer_host_event_irq_enable(struct capi_timer_handle *handle,
+		uint32_t event)
+{
+	struct capi_timer_host_handle *th = timer_host_priv(handle);
+
+	if (!th)
+		return -EINVAL;
+	if (event != CAPI_TIMER_GLOBAL_EVENT_COUNTER_OVERFLOW)
+		return -EINVAL;
+
+	th->event_irq_enabled = true;
+	timer_host_sync(th, handle);
+
+	return 0;
+}
+
+/**
+ * @brief Disable timer global event interrupts.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_timer_host_event_irq_disable(struct capi_timer_handle *handle,
+		uint32_t event)
+{
+	struct capi_timer_host_handle *th = timer_host_priv(handle);
+
+	if (!th)
+		return -EINVAL;
+	if (event != CAPI_TIMER_GLOBAL_EVENT_COUNTER_OVERFLOW)
+		return -EINVAL;
+
+	th->event_irq_enabled = false;
+	th->overflow_pending = false;
+	timer_host_sync(th, handle);
+
+	return 0;
+}
+
+/**
+ * @brief Register the timer global event callback.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_timer_host_register_event_callback(struct capi_timer_handle
+		*handle,
+		capi_timer_event_callback callback,
+		void *callback_arg)
+{
+	struct capi_timer_host_handle *th = timer_host_priv(handle);
+
+	if (!th)
+		return -EINVAL;
+
+	th->event_callback = callback;
+	th->event_callback_arg = callback_arg;
+
+	return 0;
+}
+
+/**
+ * @brief Initialize a timer channel, in compare mode.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_timer_host_channel_init(struct capi_timer_handle *handle,
+					uint32_t chan)
+{
+	struct capi_timer_host_channel *ch = timer_host_channel(handle, chan);
+
+	if (!ch)
+		return -EINVAL;
+
+	memset(ch, 0, sizeof(*ch));
+	ch->config.mode = CAPI_TIMER_COMPARE_MODE;
+	ch->initialized = true;
+
+	return 0;
+}
+
+/**
+ * @brief Deinitialize a timer channel.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_timer_host_channel_deinit(struct capi_timer_handle *handle,
+		uint32_t chan)
+{
+	struct capi_timer_host_channel *ch = timer_host_channel(handle, chan);
+
+	if (!ch)
+		return -EINVAL;
+
+	memset(ch, 0, sizeof(*ch));
+	timer_host_kick(handle->priv, handle);
+
+	return 0;
+}
+
+/**
+ * @brief Configure a timer channel.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_timer_host_channel_config(struct capi_timer_handle *handle,
+		uint32_t chan,
+		const struct capi_timer_channel_config *ch_config)
+{
+	struct capi_timer_host_channel *ch = timer_host_channel(handle, chan);
+	struct capi_timer_host_handle *th;
+
+	if (!ch || !ch_config)
+		return -EINVAL;
+	if (!ch->initialized)
+		return -EINVAL;
+	if (ch_config->extra != NULL)
+		return -ENOTSUP;
+
+	th = handle->priv;
+	switch (ch_config->mode) {
+	case CAPI_TIMER_COMPARE_MODE:
+		if (ch_config->config.compare.match_value < th->min ||
+		    ch_config->config.compare.match_value > th->max)
+			return -EINVAL;
+		ch->compare = ch_config->config.compare.match_value;
+		break;
+
+	case CAPI_TIMER_CAPTURE_MODE:
+		if (ch_config->config.capture.edge >= CAPI_TIMER_CAPTURE_EDGE_LIMIT)
+			return -EINVAL;
+		break;
+
+	case CAPI_TIMER_PWM_MODE:
+		if (ch_config->config.pwm.period_ns == 0 ||
+		    ch_config->config.pwm.active_ns > ch_config->config.pwm.period_ns)
+			return -EINVAL;
+		break;
+
+	default:
+		return -EINVAL;
+	}
+
+	ch->config = *ch_config;
+	ch->pending = 0;
+	timer_host_sync(th, handle);
+
+	return 0;
+}
+
+/**
+ * @brief Enable a timer channel.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_timer_host_channel_enable(struct capi_timer_handle *handle,
+		uint32_t chan)
+{
+	struct capi_timer_host_channel *ch = timer_host_channel(handle, chan);
+
+	if (!ch || !ch->initialized)
+		return -EINVAL;
+
+	ch->enabled = true;
+	timer_host_sync(handle->priv, handle);
+
+	return 0;
+}
+
+/**
+ * @brief Disable a timer channel.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_timer_host_channel_disable(struct capi_timer_handle *handle,
+		uint32_t chan)
+{
+	struct capi_timer_host_channel *ch = timer_host_channel(handle, chan);
+
+	if (!ch)
+		return -EINVAL;
+
+	ch->enabled = false;
+	timer_host_sync(handle->priv, handle);
+
+	return 0;
+}
+
+/**
+ * @brief Set a timer channel compare value.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_timer_host_channel_compare_set(struct capi_timer_handle
+		*handle, uint32_t chan,
+		uint32_t compare)
+{
+	struct capi_timer_host_channel *ch = timer_host_channel(handle, chan);
+	struct capi_timer_host_handle *th;
+
+	if (!ch)
+		return -EINVAL;
+
+	th = handle->priv;
+	if (compare < th->min || compare > th->max)
+		return -EINVAL;
+
+	ch->compare = compare;
+	ch->config.config.compare.match_value = compare;
+	timer_host_sync(th, handle);
+
+	return 0;
+}
+
+/**
+ * @brief Get a timer channel compare value.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_timer_host_channel_compare_get(struct capi_timer_handle
+		*handle, uint32_t chan,
+		uint32_t *compare)
+{
+	struct capi_timer_host_channel *ch = timer_host_channel(handle, chan);
+
+	if (!ch || !compare)
+		return -EINVAL;
+
+	*compare = ch->compare;
+
+	return 0;
+}
+
+/**
+ * @brief Get the counter value latched by the last capture.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_timer_host_channel_capture_get(struct capi_timer_handle
+		*handle, uint32_t chan,
+		uint32_t *capture)
+{
+	struct capi_timer_host_channel *ch = timer_host_channel(handle, chan);
+
+	if (!ch || !capture)
+		return -EINVAL;
+	if (ch->config.mode != CAPI_TIMER_CAPTURE_MODE)
+		return -EINVAL;
+
+	*capture = ch->capture;
+
+	return 0;
+}
+
+/**
+ * @brief Enable timer channel interrupts.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_timer_host_channel_irq_enable(struct capi_timer_handle
+		*handle, uint32_t chan,
+		uint32_t event)
+{
+	struct capi_timer_host_channel *ch = timer_host_channel(handle, chan);
+
+	if (!ch)
+		return -EINVAL;
+	if (event >= CAPI_TIMER_CHANNEL_EVENT_LIMIT)
+		return -EINVAL;
+
+	ch->irq_mask |= 1U << event;
+	timer_host_sync(handle->priv, handle);
+
+	return 0;
+}
+
+/**
+ * @brief Disable timer channel interrupts.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_timer_host_channel_irq_disable(struct capi_timer_handle
+		*handle, uint32_t chan,
+		uint32_t event)
+{
+	struct capi_timer_host_channel *ch = timer_host_channel(handle, chan);
+
+	if (!ch)
+		return -EINVAL;
+	if (event >= CAPI_TIMER_CHANNEL_EVENT_LIMIT)
+		return -EINVAL;
+
+	ch->irq_mask &= ~(1U << event);
+	ch->pending &= ~(1U << event);
+	timer_host_sync(handle->priv, handle);
+
+	return 0;
+}
+
+/**
+ * @brief Register a timer channel callback.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_timer_host_channel_register_callback(struct capi_timer_handle
+		*handle,
+		uint32_t chan,
+		capi_timer_channel_callback callback,
+		void *callback_arg)
+{
+	struct capi_timer_host_channel *ch = timer_host_channel(handle, chan);
+
+	if (!ch)
+		return -EINVAL;
+
+	ch->callback = callback;
+	ch->callback_arg = callback_arg;
+
+	return 0;
+}
+
+/**
+ * @brief Check whether an enabled timer event is latched.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_timer_host_is_irq_pending(struct capi_timer_handle *handle,
+		bool *pending)
+{
+	struct capi_timer_host_handle *th = timer_host_priv(handle);
+
+	if (!th || !pending)
+		return -EINVAL;
+
+	*pending = th->event_irq_enabled && th->overflow_pending;
+	for (uint32_t i = 0; i < CAPI_TIMER_HOST_NUM_CHANNELS; i++)
+		*pending |= (th->channels[i].pending & th->channels[i].irq_mask) != 0;
+
+	return 0;
+}
+
+/**
+ * @brief Clear the latched events and run their callbacks. Connected to the
+ *        host IRQ line when use_irq is set.
+ */
+static void capi_timer_host_isr(struct capi_timer_handle *handle)
+{
+	struct capi_timer_host_handle *th = timer_host_priv(handle);
+	struct capi_timer_host_channel *ch;
+	uint32_t status;
+
+	if (!th)
+		return;
+
+	for (uint32_t i = 0; i < CAPI_TIMER_HOST_NUM_CHANNELS; i++) {
+		ch = &th->channels[i];
+		status = ch->pending & ch->irq_mask;
+		ch->pending = 0;
+		if (!ch->callback)
+			continue;
+		if (status & (1U << CAPI_TIMER_CHANNEL_EVENT_COMPARE))
+			ch->callback(CAPI_TIMER_CHANNEL_EVENT_COMPARE, i,
+				     ch->callback_arg, 0);
+		if (status & (1U << CAPI_TIMER_CHANNEL_EVENT_CAPTURE))
+			ch->callback(CAPI_TIMER_CHANNEL_EVENT_CAPTURE, i,
+				     ch->callback_arg, 0);
+	}
+
+	if (th->overflow_pending) {
+		th->overflow_pending = false;
+		if (th->event_irq_enabled && th->event_callback)
+			th->event_callback(CAPI_TIMER_GLOBAL_EVENT_COUNTER_OVERFLOW,
+					   th->event_callback_arg, 0);
+	}
+}
+
+/**
+ * @brief Convert nanoseconds to timer ticks.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_timer_host_nsec_to_ticks(const struct capi_timer_handle
+		*handle,
+		uint64_t duration_ns, uint32_t *ticks)
+{
+	const struct capi_timer_host_handle *th = timer_host_priv(handle);
+	uint64_t result;
+
+	if (!th || !ticks)
+		return -EINVAL;
+
+	if (duration_ns / CAPI_TIMER_NSEC_PER_SEC > UINT32_MAX / th->tick_hz)
+		return -EOVERFLOW;
+
+	result = timer_host_ns_to_ticks(duration_ns, th->tick_hz);
+	if (result > UINT32_MAX)
+		return -EOVERFLOW;
+
+	*ticks = (uint32_t)result;
+	return 0;
+}
+
+/**
+ * @brief Convert timer ticks to nanoseconds.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_timer_host_ticks_to_nsec(const struct capi_timer_handle
+		*handle, uint64_t ticks,
+		uint32_t *duration_ns)
+{
+	const struct capi_timer_host_handle *th = timer_host_priv(handle);
+	uint64_t whole, result;
+
+	if (!th || !duration_ns)
+		return -EINVAL;
+
+	whole = ticks / th->tick_hz;
+	if (whole > UINT32_MAX / CAPI_TIMER_NSEC_PER_SEC)
+		return -EOVERFLOW;
+
+	result = whole * CAPI_TIMER_NSEC_PER_SEC +
+		 ticks % th->tick_hz * CAPI_TIMER_NSEC_PER_SEC / th->tick_hz;
+	if (result > UINT32_MAX)
+		return -EOVERFLOW;
+
+	*duration_ns = (uint32_t)result;
+	return 0;
+}
+
+int capi_timer_host_capture(struct capi_timer_handle *handle, uint32_t chan,
+			    bool rising)
+{
+	struct capi_timer_host_channel *ch = timer_host_channel(handle, chan);
+	struct capi_timer_host_handle *th;
+	uint8_t edge;
+
+	if (!ch)
+		return -EINVAL;
+	if (!ch->enabled || ch->config.mode != CAPI_TIMER_CAPTURE_MODE)
+		return 0;
+
+	edge = ch->config.config.capture.edge;
+	if ((edge == CAPI_TIMER_CAPTURE_RISING && !rising) ||
+	    (edge == CAPI_TIMER_CAPTURE_FALLING && rising))
+		return 0;
+
+	th = handle->priv;
+	ch->capture = timer_host_value(th, timer_host_pos(th));
+	ch->pending |= 1U << CAPI_TIMER_CHANNEL_EVENT_CAPTURE;
+	if (ch->irq_mask & (1U << CAPI_TIMER_CHANNEL_EVENT_CAPTURE))
+		timer_host_dispatch(th, handle);
+
+	return 0;
+}
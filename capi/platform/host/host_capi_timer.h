@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2026 Analog Devices, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * @brief Host platform simulated timer for CAPI
+ *
+ * Backend (select via config.ops):
+ *   capi_timer_host_ops  - simulated timer, 4 channels
+ *
+ * The counter is derived from the virtual clock. The tick rate is
+ * input_clock_hz (100 MHz if zero) divided by the smallest integer
+ * prescaler that does not exceed output_freq_hz, and at most 1 GHz.
+ *
+ * Counter overflows, compare matches and captures latch a pending flag and
+ * run the registered callbacks from the virtual clock, directly or through
+ * the host IRQ line irq_id when use_irq is set. Overflow and compare events
+ * are only scheduled while their interrupt is enabled, or for a compare
+ * channel with stop_enabled. Capture channels latch the counter when a
+ * model calls capi_timer_host_capture(). PWM channels only keep their
+ * configuration.
+ */
+
+#ifndef _HOST_CAPI_TIMER_H_
+#define _HOST_CAPI_TIMER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <capi_timer.h>
+#include <host_capi_sim.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Number of channels of the host timer */
+#define CAPI_TIMER_HOST_NUM_CHANNELS	4
+
+/**
+ * @struct capi_timer_host_config
+ * @brief Optional host timer configuration, passed via config->extra.
+ */
+struct capi_timer_host_config {
+	/** Run the callbacks through the host IRQ controller */
+	bool use_irq;
+	/** Host IRQ line, only valid if use_irq is true */
+	uint32_t irq_id;
+};
+
+/**
+ * @brief Signal an input capture edge on a channel. The counter is latched
+ *        if the channel is enabled in capture mode and the edge matches its
+ *        configuration.
+ * @param handle - Timer handle.
+ * @param chan - Channel.
+ * @param rising - True for a rising edge, false for a falling edge.
+ * @return 0 on success, negative errno on failure.
+ */
+int capi_timer_host_capture(struct capi_timer_handle *handle, uint32_t chan,
+			    bool rising);
+
+/**
+ * @brief Host timer operations table.
+ */
+extern const struct capi_timer_ops capi_timer_host_ops;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _HOST_CAPI_TIMER_H_ */
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2026 Analog Devices, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * @brief Host platform Timer private driver contract.
+ */
+
+#ifndef _HOST_CAPI_TIMER_PRIV_H_
+#define _HOST_CAPI_TIMER_PRIV_H_
+
+#include <host_capi_timer.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct capi_timer_host_channel
+ * @brief Per-channel state tracking.
+ */
+struct capi_timer_host_channel {
+	/** Channel has been initialized */
+	bool initialized;
+	/** Channel is running */
+	bool enabled;
+	/** Channel configuration */
+	struct capi_timer_channel_config config;
+	/** Compare value */
+	uint32_t compare;
+	/** Last captured counter value */
+	uint32_t capture;
+	/** Enabled events, bit per enum capi_timer_channel_event */
+	uint32_t irq_mask;
+	/** Latched events, bit per enum capi_timer_channel_event */
+	uint32_t pending;
+	/** User callback */
+	capi_timer_channel_callback callback;
+	/** Callback argument */
+	void *callback_arg;
+};
+
+/**
+ * @struct capi_timer_host_handle
+ * @brief Host timer private state.
+ *
+ * The counter position is kept as the number of ticks since the counter
+ * was last configured, independent of direction and limits.
+ */
+struct capi_timer_host_handle {
+	/** Host configuration */
+	struct capi_timer_host_config cfg;
+	/** Counter tick rate in Hz */
+	uint64_t tick_hz;
+	/** True once init completed */
+	bool initialized;
+	/** Counter is running */
+	bool running;
+	/** Counter direction */
+	uint32_t direction;
+	/** Counter limits */
+	uint32_t min;
+	uint32_t max;
+	/** Rollover enabled */
+	bool rollover;
+	/** Virtual time of the last start */
+	uint64_t origin_ns;
+	/** Counter position at origin_ns */
+	uint64_t origin_pos;
+	/** Counter position up to which events were handled */
+	uint64_t checked_pos;
+	/** Global event IRQ is logically enabled */
+	bool event_irq_enabled;
+	/** Overflow latched */
+	bool overflow_pending;
+	/** Per-channel state */
+	struct capi_timer_host_channel channels[CAPI_TIMER_HOST_NUM_CHANNELS];
+	/** Global timer event callback */
+	capi_timer_event_callback event_callback;
+	/** Event callback argument */
+	void *event_callback_arg;
+	/** Next overflow or compare match */
+	struct capi_host_event event;
+};
+
+/**
+ * @brief Declare a stack-allocated host Timer handle.
+ *
+ * Declares `name` (struct capi_timer_handle) with embedded private state.
+ * Pass &name to capi_timer_init().
+ */
+#define CAPI_TIMER_HANDLE_HOST_DEFINE(name)                            \
+	struct capi_timer_handle name = {                                  \
+		.ops = NULL,                                                   \
+		.init_allocated = false,                                       \
+		.priv = &(struct capi_timer_host_handle){0}                    \
+	}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _HOST_CAPI_TIMER_PRIV_H_ */
@@ -0,0 +1,1027 @@
+/*
+ * Copyright (c) 2026 Analog Devices, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * @brief Host simulated UART
+ *
+ * The TX side has a holding register in front of the shift register: a
+ * character can be written while the previous one is still on the line.
+ * The TX empty interrupt fires once per write (or per enable) when the
+ * holding register frees up, the RX interrupt once per batch of newly
+ * arrived characters, so handlers that leave the condition set do not
+ * re-trigger forever.
+ */
+
+#include <capi_alloc.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <string.h>
+#include <capi_uart.h>
+#include <host_capi_uart_priv.h>
+#include <host_capi_irq.h>
+
+#define UART_HOST_DEFAULT_BAUDRATE	115200U
+#define UART_HOST_DEFAULT_FIFO_SIZE	256U
+#define UART_HOST_DEFAULT_TIMEOUT_US	1000000U
+
+static int capi_uart_host_init(struct capi_uart_handle **handle,
+			       const struct capi_uart_config *config);
+static int capi_uart_host_deinit(struct capi_uart_handle *handle);
+static int capi_uart_host_get_line_config(struct capi_uart_handle *handle,
+		struct capi_uart_line_config *line_config);
+static int capi_uart_host_set_line_config(struct capi_uart_handle *handle,
+		struct capi_uart_line_config *line_config);
+static int capi_uart_host_enable_fifo(struct capi_uart_handle *handle,
+				      bool enable);
+static int capi_uart_host_flush_tx_fifo(struct capi_uart_handle *handle);
+static int capi_uart_host_flush_rx_fifo(struct capi_uart_handle *handle);
+static int capi_uart_host_get_rx_fifo_count(struct capi_uart_handle *handle,
+		uint16_t *count);
+static int capi_uart_host_get_tx_fifo_count(struct capi_uart_handle *handle,
+		uint16_t *count);
+static int capi_uart_host_transmit(struct capi_uart_handle *handle,
+				   uint8_t *buf, uint32_t len);
+static int capi_uart_host_receive(struct capi_uart_handle *handle,
+				  uint8_t *buf, uint32_t len);
+static int capi_uart_host_register_callback(struct capi_uart_handle *handle,
+		capi_uart_callback const callback, void *const callback_arg);
+static int capi_uart_host_transmit_async(struct capi_uart_handle *handle,
+		uint8_t *buf, uint32_t len);
+static int capi_uart_host_receive_async(struct capi_uart_handle *handle,
+					uint8_t *buf, uint32_t len);
+static int capi_uart_host_get_interrupt_reason(struct capi_uart_handle *handle,
+		enum capi_uart_interrupt_reason *reason);
+static int capi_uart_host_get_line_status(struct capi_uart_handle *handle,
+		uint32_t *status_flags);
+static int capi_uart_host_transmit_9bit(struct capi_uart_handle *handle,
+					uint16_t data, bool is_address);
+static int capi_uart_host_receive_9bit(struct capi_uart_handle *handle,
+				       uint16_t *data, bool *is_address);
+static int capi_uart_host_set_flow_control_state(struct capi_uart_handle
+		*handle, bool rts_state, bool cts_state);
+static int capi_uart_host_get_flow_control_state(struct capi_uart_handle
+		*handle, bool *rts_state, bool *cts_state);
+static void capi_uart_host_isr(void *handle);
+static uint32_t capi_uart_host_read_byte(struct capi_uart_handle *handle,
+		uint8_t *byte);
+static uint32_t capi_uart_host_write_byte(struct capi_uart_handle *handle,
+		uint8_t byte);
+static int capi_uart_host_set_irq_tx(struct capi_uart_handle *handle,
+				     bool enable);
+static int capi_uart_host_irq_tx_ready(struct capi_uart_handle *handle,
+				       bool *ready);
+static int capi_uart_host_irq_tx_complete(struct capi_uart_handle *handle,
+		bool *complete);
+static int capi_uart_host_set_irq_rx(struct capi_uart_handle *handle,
+				     bool enable);
+static int capi_uart_host_irq_rx_ready(struct capi_uart_handle *handle,
+				       bool *ready);
+static int capi_uart_host_set_irq_err(struct capi_uart_handle *handle,
+				      bool enable);
+static int capi_uart_host_is_irq_pending(struct capi_uart_handle *handle,
+		bool *pending);
+
+const struct capi_uart_ops capi_uart_host_ops = {
+	.init = capi_uart_host_init,
+	.deinit = capi_uart_host_deinit,
+	.get_line_config = capi_uart_host_get_line_config,
+	.set_line_config = capi_uart_host_set_line_config,
+	.enable_fifo = capi_uart_host_enable_fifo,
+	.flush_tx_fifo = capi_uart_host_flush_tx_fifo,
+	.flush_rx_fifo = capi_uart_host_flush_rx_fifo,
+	.get_rx_fifo_count = capi_uart_host_get_rx_fifo_count,
+	.get_tx_fifo_count = capi_uart_host_get_tx_fifo_count,
+	.transmit = capi_uart_host_transmit,
+	.receive = capi_uart_host_receive,
+	.register_callback = capi_uart_host_register_callback,
+	.transmit_async = capi_uart_host_transmit_async,
+	.receive_async = capi_uart_host_receive_async,
+	.get_interrupt_reason = capi_uart_host_get_interrupt_reason,
+	.get_line_status = capi_uart_host_get_line_status,
+	.transmit_9bit = capi_uart_host_transmit_9bit,
+	.receive_9bit = capi_uart_host_receive_9bit,
+	.set_flow_control_state = capi_uart_host_set_flow_control_state,
+	.get_flow_control_state = capi_uart_host_get_flow_control_state,
+	.isr = capi_uart_host_isr,
+	.read_byte = capi_uart_host_read_byte,
+	.write_byte = capi_uart_host_write_byte,
+	.set_irq_tx = capi_uart_host_set_irq_tx,
+	.irq_tx_ready = capi_uart_host_irq_tx_ready,
+	.irq_tx_complete = capi_uart_host_irq_tx_complete,
+	.set_irq_rx = capi_uart_host_set_irq_rx,
+	.irq_rx_ready = capi_uart_host_irq_rx_ready,
+	.set_irq_err = capi_uart_host_set_irq_err,
+	.is_irq_pending = capi_uart_host_is_irq_pending,
+};
+
+static struct capi_uart_host_handle *uart_host_priv(
+	const struct capi_uart_handle *handle)
+{
+	struct capi_uart_host_handle *uh;
+
+	if (handle == NULL)
+		return NULL;
+
+	uh = handle->priv;
+	if (uh == NULL || !uh->initialized)
+		return NULL;
+
+	return uh;
+}
+
+static int uart_host_char_ns(const struct capi_uart_line_config *line,
+			     uint64_t *char_ns)
+{
+	uint32_t bits;
+
+	if (line->baudrate == 0 || (uint32_t)line->size > CAPI_UART_DATA_BITS_5 ||
+	    (uint32_t)line->parity > CAPI_UART_PARITY_EVEN ||
+	    (uint32_t)line->stop_bits > CAPI_UART_STOP_2_BIT)
+		return -EINVAL;
+
+	/* enum capi_uart_data_bits counts down from 8 data bits. */
+	bits = 1 + (8 - (uint32_t)line->size);
+	if (line->parity != CAPI_UART_PARITY_NONE)
+		bits++;
+	bits += line->stop_bits == CAPI_UART_STOP_2_BIT ? 2 : 1;
+
+	*char_ns = capi_host_cycles_to_ns(bits, line->baudrate);
+
+	return 0;
+}
+
+static uint16_t uart_host_rx_index(const struct capi_uart_host_handle *uh,
+				   uint16_t pos)
+{
+	return (uint16_t)((uh->rx_head + pos) % uh->cfg.rx_fifo_size);
+}
+
+/**
+ * @brief Characters of the RX FIFO that have completely arrived.
+ */
+static uint16_t uart_host_rx_avail(const struct capi_uart_host_handle *uh)
+{
+	uint64_t now = capi_host_sim_now();
+	uint16_t n;
+
+	for (n = 0; n < uh->rx_count; n++)
+		if (uh->rx_time[uart_host_rx_index(uh, n)] > now)
+			break;
+
+	return n;
+}
+
+static void uart_host_rx_pop(struct capi_uart_host_handle *uh, uint8_t *buf,
+			     uint32_t len)
+{
+	for (uint32_t i = 0; i < len; i++) {
+		buf[i] = uh->rx_data[uh->rx_head];
+		uh->rx_head = uart_host_rx_index(uh, 1);
+		uh->rx_count--;
+		if (uh->rx_signaled)
+			uh->rx_signaled--;
+	}
+}
+
+/** Holding register free: at most the shift register is still busy. */
+static bool uart_host_tx_ready(const struct capi_uart_host_handle *uh)
+{
+	return uh->tx_busy_until <= capi_host_sim_now() + uh->char_ns;
+}
+
+static void uart_host_event_fire(struct capi_host_event *event);
+
+/**
+ * @brief Schedule the next completion or interrupt condition.
+ */
+static void uart_host_kick(struct capi_uart_host_handle *uh,
+			   struct capi_uart_handle *h)
+{
+	uint64_t now = capi_host_sim_now();
+	uint64_t when = UINT64_MAX;
+	uint64_t t;
+
+	if (uh->tx_async && uh->tx_busy_until < when)
+		when = uh->tx_busy_until;
+	if (uh->irq_tx && uh->tx_armed) {
+		t = uh->tx_busy_until > uh->char_ns ?
+		    uh->tx_busy_until - uh->char_ns : 0;
+		if (t < when)
+			when = t;
+	}
+	if (uh->rx_async && uh->rx_count >= uh->rx_async_len) {
+		t = uh->rx_time[uart_host_rx_index(uh, uh->rx_async_len - 1)];
+		if (t < when)
+			when = t;
+	}
+	if (uh->irq_rx && uh->rx_signaled < uh->rx_count) {
+		t = uh->rx_time[uart_host_rx_index(uh, uh->rx_signaled)];
+		if (t < when)
+			when = t;
+	}
+	if (uh->irq_err && uh->err_pending)
+		when = now;
+
+	if (when == UINT64_MAX) {
+		capi_host_sim_cancel(&uh->event);
+		return;
+	}
+
+	uh->event.fire = uart_host_event_fire;
+	uh->event.arg = h;
+	capi_host_sim_schedule(&uh->event, when > now ? when : now);
+}
+
+/**
+ * @brief Run the completions and report one interrupt condition that are
+ *        due at the current virtual time.
+ */
+static void uart_host_service(struct capi_uart_host_handle *uh,
+			      struct capi_uart_handle *h)
+{
+	enum capi_uart_interrupt_reason reason = CAPI_UART_INTR_NONE;
+	uint16_t avail;
+
+	if (uh->tx_async && uh->tx_busy_until <= capi_host_sim_now()) {
+		uh->tx_async = false;
+		if (uh->callback != NULL)
+			uh->callback(CAPI_UART_EVENT_TX_DONE, uh->callback_arg, 0);
+	}
+
+	if (uh->rx_async && uart_host_rx_avail(uh) >= uh->rx_async_len) {
+		uart_host_rx_pop(uh, uh->rx_async_buf, uh->rx_async_len);
+		uh->rx_async = false;
+		if (uh->callback != NULL)
+			uh->callback(CAPI_UART_EVENT_RX_DONE, uh->callback_arg, 0);
+	}
+
+	avail = uart_host_rx_avail(uh);
+	if (uh->irq_err && uh->err_pending) {
+		uh->err_pending = false;
+		reason = CAPI_UART_INTR_RX_LINE_STATUS;
+	} else if (uh->irq_rx && avail > uh->rx_signaled) {
+		uh->rx_signaled = avail;
+		reason = CAPI_UART_INTR_RX_BUFFER_FULL;
+	} else if (uh->irq_tx && uh->tx_armed && uart_host_tx_ready(uh)) {
+		uh->tx_armed = false;
+		reason = CAPI_UART_INTR_TX_BUFFER_EMPTY;
+	}
+
+	if (reason != CAPI_UART_INTR_NONE) {
+		uh->reason = reason;
+		if (uh->callback != NULL)
+			uh->callback(CAPI_UART_EVENT_INTERRUPT, uh->callback_arg, reason);
+	}
+
+	uart_host_kick(uh, h);
+}
+
+static void uart_host_event_fire(struct capi_host_event *event)
+{
+	struct capi_uart_handle *h = event->arg;
+	struct capi_uart_host_handle *uh = h->priv;
+
+	if (uh->cfg.use_irq)
+		(void)capi_irq_host_set_pending(uh->cfg.irq_id);
+	else
+		uart_host_service(uh, h);
+}
+
+static void uart_host_rx_push(struct capi_uart_host_handle *uh,
+			      const uint8_t *buf, uint32_t len)
+{
+	uint64_t t = uh->rx_line_free_ns;
+	uint16_t idx;
+
+	if (t < capi_host_sim_now())
+		t = capi_host_sim_now();
+
+	for (uint32_t i = 0; i < len; i++) {
+		t += uh->char_ns;
+		uh->stats.bytes++;
+		if (uh->rx_count >= uh->cfg.rx_fifo_size) {
+			uh->line_status |= CAPI_UART_LINE_STAT_OVERRUN_ERROR;
+			uh->err_pending = true;
+			uh->stats.errors++;
+			continue;
+		}
+
+		idx = uart_host_rx_index(uh, uh->rx_count);
+		uh->rx_data[idx] = buf[i];
+		uh->rx_time[idx] = t;
+		uh->rx_count++;
+	}
+
+	uh->rx_line_free_ns = t;
+}
+
+/**
+ * @brief Put characters on the TX line.
+ * @return Virtual time the last character leaves the line.
+ */
+static uint64_t uart_host_tx(struct capi_uart_host_handle *uh,
+			     const uint8_t *buf, uint32_t len)
+{
+	uint64_t start = uh->tx_busy_until;
+
+	if (start < capi_host_sim_now())
+		start = capi_host_sim_now();
+
+	if (uh->cfg.tx_sink != NULL)
+		uh->cfg.tx_sink(uh->cfg.tx_sink_arg, buf, len);
+	if (uh->line.loopback)
+		uart_host_rx_push(uh, buf, len);
+
+	capi_host_bus_account(&uh->stats, len, (uint64_t)len * uh->char_ns, true);
+	uh->tx_busy_until = start + (uint64_t)len * uh->char_ns;
+	uh->tx_armed = true;
+
+	return uh->tx_busy_until;
+}
+
+/**
+ * @brief Initialize the CAPI backend instance. Without a line
+ *        configuration the UART runs at 115200 baud, 8N1.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_uart_host_init(struct capi_uart_handle **handle,
+			       const struct capi_uart_config *config)
+{
+	if (handle == NULL || config == NULL)
+		return -EINVAL;
+	if (*handle != NULL &&
+	    ((*handle)->ops != NULL ||
+	     ((*handle)->priv != NULL &&
+	      ((struct capi_uart_host_handle *)(*handle)->priv)->initialized)))
+		return -EBUSY;
+	if (config->dma_handle != NULL)
+		return -ENOTSUP;
+
+	bool alloc = (*handle == NULL);
+	struct capi_uart_handle *h = *handle;
+	struct capi_uart_host_handle *uh;
+	int ret;
+
+	if (alloc) {
+		h = capi_calloc(1, sizeof(*h));
+		if (h == NULL)
+			return -ENOMEM;
+
+		uh = capi_malloc(sizeof(*uh));
+		if (uh == NULL) {
+			capi_free(h);
+			return -ENOMEM;
+		}
+		h->priv = uh;
+	} else {
+		uh = h->priv;
+		if (uh == NULL)
+			return -EINVAL;
+	}
+
+	memset(uh, 0, sizeof(*uh));
+	if (config->extra != NULL)
+		uh->cfg = *(const struct capi_uart_host_config *)config->extra;
+	if (uh->cfg.rx_fifo_size == 0)
+		uh->cfg.rx_fifo_size = UART_HOST_DEFAULT_FIFO_SIZE;
+	if (uh->cfg.rx_timeout_us == 0)
+		uh->cfg.rx_timeout_us = UART_HOST_DEFAULT_TIMEOUT_US;
+
+	if (config->line_config != NULL)
+		uh->line = *config->line_config;
+	else
+		uh->line.baudrate = UART_HOST_DEFAULT_BAUDRATE;
+
+	ret = uart_host_char_ns(&uh->line, &uh->char_ns);
+	if (ret)
+		goto err_handle;
+
+	uh->rx_data = capi_calloc(uh->cfg.rx_fifo_size, sizeof(*uh->rx_data));
+	uh->rx_time = capi_calloc(uh->cfg.rx_fifo_size, sizeof(*uh->rx_time));
+	if (uh->rx_data == NULL || uh->rx_time == NULL) {
+		ret = -ENOMEM;
+		goto err_fifo;
+	}
+
+	if (uh->cfg.use_irq) {
+		ret = capi_irq_connect(uh->cfg.irq_id, capi_uart_host_isr, h);
+		if (ret == 0)
+			ret = capi_irq_enable(uh->cfg.irq_id);
+		if (ret)
+			goto err_fifo;
+	}
+
+	uh->stats.since_ns = capi_host_sim_now();
+	uh->reason = CAPI_UART_INTR_NONE;
+	uh->initialized = true;
+	h->init_allocated = alloc;
+	h->ops = config->ops ? config->ops : &capi_uart_host_ops;
+	*handle = h;
+
+	return 0;
+
+err_fifo:
+	capi_free(uh->rx_data);
+	capi_free(uh->rx_time);
+err_handle:
+	if (alloc) {
+		capi_free(uh);
+		capi_free(h);
+	}
+	return ret;
+}
+
+/**
+ * @brief Deinitialize the CAPI backend instance. Transfers in flight are
+ *        dropped without callback.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_uart_host_deinit(struct capi_uart_handle *handle)
+{
+	struct capi_uart_host_handle *uh;
+
+	if (handle == NULL || handle->priv == NULL)
+		return -EINVAL;
+
+	uh = handle->priv;
+	capi_host_sim_cancel(&uh->event);
+	if (uh->cfg.use_irq)
+		(void)capi_irq_disable(uh->cfg.irq_id);
+	capi_free(uh->rx_data);
+	capi_free(uh->rx_time);
+	uh->rx_data = NULL;
+	uh->rx_time = NULL;
+	uh->initialized = false;
+
+	if (handle->init_allocated) {
+		capi_free(uh);
+		capi_free(handle);
+	} else {
+		handle->ops = NULL;
+	}
+
+	return 0;
+}
+
+static int capi_uart_host_get_line_config(struct capi_uart_handle *handle,
+		struct capi_uart_line_config *line_config)
+{
+	struct capi_uart_host_handle *uh = uart_host_priv(handle);
+
+	if (uh == NULL || line_config == NULL)
+		return -EINVAL;
+
+	*line_config = uh->line;
+
+	return 0;
+}
+
+static int capi_uart_host_set_line_config(struct capi_uart_handle *handle,
+		struct capi_uart_line_config *line_config)
+{
+	struct capi_uart_host_handle *uh = uart_host_priv(handle);
+	uint64_t char_ns;
+	int ret;
+
+	if (uh == NULL || line_config == NULL)
+		return -EINVAL;
+	if (line_config->address_mode != CAPI_UART_ADDRESS_MODE_DISABLED)
+		return -ENOTSUP;
+
+	ret = uart_host_char_ns(line_config, &char_ns);
+	if (ret)
+		return ret;
+
+	uh->line = *line_config;
+	uh->char_ns = char_ns;
+
+	return 0;
+}
+
+/**
+ * @brief The RX FIFO depth is fixed by rx_fifo_size; accepted for
+ *        compatibility.
+ */
+static int capi_uart_host_enable_fifo(struct capi_uart_handle *handle,
+				      bool enable)
+{
+	(void)enable;
+
+	return uart_host_priv(handle) ? 0 : -EINVAL;
+}
+
+/**
+ * @brief Drop the characters still waiting on the TX line.
+ */
+static int capi_uart_host_flush_tx_fifo(struct capi_uart_handle *handle)
+{
+	struct capi_uart_host_handle *uh = uart_host_priv(handle);
+	uint64_t now;
+
+	if (uh == NULL)
+		return -EINVAL;
+
+	/* The character in the shift register still completes. */
+	now = capi_host_sim_now();
+	if (uh->tx_busy_until > now + uh->char_ns)
+		uh->tx_busy_until = now + uh->char_ns;
+	uart_host_kick(uh, handle);
+
+	return 0;
+}
+
+static int capi_uart_host_flush_rx_fifo(struct capi_uart_handle *handle)
+{
+	struct capi_uart_host_handle *uh = uart_host_priv(handle);
+
+	if (uh == NULL)
+		return -EINVAL;
+
+	uh->rx_head = 0;
+	uh->rx_count = 0;
+	uh->rx_signaled = 0;
+	uart_host_kick(uh, handle);
+
+	return 0;
+}
+
+static int capi_uart_host_get_rx_fifo_count(struct capi_uart_handle *handle,
+		uint16_t *count)
+{
+	struct capi_uart_host_handle *uh = uart_host_priv(handle);
+
+	if (uh == NULL || count == NULL)
+		return -EINVAL;
+
+	*count = uart_host_rx_avail(uh);
+
+	return 0;
+}
+
+static int capi_uart_host_get_tx_fifo_count(struct capi_uart_handle *handle,
+		uint16_t *count)
+{
+	struct capi_uart_host_handle *uh = uart_host_priv(handle);
+	uint64_t now, pending;
+
+	if (uh == NULL || count == NULL)
+		return -EINVAL;
+
+	now = capi_host_sim_now();
+	pending = uh->tx_busy_until > now ?
+		  (uh->tx_busy_until - now + uh->char_ns - 1) / uh->char_ns : 0;
+	*count = pending > UINT16_MAX ? UINT16_MAX : (uint16_t)pending;
+
+	return 0;
+}
+
+/**
+ * @brief Blocking transmit: returns once the last character left the
+ *        line.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_uart_host_transmit(struct capi_uart_handle *handle,
+				   uint8_t *buf, uint32_t len)
+{
+	struct capi_uart_host_handle *uh = uart_host_priv(handle);
+	uint64_t end;
+
+	if (uh == NULL || (buf == NULL && len > 0))
+		return -EINVAL;
+	if (uh->tx_async)
+		return -EBUSY;
+	if (len == 0)
+		return 0;
+
+	capi_host_sim_enter();
+	end = uart_host_tx(uh, buf, len);
+	uh->tx_armed = false;
+	capi_host_sim_advance(end - capi_host_sim_now());
+	uart_host_kick(uh, handle);
+	capi_host_sim_exit();
+
+	return 0;
+}
+
+/**
+ * @brief Blocking receive. Waits for characters in flight; with nothing in
+ *        flight, gives up after rx_timeout_us of virtual time.
+ *
+ * @return 0 on success, -ETIMEDOUT if the data did not arrive.
+ */
+static int capi_uart_host_receive(struct capi_uart_handle *handle,
+				  uint8_t *buf, uint32_t len)
+{
+	struct capi_uart_host_handle *uh = uart_host_priv(handle);
+	uint64_t deadline, now, t;
+	uint16_t avail;
+	int ret = 0;
+
+	if (uh == NULL || (buf == NULL && len > 0))
+		return -EINVAL;
+	if (uh->rx_async)
+		return -EBUSY;
+	if (len > uh->cfg.rx_fifo_size)
+		return -EINVAL;
+
+	capi_host_sim_enter();
+	deadline = capi_host_sim_now() + (uint64_t)uh->cfg.rx_timeout_us * 1000U;
+	while ((avail = uart_host_rx_avail(uh)) < len) {
+		now = capi_host_sim_now();
+		if (uh->rx_count > avail) {
+			/* Wait for the characters already on the line. */
+			t = uh->rx_time[uart_host_rx_index(uh,
+					(uh->rx_count < len ? uh->rx_count : len) - 1)];
+			capi_host_sim_advance(t - now);
+			deadline = capi_host_sim_now() +
+				   (uint64_t)uh->cfg.rx_timeout_us * 1000U;
+		} else if (now >= deadline) {
+			ret = -ETIMEDOUT;
+			break;
+		} else {
+			/* Let peer models run, one character time at a time. */
+			t = deadline - now;
+			capi_host_sim_advance(t < uh->char_ns ? t : uh->char_ns);
+		}
+	}
+
+	if (!ret)
+		uart_host_rx_pop(uh, buf, len);
+	uart_host_kick(uh, handle);
+	capi_host_sim_exit();
+
+	return ret;
+}
+
+static int capi_uart_host_register_callback(struct capi_uart_handle *handle,
+		capi_uart_callback const callback, void *const callback_arg)
+{
+	if (handle == NULL || handle->priv == NULL)
+		return -EINVAL;
+
+	struct capi_uart_host_handle *uh = handle->priv;
+	uh->callback = callback;
+	uh->callback_arg = callback_arg;
+
+	return 0;
+}
+
+/**
+ * @brief Start a transmit completing with CAPI_UART_EVENT_TX_DONE once the
+ *        last character left the line.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_uart_host_transmit_async(struct capi_uart_handle *handle,
+		uint8_t *buf, uint32_t len)
+{
+	struct capi_uart_host_handle *uh = uart_host_priv(handle);
+
+	if (uh == NULL || buf == NULL || len == 0)
+		return -EINVAL;
+	if (uh->tx_async)
+		return -EBUSY;
+
+	capi_host_sim_enter();
+	uart_host_tx(uh, buf, len);
+	uh->tx_armed = false;
+	uh->tx_async = true;
+	uart_host_kick(uh, handle);
+	capi_host_sim_exit();
+
+	return 0;
+}
+
+/**
+ * @brief Start a receive completing with CAPI_UART_EVENT_RX_DONE once len
+ *        characters arrived.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+static int capi_uart_host_receive_async(struct capi_uart_handle *handle,
+					uint8_t *buf, uint32_t len)
+{
+	struct capi_uart_host_handle *uh = uart_host_priv(handle);
+
+	if (uh == NULL || buf == NULL || len == 0)
+		return -EINVAL;
+	if (len > uh->cfg.rx_fifo_size)
+		return -EINVAL;
+	if (uh->rx_async)
+		return -EBUSY;
+
+	capi_host_sim_enter();
+	uh->rx_async_buf = buf;
+	uh->rx_async_len = len;
+	uh->rx_async = true;
+	uart_host_kick(uh, handle);
+	capi_host_sim_exit();
+
+	return 0;
+}
+
+static int capi_uart_host_get_interrupt_reason(struct capi_uart_handle *handle,
+		enum capi_uart_interrupt_reason *reason)
+{
+	struct capi_uart_host_handle *uh = uart_host_priv(handle);
+
+	if (uh == NULL || reason == NULL)
+		return -EINVAL;
+
+	*reason = uh->reason;
+
+	return 0;
+}
+
+/**
+ * @brief Get and clear the sticky line status flags.
+ */
+static int capi_uart_host_get_line_status(struct capi_uart_handle *handle,
+		uint32_t *status_flags)
+{
+	struct capi_uart_host_handle *uh = uart_host_priv(handle);
+
+	if (uh == NULL || status_flags == NULL)
+		return -EINVAL;
+
+	*status_flags = uh->line_status;
+	uh->line_status = 0;
+
+	return 0;
+}
+
+/**
+ * @brief 9-bit address mode is not simulated.
+ *
+ * @return -ENOTSUP.
+ */
+static int capi_uart_host_transmit_9bit(struct capi_uart_handle *handle,
+					uint16_t data, bool is_address)
+{
+	(void)handle;
+	(void)data;
+	(void)is_address;
+
+	return -ENOTSUP;
+}
+
+/**
+ * @brief 9-bit address mode is not simulated.
+ *
+ * @return -ENOTSUP.
+ */
+static int capi_uart_host_receive_9bit(struct capi_uart_handle *handle,
+				       uint16_t *data, bool *is_address)
+{
+	(void)handle;
+	(void)data;
+	(void)is_address;
+
+	return -ENOTSUP;
+}
+
+/**
+ * @brief Store the RTS/CTS states. Flow control does not throttle the
+ *        simulated line.
+ */
+static int capi_uart_host_set_flow_control_state(struct capi_uart_handle
+		*handle, bool rts_state, bool cts_state)
+{
+	struct capi_uart_host_handle *uh = uart_host_priv(handle);
+
+	if (uh == NULL)
+		return -EINVAL;
+
+	uh->rts = rts_state;
+	uh->cts = cts_state;
+
+	return 0;
+}
+
+static int capi_uart_host_get_flow_control_state(struct capi_uart_handle
+		*handle, bool *rts_state, bool *cts_state)
+{
+	struct capi_uart_host_handle *uh = uart_host_priv(handle);
+
+	if (uh == NULL || rts_state == NULL || cts_state == NULL)
+		return -EINVAL;
+
+	*rts_state = uh->rts;
+	*cts_state = uh->cts;
+
+	return 0;
+}
+
+/**
+ * @brief Run the due completions and interrupts. Connected to the host
+ *        IRQ line when use_irq is set.
+ */
+static void capi_uart_host_isr(void *handle)
+{
+	struct capi_uart_handle *h = handle;
+	struct capi_uart_host_handle *uh = uart_host_priv(h);
+
+	if (uh == NULL)
+		return;
+
+	uart_host_service(uh, h);
+}
+
+/**
+ * @brief Read one character. Polling an empty FIFO spins until the next
+ *        character in flight arrives, if any.
+ *
+ * @return 1 if a character was read, 0 otherwise.
+ */
+static uint32_t capi_uart_host_read_byte(struct capi_uart_handle *handle,
+		uint8_t *byte)
+{
+	struct capi_uart_host_handle *uh = uart_host_priv(handle);
+	uint64_t t;
+
+	if (uh == NULL || byte == NULL || uh->rx_count == 0)
+		return 0;
+
+	capi_host_sim_enter();
+	t = uh->rx_time[uh->rx_head];
+	if (t > capi_host_sim_now())
+		capi_host_sim_advance(t - capi_host_sim_now());
+	uart_host_rx_pop(uh, byte, 1);
+	uart_host_kick(uh, handle);
+	capi_host_sim_exit();
+
+	return 1;
+}
+
+/**
+ * @brief Write one character. Waits for the holding register to free up.
+ *
+ * @return 1 if the character was written, 0 otherwise.
+ */
+static uint32_t capi_uart_host_write_byte(struct capi_uart_handle *handle,
+		uint8_t byte)
+{
+	struct capi_uart_host_handle *uh = uart_host_priv(handle);
+	uint64_t now;
+
+	if (uh == NULL || uh->tx_async)
+		return 0;
+
+	capi_host_sim_enter();
+	now = capi_host_sim_now();
+	if (uh->tx_busy_until > now + uh->char_ns)
+		capi_host_sim_advance(uh->tx_busy_until - uh->char_ns - now);
+	uart_host_tx(uh, &byte, 1);
+	uart_host_kick(uh, handle);
+	capi_host_sim_exit();
+
+	return 1;
+}
+
+static int capi_uart_host_set_irq_tx(struct capi_uart_handle *handle,
+				     bool enable)
+{
+	struct capi_uart_host_handle *uh = uart_host_priv(handle);
+
+	if (uh == NULL)
+		return -EINVAL;
+
+	uh->irq_tx = enable;
+	uh->tx_armed = enable;
+	uart_host_kick(uh, handle);
+
+	return 0;
+}
+
+static int capi_uart_host_irq_tx_ready(struct capi_uart_handle *handle,
+				       bool *ready)
+{
+	struct capi_uart_host_handle *uh = uart_host_priv(handle);
+
+	if (uh == NULL || ready == NULL)
+		return -EINVAL;
+
+	*ready = !uh->tx_async && uart_host_tx_ready(uh);
+
+	return 0;
+}
+
+static int capi_uart_host_irq_tx_complete(struct capi_uart_handle *handle,
+		bool *complete)
+{
+	struct capi_uart_host_handle *uh = uart_host_priv(handle);
+
+	if (uh == NULL || complete == NULL)
+		return -EINVAL;
+
+	*complete = uh->tx_busy_until <= capi_host_sim_now();
+
+	return 0;
+}
+
+static int capi_uart_host_set_irq_rx(struct capi_uart_handle *handle,
+				     bool enable)
+{
+	struct capi_uart_host_handle *uh = uart_host_priv(handle);
+
+	if (uh == NULL)
+		return -EINVAL;
+
+	uh->irq_rx = enable;
+	/* Characters already waiting are reported on enable. */
+	if (enable)
+		uh->rx_signaled = 0;
+	uart_host_kick(uh, handle);
+
+	return 0;
+}
+
+static int capi_uart_host_irq_rx_ready(struct capi_uart_handle *handle,
+				       bool *ready)
+{
+	struct capi_uart_host_handle *uh = uart_host_priv(handle);
+
+	if (uh == NULL || ready == NULL)
+		return -EINVAL;
+
+	*ready = uart_host_rx_avail(uh) > 0;
+
+	return 0;
+}
+
+static int capi_uart_host_set_irq_err(struct capi_uart_handle *handle,
+				      bool enable)
+{
+	struct capi_uart_host_handle *uh = uart_host_priv(handle);
+
+	if (uh == NULL)
+		return -EINVAL;
+
+	uh->irq_err = enable;
+	uart_host_kick(uh, handle);
+
+	return 0;
+}
+
+static int capi_uart_host_is_irq_pending(struct capi_uart_handle *handle,
+		bool *pending)
+{
+	struct capi_uart_host_handle *uh = uart_host_priv(handle);
+
+	if (uh == NULL || pending == NULL)
+		return -EINVAL;
+
+	*pending = (uh->irq_rx && uart_host_rx_avail(uh) > 0) ||
+		   (uh->irq_tx && uart_host_tx_ready(uh)) ||
+		   (uh->irq_err && uh->line_status != 0);
+
+	return 0;
+}
+
+int capi_uart_host_inject(struct capi_uart_handle *handle, const uint8_t *buf,
+			  uint32_t len)
+{
+	struct capi_uart_host_handle *uh = uart_host_priv(handle);
+
+	if (uh == NULL || (buf == NULL && len > 0))
+		return -EINVAL;
+
+	uart_host_rx_push(uh, buf, len);
+	uart_host_kick(uh, handle);
+
+	return 0;
+}
+
+int capi_uart_host_get_stats(struct capi_uart_handle *handle,
+			     struct capi_host_bus_stats *stats)
+{
+	if (handle == NULL || handle->priv == NULL || stats == NULL)
+		return -EINVAL;
+
+	*stats = ((struct capi_uart_host_handle *)handle->priv)->stats;
+
+	return 0;
+}
+
+int capi_uart_host_reset_stats(struct capi_uart_handle *handle)
+{
+	struct capi_uart_host_handle *uh;
+
+	if (handle == NULL || handle->priv == NULL)
+		return -EINVAL;
+
+	uh = handle->priv;
+	uh->stats = (struct capi_host_bus_stats) {
+		.since_ns = capi_host_sim_now(),
+	};
+
+	return 0;
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2026 Analog Devices, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * @brief Host platform simulated UART for CAPI
+ *
+ * Backend (select via config.ops):
+ *   capi_uart_host_ops  - simulated UART
+ *
+ * Characters take (1 start + data + parity + stop) bits / baudrate on the
+ * line. Transmitted data goes to the tx_sink of the peer model as soon as
+ * it is written, and the TX line stays busy for the modeled time: blocking
+ * transmits advance the virtual clock, async transmits and the TX empty
+ * interrupt complete when the line frees up. Data from the peer is queued
+ * with capi_uart_host_inject() and arrives back to back at the line rate.
+ * With line_config->loopback set, transmitted data is also injected.
+ *
+ * Completions and the RX, TX empty and line status interrupts run the
+ * driver callback from the virtual clock, directly or through the host
+ * IRQ line irq_id when use_irq is set.
+ *
+ * Statistics cover the TX line; bytes also count received characters,
+ * errors count RX overruns.
+ */
+
+#ifndef _HOST_CAPI_UART_H_
+#define _HOST_CAPI_UART_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <capi_uart.h>
+#include <host_capi_sim.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Peer model receiving the transmitted data.
+ * @param arg - tx_sink_arg.
+ * @param buf - Transmitted characters.
+ * @param len - Number of characters.
+ */
+typedef void (*capi_uart_host_sink)(void *arg, const uint8_t *buf,
+				    uint32_t len);
+
+/**
+ * @struct capi_uart_host_config
+ * @brief Optional host UART configuration, passed via config->extra.
+ */
+struct capi_uart_host_config {
+	/** RX FIFO depth in characters, 0 for 256 */
+	uint16_t rx_fifo_size;
+	/** Blocking receive timeout with no data in flight, 0 for 1 s */
+	uint32_t rx_timeout_us;
+	/** Optional peer receiving the transmitted data */
+	capi_uart_host_sink tx_sink;
+	/** Peer argument */
+	void *tx_sink_arg;
+	/** Run completions and interrupts through the host IRQ controller */
+	bool use_irq;
+	/** Host IRQ line, only valid if use_irq is true */
+	uint32_t irq_id;
+};
+
+/**
+ * @brief Send characters from the peer. They arrive back to back at the
+ *        line rate, after the characters already in flight. Characters
+ *        that find the RX FIFO full are dropped with an overrun error.
+ * @return 0 on success, negative errno on failure.
+ */
+int capi_uart_host_inject(struct capi_uart_handle *handle, const uint8_t *buf,
+			  uint32_t len);
+
+/**
+ * @brief Get the statistics of the UART.
+ * @return 0 on success, negative errno on failure.
+ */
+int capi_uart_host_get_stats(struct capi_uart_handle *handle,
+			     struct capi_host_bus_stats *stats);
+
+/**
+ * @brief Reset the statistics of the UART.
+ * @return 0 on success, negative errno on failure.
+ */
+int capi_uart_host_reset_stats(struct capi_uart_handle *handle);
+
+/**
+ * @brief Host UART operations table.
+ */
+extern const struct capi_uart_ops capi_uart_host_ops;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _HOST_CAPI_UART_H_ */
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2026 Analog Devices, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * @brief Host platform UART private driver contract.
+ */
+
+#ifndef _HOST_CAPI_UART_PRIV_H_
+#define _HOST_CAPI_UART_PRIV_H_
+
+#include <host_capi_uart.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct capi_uart_host_handle
+ * @brief Host UART private state.
+ */
+struct capi_uart_host_handle {
+	/** Host configuration */
+	struct capi_uart_host_config cfg;
+	/** Line configuration */
+	struct capi_uart_line_config line;
+	/** Duration of one character on the line */
+	uint64_t char_ns;
+	/** True once init completed */
+	bool initialized;
+	/** RX FIFO characters (malloc'd to rx_fifo_size) */
+	uint8_t *rx_data;
+	/** Virtual time each RX FIFO character is complete */
+	uint64_t *rx_time;
+	/** Index of the oldest RX FIFO character */
+	uint16_t rx_head;
+	/** Characters in the RX FIFO, including those still in flight */
+	uint16_t rx_count;
+	/** RX FIFO characters already reported by an RX interrupt */
+	uint16_t rx_signaled;
+	/** End of the last character in flight on the RX line */
+	uint64_t rx_line_free_ns;
+	/** End of the last character on the TX line */
+	uint64_t tx_busy_until;
+	/** TX empty interrupt armed by a write or by enabling it */
+	bool tx_armed;
+	/** Sticky line status flags */
+	uint32_t line_status;
+	/** Line status interrupt not reported yet */
+	bool err_pending;
+	/** Reason of the last interrupt */
+	enum capi_uart_interrupt_reason reason;
+	/** RTS/CTS states */
+	bool rts;
+	bool cts;
+	/** Interrupt enables */
+	bool irq_tx;
+	bool irq_rx;
+	bool irq_err;
+	/** User callback */
+	capi_uart_callback callback;
+	/** User callback argument */
+	void *callback_arg;
+	/** True while an async transmit is in flight */
+	bool tx_async;
+	/** Destination and length of the async receive in flight */
+	uint8_t *rx_async_buf;
+	uint32_t rx_async_len;
+	/** True while an async receive is in flight */
+	bool rx_async;
+	/** Statistics */
+	struct capi_host_bus_stats stats;
+	/** Next completion or interrupt */
+	struct capi_host_event event;
+};
+
+/**
+ * @brief Declare a stack-allocated host UART handle.
+ *
+ * Declares `name` (struct capi_uart_handle) with embedded private state.
+ * Pass &name to capi_uart_init().
+ */
+#define CAPI_UART_HANDLE_HOST_DEFINE(name)                             \
+	struct capi_uart_handle name = {                                   \
+		.ops = NULL,                                                   \
+		.init_allocated = false,                                       \
+		.priv = &(struct capi_uart_host_handle){0}                     \
+	}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _HOST_CAPI_UART_PRIV_H_ */
@@ -197,6 +197,8 @@ int adxl355_init(struct adxl355_dev **device,
 
 	// Default value for FIFO SAMPLES
 	dev->fifo_samples = GET_ADXL355_RESET_VAL(ADXL355_FIFO_SAMPLES);
+	dev->fifo_parser.format = ADXL_FIFO_FORMAT_20B_MARKER;
+	dev->fifo_parser.nb_channels = 3;
 
 	// Default value for POWER_CTL
 	dev->op_mode = GET_ADXL355_RESET_VAL(ADXL355_POWER_CTL);
@@ -313,6 +315,9 @@ int adxl355_soft_reset(struct adxl355_dev *dev)
 	if ((!nb_of_retries) || ret)
 		return -EAGAIN;
 
+	// The FIFO is flushed by the reset
+	adxl_fifo_parser_reset(&dev->fifo_parser);
+
 	// Delay is needed between soft reset command and shadow registers reading
 	no_os_mdelay(1);
 
@@ -724,33 +729,38 @@ int adxl355_set_fifo_samples(struct adxl355_dev *dev, uint8_t reg_value)
 int adxl355_get_raw_fifo_data(struct adxl355_dev *dev, uint8_t *fifo_entries,
 			      uint32_t *raw_x, uint32_t *raw_y, uint32_t *raw_z)
 {
+	int32_t sets[ADXL355_MAX_FIFO_SAMPLES_VAL];
+	uint32_t nb_sets = 0;
 	int ret;
 
 	ret = adxl355_get_nb_of_fifo_entries(dev, fifo_entries);
 	if (ret)
 		return ret;
 
-	*fifo_entries = (*fifo_entries / 3) * 3;
+	if (*fifo_entries > ADXL355_MAX_FIFO_SAMPLES_VAL)
+		return -EIO;
 
 	if (*fifo_entries > 0) {
-
 		ret = adxl355_read_device_data(dev, ADXL355_ADDR(ADXL355_FIFO_DATA),
 					       *fifo_entries * 3, dev->comm_buff);
 		if (ret)
 			return ret;
 
-		for (uint16_t idx = 0; idx < *fifo_entries * 3; idx = idx + 9) {
-			if (((dev->comm_buff[idx + 2] & 1) == 1)
-			    && ((dev->comm_buff[idx + 2] & 2) == 0)) {
-				// This is x-axis
-				// Process data
-				raw_x[idx / 9] = adxl355_accel_array_conv(dev, &dev->comm_buff[idx]);
-				raw_y[idx / 9] = adxl355_accel_array_conv(dev, &dev->comm_buff[idx + 3]);
-				raw_z[idx / 9] = adxl355_accel_array_conv(dev, &dev->comm_buff[idx + 6]);
-			}
+		// A set split between two reads is completed by the next one
+		ret = adxl_fifo_parse(&dev->fifo_parser, dev->comm_buff, *fifo_entries,
+				      sets, ADXL355_MAX_FIFO_SAMPLES_VAL / 3, &nb_sets);
+		if (ret)
+			return ret;
+
+		for (uint32_t idx = 0; idx < nb_sets; idx++) {
+			raw_x[idx] = sets[idx * 3] & NO_OS_GENMASK(19, 0);
+			raw_y[idx] = sets[idx * 3 + 1] & NO_OS_GENMASK(19, 0);
+			raw_z[idx] = sets[idx * 3 + 2] & NO_OS_GENMASK(19, 0);
 		}
 	}
 
+	*fifo_entries = nb_sets * 3;
+
 	return ret;
 }
 
@@ -793,6 +803,67 @@ int adxl355_get_fifo_data(struct adxl355_dev *dev, uint8_t *fifo_entries,
 	return ret;
 }
 
+/***************************************************************************//**
+ * @brief Burst reads FIFO data. Used as read callback of the FIFO drain engine.
+ *
+ * @param dev - The device structure.
+ * @param buf - Buffer for the FIFO entries.
+ * @param len - Number of bytes to be read.
+ *
+ * @return ret - Result of the reading procedure.
+*******************************************************************************/
+int adxl355_fifo_read(void *dev, uint8_t *buf, uint32_t len)
+{
+	if (len > ADXL355_MAX_FIFO_SAMPLES_VAL * 3)
+		return -EINVAL;
+
+	return adxl355_read_device_data(dev, ADXL355_ADDR(ADXL355_FIFO_DATA), len,
+					buf);
+}
+
+/***************************************************************************//**
+ * @brief Gets the output data rate.
+ *
+ * @param dev - The device structure.
+ *
+ * @return The output data rate in mHz.
+*******************************************************************************/
+uint32_t adxl355_get_odr_mhz(struct adxl355_dev *dev)
+{
+	return 4000000 >> dev->odr_lpf;
+}
+
+/***************************************************************************//**
+ * @brief Initializes a FIFO drain engine for the device. Entries read past
+ *        the FIFO content are flagged empty and discarded, so the FIFO may be
+ *        drained in a single burst, without reading FIFO_ENTRIES first.
+ *
+ * @param dev     - The device structure.
+ * @param entries - Number of entries read by each drain. Reading the whole
+ *                  FIFO (ADXL355_MAX_FIFO_SAMPLES_VAL) leaves it empty, so
+ *                  the next watermark interrupt is an edge again.
+ * @param fifo    - The drain engine.
+ *
+ * @return ret    - Result of the initialization procedure.
+*******************************************************************************/
+int adxl355_fifo_init(struct adxl355_dev *dev, uint8_t entries,
+		      struct adxl_fifo **fifo)
+{
+	struct adxl_fifo_init_param fifo_ip = {
+		.format = ADXL_FIFO_FORMAT_20B_MARKER,
+		.nb_channels = 3,
+		.entries_per_read = entries,
+		.odr_mhz = adxl355_get_odr_mhz(dev),
+		.read = adxl355_fifo_read,
+		.dev = dev,
+	};
+
+	if (!entries || entries > ADXL355_MAX_FIFO_SAMPLES_VAL)
+		return -EINVAL;
+
+	return adxl_fifo_init(fifo, &fifo_ip);
+}
+
 /***************************************************************************//**
  * @brief Configures the activity enable register.
  *
@@ -38,6 +38,7 @@
 #include "no_os_util.h"
 #include "no_os_i2c.h"
 #include "no_os_spi.h"
+#include "adxl_fifo.h"
 
 /* SPI commands */
 #define ADXL355_SPI_READ          0x01
@@ -299,6 +300,8 @@ struct adxl355_dev {
 	union adxl355_act_en_flags act_en;
 	uint8_t act_cnt;
 	uint16_t act_thr;
+	/** FIFO set reassembly state of adxl355_get_raw_fifo_data() */
+	struct adxl_fifo_parser fifo_parser;
 	uint8_t comm_buff[289];
 };
 
@@ -370,6 +373,16 @@ int adxl355_get_fifo_data(struct adxl355_dev *dev, uint8_t *fifo_entries,
 			  struct adxl355_frac_repr *x, struct adxl355_frac_repr *y,
 			  struct adxl355_frac_repr *z);
 
+/*! Burst reads FIFO data, to be used as FIFO drain engine read callback. */
+int adxl355_fifo_read(void *dev, uint8_t *buf, uint32_t len);
+
+/*! Initializes a FIFO drain engine for the device. */
+int adxl355_fifo_init(struct adxl355_dev *dev, uint8_t entries,
+		      struct adxl_fifo **fifo);
+
+/*! Gets the output data rate in mHz. */
+uint32_t adxl355_get_odr_mhz(struct adxl355_dev *dev);
+
 /*! Configures the activity enable register. */
 int adxl355_conf_act_en(struct adxl355_dev *dev,
 			union adxl355_act_en_flags act_config);
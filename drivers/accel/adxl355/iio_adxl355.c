@@ -110,7 +110,11 @@ static int adxl355_iio_read_samp_freq_avail(void *dev, char *buf,
 static int adxl355_iio_read_samples(void *dev, void *buff,
 				    uint32_t samples);
 static int adxl355_iio_update_channels(void *dev, uint32_t mask);
+static int adxl355_iio_push_set(struct iio_device_data *dev_data, int32_t x,
+				int32_t y, int32_t z);
 static int adxl355_trigger_handler(struct iio_device_data *dev_data);
+static int adxl355_iio_fifo_setup(struct adxl355_iio_dev *desc,
+				  uint8_t watermark);
 static struct iio_attribute adxl355_iio_temp_attrs[] = {
 	{
 		.name = "offset",
@@ -787,6 +791,13 @@ static int adxl355_iio_write_sampling_freq(void *dev, char *buf,
 		if (ret)
 			return ret;
 
+		if (iio_adxl355->fifo) {
+			ret = adxl_fifo_set_odr(iio_adxl355->fifo,
+						adxl355_get_odr_mhz(adxl355));
+			if (ret)
+				return ret;
+		}
+
 		// Update 3db frequency table for new ODR value
 		return adxl355_iio_fill_3db_frequency_table(iio_adxl355);
 
@@ -968,11 +979,48 @@ static int adxl355_iio_update_channels(void *dev, uint32_t mask)
 
 	iio_adxl355->no_of_active_channels = counter;
 
+	if (iio_adxl355->fifo)
+		adxl_fifo_reset(iio_adxl355->fifo, 0);
+
 	return 0;
 }
 
 /***************************************************************************//**
- * @brief Handles trigger: reads one data-set and writes it to the buffer.
+ * @brief Pushes the active channels of one data-set to the buffer.
+ *
+ * @param dev_data  - The iio device data structure.
+ * @param x         - X axis sign extended data.
+ * @param y         - Y axis sign extended data.
+ * @param z         - Z axis sign extended data.
+ *
+ * @return ret - Result of the push procedure.
+*******************************************************************************/
+static int adxl355_iio_push_set(struct iio_device_data *dev_data, int32_t x,
+				int32_t y, int32_t z)
+{
+	int32_t data_buff[3];
+	uint8_t i = 0;
+
+	if (dev_data->buffer->active_mask & NO_OS_BIT(0)) {
+		data_buff[0] = x;
+		i++;
+	}
+	if (dev_data->buffer->active_mask & NO_OS_BIT(1)) {
+		data_buff[i] = y;
+		i++;
+	}
+	if (dev_data->buffer->active_mask & NO_OS_BIT(2)) {
+		data_buff[i] = z;
+		i++;
+	}
+
+	return iio_buffer_push_scan(dev_data->buffer, &data_buff[0]);
+}
+
+/***************************************************************************//**
+ * @brief Handles trigger: reads one data-set and writes it to the buffer. If
+ * 		  a FIFO watermark is configured, the whole FIFO is read in one burst
+ * 		  and all its data-sets are written to the buffer.
  *
  * @param dev_data  - The iio device data structure.
  *
@@ -981,9 +1029,10 @@ static int adxl355_iio_update_channels(void *dev, uint32_t mask)
 *******************************************************************************/
 static int adxl355_trigger_handler(struct iio_device_data *dev_data)
 {
-	int32_t data_buff[3];
 	uint32_t x, y, z;
-	uint8_t i = 0;
+	uint32_t nb_sets;
+	int32_t *set;
+	int ret;
 
 	struct adxl355_iio_dev *iio_adxl355;
 	struct adxl355_dev *adxl355;
@@ -998,22 +1047,68 @@ static int adxl355_trigger_handler(struct iio_device_data *dev_data)
 
 	adxl355 = iio_adxl355->adxl355_dev;
 
-	adxl355_get_raw_xyz(adxl355, &x, &y, &z);
+	if (!iio_adxl355->fifo) {
+		adxl355_get_raw_xyz(adxl355, &x, &y, &z);
 
-	if (dev_data->buffer->active_mask & NO_OS_BIT(0)) {
-		data_buff[0] = no_os_sign_extend32(x, 19);
-		i++;
+		return adxl355_iio_push_set(dev_data, no_os_sign_extend32(x, 19),
+					    no_os_sign_extend32(y, 19),
+					    no_os_sign_extend32(z, 19));
 	}
-	if (dev_data->buffer->active_mask & NO_OS_BIT(1)) {
-		data_buff[i] = no_os_sign_extend32(y, 19);
-		i++;
+
+	ret = adxl_fifo_drain(iio_adxl355->fifo, iio_adxl355->fifo_sets, NULL,
+			      adxl_fifo_max_sets(iio_adxl355->fifo), &nb_sets);
+	if (ret)
+		return ret;
+
+	for (set = iio_adxl355->fifo_sets; nb_sets; nb_sets--, set += 3) {
+		ret = adxl355_iio_push_set(dev_data, set[0], set[1], set[2]);
+		if (ret)
+			return ret;
 	}
-	if (dev_data->buffer->active_mask & NO_OS_BIT(2)) {
-		data_buff[i] = no_os_sign_extend32(z, 19);
-		i++;
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Configures the FIFO watermark on INT1 and the FIFO drain engine.
+ *
+ * @param desc      - The iio device structure.
+ * @param watermark - FIFO watermark in data-sets.
+ *
+ * @return ret      - Result of the configuration procedure.
+*******************************************************************************/
+static int adxl355_iio_fifo_setup(struct adxl355_iio_dev *desc,
+				  uint8_t watermark)
+{
+	union adxl355_int_mask int_map = { .value = 0 };
+	int ret;
+
+	if (watermark * 3 > ADXL355_MAX_FIFO_SAMPLES_VAL)
+		return -EINVAL;
+
+	ret = adxl355_set_fifo_samples(desc->adxl355_dev, watermark * 3);
+	if (ret)
+		return ret;
+
+	int_map.fields.FULL_EN1 = 1;
+	ret = adxl355_config_int_pins(desc->adxl355_dev, int_map);
+	if (ret)
+		return ret;
+
+	ret = adxl355_fifo_init(desc->adxl355_dev, ADXL355_MAX_FIFO_SAMPLES_VAL,
+				&desc->fifo);
+	if (ret)
+		return ret;
+
+	desc->fifo_sets = (int32_t *)no_os_calloc(adxl_fifo_max_sets(desc->fifo) * 3,
+			  sizeof(*desc->fifo_sets));
+	if (!desc->fifo_sets) {
+		adxl_fifo_remove(desc->fifo);
+		desc->fifo = NULL;
+		return -ENOMEM;
 	}
 
-	return iio_buffer_push_scan(dev_data->buffer, &data_buff[0]);
+	return 0;
 }
 
 /***************************************************************************//**
@@ -1059,6 +1154,12 @@ int adxl355_iio_init(struct adxl355_iio_dev **iio_dev,
 	if (ret)
 		goto error_config;
 
+	if (init_param->fifo_watermark) {
+		ret = adxl355_iio_fifo_setup(desc, init_param->fifo_watermark);
+		if (ret)
+			goto error_config;
+	}
+
 	*iio_dev = desc;
 
 	return 0;
@@ -1087,6 +1188,8 @@ int adxl355_iio_remove(struct adxl355_iio_dev *desc)
 	if (ret)
 		return ret;
 
+	adxl_fifo_remove(desc->fifo);
+	no_os_free(desc->fifo_sets);
 	no_os_free(desc);
 
 	return 0;
@@ -35,6 +35,7 @@
 
 #include "iio.h"
 #include "no_os_irq.h"
+#include "adxl_fifo.h"
 
 extern struct iio_trigger adxl355_iio_trig_desc;
 
@@ -44,10 +45,17 @@ struct adxl355_iio_dev {
 	int adxl355_hpf_3db_table[7][2];
 	uint32_t active_channels;
 	uint8_t no_of_active_channels;
+	/** FIFO drain engine, NULL when reading one set per trigger */
+	struct adxl_fifo *fifo;
+	/** Sets returned by the FIFO drain engine */
+	int32_t *fifo_sets;
 };
 
 struct adxl355_iio_dev_init_param {
 	struct adxl355_init_param *adxl355_dev_init;
+	/** FIFO watermark in sets, mapped to INT1. The trigger handler then
+	 *  drains the whole FIFO in one burst. 0 to read one set per trigger. */
+	uint8_t fifo_watermark;
 };
 
 int adxl355_iio_init(struct adxl355_iio_dev **iio_dev,
@@ -32,6 +32,7 @@
 *******************************************************************************/
 
 #include <stdlib.h>
+#include <string.h>
 #include "adxl367.h"
 #include "no_os_delay.h"
 #include "no_os_error.h"
@@ -40,7 +41,30 @@
 #include "no_os_print_log.h"
 
 static const uint8_t adxl367_scale_mul[3] = {1, 2, 4};
-static uint8_t samples_per_set = 0;
+
+#define ADXL367_FIFO_PARSE_CHUNK	64
+
+/* Channel IDs of a FIFO set for each FIFO format. */
+static const uint8_t adxl367_fifo_chan_ids[][ADXL_FIFO_MAX_CHANNELS] = {
+	[ADXL367_FIFO_FORMAT_XYZ] = {ADXL367_FIFO_X_ID, ADXL367_FIFO_Y_ID, ADXL367_FIFO_Z_ID},
+	[ADXL367_FIFO_FORMAT_X] = {ADXL367_FIFO_X_ID},
+	[ADXL367_FIFO_FORMAT_Y] = {ADXL367_FIFO_Y_ID},
+	[ADXL367_FIFO_FORMAT_Z] = {ADXL367_FIFO_Z_ID},
+	[ADXL367_FIFO_FORMAT_XYZT] = {
+		ADXL367_FIFO_X_ID, ADXL367_FIFO_Y_ID, ADXL367_FIFO_Z_ID,
+		ADXL367_FIFO_TEMP_ADC_ID
+	},
+	[ADXL367_FIFO_FORMAT_XT] = {ADXL367_FIFO_X_ID, ADXL367_FIFO_TEMP_ADC_ID},
+	[ADXL367_FIFO_FORMAT_YT] = {ADXL367_FIFO_Y_ID, ADXL367_FIFO_TEMP_ADC_ID},
+	[ADXL367_FIFO_FORMAT_ZT] = {ADXL367_FIFO_Z_ID, ADXL367_FIFO_TEMP_ADC_ID},
+	[ADXL367_FIFO_FORMAT_XYZA] = {
+		ADXL367_FIFO_X_ID, ADXL367_FIFO_Y_ID, ADXL367_FIFO_Z_ID,
+		ADXL367_FIFO_TEMP_ADC_ID
+	},
+	[ADXL367_FIFO_FORMAT_XA] = {ADXL367_FIFO_X_ID, ADXL367_FIFO_TEMP_ADC_ID},
+	[ADXL367_FIFO_FORMAT_YA] = {ADXL367_FIFO_Y_ID, ADXL367_FIFO_TEMP_ADC_ID},
+	[ADXL367_FIFO_FORMAT_ZA] = {ADXL367_FIFO_Z_ID, ADXL367_FIFO_TEMP_ADC_ID},
+};
 
 /***************************************************************************//**
  * @brief Initializes communication with the device and checks if the part is
@@ -966,16 +990,16 @@ int adxl367_set_fifo_format(struct adxl367_dev *dev,
 
 	switch (dev->fifo_format) {
 	case ADXL367_FIFO_FORMAT_XYZ:
-		samples_per_set = 3;
+		dev->fifo_parser.nb_channels = 3;
 		break;
 	case ADXL367_FIFO_FORMAT_X:
 	case ADXL367_FIFO_FORMAT_Y:
 	case ADXL367_FIFO_FORMAT_Z:
-		samples_per_set = 1;
+		dev->fifo_parser.nb_channels = 1;
 		break;
 	case ADXL367_FIFO_FORMAT_XYZT:
 	case ADXL367_FIFO_FORMAT_XYZA:
-		samples_per_set = 4;
+		dev->fifo_parser.nb_channels = 4;
 		break;
 	case ADXL367_FIFO_FORMAT_XT:
 	case ADXL367_FIFO_FORMAT_YT:
@@ -983,12 +1007,17 @@ int adxl367_set_fifo_format(struct adxl367_dev *dev,
 	case ADXL367_FIFO_FORMAT_XA:
 	case ADXL367_FIFO_FORMAT_YA:
 	case ADXL367_FIFO_FORMAT_ZA:
-		samples_per_set = 2;
+		dev->fifo_parser.nb_channels = 2;
 		break;
 	default:
 		return -1;
 	}
 
+	dev->fifo_parser.format = ADXL_FIFO_FORMAT_14B_CHID;
+	memcpy(dev->fifo_parser.chan_ids, adxl367_fifo_chan_ids[format],
+	       sizeof(dev->fifo_parser.chan_ids));
+	adxl_fifo_parser_reset(&dev->fifo_parser);
+
 	return 0;
 }
 
@@ -1059,76 +1088,108 @@ int adxl367_fifo_setup(struct adxl367_dev *dev,
 int adxl367_read_raw_fifo(struct adxl367_dev *dev, int16_t *x, int16_t *y,
 			  int16_t *z, int16_t *temp_adc, uint16_t *entries)
 {
+	int32_t sets[ADXL367_FIFO_PARSE_CHUNK + ADXL_FIFO_MAX_CHANNELS];
+	int16_t **out[ADXL_FIFO_MAX_CHANNELS] = {&x, &y, &z, &temp_adc};
+	uint8_t nb_chan = dev->fifo_parser.nb_channels;
+	uint16_t stored_entr = 0;
+	uint32_t i, j, k, n, nb_sets;
+	int16_t **ch;
 	int ret;
-	uint16_t i, stored_entr = 0;
-	uint8_t id;
+
+	if (!nb_chan)
+		return -EINVAL;
+
+	for (k = 0; k < nb_chan; k++)
+		if (!*out[dev->fifo_parser.chan_ids[k]])
+			return -1;
 
 	ret = adxl367_get_nb_of_fifo_entries(dev, &stored_entr);
 	if (ret)
 		return ret;
 
-	*entries = stored_entr;
+	*entries = 0;
 
 	ret = adxl367_get_fifo_value(dev, dev->fifo_buffer, stored_entr * 2);
 	if (ret)
 		return -1;
 
-	// MSB = 6 data bits + 2 bits for CH ID
-	for (i = 0; i < (stored_entr * 2); i += 2) {
-		id = dev->fifo_buffer[i] >> 6;
-
-		switch (id) {
-		case (ADXL367_FIFO_X_ID) :
-			if (x == NULL)
-				return -1;
-			*x = ((dev->fifo_buffer[i] & 0x3F) << 8) + dev->fifo_buffer[i + 1];
-			//extend sign
-			if (*x & NO_OS_BIT(13))
-				*x |= NO_OS_GENMASK(15, 14);
-			x++;
-			break;
-
-		case (ADXL367_FIFO_Y_ID) :
-			if (y == NULL)
-				return -1;
-			*y = ((dev->fifo_buffer[i] & 0x3F) << 8) + dev->fifo_buffer[i + 1];
-			//extend sign
-			if (*y & NO_OS_BIT(13))
-				*y |= NO_OS_GENMASK(15, 14);
-			y++;
-			break;
-
-		case (ADXL367_FIFO_Z_ID) :
-			if (z == NULL)
-				return -1;
-			*z = ((dev->fifo_buffer[i] & 0x3F) << 8) + dev->fifo_buffer[i + 1];
-			//extend sign
-			if (*z & NO_OS_BIT(13))
-				*z |= NO_OS_GENMASK(15, 14);
-			z++;
-			break;
-
-		case (ADXL367_FIFO_TEMP_ADC_ID) :
-			if (temp_adc == NULL)
-				return -1;
-			*temp_adc = (int16_t)((dev->fifo_buffer[i] & 0x3F) << 8) + dev->fifo_buffer[i
-					+ 1];
-			//extend sign
-			if (*temp_adc & NO_OS_BIT(13))
-				*temp_adc |= NO_OS_GENMASK(15, 14);
-			temp_adc++;
-			break;
+	// MSB = 2 bits for CH ID + 6 data bits. A set split between two reads is
+	// completed by the next one.
+	for (i = 0; i < stored_entr; i += n) {
+		n = no_os_min(stored_entr - i, (uint32_t)ADXL367_FIFO_PARSE_CHUNK);
+		ret = adxl_fifo_parse(&dev->fifo_parser, &dev->fifo_buffer[i * 2], n,
+				      sets, NO_OS_ARRAY_SIZE(sets) / nb_chan, &nb_sets);
+		if (ret)
+			return ret;
 
-		default :
-			pr_err("%s: FIFO read invalid channel ID.\n", __func__);
-			return -1;
+		for (j = 0; j < nb_sets; j++) {
+			for (k = 0; k < nb_chan; k++) {
+				ch = out[dev->fifo_parser.chan_ids[k]];
+				**ch = sets[j * nb_chan + k];
+				(*ch)++;
+			}
 		}
-
+		*entries += nb_sets * nb_chan;
 	}
 
 	return 0;
 }
 
+/***************************************************************************//**
+ * @brief Burst reads FIFO data. Used as read callback of the FIFO drain engine.
+ *
+ * @param dev - The device structure.
+ * @param buf - Buffer for the FIFO entries.
+ * @param len - Number of bytes to be read.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+int adxl367_fifo_read(void *dev, uint8_t *buf, uint32_t len)
+{
+	struct adxl367_dev *desc = dev;
+	int ret;
+
+	if (len > sizeof(desc->fifo_buffer) - 1)
+		return -EINVAL;
+
+	ret = adxl367_get_fifo_value(desc, desc->fifo_buffer, len);
+	if (ret)
+		return ret;
+
+	memcpy(buf, desc->fifo_buffer, len);
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Initializes a FIFO drain engine for the current FIFO configuration.
+ * 		The FIFO must be configured with adxl367_fifo_setup() first.
+ *
+ * @param dev     - The device structure.
+ * @param entries - Number of entries read by each drain, usually the FIFO
+ * 		    watermark.
+ * @param fifo    - The drain engine.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+int adxl367_fifo_init(struct adxl367_dev *dev, uint16_t entries,
+		      struct adxl_fifo **fifo)
+{
+	struct adxl_fifo_init_param fifo_ip = {
+		.format = ADXL_FIFO_FORMAT_14B_CHID,
+		.nb_channels = dev->fifo_parser.nb_channels,
+		.entries_per_read = entries,
+		.odr_mhz = 12500 << dev->odr,
+		.read = adxl367_fifo_read,
+		.dev = dev,
+	};
+
+	memcpy(fifo_ip.chan_ids, dev->fifo_parser.chan_ids,
+	       sizeof(fifo_ip.chan_ids));
+
+	return adxl_fifo_init(fifo, &fifo_ip);
+}
+
 /***************************************************************************//**
  * @brief Reads converted values from FIFO. If, after setting FIFO mode, any of
  *      x, y, z, temp or adc aren't selected, assign NULL pointer. Uses
@@ -1157,7 +1218,7 @@ int adxl367_read_converted_fifo(struct adxl367_dev *dev,
 	if (ret)
 		return ret;
 
-	sets_nb = *entries / samples_per_set;
+	sets_nb = *entries / dev->fifo_parser.nb_channels;
 
 	// convert raw data to g value
 	for (index = 0; index < sets_nb; index++) {
@@ -38,6 +38,7 @@
 #include <stdbool.h>
 #include "no_os_spi.h"
 #include "no_os_i2c.h"
+#include "adxl_fifo.h"
 
 /* ADXL367 communication commands */
 #define ADXL367_WRITE_REG               0x0A
@@ -455,6 +456,8 @@ struct adxl367_dev {
 	enum adxl367_fifo_mode		fifo_mode;
 	enum adxl367_fifo_format 	fifo_format;
 	enum adxl367_fifo_read_mode 	fifo_read_mode;
+	/** FIFO set reassembly state. */
+	struct adxl_fifo_parser		fifo_parser;
 	/** FIFO Buffer 513 * 2 + 1 cmd byte */
 	uint8_t 			fifo_buffer[1027];
 	uint16_t 			x_offset;
@@ -583,6 +586,13 @@ int adxl367_fifo_setup(struct adxl367_dev *dev,
 int adxl367_read_raw_fifo(struct adxl367_dev *dev, int16_t *x, int16_t *y,
 			  int16_t *z, int16_t *temp_adc, uint16_t *entries);
 
+/* Burst reads FIFO data, to be used as FIFO drain engine read callback. */
+int adxl367_fifo_read(void *dev, uint8_t *buf, uint32_t len);
+
+/* Initializes a FIFO drain engine for the current FIFO configuration. */
+int adxl367_fifo_init(struct adxl367_dev *dev, uint16_t entries,
+		      struct adxl_fifo **fifo);
+
 /* Reads converted values from FIFO. */
 int adxl367_read_converted_fifo(struct adxl367_dev *dev,
 				struct adxl367_fractional_val *x, struct adxl367_fractional_val *y,
@@ -36,6 +36,7 @@
 #include "no_os_error.h"
 #include "no_os_util.h"
 #include "no_os_alloc.h"
+#include "no_os_delay.h"
 #include "iio_adxl367.h"
 #include "adxl367.h"
 #include <string.h>
@@ -642,11 +643,17 @@ static int adxl367_iio_update_channels(void* dev, uint32_t mask)
 
 	iio_adxl367->no_of_active_channels = counter;
 
+	// Drop the sets read before the buffer was enabled
+	iio_adxl367->fifo_pos = 0;
+	iio_adxl367->fifo_sets = 0;
+
 	return 0;
 }
 
 /***************************************************************************//**
- * @brief Reads the number of given samples for the selected channels
+ * @brief Reads the number of given samples for the selected channels. The
+ * 		  samples are taken from the FIFO, which is read in one burst each time
+ * 		  the sets read previously are used up.
  *
  * @param dev     - The iio device structure.
  * @param buf	  - Command buffer to be filled with requested data.
@@ -657,12 +664,11 @@ static int adxl367_iio_update_channels(void* dev, uint32_t mask)
 *******************************************************************************/
 static int adxl367_iio_read_samples(void* dev, int* buff, uint32_t samples)
 {
-	int16_t data_x;
-	int16_t data_y;
-	int16_t data_z;
-	int16_t raw_temp;
 	struct adxl367_iio_dev *iio_adxl367;
 	struct adxl367_dev *adxl367;
+	uint16_t entries;
+	uint16_t set;
+	int ret;
 
 	if (!dev)
 		return -EINVAL;
@@ -675,23 +681,37 @@ static int adxl367_iio_read_samples(void* dev, int* buff, uint32_t samples)
 	adxl367 = iio_adxl367->adxl367_dev;
 
 	for (uint32_t i = 0; i < samples * iio_adxl367->no_of_active_channels;) {
-		adxl367_get_raw_xyz(adxl367, &data_x, &data_y, &data_z);
+		if (iio_adxl367->fifo_pos == iio_adxl367->fifo_sets) {
+			ret = adxl367_read_raw_fifo(adxl367, iio_adxl367->fifo_x,
+						    iio_adxl367->fifo_y,
+						    iio_adxl367->fifo_z,
+						    iio_adxl367->fifo_temp, &entries);
+			if (ret)
+				return ret;
+
+			iio_adxl367->fifo_pos = 0;
+			iio_adxl367->fifo_sets = entries / ADXL367_IIO_FIFO_CHANNELS;
+			if (!iio_adxl367->fifo_sets) {
+				no_os_mdelay(1);
+				continue;
+			}
+		}
 
+		set = iio_adxl367->fifo_pos++;
 		if (iio_adxl367->active_channels & NO_OS_BIT(0)) {
-			buff[i] = no_os_sign_extend32(data_x, 15);
+			buff[i] = iio_adxl367->fifo_x[set];
 			i++;
 		}
 		if (iio_adxl367->active_channels & NO_OS_BIT(1)) {
-			buff[i] = no_os_sign_extend32(data_y, 15);
+			buff[i] = iio_adxl367->fifo_y[set];
 			i++;
 		}
 		if (iio_adxl367->active_channels & NO_OS_BIT(2)) {
-			buff[i] = no_os_sign_extend32(data_z, 15);
+			buff[i] = iio_adxl367->fifo_z[set];
 			i++;
 		}
 		if (iio_adxl367->active_channels & NO_OS_BIT(3)) {
-			adxl367_read_raw_temp(adxl367, &raw_temp);
-			buff[i] = raw_temp;
+			buff[i] = iio_adxl367->fifo_temp[set];
 			i++;
 		}
 	}
@@ -735,6 +755,13 @@ int adxl367_iio_init(struct adxl367_iio_dev **iio_dev,
 	if (ret)
 		goto error_config;
 
+	// Stream all the channels through the FIFO, which is polled
+	ret = adxl367_fifo_setup(desc->adxl367_dev, ADXL367_STREAM_MODE,
+				 ADXL367_FIFO_FORMAT_XYZT,
+				 ADXL367_IIO_FIFO_WATERMARK);
+	if (ret)
+		goto error_config;
+
 	// Enter measure mode
 	ret = adxl367_set_power_mode(desc->adxl367_dev, ADXL367_OP_MEASURE);
 	if (ret)
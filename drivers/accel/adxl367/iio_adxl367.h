@@ -35,11 +35,27 @@
 
 #include "iio.h"
 
+/* Channels of a FIFO set: x, y, z and temperature */
+#define ADXL367_IIO_FIFO_CHANNELS	4
+/* The FIFO holds 512 entries, plus a carried partial set */
+#define ADXL367_IIO_FIFO_SETS		129
+/* FIFO watermark in sets, unused as the FIFO is polled */
+#define ADXL367_IIO_FIFO_WATERMARK	64
+
 struct adxl367_iio_dev {
 	struct adxl367_dev *adxl367_dev;
 	struct iio_device *iio_dev;
 	uint32_t active_channels;
 	uint8_t no_of_active_channels;
+	/* Sets of the last FIFO read */
+	int16_t fifo_x[ADXL367_IIO_FIFO_SETS];
+	int16_t fifo_y[ADXL367_IIO_FIFO_SETS];
+	int16_t fifo_z[ADXL367_IIO_FIFO_SETS];
+	int16_t fifo_temp[ADXL367_IIO_FIFO_SETS];
+	/* Number of sets of the last FIFO read */
+	uint16_t fifo_sets;
+	/* Next set to be returned */
+	uint16_t fifo_pos;
 };
 
 struct adxl367_iio_init_param {
@@ -39,6 +39,31 @@
 #include "no_os_alloc.h"
 #include "no_os_error.h"
 
+#define ADXL372_FIFO_PARSE_CHUNK	48
+
+/* Axis of each entry of a FIFO set, 0 = x, 1 = y, 2 = z */
+static const uint8_t adxl372_fifo_axes[][3] = {
+	[ADXL372_XYZ_FIFO] = {0, 1, 2},
+	[ADXL372_X_FIFO] = {0},
+	[ADXL372_Y_FIFO] = {1},
+	[ADXL372_XY_FIFO] = {0, 1},
+	[ADXL372_Z_FIFO] = {2},
+	[ADXL372_XZ_FIFO] = {0, 2},
+	[ADXL372_YZ_FIFO] = {1, 2},
+	[ADXL372_XYZ_PEAK_FIFO] = {0, 1, 2},
+};
+
+static const uint8_t adxl372_fifo_nb_axes[] = {
+	[ADXL372_XYZ_FIFO] = 3,
+	[ADXL372_X_FIFO] = 1,
+	[ADXL372_Y_FIFO] = 1,
+	[ADXL372_XY_FIFO] = 2,
+	[ADXL372_Z_FIFO] = 1,
+	[ADXL372_XZ_FIFO] = 2,
+	[ADXL372_YZ_FIFO] = 2,
+	[ADXL372_XYZ_PEAK_FIFO] = 3,
+};
+
 /**
  * Wrapper used to read device registers.
  * @param dev - The device structure.
@@ -519,6 +544,11 @@ int32_t adxl372_configure_fifo(struct adxl372_dev *dev,
 	dev->fifo_config.fifo_mode = mode;
 	dev->fifo_config.fifo_samples = fifo_samples;
 
+	/* The FIFO is cleared when its configuration is written */
+	dev->fifo_parser.format = ADXL_FIFO_FORMAT_12B_MARKER;
+	dev->fifo_parser.nb_channels = adxl372_fifo_nb_axes[format];
+	adxl_fifo_parser_reset(&dev->fifo_parser);
+
 	return ret;
 }
 
@@ -527,10 +557,10 @@ int32_t adxl372_configure_fifo(struct adxl372_dev *dev,
  * but works best when interrupts are used
  * @param dev - The device structure.
  * @param fifo_data - pointer to an array of type adxl372_xyz_accel_data
- *		      where (x, y, z) values will be stored. Array max size
- *		      should be 170, as the FIFO can hold up to 512 samples.
+ *		      where (x, y, z) values will be stored. Array size
+ *		      should be ADXL372_FIFO_MAX_SETS.
  * @param fifo_entries - pointer which will store the number of valid data
- *			 samples present in the FIFO buffer
+ *			 samples read from the FIFO buffer
  * @return 0 in case of success, negative error code otherwise.
  */
 int32_t adxl372_service_fifo_ev(struct adxl372_dev *dev,
@@ -538,6 +568,7 @@ int32_t adxl372_service_fifo_ev(struct adxl372_dev *dev,
 				uint16_t *fifo_entries)
 {
 	uint8_t status1, status2;
+	uint16_t nb_sets;
 	int32_t ret;
 
 	ret = adxl372_get_status(dev, &status1, &status2, fifo_entries);
@@ -558,11 +589,13 @@ int32_t adxl372_service_fifo_ev(struct adxl372_dev *dev,
 			 * of order, at least one sample set must be left in the
 			 * FIFO after every read.
 			 */
-			*fifo_entries -= 3;
-			ret = adxl372_get_fifo_xyz_data(dev, fifo_data,
-							*fifo_entries);
-			if (ret < 0)
+			*fifo_entries -= dev->fifo_parser.nb_channels;
+			ret = adxl372_get_fifo_xyz_sets(dev, fifo_data,
+							*fifo_entries, &nb_sets);
+			if (ret)
 				return ret;
+
+			*fifo_entries = nb_sets * dev->fifo_parser.nb_channels;
 		}
 	}
 
@@ -570,23 +603,40 @@ int32_t adxl372_service_fifo_ev(struct adxl372_dev *dev,
 }
 
 /**
- * Get the data stored in FIFO.
+ * Get the data stored in FIFO. The entries are read in one burst and
+ * reassembled into sets using the series start bit: a set split between two
+ * reads is completed by the next one, and a set missing entries is dropped.
+ * Axes which are not stored in the FIFO are set to 0. At most
+ * ADXL372_FIFO_MAX_SETS sets are returned, the entries which would not fit
+ * are left in the FIFO.
  * @param dev - The device structure.
- * @param samples - pointer to the raw data stored in the ADXL372_FIFO_DATA
+ * @param samples - pointer to the raw data stored in the ADXL372_FIFO_DATA,
+ *		    of ADXL372_FIFO_MAX_SETS elements
  * @param cnt - How many samples should be retrieved from the FIFO DATA reg
+ * @param nb_sets - pointer which will store the number of sets stored in
+ *		    samples
  * @return 0 in case of success, negative error code otherwise.
  */
-int32_t adxl372_get_fifo_xyz_data(struct adxl372_dev *dev,
+int32_t adxl372_get_fifo_xyz_sets(struct adxl372_dev *dev,
 				  struct adxl372_xyz_accel_data *samples,
-				  uint16_t cnt)
+				  uint16_t cnt, uint16_t *nb_sets)
 {
+	int32_t sets[ADXL372_FIFO_PARSE_CHUNK + ADXL_FIFO_MAX_CHANNELS];
+	const uint8_t *axes = adxl372_fifo_axes[dev->fifo_config.fifo_format];
+	uint8_t nb_chan = dev->fifo_parser.nb_channels;
 	uint8_t buf[1024];
-	uint16_t i;
+	uint16_t *val;
+	uint32_t max_sets, parsed, i, j, k, n;
+	uint32_t total = 0;
 	int32_t ret;
 
-
-	if (cnt > 512)
+	if (cnt > 512 || !nb_chan || !nb_sets)
 		return -1;
+
+	/* Together with the carried partial set, never exceed the output */
+	cnt = no_os_min(cnt, ADXL372_FIFO_MAX_SETS * nb_chan -
+			dev->fifo_parser.pos);
+
 	/*
 	 * The FIFO can hold up to 512 samples.
 	 * Each sample is 2 bytes, that's why we read (cnt * 2) bytes
@@ -598,14 +648,89 @@ int32_t adxl372_get_fifo_xyz_data(struct adxl372_dev *dev,
 	if (ret < 0)
 		return ret;
 
-	for (i = 0; i < cnt * 2; i += 6) {
-		samples->x = ((buf[i] << 4) | (buf[i + 1] >> 4));
-		samples->y = ((buf[i + 2] << 4) | (buf[i + 3] >> 4));
-		samples->z = ((buf[i + 4] << 4) | (buf[i + 5] >> 4));
-		samples++;
+	for (i = 0; i < cnt; i += n) {
+		n = no_os_min(cnt - i, (uint32_t)ADXL372_FIFO_PARSE_CHUNK);
+		max_sets = no_os_min(NO_OS_ARRAY_SIZE(sets) / nb_chan,
+				     ADXL372_FIFO_MAX_SETS - total);
+		ret = adxl_fifo_parse(&dev->fifo_parser, &buf[i * 2], n, sets,
+				      max_sets, &parsed);
+		if (ret)
+			return ret;
+
+		for (j = 0; j < parsed; j++, samples++) {
+			memset(samples, 0, sizeof(*samples));
+			for (k = 0; k < nb_chan; k++) {
+				val = axes[k] == 0 ? &samples->x :
+				      axes[k] == 1 ? &samples->y : &samples->z;
+				*val = sets[j * nb_chan + k] & 0xFFF;
+			}
+		}
+		total += parsed;
 	}
 
-	return ret;
+	*nb_sets = total;
+
+	return 0;
+}
+
+/**
+ * Get the data stored in FIFO. Same as adxl372_get_fifo_xyz_sets(), without
+ * the number of sets stored in samples.
+ * @param dev - The device structure.
+ * @param samples - pointer to the raw data stored in the ADXL372_FIFO_DATA,
+ *		    of ADXL372_FIFO_MAX_SETS elements
+ * @param cnt - How many samples should be retrieved from the FIFO DATA reg
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t adxl372_get_fifo_xyz_data(struct adxl372_dev *dev,
+				  struct adxl372_xyz_accel_data *samples,
+				  uint16_t cnt)
+{
+	uint16_t nb_sets;
+
+	return adxl372_get_fifo_xyz_sets(dev, samples, cnt, &nb_sets);
+}
+
+/**
+ * Burst read FIFO data. Used as read callback of the FIFO drain engine.
+ * @param dev - The device structure.
+ * @param buf - Buffer for the FIFO entries.
+ * @param len - Number of bytes to be read.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int adxl372_fifo_read(void *dev, uint8_t *buf, uint32_t len)
+{
+	if (len > 1024)
+		return -EINVAL;
+
+	return adxl372_read_reg_multiple(dev, ADXL372_FIFO_DATA, buf, len);
+}
+
+/**
+ * Initialize a FIFO drain engine for the current FIFO configuration.
+ * @param dev - The device structure.
+ * @param entries - Number of entries read by each drain. When reading
+ *		    multiple axes, at least one set must be left in the FIFO,
+ *		    so this should be the FIFO watermark minus one set.
+ * @param fifo - The drain engine.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int adxl372_fifo_init(struct adxl372_dev *dev, uint16_t entries,
+		      struct adxl_fifo **fifo)
+{
+	struct adxl_fifo_init_param fifo_ip = {
+		.format = ADXL_FIFO_FORMAT_12B_MARKER,
+		.nb_channels = dev->fifo_parser.nb_channels,
+		.entries_per_read = entries,
+		.odr_mhz = 400000 << dev->odr,
+		.read = adxl372_fifo_read,
+		.dev = dev,
+	};
+
+	if (entries > 512)
+		return -EINVAL;
+
+	return adxl_fifo_init(fifo, &fifo_ip);
 }
 
 /**
@@ -40,6 +40,7 @@
 #include "no_os_gpio.h"
 #include "no_os_i2c.h"
 #include "no_os_spi.h"
+#include "adxl_fifo.h"
 
 /*
  * ADXL372 registers definition
@@ -149,6 +150,9 @@
 #define ADXL372_FIFO_CTL_SAMPLES_MSK		NO_OS_BIT(0)
 #define ADXL372_FIFO_CTL_SAMPLES_MODE(x)	(((x) > 0xFF) ? 1 : 0)
 
+/* Maximum number of sets returned by adxl372_get_fifo_xyz_sets() */
+#define ADXL372_FIFO_MAX_SETS			170
+
 /* ADXL372_STATUS_1 */
 #define ADXL372_STATUS_1_DATA_RDY(x)		(((x) >> 0) & 0x1)
 #define ADXL372_STATUS_1_FIFO_RDY(x)		(((x) >> 1) & 0x1)
@@ -371,6 +375,8 @@ struct adxl372_dev {
 	enum adxl372_act_proc_mode	act_proc_mode;
 	enum adxl372_instant_on_th_mode	th_mode;
 	struct adxl372_fifo_config	fifo_config;
+	/* FIFO set reassembly state */
+	struct adxl_fifo_parser		fifo_parser;
 	enum adxl372_comm_type		comm_type;
 };
 
@@ -462,6 +468,12 @@ int32_t adxl372_configure_fifo(struct adxl372_dev *dev,
 int32_t adxl372_get_fifo_xyz_data(struct adxl372_dev *dev,
 				  struct adxl372_xyz_accel_data *fifo_data,
 				  uint16_t cnt);
+int32_t adxl372_get_fifo_xyz_sets(struct adxl372_dev *dev,
+				  struct adxl372_xyz_accel_data *fifo_data,
+				  uint16_t cnt, uint16_t *nb_sets);
+int adxl372_fifo_read(void *dev, uint8_t *buf, uint32_t len);
+int adxl372_fifo_init(struct adxl372_dev *dev, uint16_t entries,
+		      struct adxl_fifo **fifo);
 int32_t adxl372_service_fifo_ev(struct adxl372_dev *dev,
 				struct adxl372_xyz_accel_data *fifo_data,
 				uint16_t *fifo_entries);
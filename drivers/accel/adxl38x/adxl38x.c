@@ -971,3 +971,75 @@ int adxl38x_data_raw_to_gees(struct adxl38x_dev *dev, uint8_t *raw_accel_data,
 	return 0;
 }
 
+
+/***************************************************************************//**
+ * @brief Burst reads FIFO data directly into the caller buffer. Used as read
+ *        callback of the FIFO drain engine.
+ *
+ * @param dev - The device structure.
+ * @param buf - Buffer for the FIFO entries.
+ * @param len - Number of bytes to be read.
+ *
+ * @return ret - Result of the reading procedure.
+*******************************************************************************/
+int adxl38x_fifo_read(void *dev, uint8_t *buf, uint32_t len)
+{
+	struct adxl38x_dev *desc = dev;
+	uint8_t reg = ADXL38X_FIFO_DATA;
+	uint8_t cmd = (ADXL38X_FIFO_DATA << 1) | ADXL38X_SPI_READ;
+	struct no_os_spi_msg msgs[] = {
+		{
+			.tx_buff = &cmd,
+			.bytes_number = 1,
+		},
+		{
+			.rx_buff = buf,
+			.bytes_number = len,
+			.cs_change = 1,
+		},
+	};
+	int ret;
+
+	if (desc->comm_type == ADXL38X_SPI_COMM)
+		return no_os_spi_transfer(desc->com_desc.spi_desc, msgs,
+					  NO_OS_ARRAY_SIZE(msgs));
+
+	ret = no_os_i2c_write(desc->com_desc.i2c_desc, &reg, 1, 0);
+	if (ret)
+		return ret;
+
+	return no_os_i2c_read(desc->com_desc.i2c_desc, buf, len, 1);
+}
+
+/***************************************************************************//**
+ * @brief Initializes a FIFO drain engine. The FIFO must be configured with
+ *        channel ID enabled (see adxl38x_accel_set_FIFO()).
+ *
+ * @param dev      - The device structure.
+ * @param channels - Channels stored in the FIFO, as enabled in DIG_EN.
+ * @param entries  - Number of entries read by each drain, usually the FIFO
+ *                   watermark.
+ * @param odr_mhz  - Output data rate of the operating mode, in mHz.
+ * @param fifo     - The drain engine.
+ *
+ * @return ret - Result of the initialization procedure.
+*******************************************************************************/
+int adxl38x_fifo_init(struct adxl38x_dev *dev, enum adxl38x_ch_select channels,
+		      uint16_t entries, uint32_t odr_mhz, struct adxl_fifo **fifo)
+{
+	struct adxl_fifo_init_param fifo_ip = {
+		.format = ADXL_FIFO_FORMAT_16B_CHID,
+		.entries_per_read = entries,
+		.odr_mhz = odr_mhz,
+		.read = adxl38x_fifo_read,
+		.dev = dev,
+	};
+	uint8_t id;
+
+	// Channels are stored in x, y, z, temperature order, with IDs 0 to 3
+	for (id = 0; id < ADXL_FIFO_MAX_CHANNELS; id++)
+		if (channels & NO_OS_BIT(id))
+			fifo_ip.chan_ids[fifo_ip.nb_channels++] = id;
+
+	return adxl_fifo_init(fifo, &fifo_ip);
+}
@@ -37,6 +37,7 @@
 #include <stdbool.h>
 #include "no_os_i2c.h"
 #include "no_os_spi.h"
+#include "adxl_fifo.h"
 
 /* Constants and Macros */
 
@@ -450,5 +451,10 @@ int adxl38x_accel_set_FIFO(struct adxl38x_dev *dev, uint16_t numSamples,
 int adxl38x_data_raw_to_gees(struct adxl38x_dev *dev, uint8_t *raw_accel_data,
 			     struct adxl38x_fractional_val *data_frac);
 
+int adxl38x_fifo_read(void *dev, uint8_t *buf, uint32_t len);
+
+int adxl38x_fifo_init(struct adxl38x_dev *dev, enum adxl38x_ch_select channels,
+		      uint16_t entries, uint32_t odr_mhz, struct adxl_fifo **fifo);
+
 #endif /* __ADXL38X_H__ */
 
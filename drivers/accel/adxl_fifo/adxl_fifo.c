@@ -0,0 +1,410 @@
+/***************************************************************************//**
+ *   @file   drivers/accel/adxl_fifo/adxl_fifo.c
+ *   @brief  Common FIFO drain engine for the ADXL accelerometers.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <errno.h>
+#include <string.h>
+#include "adxl_fifo.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+
+/** Number of entries unpacked at once by adxl_fifo_parse(). */
+#define ADXL_FIFO_CHUNK		32
+
+/* Tags of the 20 bit marker format, indexed by the empty and marker bits. */
+static const uint8_t adxl_fifo_tags_20b[4] = {
+	ADXL_FIFO_TAG_NEXT, 0, ADXL_FIFO_TAG_EMPTY, ADXL_FIFO_TAG_EMPTY
+};
+
+/* Tags of the 12 bit marker format, indexed by the series start bit. */
+static const uint8_t adxl_fifo_tags_12b[2] = {
+	ADXL_FIFO_TAG_NEXT, 0
+};
+
+/***************************************************************************//**
+ * @brief Get the size in bytes of a FIFO entry.
+ *
+ * @param format - Entry layout.
+ *
+ * @return Entry size in bytes.
+*******************************************************************************/
+uint8_t adxl_fifo_entry_size(enum adxl_fifo_format format)
+{
+	switch (format) {
+	case ADXL_FIFO_FORMAT_20B_MARKER:
+	case ADXL_FIFO_FORMAT_16B_CHID:
+		return 3;
+	default:
+		return 2;
+	}
+}
+
+/***************************************************************************//**
+ * @brief Unpack FIFO entries into sign extended values and tags. The tag is
+ * 	  the channel ID for the channel ID formats. For the marker formats it is
+ * 	  0 for the first entry of a set and ADXL_FIFO_TAG_NEXT otherwise.
+ * 	  Empty entries are tagged ADXL_FIFO_TAG_EMPTY.
+ * 	  Each format is unpacked by its own branchless loop.
+ *
+ * @param format     - Entry layout.
+ * @param buf        - Raw FIFO data.
+ * @param nb_entries - Number of entries in buf.
+ * @param vals       - Unpacked values.
+ * @param tags       - Entry tags.
+*******************************************************************************/
+void adxl_fifo_unpack(enum adxl_fifo_format format, const uint8_t *buf,
+		      uint32_t nb_entries, int32_t *vals, uint8_t *tags)
+{
+	uint32_t i;
+
+	switch (format) {
+	case ADXL_FIFO_FORMAT_20B_MARKER:
+		for (i = 0; i < nb_entries; i++, buf += 3) {
+			vals[i] = (int32_t)(((uint32_t)buf[0] << 24) |
+					    ((uint32_t)buf[1] << 16) |
+					    ((uint32_t)buf[2] << 8)) >> 12;
+			tags[i] = adxl_fifo_tags_20b[buf[2] & 0x3];
+		}
+		break;
+	case ADXL_FIFO_FORMAT_12B_MARKER:
+		for (i = 0; i < nb_entries; i++, buf += 2) {
+			vals[i] = (int16_t)((buf[0] << 8) | buf[1]) >> 4;
+			tags[i] = adxl_fifo_tags_12b[buf[1] & 0x1];
+		}
+		break;
+	case ADXL_FIFO_FORMAT_14B_CHID:
+		for (i = 0; i < nb_entries; i++, buf += 2) {
+			vals[i] = (int32_t)(((uint32_t)buf[0] << 26) |
+					    ((uint32_t)buf[1] << 18)) >> 18;
+			tags[i] = buf[0] >> 6;
+		}
+		break;
+	case ADXL_FIFO_FORMAT_16B_CHID:
+		for (i = 0; i < nb_entries; i++, buf += 3) {
+			vals[i] = (int16_t)((buf[1] << 8) | buf[2]);
+			tags[i] = buf[0] & 0x3;
+		}
+		break;
+	}
+}
+
+/***************************************************************************//**
+ * @brief Check if an entry may be placed at a given position of a set.
+ *
+ * @param parser - Parser descriptor.
+ * @param tag    - Entry tag.
+ * @param pos    - Position in the set.
+ *
+ * @return true if the entry matches the position, false otherwise.
+*******************************************************************************/
+static bool adxl_fifo_match(struct adxl_fifo_parser *parser, uint8_t tag,
+			    uint8_t pos)
+{
+	switch (parser->format) {
+	case ADXL_FIFO_FORMAT_20B_MARKER:
+	case ADXL_FIFO_FORMAT_12B_MARKER:
+		return (tag == 0) == (pos == 0);
+	default:
+		return tag == parser->chan_ids[pos];
+	}
+}
+
+/***************************************************************************//**
+ * @brief Reset the set reassembly state. The statistics are kept.
+ *
+ * @param parser - Parser descriptor.
+*******************************************************************************/
+void adxl_fifo_parser_reset(struct adxl_fifo_parser *parser)
+{
+	parser->synced = false;
+	parser->pos = 0;
+}
+
+/***************************************************************************//**
+ * @brief Parse raw FIFO data into complete sets. A set started by a previous
+ * 	  call is completed with the first entries of buf, and the entries of
+ * 	  an incomplete set at the end of buf are kept for the next call.
+ *
+ * @param parser     - Parser descriptor.
+ * @param buf        - Raw FIFO data.
+ * @param nb_entries - Number of entries in buf.
+ * @param sets       - Output sets, nb_channels values each.
+ * @param max_sets   - Capacity of sets. Further sets are counted as overflows.
+ * @param nb_sets    - Number of sets written.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+int adxl_fifo_parse(struct adxl_fifo_parser *parser, const uint8_t *buf,
+		    uint32_t nb_entries, int32_t *sets, uint32_t max_sets,
+		    uint32_t *nb_sets)
+{
+	int32_t vals[ADXL_FIFO_CHUNK];
+	uint8_t tags[ADXL_FIFO_CHUNK];
+	uint8_t size, nb_chan;
+	uint32_t i, cnt, n = 0;
+
+	if (!parser || !buf || !sets || !nb_sets)
+		return -EINVAL;
+
+	nb_chan = parser->nb_channels;
+	if (!nb_chan || nb_chan > ADXL_FIFO_MAX_CHANNELS)
+		return -EINVAL;
+
+	size = adxl_fifo_entry_size(parser->format);
+
+	while (nb_entries) {
+		cnt = no_os_min(nb_entries, (uint32_t)ADXL_FIFO_CHUNK);
+		adxl_fifo_unpack(parser->format, buf, cnt, vals, tags);
+
+		for (i = 0; i < cnt; i++) {
+			if (tags[i] == ADXL_FIFO_TAG_EMPTY) {
+				parser->empty++;
+				continue;
+			}
+
+			if (!parser->synced ||
+			    !adxl_fifo_match(parser, tags[i], parser->pos)) {
+				if (parser->synced)
+					parser->resyncs++;
+				parser->synced = false;
+				parser->pos = 0;
+				if (!adxl_fifo_match(parser, tags[i], 0)) {
+					parser->skipped++;
+					continue;
+				}
+				parser->synced = true;
+			}
+
+			parser->partial[parser->pos++] = vals[i];
+			if (parser->pos < nb_chan)
+				continue;
+
+			parser->pos = 0;
+			if (n == max_sets) {
+				parser->overflows++;
+				continue;
+			}
+			memcpy(&sets[n * nb_chan], parser->partial,
+			       nb_chan * sizeof(*sets));
+			n++;
+		}
+
+		buf += cnt * size;
+		nb_entries -= cnt;
+	}
+
+	*nb_sets = n;
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Initialize the drain engine.
+ *
+ * @param fifo  - The engine descriptor.
+ * @param param - Initialization parameters.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+int adxl_fifo_init(struct adxl_fifo **fifo,
+		   const struct adxl_fifo_init_param *param)
+{
+	struct adxl_fifo *desc;
+	int ret;
+
+	if (!fifo || !param || !param->read || !param->entries_per_read ||
+	    !param->nb_channels || param->nb_channels > ADXL_FIFO_MAX_CHANNELS)
+		return -EINVAL;
+
+	desc = (struct adxl_fifo *)no_os_calloc(1, sizeof(*desc));
+	if (!desc)
+		return -ENOMEM;
+
+	desc->buf = (uint8_t *)no_os_calloc(param->entries_per_read,
+					    adxl_fifo_entry_size(param->format));
+	if (!desc->buf) {
+		ret = -ENOMEM;
+		goto error;
+	}
+
+	desc->parser.format = param->format;
+	desc->parser.nb_channels = param->nb_channels;
+	memcpy(desc->parser.chan_ids, param->chan_ids,
+	       sizeof(desc->parser.chan_ids));
+	desc->entries_per_read = param->entries_per_read;
+	desc->read = param->read;
+	desc->dev = param->dev;
+
+	ret = adxl_fifo_set_odr(desc, param->odr_mhz);
+	if (ret)
+		goto error_buf;
+
+	adxl_fifo_reset(desc, 0);
+	*fifo = desc;
+
+	return 0;
+
+error_buf:
+	no_os_free(desc->buf);
+error:
+	no_os_free(desc);
+
+	return ret;
+}
+
+/***************************************************************************//**
+ * @brief Free the resources allocated by adxl_fifo_init().
+ *
+ * @param fifo - The engine descriptor.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+int adxl_fifo_remove(struct adxl_fifo *fifo)
+{
+	if (!fifo)
+		return -EINVAL;
+
+	no_os_free(fifo->buf);
+	no_os_free(fifo);
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Drop the parser state and restart the timestamps. To be called
+ * 	  after the FIFO was flushed or reconfigured.
+ *
+ * @param fifo  - The engine descriptor.
+ * @param ts_ns - Timestamp of the next set, in ns.
+*******************************************************************************/
+void adxl_fifo_reset(struct adxl_fifo *fifo, uint64_t ts_ns)
+{
+	adxl_fifo_parser_reset(&fifo->parser);
+	fifo->ts_ns = ts_ns;
+	fifo->ts_rem = 0;
+}
+
+/***************************************************************************//**
+ * @brief Set the output data rate used for the timestamps.
+ *
+ * @param fifo    - The engine descriptor.
+ * @param odr_mhz - Output data rate, in mHz.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+int adxl_fifo_set_odr(struct adxl_fifo *fifo, uint32_t odr_mhz)
+{
+	if (!fifo || !odr_mhz)
+		return -EINVAL;
+
+	fifo->odr_mhz = odr_mhz;
+	fifo->period_ns = no_os_div_u64_rem(1000000000000ULL, odr_mhz,
+					    &fifo->period_rem);
+	fifo->ts_rem = 0;
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Advance the timestamp by one sample period.
+ *
+ * @param fifo - The engine descriptor.
+*******************************************************************************/
+static void adxl_fifo_ts_advance(struct adxl_fifo *fifo)
+{
+	fifo->ts_ns += fifo->period_ns;
+	fifo->ts_rem += fifo->period_rem;
+	if (fifo->ts_rem >= fifo->odr_mhz) {
+		fifo->ts_rem -= fifo->odr_mhz;
+		fifo->ts_ns++;
+	}
+}
+
+/***************************************************************************//**
+ * @brief Maximum number of sets returned by one drain.
+ *
+ * @param fifo - The engine descriptor.
+ *
+ * @return Number of sets.
+*******************************************************************************/
+uint32_t adxl_fifo_max_sets(struct adxl_fifo *fifo)
+{
+	return fifo->entries_per_read / fifo->parser.nb_channels + 1;
+}
+
+/***************************************************************************//**
+ * @brief Read entries_per_read FIFO entries in one burst and return the
+ * 	  complete sets, timestamped from the output data rate.
+ *
+ * @param fifo     - The engine descriptor.
+ * @param sets     - Output sets, nb_channels values each.
+ * @param ts       - Timestamp of each set, in ns. May be NULL.
+ * @param max_sets - Capacity of sets and ts.
+ * @param nb_sets  - Number of sets written.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+int adxl_fifo_drain(struct adxl_fifo *fifo, int32_t *sets, uint64_t *ts,
+		    uint32_t max_sets, uint32_t *nb_sets)
+{
+	uint32_t i, overflows;
+	int ret;
+
+	if (!fifo)
+		return -EINVAL;
+
+	ret = fifo->read(fifo->dev, fifo->buf, fifo->entries_per_read *
+			 adxl_fifo_entry_size(fifo->parser.format));
+	if (ret)
+		return ret;
+
+	fifo->reads++;
+	overflows = fifo->parser.overflows;
+
+	ret = adxl_fifo_parse(&fifo->parser, fifo->buf, fifo->entries_per_read,
+			      sets, max_sets, nb_sets);
+	if (ret)
+		return ret;
+
+	for (i = 0; i < *nb_sets; i++) {
+		if (ts)
+			ts[i] = fifo->ts_ns;
+		adxl_fifo_ts_advance(fifo);
+	}
+
+	/* Sets which didn't fit still took their sample period. */
+	for (i = overflows; i != fifo->parser.overflows; i++)
+		adxl_fifo_ts_advance(fifo);
+
+	fifo->sets += *nb_sets;
+
+	return 0;
+}
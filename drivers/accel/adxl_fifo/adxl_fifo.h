@@ -0,0 +1,178 @@
+/***************************************************************************//**
+ *   @file   drivers/accel/adxl_fifo/adxl_fifo.h
+ *   @brief  Common FIFO drain engine for the ADXL accelerometers.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef __ADXL_FIFO_H__
+#define __ADXL_FIFO_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** Maximum number of channels in a FIFO sample set. */
+#define ADXL_FIFO_MAX_CHANNELS		4
+/** Tag of an entry which is not the first one of a set (marker formats). */
+#define ADXL_FIFO_TAG_NEXT		0xFE
+/** Tag of an entry read while the FIFO was empty. */
+#define ADXL_FIFO_TAG_EMPTY		0xFF
+
+/**
+ * @enum adxl_fifo_format
+ * @brief Layout of a FIFO entry.
+ */
+enum adxl_fifo_format {
+	/** 3 bytes, 20 bit left aligned, bit 0 x-axis marker, bit 1 empty
+	 *  indicator (ADXL355, ADXL357, ADXL359). */
+	ADXL_FIFO_FORMAT_20B_MARKER,
+	/** 2 bytes, 12 bit left aligned, bit 0 series start (ADXL372). */
+	ADXL_FIFO_FORMAT_12B_MARKER,
+	/** 2 bytes, 2 bit channel ID followed by 14 bit data (ADXL367). */
+	ADXL_FIFO_FORMAT_14B_CHID,
+	/** 3 bytes, channel ID byte followed by 16 bit data (ADXL38X). */
+	ADXL_FIFO_FORMAT_16B_CHID,
+};
+
+/**
+ * @struct adxl_fifo_parser
+ * @brief FIFO set reassembly state. A set split between two reads is
+ * completed by the next one; when an entry doesn't match the expected
+ * position, the partial set is dropped and parsing restarts at the next
+ * entry which begins a set.
+ */
+struct adxl_fifo_parser {
+	/** Entry layout. */
+	enum adxl_fifo_format format;
+	/** Number of entries in a set. */
+	uint8_t nb_channels;
+	/** Channel IDs of the set, in FIFO order (channel ID formats only). */
+	uint8_t chan_ids[ADXL_FIFO_MAX_CHANNELS];
+	/** A set start was seen since the last loss of alignment. */
+	bool synced;
+	/** Position of the next entry in the set. */
+	uint8_t pos;
+	/** Entries of the incomplete set. */
+	int32_t partial[ADXL_FIFO_MAX_CHANNELS];
+	/** Number of times the alignment was lost. */
+	uint32_t resyncs;
+	/** Number of entries discarded while waiting for a set start. */
+	uint32_t skipped;
+	/** Number of empty entries. */
+	uint32_t empty;
+	/** Number of complete sets which didn't fit in the output. */
+	uint32_t overflows;
+};
+
+/**
+ * @struct adxl_fifo_init_param
+ * @brief Drain engine initialization parameters.
+ */
+struct adxl_fifo_init_param {
+	/** Entry layout. */
+	enum adxl_fifo_format format;
+	/** Number of entries in a set. */
+	uint8_t nb_channels;
+	/** Channel IDs of the set, in FIFO order (channel ID formats only). */
+	uint8_t chan_ids[ADXL_FIFO_MAX_CHANNELS];
+	/** Number of entries read by each drain, in one burst. */
+	uint16_t entries_per_read;
+	/** Output data rate, in mHz. */
+	uint32_t odr_mhz;
+	/** Burst read of the FIFO data register. */
+	int (*read)(void *dev, uint8_t *buf, uint32_t len);
+	/** Device passed to read(). */
+	void *dev;
+};
+
+/**
+ * @struct adxl_fifo
+ * @brief Drain engine descriptor.
+ */
+struct adxl_fifo {
+	/** Set reassembly state. */
+	struct adxl_fifo_parser parser;
+	/** Number of entries read by each drain. */
+	uint16_t entries_per_read;
+	/** Burst read of the FIFO data register. */
+	int (*read)(void *dev, uint8_t *buf, uint32_t len);
+	/** Device passed to read(). */
+	void *dev;
+	/** Raw FIFO data. */
+	uint8_t *buf;
+	/** Output data rate, in mHz. */
+	uint32_t odr_mhz;
+	/** Integer part of the sample period, in ns. */
+	uint64_t period_ns;
+	/** Fractional part of the sample period, in 1/odr_mhz ns. */
+	uint32_t period_rem;
+	/** Timestamp of the next set, in ns. */
+	uint64_t ts_ns;
+	/** Accumulated fractional part of the timestamp. */
+	uint32_t ts_rem;
+	/** Number of burst reads. */
+	uint32_t reads;
+	/** Number of sets delivered. */
+	uint32_t sets;
+};
+
+/** Get the size in bytes of a FIFO entry. */
+uint8_t adxl_fifo_entry_size(enum adxl_fifo_format format);
+
+/** Unpack FIFO entries into sign extended values and tags. */
+void adxl_fifo_unpack(enum adxl_fifo_format format, const uint8_t *buf,
+		      uint32_t nb_entries, int32_t *vals, uint8_t *tags);
+
+/** Reset the set reassembly state. */
+void adxl_fifo_parser_reset(struct adxl_fifo_parser *parser);
+
+/** Parse raw FIFO data into complete sets. */
+int adxl_fifo_parse(struct adxl_fifo_parser *parser, const uint8_t *buf,
+		    uint32_t nb_entries, int32_t *sets, uint32_t max_sets,
+		    uint32_t *nb_sets);
+
+/** Initialize the drain engine. */
+int adxl_fifo_init(struct adxl_fifo **fifo,
+		   const struct adxl_fifo_init_param *param);
+
+/** Free the resources allocated by adxl_fifo_init(). */
+int adxl_fifo_remove(struct adxl_fifo *fifo);
+
+/** Drop the parser state and restart the timestamps. */
+void adxl_fifo_reset(struct adxl_fifo *fifo, uint64_t ts_ns);
+
+/** Set the output data rate used for the timestamps. */
+int adxl_fifo_set_odr(struct adxl_fifo *fifo, uint32_t odr_mhz);
+
+/** Maximum number of sets returned by one drain. */
+uint32_t adxl_fifo_max_sets(struct adxl_fifo *fifo);
+
+/** Read the FIFO in one burst and return the complete sets. */
+int adxl_fifo_drain(struct adxl_fifo *fifo, int32_t *sets, uint64_t *ts,
+		    uint32_t max_sets, uint32_t *nb_sets);
+
+#endif /* __ADXL_FIFO_H__ */
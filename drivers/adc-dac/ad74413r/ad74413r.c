@@ -31,6 +31,7 @@
  * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 *******************************************************************************/
 
+#include <string.h>
 #include "ad74413r.h"
 #include "no_os_crc8.h"
 #include "no_os_delay.h"
@@ -266,6 +267,92 @@ int ad74413r_reg_read(struct ad74413r_desc *desc, uint32_t addr, uint16_t *val)
 	return 0;
 }
 
+/**
+ * @brief Read the raw frames of several registers in a single SPI transfer.
+ * Every frame selects the next register for readback while it returns the
+ * register selected by the previous frame, so N registers take N + 1 frames
+ * instead of 2 * N. The CRC of all the received frames is checked once the
+ * transfer is done.
+ * @param desc  - The device structure.
+ * @param addrs - The registers' addresses, in the order they are read.
+ * @param nb_regs - The number of registers (at most AD74413R_BURST_MAX_REGS).
+ * @param frames - The raw frames, 4 bytes for each register.
+ * @return 0 in case of success, -EINVAL if a CRC doesn't match, negative
+ * error otherwise.
+ */
+int ad74413r_reg_read_burst_raw(struct ad74413r_desc *desc,
+				const uint8_t *addrs, uint32_t nb_regs,
+				uint8_t *frames)
+{
+	struct no_os_spi_msg msgs[AD74413R_BURST_MAX_REGS + 1] = {0};
+	uint32_t crc_err_cnt = 0;
+	uint8_t *frame;
+	uint32_t i;
+	int ret;
+
+	if (!nb_regs || nb_regs > AD74413R_BURST_MAX_REGS)
+		return -EINVAL;
+
+	for (i = 0; i <= nb_regs; i++) {
+		if (i < nb_regs)
+			ad74413r_format_reg_write(AD74413R_READ_SELECT, addrs[i],
+						  &desc->burst_tx[i * AD74413R_FRAME_SIZE]);
+		else
+			ad74413r_format_reg_write(AD74413R_NOP, AD74413R_NOP,
+						  &desc->burst_tx[i * AD74413R_FRAME_SIZE]);
+
+		msgs[i].tx_buff = &desc->burst_tx[i * AD74413R_FRAME_SIZE];
+		msgs[i].rx_buff = &desc->burst_rx[i * AD74413R_FRAME_SIZE];
+		msgs[i].bytes_number = AD74413R_FRAME_SIZE;
+		msgs[i].cs_change = 1;
+	}
+
+	ret = no_os_spi_transfer(desc->comm_desc, msgs, nb_regs + 1);
+	if (ret)
+		return ret;
+
+	/* The first frame returns the register selected before the burst. */
+	frame = &desc->burst_rx[AD74413R_FRAME_SIZE];
+	for (i = 0; i < nb_regs; i++, frame += AD74413R_FRAME_SIZE)
+		if (no_os_crc8(_crc_table, frame, 3, 0) != frame[3])
+			crc_err_cnt++;
+
+	if (crc_err_cnt) {
+		desc->crc_err_cnt += crc_err_cnt;
+		return -EINVAL;
+	}
+
+	memcpy(frames, &desc->burst_rx[AD74413R_FRAME_SIZE],
+	       nb_regs * AD74413R_FRAME_SIZE);
+
+	return 0;
+}
+
+/**
+ * @brief Read the values of several registers in a single SPI transfer.
+ * @param desc  - The device structure.
+ * @param addrs - The registers' addresses, in the order they are read.
+ * @param nb_regs - The number of registers (at most AD74413R_BURST_MAX_REGS).
+ * @param vals - The registers' values.
+ * @return 0 in case of success, negative error otherwise.
+ */
+int ad74413r_reg_read_burst(struct ad74413r_desc *desc, const uint8_t *addrs,
+			    uint32_t nb_regs, uint16_t *vals)
+{
+	uint8_t frames[AD74413R_BURST_MAX_REGS * AD74413R_FRAME_SIZE];
+	uint32_t i;
+	int ret;
+
+	ret = ad74413r_reg_read_burst_raw(desc, addrs, nb_regs, frames);
+	if (ret)
+		return ret;
+
+	for (i = 0; i < nb_regs; i++)
+		vals[i] = no_os_get_unaligned_be16(&frames[i * AD74413R_FRAME_SIZE + 1]);
+
+	return 0;
+}
+
 /**
  * @brief Update a register's field.
  * @param desc  - The device structure.
@@ -453,6 +540,44 @@ int ad74413r_get_raw_adc_result(struct ad74413r_desc *desc, uint32_t ch,
 	return ad74413r_reg_read(desc, AD74413R_ADC_RESULT(ch), val);
 }
 
+/**
+ * @brief Read the raw conversion values of several channels and the alert
+ * status in a single SPI burst, while the ADC converts continuously.
+ * @param desc - The device structure.
+ * @param ch_mask - Bit mask of the channels to read.
+ * @param vals - The ADC raw conversion values, indexed by channel.
+ * @param alert_status - The ALERT_STATUS register value. May be NULL.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int ad74413r_get_raw_adc_results(struct ad74413r_desc *desc, uint8_t ch_mask,
+				 uint16_t *vals, uint16_t *alert_status)
+{
+	uint8_t addrs[AD74413R_N_CHANNELS + 1];
+	uint16_t regs[AD74413R_N_CHANNELS + 1];
+	uint32_t nb_regs = 0;
+	uint32_t i;
+	int ret;
+
+	for (i = 0; i < AD74413R_N_CHANNELS; i++)
+		if (ch_mask & NO_OS_BIT(i))
+			addrs[nb_regs++] = AD74413R_ADC_RESULT(i);
+	addrs[nb_regs++] = AD74413R_ALERT_STATUS;
+
+	ret = ad74413r_reg_read_burst(desc, addrs, nb_regs, regs);
+	if (ret)
+		return ret;
+
+	nb_regs = 0;
+	for (i = 0; i < AD74413R_N_CHANNELS; i++)
+		if (ch_mask & NO_OS_BIT(i))
+			vals[i] = regs[nb_regs++];
+
+	if (alert_status)
+		*alert_status = regs[nb_regs];
+
+	return 0;
+}
+
 /**
  * @brief Enable/disable a specific ADC channel
  * @param desc - The device structure.
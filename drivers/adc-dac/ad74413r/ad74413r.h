@@ -46,6 +46,15 @@
 #define AD74413R_CH_C                   2
 #define AD74413R_CH_D                   3
 
+/**
+ * Maximum number of registers read by ad74413r_reg_read_burst(): DIN_COMP_OUT,
+ * the ADC and diagnostics results and ALERT_STATUS.
+ */
+#define AD74413R_BURST_MAX_REGS		(AD74413R_N_CHANNELS + \
+					 AD74413R_N_DIAG_CHANNELS + 2)
+/** A burst of N registers is made of N + 1 4-byte frames */
+#define AD74413R_BURST_BUFF_SIZE	((AD74413R_BURST_MAX_REGS + 1) * 4)
+
 /** The value of the sense resistor in ohms */
 #define AD74413R_RSENSE                 100
 /** 16 bit ADC */
@@ -352,6 +361,12 @@ struct ad74413r_desc {
 	uint8_t comm_buff[4];
 	struct ad74413r_channel_config channel_configs[AD74413R_N_CHANNELS];
 	struct no_os_gpio_desc *reset_gpio;
+	/** Frames sent during a burst read */
+	uint8_t burst_tx[AD74413R_BURST_BUFF_SIZE];
+	/** Frames received during a burst read */
+	uint8_t burst_rx[AD74413R_BURST_BUFF_SIZE];
+	/** Number of frames received with a wrong CRC by burst reads */
+	uint32_t crc_err_cnt;
 };
 
 /** Converts a millivolt value in the corresponding DAC 13 bit code */
@@ -371,6 +386,14 @@ int ad74413r_reg_read_raw(struct ad74413r_desc *, uint32_t, uint8_t *);
 /** Read a register's value */
 int ad74413r_reg_read(struct ad74413r_desc *, uint32_t, uint16_t *);
 
+/** Read the raw frames of several registers in a single SPI transfer */
+int ad74413r_reg_read_burst_raw(struct ad74413r_desc *, const uint8_t *,
+				uint32_t, uint8_t *);
+
+/** Read the values of several registers in a single SPI transfer */
+int ad74413r_reg_read_burst(struct ad74413r_desc *, const uint8_t *,
+			    uint32_t, uint16_t *);
+
 /** Update a register's field */
 int ad74413r_reg_update(struct ad74413r_desc *, uint32_t, uint16_t,
 			uint16_t);
@@ -398,6 +421,10 @@ int ad74413r_set_channel_function(struct ad74413r_desc *,
 int ad74413r_get_raw_adc_result(struct ad74413r_desc *, uint32_t,
 				uint16_t *);
 
+/** Read the raw conversion values of several channels and the alert status */
+int ad74413r_get_raw_adc_results(struct ad74413r_desc *, uint8_t, uint16_t *,
+				 uint16_t *);
+
 /** Enable/disable a specific ADC channel */
 int ad74413r_set_adc_channel_enable(struct ad74413r_desc *, uint32_t,
 				    bool);
@@ -159,6 +159,10 @@ static int ad74413r_iio_buffer_disable(void *dev);
 static int ad74413r_iio_read_samples(void *dev, void *buf,
 				     uint32_t samples);
 static int ad74413r_iio_trigger_handler(struct iio_device_data *dev_data);
+static int ad74413r_iio_read_alert_status(void *dev, char *buf, uint32_t len,
+		const struct iio_ch_info *channel, intptr_t priv);
+static int ad74413r_iio_read_crc_errors(void *dev, char *buf, uint32_t len,
+					const struct iio_ch_info *channel, intptr_t priv);
 
 static struct scan_type ad74413r_iio_adc_scan_type = {
 	.sign = 'u',
@@ -379,7 +383,20 @@ static struct ad74413r_channel_map channel_map[] = {
 	[AD74413R_CURRENT_IN_LOOP_HART] = AD74413R_CHANNELS(current_input),
 };
 
+static struct iio_attribute ad74413r_iio_debug_attrs[] = {
+	{
+		.name = "alert_status",
+		.show = ad74413r_iio_read_alert_status,
+	},
+	{
+		.name = "crc_errors",
+		.show = ad74413r_iio_read_crc_errors,
+	},
+	END_ATTRIBUTES_ARRAY
+};
+
 static struct iio_device ad74413r_iio_dev = {
+	.debug_attributes = ad74413r_iio_debug_attrs,
 	.pre_enable = ad74413r_iio_update_channels,
 	.post_disable = ad74413r_iio_buffer_disable,
 	.trigger_handler = ad74413r_iio_trigger_handler,
@@ -1337,6 +1354,19 @@ free_channels:
 	return ret;
 }
 
+/**
+ * @brief Check if a channel is configured as a digital input.
+ * @param iio_desc - The iio device descriptor.
+ * @param ch - The channel index.
+ * @return true if the channel is a digital input, false otherwise
+ */
+static bool ad74413r_iio_is_digital(struct ad74413r_iio_desc *iio_desc,
+				    uint32_t ch)
+{
+	return iio_desc->channel_configs[ch].function == AD74413R_DIGITAL_INPUT ||
+	       iio_desc->channel_configs[ch].function == AD74413R_DIGITAL_INPUT_LOOP;
+}
+
 /**
  * @brief Enable IIO channels and start the ADC conversions in continuous mode.
  * @param dev - The iio device structure.
@@ -1352,6 +1382,7 @@ static int ad74413r_iio_update_channels(void *dev, uint32_t mask)
 
 	iio_desc->active_channels = mask;
 	iio_desc->no_of_active_channels = no_os_hweight8(mask);
+	iio_desc->burst_nb = 0;
 
 	for (i = 0; i < AD74413R_N_CHANNELS + AD74413R_N_DIAG_CHANNELS; i++) {
 		if (mask & NO_OS_BIT(i)) {
@@ -1359,6 +1390,18 @@ static int ad74413r_iio_update_channels(void *dev, uint32_t mask)
 			if (ret)
 				return ret;
 
+			iio_desc->burst_ch[iio_desc->burst_nb] = ch;
+			if (ch >= AD74413R_N_CHANNELS)
+				iio_desc->burst_addrs[iio_desc->burst_nb] =
+					AD74413R_DIAG_RESULT(ch - AD74413R_N_CHANNELS);
+			else if (ad74413r_iio_is_digital(iio_desc, ch))
+				iio_desc->burst_addrs[iio_desc->burst_nb] =
+					AD74413R_DIN_COMP_OUT;
+			else
+				iio_desc->burst_addrs[iio_desc->burst_nb] =
+					AD74413R_ADC_RESULT(ch);
+			iio_desc->burst_nb++;
+
 			if (ch < AD74413R_N_CHANNELS) {
 				ret = ad74413r_set_adc_channel_enable(iio_desc->ad74413r_desc,
 								      ch, true);
@@ -1377,6 +1420,10 @@ static int ad74413r_iio_update_channels(void *dev, uint32_t mask)
 		}
 	}
 
+	/* The alert status is read at the end of every scan */
+	iio_desc->burst_ch[iio_desc->burst_nb] = 0;
+	iio_desc->burst_addrs[iio_desc->burst_nb++] = AD74413R_ALERT_STATUS;
+
 	ret = ad74413r_set_adc_conv_seq(iio_desc->ad74413r_desc, AD74413R_START_CONT);
 	if (ret)
 		return ret;
@@ -1419,6 +1466,43 @@ static int ad74413r_iio_buffer_disable(void *dev)
 	return 0;
 }
 
+/**
+ * @brief Read one scan of the enabled channels, together with the alert
+ * status, using a single SPI burst.
+ * @param iio_desc - The iio device descriptor.
+ * @param buff - The raw frames of the enabled channels, in scan order.
+ * @return 0 in case of success, an error code otherwise.
+ */
+static int ad74413r_iio_read_scan(struct ad74413r_iio_desc *iio_desc,
+				  uint8_t *buff)
+{
+	uint32_t digital_val;
+	uint8_t *frame;
+	uint32_t i;
+	int ret;
+
+	ret = ad74413r_reg_read_burst_raw(iio_desc->ad74413r_desc,
+					  iio_desc->burst_addrs,
+					  iio_desc->burst_nb, buff);
+	if (ret)
+		return ret;
+
+	for (i = 0; i < iio_desc->burst_nb - 1; i++) {
+		if (iio_desc->burst_addrs[i] != AD74413R_DIN_COMP_OUT)
+			continue;
+
+		frame = &buff[i * 4];
+		digital_val = no_os_field_get(AD74413R_DIN_COMP_CH(iio_desc->burst_ch[i]),
+					      frame[2]);
+		frame[1] = 0x0;
+		frame[2] = !!digital_val;
+	}
+
+	iio_desc->alert_status = no_os_get_unaligned_be16(&buff[i * 4 + 1]);
+
+	return 0;
+}
+
 /**
  * @brief Read a number of samples from each enabled channel.
  * @param dev - The iio device structure.
@@ -1428,85 +1512,79 @@ static int ad74413r_iio_buffer_disable(void *dev)
  */
 static int ad74413r_iio_read_samples(void *dev, void *buf, uint32_t samples)
 {
-	int ret;
-	uint32_t j = 0;
-	uint32_t val;
-	uint32_t i, chan_i;
+	uint8_t buff[AD74413R_BURST_MAX_REGS * 4];
 	struct ad74413r_iio_desc *iio_desc = dev;
-	uint32_t *ibuf = buf;
+	uint32_t scan_size;
+	uint8_t *ibuf = buf;
+	uint32_t i;
+	int ret;
+
+	scan_size = (iio_desc->burst_nb - 1) * 4;
 
 	for (i = 0; i < samples; i++) {
-		for (chan_i = 0; chan_i < AD74413R_N_CHANNELS; chan_i++) {
-			if (iio_desc->active_channels & NO_OS_BIT(chan_i)) {
-				ret = ad74413r_reg_read_raw(iio_desc->ad74413r_desc,
-							    AD74413R_ADC_RESULT(chan_i),
-							    (uint8_t *)&val);
-				if (ret)
-					return ret;
-				ibuf[j++] = val;
-			}
-		}
+		ret = ad74413r_iio_read_scan(iio_desc, buff);
+		if (ret)
+			return ret;
+
+		memcpy(&ibuf[i * scan_size], buff, scan_size);
 	}
 
 	return samples;
 }
 
 /**
- * @brief Read a sample for each enabled channel.
+ * @brief Read a sample for each enabled channel. The ADC results, the
+ * digital input states, the diagnostics results and the alert status are
+ * read in a single SPI burst.
  * @param dev_data - The iio device data structure.
  * @return 0 in case of success, an error code otherwise.
  */
 static int ad74413r_iio_trigger_handler(struct iio_device_data *dev_data)
 {
+	uint8_t buff[AD74413R_BURST_MAX_REGS * 4];
 	int ret;
-	uint32_t i;
-	uint32_t ch;
-	uint32_t diag_ch_idx;
-	uint32_t digital_val;
-	uint8_t buff[32] = {0};
-	uint32_t buffer_idx = 0;
-	struct ad74413r_iio_desc *iio_desc;
-	struct ad74413r_channel_config *config;
-	struct ad74413r_desc *desc;
 
-	iio_desc = dev_data->dev;
-	desc = iio_desc->ad74413r_desc;
-	config = iio_desc->channel_configs;
+	ret = ad74413r_iio_read_scan(dev_data->dev, buff);
+	if (ret)
+		return ret;
 
-	for (i = 0; i < AD74413R_N_CHANNELS + AD74413R_N_CHANNELS; i++) {
-		if (iio_desc->active_channels & NO_OS_BIT(i)) {
-			ret = _get_ch_by_idx(iio_desc->iio_dev, i, &ch);
-			if (ret)
-				continue;
+	return iio_buffer_push_scan(dev_data->buffer, buff);
+}
 
-			if (ch < AD74413R_N_DIAG_CHANNELS) {
-				if (config[ch].function == AD74413R_DIGITAL_INPUT ||
-				    config[ch].function == AD74413R_DIGITAL_INPUT_LOOP) {
-					ret = ad74413r_reg_read_raw(desc, AD74413R_DIN_COMP_OUT,
-								    &buff[buffer_idx]);
-					digital_val = no_os_field_get(AD74413R_DIN_COMP_CH(ch),
-								      buff[buffer_idx + 2]);
-					buff[buffer_idx + 1] = 0x0;
-					buff[buffer_idx + 2] = !!digital_val;
-				} else {
-					ret = ad74413r_reg_read_raw(desc, AD74413R_ADC_RESULT(ch),
-								    &buff[buffer_idx]);
-				}
-			} else {
-				diag_ch_idx = ch - AD74413R_N_DIAG_CHANNELS;
-				ret = ad74413r_reg_read_raw(desc,
-							    AD74413R_DIAG_RESULT(diag_ch_idx),
-							    &buff[buffer_idx]);
-			}
+/**
+ * @brief Read the alert status captured with the last scan.
+ * @param dev - The iio device structure.
+ * @param buf - Buffer to be filled with requested data.
+ * @param len - Length of the received command buffer in bytes.
+ * @param channel - Command channel info.
+ * @param priv - Private descriptor
+ * @return The number of bytes written in buf, an error code otherwise
+ */
+static int ad74413r_iio_read_alert_status(void *dev, char *buf, uint32_t len,
+		const struct iio_ch_info *channel, intptr_t priv)
+{
+	struct ad74413r_iio_desc *iio_desc = dev;
+	int32_t val = iio_desc->alert_status;
 
-			if (ret)
-				return ret;
+	return iio_format_value(buf, len, IIO_VAL_INT, 1, &val);
+}
 
-			buffer_idx += 4;
-		}
-	}
+/**
+ * @brief Read the number of frames with a wrong CRC received by the scans.
+ * @param dev - The iio device structure.
+ * @param buf - Buffer to be filled with requested data.
+ * @param len - Length of the received command buffer in bytes.
+ * @param channel - Command channel info.
+ * @param priv - Private descriptor
+ * @return The number of bytes written in buf, an error code otherwise
+ */
+static int ad74413r_iio_read_crc_errors(void *dev, char *buf, uint32_t len,
+					const struct iio_ch_info *channel, intptr_t priv)
+{
+	struct ad74413r_iio_desc *iio_desc = dev;
+	int32_t val = iio_desc->ad74413r_desc->crc_err_cnt;
 
-	return iio_buffer_push_scan(dev_data->buffer, buff);
+	return iio_format_value(buf, len, IIO_VAL_INT, 1, &val);
 }
 
 /**
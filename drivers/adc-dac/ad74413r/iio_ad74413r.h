@@ -75,6 +75,14 @@ struct ad74413r_iio_desc {
 	enum ad74413r_conv_seq conv_state;
 	struct ad74413r_diag_channel_config
 		diag_channel_configs[AD74413R_N_DIAG_CHANNELS];
+	/** Registers read for each scan, followed by ALERT_STATUS */
+	uint8_t burst_addrs[AD74413R_BURST_MAX_REGS];
+	/** Channel of each register in burst_addrs */
+	uint8_t burst_ch[AD74413R_BURST_MAX_REGS];
+	/** Number of registers in burst_addrs */
+	uint32_t burst_nb;
+	/** ALERT_STATUS read with the last scan */
+	uint16_t alert_status;
 };
 
 /**
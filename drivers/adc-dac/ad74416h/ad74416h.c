@@ -31,6 +31,7 @@
  * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 *******************************************************************************/
 
+#include <string.h>
 #include "ad74416h.h"
 #include "no_os_crc8.h"
 #include "no_os_delay.h"
@@ -218,6 +219,94 @@ int ad74416h_reg_read(struct ad74416h_desc *desc, uint32_t addr, uint16_t *val)
 	return 0;
 }
 
+/**
+ * @brief Read the raw frames of several registers in a single SPI transfer.
+ * Every frame selects the next register for readback while it returns the
+ * register selected by the previous frame, so N registers take N + 1 frames
+ * instead of 2 * N. The CRC of all the received frames is checked once the
+ * transfer is done.
+ * @param desc  - The device structure.
+ * @param addrs - The registers' addresses, in the order they are read.
+ * @param nb_regs - The number of registers (at most AD74416H_BURST_MAX_REGS).
+ * @param frames - The raw frames, AD74416H_FRAME_SIZE bytes for each register.
+ * @return 0 in case of success, -EINVAL if a CRC doesn't match, negative
+ * error otherwise.
+ */
+int ad74416h_reg_read_burst_raw(struct ad74416h_desc *desc,
+				const uint8_t *addrs, uint32_t nb_regs,
+				uint8_t *frames)
+{
+	struct no_os_spi_msg msgs[AD74416H_BURST_MAX_REGS + 1] = {0};
+	uint32_t crc_err_cnt = 0;
+	uint8_t *frame;
+	uint32_t i;
+	int ret;
+
+	if (!nb_regs || nb_regs > AD74416H_BURST_MAX_REGS)
+		return -EINVAL;
+
+	for (i = 0; i <= nb_regs; i++) {
+		if (i < nb_regs)
+			ad74416h_format_reg_write(desc->dev_addr, AD74416H_READ_SELECT,
+						  addrs[i],
+						  &desc->burst_tx[i * AD74416H_FRAME_SIZE]);
+		else
+			ad74416h_format_reg_write(desc->dev_addr, AD74416H_NOP,
+						  AD74416H_NOP,
+						  &desc->burst_tx[i * AD74416H_FRAME_SIZE]);
+
+		msgs[i].tx_buff = &desc->burst_tx[i * AD74416H_FRAME_SIZE];
+		msgs[i].rx_buff = &desc->burst_rx[i * AD74416H_FRAME_SIZE];
+		msgs[i].bytes_number = AD74416H_FRAME_SIZE;
+		msgs[i].cs_change = 1;
+	}
+
+	ret = no_os_spi_transfer(desc->spi_desc, msgs, nb_regs + 1);
+	if (ret)
+		return ret;
+
+	/* The first frame returns the register selected before the burst. */
+	frame = &desc->burst_rx[AD74416H_FRAME_SIZE];
+	for (i = 0; i < nb_regs; i++, frame += AD74416H_FRAME_SIZE)
+		if (no_os_crc8(_crc_table, frame, 4, 0) != frame[4])
+			crc_err_cnt++;
+
+	if (crc_err_cnt) {
+		desc->crc_err_cnt += crc_err_cnt;
+		return -EINVAL;
+	}
+
+	memcpy(frames, &desc->burst_rx[AD74416H_FRAME_SIZE],
+	       nb_regs * AD74416H_FRAME_SIZE);
+
+	return 0;
+}
+
+/**
+ * @brief Read the values of several registers in a single SPI transfer.
+ * @param desc  - The device structure.
+ * @param addrs - The registers' addresses, in the order they are read.
+ * @param nb_regs - The number of registers (at most AD74416H_BURST_MAX_REGS).
+ * @param vals - The registers' values.
+ * @return 0 in case of success, negative error otherwise.
+ */
+int ad74416h_reg_read_burst(struct ad74416h_desc *desc, const uint8_t *addrs,
+			    uint32_t nb_regs, uint16_t *vals)
+{
+	uint8_t frames[AD74416H_BURST_MAX_REGS * AD74416H_FRAME_SIZE];
+	uint32_t i;
+	int ret;
+
+	ret = ad74416h_reg_read_burst_raw(desc, addrs, nb_regs, frames);
+	if (ret)
+		return ret;
+
+	for (i = 0; i < nb_regs; i++)
+		vals[i] = no_os_get_unaligned_be16(&frames[i * AD74416H_FRAME_SIZE + 2]);
+
+	return 0;
+}
+
 /**
  * @brief Update a register's field.
  * @param desc  - The device structure.
@@ -301,6 +390,56 @@ int ad74416h_get_raw_adc_result(struct ad74416h_desc *desc, uint32_t ch,
 	return 0;
 }
 
+/**
+ * @brief Read the raw conversion values of several channels and the alert
+ * status in a single SPI burst, while the ADC converts continuously.
+ * @param desc - The device structure.
+ * @param ch_mask - Bit mask of the channels to read.
+ * @param vals - The ADC raw conversion values, indexed by channel.
+ * @param alert_status - The ALERT_STATUS register value. May be NULL.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int ad74416h_get_raw_adc_results(struct ad74416h_desc *desc, uint8_t ch_mask,
+				 uint32_t *vals, uint16_t *alert_status)
+{
+	uint8_t addrs[AD74416H_N_CHANNELS * 2 + 1];
+	uint16_t regs[AD74416H_N_CHANNELS * 2 + 1];
+	uint32_t nb_regs = 0;
+	uint32_t i;
+	int ret;
+
+	for (i = 0; i < AD74416H_N_CHANNELS; i++) {
+		if (!(ch_mask & NO_OS_BIT(i)))
+			continue;
+
+		if (desc->id == ID_AD74416H)
+			addrs[nb_regs++] = AD74416H_ADC_RESULT_UPR(i);
+		addrs[nb_regs++] = AD74416H_ADC_RESULT(i);
+	}
+	addrs[nb_regs++] = AD74416H_ALERT_STATUS;
+
+	ret = ad74416h_reg_read_burst(desc, addrs, nb_regs, regs);
+	if (ret)
+		return ret;
+
+	nb_regs = 0;
+	for (i = 0; i < AD74416H_N_CHANNELS; i++) {
+		if (!(ch_mask & NO_OS_BIT(i)))
+			continue;
+
+		vals[i] = 0;
+		if (desc->id == ID_AD74416H)
+			vals[i] = no_os_field_get(AD74416H_CONV_RES_UPR_MSK,
+						  regs[nb_regs++]) << 16;
+		vals[i] |= no_os_field_get(AD74416H_CONV_RESULT_MSK, regs[nb_regs++]);
+	}
+
+	if (alert_status)
+		*alert_status = regs[nb_regs];
+
+	return 0;
+}
+
 /**
  * @brief Enable/disable a specific ADC channel
  * @param desc - The device structure.
@@ -408,6 +408,16 @@
 #define AD74416H_TEMP_SCALE_DIV			1000
 
 #define AD74416H_FRAME_SIZE 			5
+
+/**
+ * Maximum number of registers read by ad74416h_reg_read_burst(): DIN_COMP_OUT,
+ * both result registers of every channel, the four diagnostics results and
+ * ALERT_STATUS.
+ */
+#define AD74416H_BURST_MAX_REGS			(AD74416H_N_CHANNELS * 2 + 6)
+/** A burst of N registers is made of N + 1 frames */
+#define AD74416H_BURST_BUFF_SIZE		((AD74416H_BURST_MAX_REGS + 1) * \
+						 AD74416H_FRAME_SIZE)
 #define AD74416H_THRESHOLD_DAC_RANGE		98
 #define AD74416H_THRESHOLD_RANGE		30000
 #define AD74416H_DAC_RANGE			12000
@@ -637,6 +647,12 @@ struct ad74416h_desc {
 	uint8_t comm_buff[AD74416H_FRAME_SIZE];
 	struct ad74416h_channel_config channel_configs[AD74416H_N_CHANNELS];
 	struct no_os_gpio_desc *reset_gpio;
+	/** Frames sent during a burst read */
+	uint8_t burst_tx[AD74416H_BURST_BUFF_SIZE];
+	/** Frames received during a burst read */
+	uint8_t burst_rx[AD74416H_BURST_BUFF_SIZE];
+	/** Number of frames received with a wrong CRC by burst reads */
+	uint32_t crc_err_cnt;
 };
 
 /** Converts a millivolt value in the corresponding DAC 13 bit code */
@@ -655,6 +671,14 @@ int ad74416h_reg_read_raw(struct ad74416h_desc *, uint32_t, uint8_t *);
 /** Read a register's value */
 int ad74416h_reg_read(struct ad74416h_desc *, uint32_t, uint16_t *);
 
+/** Read the raw frames of several registers in a single SPI transfer */
+int ad74416h_reg_read_burst_raw(struct ad74416h_desc *, const uint8_t *,
+				uint32_t, uint8_t *);
+
+/** Read the values of several registers in a single SPI transfer */
+int ad74416h_reg_read_burst(struct ad74416h_desc *, const uint8_t *,
+			    uint32_t, uint16_t *);
+
 /** Update a register's field */
 int ad74416h_reg_update(struct ad74416h_desc *, uint32_t, uint16_t,
 			uint16_t);
@@ -680,6 +704,10 @@ int ad74416h_set_channel_vout_range(struct ad74416h_desc *desc, uint32_t ch,
 int ad74416h_set_channel_i_limit(struct ad74416h_desc *, uint32_t,
 				 enum ad74416h_i_limit);
 
+/** Read the raw conversion values of several channels and the alert status */
+int ad74416h_get_raw_adc_results(struct ad74416h_desc *, uint8_t, uint32_t *,
+				 uint16_t *);
+
 /** Read the raw ADC raw conversion value */
 int ad74416h_get_raw_adc_result(struct ad74416h_desc *, uint32_t,
 				uint32_t *);
@@ -64,6 +64,9 @@ static void AD5940_StructInit(void *pStruct, uint32_t StructSize);
  *
  */
 
+/* Sequencer commands written to SRAM by one SPI transfer */
+#define AD5940_SEQ_WR_BURST	8
+
 /* Declare of SPI functions used to read/write registers */
 static int AD5940_SPIReadReg(struct no_os_spi_desc *spi, uint16_t RegAddr,
 			     uint32_t *RegData);
@@ -195,6 +198,7 @@ int ad5940_remove(struct ad5940_dev *dev)
 	no_os_gpio_remove(dev->reset_gpio);
 	no_os_spi_remove(dev->spi);
 	dev->spi = NULL;
+	no_os_free(dev->pFifoBuff);
 	no_os_free(dev);
 
 	return 0;
@@ -645,30 +649,104 @@ static int AD5940_SPIReadReg(struct no_os_spi_desc *spi, uint16_t RegAddr,
 	return 0;
 }
 
-static int AD5940_FIFORd_Fast(struct no_os_spi_desc *spi, uint32_t *pBuffer,
+/* Fill a register write as two messages of an SPI transfer: set address,
+ * then write. @ref pBuff must hold 8 bytes. Returns the number of messages. */
+static int AD5940_SPIWriteRegMsg(uint8_t *pBuff, struct no_os_spi_msg *pMsg,
+				 uint16_t RegAddr, uint32_t RegData)
+{
+	unsigned int i = 3;
+
+	pBuff[0] = SPICMD_SETADDR;
+	pBuff[1] = RegAddr >> 8;
+	pBuff[2] = RegAddr & 0xff;
+
+	pBuff[i++] = SPICMD_WRITEREG;
+	if (((RegAddr >= 0x1000) && (RegAddr <= 0x3014))) {
+		pBuff[i++] = RegData >> 24;
+		pBuff[i++] = RegData >> 16;
+	}
+	pBuff[i++] = RegData >> 8;
+	pBuff[i++] = RegData & 0xff;
+
+	pMsg[0] = (struct no_os_spi_msg) {
+		.tx_buff = pBuff,
+		.bytes_number = 3,
+		.cs_change = 1,
+	};
+	pMsg[1] = (struct no_os_spi_msg) {
+		.tx_buff = pBuff + 3,
+		.bytes_number = i - 3,
+		.cs_change = 1,
+	};
+
+	return 2;
+}
+
+/* Short FIFO reads: one register read per word, all in one SPI transfer */
+static int AD5940_FIFORd_Reg(struct no_os_spi_desc *spi, uint32_t *pBuffer,
+			     uint32_t uiReadCount)
+{
+	int ret;
+	uint8_t iobuf[3][9] = {0};
+	struct no_os_spi_msg msgs[6];
+	uint32_t i;
+
+	for (i = 0; i < uiReadCount; i++) {
+		iobuf[i][0] = SPICMD_SETADDR;
+		iobuf[i][1] = REG_AFE_DATAFIFORD >> 8;
+		iobuf[i][2] = REG_AFE_DATAFIFORD & 0xff;
+		iobuf[i][3] = SPICMD_READREG;
+
+		msgs[2 * i] = (struct no_os_spi_msg) {
+			.tx_buff = iobuf[i],
+			.bytes_number = 3,
+			.cs_change = 1,
+		};
+		/* Command, dummy byte and 32 bit data */
+		msgs[2 * i + 1] = (struct no_os_spi_msg) {
+			.tx_buff = &iobuf[i][3],
+			.rx_buff = &iobuf[i][3],
+			.bytes_number = 6,
+			.cs_change = 1,
+		};
+	}
+
+	ret = no_os_spi_transfer(spi, msgs, 2 * uiReadCount);
+	if (ret)
+		return ret;
+
+	for (i = 0; i < uiReadCount; i++)
+		pBuffer[i] = (uint32_t)iobuf[i][5] << 24 |
+			     (uint32_t)iobuf[i][6] << 16 |
+			     (uint32_t)iobuf[i][7] << 8 |
+			     iobuf[i][8];
+
+	return 0;
+}
+
+static int AD5940_FIFORd_Fast(struct ad5940_dev *dev, uint32_t *pBuffer,
 			      uint32_t uiReadCount)
 {
 	int ret;
-	static uint32_t iobuf_alloc_sz = 0;
 	uint32_t iobuf_sz = 7 + uiReadCount * sizeof(uiReadCount);
-	static uint8_t *iobuf;
-	uint8_t *buf;
+	struct no_os_spi_msg msg;
+	uint8_t *iobuf;
+	uint8_t *rxbuf;
 	uint32_t i = 0;
 	uint32_t s = 0;
 
-	if (!iobuf_alloc_sz) {
-		iobuf = no_os_malloc(iobuf_sz);
+	/* Separate TX and RX halves, for DMA */
+	if (dev->FifoBuffSize < 2 * iobuf_sz) {
+		iobuf = no_os_calloc(2 * iobuf_sz, 1);
 		if (!iobuf)
 			return -ENOMEM;
-	}
-
-	if (iobuf_alloc_sz < iobuf_sz) {
-		buf = realloc(iobuf, iobuf_sz);
-		if (!buf)
-			return -ENOMEM;
 
-		iobuf = buf;
+		no_os_free(dev->pFifoBuff);
+		dev->pFifoBuff = iobuf;
+		dev->FifoBuffSize = 2 * iobuf_sz;
 	}
+	iobuf = dev->pFifoBuff;
+	rxbuf = iobuf;
 
 	// zero-out everything, needed for bytes 1 through 6 (dummy bytes).
 	memset(iobuf, 0, iobuf_sz);
@@ -677,20 +755,37 @@ static int AD5940_FIFORd_Fast(struct no_os_spi_desc *spi, uint32_t *pBuffer,
 	// set the MOSI output during last two samples to 0x44444444 for each.
 	memset(&iobuf[iobuf_sz - 8], 0x44, 8);
 
-	ret = no_os_spi_write_and_read(spi, iobuf, iobuf_sz);
+	ret = -ENOSYS;
+	if (!dev->FifoNoDma) {
+		msg = (struct no_os_spi_msg) {
+			.tx_buff = iobuf,
+			.rx_buff = iobuf + iobuf_sz,
+			.bytes_number = iobuf_sz,
+			.cs_change = 1,
+		};
+		ret = no_os_spi_transfer_dma(dev->spi, &msg, 1);
+		if (ret == -ENOSYS)
+			dev->FifoNoDma = true;
+		else
+			rxbuf = iobuf + iobuf_sz;
+	}
+	if (dev->FifoNoDma)
+		ret = no_os_spi_write_and_read(dev->spi, iobuf, iobuf_sz);
 	if (ret)
 		return ret;
 
 	for (i = 7; i < iobuf_sz; i += sizeof(uiReadCount))
-		pBuffer[s++] = iobuf[i] << 24 |
-			       iobuf[i + 1] << 16 |
-			       iobuf[i + 2] << 8 |
-			       iobuf[i + 3];
+		pBuffer[s++] = (uint32_t)rxbuf[i] << 24 |
+			       (uint32_t)rxbuf[i + 1] << 16 |
+			       (uint32_t)rxbuf[i + 2] << 8 |
+			       rxbuf[i + 3];
 	return 0;
 }
 
 /**
   @brief Read specific number of data from FIFO with optimized SPI access.
+         Bursts use DMA when the SPI platform supports it. The burst buffer
+         is kept in the device handler and only grows.
   @param pBuffer: Pointer to a buffer that used to store data read back.
   @param uiReadCount: Hou much data to be read.
   @return 0 in case of success, negative error code otherwise.
@@ -702,20 +797,18 @@ int ad5940_FIFORd(struct ad5940_dev *dev, uint32_t *pBuffer,
 	if (!dev)
 		return -EINVAL;
 
+	if (!uiReadCount)
+		return 0;
+
 	if (uiReadCount < 4) {
-		uint8_t i;
-		for (i = 0; i < uiReadCount; i++) {
-			ret = AD5940_SPIReadReg(dev->spi, REG_AFE_DATAFIFORD, &pBuffer[i]);
-			if (ret)
-				break;
-		}
+		ret = AD5940_FIFORd_Reg(dev->spi, pBuffer, uiReadCount);
 	} else {
 		uint8_t iobuf[] = {SPICMD_SETADDR, 0, 0, 0, 0, (uint16_t)REG_AFE_DATAFIFORD >> 8, (uint8_t)REG_AFE_DATAFIFORD};
 		ret = no_os_spi_write_and_read(dev->spi, iobuf, sizeof(iobuf));
 		if (ret)
 			return ret;
 
-		ret = AD5940_FIFORd_Fast(dev->spi, pBuffer, uiReadCount);
+		ret = AD5940_FIFORd_Fast(dev, pBuffer, uiReadCount);
 	}
 
 	return ret;
@@ -2053,19 +2146,49 @@ int ad5940_SEQMmrTrig(struct ad5940_dev *dev, uint32_t SeqId)
 	return ad5940_WriteReg(dev, REG_AFECON_TRIGSEQ, 1 << SeqId);
 }
 
-/* Write sequencer commands to AD5940 SRAM */
+/* Write sequencer commands to AD5940 SRAM. Each command needs a write
+ * address and a data register write, which are sent in bursts of
+ * AD5940_SEQ_WR_BURST commands per SPI transfer. */
 int ad5940_SEQCmdWrite(struct ad5940_dev *dev, uint32_t StartAddr,
 		       const uint32_t *pCommand, uint32_t CmdCnt)
 {
 	int ret;
+	uint8_t iobuf[AD5940_SEQ_WR_BURST][16];
+	struct no_os_spi_msg msgs[AD5940_SEQ_WR_BURST * 4];
+	uint32_t i, n, nmsg;
 
-	while (CmdCnt--) {
-		ret = ad5940_WriteReg(dev, REG_AFE_CMDFIFOWADDR, StartAddr++);
-		if (ret < 0)
-			return ret;
-		ret = ad5940_WriteReg(dev, REG_AFE_CMDFIFOWRITE, *pCommand++);
+	if (!dev)
+		return -EINVAL;
+
+	/* Writes are recorded by the sequence generator */
+	if (dev->SeqGenDB.EngineStart == true) {
+		while (CmdCnt--) {
+			ret = ad5940_WriteReg(dev, REG_AFE_CMDFIFOWADDR, StartAddr++);
+			if (ret < 0)
+				return ret;
+			ret = ad5940_WriteReg(dev, REG_AFE_CMDFIFOWRITE, *pCommand++);
+			if (ret < 0)
+				return ret;
+		}
+
+		return 0;
+	}
+
+	while (CmdCnt) {
+		n = CmdCnt < AD5940_SEQ_WR_BURST ? CmdCnt : AD5940_SEQ_WR_BURST;
+		nmsg = 0;
+		for (i = 0; i < n; i++) {
+			nmsg += AD5940_SPIWriteRegMsg(iobuf[i], &msgs[nmsg],
+						      REG_AFE_CMDFIFOWADDR, StartAddr++);
+			nmsg += AD5940_SPIWriteRegMsg(iobuf[i] + 8, &msgs[nmsg],
+						      REG_AFE_CMDFIFOWRITE, *pCommand++);
+		}
+
+		ret = no_os_spi_transfer(dev->spi, msgs, nmsg);
 		if (ret < 0)
 			return ret;
+
+		CmdCnt -= n;
 	}
 
 	return 0;
@@ -3972,6 +3972,9 @@ struct ad5940_dev {
 	struct no_os_gpio_desc *reset_gpio;
 	struct no_os_gpio_desc *gp0_gpio;
 	struct SeqGen SeqGenDB;
+	uint8_t *pFifoBuff;      /* SPI buffer of FIFO bursts, grown as needed */
+	uint32_t FifoBuffSize;
+	bool FifoNoDma;          /* Set once the SPI reported no DMA support */
 };
 
 /**
@@ -32,8 +32,13 @@
  * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 *******************************************************************************/
 #include <errno.h>
+#include "no_os_delay.h"
+#include "no_os_gpio.h"
 #include "bia_measurement.h"
 
+/* SRAM reserved for the sequencer by SEQMEMSIZE_2KB, in words */
+#define BIA_SEQ_SRAM_SIZE	512
+
 /* External function provided by platform/project */
 extern uint32_t ClrMCUIntFlag(void);
 
@@ -181,8 +186,22 @@ int AppBiaCtrl(struct ad5940_dev *dev, int32_t BcmCtrl, void *pPara)
 	return ret;
 }
 
+/* Frequency of the first measurement after initialization */
+static float AppBiaInitFreq(struct ad5940_dev *dev)
+{
+	if (AppBiaCfg.SweepCfg.SweepEn == true) {
+		AppBiaCfg.FreqofData = AppBiaCfg.SweepCfg.SweepStart;
+		AppBiaCfg.SweepCurrFreq = AppBiaCfg.SweepCfg.SweepStart;
+		ad5940_SweepNext(dev, &AppBiaCfg.SweepCfg, &AppBiaCfg.SweepNextFreq);
+		return AppBiaCfg.SweepCurrFreq;
+	}
+
+	AppBiaCfg.FreqofData = AppBiaCfg.SinFreq;
+	return AppBiaCfg.SinFreq;
+}
+
 /* Generate init sequence */
-static int AppBiaSeqCfgGen(struct ad5940_dev *dev)
+static int AppBiaSeqCfgGen(struct ad5940_dev *dev, uint32_t SeqRamAddr)
 {
 	int ret = 0;
 	uint32_t const *pSeqCmd;
@@ -237,15 +256,7 @@ static int AppBiaSeqCfgGen(struct ad5940_dev *dev)
 	hs_loop.WgCfg.WgType = WGTYPE_SIN;
 	hs_loop.WgCfg.GainCalEn = false;
 	hs_loop.WgCfg.OffsetCalEn = false;
-	if (AppBiaCfg.SweepCfg.SweepEn == true) {
-		AppBiaCfg.FreqofData = AppBiaCfg.SweepCfg.SweepStart;
-		AppBiaCfg.SweepCurrFreq = AppBiaCfg.SweepCfg.SweepStart;
-		ad5940_SweepNext(dev, &AppBiaCfg.SweepCfg, &AppBiaCfg.SweepNextFreq);
-		sin_freq = AppBiaCfg.SweepCurrFreq;
-	} else {
-		sin_freq = AppBiaCfg.SinFreq;
-		AppBiaCfg.FreqofData = sin_freq;
-	}
+	sin_freq = AppBiaInitFreq(dev);
 	hs_loop.WgCfg.SinCfg.SinFreqWord = ad5940_WGFreqWordCal(sin_freq,
 					   AppBiaCfg.SysClkFreq);
 	hs_loop.WgCfg.SinCfg.SinAmplitudeWord = (uint32_t)(AppBiaCfg.DacVoltPP / 800.0f
@@ -339,9 +350,11 @@ static int AppBiaSeqCfgGen(struct ad5940_dev *dev)
 		return ret;
 
 	AppBiaCfg.InitSeqInfo.SeqId = SEQID_1;
-	AppBiaCfg.InitSeqInfo.SeqRamAddr = AppBiaCfg.SeqStartAddr;
+	AppBiaCfg.InitSeqInfo.SeqRamAddr = SeqRamAddr;
 	AppBiaCfg.InitSeqInfo.pSeqCmd = pSeqCmd;
 	AppBiaCfg.InitSeqInfo.SeqLen = SeqLen;
+	if (SeqRamAddr + SeqLen > BIA_SEQ_SRAM_SIZE)
+		return -ENOSPC;
 	/* Write command to SRAM */
 	return ad5940_SEQCmdWrite(dev, AppBiaCfg.InitSeqInfo.SeqRamAddr, pSeqCmd,
 				  SeqLen);
@@ -479,11 +492,173 @@ static int AppBiaSeqMeasureGen(struct ad5940_dev *dev, bool bImpedanceMode)
 					      AppBiaCfg.InitSeqInfo.SeqLen;
 	AppBiaCfg.MeasureSeqInfo.pSeqCmd = pSeqCmd;
 	AppBiaCfg.MeasureSeqInfo.SeqLen = SeqLen;
+	if (AppBiaCfg.MeasureSeqInfo.SeqRamAddr + SeqLen > BIA_SEQ_SRAM_SIZE)
+		return -ENOSPC;
 	/* Write command to SRAM */
 	return ad5940_SEQCmdWrite(dev, AppBiaCfg.MeasureSeqInfo.SeqRamAddr, pSeqCmd,
 				  SeqLen);
 }
 
+/* Parameters the sequences are generated from */
+static void AppBiaSeqKeyGet(AppBiaSeqKey_Type *pKey)
+{
+	memset(pKey, 0, sizeof(*pKey));
+	pKey->bImpedanceReadMode = AppBiaCfg.bImpedanceReadMode;
+	pKey->SysClkFreq = AppBiaCfg.SysClkFreq;
+	pKey->AdcClkFreq = AppBiaCfg.AdcClkFreq;
+	pKey->DacVoltPP = AppBiaCfg.DacVoltPP;
+	pKey->ExcitBufGain = AppBiaCfg.ExcitBufGain;
+	pKey->HsDacGain = AppBiaCfg.HsDacGain;
+	pKey->HsDacUpdateRate = AppBiaCfg.HsDacUpdateRate;
+	pKey->ADCPgaGain = AppBiaCfg.ADCPgaGain;
+	pKey->ADCSinc3Osr = AppBiaCfg.ADCSinc3Osr;
+	pKey->ADCSinc2Osr = AppBiaCfg.ADCSinc2Osr;
+	pKey->HstiaRtiaSel = AppBiaCfg.HstiaRtiaSel;
+	pKey->CtiaSel = AppBiaCfg.CtiaSel;
+	pKey->DftNum = AppBiaCfg.DftNum;
+	pKey->DftSrc = AppBiaCfg.DftSrc;
+	pKey->HanWinEn = AppBiaCfg.HanWinEn;
+}
+
+/* Parameters the RTIA calibration depends on, besides the frequency */
+static void AppBiaRtiaKeyGet(AppBiaSeqKey_Type *pKey)
+{
+	memset(pKey, 0, sizeof(*pKey));
+	pKey->SysClkFreq = AppBiaCfg.SysClkFreq;
+	pKey->AdcClkFreq = AppBiaCfg.AdcClkFreq;
+	pKey->ADCSinc3Osr = AppBiaCfg.ADCSinc3Osr;
+	pKey->ADCSinc2Osr = AppBiaCfg.ADCSinc2Osr;
+	pKey->CtiaSel = AppBiaCfg.CtiaSel;
+	pKey->DftNum = AppBiaCfg.DftNum;
+	pKey->DftSrc = AppBiaCfg.DftSrc;
+	pKey->HanWinEn = AppBiaCfg.HanWinEn;
+}
+
+/**
+   Drop the cached sequences and RTIA calibration results. Must be called
+   when the AFE was reset, since the sequencer SRAM content is lost.
+ */
+int AppBiaCacheFlush(void)
+{
+	memset(AppBiaCfg.SeqCache, 0, sizeof(AppBiaCfg.SeqCache));
+	AppBiaCfg.SeqCacheNext = AppBiaCfg.SeqStartAddr;
+	AppBiaCfg.RtiaCacheCnt = 0;
+
+	return 0;
+}
+
+/* Look for sequences generated from the current parameters. */
+static AppBiaSeqCache_Type *AppBiaSeqCacheFind(const AppBiaSeqKey_Type *pKey)
+{
+	uint32_t i;
+
+	for (i = 0; i < BIA_SEQ_CACHE_SLOTS; i++)
+		if (AppBiaCfg.SeqCache[i].bValid &&
+		    !memcmp(&AppBiaCfg.SeqCache[i].Key, pKey, sizeof(*pKey)))
+			return &AppBiaCfg.SeqCache[i];
+
+	return NULL;
+}
+
+/* Generate both sequences and write them to free SRAM. The cache is flushed
+   when it has no free slot or not enough SRAM left. */
+static int AppBiaSeqCacheLoad(struct ad5940_dev *dev, uint32_t *pBuffer,
+			      uint32_t BufferSize, const AppBiaSeqKey_Type *pKey)
+{
+	AppBiaSeqCache_Type *pSlot = NULL;
+	uint32_t i;
+	int ret;
+
+	for (i = 0; i < BIA_SEQ_CACHE_SLOTS; i++) {
+		if (!AppBiaCfg.SeqCache[i].bValid) {
+			pSlot = &AppBiaCfg.SeqCache[i];
+			break;
+		}
+	}
+	if (!pSlot) {
+		AppBiaCacheFlush();
+		pSlot = &AppBiaCfg.SeqCache[0];
+	}
+
+	while (1) {
+		ret = ad5940_SEQGenInit(dev, pBuffer, BufferSize);
+		if (ret < 0)
+			return ret;
+
+		/* Generate initialize sequence */
+		ret = AppBiaSeqCfgGen(dev, AppBiaCfg.SeqCacheNext);
+		if (ret == 0)
+			/* Generate measurement sequence */
+			ret = AppBiaSeqMeasureGen(dev, AppBiaCfg.bImpedanceReadMode);
+		if (ret != -ENOSPC ||
+		    AppBiaCfg.SeqCacheNext == AppBiaCfg.SeqStartAddr)
+			break;
+
+		/* Out of SRAM, start over from an empty cache */
+		AppBiaCacheFlush();
+		pSlot = &AppBiaCfg.SeqCache[0];
+	}
+	if (ret < 0)
+		return ret;
+
+	pSlot->bValid = true;
+	pSlot->Key = *pKey;
+	pSlot->InitSeqInfo = AppBiaCfg.InitSeqInfo;
+	pSlot->MeasureSeqInfo = AppBiaCfg.MeasureSeqInfo;
+	/* Command buffer is reused, only the SRAM copy is kept */
+	pSlot->InitSeqInfo.pSeqCmd = NULL;
+	pSlot->MeasureSeqInfo.pSeqCmd = NULL;
+	AppBiaCfg.SeqCacheNext = AppBiaCfg.MeasureSeqInfo.SeqRamAddr +
+				 AppBiaCfg.MeasureSeqInfo.SeqLen;
+	AppBiaCfg.SeqUploads++;
+
+	return 0;
+}
+
+/* Calibrated RTIA value at the excitation frequency, if it was measured
+   before with the same parameters. */
+static bool AppBiaRtiaCacheGet(float Freq)
+{
+	AppBiaSeqKey_Type key;
+	uint32_t i;
+
+	AppBiaRtiaKeyGet(&key);
+	if (memcmp(&key, &AppBiaCfg.RtiaCacheKey, sizeof(key)) ||
+	    AppBiaCfg.RtiaCacheRcal != AppBiaCfg.RcalVal) {
+		AppBiaCfg.RtiaCacheKey = key;
+		AppBiaCfg.RtiaCacheRcal = AppBiaCfg.RcalVal;
+		AppBiaCfg.RtiaCacheCnt = 0;
+		return false;
+	}
+
+	for (i = 0; i < AppBiaCfg.RtiaCacheCnt; i++) {
+		if (AppBiaCfg.RtiaCache[i].Freq == Freq) {
+			AppBiaCfg.RtiaCurrValue[0] = AppBiaCfg.RtiaCache[i].Rtia[0];
+			AppBiaCfg.RtiaCurrValue[1] = AppBiaCfg.RtiaCache[i].Rtia[1];
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void AppBiaRtiaCachePut(float Freq)
+{
+	uint32_t i;
+
+	for (i = 0; i < AppBiaCfg.RtiaCacheCnt; i++)
+		if (AppBiaCfg.RtiaCache[i].Freq == Freq)
+			break;
+	if (i == MAXSWEEP_POINTS)
+		return;
+	if (i == AppBiaCfg.RtiaCacheCnt)
+		AppBiaCfg.RtiaCacheCnt++;
+
+	AppBiaCfg.RtiaCache[i].Freq = Freq;
+	AppBiaCfg.RtiaCache[i].Rtia[0] = AppBiaCfg.RtiaCurrValue[0];
+	AppBiaCfg.RtiaCache[i].Rtia[1] = AppBiaCfg.RtiaCurrValue[1];
+}
+
 static int AppBiaRtiaCal(struct ad5940_dev *dev)
 {
 	int ret;
@@ -522,13 +697,19 @@ static int AppBiaRtiaCal(struct ad5940_dev *dev)
 			AppBiaCfg.RtiaCalTable[i][0];
 		AppBiaCfg.SweepCfg.SweepIndex = 0; /* Reset index */
 	} else {
+		if (!AppBiaCfg.ReDoRtiaCal && AppBiaRtiaCacheGet(AppBiaCfg.SinFreq)) {
+			AppBiaCfg.RtiaCacheHits++;
+			return 0;
+		}
 		hsrtia_cal.fFreq = AppBiaCfg.SinFreq;
 		ret = ad5940_HSRtiaCal(dev, &hsrtia_cal, AppBiaCfg.RtiaCurrValue);
 		if (ret < 0)
 			return ret;
 		printf("RtiaReal:%.2f,Imag:%f\n", AppBiaCfg.RtiaCurrValue[0],
 		       AppBiaCfg.RtiaCurrValue[1]);
+		AppBiaRtiaCachePut(AppBiaCfg.SinFreq);
 	}
+	AppBiaCfg.RtiaCalCount++;
 	return 0;
 }
 
@@ -538,6 +719,9 @@ int AppBiaInit(struct ad5940_dev *dev, uint32_t *pBuffer, uint32_t BufferSize)
 	int ret;
 	SEQCfg_Type seq_cfg;
 	FIFOCfg_Type fifo_cfg;
+	AppBiaSeqKey_Type seq_key;
+	AppBiaSeqCache_Type *pSeqCache = NULL;
+	float sin_freq;
 
 	ret = ad5940_WakeUp(dev, 10);
 	if (ret < 0)
@@ -557,6 +741,10 @@ int AppBiaInit(struct ad5940_dev *dev, uint32_t *pBuffer, uint32_t BufferSize)
 	if (ret < 0)
 		return ret;
 
+	/* Sequencer SRAM content is unknown on the first initialization */
+	if (AppBiaCfg.BiaInited == false)
+		AppBiaCacheFlush();
+
 	/* Do RTIA calibration */
 
 	if ((AppBiaCfg.bParamsChanged == true) || (AppBiaCfg.ReDoRtiaCal == true) ||
@@ -588,28 +776,25 @@ int AppBiaInit(struct ad5940_dev *dev, uint32_t *pBuffer, uint32_t BufferSize)
 	if (ret < 0)
 		return ret;
 
-	/* Start sequence generator */
-	/* Initialize sequencer generator */
+	/* Switch to the sequences of the current parameters, if they are
+	   already in SRAM, otherwise generate and write them. */
 	if ((AppBiaCfg.BiaInited == false) ||
 	    (AppBiaCfg.bParamsChanged == true)) {
-		if (pBuffer == 0)
-			return -EINVAL;
-		if (BufferSize == 0)
-			return -EINVAL;
-		ret = ad5940_SEQGenInit(dev, pBuffer, BufferSize);
-		if (ret < 0)
-			return ret;
-
-		/* Generate initialize sequence */
-		ret = AppBiaSeqCfgGen(
-			      dev); /* Application initialization sequence using either MCU or sequencer */
-		if (ret < 0)
-			return ret;
-
-		/* Generate measurement sequence */
-		ret = AppBiaSeqMeasureGen(dev, AppBiaCfg.bImpedanceReadMode);
-		if (ret < 0)
-			return ret;
+		AppBiaSeqKeyGet(&seq_key);
+		pSeqCache = AppBiaSeqCacheFind(&seq_key);
+		if (pSeqCache) {
+			AppBiaCfg.InitSeqInfo = pSeqCache->InitSeqInfo;
+			AppBiaCfg.MeasureSeqInfo = pSeqCache->MeasureSeqInfo;
+			AppBiaCfg.SeqCacheHits++;
+		} else {
+			if (pBuffer == 0)
+				return -EINVAL;
+			if (BufferSize == 0)
+				return -EINVAL;
+			ret = AppBiaSeqCacheLoad(dev, pBuffer, BufferSize, &seq_key);
+			if (ret < 0)
+				return ret;
+		}
 	}
 
 	/* Initialization sequencer  */
@@ -627,6 +812,14 @@ int AppBiaInit(struct ad5940_dev *dev, uint32_t *pBuffer, uint32_t BufferSize)
 	while (ad5940_INTCTestFlag(dev, AFEINTC_1, AFEINTSRC_ENDSEQ) == false)
 		;
 
+	/* A cached init sequence sets the frequency it was generated with */
+	if (pSeqCache) {
+		sin_freq = AppBiaInitFreq(dev);
+		ret = ad5940_WGFreqCtrlS(dev, sin_freq, AppBiaCfg.SysClkFreq);
+		if (ret < 0)
+			return ret;
+	}
+
 	/* Measurment sequence  */
 	AppBiaCfg.MeasureSeqInfo.WriteSRAM = false;
 	ad5940_SEQInfoCfg(dev, &AppBiaCfg.MeasureSeqInfo);
@@ -774,6 +967,92 @@ int AppBiaISR(struct ad5940_dev *dev, void *pBuff, uint32_t *pCount)
 	return 0;
 }
 
+/**
+   Measure one impedance per frequency of a logarithmic sweep between
+   SweepCfg.SweepStart and SweepCfg.SweepStop, the same way single reads
+   are done: set the frequency, reinitialize, start the wakeup timer, wait
+   for the end of sequence on GP0 and drain the FIFO. Reports the number of
+   points measured per second. The sweep configuration of AppBiaCfg is left
+   unchanged. GetTime is supplied by the caller since not every platform
+   implements no_os_get_time().
+ */
+int AppBiaSweepBench(struct ad5940_dev *dev, uint32_t *pBuffer,
+		     uint32_t BufferSize, uint32_t Points,
+		     struct no_os_time (*GetTime)(void), uint32_t *pPointsPerSec)
+{
+	SoftSweepCfg_Type sweep = AppBiaCfg.SweepCfg;
+	float SinFreq = AppBiaCfg.SinFreq;
+	struct no_os_time start, end;
+	uint64_t elapsed_us;
+	uint32_t timeout, count, i;
+	uint8_t gpio;
+	float freq;
+	int ret;
+
+	if (!dev || !pBuffer || !Points || Points > MAXSWEEP_POINTS ||
+	    !GetTime || !pPointsPerSec)
+		return -EINVAL;
+
+	sweep.SweepEn = true;
+	sweep.SweepLog = true;
+	sweep.SweepPoints = Points;
+	sweep.SweepIndex = Points - 1;
+
+	start = GetTime();
+	for (i = 0; i < Points; i++) {
+		/* The index wraps to 0 first, the sweep starts at SweepStart */
+		ad5940_SweepNext(dev, &sweep, &freq);
+		if (AppBiaCfg.SinFreq != freq) {
+			AppBiaCfg.SinFreq = freq;
+			AppBiaCfg.bParamsChanged = true;
+		}
+		ret = AppBiaInit(dev, pBuffer, BufferSize);
+		if (ret < 0)
+			goto out;
+
+		ret = AppBiaCtrl(dev, BIACTRL_START, 0);
+		if (ret < 0)
+			goto out;
+
+		timeout = 1000;
+		do {
+			ret = no_os_gpio_get_value(dev->gp0_gpio, &gpio);
+			if (ret < 0 || !gpio)
+				break;
+			no_os_mdelay(1);
+		} while (--timeout);
+		if (!ret && gpio)
+			ret = -ETIMEDOUT;
+		if (ret < 0) {
+			AppBiaCtrl(dev, BIACTRL_STOPNOW, 0);
+			goto out;
+		}
+
+		count = BufferSize;
+		ret = AppBiaISR(dev, pBuffer, &count);
+		if (ret < 0)
+			goto out;
+
+		ret = AppBiaCtrl(dev, BIACTRL_STOPNOW, 0);
+		if (ret < 0)
+			goto out;
+	}
+	end = GetTime();
+
+	elapsed_us = (uint64_t)(end.s - start.s) * 1000000 + end.us - start.us;
+	if (!elapsed_us)
+		elapsed_us = 1;
+	*pPointsPerSec = (uint64_t)Points * 1000000 / elapsed_us;
+	ret = 0;
+out:
+	if (AppBiaCfg.SinFreq != SinFreq) {
+		AppBiaCfg.SinFreq = SinFreq;
+		AppBiaCfg.bParamsChanged = true;
+	}
+
+	return ret;
+}
+
 /**
  * @}
  */
@@ -38,9 +38,46 @@
 #include <stdio.h>
 #include <string.h>
 #include <math.h>
+#include "no_os_delay.h"
 #include "ad5940.h"
 
 #define MAXSWEEP_POINTS 100 /* Need to know how much buffer is needed to save RTIA calibration result */
+#define BIA_SEQ_CACHE_SLOTS 4 /* Sequence pairs kept in SRAM, one per set of measurement parameters */
+
+/* Parameters the init and measurement sequences are generated from.
+   The excitation frequency is not part of it, it is written to the waveform
+   generator once the init sequence has run. */
+typedef struct {
+	bool bImpedanceReadMode;
+	float SysClkFreq;
+	float AdcClkFreq;
+	float DacVoltPP;
+	uint32_t ExcitBufGain;
+	uint32_t HsDacGain;
+	uint32_t HsDacUpdateRate;
+	uint32_t ADCPgaGain;
+	uint8_t ADCSinc3Osr;
+	uint8_t ADCSinc2Osr;
+	uint32_t HstiaRtiaSel;
+	uint32_t CtiaSel;
+	uint32_t DftNum;
+	uint32_t DftSrc;
+	bool HanWinEn;
+} AppBiaSeqKey_Type;
+
+/* Init and measurement sequences of one set of parameters, loaded in SRAM */
+typedef struct {
+	bool bValid;
+	AppBiaSeqKey_Type Key;
+	SEQInfo_Type InitSeqInfo;
+	SEQInfo_Type MeasureSeqInfo;
+} AppBiaSeqCache_Type;
+
+/* RTIA calibration result of one frequency */
+typedef struct {
+	float Freq;
+	float Rtia[2];
+} AppBiaRtiaCache_Type;
 
 /*
   Note: this example will use SEQID_0 as measurment sequence, and use SEQID_1 as init sequence.
@@ -94,6 +131,17 @@ typedef struct {
 	SEQInfo_Type MeasureSeqInfo;
 	bool StopRequired;  /* After FIFO is ready, stop the measurment sequence */
 	uint32_t FifoDataCount; /* Count how many times impedance have been measured */
+	AppBiaSeqCache_Type SeqCache[BIA_SEQ_CACHE_SLOTS]; /* Sequences loaded in SRAM */
+	uint32_t SeqCacheNext;   /* First free SRAM address after the cached sequences */
+	AppBiaSeqKey_Type RtiaCacheKey;   /* Calibration parameters of the RTIA cache, others are 0 */
+	float RtiaCacheRcal;
+	AppBiaRtiaCache_Type RtiaCache[MAXSWEEP_POINTS];
+	uint32_t RtiaCacheCnt;
+	/* Statistics */
+	uint32_t SeqUploads;     /* Sequence pairs generated and written to SRAM */
+	uint32_t SeqCacheHits;   /* Sequence pairs switched to without upload */
+	uint32_t RtiaCalCount;   /* RTIA calibrations done */
+	uint32_t RtiaCacheHits;  /* RTIA calibrations skipped */
 	/* End */
 } AppBiaCfg_Type;
 
@@ -107,6 +155,10 @@ int AppBiaGetCfg(void *pCfg);
 int AppBiaInit(struct ad5940_dev *dev, uint32_t *pBuffer, uint32_t nBufferSize);
 int AppBiaISR(struct ad5940_dev *dev, void *pBuff, uint32_t *pCountd);
 int AppBiaCtrl(struct ad5940_dev *dev, int32_t BcmCtrl, void *pPara);
+int AppBiaCacheFlush(void);
+int AppBiaSweepBench(struct ad5940_dev *dev, uint32_t *pBuffer,
+		     uint32_t BufferSize, uint32_t Points,
+		     struct no_os_time (*GetTime)(void), uint32_t *pPointsPerSec);
 void signExtend18To32(uint32_t *const pData, uint16_t nLen);
 fImpCar_Type computeImpedance(uint32_t *const pData);
 
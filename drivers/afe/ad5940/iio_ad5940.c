@@ -231,6 +231,80 @@ int ad5940_iio_set_attr(void *device, char *buf, uint32_t len,
 	return 0;
 }
 
+/* Number of frequencies of the sweep_points_per_sec benchmark */
+#define AD5940_IIO_SWEEP_BENCH_POINTS	100
+
+static int ad5940_iio_get_debug_attr(void *device, char *buf, uint32_t len,
+				     const struct iio_ch_info *channel,
+				     intptr_t priv)
+{
+	struct ad5940_iio_dev *iiodev = (struct ad5940_iio_dev *)device;
+	AppBiaCfg_Type *pBiaCfg;
+	uint32_t val;
+	int ret;
+
+	AppBiaGetCfg(&pBiaCfg);
+
+	switch (priv) {
+	case AD5940_IIO_SEQ_UPLOADS:
+		val = pBiaCfg->SeqUploads;
+		break;
+	case AD5940_IIO_SEQ_CACHE_HITS:
+		val = pBiaCfg->SeqCacheHits;
+		break;
+	case AD5940_IIO_RTIA_CAL_COUNT:
+		val = pBiaCfg->RtiaCalCount;
+		break;
+	case AD5940_IIO_RTIA_CACHE_HITS:
+		val = pBiaCfg->RtiaCacheHits;
+		break;
+	case AD5940_IIO_SWEEP_BENCH:
+		if (!iiodev->get_time)
+			return -ENOSYS;
+
+		ret = AppBiaSweepBench(iiodev->ad5940, iiodev->AppBuff,
+				       NO_OS_ARRAY_SIZE(iiodev->AppBuff),
+				       AD5940_IIO_SWEEP_BENCH_POINTS,
+				       iiodev->get_time, &val);
+		if (ret)
+			return ret;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	return snprintf(buf, len, "%"PRIu32, val);
+}
+
+static struct iio_attribute ad5940_iio_debug_attr[] = {
+	{
+		.name = "seq_uploads",
+		.priv = AD5940_IIO_SEQ_UPLOADS,
+		.show = ad5940_iio_get_debug_attr,
+	},
+	{
+		.name = "seq_cache_hits",
+		.priv = AD5940_IIO_SEQ_CACHE_HITS,
+		.show = ad5940_iio_get_debug_attr,
+	},
+	{
+		.name = "rtia_cal_count",
+		.priv = AD5940_IIO_RTIA_CAL_COUNT,
+		.show = ad5940_iio_get_debug_attr,
+	},
+	{
+		.name = "rtia_cache_hits",
+		.priv = AD5940_IIO_RTIA_CACHE_HITS,
+		.show = ad5940_iio_get_debug_attr,
+	},
+	{
+		.name = "sweep_points_per_sec",
+		.priv = AD5940_IIO_SWEEP_BENCH,
+		.show = ad5940_iio_get_debug_attr,
+	},
+	END_ATTRIBUTES_ARRAY,
+};
+
 struct iio_attribute ad5940_iio_global_attr[] = {
 	{
 		.name = "impedance_mode",
@@ -267,7 +341,7 @@ struct iio_attribute ad5940_iio_global_attr[] = {
 
 static struct iio_device ad5940_iio_device = {
 	.attributes = ad5940_iio_global_attr,
-	.debug_attributes = NULL,
+	.debug_attributes = ad5940_iio_debug_attr,
 	.buffer_attributes = NULL,
 	.pre_enable = NULL,
 	.post_disable = NULL,
@@ -300,6 +374,7 @@ int32_t ad5940_iio_init(struct ad5940_iio_dev **iio_dev,
 		return -ENOMEM;
 
 	desc->iio = &ad5940_iio_device;
+	desc->get_time = init_param->get_time;
 
 	desc->iio->channels = (struct iio_channel *)no_os_calloc(1,
 			      sizeof(struct iio_channel));
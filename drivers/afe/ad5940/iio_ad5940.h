@@ -34,6 +34,7 @@
 #define IIO_AD5940_H
 
 #include "iio.h"
+#include "no_os_delay.h"
 #include "ad5940.h"
 
 enum ad5940_iio_attr {
@@ -42,6 +43,11 @@ enum ad5940_iio_attr {
 	AD5940_IIO_IMPEDANCE_MODE,
 	AD5940_IIO_MAGNITUDE_MODE,
 	AD5940_IIO_GPIO1_TOGGLE,
+	AD5940_IIO_SEQ_UPLOADS,
+	AD5940_IIO_SEQ_CACHE_HITS,
+	AD5940_IIO_RTIA_CAL_COUNT,
+	AD5940_IIO_RTIA_CACHE_HITS,
+	AD5940_IIO_SWEEP_BENCH,
 };
 
 struct ad5940_iio_dev {
@@ -50,10 +56,13 @@ struct ad5940_iio_dev {
 	bool magnitude_mode;
 	bool gpio1;
 	uint32_t AppBuff[512];
+	struct no_os_time (*get_time)(void);
 };
 
 struct ad5940_iio_init_param {
 	struct ad5940_init_param *ad5940_init;
+	/* Clock of the sweep_points_per_sec benchmark, optional */
+	struct no_os_time (*get_time)(void);
 };
 
 int32_t ad5940_iio_init(struct ad5940_iio_dev **iio_dev,
@@ -38,6 +38,10 @@
 #include "no_os_irq.h"
 #include "no_os_alloc.h"
 #include "no_os_list.h"
+#include "no_os_trace.h"
+
+NO_OS_TRACE_POINT(dma_xfer_start_tp, "dma_xfer_start");
+NO_OS_TRACE_POINT(dma_xfer_tp, "dma_xfer");
 
 /**
  * @brief Default handler for cycling though the channel's list of transfers
@@ -64,6 +68,8 @@ static void default_sg_callback(void *context)
 		return;
 	}
 
+	NO_OS_TRACE_END(dma_xfer_tp, data->channel->xfer_ts);
+
 	no_os_list_read_first(data->channel->sg_list, (void **)&next_xfer);
 	no_os_list_get_size(data->channel->sg_list, &list_size);
 	if (old_xfer->xfer_complete_cb)
@@ -92,7 +98,7 @@ int no_os_dma_init(struct no_os_dma_desc **desc,
 {
 	int ret;
 	uint32_t i, j;
-	void *mutex;
+	void *mutex = NULL;
 
 	if (!param || !param->platform_ops)
 		return -EINVAL;
@@ -121,6 +127,7 @@ int no_os_dma_init(struct no_os_dma_desc **desc,
 
 	(*desc)->ref++;
 	no_os_mutex_unlock(mutex);
+	no_os_mutex_remove(mutex);
 
 	return 0;
 
@@ -131,6 +138,7 @@ list_err:
 	no_os_dma_remove(*desc);
 unlock:
 	no_os_mutex_unlock(mutex);
+	no_os_mutex_remove(mutex);
 
 	return ret;
 }
@@ -368,7 +376,10 @@ int no_os_dma_xfer_start(struct no_os_dma_desc *desc, struct no_os_dma_ch *ch)
 	if (desc->irq_ctrl)
 		no_os_irq_enable(desc->irq_ctrl, ch->irq_num);
 
+	NO_OS_TRACE_BEGIN(ts);
+	NO_OS_TRACE_STAMP(ch->xfer_ts);
 	ret = desc->platform_ops->dma_xfer_start(desc, ch);
+	NO_OS_TRACE_END(dma_xfer_start_tp, ts);
 
 	no_os_mutex_unlock(ch->mutex);
 
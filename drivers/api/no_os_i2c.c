@@ -207,3 +207,47 @@ int32_t no_os_i2c_read(struct no_os_i2c_desc *desc,
 
 	return ret;
 }
+
+/**
+ * @brief Perform a sequence of reads and writes on a slave device. Platforms
+ * implementing i2c_ops_transfer may submit the whole sequence at once,
+ * otherwise the messages are issued one by one.
+ * @param desc - The I2C descriptor.
+ * @param msgs - The I2C messages.
+ * @param len - Number of messages.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_i2c_transfer(struct no_os_i2c_desc *desc,
+			   struct no_os_i2c_msg *msgs,
+			   uint32_t len)
+{
+	const struct no_os_i2c_platform_ops *ops;
+	int32_t ret = 0;
+	uint32_t i;
+
+	if (!desc || !desc->platform_ops || (len && !msgs))
+		return -EINVAL;
+
+	ops = desc->platform_ops;
+	if (!ops->i2c_ops_transfer && (!ops->i2c_ops_read || !ops->i2c_ops_write))
+		return -ENOSYS;
+
+	no_os_mutex_lock(desc->bus->mutex);
+	if (ops->i2c_ops_transfer) {
+		ret = ops->i2c_ops_transfer(desc, msgs, len);
+	} else {
+		for (i = 0; i < len && !ret; i++) {
+			if (msgs[i].read)
+				ret = ops->i2c_ops_read(desc, msgs[i].data,
+							msgs[i].bytes_number,
+							msgs[i].stop_bit);
+			else
+				ret = ops->i2c_ops_write(desc, msgs[i].data,
+							 msgs[i].bytes_number,
+							 msgs[i].stop_bit);
+		}
+	}
+	no_os_mutex_unlock(desc->bus->mutex);
+
+	return ret;
+}
@@ -193,6 +193,7 @@ int no_os_i3c_init_bus(struct no_os_i3c_bus_desc **desc,
 	if (ret)
 		goto error_bus_1;
 
+	no_os_mutex_init(&bus_desc->mutex);
 	i3c_table[param->device_id - 1] = bus_desc;
 
 	no_os_i3c_addr_init(bus_desc);
@@ -249,12 +250,12 @@ int no_os_i3c_init_bus(struct no_os_i3c_bus_desc **desc,
 	if (ret)
 		goto error_bus_2;
 
-	no_os_mutex_init(bus_desc->mutex);
 	*desc = bus_desc;
 
 	return 0;
 
 error_bus_2:
+	no_os_mutex_remove(bus_desc->mutex);
 	ret = param->platform_ops->i3c_ops_remove_bus(bus_desc);
 error_bus_1:
 	no_os_free(bus_desc);
@@ -37,12 +37,17 @@
 #include "no_os_error.h"
 #include "no_os_mutex.h"
 #include "no_os_alloc.h"
+#include "no_os_trace.h"
 
 /**
  * @brief spi_table contains the pointers towards the SPI buses
 */
 static void *spi_table[SPI_MAX_BUS_NUMBER + 1];
 
+NO_OS_TRACE_POINT(spi_write_and_read_tp, "spi_write_and_read");
+NO_OS_TRACE_POINT(spi_transfer_tp, "spi_transfer");
+NO_OS_TRACE_POINT(spi_transfer_dma_tp, "spi_transfer_dma");
+
 /**
  * @brief Initialize the SPI communication peripheral.
  * @param desc - The SPI descriptor.
@@ -169,7 +174,9 @@ int32_t no_os_spi_write_and_read(struct no_os_spi_desc *desc,
 		return -ENOSYS;
 
 	no_os_mutex_lock(desc->bus->mutex);
+	NO_OS_TRACE_BEGIN(ts);
 	ret =  desc->platform_ops->write_and_read(desc, data, bytes_number);
+	NO_OS_TRACE_END(spi_write_and_read_tp, ts);
 	no_os_mutex_unlock(desc->bus->mutex);
 
 	return ret;
@@ -192,24 +199,33 @@ int32_t no_os_spi_transfer(struct no_os_spi_desc *desc,
 	if (!desc || !desc->platform_ops)
 		return -EINVAL;
 
-	if (desc->platform_ops->transfer)
-		return desc->platform_ops->transfer(desc, msgs, len);
-
 	no_os_mutex_lock(desc->bus->mutex);
+	NO_OS_TRACE_BEGIN(ts);
+
+	if (desc->platform_ops->transfer) {
+		ret = desc->platform_ops->transfer(desc, msgs, len);
+		goto out;
+	}
+
+	if (!desc->platform_ops->write_and_read) {
+		ret = -ENOSYS;
+		goto out;
+	}
 
 	for (i = 0; i < len; i++) {
 		if (msgs[i].rx_buff != msgs[i].tx_buff || !msgs[i].tx_buff) {
 			ret = -EINVAL;
 			goto out;
 		}
-		ret = no_os_spi_write_and_read(desc, msgs[i].rx_buff,
-					       msgs[i].bytes_number);
+		ret = desc->platform_ops->write_and_read(desc, msgs[i].rx_buff,
+				msgs[i].bytes_number);
 		if (NO_OS_IS_ERR_VALUE(ret)) {
 			goto out;
 		}
 	}
 
 out:
+	NO_OS_TRACE_END(spi_transfer_tp, ts);
 	no_os_mutex_unlock(desc->bus->mutex);
 	return ret;
 }
@@ -225,13 +241,19 @@ int32_t no_os_spi_transfer_dma(struct no_os_spi_desc *desc,
 			       struct no_os_spi_msg *msgs,
 			       uint32_t len)
 {
+	int32_t ret;
+
 	if (!desc || !desc->platform_ops || !msgs || !len)
 		return -EINVAL;
 
-	if (desc->platform_ops->transfer_dma)
-		return desc->platform_ops->transfer_dma(desc, msgs, len);
+	if (!desc->platform_ops->transfer_dma)
+		return -ENOSYS;
+
+	NO_OS_TRACE_BEGIN(ts);
+	ret = desc->platform_ops->transfer_dma(desc, msgs, len);
+	NO_OS_TRACE_END(spi_transfer_dma_tp, ts);
 
-	return -ENOSYS;
+	return ret;
 }
 
 /**
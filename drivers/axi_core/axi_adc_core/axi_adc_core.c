@@ -32,12 +32,15 @@
 *******************************************************************************/
 
 #include <stdlib.h>
+#include <string.h>
 #include <stdio.h>
 #include <inttypes.h>
 #include "no_os_error.h"
 #include "no_os_delay.h"
 #include "no_os_util.h"
 #include "no_os_alloc.h"
+#include "no_os_print_log.h"
+#include "no_os_crc8.h"
 #include "axi_adc_core.h"
 #include "no_os_axi_io.h"
 
@@ -212,16 +215,15 @@ int32_t axi_adc_delay_set(struct axi_adc *adc,
 	axi_adc_read(adc, 0x0, &pcore_version);
 	pcore_version >>= 16;
 	if (pcore_version < 9) {
-		printf(" pcore_version is : %d\n\r", (int)pcore_version);
-		printf(" DRIVER DOES NOT SUPPORT PCORE VERSIONS OLDER THAN 10 !");
+		pr_err("pcore_version %d not supported\n", (int)pcore_version);
 		return -1;
 	} else {
 		for (i = 0; i < no_of_lanes; i++) {
 			axi_adc_idelay_set(adc, i, delay);
 			axi_adc_read(adc, AXI_ADC_REG_DELAY(i), &rdata);
 			if (rdata != delay) {
-				printf("adc_delay_1: sel(%2d), rcv(%04x), exp(%04x)\n\r",
-				       (int)i, (int)rdata, (int)delay);
+				pr_warning("adc_delay_1: sel(%2d), rcv(%04x), exp(%04x)\n",
+					   (int)i, (int)rdata, (int)delay);
 			}
 		}
 	}
@@ -266,7 +268,7 @@ int32_t axi_adc_delay_calibrate(struct axi_adc *adc,
 		}
 	}
 	if (start_valid_delay > 31) {
-		printf("%s FAILED.\n", __func__);
+		pr_err("FAILED.\n");
 		axi_adc_delay_set(adc, no_of_lanes, 0);
 		return -1;
 	}
@@ -308,12 +310,430 @@ int32_t axi_adc_delay_calibrate(struct axi_adc *adc,
 
 	delay = (valid_range[max_interval] + invalid_range[max_interval] - 1) / 2;
 
-	printf("adc_delay: setting zero error delay (%d)\n\r", delay);
+	pr_info("adc_delay: setting zero error delay (%d)\n", delay);
 	axi_adc_delay_set(adc, no_of_lanes, delay);
 
 	return 0;
 }
 
+#define AXI_ADC_CAL_CRC8_POLY		0x07
+#define AXI_ADC_CAL_COARSE_STEP		4
+#define AXI_ADC_CAL_SETTLE_US		10
+#define AXI_ADC_CAL_SHORT_CHECK_US	20
+#define AXI_ADC_CAL_LONG_CHECK_US	1000
+
+NO_OS_DECLARE_CRC8_TABLE(axi_adc_cal_crc8);
+static bool axi_adc_cal_crc8_ready;
+
+/**
+ * @struct axi_adc_cal_ctx
+ * @brief State of a per-lane delay calibration.
+ */
+struct axi_adc_cal_ctx {
+	struct axi_adc *adc;
+	uint32_t no_of_lanes;
+	uint8_t step;
+	uint32_t settle_us;
+	uint32_t short_us;
+	uint32_t long_us;
+	uint32_t pn_checks;
+	struct no_os_time start;
+};
+
+/**
+ * @brief Initialize the calibration state and select the PN sequence.
+ * @param ctx - Calibration state.
+ * @param adc - The device structure.
+ * @param param - Calibration parameters.
+ * @return Returns 0 in case of success or negative error code otherwise.
+ */
+static int32_t axi_adc_cal_begin(struct axi_adc_cal_ctx *ctx,
+				 struct axi_adc *adc,
+				 const struct axi_adc_delay_cal_param *param)
+{
+	uint32_t pcore_version;
+	uint32_t reg_data;
+	uint8_t ch;
+
+	if (!param->no_of_lanes || param->no_of_lanes > AXI_ADC_MAX_LANES)
+		return -EINVAL;
+
+	axi_adc_read(adc, 0x0, &pcore_version);
+	if ((pcore_version >> 16) < 9)
+		return -ENOTSUP;
+
+	ctx->start = no_os_get_time();
+	ctx->adc = adc;
+	ctx->no_of_lanes = param->no_of_lanes;
+	ctx->step = param->coarse_step ? : AXI_ADC_CAL_COARSE_STEP;
+	ctx->settle_us = param->settle_us ? : AXI_ADC_CAL_SETTLE_US;
+	ctx->short_us = param->short_check_us ? : AXI_ADC_CAL_SHORT_CHECK_US;
+	ctx->long_us = param->long_check_us ? : AXI_ADC_CAL_LONG_CHECK_US;
+	ctx->pn_checks = 0;
+
+	/* The PN monitors are set up once, not for every tap */
+	for (ch = 0; ch < adc->num_channels; ch++) {
+		axi_adc_read(adc, AXI_ADC_REG_CHAN_CNTRL(ch), &reg_data);
+		reg_data |= AXI_ADC_ENABLE;
+		axi_adc_write(adc, AXI_ADC_REG_CHAN_CNTRL(ch), reg_data);
+		axi_adc_set_pnsel(adc, ch, param->sel);
+	}
+	no_os_mdelay(1);
+
+	return 0;
+}
+
+/**
+ * @brief Fill in the calibration report.
+ * @param ctx - Calibration state.
+ * @param report - Report, may be NULL.
+ * @param cached - Set if a persisted result was reused.
+ */
+static void axi_adc_cal_end(struct axi_adc_cal_ctx *ctx,
+			    struct axi_adc_delay_cal_report *report,
+			    bool cached)
+{
+	struct no_os_time now;
+
+	if (!report)
+		return;
+
+	now = no_os_get_time();
+	report->duration_us = (now.s - ctx->start.s) * 1000000 + now.us -
+			      ctx->start.us;
+	report->pn_checks = ctx->pn_checks;
+	report->cached = cached;
+}
+
+/**
+ * @brief Check that all channels receive the PN sequence without errors.
+ * @param ctx - Calibration state.
+ * @param check_us - Time to monitor the PN sequence for.
+ * @return true if no error was seen.
+ */
+static bool axi_adc_cal_pn_ok(struct axi_adc_cal_ctx *ctx, uint32_t check_us)
+{
+	uint32_t reg_data;
+	uint8_t ch;
+
+	ctx->pn_checks++;
+
+	for (ch = 0; ch < ctx->adc->num_channels; ch++)
+		axi_adc_write(ctx->adc, AXI_ADC_REG_CHAN_STATUS(ch), 0xff);
+
+	no_os_udelay(check_us);
+
+	for (ch = 0; ch < ctx->adc->num_channels; ch++) {
+		axi_adc_read(ctx->adc, AXI_ADC_REG_CHAN_STATUS(ch), &reg_data);
+		if (reg_data)
+			return false;
+	}
+
+	return true;
+}
+
+/**
+ * @brief Set the delay of a lane and wait for the monitors to settle.
+ * @param ctx - Calibration state.
+ * @param lane - Interface lane.
+ * @param tap - Delay value.
+ */
+static void axi_adc_cal_set_lane(struct axi_adc_cal_ctx *ctx, uint32_t lane,
+				 uint32_t tap)
+{
+	axi_adc_idelay_set(ctx->adc, lane, tap);
+	no_os_udelay(ctx->settle_us);
+}
+
+/**
+ * @brief Find a delay which is error free when used by all lanes.
+ *
+ * The taps are sampled every coarse step with short PN checks; every tap is
+ * tried only if the common eye is narrower than a coarse step.
+ * @param ctx - Calibration state.
+ * @param tap - Middle of the widest error free range.
+ * @return Returns 0 in case of success or negative error code otherwise.
+ */
+static int32_t axi_adc_cal_common_tap(struct axi_adc_cal_ctx *ctx,
+				      uint8_t *tap)
+{
+	uint32_t best_len = 0, best_start = 0;
+	uint32_t run_len, run_start = 0;
+	uint32_t lane, t;
+	uint8_t step;
+
+	for (step = ctx->step; step; step = step > 1 ? 1 : 0) {
+		run_len = 0;
+		for (t = 0; t < AXI_ADC_DELAY_TAPS; t += step) {
+			for (lane = 0; lane < ctx->no_of_lanes; lane++)
+				axi_adc_idelay_set(ctx->adc, lane, t);
+			no_os_udelay(ctx->settle_us);
+
+			if (!axi_adc_cal_pn_ok(ctx, ctx->short_us)) {
+				run_len = 0;
+				continue;
+			}
+
+			if (!run_len++)
+				run_start = t;
+			if (run_len > best_len) {
+				best_len = run_len;
+				best_start = run_start;
+			}
+		}
+
+		if (best_len) {
+			*tap = best_start + (best_len - 1) * step / 2;
+			return 0;
+		}
+	}
+
+	return -EIO;
+}
+
+/**
+ * @brief Find the last error free tap of a lane in one direction.
+ *
+ * The lane is moved away from a known good tap in coarse steps, using short
+ * PN checks. The taps between the last good coarse tap and the first failing
+ * one are then tried one by one, and the edge is confirmed with long checks.
+ * @param ctx - Calibration state.
+ * @param lane - Interface lane.
+ * @param start - Known good tap.
+ * @param dir - 1 to search upwards, -1 to search downwards.
+ * @return The last error free tap.
+ */
+static int32_t axi_adc_cal_edge(struct axi_adc_cal_ctx *ctx, uint32_t lane,
+				int32_t start, int32_t dir)
+{
+	int32_t last = start;
+	int32_t coarse;
+	int32_t t;
+
+	for (t = start + dir * ctx->step;
+	     t >= 0 && t < AXI_ADC_DELAY_TAPS; t += dir * ctx->step) {
+		axi_adc_cal_set_lane(ctx, lane, t);
+		if (!axi_adc_cal_pn_ok(ctx, ctx->short_us))
+			break;
+		last = t;
+	}
+
+	coarse = last;
+	for (t = last + dir; t >= 0 && t < AXI_ADC_DELAY_TAPS &&
+	     abs(t - coarse) < ctx->step; t += dir) {
+		axi_adc_cal_set_lane(ctx, lane, t);
+		if (!axi_adc_cal_pn_ok(ctx, ctx->short_us) ||
+		    !axi_adc_cal_pn_ok(ctx, ctx->long_us))
+			break;
+		last = t;
+	}
+
+	/* A coarse tap next to the edge was only checked briefly */
+	if (last == coarse) {
+		while (last != start) {
+			axi_adc_cal_set_lane(ctx, lane, last);
+			if (axi_adc_cal_pn_ok(ctx, ctx->long_us))
+				break;
+			last -= dir;
+		}
+	}
+
+	return last;
+}
+
+/**
+ * @brief Compute the CRC of a calibration result.
+ * @param cal - Calibration result.
+ * @return CRC-8 of the structure, with the crc field set to 0.
+ */
+static uint8_t axi_adc_cal_crc(const struct axi_adc_delay_cal *cal)
+{
+	struct axi_adc_delay_cal tmp = *cal;
+
+	if (!axi_adc_cal_crc8_ready) {
+		no_os_crc8_populate_msb(axi_adc_cal_crc8, AXI_ADC_CAL_CRC8_POLY);
+		axi_adc_cal_crc8_ready = true;
+	}
+
+	tmp.crc = 0;
+
+	return no_os_crc8(axi_adc_cal_crc8, (const uint8_t *)&tmp, sizeof(tmp), 0);
+}
+
+/**
+ * @brief Get the sample rate a calibration result is keyed by.
+ * @param adc - The device structure.
+ * @param param - Calibration parameters.
+ * @return The sample rate.
+ */
+static uint64_t axi_adc_cal_rate(struct axi_adc *adc,
+				 const struct axi_adc_delay_cal_param *param)
+{
+	uint64_t rate;
+
+	if (param->sample_rate)
+		return param->sample_rate;
+
+	axi_adc_get_sampling_freq(adc, 0, &rate);
+
+	return rate;
+}
+
+/**
+ * @brief Calibrate the delay of each lane using a PN sequence.
+ *
+ * A delay which is error free on all lanes is found first. Then each lane is
+ * swept on its own, from that delay towards both edges of its eye, while the
+ * other lanes stay in a known good position, and is set in the middle of its
+ * eye. The converter must be sending the selected PN sequence.
+ * @param adc - The device structure.
+ * @param param - Calibration parameters.
+ * @param cal - Calibration result, to be persisted by the caller.
+ * @param report - Time spent and number of PN checks. May be NULL.
+ * @return Returns 0 in case of success or negative error code otherwise.
+ */
+int32_t axi_adc_delay_calibrate_lanes(struct axi_adc *adc,
+				      const struct axi_adc_delay_cal_param *param,
+				      struct axi_adc_delay_cal *cal,
+				      struct axi_adc_delay_cal_report *report)
+{
+	struct axi_adc_cal_ctx ctx;
+	int32_t left, right;
+	uint32_t lane;
+	uint8_t common;
+	int32_t ret;
+
+	if (!adc || !param || !cal)
+		return -EINVAL;
+
+	ret = axi_adc_cal_begin(&ctx, adc, param);
+	if (ret)
+		return ret;
+
+	memset(cal, 0, sizeof(*cal));
+
+	ret = axi_adc_cal_common_tap(&ctx, &common);
+	if (ret)
+		goto error;
+
+	for (lane = 0; lane < param->no_of_lanes; lane++)
+		axi_adc_idelay_set(adc, lane, common);
+
+	for (lane = 0; lane < param->no_of_lanes; lane++) {
+		right = axi_adc_cal_edge(&ctx, lane, common, 1);
+		left = axi_adc_cal_edge(&ctx, lane, common, -1);
+
+		cal->delay[lane] = (left + right) / 2;
+		cal->eye_width[lane] = right - left + 1;
+		axi_adc_cal_set_lane(&ctx, lane, cal->delay[lane]);
+	}
+
+	if (!axi_adc_cal_pn_ok(&ctx, ctx.long_us)) {
+		ret = -EIO;
+		goto error;
+	}
+
+	cal->magic = AXI_ADC_DELAY_CAL_MAGIC;
+	cal->num_lanes = param->no_of_lanes;
+	cal->board_id = param->board_id;
+	cal->sample_rate = axi_adc_cal_rate(adc, param);
+	cal->crc = axi_adc_cal_crc(cal);
+
+	axi_adc_cal_end(&ctx, report, false);
+
+	return 0;
+
+error:
+	printf("%s FAILED.\n", __func__);
+	for (lane = 0; lane < param->no_of_lanes; lane++)
+		axi_adc_idelay_set(adc, lane, 0);
+	axi_adc_cal_end(&ctx, report, false);
+
+	return ret;
+}
+
+/**
+ * @brief Restore and validate a persisted per-lane delay calibration.
+ *
+ * The result is used only if it was computed for the same board and number of
+ * lanes, at a sample rate within 0.1% of the current one, and if the PN
+ * sequence is then received without errors.
+ * @param adc - The device structure.
+ * @param param - Calibration parameters.
+ * @param cal - Persisted calibration result.
+ * @param report - Time spent and number of PN checks. May be NULL.
+ * @return Returns 0 in case of success, -ENOENT if the result doesn't match
+ * the current setup, -EIO if the validation failed or negative error code
+ * otherwise.
+ */
+int32_t axi_adc_delay_cal_apply(struct axi_adc *adc,
+				const struct axi_adc_delay_cal_param *param,
+				const struct axi_adc_delay_cal *cal,
+				struct axi_adc_delay_cal_report *report)
+{
+	struct axi_adc_cal_ctx ctx;
+	uint64_t rate, diff;
+	uint32_t lane;
+	int32_t ret;
+
+	if (!adc || !param || !cal)
+		return -EINVAL;
+
+	if (cal->magic != AXI_ADC_DELAY_CAL_MAGIC ||
+	    cal->num_lanes != param->no_of_lanes ||
+	    cal->board_id != param->board_id ||
+	    cal->crc != axi_adc_cal_crc(cal))
+		return -ENOENT;
+
+	rate = axi_adc_cal_rate(adc, param);
+	diff = rate > cal->sample_rate ? rate - cal->sample_rate :
+	       cal->sample_rate - rate;
+	if (diff > cal->sample_rate / 1000)
+		return -ENOENT;
+
+	ret = axi_adc_cal_begin(&ctx, adc, param);
+	if (ret)
+		return ret;
+
+	for (lane = 0; lane < cal->num_lanes; lane++)
+		axi_adc_idelay_set(adc, lane, cal->delay[lane]);
+	no_os_udelay(ctx.settle_us);
+
+	ret = axi_adc_cal_pn_ok(&ctx, ctx.long_us) ? 0 : -EIO;
+
+	axi_adc_cal_end(&ctx, report, true);
+
+	return ret;
+}
+
+/**
+ * @brief Restore a persisted per-lane delay calibration, or calibrate again.
+ * @param adc - The device structure.
+ * @param param - Calibration parameters.
+ * @param cal - Persisted calibration result. Updated if the calibration had
+ * to be done again.
+ * @param report - Time spent and number of PN checks. May be NULL.
+ * @return Returns 0 if the persisted result was reused, 1 if it was replaced
+ * and should be persisted again, or negative error code otherwise.
+ */
+int32_t axi_adc_delay_calibrate_cached(struct axi_adc *adc,
+				       const struct axi_adc_delay_cal_param *param,
+				       struct axi_adc_delay_cal *cal,
+				       struct axi_adc_delay_cal_report *report)
+{
+	int32_t ret;
+
+	ret = axi_adc_delay_cal_apply(adc, param, cal, report);
+	if (ret != -ENOENT && ret != -EIO)
+		return ret;
+
+	ret = axi_adc_delay_calibrate_lanes(adc, param, cal, report);
+	if (ret)
+		return ret;
+
+	return 1;
+}
+
 /**
  * @brief Calibrate phase for specific AXI ADC channel.
  * @param adc - The device structure.
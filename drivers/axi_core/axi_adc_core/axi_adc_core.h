@@ -34,6 +34,7 @@
 #define AXI_ADC_CORE_H_
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "no_os_util.h"
 
 #define AXI_ADC_REG_CONFIG		0x000C
@@ -167,6 +168,71 @@ enum axi_adc_pn_sel {
 	AXI_ADC_PN_END = 12,
 };
 
+/** Number of taps of the interface delay primitives */
+#define AXI_ADC_DELAY_TAPS		32
+/** Maximum number of lanes handled by the per-lane delay calibration */
+#define AXI_ADC_MAX_LANES		32
+/** Marks a valid \ref axi_adc_delay_cal */
+#define AXI_ADC_DELAY_CAL_MAGIC		0x4443
+
+/**
+ * @struct axi_adc_delay_cal_param
+ * @brief Per-lane delay calibration parameters.
+ */
+struct axi_adc_delay_cal_param {
+	/** Number of interface lanes */
+	uint32_t no_of_lanes;
+	/** PN sequence sent by the converter */
+	enum axi_adc_pn_sel sel;
+	/** Sample rate the result is valid for. 0 reads it from the core. */
+	uint64_t sample_rate;
+	/** Identifies the board (e.g. serial number) the result is valid for */
+	uint32_t board_id;
+	/** Taps skipped by the coarse search. 0 selects 4. */
+	uint8_t coarse_step;
+	/** Settling time after a tap change, in us. 0 selects 10. */
+	uint32_t settle_us;
+	/** PN check time of the coarse search, in us. 0 selects 20. */
+	uint32_t short_check_us;
+	/** PN check time near the eye edges, in us. 0 selects 1000. */
+	uint32_t long_check_us;
+};
+
+/**
+ * @struct axi_adc_delay_cal
+ * @brief Per-lane delay calibration result. Meant to be persisted by the
+ * caller and restored with \ref axi_adc_delay_cal_apply.
+ */
+struct axi_adc_delay_cal {
+	/** \ref AXI_ADC_DELAY_CAL_MAGIC */
+	uint16_t magic;
+	/** Number of calibrated lanes */
+	uint8_t num_lanes;
+	/** CRC-8 of the whole structure, computed with this field set to 0 */
+	uint8_t crc;
+	/** Board the result is valid for */
+	uint32_t board_id;
+	/** Sample rate the result is valid for */
+	uint64_t sample_rate;
+	/** Delay of each lane, in the middle of its eye */
+	uint8_t delay[AXI_ADC_MAX_LANES];
+	/** Number of error free taps of each lane */
+	uint8_t eye_width[AXI_ADC_MAX_LANES];
+};
+
+/**
+ * @struct axi_adc_delay_cal_report
+ * @brief Cost of a per-lane delay calibration.
+ */
+struct axi_adc_delay_cal_report {
+	/** Time spent, in us */
+	uint32_t duration_us;
+	/** Number of PN checks */
+	uint32_t pn_checks;
+	/** Set if a persisted result was reused */
+	bool cached;
+};
+
 /** Begin AXI ADC Initialization */
 int32_t axi_adc_init_begin(struct axi_adc **adc_core,
 			   const struct axi_adc_init *init);
@@ -209,6 +275,21 @@ int32_t axi_adc_delay_set(struct axi_adc *adc,
 int32_t axi_adc_delay_calibrate(struct axi_adc *core,
 				uint32_t no_of_lanes,
 				enum axi_adc_pn_sel sel);
+/** Calibrate the delay of each lane using a PN sequence */
+int32_t axi_adc_delay_calibrate_lanes(struct axi_adc *adc,
+				      const struct axi_adc_delay_cal_param *param,
+				      struct axi_adc_delay_cal *cal,
+				      struct axi_adc_delay_cal_report *report);
+/** Restore and validate a persisted per-lane delay calibration */
+int32_t axi_adc_delay_cal_apply(struct axi_adc *adc,
+				const struct axi_adc_delay_cal_param *param,
+				const struct axi_adc_delay_cal *cal,
+				struct axi_adc_delay_cal_report *report);
+/** Restore a persisted per-lane delay calibration, or calibrate again */
+int32_t axi_adc_delay_calibrate_cached(struct axi_adc *adc,
+				       const struct axi_adc_delay_cal_param *param,
+				       struct axi_adc_delay_cal *cal,
+				       struct axi_adc_delay_cal_report *report);
 /** Calibrate phase for specific AXI ADC channel */
 int32_t axi_adc_set_calib_phase(struct axi_adc *adc,
 				uint32_t chan,
@@ -613,6 +613,58 @@ int32_t axi_dac_set_datasel(struct axi_dac *dac,
 	return 0;
 }
 
+/**
+ * @brief Compute the DDS phase increment for a frequency.
+ * @param dac - The device structure.
+ * @param freq_hz - The frequency in Hz.
+ * @return The AXI_DAC_REG_DDS_INIT_INCR increment field.
+ */
+static uint32_t axi_dac_dds_freq_to_incr(struct axi_dac *dac, uint32_t freq_hz)
+{
+	uint64_t val64;
+
+	val64 = (uint64_t) freq_hz * 0xFFFFULL;
+	val64 = val64 / dac->clock_hz;
+
+	return AXI_DAC_DDS_INCR(val64) | 1;
+}
+
+/**
+ * @brief Compute the DDS initial phase for a phase in milli angles.
+ * @param phase - The phase in milli angles.
+ * @return The AXI_DAC_REG_DDS_INIT_INCR init field.
+ */
+static uint32_t axi_dac_dds_phase_to_init(uint32_t phase)
+{
+	uint64_t val64;
+
+	val64 = (uint64_t) phase * 0x10000ULL + (360000 / 2);
+	val64 = val64 / 360000;
+
+	return AXI_DAC_DDS_INIT(val64);
+}
+
+/**
+ * @brief Compute the DDS scale register value for a scale in micro units.
+ * @param scale_micro_units - The scale in micro units.
+ * @return The AXI_DAC_REG_DDS_SCALE register value.
+ */
+static uint32_t axi_dac_dds_scale_to_reg(int32_t scale_micro_units)
+{
+	uint32_t scale_reg;
+
+	scale_reg = scale_micro_units;
+	if (scale_micro_units < 0)
+		scale_reg = scale_micro_units * -1;
+	if (scale_reg >= 1999000)
+		scale_reg = 1999000;
+	scale_reg = (uint32_t)(((uint64_t)scale_reg * 0x4000) / 1000000);
+	if (scale_micro_units < 0)
+		scale_reg = scale_reg | 0x8000;
+
+	return AXI_DAC_DDS_SCALE(scale_reg);
+}
+
 /**
  * @brief AXI DAC Set DDS frequency for specific channel
  * @param dac - The device structure.
@@ -623,14 +675,12 @@ int32_t axi_dac_set_datasel(struct axi_dac *dac,
 int32_t axi_dac_dds_set_frequency(struct axi_dac *dac,
 				  uint32_t chan, uint32_t freq_hz)
 {
-	uint64_t val64;
 	uint32_t reg;
 
 	axi_dac_write(dac, AXI_DAC_REG_SYNC_CONTROL, 0);
 	axi_dac_read(dac, AXI_DAC_REG_DDS_INIT_INCR(chan), &reg);
-	val64 = (uint64_t) freq_hz * 0xFFFFULL;
-	val64 = val64 / dac->clock_hz;
-	reg = (reg & ~AXI_DAC_DDS_INCR(~0)) | AXI_DAC_DDS_INCR(val64) | 1;
+	reg = (reg & ~AXI_DAC_DDS_INCR(~0)) |
+	      axi_dac_dds_freq_to_incr(dac, freq_hz);
 	axi_dac_write(dac, AXI_DAC_REG_DDS_INIT_INCR(chan), reg);
 	axi_dac_write(dac, AXI_DAC_REG_SYNC_CONTROL, AXI_DAC_SYNC);
 
@@ -672,14 +722,11 @@ int32_t axi_dac_dds_get_frequency(struct axi_dac *dac,
 int32_t axi_dac_dds_set_phase(struct axi_dac *dac,
 			      uint32_t chan, uint32_t phase)
 {
-	uint64_t val64;
 	uint32_t reg;
 
 	axi_dac_write(dac, AXI_DAC_REG_SYNC_CONTROL, 0);
 	axi_dac_read(dac, AXI_DAC_REG_DDS_INIT_INCR(chan), &reg);
-	val64 = (uint64_t) phase * 0x10000ULL + (360000 / 2);
-	val64 = val64 / 360000;
-	reg = (reg & ~AXI_DAC_DDS_INIT(~0)) | AXI_DAC_DDS_INIT(val64);
+	reg = (reg & ~AXI_DAC_DDS_INIT(~0)) | axi_dac_dds_phase_to_init(phase);
 	axi_dac_write(dac, AXI_DAC_REG_DDS_INIT_INCR(chan), reg);
 	axi_dac_write(dac, AXI_DAC_REG_SYNC_CONTROL, AXI_DAC_SYNC);
 
@@ -724,20 +771,43 @@ int32_t axi_dac_dds_set_scale(struct axi_dac *dac,
 			      uint32_t chan,
 			      int32_t scale_micro_units)
 {
-	uint32_t scale_reg;
+	axi_dac_write(dac, AXI_DAC_REG_SYNC_CONTROL, 0);
+	axi_dac_write(dac, AXI_DAC_REG_DDS_SCALE(chan),
+		      axi_dac_dds_scale_to_reg(scale_micro_units));
+	axi_dac_write(dac, AXI_DAC_REG_SYNC_CONTROL, AXI_DAC_SYNC);
 
-	scale_reg = scale_micro_units;
-	if (scale_micro_units < 0)
-		scale_reg = scale_micro_units * -1;
-	if (scale_reg >= 1999000)
-		scale_reg = 1999000;
-	scale_reg = (uint32_t)(((uint64_t)scale_reg * 0x4000) / 1000000);
-	if (scale_micro_units < 0)
-		scale_reg = scale_reg | 0x8000;
+	return 0;
+}
+
+/**
+ * @brief AXI DAC Set frequency, phase and scale for multiple DDS tones.
+ *
+ * The new settings are staged while the synchronization is deasserted and
+ * committed with a single synchronization, so every tone switches at the
+ * same time. Since both the frequency and the phase are provided, the
+ * DDS_INIT_INCR registers are written without being read back first.
+ * @param dac - The device structure.
+ * @param tones - The tones to be updated.
+ * @param num_tones - Number of tones.
+ * @return Returns 0 in case of success or negative error code otherwise.
+ */
+int32_t axi_dac_dds_set_tones(struct axi_dac *dac,
+			      const struct axi_dac_dds_tone *tones,
+			      uint32_t num_tones)
+{
+	uint32_t i;
+
+	if (!dac || !tones || !num_tones)
+		return -EINVAL;
 
 	axi_dac_write(dac, AXI_DAC_REG_SYNC_CONTROL, 0);
-	axi_dac_write(dac, AXI_DAC_REG_DDS_SCALE(chan),
-		      AXI_DAC_DDS_SCALE(scale_reg));
+	for (i = 0; i < num_tones; i++) {
+		axi_dac_write(dac, AXI_DAC_REG_DDS_INIT_INCR(tones[i].chan),
+			      axi_dac_dds_freq_to_incr(dac, tones[i].freq_hz) |
+			      axi_dac_dds_phase_to_init(tones[i].phase));
+		axi_dac_write(dac, AXI_DAC_REG_DDS_SCALE(tones[i].chan),
+			      axi_dac_dds_scale_to_reg(tones[i].scale_micro_units));
+	}
 	axi_dac_write(dac, AXI_DAC_REG_SYNC_CONTROL, AXI_DAC_SYNC);
 
 	return 0;
@@ -971,6 +1041,40 @@ int32_t axi_dac_dds_get_calib_phase(struct axi_dac *dac,
 	return axi_dac_dds_get_calib_phase_scale(dac, 1, chan, val, val2);
 }
 
+/**
+ * @brief Drop the residency of the cached buffers overlapping a memory range.
+ *
+ * Must be called by users that write the DAC memory outside of this driver
+ * (e.g. DMA or memcpy), so that axi_dac_load_waveform() copies the waveform
+ * again.
+ * @param dac - The device structure.
+ * @param address - Start of the range that is being overwritten.
+ * @param size - Size of the range in bytes.
+ */
+void axi_dac_wave_invalidate(struct axi_dac *dac, uint32_t address,
+			     uint32_t size)
+{
+	uint32_t num_tx_channels = no_os_max(dac->num_channels / 2, 1);
+	struct axi_dac_wave *wave;
+	uint32_t wave_size;
+	uint32_t i;
+
+	for (i = 0; i < AXI_DAC_WAVE_CACHE_SIZE; i++) {
+		wave = &dac->wave_cache[i];
+		if (!wave->resident)
+			continue;
+		wave_size = wave->length * num_tx_channels * sizeof(uint32_t);
+		if (address < wave->address + wave_size &&
+		    wave->address < address + size)
+			wave->resident = false;
+	}
+
+	if (dac->sine_lut_resident &&
+	    address < dac->sine_lut_address + sizeof(sine_lut) * 4 &&
+	    dac->sine_lut_address < address + size)
+		dac->sine_lut_resident = false;
+}
+
 /**
  * @brief AXI DAC Set data based on a Sine Lookup Table
  * @param dac - The device structure.
@@ -993,6 +1097,13 @@ uint32_t axi_dac_set_sine_lut(struct axi_dac *dac,
 	uint32_t data_i2;
 	uint32_t data_q2;
 	tx_count = sizeof(sine_lut) / sizeof(uint16_t);
+	length = tx_count * dac->num_channels * 2;
+
+	/* The LUT content never changes, skip the upload if already loaded */
+	if (dac->sine_lut_resident && dac->sine_lut_address == address)
+		return length;
+
+	axi_dac_wave_invalidate(dac, address, sizeof(sine_lut) * 4);
 	if (dac->num_channels == 4) {
 		for (index = 0, index_mem = 0; index < (tx_count * 2);
 		     index += 2, index_mem += 2) {
@@ -1030,7 +1141,9 @@ uint32_t axi_dac_set_sine_lut(struct axi_dac *dac,
 		}
 	}
 
-	length = tx_count * dac->num_channels * 2;
+	dac->sine_lut_resident = true;
+	dac->sine_lut_address = address;
+
 	return length;
 }
 
@@ -1051,6 +1164,8 @@ int32_t axi_dac_set_buff(struct axi_dac *dac,
 	uint32_t data_i;
 	uint32_t data_q;
 
+	axi_dac_wave_invalidate(dac, address, buff_size * sizeof(uint16_t));
+
 	for (index = 0; index < buff_size; index += 2) {
 		data_i = (buff[index]);
 		data_q = (buff[index + 1] << 16);
@@ -1061,6 +1176,23 @@ int32_t axi_dac_set_buff(struct axi_dac *dac,
 	return 0;
 }
 
+/**
+ * @brief Select the DMA data on all the channels and sync them.
+ * @param dac - The device structure.
+ * @return Returns 0 in case of success or negative error code otherwise.
+ */
+static int32_t axi_dac_dma_select(struct axi_dac *dac)
+{
+	uint8_t chan;
+
+	for (chan = 0; chan < dac->num_channels; chan++) {
+		axi_dac_write(dac, AXI_DAC_REG_DATA_SELECT((chan * 2) + 0), 0x2);
+		axi_dac_write(dac, AXI_DAC_REG_DATA_SELECT((chan * 2) + 1), 0x2);
+	}
+
+	return axi_dac_write(dac, AXI_DAC_REG_SYNC_CONTROL, AXI_DAC_SYNC);
+}
+
 /**
  * @brief AXI DAC Load custom data.
  * @param dac - The device structure.
@@ -1078,6 +1210,9 @@ int32_t axi_dac_load_custom_data(struct axi_dac *dac,
 	uint8_t chan;
 	uint8_t num_tx_channels = dac->num_channels / 2;
 
+	axi_dac_wave_invalidate(dac, address, custom_tx_count *
+				num_tx_channels * sizeof(uint32_t));
+
 	for (index = 0; index < custom_tx_count; index++) {
 		/* Send the same data on all the channels */
 		for (chan = 0; chan < num_tx_channels; chan++) {
@@ -1089,15 +1224,139 @@ int32_t axi_dac_load_custom_data(struct axi_dac *dac,
 		}
 	}
 
-	for (chan = 0; chan < dac->num_channels; chan++) {
-		axi_dac_write(dac, AXI_DAC_REG_DATA_SELECT((chan * 2) + 0), 0x2);
-		axi_dac_write(dac, AXI_DAC_REG_DATA_SELECT((chan * 2) + 1), 0x2);
+	return axi_dac_dma_select(dac);
+}
+
+/**
+ * @brief Generate a sine waveform in I/Q format.
+ *
+ * The samples are taken from the 12-bit sine LUT using a 32-bit phase
+ * accumulator, the Q component being shifted by a quarter of a period.
+ * @param dac - The device structure.
+ * @param wave - The waveform to be generated.
+ */
+static void axi_dac_wave_generate(struct axi_dac *dac,
+				  struct axi_dac_wave *wave)
+{
+	uint32_t tx_count = NO_OS_ARRAY_SIZE(sine_lut);
+	uint64_t step;
+	uint32_t acc = 0;
+	uint32_t index;
+	int32_t data_i;
+	int32_t data_q;
+	uint32_t i;
+
+	step = ((uint64_t)wave->freq_hz << 32) / dac->clock_hz;
+
+	for (i = 0; i < wave->length; i++) {
+		index = acc >> 25;
+		data_i = no_os_sign_extend32(sine_lut[index], 11);
+		data_q = no_os_sign_extend32(sine_lut[(index + tx_count / 4) %
+						tx_count], 11);
+		data_i = ((int64_t)data_i * wave->amplitude) / 1000000;
+		data_q = ((int64_t)data_q * wave->amplitude) / 1000000;
+		wave->samples[i] = ((data_i & 0xFFF) << 20) |
+				   ((data_q & 0xFFF) << 4);
+		acc += (uint32_t)step;
 	}
-	axi_dac_write(dac, AXI_DAC_REG_SYNC_CONTROL, AXI_DAC_SYNC);
+}
+
+/**
+ * @brief AXI DAC Load a generated sine waveform.
+ *
+ * Generated waveforms are cached by (frequency, amplitude, length). A cached
+ * waveform is not generated again and, if it is still present in the DAC
+ * memory at the requested address, it is not copied again either. The DMA
+ * data path is selected and synced in both cases. The least
+ * recently used entry is evicted when the cache is full.
+ * @param dac - The device structure.
+ * @param freq_hz - The tone frequency in Hz.
+ * @param amplitude - The amplitude in micro units (1*1000*1000 is full scale).
+ * @param length - The number of I/Q samples.
+ * @param address - The address where the data is loaded.
+ * @return Returns 0 in case of success or negative error code otherwise.
+ */
+int32_t axi_dac_load_waveform(struct axi_dac *dac,
+			      uint32_t freq_hz,
+			      int32_t amplitude,
+			      uint32_t length,
+			      uint32_t address)
+{
+	struct axi_dac_wave *wave = NULL;
+	struct axi_dac_wave *entry;
+	uint32_t i;
+	int32_t ret;
+
+	if (!dac || !length || !dac->clock_hz ||
+	    amplitude < 0 || amplitude > 1000000)
+		return -EINVAL;
+
+	for (i = 0; i < AXI_DAC_WAVE_CACHE_SIZE; i++) {
+		entry = &dac->wave_cache[i];
+		if (entry->samples && entry->freq_hz == freq_hz &&
+		    entry->amplitude == amplitude && entry->length == length) {
+			wave = entry;
+			break;
+		}
+	}
+
+	if (!wave) {
+		/* Pick an unused entry or the least recently used one */
+		wave = &dac->wave_cache[0];
+		for (i = 0; i < AXI_DAC_WAVE_CACHE_SIZE; i++) {
+			entry = &dac->wave_cache[i];
+			if (!entry->samples) {
+				wave = entry;
+				break;
+			}
+			if (entry->last_used < wave->last_used)
+				wave = entry;
+		}
+
+		no_os_free(wave->samples);
+		wave->samples = no_os_calloc(length, sizeof(*wave->samples));
+		if (!wave->samples)
+			return -ENOMEM;
+
+		wave->freq_hz = freq_hz;
+		wave->amplitude = amplitude;
+		wave->length = length;
+		wave->resident = false;
+		axi_dac_wave_generate(dac, wave);
+	}
+
+	wave->last_used = ++dac->wave_cache_tick;
+
+	/* Already in the DAC memory, only the data path has to be selected */
+	if (wave->resident && wave->address == address)
+		return axi_dac_dma_select(dac);
+
+	ret = axi_dac_load_custom_data(dac, wave->samples, length, address);
+	if (ret)
+		return ret;
+
+	wave->resident = true;
+	wave->address = address;
 
 	return 0;
 }
 
+/**
+ * @brief AXI DAC Release all the cached waveforms.
+ * @param dac - The device structure.
+ */
+void axi_dac_wave_cache_flush(struct axi_dac *dac)
+{
+	uint32_t i;
+
+	for (i = 0; i < AXI_DAC_WAVE_CACHE_SIZE; i++) {
+		no_os_free(dac->wave_cache[i].samples);
+		dac->wave_cache[i].samples = NULL;
+		dac->wave_cache[i].resident = false;
+	}
+	dac->sine_lut_resident = false;
+}
+
 /**
  * @brief Begin AXI DAC Initialization.
  * @param dac_core - The device structure.
@@ -1109,7 +1368,7 @@ int32_t axi_dac_init_begin(struct axi_dac **dac_core,
 {
 	struct axi_dac *dac;
 
-	dac = (struct axi_dac *)no_os_malloc(sizeof(*dac));
+	dac = (struct axi_dac *)no_os_calloc(1, sizeof(*dac));
 	if (!dac)
 		return -1;
 
@@ -1201,6 +1460,7 @@ error:
  */
 int32_t axi_dac_data_setup(struct axi_dac *dac)
 {
+	struct axi_dac_dds_tone tones[2];
 	struct axi_dac_channel *chan;
 	uint32_t i;
 
@@ -1208,30 +1468,31 @@ int32_t axi_dac_data_setup(struct axi_dac *dac)
 		for (i = 0; i < dac->num_channels; i++) {
 			chan = &dac->channels[i];
 			if (chan->sel == AXI_DAC_DATA_SEL_DDS) {
-				axi_dac_dds_set_frequency(dac, ((i * 2) + 0), chan->dds_frequency_0);
-				axi_dac_dds_set_phase(dac, ((i * 2) + 0), chan->dds_phase_0);
-				axi_dac_dds_set_scale(dac, ((i * 2) + 0), chan->dds_scale_0);
-				if (chan->dds_dual_tone == 0) {
-					axi_dac_dds_set_frequency(dac, ((i * 2) + 1), chan->dds_frequency_0);
-					axi_dac_dds_set_phase(dac, ((i * 2) + 1), chan->dds_phase_0);
-					axi_dac_dds_set_scale(dac, ((i * 2) + 1), chan->dds_scale_0);
-				} else {
-					axi_dac_dds_set_frequency(dac, ((i * 2) + 1), chan->dds_frequency_1);
-					axi_dac_dds_set_phase(dac, ((i * 2) + 1), chan->dds_phase_1);
-					axi_dac_dds_set_scale(dac, ((i * 2) + 1), chan->dds_scale_1);
+				tones[0].chan = (i * 2) + 0;
+				tones[0].freq_hz = chan->dds_frequency_0;
+				tones[0].phase = chan->dds_phase_0;
+				tones[0].scale_micro_units = chan->dds_scale_0;
+				tones[1] = tones[0];
+				tones[1].chan = (i * 2) + 1;
+				if (chan->dds_dual_tone) {
+					tones[1].freq_hz = chan->dds_frequency_1;
+					tones[1].phase = chan->dds_phase_1;
+					tones[1].scale_micro_units = chan->dds_scale_1;
 				}
+				axi_dac_dds_set_tones(dac, tones, 2);
 			}
 			axi_dac_write(dac, DAC_REG_DATA_PATTERN(i), chan->pat_data);
 			axi_dac_set_datasel(dac, i, chan->sel);
 		}
 	} else {
 		for (i = 0; i < dac->num_channels; i++) {
-			axi_dac_dds_set_frequency(dac, ((i * 2) + 0), 3 * 1000 * 1000);
-			axi_dac_dds_set_frequency(dac, ((i * 2) + 1), 3 * 1000 * 1000);
-			axi_dac_dds_set_phase(dac, ((i * 2) + 0), (i % 2) ? 0 : 90000);
-			axi_dac_dds_set_phase(dac, ((i * 2) + 1), (i % 2) ? 0 : 90000);
-			axi_dac_dds_set_scale(dac, ((i * 2) + 0), 50 * 1000);
-			axi_dac_dds_set_scale(dac, ((i * 2) + 1), 50 * 1000);
+			tones[0].chan = (i * 2) + 0;
+			tones[0].freq_hz = 3 * 1000 * 1000;
+			tones[0].phase = (i % 2) ? 0 : 90000;
+			tones[0].scale_micro_units = 50 * 1000;
+			tones[1] = tones[0];
+			tones[1].chan = (i * 2) + 1;
+			axi_dac_dds_set_tones(dac, tones, 2);
 			axi_dac_write(dac, AXI_DAC_REG_DATA_SELECT((i * 2) + 0), 0);
 			axi_dac_write(dac, AXI_DAC_REG_DATA_SELECT((i * 2) + 1), 0);
 		}
@@ -1246,6 +1507,7 @@ int32_t axi_dac_data_setup(struct axi_dac *dac)
  */
 int32_t axi_dac_remove(struct axi_dac *dac)
 {
+	axi_dac_wave_cache_flush(dac);
 	no_os_free(dac);
 
 	return 0;
@@ -34,6 +34,10 @@
 #define AXI_DAC_CORE_H_
 
 #include <stdint.h>
+#include <stdbool.h>
+
+/** Number of generated waveforms kept by the AXI DAC waveform cache */
+#define AXI_DAC_WAVE_CACHE_SIZE		4
 
 enum axi_iface {
 	AXI_DAC_BUS_TYPE_NONE,
@@ -46,6 +50,27 @@ enum axi_io_mode {
 	AXI_DAC_IO_MODE_QSPI,
 };
 
+/**
+ * @struct axi_dac_wave
+ * @brief Generated waveform, cached by (frequency, amplitude, length).
+ */
+struct axi_dac_wave {
+	/** Tone frequency in Hz */
+	uint32_t freq_hz;
+	/** Amplitude in micro units (1*1000*1000 is full scale) */
+	int32_t amplitude;
+	/** Number of I/Q samples */
+	uint32_t length;
+	/** Generated I/Q samples, NULL if the entry is unused */
+	uint32_t *samples;
+	/** Set while the samples are present in the DAC memory at address */
+	bool resident;
+	/** DAC memory address the samples were last loaded at */
+	uint32_t address;
+	/** Value of the cache tick when the entry was last used */
+	uint32_t last_used;
+};
+
 /**
  * @struct axi_dac
  * @brief AXI DAC Device Descriptor.
@@ -63,6 +88,14 @@ struct axi_dac {
 	struct axi_dac_channel *channels;
 	/** DAC IP bus type */
 	uint32_t bus_type;
+	/** Generated waveform cache */
+	struct axi_dac_wave wave_cache[AXI_DAC_WAVE_CACHE_SIZE];
+	/** Waveform cache usage counter, used for LRU eviction */
+	uint32_t wave_cache_tick;
+	/** Set while the sine LUT is present in the DAC memory */
+	bool sine_lut_resident;
+	/** DAC memory address the sine LUT was last loaded at */
+	uint32_t sine_lut_address;
 };
 
 struct axi_dac_init {
@@ -105,6 +138,21 @@ struct axi_dac_channel {
 	enum axi_dac_data_sel sel;      // set to one of the enumerated type above.
 };
 
+/**
+ * @struct axi_dac_dds_tone
+ * @brief DDS tone settings, used for staged multi-channel updates.
+ */
+struct axi_dac_dds_tone {
+	/** DDS tone index ((channel * 2) + tone) */
+	uint32_t chan;
+	/** Frequency in Hz */
+	uint32_t freq_hz;
+	/** Phase in milli angles (90*1000 is 90 degrees) */
+	uint32_t phase;
+	/** Scale in micro units (1*1000*1000 is 1.0) */
+	int32_t scale_micro_units;
+};
+
 extern const uint16_t sine_lut[128];
 
 extern const uint32_t sine_lut_iq[1024];
@@ -143,6 +191,10 @@ int32_t axi_dac_dds_set_scale(struct axi_dac *dac,
 int32_t axi_dac_dds_get_scale(struct axi_dac *dac,
 			      uint32_t chan,
 			      int32_t *scale_micro_units);
+/** AXI DAC Set multiple DDS tones with a single synchronization */
+int32_t axi_dac_dds_set_tones(struct axi_dac *dac,
+			      const struct axi_dac_dds_tone *tones,
+			      uint32_t num_tones);
 /** AXI DAC Set Buffer */
 int32_t axi_dac_set_buff(struct axi_dac *dac,
 			 uint32_t address,
@@ -176,6 +228,17 @@ int32_t axi_dac_load_custom_data(struct axi_dac *dac,
 				 const uint32_t *custom_data_iq,
 				 uint32_t custom_tx_count,
 				 uint32_t address);
+/** AXI DAC Load a generated sine waveform, reusing cached buffers */
+int32_t axi_dac_load_waveform(struct axi_dac *dac,
+			      uint32_t freq_hz,
+			      int32_t amplitude,
+			      uint32_t length,
+			      uint32_t address);
+/** AXI DAC Drop the cached waveforms overwritten by an external write */
+void axi_dac_wave_invalidate(struct axi_dac *dac, uint32_t address,
+			     uint32_t size);
+/** AXI DAC Release all the cached waveforms */
+void axi_dac_wave_cache_flush(struct axi_dac *dac);
 /** Setup the AXI DAC Data */
 int32_t axi_dac_data_setup(struct axi_dac *dac);
 /** AXI DAC Bus Data read */
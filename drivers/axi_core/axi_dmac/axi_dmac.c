@@ -40,6 +40,7 @@
 #include "no_os_error.h"
 #include "no_os_delay.h"
 #include "no_os_alloc.h"
+#include "no_os_print_log.h"
 #include "axi_dmac.h"
 
 /*******************************************************************************
@@ -395,7 +396,7 @@ int32_t axi_dmac_transfer_start(struct axi_dmac *dmac,
 	/* If HW cyclic transfer selected and not available, show error */
 	/* HW cyclic transfer available only for MEM to DEV transfers. */
 	if ((!dmac->hw_cyclic) && (dma_transfer->cyclic == CYCLIC)) {
-		printf("Transfer mode not supported!\n");
+		pr_err("Transfer mode not supported!\n");
 		return -1;
 	}
 
@@ -403,7 +404,7 @@ int32_t axi_dmac_transfer_start(struct axi_dmac *dmac,
 	if ((dmac->direction == DMA_DEV_TO_MEM)
 	    || (dmac->direction == DMA_MEM_TO_MEM)) {
 		if (dma_transfer->cyclic == CYCLIC) {
-			printf("Transfer mode not supported!\n");
+			pr_err("Transfer mode not supported!\n");
 			return -1;
 		}
 	}
@@ -440,7 +441,7 @@ int32_t axi_dmac_transfer_start(struct axi_dmac *dmac,
 			axi_dmac_write(dmac, AXI_DMAC_REG_DEST_ADDRESS, dmac->next_dest_addr);
 			axi_dmac_write(dmac, AXI_DMAC_REG_DEST_STRIDE, 0x0);
 			if (dmac->transfer.dest_addr % dmac->width_dst) {
-				printf("Destination address should be aligned with destination data path width.\n\n");
+				pr_err("Destination address should be aligned with destination data path width.\n");
 				return -1;
 			}
 			break;
@@ -449,7 +450,7 @@ int32_t axi_dmac_transfer_start(struct axi_dmac *dmac,
 			axi_dmac_write(dmac, AXI_DMAC_REG_SRC_ADDRESS, dmac->next_src_addr);
 			axi_dmac_write(dmac, AXI_DMAC_REG_SRC_STRIDE, 0x0);
 			if (dmac->transfer.src_addr % dmac->width_src) {
-				printf("Source address should be aligned with source data path width.\n");
+				pr_err("Source address should be aligned with source data path width.\n");
 				return -1;
 			}
 			break;
@@ -461,7 +462,7 @@ int32_t axi_dmac_transfer_start(struct axi_dmac *dmac,
 			axi_dmac_write(dmac, AXI_DMAC_REG_SRC_STRIDE, 0x0);
 			if ((dmac->transfer.dest_addr % (dmac->width_dst))
 			    || (dmac->transfer.src_addr % (dmac->width_src))) {
-				printf("Source and destination addresses should be aligned with data path widths.\n");
+				pr_err("Source and destination addresses should be aligned with data path widths.\n");
 				return -1;
 			}
 			break;
@@ -525,7 +526,7 @@ int32_t axi_dmac_transfer_wait_completion(struct axi_dmac *dmac,
 			timeout++;
 			no_os_mdelay(1);
 			if (timeout == timeout_ms) {
-				printf("Error transferring data using DMA.\n");
+				pr_err("Error transferring data using DMA.\n");
 				return -1;
 			}
 		}
@@ -535,7 +536,7 @@ int32_t axi_dmac_transfer_wait_completion(struct axi_dmac *dmac,
 			timeout++;
 			no_os_mdelay(1);
 			if (timeout == timeout_ms) {
-				printf("Error transferring data using DMA.\n");
+				pr_err("Error transferring data using DMA.\n");
 				return -1;
 			}
 			axi_dmac_read(dmac, AXI_DMAC_REG_IRQ_PENDING, &reg_val);
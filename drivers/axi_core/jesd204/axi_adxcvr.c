@@ -314,6 +314,9 @@ int adxcvr_clk_set_rate(struct adxcvr *xcvr,
 	pr_debug("%s: Rate %lu Hz Parent Rate %lu Hz\n",
 		 __func__, rate, parent_rate);
 
+	/* The rate may also be changed without going through clk_out */
+	no_os_clk_invalidate_rate(xcvr->clk_out);
+
 	clk25_div = NO_OS_DIV_ROUND_CLOSEST(parent_rate, 25000);
 
 	if (xcvr->cpll_enable)
@@ -557,7 +560,7 @@ static void adxcvr_get_info(struct adxcvr *xcvr)
 int32_t adxcvr_init(struct adxcvr **ad_xcvr,
 		    const struct adxcvr_init *init)
 {
-	struct no_os_clk_init_param clk_out_init;
+	struct no_os_clk_init_param clk_out_init = { 0 };
 	uint32_t synth_conf, xcvr_type;
 	struct adxcvr *xcvr;
 	int32_t ret;
@@ -659,6 +662,7 @@ int32_t adxcvr_init(struct adxcvr **ad_xcvr,
 		clk_out_init.dev_desc = xcvr;
 		clk_out_init.platform_ops = &adxcvr_clk_ops;
 		clk_out_init.name = xcvr->name;
+		clk_out_init.flags = NO_OS_CLK_CACHE_RATE;
 		ret = no_os_clk_init(&xcvr->clk_out, &clk_out_init);
 		if (ret)
 			goto err;
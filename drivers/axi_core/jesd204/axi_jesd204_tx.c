@@ -619,6 +619,9 @@ static int axi_jesd204_tx_jesd204_link_setup(struct jesd204_dev *jdev,
 	case JESD204_STATE_OP_REASON_INIT:
 		break;
 	case JESD204_STATE_OP_REASON_UNINIT:
+		/* Balance the no_os_clk_enable() below */
+		no_os_clk_disable(jesd->lane_clk);
+
 		return JESD204_STATE_CHANGE_DONE;
 	default:
 		return JESD204_STATE_CHANGE_DONE;
@@ -34,10 +34,19 @@
 *******************************************************************************/
 
 #include <stdlib.h>
+#include <string.h>
 #include "no_os_error.h"
 #include "adas1000.h"
 #include "no_os_crc.h"
 #include "no_os_alloc.h"
+#include "no_os_util.h"
+
+/* Byte size of the frame header, which is a 32 bit word at all frame rates */
+#define ADAS1000_HEADER_SIZE	4
+
+NO_OS_DECLARE_CRC16_TABLE(adas1000_crc16);
+NO_OS_DECLARE_CRC24_TABLE(adas1000_crc24);
+static bool adas1000_crc_populated;
 
 /**
  * @brief Preliminary function which computes the spi frequency based on the
@@ -386,6 +395,19 @@ int32_t adas1000_read_data(struct adas1000_dev *device, uint8_t *data_buff,
 	return ret;
 }
 
+/**
+ * @brief Populate the CRC tables, once.
+ */
+static void adas1000_crc_init(void)
+{
+	if (adas1000_crc_populated)
+		return;
+
+	no_os_crc16_populate_msb(adas1000_crc16, CRC_POLY_128KHZ);
+	no_os_crc24_populate_msb(adas1000_crc24, CRC_POLY_2KHZ_16KHZ);
+	adas1000_crc_populated = true;
+}
+
 /**
  * @brief Computes the CRC for a frame.
  * @param device - Device structure.
@@ -396,14 +418,346 @@ uint32_t adas1000_compute_frame_crc(struct adas1000_dev * device, uint8_t *buff)
 {
 	uint32_t crc = 0xFFFFFFFFul;
 
+	adas1000_crc_init();
+
 	/** Select the CRC poly and word size based on the frame rate. */
-	if (device->frame_rate == ADAS1000_128KHZ_FRAME_RATE) {
-		NO_OS_DECLARE_CRC16_TABLE(adas1000_crc16);
-		no_os_crc16_populate_msb(adas1000_crc16, CRC_POLY_128KHZ);
+	if (device->frame_rate == ADAS1000_128KHZ_FRAME_RATE)
 		return no_os_crc16(adas1000_crc16, buff, device->frame_size, (uint16_t)crc);
-	} else {
-		NO_OS_DECLARE_CRC24_TABLE(adas1000_crc24);
-		no_os_crc24_populate_msb(adas1000_crc24, CRC_POLY_2KHZ_16KHZ);
+	else
 		return no_os_crc24(adas1000_crc24, buff, device->frame_size, crc);
+}
+
+/**
+ * @brief Checks the CRC of a frame. Computed over the whole frame, including
+ *	  the CRC word, the CRC of a valid frame is a constant.
+ * @param device - Device structure.
+ * @param buff - Buffer holding the frame data.
+ * @return true if the frame is valid, false otherwise.
+ */
+bool adas1000_frame_crc_valid(struct adas1000_dev *device, uint8_t *buff)
+{
+	uint32_t crc = adas1000_compute_frame_crc(device, buff);
+
+	if (device->frame_rate == ADAS1000_128KHZ_FRAME_RATE)
+		return (crc & 0xFFFF) == CRC_CHECK_CONST_128KHz;
+
+	return (crc & ADAS1000_CRC_MASK) == CRC_CHECK_CONST_2KHZ_16KHZ;
+}
+
+/**
+ * @brief DRDY interrupt callback.
+ * @param context - Device structure.
+ */
+static void adas1000_drdy_handler(void *context)
+{
+	struct adas1000_dev *device = context;
+
+	device->stream.pending = true;
+}
+
+/**
+ * @brief Starts streaming frames. The frame layout is read from the Frame
+ *	  Control Register, which must not be changed until the stream is
+ *	  stopped. Frames are read in blocks by a single SPI transfer, using DMA
+ *	  when the platform supports it. The SPI clock must be high enough for
+ *	  a block to be read before the next frames are due, see
+ *	  adas1000_compute_spi_freq().
+ * @param device - The device structure.
+ * @param param - Streaming parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t adas1000_stream_start(struct adas1000_dev *device,
+			      const struct adas1000_stream_param *param)
+{
+	struct adas1000_stream *stream;
+	uint32_t frm_ctrl, word_size, lead_bytes;
+	uint8_t i;
+	int32_t ret;
+
+	if (!device || !param)
+		return -EINVAL;
+
+	stream = &device->stream;
+	if (stream->active)
+		return -EBUSY;
+
+	stream->decimation = param->decimation ? param->decimation : 1;
+	if (stream->decimation > ADAS1000_STREAM_MAX_DECIMATION)
+		return -EINVAL;
+	stream->frames = param->frames ? param->frames : stream->decimation;
+
+	ret = adas1000_read(device, ADAS1000_FRMCTL, &frm_ctrl);
+	if (ret != 0)
+		return ret;
+
+	/* The frame size must not depend on the data */
+	if (frm_ctrl & ADAS1000_FRMCTL_ADIS)
+		return -EINVAL;
+
+	stream->nb_leads = 0;
+	for (i = 0; i < ADAS1000_NUM_LEADS; i++)
+		if (!(frm_ctrl & (ADAS1000_FRMCTL_LEAD_I_LADIS >> i)))
+			stream->leads[stream->nb_leads++] = i;
+
+	word_size = device->frame_rate == ADAS1000_128KHZ_FRAME_RATE ? 2 : 4;
+	lead_bytes = stream->nb_leads * word_size;
+	if (device->frame_size < ADAS1000_HEADER_SIZE + lead_bytes)
+		return -EINVAL;
+
+	stream->signed_data = frm_ctrl & ADAS1000_FRMCTL_DATAFMT;
+	stream->crc_check = !(frm_ctrl & ADAS1000_FRMCTL_CRCDIS);
+	if (stream->crc_check)
+		adas1000_crc_init();
+
+	stream->rx_buf = no_os_calloc(stream->frames, device->frame_size);
+	if (!stream->rx_buf)
+		return -ENOMEM;
+
+	/* NOP commands are sent while the frames are read */
+	stream->tx_buf = no_os_calloc(stream->frames, device->frame_size);
+	if (!stream->tx_buf) {
+		ret = -ENOMEM;
+		goto error_rx;
 	}
+
+	stream->acc_cnt = 0;
+	memset(stream->acc, 0, sizeof(stream->acc));
+	stream->use_dma = true;
+	stream->pending = false;
+	stream->drdy_irq_ctrl = param->drdy_irq_ctrl;
+	stream->drdy_irq_id = param->drdy_irq_id;
+
+	if (stream->drdy_irq_ctrl) {
+		stream->drdy_cb.callback = adas1000_drdy_handler;
+		stream->drdy_cb.ctx = device;
+		stream->drdy_cb.event = NO_OS_EVT_GPIO;
+		stream->drdy_cb.peripheral = NO_OS_GPIO_IRQ;
+
+		ret = no_os_irq_register_callback(stream->drdy_irq_ctrl,
+						  stream->drdy_irq_id,
+						  &stream->drdy_cb);
+		if (ret != 0)
+			goto error_tx;
+
+		/* DRDY is driven low when a frame is ready */
+		ret = no_os_irq_trigger_level_set(stream->drdy_irq_ctrl,
+						  stream->drdy_irq_id,
+						  NO_OS_IRQ_EDGE_FALLING);
+		if (ret != 0)
+			goto error_irq;
+
+		ret = no_os_irq_enable(stream->drdy_irq_ctrl, stream->drdy_irq_id);
+		if (ret != 0)
+			goto error_irq;
+	}
+
+	/** Start the frames read sequence. */
+	ret = adas1000_write(device, ADAS1000_FRAMES, 0);
+	if (ret != 0)
+		goto error_enable;
+
+	stream->active = true;
+
+	return 0;
+
+error_enable:
+	if (stream->drdy_irq_ctrl)
+		no_os_irq_disable(stream->drdy_irq_ctrl, stream->drdy_irq_id);
+error_irq:
+	if (stream->drdy_irq_ctrl)
+		no_os_irq_unregister_callback(stream->drdy_irq_ctrl,
+					      stream->drdy_irq_id,
+					      &stream->drdy_cb);
+error_tx:
+	no_os_free(stream->tx_buf);
+	stream->tx_buf = NULL;
+error_rx:
+	no_os_free(stream->rx_buf);
+	stream->rx_buf = NULL;
+
+	return ret;
+}
+
+/**
+ * @brief Stops streaming frames. The statistics are kept.
+ * @param device - The device structure.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t adas1000_stream_stop(struct adas1000_dev *device)
+{
+	struct adas1000_stream *stream;
+	uint32_t reg_data;
+	int32_t ret;
+
+	if (!device)
+		return -EINVAL;
+
+	stream = &device->stream;
+	if (!stream->active)
+		return 0;
+
+	if (stream->drdy_irq_ctrl) {
+		ret = no_os_irq_disable(stream->drdy_irq_ctrl, stream->drdy_irq_id);
+		if (ret != 0)
+			return ret;
+
+		ret = no_os_irq_unregister_callback(stream->drdy_irq_ctrl,
+						    stream->drdy_irq_id,
+						    &stream->drdy_cb);
+		if (ret != 0)
+			return ret;
+	}
+
+	/** Reading a register stops the frames read sequence. */
+	ret = adas1000_read(device, ADAS1000_FRMCTL, &reg_data);
+	if (ret != 0)
+		return ret;
+
+	no_os_free(stream->tx_buf);
+	stream->tx_buf = NULL;
+	no_os_free(stream->rx_buf);
+	stream->rx_buf = NULL;
+	stream->active = false;
+
+	return 0;
+}
+
+/**
+ * @brief Checks if frames can be read without waiting. Without DRDY
+ *	  interrupt, the SPI clock paces the reads and the stream is always
+ *	  ready.
+ * @param device - The device structure.
+ * @param ready - Set if a block of frames may be read.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t adas1000_stream_ready(struct adas1000_dev *device, bool *ready)
+{
+	if (!device || !ready || !device->stream.active)
+		return -EINVAL;
+
+	*ready = !device->stream.drdy_irq_ctrl || device->stream.pending;
+
+	return 0;
+}
+
+/**
+ * @brief Reads a block of frames and returns the decimated lead samples. The
+ *	  frames which are not ready, miss the header marker or fail the CRC
+ *	  check are dropped and counted. The decimation filter averages the
+ *	  valid frames and carries its state over to the next block.
+ * @param device - The device structure.
+ * @param data - Lead samples, nb_leads values per sample, in LA, LL, RA, V1,
+ *		 V2 order. Must hold DIV_ROUND_UP(frames, decimation) samples.
+ * @param nb_samples - Number of samples returned.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t adas1000_stream_read(struct adas1000_dev *device, int32_t *data,
+			     uint32_t *nb_samples)
+{
+	struct adas1000_stream *stream;
+	struct no_os_spi_msg msg;
+	uint32_t header, raw, i, n = 0;
+	uint8_t *frame, *word;
+	uint8_t k;
+	int32_t ret;
+
+	if (!device || !data || !nb_samples || !device->stream.active)
+		return -EINVAL;
+
+	stream = &device->stream;
+	stream->pending = false;
+
+	msg = (struct no_os_spi_msg) {
+		.tx_buff = stream->tx_buf,
+		.rx_buff = stream->rx_buf,
+		.bytes_number = stream->frames * device->frame_size,
+		.cs_change = 1,
+	};
+
+	ret = -ENOSYS;
+	if (stream->use_dma) {
+		ret = no_os_spi_transfer_dma(device->spi_desc, &msg, 1);
+		if (ret == -ENOSYS)
+			stream->use_dma = false;
+	}
+	if (!stream->use_dma)
+		ret = no_os_spi_transfer(device->spi_desc, &msg, 1);
+	if (ret != 0)
+		return ret;
+
+	frame = stream->rx_buf;
+	for (i = 0; i < stream->frames; i++, frame += device->frame_size) {
+		header = no_os_get_unaligned_be32(frame);
+		if (!(header & ADAS1000_FRAMES_MARKER)) {
+			stream->marker_errors++;
+			continue;
+		}
+		if (header & ADAS1000_FRAMES_READY_BIT) {
+			stream->not_ready++;
+			continue;
+		}
+		if (stream->crc_check && !adas1000_frame_crc_valid(device, frame)) {
+			stream->crc_errors++;
+			continue;
+		}
+
+		stream->valid_frames++;
+		stream->missed += no_os_field_get(ADAS1000_FRAMES_OVERFLOW_MASK,
+						  header);
+
+		word = frame + ADAS1000_HEADER_SIZE;
+		for (k = 0; k < stream->nb_leads; k++) {
+			if (device->frame_rate == ADAS1000_128KHZ_FRAME_RATE) {
+				raw = no_os_get_unaligned_be16(word);
+				word += 2;
+				stream->acc[k] += stream->signed_data ?
+						  no_os_sign_extend32(raw, 15) : (int32_t)raw;
+			} else {
+				raw = no_os_get_unaligned_be32(word) &
+				      ADAS1000_LADATA_ECG_DATA_MASK;
+				word += 4;
+				stream->acc[k] += stream->signed_data ?
+						  no_os_sign_extend32(raw, 23) : (int32_t)raw;
+			}
+		}
+
+		if (++stream->acc_cnt < stream->decimation)
+			continue;
+
+		for (k = 0; k < stream->nb_leads; k++) {
+			*data++ = stream->acc[k] / (int32_t)stream->decimation;
+			stream->acc[k] = 0;
+		}
+		stream->acc_cnt = 0;
+		n++;
+	}
+
+	*nb_samples = n;
+
+	return 0;
+}
+
+/**
+ * @brief Free the resources allocated by adas1000_init().
+ * @param device - The device structure.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t adas1000_remove(struct adas1000_dev *device)
+{
+	int32_t ret;
+
+	if (!device)
+		return -EINVAL;
+
+	ret = adas1000_stream_stop(device);
+	if (ret != 0)
+		return ret;
+
+	ret = no_os_spi_remove(device->spi_desc);
+	if (ret != 0)
+		return ret;
+
+	no_os_free(device);
+
+	return 0;
 }
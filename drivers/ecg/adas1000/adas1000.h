@@ -39,6 +39,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "no_os_spi.h"
+#include "no_os_irq.h"
 
 /******************************************************************************/
 /* ADAS1000 SPI Registers Memory Map */
@@ -995,6 +996,7 @@
    10 = 2 frames missed
    11 = 3 or more frames missed */
 #define ADAS1000_FRAMES_OVERFLOW		            (1ul << 28)
+#define ADAS1000_FRAMES_OVERFLOW_MASK	      (0x00000003ul << 28)
 /* Internal device error detected.
    0 = normal operation
    1 = error condition	*/
@@ -1063,6 +1065,74 @@
 #define CRC_POLY_128KHZ				               0x00001021ul
 #define CRC_CHECK_CONST_128KHz			         0x00001D0Ful
 
+/******************************************************************************/
+/* ADAS1000 frame streaming */
+/******************************************************************************/
+#define ADAS1000_NUM_LEADS			         5
+#define ADAS1000_STREAM_MAX_DECIMATION		   128
+
+enum adas1000_lead {
+	ADAS1000_LEAD_LA,
+	ADAS1000_LEAD_LL,
+	ADAS1000_LEAD_RA,
+	ADAS1000_LEAD_V1,
+	ADAS1000_LEAD_V2,
+};
+
+struct adas1000_stream_param {
+	/** Frames read by each SPI transfer, 0 for one output sample worth */
+	uint32_t frames;
+	/** Number of frames averaged into one output sample, 0 or 1 for none */
+	uint32_t decimation;
+	/** Interrupt controller of the DRDY pin, NULL to read without waiting */
+	struct no_os_irq_ctrl_desc *drdy_irq_ctrl;
+	/** DRDY pin interrupt ID */
+	uint32_t drdy_irq_id;
+};
+
+struct adas1000_stream {
+	/** Set while the device is in frame mode */
+	bool active;
+	/** Cleared once the platform reported DMA transfers as unsupported */
+	bool use_dma;
+	/** Frames read by each transfer */
+	uint32_t frames;
+	/** Frames averaged into one output sample */
+	uint32_t decimation;
+	/** Received frames */
+	uint8_t *rx_buf;
+	/** Transmitted NOP words */
+	uint8_t *tx_buf;
+	/** Number of lead words in a frame */
+	uint8_t nb_leads;
+	/** Leads in frame order */
+	uint8_t leads[ADAS1000_NUM_LEADS];
+	/** Lead data is two's complement (lead/vector format) */
+	bool signed_data;
+	/** Frames end with a CRC word */
+	bool crc_check;
+	/** Decimation filter accumulators */
+	int32_t acc[ADAS1000_NUM_LEADS];
+	/** Frames in the accumulators */
+	uint32_t acc_cnt;
+	/** Set by the DRDY interrupt */
+	volatile bool pending;
+	/** DRDY interrupt callback */
+	struct no_os_callback_desc drdy_cb;
+	struct no_os_irq_ctrl_desc *drdy_irq_ctrl;
+	uint32_t drdy_irq_id;
+	/** Valid frames */
+	uint32_t valid_frames;
+	/** Frames without the header marker */
+	uint32_t marker_errors;
+	/** Frames with a CRC mismatch */
+	uint32_t crc_errors;
+	/** Frames read before the READY bit was set */
+	uint32_t not_ready;
+	/** Frames missed by the host, as reported by the headers */
+	uint32_t missed;
+};
+
 struct adas1000_dev {
 	/** SPI Descriptor */
 	struct no_os_spi_desc *spi_desc;
@@ -1072,6 +1142,8 @@ struct adas1000_dev {
 	uint32_t frame_rate;
 	/** Number of inactive words in a frame */
 	uint32_t inactive_words_no;
+	/** Frame streaming state */
+	struct adas1000_stream stream;
 };
 
 struct adas1000_init_param {
@@ -1132,4 +1204,24 @@ int32_t adas1000_read_data(struct adas1000_dev *device, uint8_t *data_buff,
 uint32_t adas1000_compute_frame_crc(struct adas1000_dev * device,
 				    uint8_t *buff);
 
+/* Checks the CRC of a frame */
+bool adas1000_frame_crc_valid(struct adas1000_dev *device, uint8_t *buff);
+
+/* Starts streaming frames */
+int32_t adas1000_stream_start(struct adas1000_dev *device,
+			      const struct adas1000_stream_param *param);
+
+/* Stops streaming frames */
+int32_t adas1000_stream_stop(struct adas1000_dev *device);
+
+/* Checks if frames can be read without waiting */
+int32_t adas1000_stream_ready(struct adas1000_dev *device, bool *ready);
+
+/* Reads a block of frames and returns the decimated lead samples */
+int32_t adas1000_stream_read(struct adas1000_dev *device, int32_t *data,
+			     uint32_t *nb_samples);
+
+/* Free the resources allocated by adas1000_init() */
+int32_t adas1000_remove(struct adas1000_dev *device);
+
 #endif /* _ADAS1000_H_ */
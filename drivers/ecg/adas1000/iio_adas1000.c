@@ -0,0 +1,447 @@
+/***************************************************************************//**
+ *   @file   iio_adas1000.c
+ *   @brief  Implementation of the ADAS1000 IIO driver.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <stdio.h>
+#include <inttypes.h>
+#include "no_os_error.h"
+#include "no_os_util.h"
+#include "no_os_alloc.h"
+#include "no_os_delay.h"
+#include "iio_adas1000.h"
+
+/* Time to wait for a DRDY interrupt, in milliseconds */
+#define ADAS1000_IIO_STREAM_TIMEOUT	100
+
+enum adas1000_iio_stat {
+	ADAS1000_IIO_VALID_FRAMES,
+	ADAS1000_IIO_MARKER_ERRORS,
+	ADAS1000_IIO_CRC_ERRORS,
+	ADAS1000_IIO_NOT_READY,
+	ADAS1000_IIO_MISSED,
+};
+
+static const char * const adas1000_iio_lead_names[ADAS1000_NUM_LEADS] = {
+	"la", "ll", "ra", "v1", "v2"
+};
+
+/**
+ * @brief Read a device register.
+ * @param dev - The IIO device structure.
+ * @param reg - Register address.
+ * @param readval - Register value.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int adas1000_iio_read_reg(void *dev, uint32_t reg, uint32_t *readval)
+{
+	struct adas1000_iio_dev *desc = dev;
+
+	return adas1000_read(desc->adas1000_dev, reg, readval);
+}
+
+/**
+ * @brief Write a device register.
+ * @param dev - The IIO device structure.
+ * @param reg - Register address.
+ * @param writeval - Register value.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int adas1000_iio_write_reg(void *dev, uint32_t reg, uint32_t writeval)
+{
+	struct adas1000_iio_dev *desc = dev;
+
+	return adas1000_write(desc->adas1000_dev, reg, writeval);
+}
+
+/**
+ * @brief Get the output sampling frequency, the frame rate divided by the
+ *	  decimation.
+ * @param dev - The IIO device structure.
+ * @param buf - Output buffer.
+ * @param len - Length of the output buffer.
+ * @param channel - IIO channel information.
+ * @param priv - Attribute private ID.
+ * @return Number of bytes printed in the output buffer, or negative error code.
+ */
+static int adas1000_iio_get_sampling_freq(void *dev, char *buf, uint32_t len,
+		const struct iio_ch_info *channel, intptr_t priv)
+{
+	struct adas1000_iio_dev *desc = dev;
+	uint32_t decimation = desc->stream_param.decimation ?
+			      desc->stream_param.decimation : 1;
+	uint64_t rate_mhz;
+
+	/* The 31.25 Hz frame rate is stored in hundredths of Hz */
+	if (desc->adas1000_dev->frame_rate == ADAS1000_31_25HZ_FRAME_RATE)
+		rate_mhz = ADAS1000_31_25HZ_FRAME_RATE * 10ull;
+	else
+		rate_mhz = desc->adas1000_dev->frame_rate * 1000ull;
+	rate_mhz /= decimation;
+
+	return snprintf(buf, len, "%"PRIu32".%03"PRIu32,
+			(uint32_t)(rate_mhz / 1000), (uint32_t)(rate_mhz % 1000));
+}
+
+/**
+ * @brief Get the number of frames averaged into one sample.
+ * @param dev - The IIO device structure.
+ * @param buf - Output buffer.
+ * @param len - Length of the output buffer.
+ * @param channel - IIO channel information.
+ * @param priv - Attribute private ID.
+ * @return Number of bytes printed in the output buffer, or negative error code.
+ */
+static int adas1000_iio_get_decimation(void *dev, char *buf, uint32_t len,
+				       const struct iio_ch_info *channel, intptr_t priv)
+{
+	struct adas1000_iio_dev *desc = dev;
+
+	return snprintf(buf, len, "%"PRIu32,
+			desc->stream_param.decimation ? desc->stream_param.decimation : 1);
+}
+
+/**
+ * @brief Set the number of frames averaged into one sample. The frames read
+ *	  by each transfer follow the decimation, unless set at initialization.
+ * @param dev - The IIO device structure.
+ * @param buf - Input buffer.
+ * @param len - Length of the input buffer.
+ * @param channel - IIO channel information.
+ * @param priv - Attribute private ID.
+ * @return Number of bytes read from the input buffer, or negative error code.
+ */
+static int adas1000_iio_set_decimation(void *dev, char *buf, uint32_t len,
+				       const struct iio_ch_info *channel, intptr_t priv)
+{
+	struct adas1000_iio_dev *desc = dev;
+	uint32_t decimation;
+
+	if (desc->adas1000_dev->stream.active)
+		return -EBUSY;
+
+	decimation = no_os_str_to_uint32(buf);
+	if (!decimation || decimation > ADAS1000_STREAM_MAX_DECIMATION)
+		return -EINVAL;
+
+	desc->stream_param.decimation = decimation;
+
+	return len;
+}
+
+/**
+ * @brief Get a frame streaming statistic.
+ * @param dev - The IIO device structure.
+ * @param buf - Output buffer.
+ * @param len - Length of the output buffer.
+ * @param channel - IIO channel information.
+ * @param priv - Statistic identifier.
+ * @return Number of bytes printed in the output buffer, or negative error code.
+ */
+static int adas1000_iio_get_stat(void *dev, char *buf, uint32_t len,
+				 const struct iio_ch_info *channel, intptr_t priv)
+{
+	struct adas1000_stream *stream = &((struct adas1000_iio_dev *)dev)->adas1000_dev->stream;
+	uint32_t val;
+
+	switch (priv) {
+	case ADAS1000_IIO_VALID_FRAMES:
+		val = stream->valid_frames;
+		break;
+	case ADAS1000_IIO_MARKER_ERRORS:
+		val = stream->marker_errors;
+		break;
+	case ADAS1000_IIO_CRC_ERRORS:
+		val = stream->crc_errors;
+		break;
+	case ADAS1000_IIO_NOT_READY:
+		val = stream->not_ready;
+		break;
+	case ADAS1000_IIO_MISSED:
+		val = stream->missed;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	return snprintf(buf, len, "%"PRIu32, val);
+}
+
+/**
+ * @brief Start the frame stream.
+ * @param dev - The IIO device structure.
+ * @param mask - Active channels mask.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int adas1000_iio_pre_enable(void *dev, uint32_t mask)
+{
+	struct adas1000_iio_dev *desc = dev;
+	struct adas1000_stream *stream = &desc->adas1000_dev->stream;
+	uint32_t configured = 0;
+	uint8_t i;
+	int ret;
+
+	ret = adas1000_stream_start(desc->adas1000_dev, &desc->stream_param);
+	if (ret)
+		return ret;
+
+	for (i = 0; i < stream->nb_leads; i++)
+		configured |= NO_OS_BIT(stream->leads[i]);
+
+	/* Leads removed from the frame can't be captured */
+	if (mask & ~configured) {
+		ret = -EINVAL;
+		goto error;
+	}
+
+	desc->samples = no_os_calloc(NO_OS_DIV_ROUND_UP(stream->frames,
+					stream->decimation) * stream->nb_leads,
+				     sizeof(*desc->samples));
+	if (!desc->samples) {
+		ret = -ENOMEM;
+		goto error;
+	}
+	desc->avail = 0;
+	desc->pos = 0;
+
+	return 0;
+error:
+	adas1000_stream_stop(desc->adas1000_dev);
+
+	return ret;
+}
+
+/**
+ * @brief Stop the frame stream.
+ * @param dev - The IIO device structure.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int adas1000_iio_post_disable(void *dev)
+{
+	struct adas1000_iio_dev *desc = dev;
+
+	no_os_free(desc->samples);
+	desc->samples = NULL;
+
+	return adas1000_stream_stop(desc->adas1000_dev);
+}
+
+/**
+ * @brief Fill the IIO buffer with decimated lead samples. The samples left
+ *	  over by a request are used by the next one.
+ * @param iio_dev_data - IIO device data.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int adas1000_iio_submit(struct iio_device_data *iio_dev_data)
+{
+	struct adas1000_iio_dev *desc = iio_dev_data->dev;
+	struct adas1000_stream *stream = &desc->adas1000_dev->stream;
+	uint32_t mask = iio_dev_data->buffer->active_mask;
+	int32_t scan[ADAS1000_NUM_LEADS];
+	uint32_t i, timeout;
+	int32_t *sample;
+	uint8_t k, n;
+	bool ready;
+	int ret;
+
+	for (i = 0; i < iio_dev_data->buffer->samples; i++) {
+		while (desc->pos == desc->avail) {
+			timeout = ADAS1000_IIO_STREAM_TIMEOUT;
+			do {
+				ret = adas1000_stream_ready(desc->adas1000_dev, &ready);
+				if (ret)
+					return ret;
+				if (ready)
+					break;
+				no_os_mdelay(1);
+			} while (--timeout);
+			if (!ready)
+				return -ETIMEDOUT;
+
+			ret = adas1000_stream_read(desc->adas1000_dev, desc->samples,
+						   &desc->avail);
+			if (ret)
+				return ret;
+			desc->pos = 0;
+		}
+
+		sample = &desc->samples[desc->pos++ * stream->nb_leads];
+		for (k = 0, n = 0; k < stream->nb_leads; k++)
+			if (mask & NO_OS_BIT(stream->leads[k]))
+				scan[n++] = sample[k];
+
+		ret = iio_buffer_push_scan(iio_dev_data->buffer, scan);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+static struct iio_attribute adas1000_iio_attrs[] = {
+	{
+		.name = "sampling_frequency",
+		.show = adas1000_iio_get_sampling_freq,
+	},
+	{
+		.name = "decimation",
+		.show = adas1000_iio_get_decimation,
+		.store = adas1000_iio_set_decimation,
+	},
+	END_ATTRIBUTES_ARRAY
+};
+
+static struct iio_attribute adas1000_iio_debug_attrs[] = {
+	{
+		.name = "valid_frames",
+		.show = adas1000_iio_get_stat,
+		.priv = ADAS1000_IIO_VALID_FRAMES,
+	},
+	{
+		.name = "marker_errors",
+		.show = adas1000_iio_get_stat,
+		.priv = ADAS1000_IIO_MARKER_ERRORS,
+	},
+	{
+		.name = "crc_errors",
+		.show = adas1000_iio_get_stat,
+		.priv = ADAS1000_IIO_CRC_ERRORS,
+	},
+	{
+		.name = "not_ready_frames",
+		.show = adas1000_iio_get_stat,
+		.priv = ADAS1000_IIO_NOT_READY,
+	},
+	{
+		.name = "missed_frames",
+		.show = adas1000_iio_get_stat,
+		.priv = ADAS1000_IIO_MISSED,
+	},
+	END_ATTRIBUTES_ARRAY
+};
+
+/**
+ * @brief Initializes the ADAS1000 IIO driver. The scan type of the lead
+ *	  channels follows the frame rate and data format configured at this
+ *	  point.
+ * @param iio_dev - The IIO device structure.
+ * @param init_param - The structure that contains the device initial
+ *		       parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int adas1000_iio_init(struct adas1000_iio_dev **iio_dev,
+		      struct adas1000_iio_dev_init_param *init_param)
+{
+	struct adas1000_iio_dev *desc;
+	uint32_t frm_ctrl;
+	uint8_t i;
+	int ret;
+
+	if (!iio_dev || !init_param || !init_param->adas1000_dev_init)
+		return -EINVAL;
+
+	if (init_param->stream_param.decimation > ADAS1000_STREAM_MAX_DECIMATION)
+		return -EINVAL;
+
+	desc = no_os_calloc(1, sizeof(*desc));
+	if (!desc)
+		return -ENOMEM;
+
+	ret = adas1000_init(&desc->adas1000_dev, init_param->adas1000_dev_init);
+	if (ret)
+		goto error_dev;
+
+	ret = adas1000_read(desc->adas1000_dev, ADAS1000_FRMCTL, &frm_ctrl);
+	if (ret)
+		goto error_init;
+
+	desc->stream_param = init_param->stream_param;
+
+	desc->scan_type.sign = (frm_ctrl & ADAS1000_FRMCTL_DATAFMT) ? 's' : 'u';
+	desc->scan_type.realbits =
+		desc->adas1000_dev->frame_rate == ADAS1000_128KHZ_FRAME_RATE ? 16 : 24;
+	desc->scan_type.storagebits = 32;
+
+	for (i = 0; i < ADAS1000_NUM_LEADS; i++) {
+		desc->channels[i] = (struct iio_channel) {
+			.name = adas1000_iio_lead_names[i],
+			.ch_type = IIO_VOLTAGE,
+			.channel = i,
+			.scan_index = i,
+			.scan_type = &desc->scan_type,
+			.indexed = true,
+		};
+	}
+
+	desc->iio_dev_desc = (struct iio_device) {
+		.num_ch = ADAS1000_NUM_LEADS,
+		.channels = desc->channels,
+		.attributes = adas1000_iio_attrs,
+		.debug_attributes = adas1000_iio_debug_attrs,
+		.pre_enable = adas1000_iio_pre_enable,
+		.post_disable = adas1000_iio_post_disable,
+		.submit = adas1000_iio_submit,
+		.debug_reg_read = adas1000_iio_read_reg,
+		.debug_reg_write = adas1000_iio_write_reg,
+	};
+	desc->iio_dev = &desc->iio_dev_desc;
+
+	*iio_dev = desc;
+
+	return 0;
+
+error_init:
+	adas1000_remove(desc->adas1000_dev);
+error_dev:
+	no_os_free(desc);
+
+	return ret;
+}
+
+/**
+ * @brief Free the resources allocated by adas1000_iio_init().
+ * @param desc - The IIO device structure.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int adas1000_iio_remove(struct adas1000_iio_dev *desc)
+{
+	int ret;
+
+	if (!desc)
+		return -EINVAL;
+
+	ret = adas1000_remove(desc->adas1000_dev);
+	if (ret)
+		return ret;
+
+	no_os_free(desc->samples);
+	no_os_free(desc);
+
+	return 0;
+}
@@ -0,0 +1,66 @@
+/***************************************************************************//**
+ *   @file   iio_adas1000.h
+ *   @brief  Header file of the ADAS1000 IIO driver.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef IIO_ADAS1000_H
+#define IIO_ADAS1000_H
+
+#include "iio.h"
+#include "adas1000.h"
+
+struct adas1000_iio_dev {
+	struct adas1000_dev *adas1000_dev;
+	struct iio_device *iio_dev;
+	/** Frame streaming parameters used when the buffer is enabled */
+	struct adas1000_stream_param stream_param;
+	/** Decimated lead samples of the last block */
+	int32_t *samples;
+	/** Samples of the last block */
+	uint32_t avail;
+	/** Next sample of the last block to be pushed */
+	uint32_t pos;
+	struct scan_type scan_type;
+	struct iio_channel channels[ADAS1000_NUM_LEADS];
+	struct iio_device iio_dev_desc;
+};
+
+struct adas1000_iio_dev_init_param {
+	struct adas1000_init_param *adas1000_dev_init;
+	/** Frame streaming parameters, the decimation may also be changed
+	 *  through the decimation attribute. */
+	struct adas1000_stream_param stream_param;
+};
+
+int adas1000_iio_init(struct adas1000_iio_dev **iio_dev,
+		      struct adas1000_iio_dev_init_param *init_param);
+
+int adas1000_iio_remove(struct adas1000_iio_dev *desc);
+
+#endif /** IIO_ADAS1000_H */
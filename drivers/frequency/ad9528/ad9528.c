@@ -713,7 +713,7 @@ int32_t ad9528_setup(struct ad9528_dev **device,
 	uint32_t pll2_ndiv, pll2_ndiv_a_cnt, pll2_ndiv_b_cnt;
 	struct ad9528_dev *dev;
 	struct no_os_clk_desc **clocks = NULL;
-	struct no_os_clk_init_param clk_init;
+	struct no_os_clk_init_param clk_init = { 0 };
 	const char *names[AD9528_NUM_CHAN] = {
 		"ad9528-1_out0", "ad9528-1_out1", "ad9528-1_out2", "ad9528-1_out3", "ad9528-1_out4",
 		"ad9528-1_out5", "ad9528-1_out6", "ad9528-1_out7", "ad9528-1_out8", "ad9528-1_out9",
@@ -743,6 +743,7 @@ int32_t ad9528_setup(struct ad9528_dev **device,
 			clk_init.hw_ch_num = i;
 			clk_init.platform_ops = &ad9528_no_os_clk_ops;
 			clk_init.dev_desc = dev;
+			clk_init.flags = NO_OS_CLK_CACHE_RATE;
 
 			ret = no_os_clk_init(&clocks[i], &clk_init);
 			if (ret) {
@@ -1239,11 +1240,12 @@ int32_t ad9528_clk_set_rate(struct ad9528_dev *dev, uint32_t chan,
 		ret = ad9528_spi_write_n(dev,
 					 AD9528_SYSREF_K_DIVIDER,
 					 AD9528_SYSREF_K_DIV(tmp));
+		if (ret)
+			return ret;
 
-		if (!ret)
-			dev->ad9528_st.vco_out_freq[AD9528_SYSREF] =
-				NO_OS_DIV_ROUND_CLOSEST(dev->ad9528_st.sysref_src_pll2,
-							tmp);
+		dev->ad9528_st.vco_out_freq[AD9528_SYSREF] =
+			NO_OS_DIV_ROUND_CLOSEST(dev->ad9528_st.sysref_src_pll2,
+						tmp);
 
 		ret = ad9528_io_update(dev);
 		if (ret)
@@ -1276,6 +1278,10 @@ int32_t ad9528_clk_set_rate(struct ad9528_dev *dev, uint32_t chan,
 		return ret;
 
 out:
+	/* The SYSREF divider is shared, drop the cached rate of every output */
+	for (tmp = 0; dev->clk_desc && tmp < AD9528_NUM_CHAN; tmp++)
+		no_os_clk_invalidate_rate(dev->clk_desc[tmp]);
+
 	return 0;
 }
 
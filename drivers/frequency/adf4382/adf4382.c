@@ -32,6 +32,7 @@
  * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 *******************************************************************************/
 
+#include <string.h>
 #include "adf4382.h"
 #include "no_os_alloc.h"
 #include "no_os_delay.h"
@@ -59,6 +60,22 @@ static const int adf4382_ci_ua[] = {
 	11100
 };
 
+/**
+ * @struct adf4382_freq_words
+ * @brief Register values that depend on the output frequency.
+ */
+struct adf4382_freq_words {
+	uint32_t frac1_word;
+	uint32_t frac2_word;
+	uint32_t mod2_word;
+	uint16_t n_int;
+	uint16_t bleed_word;
+	uint8_t clkout_div;
+	uint8_t ldwin_pw;
+	uint8_t int_mode;
+	uint8_t en_bleed;
+};
+
 /**
  * @brief Writes data to ADF4382 over SPI.
  * @param dev	   - The device structure.
@@ -1103,11 +1120,13 @@ int adf4382_set_change_rfout(struct adf4382_dev *dev, uint64_t val)
 /**
  * @brief Computes the optimized bleed word value for the PLL in fractional mode.
  * @param dev 	     - The device structure.
+ * @param freq 	     - The output frequency.
  * @param pfd_freq   - Phase detector frequency.
+ * @param bleed_word - Computed bleed word, which will be returned.
  * @return 	     - 0 in case of success or negative error code.
  */
-static int adf4382_bleed_word_compute(struct adf4382_dev *dev,
-				      uint64_t pfd_freq)
+static int adf4382_bleed_word_compute(struct adf4382_dev *dev, uint64_t freq,
+				      uint64_t pfd_freq, uint16_t *bleed_word)
 {
 	uint32_t coars_bleed;
 	uint16_t bleed_delay = 0;
@@ -1121,13 +1140,13 @@ static int adf4382_bleed_word_compute(struct adf4382_dev *dev,
 
 	/* Computes the bleed delay based on rfout frequency in SDM MODE 0.
 	See Product DataSheet for more details. */
-	if (dev->freq < 1800000000UL)
+	if (freq < 1800000000UL)
 		bleed_delay = 3600;
-	else if (dev->freq < 4000000000)
+	else if (freq < 4000000000)
 		bleed_delay = 1000;
-	else if (dev->freq < 10000000000UL)
+	else if (freq < 10000000000UL)
 		bleed_delay = 625;
-	else if (dev->freq >= 10000000000UL)
+	else if (freq >= 10000000000UL)
 		bleed_delay = 300;
 
 	bleed_i = bleed_delay * pfd_freq * adf4382_ci_ua[dev->cp_i];
@@ -1138,34 +1157,31 @@ static int adf4382_bleed_word_compute(struct adf4382_dev *dev,
 	fine_bleed = NO_OS_DIV_ROUND_UP(fine_bleed, ADF4382_FINE_BLEED_CONST_2);
 	bleed_word_tmp = coars_bleed << 9 | fine_bleed;
 	bleed_word_tmp = no_os_clamp(bleed_word_tmp, 1, 8191);
-	dev->bleed_word = bleed_word_tmp;
+	*bleed_word = bleed_word_tmp;
 	return 0;
 }
 
 /**
- * @brief Set the output frequency. This will set the required registers to
- * device but skip NDIV value, to be written separately. This Function will not
- * start autocalibration until REG0010 is written.
- * @param dev 	- The device structure.
- * @return    	- 0 in case of success, negative error code otherwise.
+ * @brief Computes the divider, fractional and lock detector values needed for
+ * an output frequency, without accessing the device registers they go to.
+ * @param dev 	     - The device structure.
+ * @param freq 	     - The output frequency.
+ * @param pfd_freq   - Phase detector frequency.
+ * @param words      - Computed values, which will be returned.
+ * @return 	     - 0 in case of success or negative error code.
  */
-int adf4382_set_change_freq(struct adf4382_dev *dev)
+static int adf4382_freq_words_compute(struct adf4382_dev *dev, uint64_t freq,
+				      uint64_t pfd_freq,
+				      struct adf4382_freq_words *words)
 {
-	uint32_t frac2_word;
-	uint32_t frac1_word;
-	uint32_t mod2_word;
-	uint8_t clkout_div;
-	uint64_t pfd_freq;
-	uint8_t ldwin_pw = 0;
-	uint8_t en_bleed;
-	uint16_t n_int;
-	uint64_t tmp;
 	uint64_t vco = 0;
-	uint8_t val;
+	uint64_t tmp;
 	int ret;
 
-	for (clkout_div = 0; clkout_div <= dev->clkout_div_reg_val_max; clkout_div++) {
-		tmp = (1 << clkout_div) * dev->freq;
+	for (words->clkout_div = 0;
+	     words->clkout_div <= dev->clkout_div_reg_val_max;
+	     words->clkout_div++) {
+		tmp = (1 << words->clkout_div) * freq;
 		if (tmp < dev->vco_min || tmp > dev->vco_max)
 			continue;
 
@@ -1178,48 +1194,77 @@ int adf4382_set_change_freq(struct adf4382_dev *dev)
 		return -EINVAL;
 	}
 
-	//Calculates the PFD freq. the output will be in Hz
-	pfd_freq = adf4382_pfd_compute(dev);
-
-	ret = adf4382_pll_fract_n_compute(dev, dev->freq, pfd_freq, &n_int,
-					  &frac1_word, &frac2_word, &mod2_word);
+	ret = adf4382_pll_fract_n_compute(dev, freq, pfd_freq, &words->n_int,
+					  &words->frac1_word, &words->frac2_word,
+					  &words->mod2_word);
 	if (ret)
 		return ret;
 
-	if (frac1_word || frac2_word) {
-		en_bleed = 1;
+	words->ldwin_pw = 0;
+	words->bleed_word = dev->bleed_word;
+
+	if (words->frac1_word || words->frac2_word) {
+		words->int_mode = 0;
+		words->en_bleed = 1;
+
+		/*The lock detector pulse window is determined based on the
+		PFD frequency as described in the datasheet*/
 		if (pfd_freq <= 40 * MHZ) {
-			ldwin_pw = 7;
+			words->ldwin_pw = 7;
 		} else if (pfd_freq <= 50 * MHZ) {
-			ldwin_pw = 6;
+			words->ldwin_pw = 6;
 		} else if (pfd_freq <= 100 * MHZ) {
-			ldwin_pw = 5;
+			words->ldwin_pw = 5;
 		} else if (pfd_freq <= 200 * MHZ) {
-			ldwin_pw = 4;
+			words->ldwin_pw = 4;
 		} else if (pfd_freq <= 250 * MHZ) {
-			if (dev->freq >= 5000U * MHZ &&
-			    dev->freq < 6400U * MHZ) {
-				ldwin_pw = 3;
-			} else {
-				ldwin_pw = 2;
-			}
+			if (freq >= 5000U * MHZ && freq < 6400U * MHZ)
+				words->ldwin_pw = 3;
+			else
+				words->ldwin_pw = 2;
 		}
-		ret = adf4382_bleed_word_compute(dev, pfd_freq);
-		if (ret)
-			return ret;
-	} else {
-		en_bleed = 0;
-
-		tmp = NO_OS_DIV_ROUND_UP(pfd_freq, MICROAMPER_PER_AMPER);
-		tmp *= adf4382_ci_ua[dev->cp_i];
-		tmp = NO_OS_DIV_ROUND_UP(dev->bleed_word, tmp);
-		if (tmp <= 85)
-			ldwin_pw = 0;
-		else
-			ldwin_pw = 1;
+
+		return adf4382_bleed_word_compute(dev, freq, pfd_freq,
+						  &words->bleed_word);
 	}
 
-	if (frac2_word) {
+	words->int_mode = 1;
+	words->en_bleed = 0;
+
+	tmp = NO_OS_DIV_ROUND_UP(pfd_freq, MICROAMPER_PER_AMPER);
+	tmp *= adf4382_ci_ua[dev->cp_i];
+	tmp = NO_OS_DIV_ROUND_UP(words->bleed_word, tmp);
+	if (tmp <= 85)
+		words->ldwin_pw = 0;
+	else
+		words->ldwin_pw = 1;
+
+	return 0;
+}
+
+/**
+ * @brief Set the output frequency. This will set the required registers to
+ * device but skip NDIV value, to be written separately. This Function will not
+ * start autocalibration until REG0010 is written.
+ * @param dev 	- The device structure.
+ * @return    	- 0 in case of success, negative error code otherwise.
+ */
+int adf4382_set_change_freq(struct adf4382_dev *dev)
+{
+	struct adf4382_freq_words words;
+	uint64_t pfd_freq;
+	uint8_t val;
+	int ret;
+
+	//Calculates the PFD freq. the output will be in Hz
+	pfd_freq = adf4382_pfd_compute(dev);
+
+	ret = adf4382_freq_words_compute(dev, dev->freq, pfd_freq, &words);
+	if (ret)
+		return ret;
+	dev->bleed_word = words.bleed_word;
+
+	if (words.frac2_word) {
 		ret = adf4382_spi_update_bits(dev, 0x28, ADF4382_VAR_MOD_EN_MSK,
 					      0xff);
 		if (ret)
@@ -1244,72 +1289,72 @@ int adf4382_set_change_freq(struct adf4382_dev *dev)
 
 	ret = adf4382_spi_update_bits(dev, 0x1F, ADF4382_EN_BLEED_MSK,
 				      no_os_field_prep(ADF4382_EN_BLEED_MSK,
-						      en_bleed));
+						      words.en_bleed));
 	if (ret)
 		return ret;
 
-	val = mod2_word & ADF4382_MOD2WORD_LSB_MSK;
+	val = words.mod2_word & ADF4382_MOD2WORD_LSB_MSK;
 	ret = adf4382_spi_write(dev, 0x1A, val);
 	if (ret)
 		return ret;
-	val = (mod2_word >> 8) & ADF4382_MOD2WORD_MID_MSK;
+	val = (words.mod2_word >> 8) & ADF4382_MOD2WORD_MID_MSK;
 	ret = adf4382_spi_write(dev, 0x1B, val);
 	if (ret)
 		return ret;
-	val = (mod2_word >> 16) & ADF4382_MOD2WORD_MSB_MSK;
+	val = (words.mod2_word >> 16) & ADF4382_MOD2WORD_MSB_MSK;
 	ret = adf4382_spi_write(dev, 0x1C, val);
 	if (ret)
 		return ret;
 
-	val = frac2_word  & ADF4382_FRAC2WORD_LSB_MSK;
+	val = words.frac2_word  & ADF4382_FRAC2WORD_LSB_MSK;
 	ret = adf4382_spi_write(dev, 0x17, val);
 	if (ret)
 		return ret;
-	val = (frac2_word >> 8)  & ADF4382_FRAC2WORD_MID_MSK;
+	val = (words.frac2_word >> 8)  & ADF4382_FRAC2WORD_MID_MSK;
 	ret = adf4382_spi_write(dev, 0x18, val);
 	if (ret)
 		return ret;
-	val = (frac2_word >> 16) & ADF4382_FRAC2WORD_MSB_MSK;
+	val = (words.frac2_word >> 16) & ADF4382_FRAC2WORD_MSB_MSK;
 	ret = adf4382_spi_write(dev, 0x19, val);
 	if (ret)
 		return ret;
 
-	val = frac1_word  & ADF4382_FRAC1WORD_LSB_MSK;
+	val = words.frac1_word  & ADF4382_FRAC1WORD_LSB_MSK;
 	ret = adf4382_spi_write(dev, 0x12, val);
 	if (ret)
 		return ret;
-	val = (frac1_word >> 8)  & ADF4382_FRAC1WORD_MID_MSK;
+	val = (words.frac1_word >> 8)  & ADF4382_FRAC1WORD_MID_MSK;
 	ret = adf4382_spi_write(dev, 0x13, val);
 	if (ret)
 		return ret;
-	val = (frac1_word >> 16) & ADF4382_FRAC1WORD_MSB_MSK;
+	val = (words.frac1_word >> 16) & ADF4382_FRAC1WORD_MSB_MSK;
 	ret = adf4382_spi_write(dev, 0x14, val);
 	if (ret)
 		return ret;
 
-	val = (frac1_word >> 24) & ADF4382_FRAC1WORD_MSB;
+	val = (words.frac1_word >> 24) & ADF4382_FRAC1WORD_MSB;
 	ret = adf4382_spi_update_bits(dev, 0x15, ADF4382_FRAC1WORD_MSB, val);
 	if (ret)
 		return ret;
 
 	ret = adf4382_spi_update_bits(dev, 0x2C, ADF4382_LDWIN_PW_MSK,
 				      no_os_field_prep(ADF4382_LDWIN_PW_MSK,
-						      ldwin_pw));
+						      words.ldwin_pw));
 	if (ret)
 		return ret;
 
 	ret = adf4382_spi_update_bits(dev, 0x11, ADF4382_CLKOUT_DIV_MSK,
 				      no_os_field_prep(ADF4382_CLKOUT_DIV_MSK,
-						      clkout_div));
+						      words.clkout_div));
 	if (ret)
 		return ret;
 
-	val = (n_int >> 8) & ADF4382_N_INT_MSB_MSK;
+	val = (words.n_int >> 8) & ADF4382_N_INT_MSB_MSK;
 	ret = adf4382_spi_update_bits(dev, 0x11, ADF4382_N_INT_MSB_MSK, val);
 	if (ret)
 		return ret;
 	// Need to store N_INT to trigger an auto-calibration in another function
-	dev->n_int = n_int;
+	dev->n_int = words.n_int;
 
 	return 0;
 }
@@ -1346,23 +1391,17 @@ int adf4382_set_start_calibration(struct adf4382_dev *dev)
  */
 int adf4382_set_freq(struct adf4382_dev *dev)
 {
-	uint32_t frac2_word;
-	uint32_t frac1_word;
-	uint32_t mod2_word;
-	uint8_t clkout_div;
+	struct adf4382_freq_words words;
 	uint8_t dclk_div1;
 	uint64_t pfd_freq;
-	uint8_t ldwin_pw = 0;
-	uint8_t int_mode;
-	uint8_t en_bleed;
 	uint8_t locked;
-	uint16_t n_int;
 	uint8_t div1;
 	uint64_t tmp;
-	uint64_t vco = 0;
 	uint8_t val;
 	int ret;
 
+	dev->configured = false;
+
 	val = no_os_field_prep(ADF4382_EN_RDBLR_MSK, dev->ref_doubler_en) |
 	      no_os_field_prep(ADF4382_R_DIV_MSK, dev->ref_div);
 	ret = adf4382_spi_update_bits(dev, 0x20,
@@ -1371,20 +1410,6 @@ int adf4382_set_freq(struct adf4382_dev *dev)
 	if (ret)
 		return ret;
 
-	for (clkout_div = 0; clkout_div <= dev->clkout_div_reg_val_max; clkout_div++) {
-		tmp = (1 << clkout_div) * dev->freq;
-		if (tmp < dev->vco_min || tmp > dev->vco_max)
-			continue;
-
-		vco = tmp;
-		break;
-	}
-
-	if (!vco) {
-		pr_err("VCO is 0\n");
-		return -EINVAL;
-	}
-
 	//Calculates the PFD freq. the output will be in Hz
 	pfd_freq = adf4382_pfd_compute(dev);
 
@@ -1394,52 +1419,12 @@ int adf4382_set_freq(struct adf4382_dev *dev)
 	if (ret)
 		return ret;
 
-	ret = adf4382_pll_fract_n_compute(dev, dev->freq, pfd_freq, &n_int,
-					  &frac1_word, &frac2_word, &mod2_word);
+	ret = adf4382_freq_words_compute(dev, dev->freq, pfd_freq, &words);
 	if (ret)
 		return ret;
+	dev->bleed_word = words.bleed_word;
 
-	if (frac1_word || frac2_word) {
-		int_mode = 0;
-		en_bleed = 1;
-
-		/*The lock detector pulse window is determined based on the
-		PFD frequency as described in the datasheet*/
-		if (pfd_freq <= 40 * MHZ) {
-			ldwin_pw = 7;
-		} else if (pfd_freq <= 50 * MHZ) {
-			ldwin_pw = 6;
-		} else if (pfd_freq <= 100 * MHZ) {
-			ldwin_pw = 5;
-		} else if (pfd_freq <= 200 * MHZ) {
-			ldwin_pw = 4;
-		} else if (pfd_freq <= 250 * MHZ) {
-			if (dev->freq >= 5000U * MHZ &&
-			    dev->freq < 6400U * MHZ) {
-				ldwin_pw = 3;
-			} else {
-				ldwin_pw = 2;
-			}
-		}
-
-		ret = adf4382_bleed_word_compute(dev, pfd_freq);
-		if (ret)
-			return ret;
-
-	} else {
-		int_mode = 1;
-		en_bleed = 0;
-
-		tmp = NO_OS_DIV_ROUND_UP(pfd_freq, MICROAMPER_PER_AMPER);
-		tmp *= adf4382_ci_ua[dev->cp_i];
-		tmp = NO_OS_DIV_ROUND_UP(dev->bleed_word, tmp);
-		if (tmp <= 85)
-			ldwin_pw = 0;
-		else
-			ldwin_pw = 1;
-	}
-
-	if (frac2_word) {
+	if (words.frac2_word) {
 		ret = adf4382_spi_update_bits(dev, 0x28, ADF4382_VAR_MOD_EN_MSK,
 					      0xff);
 		if (ret)
@@ -1453,7 +1438,7 @@ int adf4382_set_freq(struct adf4382_dev *dev)
 
 	ret = adf4382_spi_update_bits(dev, 0x15, ADF4382_INT_MODE_MSK,
 				      no_os_field_prep(ADF4382_INT_MODE_MSK,
-						      int_mode));
+						      words.int_mode));
 	if (ret)
 		return ret;
 
@@ -1470,50 +1455,50 @@ int adf4382_set_freq(struct adf4382_dev *dev)
 
 	ret = adf4382_spi_update_bits(dev, 0x1F, ADF4382_EN_BLEED_MSK,
 				      no_os_field_prep(ADF4382_EN_BLEED_MSK,
-						      en_bleed));
+						      words.en_bleed));
 	if (ret)
 		return ret;
 
-	val = mod2_word & ADF4382_MOD2WORD_LSB_MSK;
+	val = words.mod2_word & ADF4382_MOD2WORD_LSB_MSK;
 	ret = adf4382_spi_write(dev, 0x1A, val);
 	if (ret)
 		return ret;
-	val = (mod2_word >> 8) & ADF4382_MOD2WORD_MID_MSK;
+	val = (words.mod2_word >> 8) & ADF4382_MOD2WORD_MID_MSK;
 	ret = adf4382_spi_write(dev, 0x1B, val);
 	if (ret)
 		return ret;
-	val = (mod2_word >> 16) & ADF4382_MOD2WORD_MSB_MSK;
+	val = (words.mod2_word >> 16) & ADF4382_MOD2WORD_MSB_MSK;
 	ret = adf4382_spi_write(dev, 0x1C, val);
 	if (ret)
 		return ret;
 
-	val = frac2_word  & ADF4382_FRAC2WORD_LSB_MSK;
+	val = words.frac2_word  & ADF4382_FRAC2WORD_LSB_MSK;
 	ret = adf4382_spi_write(dev, 0x17, val);
 	if (ret)
 		return ret;
-	val = (frac2_word >> 8)  & ADF4382_FRAC2WORD_MID_MSK;
+	val = (words.frac2_word >> 8)  & ADF4382_FRAC2WORD_MID_MSK;
 	ret = adf4382_spi_write(dev, 0x18, val);
 	if (ret)
 		return ret;
-	val = (frac2_word >> 16) & ADF4382_FRAC2WORD_MSB_MSK;
+	val = (words.frac2_word >> 16) & ADF4382_FRAC2WORD_MSB_MSK;
 	ret = adf4382_spi_write(dev, 0x19, val);
 	if (ret)
 		return ret;
 
-	val = frac1_word  & ADF4382_FRAC1WORD_LSB_MSK;
+	val = words.frac1_word  & ADF4382_FRAC1WORD_LSB_MSK;
 	ret = adf4382_spi_write(dev, 0x12, val);
 	if (ret)
 		return ret;
-	val = (frac1_word >> 8)  & ADF4382_FRAC1WORD_MID_MSK;
+	val = (words.frac1_word >> 8)  & ADF4382_FRAC1WORD_MID_MSK;
 	ret = adf4382_spi_write(dev, 0x13, val);
 	if (ret)
 		return ret;
-	val = (frac1_word >> 16) & ADF4382_FRAC1WORD_MSB_MSK;
+	val = (words.frac1_word >> 16) & ADF4382_FRAC1WORD_MSB_MSK;
 	ret = adf4382_spi_write(dev, 0x14, val);
 	if (ret)
 		return ret;
 
-	val = (frac1_word >> 24) & ADF4382_FRAC1WORD_MSB;
+	val = (words.frac1_word >> 24) & ADF4382_FRAC1WORD_MSB;
 	ret = adf4382_spi_update_bits(dev, 0x15, ADF4382_FRAC1WORD_MSB, val);
 	if (ret)
 		return ret;
@@ -1565,27 +1550,29 @@ int adf4382_set_freq(struct adf4382_dev *dev)
 
 	ret = adf4382_spi_update_bits(dev, 0x2C, ADF4382_LDWIN_PW_MSK,
 				      no_os_field_prep(ADF4382_LDWIN_PW_MSK,
-						      ldwin_pw));
+						      words.ldwin_pw));
 	if (ret)
 		return ret;
 
 	ret = adf4382_spi_update_bits(dev, 0x11, ADF4382_CLKOUT_DIV_MSK,
 				      no_os_field_prep(ADF4382_CLKOUT_DIV_MSK,
-						      clkout_div));
+						      words.clkout_div));
 	if (ret)
 		return ret;
 
-	val = (n_int >> 8) & ADF4382_N_INT_MSB_MSK;
+	val = (words.n_int >> 8) & ADF4382_N_INT_MSB_MSK;
 	ret = adf4382_spi_update_bits(dev, 0x11, ADF4382_N_INT_MSB_MSK, val);
 	if (ret)
 		return ret;
 
 	// Need to set N_INT last to trigger an auto-calibration
-	val = n_int & ADF4382_N_INT_LSB_MSK;
+	val = words.n_int & ADF4382_N_INT_LSB_MSK;
 	ret = adf4382_spi_write(dev, 0x10, val);
 	if (ret)
 		return ret;
 
+	dev->configured = true;
+
 	no_os_udelay(ADF4382_LKD_DELAY_US);
 	ret = adf4382_spi_read(dev, 0x58, &val);
 	if (ret)
@@ -1598,6 +1585,311 @@ int adf4382_set_freq(struct adf4382_dev *dev)
 	return 0;
 }
 
+/**
+ * @brief Transfers a block of registers in a single SPI streaming transaction.
+ * The address is decremented after each data byte, so the block goes from
+ * reg_addr down to reg_addr - len + ADF4382_SPI_CMD_SIZE_BYTES + 1.
+ * @param dev 	   - The device structure.
+ * @param cmd 	   - Read or write command, including the first register address.
+ * @param buff 	   - Command bytes followed by the register values.
+ * @param len 	   - Size of the buffer, including the command bytes.
+ * @return 	   - 0 in case of success or negative error code otherwise.
+ */
+static int adf4382_spi_stream(struct adf4382_dev *dev, uint16_t cmd,
+			      uint8_t *buff, uint16_t len)
+{
+	uint16_t i;
+	int ret;
+
+	buff[0] = cmd >> 8;
+	buff[1] = cmd & 0xFF;
+
+	if (!dev->spi_desc->bit_order)
+		return no_os_spi_write_and_read(dev->spi_desc, buff, len);
+
+	buff[0] = cmd & 0xFF;
+	buff[1] = cmd >> 8;
+	for (i = 0; i < len; i++)
+		buff[i] = no_os_bit_swap_constant_8(buff[i]);
+
+	ret = no_os_spi_write_and_read(dev->spi_desc, buff, len);
+	if (ret)
+		return ret;
+
+	for (i = ADF4382_SPI_CMD_SIZE_BYTES; i < len; i++)
+		buff[i] = no_os_bit_swap_constant_8(buff[i]);
+
+	return 0;
+}
+
+/**
+ * @brief Updates a field of a register in a hop register image.
+ * @param regs 	   - Register image, from ADF4382_HOP_REG_START downwards.
+ * @param reg_addr - The register address.
+ * @param mask 	   - Bits to be updated.
+ * @param data 	   - Update value for the mask.
+ */
+static void adf4382_hop_update_bits(uint8_t *regs, uint16_t reg_addr,
+				    uint8_t mask, uint8_t data)
+{
+	uint8_t *reg = &regs[ADF4382_HOP_REG_START - reg_addr];
+
+	*reg = (*reg & ~mask) | (data & mask);
+}
+
+/**
+ * @brief Builds the frequency hop table. The register image of each entry is
+ * computed once, starting from the current register values, so everything
+ * that does not depend on the output frequency (reference path, charge pump
+ * current, LUT calibration) must be configured before loading the table.
+ * @param dev 	    - The device structure.
+ * @param freqs	    - Output frequencies in Hz.
+ * @param num_freqs - Number of frequencies.
+ * @return 	    - 0 in case of success, -EBUSY if the last adf4382_set_freq()
+ * 		      did not complete, or negative error code.
+ */
+int adf4382_hop_table_load(struct adf4382_dev *dev, const uint64_t *freqs,
+			   uint32_t num_freqs)
+{
+	struct adf4382_freq_words words;
+	struct adf4382_hop_table *table;
+	struct adf4382_hop_entry *entry;
+	uint8_t regs[ADF4382_HOP_REG_CNT];
+	uint64_t pfd_freq;
+	uint32_t i;
+	int ret;
+
+	if (!dev || !freqs || !num_freqs)
+		return -EINVAL;
+
+	/* The image is built from the registers written by adf4382_set_freq() */
+	if (!dev->configured)
+		return -EBUSY;
+
+	ret = adf4382_hop_table_remove(dev);
+	if (ret)
+		return ret;
+
+	table = no_os_calloc(1, sizeof(*table));
+	if (!table)
+		return -ENOMEM;
+
+	table->entries = no_os_calloc(num_freqs, sizeof(*table->entries));
+	if (!table->entries) {
+		ret = -ENOMEM;
+		goto error_table;
+	}
+
+	ret = adf4382_spi_stream(dev, ADF4382_SPI_READ_CMD | ADF4382_HOP_REG_START,
+				 table->buff, sizeof(table->buff));
+	if (ret)
+		goto error_entries;
+	memcpy(regs, &table->buff[ADF4382_SPI_CMD_SIZE_BYTES], sizeof(regs));
+
+	pfd_freq = adf4382_pfd_compute(dev);
+
+	for (i = 0; i < num_freqs; i++) {
+		if (freqs[i] < dev->freq_min || freqs[i] > dev->freq_max) {
+			ret = -EINVAL;
+			goto error_entries;
+		}
+
+		ret = adf4382_freq_words_compute(dev, freqs[i], pfd_freq, &words);
+		if (ret)
+			goto error_entries;
+
+		entry = &table->entries[i];
+		entry->freq = freqs[i];
+		entry->n_int = words.n_int;
+		entry->bleed_word = words.bleed_word;
+		memcpy(entry->regs, regs, sizeof(regs));
+
+		adf4382_hop_update_bits(entry->regs, 0x28, ADF4382_VAR_MOD_EN_MSK,
+					words.frac2_word ? 0xff : 0x0);
+
+		adf4382_hop_update_bits(entry->regs, 0x15, ADF4382_INT_MODE_MSK,
+					no_os_field_prep(ADF4382_INT_MODE_MSK,
+							words.int_mode));
+
+		adf4382_hop_update_bits(entry->regs, 0x1D, 0xFF,
+					words.bleed_word & ADF4382_FINE_BLEED_LSB_MSK);
+		adf4382_hop_update_bits(entry->regs, 0x1E, ADF4382_BLEED_MSB_MSK,
+					words.bleed_word >> 8);
+		adf4382_hop_update_bits(entry->regs, 0x1F, ADF4382_EN_BLEED_MSK,
+					no_os_field_prep(ADF4382_EN_BLEED_MSK,
+							words.en_bleed));
+
+		adf4382_hop_update_bits(entry->regs, 0x1A, 0xFF, words.mod2_word);
+		adf4382_hop_update_bits(entry->regs, 0x1B, 0xFF, words.mod2_word >> 8);
+		adf4382_hop_update_bits(entry->regs, 0x1C, 0xFF, words.mod2_word >> 16);
+
+		adf4382_hop_update_bits(entry->regs, 0x17, 0xFF, words.frac2_word);
+		adf4382_hop_update_bits(entry->regs, 0x18, 0xFF, words.frac2_word >> 8);
+		adf4382_hop_update_bits(entry->regs, 0x19, 0xFF, words.frac2_word >> 16);
+
+		adf4382_hop_update_bits(entry->regs, 0x12, 0xFF, words.frac1_word);
+		adf4382_hop_update_bits(entry->regs, 0x13, 0xFF, words.frac1_word >> 8);
+		adf4382_hop_update_bits(entry->regs, 0x14, 0xFF, words.frac1_word >> 16);
+		adf4382_hop_update_bits(entry->regs, 0x15, ADF4382_FRAC1WORD_MSB,
+					words.frac1_word >> 24);
+
+		adf4382_hop_update_bits(entry->regs, 0x2C, ADF4382_LDWIN_PW_MSK,
+					no_os_field_prep(ADF4382_LDWIN_PW_MSK,
+							words.ldwin_pw));
+
+		adf4382_hop_update_bits(entry->regs, 0x11, ADF4382_CLKOUT_DIV_MSK,
+					no_os_field_prep(ADF4382_CLKOUT_DIV_MSK,
+							words.clkout_div));
+		adf4382_hop_update_bits(entry->regs, 0x11, ADF4382_N_INT_MSB_MSK,
+					words.n_int >> 8);
+
+		/* Last byte of the burst, it triggers the calibration */
+		adf4382_hop_update_bits(entry->regs, 0x10, ADF4382_N_INT_LSB_MSK,
+					words.n_int);
+	}
+
+	table->num_entries = num_freqs;
+	dev->hop_table = table;
+
+	return 0;
+
+error_entries:
+	no_os_free(table->entries);
+error_table:
+	no_os_free(table);
+
+	return ret;
+}
+
+/**
+ * @brief Frees the frequency hop table.
+ * @param dev 	- The device structure.
+ * @return    	- 0 in case of success or negative error code.
+ */
+int adf4382_hop_table_remove(struct adf4382_dev *dev)
+{
+	if (!dev)
+		return -EINVAL;
+
+	if (!dev->hop_table)
+		return 0;
+
+	no_os_free(dev->hop_table->entries);
+	no_os_free(dev->hop_table);
+	dev->hop_table = NULL;
+
+	return 0;
+}
+
+/**
+ * @brief Hops to an entry of the hop table by streaming its register image in
+ * a single SPI transaction. The lock status is not waited for, use
+ * adf4382_get_lock() for that.
+ * @param dev 	- The device structure.
+ * @param index - Index of the entry in the hop table.
+ * @return    	- 0 in case of success or negative error code.
+ */
+int adf4382_hop(struct adf4382_dev *dev, uint32_t index)
+{
+	struct adf4382_hop_table *table;
+	struct adf4382_hop_entry *entry;
+	int ret;
+
+	if (!dev || !dev->hop_table)
+		return -EINVAL;
+
+	table = dev->hop_table;
+	if (index >= table->num_entries)
+		return -EINVAL;
+
+	entry = &table->entries[index];
+	memcpy(&table->buff[ADF4382_SPI_CMD_SIZE_BYTES], entry->regs,
+	       sizeof(entry->regs));
+
+	ret = adf4382_spi_stream(dev, ADF4382_SPI_WRITE_CMD | ADF4382_HOP_REG_START,
+				 table->buff, sizeof(table->buff));
+	if (ret)
+		return ret;
+
+	dev->freq = entry->freq;
+	dev->n_int = entry->n_int;
+	dev->bleed_word = entry->bleed_word;
+	table->next = index + 1 < table->num_entries ? index + 1 : 0;
+
+	return 0;
+}
+
+/**
+ * @brief Hops to the entry following the last one used, wrapping around at the
+ * end of the hop table.
+ * @param dev 	- The device structure.
+ * @return    	- 0 in case of success or negative error code.
+ */
+int adf4382_hop_next(struct adf4382_dev *dev)
+{
+	if (!dev || !dev->hop_table)
+		return -EINVAL;
+
+	return adf4382_hop(dev, dev->hop_table->next);
+}
+
+/**
+ * @brief Hop trigger callback. Register it on the interrupt of the GPIO used
+ * as hop trigger, with the device structure as context. It only records the
+ * request, the SPI burst is sent by adf4382_hop_process().
+ * @param context - The device structure.
+ */
+void adf4382_hop_irq_handler(void *context)
+{
+	struct adf4382_dev *dev = context;
+
+	if (dev && dev->hop_table)
+		dev->hop_table->pending = true;
+}
+
+/**
+ * @brief Hops to the next entry of the hop table if adf4382_hop_irq_handler()
+ * ran since the last call. To be called from the main loop; triggers which
+ * occur before the request is processed are merged into a single hop.
+ * @param dev 	- The device structure.
+ * @return    	- 0 in case of success or negative error code.
+ */
+int adf4382_hop_process(struct adf4382_dev *dev)
+{
+	if (!dev || !dev->hop_table)
+		return -EINVAL;
+
+	if (!dev->hop_table->pending)
+		return 0;
+
+	dev->hop_table->pending = false;
+
+	return adf4382_hop_next(dev);
+}
+
+/**
+ * @brief Gets the PLL lock status.
+ * @param dev 	 - The device structure.
+ * @param locked - The lock status.
+ * @return    	 - 0 in case of success or negative error code.
+ */
+int adf4382_get_lock(struct adf4382_dev *dev, bool *locked)
+{
+	uint8_t val;
+	int ret;
+
+	if (!dev)
+		return -EINVAL;
+
+	ret = adf4382_spi_read(dev, 0x58, &val);
+	if (ret)
+		return ret;
+
+	*locked = no_os_field_get(val, ADF4382_LOCKED_MSK);
+
+	return 0;
+}
+
 /**
  * @brief Set the phase adjustment in pico-seconds. The phase adjust will
  * enable the Bleed current option as well as delay mode to 0.
@@ -2115,6 +2407,8 @@ int adf4382_remove(struct adf4382_dev *dev)
 {
 	int ret;
 
+	adf4382_hop_table_remove(dev);
+
 	ret = no_os_spi_remove(dev->spi_desc);
 	if (ret)
 		no_os_free(dev);
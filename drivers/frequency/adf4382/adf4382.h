@@ -463,6 +463,13 @@
 #define ADF4382_SPI_READ_CMD			0x8000
 #define ADF4382_SPI_DUMMY_DATA			0x00
 #define ADF4382_BUFF_SIZE_BYTES			3
+#define ADF4382_SPI_CMD_SIZE_BYTES		2
+#define ADF4382_HOP_REG_START			0x2C
+#define ADF4382_HOP_REG_END			0x10
+#define ADF4382_HOP_REG_CNT			(ADF4382_HOP_REG_START - \
+						 ADF4382_HOP_REG_END + 1)
+#define ADF4382_HOP_BUFF_SIZE_BYTES		(ADF4382_SPI_CMD_SIZE_BYTES + \
+						 ADF4382_HOP_REG_CNT)
 #define ADF4382_VCO_FREQ_MIN			11000000000U	// 11GHz
 #define ADF4382_VCO_FREQ_MAX			22000000000U	// 22GHz
 #define ADF4383_VCO_FREQ_MIN			10000000000U	// 10GHz
@@ -546,6 +553,38 @@ struct adf4382_init_param {
 	enum adf4382_dev_id		id;
 };
 
+/**
+ * @struct adf4382_hop_entry
+ * @brief ADF4382 precomputed frequency hop.
+ */
+struct adf4382_hop_entry {
+	/** Output frequency in Hz */
+	uint64_t			freq;
+	/** N_INT value, written last to start the calibration */
+	uint16_t			n_int;
+	/** Bleed word used at this frequency */
+	uint16_t			bleed_word;
+	/** Image of registers ADF4382_HOP_REG_START down to ADF4382_HOP_REG_END */
+	uint8_t				regs[ADF4382_HOP_REG_CNT];
+};
+
+/**
+ * @struct adf4382_hop_table
+ * @brief ADF4382 frequency hop table.
+ */
+struct adf4382_hop_table {
+	/** Hop entries */
+	struct adf4382_hop_entry	*entries;
+	/** Number of hop entries */
+	uint32_t			num_entries;
+	/** Entry used by adf4382_hop_next() */
+	uint32_t			next;
+	/** Hop requested by adf4382_hop_irq_handler() */
+	volatile bool			pending;
+	/** SPI streaming buffer */
+	uint8_t				buff[ADF4382_HOP_BUFF_SIZE_BYTES];
+};
+
 /**
  * @struct adf4382_dev
  * @brief ADF4382 Device Descriptor.
@@ -565,6 +604,10 @@ struct adf4382_dev {
 	uint32_t			phase_adj;
 	uint8_t				en_lut_gen;
 	uint8_t				en_lut_cal;
+	/** Frequency hop table, built on top of the LUT calibration */
+	struct adf4382_hop_table	*hop_table;
+	/** The registers match the settings, after adf4382_set_freq() */
+	bool				configured;
 	uint64_t			vco_max;
 	uint64_t			vco_min;
 	uint64_t			freq_max;
@@ -801,6 +844,28 @@ int adf4382_get_sw_sync(struct adf4382_dev *dev, bool *sw_sync);
 /** ADF4382 Set VCO calibration settings attributes */
 int adf4382_set_vco_cal_timeout(struct adf4382_dev *dev);
 
+/** ADF4382 Build the frequency hop table */
+int adf4382_hop_table_load(struct adf4382_dev *dev, const uint64_t *freqs,
+			   uint32_t num_freqs);
+
+/** ADF4382 Free the frequency hop table */
+int adf4382_hop_table_remove(struct adf4382_dev *dev);
+
+/** ADF4382 Hop to an entry of the hop table */
+int adf4382_hop(struct adf4382_dev *dev, uint32_t index);
+
+/** ADF4382 Hop to the next entry of the hop table */
+int adf4382_hop_next(struct adf4382_dev *dev);
+
+/** ADF4382 Hop trigger callback, to be registered on a GPIO interrupt */
+void adf4382_hop_irq_handler(void *context);
+
+/** ADF4382 Hop to the next entry if a hop trigger occurred */
+int adf4382_hop_process(struct adf4382_dev *dev);
+
+/** ADF4382 Get the PLL lock status */
+int adf4382_get_lock(struct adf4382_dev *dev, bool *locked);
+
 /** ADF4382 Initialization */
 int adf4382_init(struct adf4382_dev **device,
 		 struct adf4382_init_param *init_param);
@@ -231,6 +231,9 @@ int gnss_remove(struct gnss_dev *dev)
 	if (!dev)
 		return -EINVAL;
 
+	if (dev->stream)
+		gnss_stream_remove(dev);
+
 	if (dev->gpio_reset)
 		no_os_gpio_remove(dev->gpio_reset);
 
@@ -2066,6 +2069,9 @@ static int gnss_get_nmea_position_data_internal(struct gnss_dev *dev,
 
 /**
  * @brief Refresh timing data from device (unified API for both UBX and NMEA devices)
+ *
+ * While the streaming parser is active, gnss_stream_process() is the only
+ * writer of the timing caches and this is a no-op.
  * @param dev - The device structure
  * @return 0 in case of success, negative error code otherwise
  */
@@ -2076,6 +2082,11 @@ int gnss_refresh_timing_data(struct gnss_dev *dev)
 	if (!dev)
 		return -EINVAL;
 
+	/* The application drives the streaming parser, polling here would
+	 * steal its bytes or race with it on the caches */
+	if (dev->stream)
+		return 0;
+
 	switch (dev->device_type) {
 	case GNSS_DEVICE_UBX_CAPABLE:
 		/* For UBX devices, refresh NAV-PVT if validity check not needed NAV-TIMEUTC data
@@ -2413,3 +2424,494 @@ int gnss_get_nmea_position_data(struct gnss_dev *dev,
 
 	return 0;
 }
+
+/**
+ * @brief Enable periodic NAV-PVT and NAV-TIMEUTC output on UART1, so that the
+ * streaming parser receives navigation solutions without polling.
+ * @param dev - The device structure
+ * @param rate - Output rate, in navigation solutions (0 disables the output)
+ * @return 0 in case of success, negative error code otherwise
+ */
+int gnss_ubx_set_periodic_nav(struct gnss_dev *dev, uint8_t rate)
+{
+	int ret;
+
+	if (!dev)
+		return -EINVAL;
+
+	if (dev->device_type != GNSS_DEVICE_UBX_CAPABLE)
+		return -ENOTSUP;
+
+	ret = gnss_ubx_set_val(dev, UBLOX_CFG_MSGOUT_UBX_NAV_PVT_UART1, rate, 1,
+			       GNSS_CONFIG_LAYER_RAM);
+	if (ret)
+		return ret;
+
+	return gnss_ubx_set_val(dev, UBLOX_CFG_MSGOUT_UBX_NAV_TIMEUTC_UART1, rate,
+				1, GNSS_CONFIG_LAYER_RAM);
+}
+
+/**
+ * @brief Initialize the streaming parser.
+ *
+ * Once initialized, the received bytes are pushed into the ring buffer, either
+ * by gnss_stream_feed() (e.g. from an UART interrupt or DMA callback) or by
+ * gnss_stream_poll(), and decoded by gnss_stream_process(). The blocking
+ * gnss_ubx_poll_*() helpers must not be used while the stream is active.
+ * @param dev - The device structure
+ * @param init_param - Streaming parser parameters
+ * @return 0 in case of success, negative error code otherwise
+ */
+int gnss_stream_init(struct gnss_dev *dev,
+		     struct gnss_stream_init_param *init_param)
+{
+	struct gnss_stream *stream;
+	uint32_t size;
+
+	if (!dev || !init_param)
+		return -EINVAL;
+
+	if (dev->stream)
+		return -EBUSY;
+
+	size = init_param->ring_size ? init_param->ring_size :
+	       GNSS_STREAM_RING_SIZE;
+	/* The ring must hold at least one NAV-PVT frame */
+	if (size & (size - 1) || size < 128)
+		return -EINVAL;
+
+	stream = no_os_calloc(1, sizeof(*stream));
+	if (!stream)
+		return -ENOMEM;
+
+	stream->ring = no_os_calloc(size, sizeof(*stream->ring));
+	if (!stream->ring) {
+		no_os_free(stream);
+		return -ENOMEM;
+	}
+
+	stream->mask = size - 1;
+	stream->state = GNSS_STREAM_SYNC;
+	stream->nav_pvt_cb = init_param->nav_pvt_cb;
+	stream->nav_timeutc_cb = init_param->nav_timeutc_cb;
+	stream->nmea_cb = init_param->nmea_cb;
+	stream->ctx = init_param->ctx;
+
+	dev->stream = stream;
+
+	return 0;
+}
+
+/**
+ * @brief Free the resources allocated by gnss_stream_init().
+ * @param dev - The device structure
+ * @return 0 in case of success, negative error code otherwise
+ */
+int gnss_stream_remove(struct gnss_dev *dev)
+{
+	if (!dev || !dev->stream)
+		return -EINVAL;
+
+	no_os_free(dev->stream->ring);
+	no_os_free(dev->stream);
+	dev->stream = NULL;
+
+	return 0;
+}
+
+/**
+ * @brief Push received bytes into the streaming parser ring buffer.
+ *
+ * Safe to call from interrupt context, as long as there is a single producer:
+ * gnss_stream_poll() must not be used on the same device.
+ * Bytes which don't fit are dropped and counted as overruns.
+ * @param dev - The device structure
+ * @param data - Received bytes
+ * @param len - Number of received bytes
+ * @return number of bytes stored in case of success, negative error code
+ * otherwise
+ */
+int gnss_stream_feed(struct gnss_dev *dev, const uint8_t *data, uint32_t len)
+{
+	struct gnss_stream *stream;
+	uint32_t head, space, off, first;
+
+	if (!dev || !dev->stream || !data)
+		return -EINVAL;
+
+	stream = dev->stream;
+	head = stream->head;
+	space = stream->mask + 1 - (head - stream->tail);
+	if (len > space) {
+		stream->stats.overruns += len - space;
+		len = space;
+	}
+
+	off = head & stream->mask;
+	first = no_os_min(len, stream->mask + 1 - off);
+	memcpy(&stream->ring[off], data, first);
+	memcpy(stream->ring, &data[first], len - first);
+
+	stream->head = head + len;
+
+	return len;
+}
+
+/**
+ * @brief Copy bytes out of the ring buffer, handling the wrap around.
+ * @param stream - The streaming parser
+ * @param idx - Ring index of the first byte
+ * @param dst - Destination buffer
+ * @param len - Number of bytes
+ */
+static void gnss_stream_copy(struct gnss_stream *stream, uint32_t idx,
+			     void *dst, uint32_t len)
+{
+	uint32_t off = idx & stream->mask;
+	uint32_t first = no_os_min(len, stream->mask + 1 - off);
+
+	memcpy(dst, &stream->ring[off], first);
+	memcpy((uint8_t *)dst + first, stream->ring, len - first);
+}
+
+/**
+ * @brief Read one byte of the ring buffer.
+ * @param stream - The streaming parser
+ * @param idx - Ring index
+ * @return the byte
+ */
+static inline uint8_t gnss_stream_byte(struct gnss_stream *stream,
+				       uint32_t idx)
+{
+	return stream->ring[idx & stream->mask];
+}
+
+/**
+ * @brief Release the current frame and wait for the next one.
+ * @param stream - The streaming parser
+ */
+static void gnss_stream_done(struct gnss_stream *stream)
+{
+	stream->tail = stream->scan;
+	stream->state = GNSS_STREAM_SYNC;
+}
+
+/**
+ * @brief Drop the first byte of an invalid frame and restart the search right
+ * after it, so a start of frame hidden inside the rejected bytes isn't lost.
+ * @param stream - The streaming parser
+ */
+static void gnss_stream_resync(struct gnss_stream *stream)
+{
+	stream->stats.discarded++;
+	stream->tail++;
+	stream->scan = stream->tail;
+	stream->state = GNSS_STREAM_SYNC;
+}
+
+/**
+ * @brief Decode an ASCII hex digit.
+ * @param c - The character
+ * @return the digit value, or -1 if c is not a hex digit
+ */
+static int gnss_stream_hex(uint8_t c)
+{
+	if (c >= '0' && c <= '9')
+		return c - '0';
+	if (c >= 'A' && c <= 'F')
+		return c - 'A' + 10;
+	if (c >= 'a' && c <= 'f')
+		return c - 'a' + 10;
+
+	return -1;
+}
+
+/**
+ * @brief Dispatch a validated UBX frame.
+ *
+ * NAV-PVT and NAV-TIMEUTC payloads are decoded straight from the ring buffer
+ * into the device cache.
+ * @param dev - The device structure
+ */
+static void gnss_stream_ubx_frame(struct gnss_dev *dev)
+{
+	struct gnss_stream *stream = dev->stream;
+	uint32_t payload = stream->tail + UBX_HEADER_SIZE;
+	uint8_t cls = gnss_stream_byte(stream, stream->tail + 2);
+	uint8_t id = gnss_stream_byte(stream, stream->tail + 3);
+
+	stream->stats.ubx_frames++;
+
+	if (cls != UBX_CLASS_NAV)
+		return;
+
+	switch (id) {
+	case UBX_NAV_PVT:
+		if (stream->length < sizeof(dev->nav_data))
+			return;
+
+		gnss_stream_copy(stream, payload, &dev->nav_data,
+				 sizeof(dev->nav_data));
+		stream->stats.nav_pvt++;
+		if (stream->nav_pvt_cb)
+			stream->nav_pvt_cb(stream->ctx, &dev->nav_data);
+		break;
+	case UBX_NAV_TIMEUTC:
+		if (stream->length < sizeof(dev->time_data))
+			return;
+
+		gnss_stream_copy(stream, payload, &dev->time_data,
+				 sizeof(dev->time_data));
+		stream->stats.nav_timeutc++;
+		if (stream->nav_timeutc_cb)
+			stream->nav_timeutc_cb(stream->ctx, &dev->time_data);
+		break;
+	default:
+		break;
+	}
+}
+
+/**
+ * @brief Dispatch a validated NMEA sentence.
+ *
+ * The string parsers need a NULL terminated sentence, so only RMC and GGA
+ * sentences (or all of them, if a NMEA callback is registered) are copied out
+ * of the ring buffer.
+ * @param dev - The device structure
+ */
+static void gnss_stream_nmea_frame(struct gnss_dev *dev)
+{
+	struct gnss_stream *stream = dev->stream;
+	struct gnss_nmea_position position;
+	struct gnss_nmea_time timing;
+	uint32_t len = stream->scan - stream->tail;
+	char type[3];
+	bool rmc, gga;
+
+	stream->stats.nmea_sentences++;
+
+	/* "$ttRMC" - skip the talker ID */
+	gnss_stream_copy(stream, stream->tail + 3, type, sizeof(type));
+	rmc = !memcmp(type, "RMC", sizeof(type));
+	gga = !memcmp(type, "GGA", sizeof(type));
+	if (!rmc && !gga && !stream->nmea_cb)
+		return;
+
+	gnss_stream_copy(stream, stream->tail, stream->sentence, len);
+	stream->sentence[len] = '\0';
+
+	if (rmc && !gnss_parse_gprmc_sentence(stream->sentence, &timing))
+		dev->nmea_timing_cache = timing;
+	else if (gga && !gnss_parse_gpgga_sentence(stream->sentence, &position))
+		dev->nmea_position_cache = position;
+
+	if (stream->nmea_cb)
+		stream->nmea_cb(stream->ctx, stream->sentence);
+}
+
+/**
+ * @brief Parse the bytes available in the ring buffer.
+ *
+ * Every byte is visited once while the checksums are accumulated; frames are
+ * only read back from the ring after they have been validated. This is the
+ * only writer of the navigation and timing caches while the stream is active,
+ * so it has to be called from the context which reads them, not from an
+ * interrupt.
+ * @param dev - The device structure
+ * @return 0 in case of success, negative error code otherwise
+ */
+int gnss_stream_process(struct gnss_dev *dev)
+{
+	struct gnss_stream *stream;
+	uint32_t head;
+	uint8_t byte;
+	int hex;
+
+	if (!dev || !dev->stream)
+		return -EINVAL;
+
+	stream = dev->stream;
+	head = stream->head;
+
+	while (stream->scan != head) {
+		byte = gnss_stream_byte(stream, stream->scan++);
+
+		switch (stream->state) {
+		case GNSS_STREAM_SYNC:
+			if (byte == UBX_SYNCH_1) {
+				stream->state = GNSS_STREAM_UBX_SYNC2;
+			} else if (byte == '$') {
+				stream->ck_a = 0;
+				stream->state = GNSS_STREAM_NMEA_BODY;
+			} else {
+				if (byte != '\r' && byte != '\n')
+					stream->stats.discarded++;
+				stream->tail = stream->scan;
+			}
+			break;
+		case GNSS_STREAM_UBX_SYNC2:
+			if (byte != UBX_SYNCH_2) {
+				gnss_stream_resync(stream);
+				break;
+			}
+
+			stream->ck_a = 0;
+			stream->ck_b = 0;
+			stream->remaining = 4;
+			stream->state = GNSS_STREAM_UBX_HEADER;
+			break;
+		case GNSS_STREAM_UBX_HEADER:
+			stream->ck_a += byte;
+			stream->ck_b += stream->ck_a;
+			if (--stream->remaining)
+				break;
+
+			stream->length = gnss_stream_byte(stream, stream->tail + 4) |
+					 gnss_stream_byte(stream, stream->tail + 5) << 8;
+			/* The whole frame has to fit in the ring */
+			if (stream->length + UBX_HEADER_SIZE + UBX_CHECKSUM_SIZE >
+			    stream->mask + 1) {
+				gnss_stream_resync(stream);
+				break;
+			}
+
+			stream->remaining = stream->length;
+			stream->state = stream->length ? GNSS_STREAM_UBX_PAYLOAD :
+					GNSS_STREAM_UBX_CK_A;
+			break;
+		case GNSS_STREAM_UBX_PAYLOAD:
+			stream->ck_a += byte;
+			stream->ck_b += stream->ck_a;
+			if (!--stream->remaining)
+				stream->state = GNSS_STREAM_UBX_CK_A;
+			break;
+		case GNSS_STREAM_UBX_CK_A:
+			if (byte != stream->ck_a) {
+				stream->stats.checksum_errors++;
+				gnss_stream_resync(stream);
+				break;
+			}
+
+			stream->state = GNSS_STREAM_UBX_CK_B;
+			break;
+		case GNSS_STREAM_UBX_CK_B:
+			if (byte != stream->ck_b) {
+				stream->stats.checksum_errors++;
+				gnss_stream_resync(stream);
+				break;
+			}
+
+			gnss_stream_ubx_frame(dev);
+			gnss_stream_done(stream);
+			break;
+		case GNSS_STREAM_NMEA_BODY:
+			if (byte == '*') {
+				stream->state = GNSS_STREAM_NMEA_CK_HI;
+				break;
+			}
+
+			/* Leave room for "*hh" */
+			if (byte < ' ' || byte > '~' ||
+			    stream->scan - stream->tail > GNSS_NMEA_MAX_SENTENCE - 3) {
+				gnss_stream_resync(stream);
+				break;
+			}
+
+			stream->ck_a ^= byte;
+			break;
+		case GNSS_STREAM_NMEA_CK_HI:
+			hex = gnss_stream_hex(byte);
+			if (hex < 0) {
+				gnss_stream_resync(stream);
+				break;
+			}
+
+			stream->nmea_ck = hex << 4;
+			stream->state = GNSS_STREAM_NMEA_CK_LO;
+			break;
+		case GNSS_STREAM_NMEA_CK_LO:
+			hex = gnss_stream_hex(byte);
+			if (hex < 0) {
+				gnss_stream_resync(stream);
+				break;
+			}
+
+			if ((stream->nmea_ck | hex) != stream->ck_a) {
+				stream->stats.checksum_errors++;
+				gnss_stream_resync(stream);
+				break;
+			}
+
+			gnss_stream_nmea_frame(dev);
+			gnss_stream_done(stream);
+			break;
+		default:
+			gnss_stream_resync(stream);
+			break;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Move the bytes received by the UART driver into the ring buffer and
+ * parse them.
+ *
+ * The UART should be initialized with asynchronous_rx set, so reception is
+ * interrupt driven and this only drains the driver FIFO. Data is read straight
+ * into the free space of the ring buffer. Alternative to gnss_stream_feed(),
+ * the two must not be used on the same device.
+ * @param dev - The device structure
+ * @return 0 in case of success, negative error code otherwise
+ */
+int gnss_stream_poll(struct gnss_dev *dev)
+{
+	struct gnss_stream *stream;
+	uint32_t head, space, off, len;
+	int ret;
+
+	if (!dev || !dev->stream)
+		return -EINVAL;
+
+	stream = dev->stream;
+
+	do {
+		head = stream->head;
+		off = head & stream->mask;
+		space = stream->mask + 1 - (head - stream->tail);
+		len = no_os_min(space, stream->mask + 1 - off);
+		if (!len)
+			return gnss_stream_process(dev);
+
+		ret = no_os_uart_read_nonblocking(dev->uart_desc,
+						  &stream->ring[off], len);
+		if (ret < 0)
+			return ret;
+
+		stream->head = head + ret;
+
+		ret = gnss_stream_process(dev);
+		if (ret)
+			return ret;
+	} while (stream->head - head == len);
+
+	return 0;
+}
+
+/**
+ * @brief Get the streaming parser counters.
+ * @param dev - The device structure
+ * @param stats - Counters output
+ * @return 0 in case of success, negative error code otherwise
+ */
+int gnss_stream_get_stats(struct gnss_dev *dev,
+			  struct gnss_stream_stats *stats)
+{
+	if (!dev || !dev->stream || !stats)
+		return -EINVAL;
+
+	*stats = dev->stream->stats;
+
+	return 0;
+}
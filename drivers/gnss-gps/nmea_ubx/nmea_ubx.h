@@ -1327,6 +1327,128 @@ struct gnss_init_param {
 	struct no_os_callback_desc *irq_cb;
 };
 
+/* Default size of the streaming parser ring buffer (power of 2) */
+#define GNSS_STREAM_RING_SIZE				2048
+/* Longest NMEA 0183 sentence, including "$" and "*hh" */
+#define GNSS_NMEA_MAX_SENTENCE				82
+
+/** Callback for decoded UBX-NAV-PVT messages */
+typedef void (*gnss_nav_pvt_cb)(void *ctx,
+				const struct gnss_ubx_nav_pvt *nav_data);
+/** Callback for decoded UBX-NAV-TIMEUTC messages */
+typedef void (*gnss_nav_timeutc_cb)(void *ctx,
+				    const struct gnss_ubx_nav_timeutc *time_data);
+/** Callback for validated NMEA sentences (NULL terminated, no CR/LF) */
+typedef void (*gnss_nmea_cb)(void *ctx, const char *sentence);
+
+/**
+ * @enum gnss_stream_state
+ * @brief Streaming parser states.
+ */
+enum gnss_stream_state {
+	/** Looking for a UBX or NMEA start of frame */
+	GNSS_STREAM_SYNC,
+	/** UBX first sync byte found */
+	GNSS_STREAM_UBX_SYNC2,
+	/** UBX class, id and length */
+	GNSS_STREAM_UBX_HEADER,
+	/** UBX payload */
+	GNSS_STREAM_UBX_PAYLOAD,
+	/** UBX checksum byte A */
+	GNSS_STREAM_UBX_CK_A,
+	/** UBX checksum byte B */
+	GNSS_STREAM_UBX_CK_B,
+	/** NMEA sentence body, up to '*' */
+	GNSS_STREAM_NMEA_BODY,
+	/** NMEA checksum, first hex digit */
+	GNSS_STREAM_NMEA_CK_HI,
+	/** NMEA checksum, second hex digit */
+	GNSS_STREAM_NMEA_CK_LO,
+};
+
+/**
+ * @struct gnss_stream_stats
+ * @brief Streaming parser counters.
+ */
+struct gnss_stream_stats {
+	/** Valid UBX frames */
+	uint32_t ubx_frames;
+	/** Valid NMEA sentences */
+	uint32_t nmea_sentences;
+	/** NAV-PVT messages decoded into the cache */
+	uint32_t nav_pvt;
+	/** NAV-TIMEUTC messages decoded into the cache */
+	uint32_t nav_timeutc;
+	/** Frames dropped because of a checksum mismatch */
+	uint32_t checksum_errors;
+	/** Bytes skipped while looking for a start of frame */
+	uint32_t discarded;
+	/** Received bytes dropped because the ring buffer was full */
+	uint32_t overruns;
+};
+
+/**
+ * @struct gnss_stream_init_param
+ * @brief Streaming parser initialization parameters.
+ */
+struct gnss_stream_init_param {
+	/** Ring buffer size, power of 2 (0 selects GNSS_STREAM_RING_SIZE) */
+	uint32_t ring_size;
+	/** NAV-PVT callback (optional) */
+	gnss_nav_pvt_cb nav_pvt_cb;
+	/** NAV-TIMEUTC callback (optional) */
+	gnss_nav_timeutc_cb nav_timeutc_cb;
+	/** NMEA sentence callback (optional) */
+	gnss_nmea_cb nmea_cb;
+	/** Context passed to the callbacks */
+	void *ctx;
+};
+
+/**
+ * @struct gnss_stream
+ * @brief Streaming parser descriptor.
+ *
+ * Received bytes are stored once in the ring buffer and stay there until the
+ * frame they belong to is fully validated. The parser only keeps indexes into
+ * the ring, so frames are never moved while being assembled.
+ */
+struct gnss_stream {
+	/** Ring buffer */
+	uint8_t *ring;
+	/** Ring buffer size - 1 */
+	uint32_t mask;
+	/** Write index, only updated by the producer */
+	volatile uint32_t head;
+	/** Start of the oldest frame still in use, only updated by the parser */
+	volatile uint32_t tail;
+	/** Next byte to be parsed */
+	uint32_t scan;
+	/** Parser state */
+	enum gnss_stream_state state;
+	/** Bytes of the current frame section still expected */
+	uint16_t remaining;
+	/** UBX payload length */
+	uint16_t length;
+	/** Running UBX checksum A or NMEA XOR checksum */
+	uint8_t ck_a;
+	/** Running UBX checksum B */
+	uint8_t ck_b;
+	/** Received NMEA checksum */
+	uint8_t nmea_ck;
+	/** NAV-PVT callback */
+	gnss_nav_pvt_cb nav_pvt_cb;
+	/** NAV-TIMEUTC callback */
+	gnss_nav_timeutc_cb nav_timeutc_cb;
+	/** NMEA sentence callback */
+	gnss_nmea_cb nmea_cb;
+	/** Callback context */
+	void *ctx;
+	/** Linear copy of the last NMEA sentence handed to string parsers */
+	char sentence[GNSS_NMEA_MAX_SENTENCE + 1];
+	/** Counters */
+	struct gnss_stream_stats stats;
+};
+
 /**
  * @struct gnss_dev
  * @brief GNSS Device structure.
@@ -1368,6 +1490,8 @@ struct gnss_dev {
 	uint32_t pps_pulse_length;
 	/* PPS enable */
 	uint8_t pps_enable;
+	/** Streaming parser, NULL when the request/response mode is used */
+	struct gnss_stream *stream;
 };
 
 /* Initialize the GNSS device and configure communication. */
@@ -1559,4 +1683,27 @@ int gnss_parse_gpgga_sentence(const char *sentence,
 int gnss_get_nmea_position_data(struct gnss_dev *dev,
 				struct gnss_nmea_position *position_data);
 
+/* Enable periodic NAV-PVT and NAV-TIMEUTC output on UART1. */
+int gnss_ubx_set_periodic_nav(struct gnss_dev *dev, uint8_t rate);
+
+/* Initialize the streaming parser. */
+int gnss_stream_init(struct gnss_dev *dev,
+		     struct gnss_stream_init_param *init_param);
+
+/* Free the resources allocated by gnss_stream_init(). */
+int gnss_stream_remove(struct gnss_dev *dev);
+
+/* Push received bytes into the streaming parser ring buffer. */
+int gnss_stream_feed(struct gnss_dev *dev, const uint8_t *data, uint32_t len);
+
+/* Parse the bytes available in the ring buffer. */
+int gnss_stream_process(struct gnss_dev *dev);
+
+/* Move pending UART bytes into the ring buffer and parse them. */
+int gnss_stream_poll(struct gnss_dev *dev);
+
+/* Get the streaming parser counters. */
+int gnss_stream_get_stats(struct gnss_dev *dev,
+			  struct gnss_stream_stats *stats);
+
 #endif /* __NMEA_UBX_H__ */
@@ -229,6 +229,55 @@ int ade9000_read_temp(struct ade9000_dev *dev)
 	return 0;
 }
 
+/**
+ * @brief Read consecutive registers with a single burst.
+ * @param dev - The device structure.
+ * @param reg_addr - The address of the first register. Burst reads are
+ * 		     supported by the waveform buffer and, when BURST_EN is
+ * 		     set, by the 0x500 to 0x63C and 0x680 to 0x6BC ranges.
+ * @param reg_data - The data read from the registers.
+ * @param nb_regs - The number of 32 bits registers to read.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int ade9000_read_burst(struct ade9000_dev *dev, uint16_t reg_addr,
+		       uint32_t *reg_data, uint16_t nb_regs)
+{
+	int ret;
+	/* index */
+	uint16_t i;
+	/* command buffer */
+	uint8_t cmd[2];
+	struct no_os_spi_msg xfer[] = {
+		{
+			.tx_buff = cmd,
+			.bytes_number = sizeof(cmd),
+		},
+		{
+			.rx_buff = (uint8_t *)reg_data,
+			.bytes_number = nb_regs * sizeof(*reg_data),
+			.cs_change = 1,
+		},
+	};
+
+	if (!dev)
+		return -ENODEV;
+	if (!reg_data || !nb_regs)
+		return -EINVAL;
+
+	no_os_put_unaligned_be16(reg_addr << 4, cmd);
+	cmd[1] |= ADE9000_SPI_READ;
+
+	ret = no_os_spi_transfer(dev->spi_desc, xfer, NO_OS_ARRAY_SIZE(xfer));
+	if (ret)
+		return ret;
+
+	/* the registers are received big endian, convert them in place */
+	for (i = 0; i < nb_regs; i++)
+		reg_data[i] = no_os_get_unaligned_be32((uint8_t *)&reg_data[i]);
+
+	return 0;
+}
+
 /**
  * @brief Read the power/energy for specific phase.
  * @param dev - The device structure.
@@ -238,16 +287,10 @@ int ade9000_read_temp(struct ade9000_dev *dev)
 int ade9000_read_data_ph(struct ade9000_dev *dev, enum ade9000_phase phase)
 {
 	int ret;
-	/* register value */
-	uint32_t temp;
-	/* i rms phase register addr */
+	/* rms and power register values */
+	uint32_t data[3];
+	/* i rms phase register addr, followed by v rms and power */
 	uint16_t irms_reg;
-	/* v rms phase register addr */
-	uint16_t vrms_reg;
-	/* power phase register addr */
-	uint16_t watt_reg;
-	/* intermediate values used for computation */
-	uint64_t val_int;
 
 	if (!dev)
 		return -ENODEV;
@@ -255,50 +298,29 @@ int ade9000_read_data_ph(struct ade9000_dev *dev, enum ade9000_phase phase)
 	/* select the phase for values read */
 	switch (phase) {
 	case ADE9000_PHASE_A:
-		irms_reg = ADE9000_REG_AIRMS;
-		vrms_reg = ADE9000_REG_AVRMS;
-		watt_reg = ADE9000_REG_AWATT;
+		irms_reg = ADE9000_REG_AIRMS_2;
 		break;
 	case ADE9000_PHASE_B:
-		irms_reg = ADE9000_REG_BIRMS;
-		vrms_reg = ADE9000_REG_BVRMS;
-		watt_reg = ADE9000_REG_BWATT;
+		irms_reg = ADE9000_REG_BIRMS_2;
 		break;
 	case ADE9000_PHASE_C:
-		irms_reg = ADE9000_REG_CIRMS;
-		vrms_reg = ADE9000_REG_CVRMS;
-		watt_reg = ADE9000_REG_CWATT;
+		irms_reg = ADE9000_REG_CIRMS_2;
 		break;
 	default:
 		return -EINVAL;
 	}
 
-	ret = ade9000_read(dev, irms_reg, &temp);
+	/* xIRMS_2, xVRMS_2 and xWATT_2 are consecutive, read them at once */
+	ret = ade9000_read_burst(dev, irms_reg, data, NO_OS_ARRAY_SIZE(data));
 	if (ret)
 		return ret;
 
 	// Value in mA
-	dev->irms_val = (uint32_t)((uint64_t)(((uint64_t) temp * ADE9000_FS_VOLTAGE
-					       * ADE9000_CURRENT_TR_FCN) / (uint64_t)ADE9000_RMS_FS_CODES));
-
-	ret = ade9000_read(dev, vrms_reg, &temp);
-	if (ret)
-		return ret;
-
+	dev->irms_val = ((uint64_t)data[0] * ADE9000_IRMS_SCALE_Q32) >> 32;
 	// Value in mV
-	dev->vrms_val = (uint32_t)((uint64_t)(((uint64_t) temp * ADE9000_FS_VOLTAGE
-					       * ADE9000_VOLTAGE_TR_FCN) / (uint64_t)ADE9000_RMS_FS_CODES));
-
-	ret = ade9000_read(dev, watt_reg, &temp);
-	if (ret)
-		return ret;
-
-	val_int = ADE9000_FS_VOLTAGE * (ADE9000_CURRENT_TR_FCN / 100)
-		  * (ADE9000_FS_VOLTAGE) * (ADE9000_VOLTAGE_TR_FCN / 10);
-	val_int = ((uint64_t)((uint64_t)temp * (uint64_t)val_int)) /
-		  (uint64_t)ADE9000_WATT_FS_CODES;
+	dev->vrms_val = ((uint64_t)data[1] * ADE9000_VRMS_SCALE_Q32) >> 32;
 	// Value in mW
-	dev->watt_val = (uint32_t)val_int;
+	dev->watt_val = ((uint64_t)data[2] * ADE9000_WATT_SCALE_Q24) >> 24;
 
 	return 0;
 }
@@ -405,7 +427,15 @@ int ade9000_init(struct ade9000_dev **device,
 	if (ret)
 		goto error_spi;
 
-	if (chip_id != ADE9000_CHIP_ID)
+	if (chip_id != ADE9000_CHIP_ID) {
+		ret = -ENODEV;
+		goto error_spi;
+	}
+
+	/* Enable register burst reads, used by ade9000_read_data_ph() */
+	ret = ade9000_update_bits(dev, ADE9000_REG_CONFIG1, ADE9000_BURST_EN,
+				  ADE9000_BURST_EN);
+	if (ret)
 		goto error_spi;
 
 	/* Enable Temperature Sensor */
@@ -446,7 +476,8 @@ int ade9000_setup(struct ade9000_dev *dev)
 	ret = ade9000_write(dev, ADE9000_REG_CONFIG0, ADE9000_CONFIG0);
 	if (ret)
 		return ret;
-	ret = ade9000_write(dev, ADE9000_REG_CONFIG1, ADE9000_CONFIG1);
+	ret = ade9000_write(dev, ADE9000_REG_CONFIG1,
+			    ADE9000_CONFIG1 | ADE9000_BURST_EN);
 	if (ret)
 		return ret;
 	ret = ade9000_write(dev, ADE9000_REG_CONFIG2, ADE9000_CONFIG2);
@@ -491,6 +522,171 @@ int ade9000_setup(struct ade9000_dev *dev)
 	return ade9000_write(dev, ADE9000_REG_RUN, ADE9000_RUN_ON);
 }
 
+/**
+ * @brief Start the continuous fixed data rate waveform buffer capture of all
+ * 	  the channels. PAGE_FULL is raised each time a buffer half is filled.
+ * @param dev - The device structure.
+ * @param src - The waveform source, which also sets the sample rate.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int ade9000_wfb_start(struct ade9000_dev *dev, enum ade9000_wf_src_e src)
+{
+	int ret;
+
+	if (!dev)
+		return -ENODEV;
+
+	switch (src) {
+	case ADE9000_SRC_SINC4:
+	case ADE9000_SRC_SINC4_IIR:
+	case ADE9000_SRC_DSP:
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	ret = ade9000_wfb_stop(dev);
+	if (ret)
+		return ret;
+
+	/* no trigger events, the buffer is filled continuously */
+	ret = ade9000_write(dev, ADE9000_REG_WFB_TRG_CFG, 0);
+	if (ret)
+		return ret;
+
+	ret = ade9000_write(dev, ADE9000_REG_WFB_PG_IRQEN, ADE9000_WFB_PG_IRQEN);
+	if (ret)
+		return ret;
+
+	ret = ade9000_write(dev, ADE9000_REG_WFB_CFG,
+			    no_os_field_prep(ADE9000_WF_IN_EN, 1) |
+			    no_os_field_prep(ADE9000_WF_SRC, src) |
+			    no_os_field_prep(ADE9000_WF_MODE,
+					     ADE9000_MODE_TRIG_EN_EVENTS) |
+			    no_os_field_prep(ADE9000_WF_CAP_SEL, 1) |
+			    no_os_field_prep(ADE9000_BURST_CHAN,
+					     ADE9000_BURST_ALL_CH));
+	if (ret)
+		return ret;
+
+	/* clear a stale page full indicator */
+	ret = ade9000_write(dev, ADE9000_REG_STATUS0, ADE9000_STATUS0_PAGE_FULL);
+	if (ret)
+		return ret;
+
+	ret = ade9000_update_bits(dev, ADE9000_REG_MASK0, ADE9000_MASK0_PAGE_FULL,
+				  ADE9000_MASK0_PAGE_FULL);
+	if (ret)
+		return ret;
+
+	dev->wfb_half = 0;
+	dev->wfb_halves = 0;
+	dev->wfb_overruns = 0;
+
+	return ade9000_update_bits(dev, ADE9000_REG_WFB_CFG, ADE9000_WF_CAP_EN,
+				   ADE9000_WF_CAP_EN);
+}
+
+/**
+ * @brief Stop the waveform buffer capture.
+ * @param dev - The device structure.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int ade9000_wfb_stop(struct ade9000_dev *dev)
+{
+	int ret;
+
+	if (!dev)
+		return -ENODEV;
+
+	ret = ade9000_update_bits(dev, ADE9000_REG_WFB_CFG, ADE9000_WF_CAP_EN, 0);
+	if (ret)
+		return ret;
+
+	return ade9000_update_bits(dev, ADE9000_REG_MASK0,
+				   ADE9000_MASK0_PAGE_FULL, 0);
+}
+
+/**
+ * @brief Burst read waveform buffer pages.
+ * @param dev - The device structure.
+ * @param page - The first page to read.
+ * @param nb_pages - The number of pages to read.
+ * @param data - The samples read, ADE9000_WFB_PAGE_WORDS per page.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int ade9000_wfb_read_pages(struct ade9000_dev *dev, uint8_t page,
+			   uint8_t nb_pages, int32_t *data)
+{
+	if (!nb_pages || page + nb_pages > ADE9000_WFB_PAGES)
+		return -EINVAL;
+
+	return ade9000_read_burst(dev,
+				  ADE9000_WFB_ADDR + page * ADE9000_WFB_PAGE_WORDS,
+				  (uint32_t *)data, nb_pages * ADE9000_WFB_PAGE_WORDS);
+}
+
+/**
+ * @brief Read the waveform buffer half filled since the last call, if any.
+ * 	  Meant to be called on the IRQ0 PAGE_FULL interrupt or polled more
+ * 	  often than a buffer half is filled.
+ * @param dev - The device structure.
+ * @param data - The samples read, ADE9000_WFB_HALF_SETS sets of
+ * 		 ADE9000_WFB_SET_WORDS words.
+ * @param nb_sets - The number of sample sets read, 0 if no half is ready.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int ade9000_wfb_read_ready(struct ade9000_dev *dev, int32_t *data,
+			   uint32_t *nb_sets)
+{
+	int ret;
+	/* register value */
+	uint32_t reg_val;
+	/* last page filled */
+	uint8_t last_page;
+	/* buffer half holding the samples */
+	uint8_t half;
+
+	if (!dev)
+		return -ENODEV;
+	if (!data || !nb_sets)
+		return -EINVAL;
+
+	*nb_sets = 0;
+
+	ret = ade9000_read(dev, ADE9000_REG_STATUS0, &reg_val);
+	if (ret)
+		return ret;
+
+	if (!(reg_val & ADE9000_STATUS0_PAGE_FULL))
+		return 0;
+
+	ret = ade9000_write(dev, ADE9000_REG_STATUS0, ADE9000_STATUS0_PAGE_FULL);
+	if (ret)
+		return ret;
+
+	ret = ade9000_read(dev, ADE9000_REG_WFB_TRG_STAT, &reg_val);
+	if (ret)
+		return ret;
+
+	/* the complete half is the one not being filled */
+	last_page = no_os_field_get(ADE9000_WFB_LAST_PAGE, reg_val);
+	half = !(((last_page + 1) % ADE9000_WFB_PAGES) / ADE9000_WFB_HALF_PAGES);
+	if (half != dev->wfb_half)
+		dev->wfb_overruns++;
+
+	ret = ade9000_wfb_read_pages(dev, half * ADE9000_WFB_HALF_PAGES,
+				     ADE9000_WFB_HALF_PAGES, data);
+	if (ret)
+		return ret;
+
+	dev->wfb_half = !half;
+	dev->wfb_halves++;
+	*nb_sets = ADE9000_WFB_HALF_SETS;
+
+	return 0;
+}
+
 /**
  * @brief Remove the device and release resources.
  * @param dev - The device structure.
@@ -826,7 +826,7 @@
 /* ADE9000_REG_WFB_CFG Bit Definition */
 #define ADE9000_WF_IN_EN		NO_OS_BIT(12)
 #define ADE9000_WF_SRC			NO_OS_GENMASK(9, 8)
-#define ADE9000_WF_MODE			NO_OS_BIT(7, 6)
+#define ADE9000_WF_MODE			NO_OS_GENMASK(7, 6)
 #define ADE9000_WF_CAP_SEL		NO_OS_BIT(5)
 #define ADE9000_WF_CAP_EN		NO_OS_BIT(4)
 #define ADE9000_BURST_CHAN		NO_OS_GENMASK(3, 0)
@@ -956,6 +956,18 @@
 /*Neutral current samples enabled, Resampled data enabled*/
 /*Burst all channels*/
 #define ADE9000_WFB_CFG 		0x1000
+/*Waveform buffer memory, 2048 32-bit words split in 16 pages*/
+#define ADE9000_WFB_ADDR		0x0800
+#define ADE9000_WFB_PAGES		16
+#define ADE9000_WFB_PAGE_WORDS		128
+/*Fixed data rate sample set: IA, VA, IB, VB, IC, VC, IN and one unused word*/
+#define ADE9000_WFB_SET_WORDS		8
+#define ADE9000_WFB_PAGE_SETS		(ADE9000_WFB_PAGE_WORDS / ADE9000_WFB_SET_WORDS)
+/*PAGE_FULL is raised when the last page of each buffer half is filled*/
+#define ADE9000_WFB_HALF_PAGES		(ADE9000_WFB_PAGES / 2)
+#define ADE9000_WFB_HALF_SETS		(ADE9000_WFB_HALF_PAGES * ADE9000_WFB_PAGE_SETS)
+#define ADE9000_WFB_PG_IRQEN		(NO_OS_BIT(ADE9000_WFB_HALF_PAGES - 1) | \
+					 NO_OS_BIT(ADE9000_WFB_PAGES - 1))
 /*size of buffer to read. 512 Max.Each element IA,VA...IN has max 512 points*/
 /*[Size of waveform buffer/number of sample sets = 2048/4 = 512]*/
 /*(Refer ADE9000 technical reference manual for more details)*/
@@ -979,6 +991,20 @@
 // 0.707V rms full scale * 1000 for mili units
 #define ADE9000_FS_VOLTAGE           	707
 
+/* rms and power scales as 32.32 and 40.24 fixed point factors, replacing the
+ * 64-bit divisions by full scale codes with a multiplication and a shift */
+#define ADE9000_IRMS_SCALE_Q32		(((uint64_t)ADE9000_FS_VOLTAGE * \
+					  ADE9000_CURRENT_TR_FCN << 32) / \
+					 ADE9000_RMS_FS_CODES)
+#define ADE9000_VRMS_SCALE_Q32		(((uint64_t)ADE9000_FS_VOLTAGE * \
+					  ADE9000_VOLTAGE_TR_FCN << 32) / \
+					 ADE9000_RMS_FS_CODES)
+#define ADE9000_WATT_SCALE_Q24		(((uint64_t)ADE9000_FS_VOLTAGE * \
+					  (ADE9000_CURRENT_TR_FCN / 100) * \
+					  ADE9000_FS_VOLTAGE * \
+					  (ADE9000_VOLTAGE_TR_FCN / 10) << 24) / \
+					 ADE9000_WATT_FS_CODES)
+
 /**
  * @enum ade9000_isum_cfg_e
  * @brief ADE9000 isum calculation configuration.
@@ -1382,6 +1408,12 @@ struct ade9000_dev {
 	uint32_t			vrms_val;
 	/** Variable storing the temperature value in degrees */
 	int32_t				temp_deg;
+	/** Waveform buffer half expected at the next PAGE_FULL */
+	uint8_t				wfb_half;
+	/** Number of waveform buffer halves read */
+	uint32_t			wfb_halves;
+	/** Number of waveform buffer halves overwritten before being read */
+	uint32_t			wfb_overruns;
 };
 
 /* Read device register. */
@@ -1420,4 +1452,22 @@ int ade9000_remove(struct ade9000_dev *dev);
 int ade9000_get_int_status0(struct ade9000_dev *dev, uint32_t msk,
 			    uint8_t *status);
 
+/* Read consecutive registers with a single burst. */
+int ade9000_read_burst(struct ade9000_dev *dev, uint16_t reg_addr,
+		       uint32_t *reg_data, uint16_t nb_regs);
+
+/* Start the continuous fixed data rate waveform buffer capture. */
+int ade9000_wfb_start(struct ade9000_dev *dev, enum ade9000_wf_src_e src);
+
+/* Stop the waveform buffer capture. */
+int ade9000_wfb_stop(struct ade9000_dev *dev);
+
+/* Burst read waveform buffer pages. */
+int ade9000_wfb_read_pages(struct ade9000_dev *dev, uint8_t page,
+			   uint8_t nb_pages, int32_t *data);
+
+/* Read the waveform buffer half filled since the last call, if any. */
+int ade9000_wfb_read_ready(struct ade9000_dev *dev, int32_t *data,
+			   uint32_t *nb_sets);
+
 #endif // __ADE9000_H__
@@ -0,0 +1,194 @@
+/***************************************************************************//**
+ *   @file   ade9000_wfb_calc.c
+ *   @brief  Integer per cycle rms, power and harmonics of ADE9000 waveform samples
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <stdbool.h>
+#include <errno.h>
+#include "ade9000_wfb_calc.h"
+
+/* 512 points sine period, offset by 0x8000 */
+extern const uint16_t no_os_sine_lut_16[512];
+
+#define ADE9000_CALC_LUT_BITS		9
+#define ADE9000_CALC_LUT_SIZE		(1 << ADE9000_CALC_LUT_BITS)
+#define ADE9000_CALC_LUT_ONE		0x7FFF
+
+/**
+ * @brief Integer square root.
+ * @param val - The value.
+ * @return The square root of the value, rounded down.
+ */
+static uint32_t ade9000_calc_isqrt(uint64_t val)
+{
+	uint64_t res = 0;
+	uint64_t bit = 1ULL << 62;
+
+	while (bit > val)
+		bit >>= 2;
+
+	while (bit) {
+		if (val >= res + bit) {
+			val -= res + bit;
+			res = (res >> 1) + bit;
+		} else {
+			res >>= 1;
+		}
+		bit >>= 2;
+	}
+
+	return res;
+}
+
+/**
+ * @brief Find a line cycle between two positive going voltage zero crossings.
+ * 	  A crossing is only accepted after the voltage went below -hyst, so
+ * 	  that noise around zero is not taken for a new cycle.
+ * @param v - The voltage samples.
+ * @param stride - The distance between two voltage samples, in words
+ * 		   (ADE9000_WFB_SET_WORDS for the interleaved buffer samples).
+ * @param nb_sets - The number of samples.
+ * @param hyst - The hysteresis, in codes.
+ * @param start - The index of the first sample of the cycle.
+ * @param len - The number of samples of the cycle.
+ * @return 0 in case of success, -ENODATA if there is no complete cycle.
+ */
+int ade9000_calc_find_cycle(const int32_t *v, uint32_t stride,
+			    uint32_t nb_sets, int32_t hyst,
+			    uint32_t *start, uint32_t *len)
+{
+	uint32_t n, first = 0;
+	bool armed = false;
+	bool found = false;
+
+	if (!v || !stride || !start || !len)
+		return -EINVAL;
+
+	for (n = 0; n < nb_sets; n++) {
+		if (v[n * stride] < -hyst) {
+			armed = true;
+			continue;
+		}
+		if (!armed || v[n * stride] < 0)
+			continue;
+
+		armed = false;
+		if (found) {
+			*start = first;
+			*len = n - first;
+			return 0;
+		}
+		first = n;
+		found = true;
+	}
+
+	return -ENODATA;
+}
+
+/**
+ * @brief Compute the rms, active power and harmonics of one line cycle.
+ * 	  Harmonics are computed as single DFT bins over the cycle, using the
+ * 	  shared sine table, so that only integer operations are needed.
+ * @param i - The current samples.
+ * @param v - The voltage samples.
+ * @param stride - The distance between two samples of a channel, in words.
+ * @param nb_samples - The number of samples of the cycle.
+ * @param nb_harm - The number of harmonics to compute, 0 to skip them.
+ * @param res - The computed values.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int ade9000_calc_cycle(const int32_t *i, const int32_t *v, uint32_t stride,
+		       uint32_t nb_samples, uint8_t nb_harm,
+		       struct ade9000_calc_cycle *res)
+{
+	uint64_t i_sq = 0, v_sq = 0;
+	int64_t pwr = 0;
+	int64_t i_re, i_im, v_re, v_im, div;
+	uint32_t phase, step, idx, n, h;
+	int32_t si, sv, s, c;
+
+	if (!i || !v || !stride || !res)
+		return -EINVAL;
+	if (!nb_samples || nb_samples > ADE9000_CALC_MAX_SAMPLES)
+		return -EINVAL;
+	if (nb_harm > ADE9000_CALC_MAX_HARMONICS || nb_harm > nb_samples / 2)
+		return -EINVAL;
+
+	/* 2^26 codes squared, over 2^10 samples, fit 63 bits */
+	for (n = 0; n < nb_samples; n++) {
+		si = i[n * stride];
+		sv = v[n * stride];
+		i_sq += (int64_t)si * si;
+		v_sq += (int64_t)sv * sv;
+		pwr += (int64_t)si * sv;
+	}
+
+	res->nb_samples = nb_samples;
+	res->irms = ade9000_calc_isqrt(i_sq / nb_samples);
+	res->vrms = ade9000_calc_isqrt(v_sq / nb_samples);
+	res->watt = pwr / (int64_t)nb_samples;
+	res->nb_harm = nb_harm;
+
+	/* bin scale: 2 / N for the peak, Q15 table, rms taken below */
+	div = (int64_t)nb_samples * ADE9000_CALC_LUT_ONE;
+
+	for (h = 1; h <= nb_harm; h++) {
+		/* fraction of the sine period per sample, as a 0.32 value */
+		step = (((uint64_t)h << 32) + nb_samples / 2) / nb_samples;
+		phase = 0;
+		i_re = i_im = v_re = v_im = 0;
+
+		for (n = 0; n < nb_samples; n++) {
+			idx = (phase + (1U << (31 - ADE9000_CALC_LUT_BITS))) >>
+			      (32 - ADE9000_CALC_LUT_BITS);
+			s = no_os_sine_lut_16[idx % ADE9000_CALC_LUT_SIZE] - 0x8000;
+			c = no_os_sine_lut_16[(idx + ADE9000_CALC_LUT_SIZE / 4) %
+						     ADE9000_CALC_LUT_SIZE] - 0x8000;
+			si = i[n * stride];
+			sv = v[n * stride];
+			i_re += (int64_t)si * c;
+			i_im += (int64_t)si * s;
+			v_re += (int64_t)sv * c;
+			v_im += (int64_t)sv * s;
+			phase += step;
+		}
+
+		i_re /= div;
+		i_im /= div;
+		v_re /= div;
+		v_im /= div;
+		/* rms = peak / sqrt(2) = sqrt(2) * |bin| */
+		res->i_harm[h - 1] = ade9000_calc_isqrt(2 * (uint64_t)(i_re * i_re +
+							 i_im * i_im));
+		res->v_harm[h - 1] = ade9000_calc_isqrt(2 * (uint64_t)(v_re * v_re +
+							 v_im * v_im));
+	}
+
+	return 0;
+}
@@ -0,0 +1,74 @@
+/***************************************************************************//**
+ *   @file   ade9000_wfb_calc.h
+ *   @brief  Integer per cycle rms, power and harmonics of ADE9000 waveform samples
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef __ADE9000_WFB_CALC_H__
+#define __ADE9000_WFB_CALC_H__
+
+#include <stdint.h>
+
+/* Maximum number of samples in a line cycle (45 Hz at 32 kSPS fits) */
+#define ADE9000_CALC_MAX_SAMPLES	1024
+/* Maximum number of harmonics computed, the fundamental included */
+#define ADE9000_CALC_MAX_HARMONICS	50
+
+/**
+ * @struct ade9000_calc_cycle
+ * @brief Values computed over one line cycle. All values are in ADC codes,
+ * 	  the power in codes squared.
+ */
+struct ade9000_calc_cycle {
+	/** Number of samples in the cycle */
+	uint32_t	nb_samples;
+	/** Current rms */
+	uint32_t	irms;
+	/** Voltage rms */
+	uint32_t	vrms;
+	/** Active power, mean of the instantaneous power */
+	int64_t		watt;
+	/** Number of harmonics computed */
+	uint8_t		nb_harm;
+	/** Current rms of harmonics 1 to nb_harm */
+	uint32_t	i_harm[ADE9000_CALC_MAX_HARMONICS];
+	/** Voltage rms of harmonics 1 to nb_harm */
+	uint32_t	v_harm[ADE9000_CALC_MAX_HARMONICS];
+};
+
+/* Find a line cycle between two positive going voltage zero crossings. */
+int ade9000_calc_find_cycle(const int32_t *v, uint32_t stride,
+			    uint32_t nb_sets, int32_t hyst,
+			    uint32_t *start, uint32_t *len);
+
+/* Compute the rms, active power and harmonics of one line cycle. */
+int ade9000_calc_cycle(const int32_t *i, const int32_t *v, uint32_t stride,
+		       uint32_t nb_samples, uint8_t nb_harm,
+		       struct ade9000_calc_cycle *res);
+
+#endif // __ADE9000_WFB_CALC_H__
@@ -0,0 +1,485 @@
+/***************************************************************************//**
+ *   @file   iio_ade9000.c
+ *   @brief  Implementation of the ADE9000 waveform buffer IIO driver
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <stdlib.h>
+#include <stdio.h>
+#include <errno.h>
+#include "no_os_delay.h"
+#include "no_os_util.h"
+#include "no_os_alloc.h"
+#include "iio_ade9000.h"
+
+/* IA, VA, IB, VB, IC, VC and IN, in the waveform buffer sample set order */
+#define ADE9000_IIO_NUM_CH		7
+
+static int ade9000_iio_read_raw(void *device, char *buf, uint32_t len,
+				const struct iio_ch_info *channel,
+				intptr_t priv);
+static int ade9000_iio_read_attr(void *device, char *buf, uint32_t len,
+				 const struct iio_ch_info *channel,
+				 intptr_t priv);
+static int ade9000_iio_write_attr(void *device, char *buf, uint32_t len,
+				  const struct iio_ch_info *channel,
+				  intptr_t priv);
+
+static struct scan_type ade9000_iio_scan_type = {
+	.sign = 's',
+	.realbits = 32,
+	.storagebits = 32,
+	.shift = 0,
+	.is_big_endian = false,
+};
+
+static struct iio_attribute ade9000_iio_ch_attrs[] = {
+	{
+		.name = "raw",
+		.show = ade9000_iio_read_raw,
+	},
+	END_ATTRIBUTES_ARRAY
+};
+
+#define ADE9000_IIO_CHANNEL(_name, _type, _ch, _idx) {	\
+	.name = _name,					\
+	.ch_type = _type,				\
+	.channel = _ch,					\
+	.address = _idx,				\
+	.scan_index = _idx,				\
+	.scan_type = &ade9000_iio_scan_type,		\
+	.attributes = ade9000_iio_ch_attrs,		\
+	.indexed = true,				\
+}
+
+static struct iio_channel ade9000_iio_channels[] = {
+	ADE9000_IIO_CHANNEL("ia", IIO_CURRENT, 0, 0),
+	ADE9000_IIO_CHANNEL("va", IIO_VOLTAGE, 0, 1),
+	ADE9000_IIO_CHANNEL("ib", IIO_CURRENT, 1, 2),
+	ADE9000_IIO_CHANNEL("vb", IIO_VOLTAGE, 1, 3),
+	ADE9000_IIO_CHANNEL("ic", IIO_CURRENT, 2, 4),
+	ADE9000_IIO_CHANNEL("vc", IIO_VOLTAGE, 2, 5),
+	ADE9000_IIO_CHANNEL("in", IIO_CURRENT, 3, 6),
+};
+
+static struct iio_attribute ade9000_iio_dev_attrs[] = {
+	{
+		.name = "sampling_frequency",
+		.priv = ADE9000_IIO_SAMPLING_FREQ,
+		.show = ade9000_iio_read_attr,
+		.store = ade9000_iio_write_attr,
+	},
+	{
+		.name = "sampling_frequency_available",
+		.priv = ADE9000_IIO_SAMPLING_FREQ_AVAIL,
+		.show = ade9000_iio_read_attr,
+	},
+	END_ATTRIBUTES_ARRAY
+};
+
+static struct iio_attribute ade9000_iio_debug_attrs[] = {
+	{
+		.name = "wfb_halves",
+		.priv = ADE9000_IIO_WFB_HALVES,
+		.show = ade9000_iio_read_attr,
+	},
+	{
+		.name = "wfb_overruns",
+		.priv = ADE9000_IIO_WFB_OVERRUNS,
+		.show = ade9000_iio_read_attr,
+	},
+	END_ATTRIBUTES_ARRAY
+};
+
+/**
+ * @brief Read the instantaneous value of a channel.
+ * @param device - The iio device structure.
+ * @param buf	 - Buffer to store the read data.
+ * @param len	 - Buffer length.
+ * @param channel - IIO channel.
+ * @param priv   - IIO private data.
+ * @return ret   - Result of the reading procedure.
+ */
+static int ade9000_iio_read_raw(void *device, char *buf, uint32_t len,
+				const struct iio_ch_info *channel,
+				intptr_t priv)
+{
+	struct ade9000_iio_desc *desc = device;
+	uint32_t reg_val;
+	uint16_t reg;
+	int ret;
+
+	/* the xx_SINC_DAT and xx_LPF_DAT registers follow the sample set order */
+	if (desc->src == ADE9000_SRC_SINC4)
+		reg = ADE9000_REG_AI_SINC_DAT;
+	else
+		reg = ADE9000_REG_AI_LPF_DAT;
+
+	ret = ade9000_read(desc->ade9000_dev, reg + channel->address, &reg_val);
+	if (ret)
+		return ret;
+
+	return iio_format_value(buf, len, IIO_VAL_INT, 1, (int32_t *)&reg_val);
+}
+
+/**
+ * @brief Read a device attribute.
+ * @param device - The iio device structure.
+ * @param buf	 - Buffer to store the read data.
+ * @param len	 - Buffer length.
+ * @param channel - IIO channel.
+ * @param priv   - IIO private data.
+ * @return ret   - Result of the reading procedure.
+ */
+static int ade9000_iio_read_attr(void *device, char *buf, uint32_t len,
+				 const struct iio_ch_info *channel,
+				 intptr_t priv)
+{
+	struct ade9000_iio_desc *desc = device;
+	uint32_t val;
+
+	switch (priv) {
+	case ADE9000_IIO_SAMPLING_FREQ:
+		val = desc->src == ADE9000_SRC_SINC4 ? 32000 : 8000;
+		break;
+	case ADE9000_IIO_SAMPLING_FREQ_AVAIL:
+		return snprintf(buf, len, "8000 32000");
+	case ADE9000_IIO_WFB_HALVES:
+		val = desc->ade9000_dev->wfb_halves;
+		break;
+	case ADE9000_IIO_WFB_OVERRUNS:
+		val = desc->ade9000_dev->wfb_overruns;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	return iio_format_value(buf, len, IIO_VAL_INT, 1, (int32_t *)&val);
+}
+
+/**
+ * @brief Write a device attribute.
+ * @param device - The iio device structure.
+ * @param buf	 - Buffer containing the value.
+ * @param len	 - Buffer length.
+ * @param channel - IIO channel.
+ * @param priv   - IIO private data.
+ * @return ret   - Result of the writing procedure.
+ */
+static int ade9000_iio_write_attr(void *device, char *buf, uint32_t len,
+				  const struct iio_ch_info *channel,
+				  intptr_t priv)
+{
+	struct ade9000_iio_desc *desc = device;
+
+	switch (priv) {
+	case ADE9000_IIO_SAMPLING_FREQ:
+		/* applied when the next buffered capture is started */
+		switch (no_os_str_to_uint32(buf)) {
+		case 32000:
+			desc->src = ADE9000_SRC_SINC4;
+			break;
+		case 8000:
+			if (desc->src == ADE9000_SRC_SINC4)
+				desc->src = ADE9000_SRC_SINC4_IIR;
+			break;
+		default:
+			return -EINVAL;
+		}
+		return len;
+	default:
+		return -EINVAL;
+	}
+}
+
+/**
+ * @brief IRQ0 interrupt handler, raised by PAGE_FULL during the capture.
+ * @param context - The iio device structure.
+ */
+static void ade9000_iio_irq_handler(void *context)
+{
+	struct ade9000_iio_desc *desc = context;
+
+	desc->page_full = true;
+}
+
+/**
+ * @brief Start the waveform buffer capture. IRQ0 only signals PAGE_FULL
+ * 	  during the capture.
+ * @param device - The iio device structure.
+ * @param mask - Mask of the enabled channels.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int ade9000_iio_pre_enable(void *device, uint32_t mask)
+{
+	struct ade9000_iio_desc *desc = device;
+	int ret;
+
+	ret = ade9000_read(desc->ade9000_dev, ADE9000_REG_MASK0, &desc->mask0);
+	if (ret)
+		return ret;
+
+	ret = ade9000_write(desc->ade9000_dev, ADE9000_REG_MASK0, 0);
+	if (ret)
+		return ret;
+
+	desc->wfb_len = 0;
+	desc->wfb_pos = 0;
+	desc->page_full = false;
+
+	ret = ade9000_wfb_start(desc->ade9000_dev, desc->src);
+	if (ret)
+		return ret;
+
+	if (desc->irq_ctrl)
+		return no_os_irq_enable(desc->irq_ctrl, desc->irq_id);
+
+	return 0;
+}
+
+/**
+ * @brief Stop the waveform buffer capture and restore MASK0.
+ * @param device - The iio device structure.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int ade9000_iio_post_disable(void *device)
+{
+	struct ade9000_iio_desc *desc = device;
+	int ret;
+
+	if (desc->irq_ctrl) {
+		ret = no_os_irq_disable(desc->irq_ctrl, desc->irq_id);
+		if (ret)
+			return ret;
+	}
+
+	ret = ade9000_wfb_stop(desc->ade9000_dev);
+	if (ret)
+		return ret;
+
+	return ade9000_write(desc->ade9000_dev, ADE9000_REG_MASK0, desc->mask0);
+}
+
+/**
+ * @brief Wait for the next waveform buffer half and read it.
+ * @param desc - The iio device structure.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int ade9000_iio_wfb_fill(struct ade9000_iio_desc *desc)
+{
+	uint32_t timeout = ADE9000_IIO_WFB_TIMEOUT_MS;
+	int ret;
+
+	do {
+		/* without the interrupt, STATUS0 is polled */
+		if (!desc->irq_ctrl || desc->page_full) {
+			desc->page_full = false;
+
+			ret = ade9000_wfb_read_ready(desc->ade9000_dev, desc->wfb,
+						     &desc->wfb_len);
+			if (ret)
+				return ret;
+
+			if (desc->wfb_len) {
+				desc->wfb_pos = 0;
+				return 0;
+			}
+		}
+
+		no_os_mdelay(1);
+	} while (timeout--);
+
+	return -ETIMEDOUT;
+}
+
+/**
+ * @brief Push the requested number of sample sets into the IIO buffer. A whole
+ * 	  waveform buffer half is read at once, the sets not pushed are kept
+ * 	  for the next call.
+ * @param dev - IIO device data.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int ade9000_iio_submit(struct iio_device_data *dev)
+{
+	struct ade9000_iio_desc *desc = dev->dev;
+	uint32_t mask = dev->buffer->active_mask;
+	int32_t data[ADE9000_IIO_NUM_CH];
+	uint32_t i, s, n;
+	int32_t *set;
+	int ret;
+
+	for (s = 0; s < dev->buffer->samples; s++) {
+		if (desc->wfb_pos == desc->wfb_len) {
+			ret = ade9000_iio_wfb_fill(desc);
+			if (ret)
+				return ret;
+		}
+
+		set = &desc->wfb[desc->wfb_pos * ADE9000_WFB_SET_WORDS];
+		desc->wfb_pos++;
+
+		n = 0;
+		for (i = 0; i < ADE9000_IIO_NUM_CH; i++)
+			if (mask & NO_OS_BIT(i))
+				data[n++] = set[i];
+
+		ret = iio_buffer_push_scan(dev->buffer, data);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Initializes the ADE9000 IIO driver.
+ * @param iio_desc - The iio device descriptor.
+ * @param init_param - The structure that contains the device initial
+ * 		       parameters.
+ * @return 0 in case of success, an error code otherwise.
+ */
+int ade9000_iio_init(struct ade9000_iio_desc **iio_desc,
+		     struct ade9000_iio_init_param *init_param)
+{
+	struct ade9000_iio_desc *descriptor;
+	int ret;
+
+	if (!iio_desc || !init_param || !init_param->ade9000_init_param)
+		return -EINVAL;
+
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	descriptor->src = init_param->src;
+
+	descriptor->wfb = no_os_calloc(ADE9000_WFB_HALF_SETS *
+				       ADE9000_WFB_SET_WORDS,
+				       sizeof(*descriptor->wfb));
+	if (!descriptor->wfb) {
+		ret = -ENOMEM;
+		goto error;
+	}
+
+	descriptor->iio_dev = no_os_calloc(1, sizeof(*descriptor->iio_dev));
+	if (!descriptor->iio_dev) {
+		ret = -ENOMEM;
+		goto error_wfb;
+	}
+
+	ret = ade9000_init(&descriptor->ade9000_dev,
+			   *init_param->ade9000_init_param);
+	if (ret)
+		goto error_iio_dev;
+
+	ret = ade9000_setup(descriptor->ade9000_dev);
+	if (ret)
+		goto error_ade9000;
+
+	if (init_param->irq_ctrl) {
+		descriptor->irq_cb.callback = ade9000_iio_irq_handler;
+		descriptor->irq_cb.ctx = descriptor;
+		descriptor->irq_cb.event = NO_OS_EVT_GPIO;
+		descriptor->irq_cb.peripheral = NO_OS_GPIO_IRQ;
+
+		ret = no_os_irq_register_callback(init_param->irq_ctrl,
+						  init_param->irq_id,
+						  &descriptor->irq_cb);
+		if (ret)
+			goto error_ade9000;
+
+		ret = no_os_irq_trigger_level_set(init_param->irq_ctrl,
+						  init_param->irq_id,
+						  NO_OS_IRQ_EDGE_FALLING);
+		if (ret)
+			goto error_irq;
+
+		ret = no_os_irq_disable(init_param->irq_ctrl, init_param->irq_id);
+		if (ret)
+			goto error_irq;
+
+		descriptor->irq_ctrl = init_param->irq_ctrl;
+		descriptor->irq_id = init_param->irq_id;
+	}
+
+	descriptor->iio_dev->num_ch = NO_OS_ARRAY_SIZE(ade9000_iio_channels);
+	descriptor->iio_dev->channels = ade9000_iio_channels;
+	descriptor->iio_dev->attributes = ade9000_iio_dev_attrs;
+	descriptor->iio_dev->debug_attributes = ade9000_iio_debug_attrs;
+	descriptor->iio_dev->pre_enable = ade9000_iio_pre_enable;
+	descriptor->iio_dev->post_disable = ade9000_iio_post_disable;
+	descriptor->iio_dev->submit = ade9000_iio_submit;
+
+	*iio_desc = descriptor;
+
+	return 0;
+
+error_irq:
+	no_os_irq_unregister_callback(init_param->irq_ctrl, init_param->irq_id,
+				      &descriptor->irq_cb);
+error_ade9000:
+	ade9000_remove(descriptor->ade9000_dev);
+error_iio_dev:
+	no_os_free(descriptor->iio_dev);
+error_wfb:
+	no_os_free(descriptor->wfb);
+error:
+	no_os_free(descriptor);
+
+	return ret;
+}
+
+/**
+ * @brief Free resources allocated by the init function
+ * @param desc - The iio device descriptor.
+ * @return 0 in case of success, an error code otherwise.
+ */
+int ade9000_iio_remove(struct ade9000_iio_desc *desc)
+{
+	int ret;
+
+	if (!desc)
+		return -EINVAL;
+
+	if (desc->irq_ctrl) {
+		ret = no_os_irq_unregister_callback(desc->irq_ctrl, desc->irq_id,
+						    &desc->irq_cb);
+		if (ret)
+			return ret;
+	}
+
+	ret = ade9000_remove(desc->ade9000_dev);
+	if (ret)
+		return ret;
+
+	no_os_free(desc->iio_dev);
+	no_os_free(desc->wfb);
+	no_os_free(desc);
+
+	return 0;
+}
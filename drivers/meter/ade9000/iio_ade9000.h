@@ -0,0 +1,106 @@
+/***************************************************************************//**
+ *   @file   iio_ade9000.h
+ *   @brief  Header file of the ADE9000 waveform buffer IIO driver
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef __IIO_ADE9000_H__
+#define __IIO_ADE9000_H__
+
+#include <stdbool.h>
+#include "iio.h"
+#include "no_os_irq.h"
+#include "ade9000.h"
+
+/* Maximum time to wait for a waveform buffer half */
+#define ADE9000_IIO_WFB_TIMEOUT_MS	100
+
+/**
+ * @brief Structure holding the ADE9000 IIO device descriptor
+ */
+struct ade9000_iio_desc {
+	struct ade9000_dev *ade9000_dev;
+	struct iio_device *iio_dev;
+	/** Waveform source used by the buffered capture */
+	enum ade9000_wf_src_e src;
+	/** Sample sets of one waveform buffer half */
+	int32_t *wfb;
+	/** Number of sample sets in wfb */
+	uint32_t wfb_len;
+	/** Next sample set of wfb to push */
+	uint32_t wfb_pos;
+	/** MASK0 value restored when the capture is stopped */
+	uint32_t mask0;
+	/** IRQ controller of the IRQ0 line, NULL to poll STATUS0 */
+	struct no_os_irq_ctrl_desc *irq_ctrl;
+	/** IRQ0 line interrupt ID */
+	uint32_t irq_id;
+	/** IRQ0 line interrupt callback */
+	struct no_os_callback_desc irq_cb;
+	/** Set on the IRQ0 interrupt */
+	volatile bool page_full;
+};
+
+/**
+ * @brief Structure holding the ADE9000 IIO initialization parameter.
+ */
+struct ade9000_iio_init_param {
+	struct ade9000_init_param *ade9000_init_param;
+	/** Waveform source, 32 kSPS for ADE9000_SRC_SINC4, 8 kSPS otherwise */
+	enum ade9000_wf_src_e src;
+	/** Optional IRQ controller of the IRQ0 line */
+	struct no_os_irq_ctrl_desc *irq_ctrl;
+	/** IRQ0 line interrupt ID */
+	uint32_t irq_id;
+};
+
+/* ADE9000 IIO attributes */
+enum ade9000_iio_attr_id {
+	ADE9000_IIO_SAMPLING_FREQ,
+	ADE9000_IIO_SAMPLING_FREQ_AVAIL,
+	ADE9000_IIO_WFB_HALVES,
+	ADE9000_IIO_WFB_OVERRUNS,
+};
+
+/**
+ * @brief Initialize the ADE9000 IIO driver
+ * @param iio_desc - Pointer to IIO descriptor pointer
+ * @param init_param - Initialization parameters
+ * @return 0 in case of success, negative error code otherwise
+ */
+int ade9000_iio_init(struct ade9000_iio_desc **iio_desc,
+		     struct ade9000_iio_init_param *init_param);
+
+/**
+ * @brief Free resources allocated by the init function
+ * @param desc - IIO descriptor to free
+ * @return 0 in case of success, negative error code otherwise
+ */
+int ade9000_iio_remove(struct ade9000_iio_desc *desc);
+
+#endif /* __IIO_ADE9000_H__ */
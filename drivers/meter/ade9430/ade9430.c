@@ -154,6 +154,55 @@ int ade9430_read_temp(struct ade9430_dev *dev)
 	return 0;
 }
 
+/**
+ * @brief Read consecutive registers with a single burst.
+ * @param dev - The device structure.
+ * @param reg_addr - The address of the first register. Burst reads are
+ * 		     supported by the waveform buffer and, when BURST_EN is
+ * 		     set, by the 0x500 to 0x63C and 0x680 to 0x6BC ranges.
+ * @param reg_data - The data read from the registers.
+ * @param nb_regs - The number of 32 bits registers to read.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int ade9430_read_burst(struct ade9430_dev *dev, uint16_t reg_addr,
+		       uint32_t *reg_data, uint16_t nb_regs)
+{
+	int ret;
+	/* index */
+	uint16_t i;
+	/* command buffer */
+	uint8_t cmd[2];
+	struct no_os_spi_msg xfer[] = {
+		{
+			.tx_buff = cmd,
+			.bytes_number = sizeof(cmd),
+		},
+		{
+			.rx_buff = (uint8_t *)reg_data,
+			.bytes_number = nb_regs * sizeof(*reg_data),
+			.cs_change = 1,
+		},
+	};
+
+	if (!dev)
+		return -ENODEV;
+	if (!reg_data || !nb_regs)
+		return -EINVAL;
+
+	no_os_put_unaligned_be16(reg_addr << 4, cmd);
+	cmd[1] |= ADE9430_SPI_READ;
+
+	ret = no_os_spi_transfer(dev->spi_desc, xfer, NO_OS_ARRAY_SIZE(xfer));
+	if (ret)
+		return ret;
+
+	/* the registers are received big endian, convert them in place */
+	for (i = 0; i < nb_regs; i++)
+		reg_data[i] = no_os_get_unaligned_be32((uint8_t *)&reg_data[i]);
+
+	return 0;
+}
+
 /**
  * @brief Read the power/energy for specific phase.
  * @param dev - The device structure.
@@ -163,46 +212,31 @@ int ade9430_read_temp(struct ade9430_dev *dev)
 int ade9430_read_data_ph(struct ade9430_dev *dev, enum ade9430_phase phase)
 {
 	int ret;
-	uint32_t temp;
-	uint16_t irms_reg, vrms_reg, watt_reg;
+	uint32_t data[3];
+	uint16_t irms_reg;
 
 	switch (phase) {
 	case ADE9430_PHASE_A:
-		irms_reg = ADE9430_REG_AIRMS;
-		vrms_reg = ADE9430_REG_AVRMS;
-		watt_reg = ADE9430_REG_AWATT;
+		irms_reg = ADE9430_REG_AIRMS_2;
 		break;
 	case ADE9430_PHASE_B:
-		irms_reg = ADE9430_REG_BIRMS;
-		vrms_reg = ADE9430_REG_BVRMS;
-		watt_reg = ADE9430_REG_BWATT;
+		irms_reg = ADE9430_REG_BIRMS_2;
 		break;
 	case ADE9430_PHASE_C:
-		irms_reg = ADE9430_REG_CIRMS;
-		vrms_reg = ADE9430_REG_CVRMS;
-		watt_reg = ADE9430_REG_CWATT;
+		irms_reg = ADE9430_REG_CIRMS_2;
 		break;
 	default:
 		return -EINVAL;
 	}
 
-	ret = ade9430_read(dev, irms_reg, &temp);
-	if (ret)
-		return ret;
-
-	dev->irms_val = temp * ADE9430_I_RES_NA / NANOAMPER_PER_AMPER;
-
-	ret = ade9430_read(dev, vrms_reg, &temp);
+	/* xIRMS_2, xVRMS_2 and xWATT_2 are consecutive, read them at once */
+	ret = ade9430_read_burst(dev, irms_reg, data, NO_OS_ARRAY_SIZE(data));
 	if (ret)
 		return ret;
 
-	dev->vrms_val = temp * ADE9430_V_RES_NV / NANOVOLT_PER_VOLT;
-
-	ret = ade9430_read(dev, watt_reg, &temp);
-	if (ret)
-		return ret;
-
-	dev->watt_val = temp * ADE9430_W_RES_UW / MICROWATT_PER_WATT;
+	dev->irms_val = ((uint64_t)data[0] * ADE9430_IRMS_SCALE_Q32) >> 32;
+	dev->vrms_val = ((uint64_t)data[1] * ADE9430_VRMS_SCALE_Q32) >> 32;
+	dev->watt_val = ((uint64_t)data[2] * ADE9430_WATT_SCALE_Q32) >> 32;
 
 	return 0;
 }
@@ -312,6 +346,12 @@ int ade9430_init(struct ade9430_dev **device,
 		goto error_spi;
 	}
 
+	/* Enable register burst reads, used by ade9430_read_data_ph() */
+	ret = ade9430_update_bits(dev, ADE9430_REG_CONFIG1, ADE9430_BURST_EN,
+				  ADE9430_BURST_EN);
+	if (ret)
+		goto error_spi;
+
 	/* Enable Temperature Sensor */
 	ret = ade9430_update_bits(dev, ADE9430_REG_TEMP_CFG, ADE9430_TEMP_EN,
 				  no_os_field_prep(ADE9430_TEMP_EN, init_param.temp_en));
@@ -330,6 +370,171 @@ error_dev:
 	return ret;
 }
 
+/**
+ * @brief Start the continuous fixed data rate waveform buffer capture of all
+ * 	  the channels. PAGE_FULL is raised each time a buffer half is filled.
+ * @param dev - The device structure.
+ * @param src - The waveform source, which also sets the sample rate.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int ade9430_wfb_start(struct ade9430_dev *dev, enum ade9430_wf_src_e src)
+{
+	int ret;
+
+	if (!dev)
+		return -ENODEV;
+
+	switch (src) {
+	case ADE9430_SRC_SINC4:
+	case ADE9430_SRC_SINC4_IIR:
+	case ADE9430_SRC_DSP:
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	ret = ade9430_wfb_stop(dev);
+	if (ret)
+		return ret;
+
+	/* no trigger events, the buffer is filled continuously */
+	ret = ade9430_write(dev, ADE9430_REG_WFB_TRG_CFG, 0);
+	if (ret)
+		return ret;
+
+	ret = ade9430_write(dev, ADE9430_REG_WFB_PG_IRQEN, ADE9430_WFB_PG_IRQEN);
+	if (ret)
+		return ret;
+
+	ret = ade9430_write(dev, ADE9430_REG_WFB_CFG,
+			    no_os_field_prep(ADE9430_WF_IN_EN, 1) |
+			    no_os_field_prep(ADE9430_WF_SRC, src) |
+			    no_os_field_prep(ADE9430_WF_MODE,
+					     ADE9430_WF_MODE_CONTINUOUS) |
+			    no_os_field_prep(ADE9430_WF_CAP_SEL, 1) |
+			    no_os_field_prep(ADE9430_BURST_CHAN,
+					     ADE9430_WFB_BURST_ALL_CH));
+	if (ret)
+		return ret;
+
+	/* clear a stale page full indicator */
+	ret = ade9430_write(dev, ADE9430_REG_STATUS0, ADE9430_STATUS0_PAGE_FULL);
+	if (ret)
+		return ret;
+
+	ret = ade9430_update_bits(dev, ADE9430_REG_MASK0, ADE9430_MASK0_PAGE_FULL,
+				  ADE9430_MASK0_PAGE_FULL);
+	if (ret)
+		return ret;
+
+	dev->wfb_half = 0;
+	dev->wfb_halves = 0;
+	dev->wfb_overruns = 0;
+
+	return ade9430_update_bits(dev, ADE9430_REG_WFB_CFG, ADE9430_WF_CAP_EN,
+				   ADE9430_WF_CAP_EN);
+}
+
+/**
+ * @brief Stop the waveform buffer capture.
+ * @param dev - The device structure.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int ade9430_wfb_stop(struct ade9430_dev *dev)
+{
+	int ret;
+
+	if (!dev)
+		return -ENODEV;
+
+	ret = ade9430_update_bits(dev, ADE9430_REG_WFB_CFG, ADE9430_WF_CAP_EN, 0);
+	if (ret)
+		return ret;
+
+	return ade9430_update_bits(dev, ADE9430_REG_MASK0,
+				   ADE9430_MASK0_PAGE_FULL, 0);
+}
+
+/**
+ * @brief Burst read waveform buffer pages.
+ * @param dev - The device structure.
+ * @param page - The first page to read.
+ * @param nb_pages - The number of pages to read.
+ * @param data - The samples read, ADE9430_WFB_PAGE_WORDS per page.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int ade9430_wfb_read_pages(struct ade9430_dev *dev, uint8_t page,
+			   uint8_t nb_pages, int32_t *data)
+{
+	if (!nb_pages || page + nb_pages > ADE9430_WFB_PAGES)
+		return -EINVAL;
+
+	return ade9430_read_burst(dev,
+				  ADE9430_WFB_ADDR + page * ADE9430_WFB_PAGE_WORDS,
+				  (uint32_t *)data, nb_pages * ADE9430_WFB_PAGE_WORDS);
+}
+
+/**
+ * @brief Read the waveform buffer half filled since the last call, if any.
+ * 	  Meant to be called on the IRQ0 PAGE_FULL interrupt or polled more
+ * 	  often than a buffer half is filled.
+ * @param dev - The device structure.
+ * @param data - The samples read, ADE9430_WFB_HALF_SETS sets of
+ * 		 ADE9430_WFB_SET_WORDS words.
+ * @param nb_sets - The number of sample sets read, 0 if no half is ready.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int ade9430_wfb_read_ready(struct ade9430_dev *dev, int32_t *data,
+			   uint32_t *nb_sets)
+{
+	int ret;
+	/* register value */
+	uint32_t reg_val;
+	/* last page filled */
+	uint8_t last_page;
+	/* buffer half holding the samples */
+	uint8_t half;
+
+	if (!dev)
+		return -ENODEV;
+	if (!data || !nb_sets)
+		return -EINVAL;
+
+	*nb_sets = 0;
+
+	ret = ade9430_read(dev, ADE9430_REG_STATUS0, &reg_val);
+	if (ret)
+		return ret;
+
+	if (!(reg_val & ADE9430_STATUS0_PAGE_FULL))
+		return 0;
+
+	ret = ade9430_write(dev, ADE9430_REG_STATUS0, ADE9430_STATUS0_PAGE_FULL);
+	if (ret)
+		return ret;
+
+	ret = ade9430_read(dev, ADE9430_REG_WFB_TRG_STAT, &reg_val);
+	if (ret)
+		return ret;
+
+	/* the complete half is the one not being filled */
+	last_page = no_os_field_get(ADE9430_WFB_LAST_PAGE, reg_val);
+	half = !(((last_page + 1) % ADE9430_WFB_PAGES) / ADE9430_WFB_HALF_PAGES);
+	if (half != dev->wfb_half)
+		dev->wfb_overruns++;
+
+	ret = ade9430_wfb_read_pages(dev, half * ADE9430_WFB_HALF_PAGES,
+				     ADE9430_WFB_HALF_PAGES, data);
+	if (ret)
+		return ret;
+
+	dev->wfb_half = !half;
+	dev->wfb_halves++;
+	*nb_sets = ADE9430_WFB_HALF_SETS;
+
+	return 0;
+}
+
 /**
  * @brief Remove the device and release resources.
  * @param dev - The device structure.
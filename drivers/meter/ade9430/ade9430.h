@@ -753,7 +753,7 @@
 /* ADE9430_REG_WFB_CFG Bit Definition */
 #define ADE9430_WF_IN_EN		NO_OS_BIT(12)
 #define ADE9430_WF_SRC			NO_OS_GENMASK(9, 8)
-#define ADE9430_WF_MODE			NO_OS_BIT(7, 6)
+#define ADE9430_WF_MODE			NO_OS_GENMASK(7, 6)
 #define ADE9430_WF_CAP_SEL		NO_OS_BIT(5)
 #define ADE9430_WF_CAP_EN		NO_OS_BIT(4)
 #define ADE9430_BURST_CHAN		NO_OS_GENMASK(3, 0)
@@ -838,6 +838,45 @@
 #define ADE9430_V_RES_NV		13357ULL
 #define ADE9430_W_RES_UW		7203ULL
 
+/* rms and power resolutions as 32.32 fixed point factors, replacing the
+ * 64-bit divisions with a multiplication and a shift */
+#define ADE9430_IRMS_SCALE_Q32		((ADE9430_I_RES_NA << 32) / \
+					 NANOAMPER_PER_AMPER)
+#define ADE9430_VRMS_SCALE_Q32		((ADE9430_V_RES_NV << 32) / \
+					 NANOVOLT_PER_VOLT)
+#define ADE9430_WATT_SCALE_Q32		((ADE9430_W_RES_UW << 32) / \
+					 MICROWATT_PER_WATT)
+
+/* Waveform buffer memory, 2048 32-bit words split in 16 pages */
+#define ADE9430_WFB_ADDR		0x0800
+#define ADE9430_WFB_PAGES		16
+#define ADE9430_WFB_PAGE_WORDS		128
+/* Fixed data rate sample set: IA, VA, IB, VB, IC, VC, IN and one unused word */
+#define ADE9430_WFB_SET_WORDS		8
+#define ADE9430_WFB_PAGE_SETS		(ADE9430_WFB_PAGE_WORDS / ADE9430_WFB_SET_WORDS)
+/* PAGE_FULL is raised when the last page of each buffer half is filled */
+#define ADE9430_WFB_HALF_PAGES		(ADE9430_WFB_PAGES / 2)
+#define ADE9430_WFB_HALF_SETS		(ADE9430_WFB_HALF_PAGES * ADE9430_WFB_PAGE_SETS)
+#define ADE9430_WFB_PG_IRQEN		(NO_OS_BIT(ADE9430_WFB_HALF_PAGES - 1) | \
+					 NO_OS_BIT(ADE9430_WFB_PAGES - 1))
+/* Continuous fill, stopped only by the enabled trigger events */
+#define ADE9430_WF_MODE_CONTINUOUS	1
+/* Burst read of all the channels */
+#define ADE9430_WFB_BURST_ALL_CH	0
+
+/**
+ * @enum ade9430_wf_src_e
+ * @brief Waveform buffer source and sample rate.
+ */
+enum ade9430_wf_src_e {
+	/* Sinc4 output at 32 kSPS */
+	ADE9430_SRC_SINC4,
+	/* Sinc4 + IIR LPF output at 8 kSPS */
+	ADE9430_SRC_SINC4_IIR = 2,
+	/* DSP processed samples at 8 kSPS */
+	ADE9430_SRC_DSP
+};
+
 /**
  * @enum ade9430_phase
  * @brief ADE9430 available phases.
@@ -884,6 +923,12 @@ struct ade9430_dev {
 	uint32_t			vrms_val;
 	/** Variable storing the temperature value in degrees */
 	int32_t				temp_deg;
+	/** Waveform buffer half expected at the next PAGE_FULL */
+	uint8_t				wfb_half;
+	/** Number of waveform buffer halves read */
+	uint32_t			wfb_halves;
+	/** Number of waveform buffer halves overwritten before being read */
+	uint32_t			wfb_overruns;
 };
 
 /* Read device register. */
@@ -912,6 +957,24 @@ int ade9430_set_egy_model(struct ade9430_dev *dev, enum ade9430_egy_model model,
 int ade9430_init(struct ade9430_dev **device,
 		 struct ade9430_init_param init_param);
 
+/* Read consecutive registers with a single burst. */
+int ade9430_read_burst(struct ade9430_dev *dev, uint16_t reg_addr,
+		       uint32_t *reg_data, uint16_t nb_regs);
+
+/* Start the continuous fixed data rate waveform buffer capture. */
+int ade9430_wfb_start(struct ade9430_dev *dev, enum ade9430_wf_src_e src);
+
+/* Stop the waveform buffer capture. */
+int ade9430_wfb_stop(struct ade9430_dev *dev);
+
+/* Burst read waveform buffer pages. */
+int ade9430_wfb_read_pages(struct ade9430_dev *dev, uint8_t page,
+			   uint8_t nb_pages, int32_t *data);
+
+/* Read the waveform buffer half filled since the last call, if any. */
+int ade9430_wfb_read_ready(struct ade9430_dev *dev, int32_t *data,
+			   uint32_t *nb_sets);
+
 /* Remove the device and release resources. */
 int ade9430_remove(struct ade9430_dev *dev);
 
@@ -48,6 +48,9 @@
 
 NO_OS_DECLARE_CRC8_TABLE(_crc_table);
 
+/* Source of the padding bytes for scatter-gather TX frames */
+static uint8_t adin1110_tx_pad[64 + 4];
+
 struct _adin1110_priv {
 	uint32_t phy_id;
 	uint32_t num_ports;
@@ -65,40 +68,57 @@ static struct _adin1110_priv driver_data[2] = {
 };
 
 /**
- * @brief Write a register's value
+ * @brief Fill a buffer with a register write SPI frame
  * @param desc - the device descriptor
+ * @param buff - the buffer to be filled
  * @param addr - register's address
  * @param data - register's value
- * @return 0 in case of success, negative error code otherwise
+ * @return the length of the SPI frame
  */
-static int adin1110_standard_spi_reg_write(struct adin1110_desc *desc,
-		uint16_t addr, uint32_t data)
+static uint32_t adin1110_reg_write_frame(struct adin1110_desc *desc,
+		uint8_t *buff, uint16_t addr, uint32_t data)
 {
 	uint32_t header_len = ADIN1110_WR_HDR_SIZE;
-	struct no_os_spi_msg xfer = {
-		.tx_buff = desc->data,
-		.rx_buff = desc->data,
-		.bytes_number = ADIN1110_WR_FRAME_SIZE,
-		.cs_change = 1,
-	};
+	uint32_t len = ADIN1110_WR_FRAME_SIZE;
 
 	addr &= ADIN1110_ADDR_MASK;
 	addr |= ADIN1110_CD_MASK | ADIN1110_RW_MASK;
-	no_os_put_unaligned_be16(addr, desc->data);
+	no_os_put_unaligned_be16(addr, buff);
 
 	if (desc->append_crc) {
-		desc->data[2] = no_os_crc8(_crc_table, desc->data, 2, 0);
+		buff[2] = no_os_crc8(_crc_table, buff, 2, 0);
 		header_len++;
-		xfer.bytes_number++;
+		len++;
 	}
 
-	no_os_put_unaligned_be32(data, &desc->data[header_len]);
+	no_os_put_unaligned_be32(data, &buff[header_len]);
 	if (desc->append_crc) {
-		desc->data[header_len + ADIN1110_REG_LEN] =
-			no_os_crc8(_crc_table, &desc->data[header_len], ADIN1110_REG_LEN, 0);
-		xfer.bytes_number++;
+		buff[header_len + ADIN1110_REG_LEN] =
+			no_os_crc8(_crc_table, &buff[header_len], ADIN1110_REG_LEN, 0);
+		len++;
 	}
 
+	return len;
+}
+
+/**
+ * @brief Write a register's value
+ * @param desc - the device descriptor
+ * @param addr - register's address
+ * @param data - register's value
+ * @return 0 in case of success, negative error code otherwise
+ */
+static int adin1110_standard_spi_reg_write(struct adin1110_desc *desc,
+		uint16_t addr, uint32_t data)
+{
+	struct no_os_spi_msg xfer = {
+		.tx_buff = desc->data,
+		.rx_buff = desc->data,
+		.cs_change = 1,
+	};
+
+	xfer.bytes_number = adin1110_reg_write_frame(desc, desc->data, addr, data);
+
 	return no_os_spi_transfer(desc->comm_desc, &xfer, 1);
 }
 
@@ -123,6 +143,59 @@ int adin1110_reg_write(struct adin1110_desc *desc, uint16_t addr, uint32_t data)
 	return adin1110_standard_spi_reg_write(desc, addr, data);
 }
 
+/**
+ * @brief Fill a buffer with a register read SPI frame
+ * @param desc - the device descriptor
+ * @param buff - the buffer to be filled
+ * @param addr - register's address
+ * @return the length of the SPI frame
+ */
+static uint32_t adin1110_reg_read_frame(struct adin1110_desc *desc,
+					uint8_t *buff, uint16_t addr)
+{
+	uint32_t len = ADIN1110_RD_HEADER_LEN + ADIN1110_REG_LEN;
+
+	no_os_put_unaligned_be16(addr, &buff[0]);
+	buff[0] |= ADIN1110_SPI_CD;
+	buff[2] = 0x0;
+
+	if (desc->append_crc) {
+		buff[2] = no_os_crc8(_crc_table, buff, 2, 0);
+		buff[3] = 0x0;
+		len += 1 + ADIN1110_CRC_LEN;
+	}
+
+	return len;
+}
+
+/**
+ * @brief Extract the register's value from a received register read SPI frame
+ * @param desc - the device descriptor
+ * @param buff - the received SPI frame
+ * @param data - register's value
+ * @return 0 in case of success, negative error code otherwise
+ */
+static int adin1110_reg_read_parse(struct adin1110_desc *desc, uint8_t *buff,
+				   uint32_t *data)
+{
+	uint32_t header_len = ADIN1110_RD_HEADER_LEN;
+	uint8_t recv_crc;
+	uint8_t crc;
+
+	if (desc->append_crc) {
+		header_len++;
+		crc = no_os_crc8(_crc_table, &buff[header_len], 4, 0);
+		recv_crc = buff[header_len + ADIN1110_REG_LEN];
+
+		if (crc != recv_crc)
+			return -EINVAL;
+	}
+
+	*data = no_os_get_unaligned_be32(&buff[header_len]);
+
+	return 0;
+}
+
 /**
  * @brief Read a register's value
  * @param desc - the device descriptor
@@ -133,44 +206,19 @@ int adin1110_reg_write(struct adin1110_desc *desc, uint16_t addr, uint32_t data)
 static int adin1110_standard_spi_reg_read(struct adin1110_desc *desc,
 		uint16_t addr, uint32_t *data)
 {
-	uint8_t crc;
-	uint8_t recv_crc;
-	uint32_t header_len = ADIN1110_RD_HEADER_LEN;
 	struct no_os_spi_msg xfer = {
 		.tx_buff = desc->data,
 		.rx_buff = desc->data,
-		.bytes_number = ADIN1110_REG_LEN,
 		.cs_change = 1,
 	};
 	int ret;
 
-	no_os_put_unaligned_be16(addr, &desc->data[0]);
-	desc->data[0] |= ADIN1110_SPI_CD;
-	desc->data[2] = 0x0;
-
-	if (desc->append_crc) {
-		xfer.bytes_number += ADIN1110_CRC_LEN;
-		desc->data[2] = no_os_crc8(_crc_table, desc->data, 2, 0);
-		desc->data[3] = 0x0;
-		header_len++;
-	}
-
-	xfer.bytes_number += header_len;
+	xfer.bytes_number = adin1110_reg_read_frame(desc, desc->data, addr);
 	ret = no_os_spi_transfer(desc->comm_desc, &xfer, 1);
 	if (ret)
 		return ret;
 
-	if (desc->append_crc) {
-		crc = no_os_crc8(_crc_table, &desc->data[header_len], 4, 0);
-		recv_crc = desc->data[header_len + ADIN1110_REG_LEN];
-
-		if (crc != recv_crc)
-			return -EINVAL;
-	}
-
-	*data = no_os_get_unaligned_be32(&desc->data[header_len]);
-
-	return 0;
+	return adin1110_reg_read_parse(desc, desc->data, data);
 }
 
 /**
@@ -526,6 +574,39 @@ int adin1110_broadcast_filter(struct adin1110_desc *desc, bool enabled)
 	return adin1110_clear_mac_addr(desc, broadcast_addr);
 }
 
+/**
+ * @brief Reserve space in the TX FIFO for a frame.
+ *
+ * The TX_SPACE register is only read when the locally tracked space is not
+ * enough for the frame. Since the FIFO is drained by the MAC, the tracked
+ * value is a lower bound of the actual free space.
+ * @param desc - the device descriptor
+ * @param padded_len - length of the frame, including the frame header.
+ * @return 0 in case of success, -EAGAIN if the FIFO is full, negative error
+ * 	   code otherwise
+ */
+static int adin1110_tx_reserve(struct adin1110_desc *desc, uint32_t padded_len)
+{
+	uint32_t words;
+	int ret;
+
+	/* The tx_space value is expressed in 16 bit words. */
+	words = no_os_round_up(padded_len, 2) + ADIN1110_FRAME_HEADER_LEN;
+
+	if (desc->tx_space < words) {
+		ret = adin1110_reg_read(desc, ADIN1110_TX_SPACE_REG, &desc->tx_space);
+		if (ret)
+			return ret;
+
+		if (desc->tx_space < words)
+			return -EAGAIN;
+	}
+
+	desc->tx_space -= words;
+
+	return 0;
+}
+
 /**
  * @brief Write a frame to the TX FIFO.
  * @param desc - the device descriptor
@@ -541,7 +622,6 @@ int adin1110_write_fifo(struct adin1110_desc *desc, uint32_t port,
 	uint32_t padding = 0;
 	uint32_t padded_len;
 	uint32_t round_len;
-	uint32_t tx_space;
 	int ret;
 
 	struct no_os_spi_msg xfer = {0};
@@ -588,17 +668,11 @@ int adin1110_write_fifo(struct adin1110_desc *desc, uint32_t port,
 	/** Align the frame length to 4 bytes */
 	round_len = no_os_align(padded_len, 4);
 
-	ret = adin1110_reg_read(desc, ADIN1110_TX_SPACE_REG, &tx_space);
+	/* Check if there is enough space for the frame in the TX FIFO. */
+	ret = adin1110_tx_reserve(desc, padded_len);
 	if (ret)
 		return ret;
 
-	/*
-	 * Check if there is enough space for the frame in the TX FIFO.
-	 * The tx_space value is expressed in 16 bit words.
-	 */
-	if (padded_len > 2 * (tx_space - ADIN1110_FRAME_HEADER_LEN))
-		return -EAGAIN;
-
 	ret = adin1110_reg_write(desc, ADIN1110_TX_FSIZE_REG, padded_len);
 	if (ret)
 		return ret;
@@ -625,6 +699,138 @@ int adin1110_write_fifo(struct adin1110_desc *desc, uint32_t port,
 	return no_os_spi_transfer(desc->comm_desc, &xfer, 1);
 }
 
+/**
+ * @brief Write a frame, scattered over multiple buffers, to the TX FIFO.
+ *
+ * The frame segments are sent straight from the caller's buffers, without
+ * being copied. The TX_FSIZE write, the FIFO header and the segments are
+ * issued as a single chain of SPI messages, with CS kept asserted for the
+ * whole frame. If the SPI platform driver cannot chain messages, the
+ * segments are gathered in the SPI buffer instead.
+ * @param desc - the device descriptor
+ * @param port - the port for the frame to be transmitted on.
+ * @param segs - the frame segments, starting with the destination MAC address.
+ * @param num_segs - number of segments (at most ADIN1110_TX_MAX_SEGS).
+ * @return 0 in case of success, negative error code otherwise
+ */
+int adin1110_write_fifo_sg(struct adin1110_desc *desc, uint32_t port,
+			   struct adin1110_tx_seg *segs, uint32_t num_segs)
+{
+	struct no_os_spi_msg xfer[ADIN1110_TX_MAX_SEGS + 3] = {0};
+	uint32_t header_len = ADIN1110_WR_HEADER_LEN;
+	uint32_t frame_len = 0;
+	uint32_t padding = 0;
+	uint32_t padded_len;
+	uint32_t round_len;
+	uint32_t n = 0;
+	uint32_t i;
+	int ret;
+
+	if (port >= driver_data[desc->chip_type].num_ports)
+		return -EINVAL;
+
+	if (!segs || !num_segs || num_segs > ADIN1110_TX_MAX_SEGS)
+		return -EINVAL;
+
+	for (i = 0; i < num_segs; i++)
+		frame_len += segs[i].len;
+
+	if (frame_len < ADIN1110_ETH_HDR_LEN)
+		return -EINVAL;
+
+	if (desc->oa_tc6_spi) {
+		struct oa_tc6_frame_buffer *oa_frame_buffer;
+		uint32_t frame_offset = 0;
+
+		ret = oa_tc6_get_tx_frame(desc->oa_desc, &oa_frame_buffer);
+		if (ret)
+			return ret;
+
+		for (i = 0; i < num_segs; i++) {
+			memcpy(&oa_frame_buffer->data[frame_offset], segs[i].buff,
+			       segs[i].len);
+			frame_offset += segs[i].len;
+		}
+
+		oa_frame_buffer->len = no_os_max(frame_len, 64);
+		oa_frame_buffer->vs = port;
+
+		oa_tc6_put_tx_frame(desc->oa_desc, oa_frame_buffer);
+
+		return oa_tc6_thread(desc->oa_desc);
+	}
+
+	/* The minimum frame length is 64 bytes */
+	if (frame_len + ADIN1110_FCS_LEN < 64)
+		padding = 64 - (frame_len + ADIN1110_FCS_LEN);
+
+	padded_len = frame_len + padding + ADIN1110_FRAME_HEADER_LEN;
+
+	/** Align the frame length to 4 bytes */
+	round_len = no_os_align(padded_len, 4);
+	if (round_len + ADIN1110_WR_HEADER_LEN + ADIN1110_CRC_LEN >
+	    ADIN1110_BUFF_LEN)
+		return -EINVAL;
+
+	ret = adin1110_tx_reserve(desc, padded_len);
+	if (ret)
+		return ret;
+
+	xfer[n].tx_buff = desc->reg_data;
+	xfer[n].rx_buff = desc->reg_data;
+	xfer[n].bytes_number = adin1110_reg_write_frame(desc, desc->reg_data,
+			       ADIN1110_TX_FSIZE_REG,
+			       padded_len);
+	xfer[n++].cs_change = 1;
+
+	no_os_put_unaligned_be16(ADIN1110_TX_REG, &desc->data[0]);
+	desc->data[0] |= ADIN1110_SPI_CD | ADIN1110_SPI_RW;
+
+	if (desc->append_crc) {
+		desc->data[2] = no_os_crc8(_crc_table, desc->data, 2, 0);
+		header_len++;
+	}
+
+	/* Set the port on which to send the frame */
+	no_os_put_unaligned_be16(port, &desc->data[header_len]);
+	xfer[n].tx_buff = desc->data;
+	xfer[n].rx_buff = desc->data;
+	xfer[n++].bytes_number = header_len + ADIN1110_FRAME_HEADER_LEN;
+
+	if (!desc->comm_desc->platform_ops->transfer) {
+		for (i = 0; i < num_segs; i++) {
+			memcpy(&desc->data[xfer[1].bytes_number], segs[i].buff,
+			       segs[i].len);
+			xfer[1].bytes_number += segs[i].len;
+		}
+		memset(&desc->data[xfer[1].bytes_number], 0,
+		       round_len - ADIN1110_FRAME_HEADER_LEN - frame_len);
+		xfer[1].bytes_number = header_len + round_len;
+		xfer[1].cs_change = 1;
+
+		return no_os_spi_transfer(desc->comm_desc, xfer, n);
+	}
+
+	for (i = 0; i < num_segs; i++) {
+		if (!segs[i].len)
+			continue;
+
+		xfer[n].tx_buff = segs[i].buff;
+		xfer[n++].bytes_number = segs[i].len;
+	}
+
+	/* Minimum frame padding and 4 byte alignment */
+	padding = round_len - ADIN1110_FRAME_HEADER_LEN - frame_len;
+	if (padding) {
+		xfer[n].tx_buff = adin1110_tx_pad;
+		xfer[n++].bytes_number = padding;
+	}
+
+	xfer[n - 1].cs_change = 1;
+
+	return no_os_spi_transfer(desc->comm_desc, xfer, n);
+}
+
 /**
  * @brief Read a frame from the RX FIFO.
  * @param desc - the device descriptor
@@ -721,6 +927,130 @@ int adin1110_read_fifo(struct adin1110_desc *desc, uint32_t port,
 	return 0;
 }
 
+/**
+ * @brief Read all the frames from the RX FIFO.
+ *
+ * Each frame burst read is chained with the read of the RX_FSIZE register,
+ * so the size of the next frame is known without an extra SPI transaction.
+ * The FIFO is drained until it is empty and each frame is passed to a
+ * callback, straight from the SPI buffer.
+ * @param desc - the device descriptor
+ * @param port - the port from which the frames shall be received.
+ * @param cb - callback invoked for each received frame.
+ * @param ctx - context passed to the callback.
+ * @param num_frames - number of frames that were received. May be NULL.
+ * @return 0 in case of success, negative error code otherwise
+ */
+int adin1110_read_fifo_all(struct adin1110_desc *desc, uint32_t port,
+			   adin1110_rx_cb cb, void *ctx, uint32_t *num_frames)
+{
+	struct no_os_spi_msg xfer[2] = {0};
+	struct oa_tc6_frame_buffer *frame;
+	uint32_t fifo_fsize_reg;
+	uint32_t field_offset;
+	uint32_t rounded_len;
+	uint32_t frame_size;
+	uint32_t count = 0;
+	uint32_t fifo_reg;
+	uint32_t rx_len;
+	int ret;
+
+	if (port >= driver_data[desc->chip_type].num_ports || !cb)
+		return -EINVAL;
+
+	if (desc->oa_tc6_spi) {
+		ret = oa_tc6_thread(desc->oa_desc);
+		if (ret)
+			return ret;
+
+		while (!oa_tc6_get_rx_frame_match_vs(desc->oa_desc, &frame, port,
+						     0x1)) {
+			ret = cb(ctx, frame->data, frame->len);
+			oa_tc6_put_rx_frame(desc->oa_desc, frame);
+			if (ret)
+				return ret;
+
+			count++;
+		}
+
+		goto out;
+	}
+
+	if (!port) {
+		fifo_reg = ADIN1110_RX_REG;
+		fifo_fsize_reg = ADIN1110_RX_FSIZE_REG;
+	} else {
+		fifo_reg = ADIN2111_RX_P2_REG;
+		fifo_fsize_reg = ADIN2111_RX_P2_FSIZE_REG;
+	}
+
+	ret = adin1110_reg_read(desc, fifo_fsize_reg, &frame_size);
+	if (ret)
+		return ret;
+
+	xfer[0].tx_buff = desc->data;
+	xfer[0].rx_buff = desc->data;
+	xfer[0].cs_change = 1;
+	xfer[1].tx_buff = desc->reg_data;
+	xfer[1].rx_buff = desc->reg_data;
+	xfer[1].cs_change = 1;
+
+	while (frame_size >= ADIN1110_FRAME_HEADER_LEN + ADIN1110_FEC_LEN) {
+		field_offset = ADIN1110_RD_HEADER_LEN;
+		rounded_len = no_os_align(frame_size, 4);
+		if (rounded_len + field_offset + ADIN1110_CRC_LEN > ADIN1110_BUFF_LEN)
+			return -EINVAL;
+
+		no_os_put_unaligned_be16(fifo_reg, &desc->data[0]);
+		desc->data[0] |= ADIN1110_SPI_CD;
+		desc->data[2] = 0x0;
+
+		if (desc->append_crc) {
+			desc->data[2] = no_os_crc8(_crc_table, desc->data, 2, 0);
+			desc->data[3] = 0x0;
+			field_offset++;
+		}
+
+		/* Set the port from which to receive the frame */
+		no_os_put_unaligned_be16(port, &desc->data[field_offset]);
+		memset(&desc->data[field_offset + ADIN1110_FRAME_HEADER_LEN], 0,
+		       rounded_len - ADIN1110_FRAME_HEADER_LEN);
+
+		/* Can only read multiples of 4 bytes (the last bytes might be 0) */
+		xfer[0].bytes_number = rounded_len + field_offset;
+		field_offset += ADIN1110_FRAME_HEADER_LEN;
+
+		/* Burst read the frame, followed by the size of the next one */
+		xfer[1].bytes_number = adin1110_reg_read_frame(desc, desc->reg_data,
+				       fifo_fsize_reg);
+		ret = no_os_spi_transfer(desc->comm_desc, xfer, 2);
+		if (ret)
+			return ret;
+
+		/*
+		 * The callback may transmit (e.g. the lwIP input path), which
+		 * reuses desc->data and desc->reg_data. Parse the next frame
+		 * size before handing the frame over.
+		 */
+		rx_len = frame_size - ADIN1110_FRAME_HEADER_LEN;
+		ret = adin1110_reg_read_parse(desc, desc->reg_data, &frame_size);
+		if (ret)
+			return ret;
+
+		ret = cb(ctx, &desc->data[field_offset], rx_len);
+		if (ret)
+			return ret;
+
+		count++;
+	}
+
+out:
+	if (num_frames)
+		*num_frames = count;
+
+	return 0;
+}
+
 /**
  * @brief Reset the MAC device.
  * @param desc - the device descriptor
@@ -184,6 +184,9 @@
 #define ADIN1110_CRC_LEN			1
 #define ADIN1110_FEC_LEN			4
 
+/* Maximum number of segments for a scatter-gather TX frame */
+#define ADIN1110_TX_MAX_SEGS			8
+
 #define ADIN_MAC_MULTICAST_ADDR_SLOT		0
 #define ADIN_MAC_BROADCAST_ADDR_SLOT		1
 #define ADIN_MAC_P1_ADDR_SLOT			2
@@ -210,6 +213,10 @@ struct adin1110_desc {
 	struct no_os_gpio_desc *int_gpio;
 	bool oa_tc6_spi;
 	bool append_crc;
+	/* Buffer for register accesses chained to frame transfers */
+	uint8_t reg_data[ADIN1110_RD_FRAME_SIZE + 2 * ADIN1110_CRC_LEN];
+	/* Lower bound of the TX FIFO space (16 bit words) */
+	uint32_t tx_space;
 
 	struct oa_tc6_desc *oa_desc;
 };
@@ -238,6 +245,22 @@ struct adin1110_eth_buff {
 	uint8_t *payload;
 };
 
+/**
+ * @brief Segment of a frame used for scatter-gather TX transactions.
+ */
+struct adin1110_tx_seg {
+	uint8_t *buff;
+	uint32_t len;
+};
+
+/**
+ * @brief Callback invoked for each frame drained from the RX FIFO. The frame
+ * starts with the destination MAC address and is only valid until the
+ * callback returns or transmits a frame on the same device, so copy it first
+ * if the callback may transmit.
+ */
+typedef int (*adin1110_rx_cb)(void *ctx, uint8_t *frame, uint32_t len);
+
 /* Reset both the MAC and PHY. */
 int adin1110_sw_reset(struct adin1110_desc *);
 
@@ -258,6 +281,14 @@ int adin1110_write_fifo(struct adin1110_desc *, uint32_t,
 int adin1110_read_fifo(struct adin1110_desc *, uint32_t,
 		       struct adin1110_eth_buff *);
 
+/* Write a frame, scattered over multiple buffers, to the TX FIFO */
+int adin1110_write_fifo_sg(struct adin1110_desc *, uint32_t,
+			   struct adin1110_tx_seg *, uint32_t);
+
+/* Read all the frames from the RX FIFO */
+int adin1110_read_fifo_all(struct adin1110_desc *, uint32_t, adin1110_rx_cb,
+			   void *, uint32_t *);
+
 /* Write a PHY register using clause 22 */
 int adin1110_mdio_write(struct adin1110_desc *, uint32_t, uint32_t, uint16_t);
 
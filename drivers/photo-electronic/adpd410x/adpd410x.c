@@ -537,6 +537,32 @@ error_slot:
 	return ret;
 }
 
+/**
+ * @brief Assemble a FIFO sample. The FIFO stores the low 16 bits of a sample
+ *        first, each 16 bit word being big endian.
+ * @param buff - Raw FIFO bytes of the sample.
+ * @param datawidth - Number of bytes of the sample, 1 to 4.
+ * @return The sample value.
+ */
+static inline uint32_t adpd410x_fifo_sample(const uint8_t *buff,
+		uint8_t datawidth)
+{
+	switch (datawidth) {
+	case 1:
+		return buff[0];
+	case 2:
+		return ((uint32_t)buff[0] << 8) | buff[1];
+	case 3:
+		return ((uint32_t)buff[0] << 8) | buff[1] |
+		       ((uint32_t)buff[2] << 16);
+	case 4:
+		return ((uint32_t)buff[0] << 8) | buff[1] |
+		       ((uint32_t)buff[2] << 24) | ((uint32_t)buff[3] << 16);
+	default:
+		return 0;
+	}
+}
+
 /**
  * @brief Reads a certain number of bytes from the fifo and stores in data
  *        Used to read a large amount of data from the fifo efficiently (using
@@ -578,30 +604,9 @@ int32_t adpd410x_read_fifo(struct adpd410x_dev *dev, uint32_t *data,
 		bytes_read += next_packet_size;
 	}
 
-	i = 0;
-	for (j = 0; j < num_samples; j++) {
-		switch (datawidth) {
-		case 0:
-			break;
-		case 1:
-			data[j] = data_byte_buff[i++];
-			break;
-		case 2:
-			data[j]  = data_byte_buff[i++] << 8;
-			data[j] |= data_byte_buff[i++];
-			break;
-		case 3:
-			data[j]  = data_byte_buff[i++] << 8;
-			data[j] |= data_byte_buff[i++];
-			data[j] |= data_byte_buff[i++] << 16;
-			break;
-		case 4:
-			data[j]  = data_byte_buff[i++] << 8;
-			data[j] |= data_byte_buff[i++];
-			data[j] |= data_byte_buff[i++] << 24;
-			data[j] |= data_byte_buff[i++] << 16;
-			break;
-		}
+	if (datawidth) {
+		for (i = 0, j = 0; j < num_samples; j++, i += datawidth)
+			data[j] = adpd410x_fifo_sample(data_byte_buff + i, datawidth);
 	}
 
 fifo_free_return:
@@ -641,6 +646,367 @@ int32_t adpd410x_get_data(struct adpd410x_dev *dev, uint32_t *data)
 	return adpd410x_get_data_packet(dev, data, ts_no, dual_chan);
 }
 
+/**
+ * @brief FIFO threshold interrupt callback.
+ * @param context - Device handler.
+ */
+static void adpd410x_stream_irq_handler(void *context)
+{
+	struct adpd410x_dev *dev = context;
+
+	dev->stream.pending = true;
+}
+
+/**
+ * @brief Read the FIFO packet layout from the time slot configuration. Each
+ *        active time slot stores channel 1, then channel 2 if enabled, using
+ *        the slot signal size for both.
+ * @param dev - Device handler.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t adpd410x_stream_layout(struct adpd410x_dev *dev)
+{
+	struct adpd410x_stream *stream = &dev->stream;
+	uint16_t data, ts_ctrl;
+	uint8_t ts_no, i, width;
+	int32_t ret;
+
+	ret = adpd410x_reg_read(dev, ADPD410X_REG_OPMODE, &data);
+	if (ret != 0)
+		return ret;
+	ts_no = ((data & BITM_OPMODE_TIMESLOT_EN) >>
+		 BITP_OPMODE_TIMESLOT_EN) + 1;
+
+	stream->nb_chan = 0;
+	stream->packet_bytes = 0;
+	for (i = 0; i < ts_no; i++) {
+		ret = adpd410x_reg_read(dev, ADPD410X_REG_TS_CTRL(i), &ts_ctrl);
+		if (ret != 0)
+			return ret;
+		ret = adpd410x_reg_read(dev, ADPD410X_REG_DATA1(i), &data);
+		if (ret != 0)
+			return ret;
+
+		width = data & BITM_DATA1_A_SIGNAL_SIZE;
+		if (width > 4)
+			return -EINVAL;
+		if (!width)
+			continue;
+
+		stream->chan_idx[stream->nb_chan] = i * 2;
+		stream->width[stream->nb_chan++] = width;
+		stream->packet_bytes += width;
+		if (ts_ctrl & BITM_TS_CTRL_A_CH2_EN) {
+			stream->chan_idx[stream->nb_chan] = i * 2 + 1;
+			stream->width[stream->nb_chan++] = width;
+			stream->packet_bytes += width;
+		}
+	}
+
+	return stream->packet_bytes ? 0 : -EINVAL;
+}
+
+/**
+ * @brief Start watermark driven continuous FIFO streaming. The FIFO is
+ *        flushed and its threshold interrupt is enabled on INTX, which must
+ *        be routed to a GPIO pin by the application. The operation mode is
+ *        left unchanged.
+ * @param dev - Device handler.
+ * @param packets - Packets read by each drain. The FIFO threshold is set to
+ *                  this amount of data. 0 selects half of the FIFO.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t adpd410x_stream_start(struct adpd410x_dev *dev, uint16_t packets)
+{
+	struct adpd410x_stream *stream;
+	uint32_t drain_bytes;
+	int32_t ret;
+
+	if (!dev || packets > ADPD410X_FIFO_DEPTH)
+		return -EINVAL;
+
+	stream = &dev->stream;
+	if (stream->active)
+		return -EBUSY;
+
+	ret = adpd410x_stream_layout(dev);
+	if (ret != 0)
+		return ret;
+
+	if (!packets)
+		packets = no_os_max(ADPD410X_FIFO_DEPTH / 2 / stream->packet_bytes, 1);
+	drain_bytes = (uint32_t)packets * stream->packet_bytes;
+	if (drain_bytes > ADPD410X_FIFO_DEPTH)
+		return -EINVAL;
+
+	stream->packets = packets;
+	stream->buf = no_os_calloc(drain_bytes + 2, sizeof(*stream->buf));
+	if (!stream->buf)
+		return -ENOMEM;
+	stream->samples = no_os_calloc(packets * stream->nb_chan,
+				       sizeof(*stream->samples));
+	if (!stream->samples) {
+		ret = -ENOMEM;
+		goto error_buf;
+	}
+
+	/* The threshold interrupt is set when the byte count exceeds FIFO_TH */
+	ret = adpd410x_reg_write(dev, ADPD410X_REG_FIFO_TH, drain_bytes - 1);
+	if (ret != 0)
+		goto error_samples;
+
+	ret = adpd410x_reg_write(dev, ADPD410X_REG_FIFO_STATUS,
+				 BITM_INT_STATUS_FIFO_CLEAR_FIFO |
+				 BITM_INT_STATUS_FIFO_INT_FIFO_OFLOW);
+	if (ret != 0)
+		goto error_samples;
+
+	ret = adpd410x_reg_write_mask(dev, ADPD410X_REG_INT_ENABLE_XD,
+				      BITM_INT_ENABLE_XD_INTX_EN_FIFO_TH,
+				      BITM_INT_ENABLE_XD_INTX_EN_FIFO_TH);
+	if (ret != 0)
+		goto error_samples;
+
+	stream->avail = 0;
+	stream->pos = 0;
+	stream->backlog = 0;
+	stream->pending = false;
+
+	if (dev->fifo_irq_ctrl) {
+		stream->irq_cb.callback = adpd410x_stream_irq_handler;
+		stream->irq_cb.ctx = dev;
+		stream->irq_cb.event = NO_OS_EVT_GPIO;
+		stream->irq_cb.peripheral = NO_OS_GPIO_IRQ;
+
+		ret = no_os_irq_register_callback(dev->fifo_irq_ctrl, dev->fifo_irq_id,
+						  &stream->irq_cb);
+		if (ret != 0)
+			goto error_int;
+
+		ret = no_os_irq_trigger_level_set(dev->fifo_irq_ctrl, dev->fifo_irq_id,
+						  NO_OS_IRQ_EDGE_RISING);
+		if (ret != 0)
+			goto error_irq;
+
+		ret = no_os_irq_enable(dev->fifo_irq_ctrl, dev->fifo_irq_id);
+		if (ret != 0)
+			goto error_irq;
+	}
+
+	stream->active = true;
+
+	return 0;
+
+error_irq:
+	no_os_irq_unregister_callback(dev->fifo_irq_ctrl, dev->fifo_irq_id,
+				      &stream->irq_cb);
+error_int:
+	adpd410x_reg_write_mask(dev, ADPD410X_REG_INT_ENABLE_XD, 0,
+				BITM_INT_ENABLE_XD_INTX_EN_FIFO_TH);
+error_samples:
+	no_os_free(stream->samples);
+	stream->samples = NULL;
+error_buf:
+	no_os_free(stream->buf);
+	stream->buf = NULL;
+
+	return ret;
+}
+
+/**
+ * @brief Stop continuous FIFO streaming. The statistics are kept.
+ * @param dev - Device handler.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t adpd410x_stream_stop(struct adpd410x_dev *dev)
+{
+	struct adpd410x_stream *stream;
+	int32_t ret;
+
+	if (!dev)
+		return -EINVAL;
+
+	stream = &dev->stream;
+	if (!stream->active)
+		return 0;
+
+	if (dev->fifo_irq_ctrl) {
+		ret = no_os_irq_disable(dev->fifo_irq_ctrl, dev->fifo_irq_id);
+		if (ret != 0)
+			return ret;
+
+		ret = no_os_irq_unregister_callback(dev->fifo_irq_ctrl,
+						    dev->fifo_irq_id,
+						    &stream->irq_cb);
+		if (ret != 0)
+			return ret;
+	}
+
+	ret = adpd410x_reg_write_mask(dev, ADPD410X_REG_INT_ENABLE_XD, 0,
+				      BITM_INT_ENABLE_XD_INTX_EN_FIFO_TH);
+	if (ret != 0)
+		return ret;
+
+	no_os_free(stream->samples);
+	stream->samples = NULL;
+	no_os_free(stream->buf);
+	stream->buf = NULL;
+	stream->active = false;
+
+	return 0;
+}
+
+/**
+ * @brief Check if a drain would return data without waiting: data was left
+ *        in the FIFO by the previous drain, or the threshold interrupt
+ *        occurred. Without interrupt controller, the FIFO byte count is read.
+ * @param dev - Device handler.
+ * @param ready - Set if a drain may be done.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t adpd410x_stream_ready(struct adpd410x_dev *dev, bool *ready)
+{
+	struct adpd410x_stream *stream;
+	uint32_t drain_bytes;
+	uint16_t bytes;
+	int32_t ret;
+
+	if (!dev || !ready || !dev->stream.active)
+		return -EINVAL;
+
+	stream = &dev->stream;
+	drain_bytes = (uint32_t)stream->packets * stream->packet_bytes;
+
+	if (stream->backlog >= drain_bytes || stream->pending) {
+		*ready = true;
+		return 0;
+	}
+
+	if (dev->fifo_irq_ctrl) {
+		*ready = false;
+		return 0;
+	}
+
+	ret = adpd410x_get_fifo_bytecount(dev, &bytes);
+	if (ret != 0)
+		return ret;
+
+	*ready = bytes >= drain_bytes;
+
+	return 0;
+}
+
+/**
+ * @brief Read one threshold worth of packets from the FIFO and demultiplex
+ *        them in a single pass. On SPI, the FIFO status is read after the
+ *        data in the same transfer, giving the bytes left in the FIFO and the
+ *        overflow flag. After an overflow, the FIFO is flushed so the next
+ *        drain starts on a packet boundary.
+ * @param dev - Device handler.
+ * @param data - Samples, one per active channel (in FIFO order) for each
+ *               packet. Must hold packets * nb_chan values.
+ * @param nb_packets - Number of packets read.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t adpd410x_stream_read(struct adpd410x_dev *dev, uint32_t *data,
+			     uint16_t *nb_packets)
+{
+	struct adpd410x_stream *stream;
+	uint32_t drain_bytes, done, chunk;
+	uint16_t fifo_status;
+	uint8_t *p;
+	uint16_t i;
+	uint8_t c;
+	int32_t ret;
+
+	if (!dev || !data || !nb_packets || !dev->stream.active)
+		return -EINVAL;
+
+	stream = &dev->stream;
+	drain_bytes = (uint32_t)stream->packets * stream->packet_bytes;
+
+	/* Cleared first, so a threshold crossing during the read isn't lost */
+	stream->pending = false;
+
+	if (dev->dev_type == ADPD4100) {
+		struct no_os_spi_msg msgs[] = {
+			{
+				.tx_buff = stream->buf,
+				.bytes_number = 2,
+			},
+			{
+				.rx_buff = stream->buf + 2,
+				.bytes_number = drain_bytes,
+				.cs_change = 1,
+			},
+			{
+				.tx_buff = stream->status,
+				.bytes_number = 2,
+			},
+			{
+				.rx_buff = stream->status + 2,
+				.bytes_number = 2,
+				.cs_change = 1,
+			},
+		};
+
+		stream->buf[0] = no_os_field_get(ADPD410X_UPPDER_BYTE_SPI_MASK,
+						 ADPD410X_REG_FIFO_DATA);
+		stream->buf[1] = (ADPD410X_REG_FIFO_DATA << 1) &
+				 ADPD410X_LOWER_BYTE_SPI_MASK;
+		stream->status[0] = no_os_field_get(ADPD410X_UPPDER_BYTE_SPI_MASK,
+						    ADPD410X_REG_FIFO_STATUS);
+		stream->status[1] = (ADPD410X_REG_FIFO_STATUS << 1) &
+				    ADPD410X_LOWER_BYTE_SPI_MASK;
+
+		ret = no_os_spi_transfer(dev->dev_ops.spi_phy_dev, msgs,
+					 NO_OS_ARRAY_SIZE(msgs));
+		if (ret != 0)
+			return ret;
+
+		fifo_status = no_os_get_unaligned_be16(stream->status + 2);
+	} else {
+		/* Can read a maximum of 255 bytes at once for i2c */
+		for (done = 0; done < drain_bytes; done += chunk) {
+			chunk = no_os_min(drain_bytes - done, 255);
+			ret = adpd410x_reg_read_bytes(dev, ADPD410X_REG_FIFO_DATA,
+						      stream->buf + 2 + done, chunk);
+			if (ret != 0)
+				return ret;
+		}
+
+		ret = adpd410x_reg_read(dev, ADPD410X_REG_FIFO_STATUS, &fifo_status);
+		if (ret != 0)
+			return ret;
+	}
+
+	stream->drains++;
+
+	p = stream->buf + 2;
+	for (i = 0; i < stream->packets; i++) {
+		for (c = 0; c < stream->nb_chan; c++) {
+			*data++ = adpd410x_fifo_sample(p, stream->width[c]);
+			p += stream->width[c];
+		}
+	}
+	*nb_packets = stream->packets;
+
+	stream->backlog = fifo_status & BITM_INT_STATUS_FIFO_FIFO_BYTE_COUNT;
+	if (fifo_status & BITM_INT_STATUS_FIFO_INT_FIFO_OFLOW) {
+		stream->overflows++;
+		stream->dropped += NO_OS_DIV_ROUND_UP(stream->backlog,
+						      stream->packet_bytes);
+		stream->backlog = 0;
+		ret = adpd410x_reg_write(dev, ADPD410X_REG_FIFO_STATUS,
+					 BITM_INT_STATUS_FIFO_CLEAR_FIFO |
+					 BITM_INT_STATUS_FIFO_INT_FIFO_OFLOW);
+		if (ret != 0)
+			return ret;
+	}
+
+	return 0;
+}
+
 /**
  * @brief Setup the device and the driver.
  * @param device - Pointer to the device handler.
@@ -660,6 +1026,8 @@ int32_t adpd410x_setup(struct adpd410x_dev **device,
 
 	dev->dev_type = init_param->dev_type;
 	dev->ext_lfo_freq = init_param->ext_lfo_freq;
+	dev->fifo_irq_ctrl = init_param->fifo_irq_ctrl;
+	dev->fifo_irq_id = init_param->fifo_irq_id;
 
 	if (dev->dev_type == ADPD4100)
 		ret = no_os_spi_init(&dev->dev_ops.spi_phy_dev,
@@ -765,6 +1133,10 @@ int32_t adpd410x_remove(struct adpd410x_dev *dev)
 	if (!dev)
 		return -EINVAL;
 
+	ret = adpd410x_stream_stop(dev);
+	if (ret != 0)
+		return ret;
+
 	if (dev->dev_type == ADPD4100)
 		ret = no_os_spi_remove(dev->dev_ops.spi_phy_dev);
 	else
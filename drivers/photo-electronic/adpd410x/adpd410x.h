@@ -37,6 +37,7 @@
 #include "no_os_spi.h"
 #include "no_os_i2c.h"
 #include "no_os_gpio.h"
+#include "no_os_irq.h"
 
 #define ADPD410X_REG_FIFO_STATUS	0x0000
 #define ADPD410X_REG_INT_STATUS_DATA	0x0001
@@ -862,6 +863,7 @@
 #define ADPD410X_MAX_PULSE_LENGTH           255
 #define ADPD410X_MAX_INTEG_OS               255
 #define ADPD410X_FIFO_DEPTH                 512
+#define ADPD410X_MAX_CHANNELS               (ADPD410X_MAX_SLOT_NUMBER * 2)
 #define ADPD410X_MAX_SAMPLING_FREQ          9000
 
 #define ADPD410X_UPPDER_BYTE_SPI_MASK			0x7f80
@@ -1157,6 +1159,52 @@ struct adpd410x_init_param {
 	struct no_os_gpio_init_param gpio3;
 	/** External low frequency oscillator frequency, if applicable */
 	uint32_t ext_lfo_freq;
+	/** Interrupt controller of the FIFO threshold (INTX) pin, optional */
+	struct no_os_irq_ctrl_desc *fifo_irq_ctrl;
+	/** Interrupt ID of the FIFO threshold (INTX) pin */
+	uint32_t fifo_irq_id;
+};
+
+/**
+ * @struct adpd410x_stream
+ * @brief Continuous FIFO streaming state
+ */
+struct adpd410x_stream {
+	/** Streaming was started */
+	bool active;
+	/** Number of active channels */
+	uint8_t nb_chan;
+	/** Channel index (time slot * 2 + channel) of each active channel, in
+	 *  FIFO order */
+	uint8_t chan_idx[ADPD410X_MAX_CHANNELS];
+	/** Sample width in bytes of each active channel, in FIFO order */
+	uint8_t width[ADPD410X_MAX_CHANNELS];
+	/** Bytes of a packet, containing one sample of each active channel */
+	uint16_t packet_bytes;
+	/** Packets read by each drain */
+	uint16_t packets;
+	/** Command bytes and raw FIFO data */
+	uint8_t *buf;
+	/** FIFO status read after the data, in the same transfer */
+	uint8_t status[4];
+	/** Demultiplexed samples of the last drain, nb_chan per packet */
+	uint32_t *samples;
+	/** Packets of the last drain not yet consumed */
+	uint16_t avail;
+	/** First packet not yet consumed */
+	uint16_t pos;
+	/** FIFO bytes left after the last drain */
+	uint16_t backlog;
+	/** Set by the FIFO threshold interrupt */
+	volatile bool pending;
+	/** FIFO threshold interrupt callback */
+	struct no_os_callback_desc irq_cb;
+	/** Number of drains */
+	uint32_t drains;
+	/** Number of FIFO overflows */
+	uint32_t overflows;
+	/** Number of packets flushed to realign the FIFO */
+	uint32_t dropped;
 };
 
 /**
@@ -1180,6 +1228,12 @@ struct adpd410x_dev {
 	struct no_os_gpio_desc *gpio3;
 	/** External low frequency oscillator frequency, if applicable */
 	uint32_t ext_lfo_freq;
+	/** Interrupt controller of the FIFO threshold (INTX) pin, optional */
+	struct no_os_irq_ctrl_desc *fifo_irq_ctrl;
+	/** Interrupt ID of the FIFO threshold (INTX) pin */
+	uint32_t fifo_irq_id;
+	/** Continuous streaming state */
+	struct adpd410x_stream stream;
 };
 
 /** Read device register. */
@@ -1242,6 +1296,19 @@ int32_t adpd410x_read_fifo(struct adpd410x_dev *dev, uint32_t *data,
  *  slots. */
 int32_t adpd410x_get_data(struct adpd410x_dev *dev, uint32_t *data);
 
+/** Start watermark driven continuous FIFO streaming. */
+int32_t adpd410x_stream_start(struct adpd410x_dev *dev, uint16_t packets);
+
+/** Stop continuous FIFO streaming. */
+int32_t adpd410x_stream_stop(struct adpd410x_dev *dev);
+
+/** Check if a drain would return data without waiting. */
+int32_t adpd410x_stream_ready(struct adpd410x_dev *dev, bool *ready);
+
+/** Read the FIFO in one transfer and demultiplex the packets. */
+int32_t adpd410x_stream_read(struct adpd410x_dev *dev, uint32_t *data,
+			     uint16_t *nb_packets);
+
 /** Setup the device and the driver. */
 int32_t adpd410x_setup(struct adpd410x_dev **device,
 		       struct adpd410x_init_param *init_param);
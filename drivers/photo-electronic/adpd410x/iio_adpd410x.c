@@ -34,12 +34,17 @@
 #include "iio_types.h"
 #include <stdlib.h>
 #include <stdio.h>
+#include <inttypes.h>
 #include <string.h>
 #include "adpd410x.h"
 #include "no_os_util.h"
 #include "no_os_error.h"
+#include "no_os_delay.h"
+#include "iio.h"
 
 #define ADPD410X_IIO_NUM_CH 8
+/* Time to wait for a FIFO threshold crossing, in milliseconds */
+#define ADPD410X_IIO_STREAM_TIMEOUT	100
 
 /**
  * @brief Read ADC Channel data.
@@ -380,6 +385,212 @@ static struct iio_attribute adpd410x_iio_attributes[] = {
 	END_ATTRIBUTES_ARRAY,
 };
 
+/**
+ * @brief Start FIFO streaming for the selected channels.
+ * @param device - Device driver descriptor.
+ * @param mask - Active channels mask.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int adpd410x_iio_stream_pre_enable(void *device, uint32_t mask)
+{
+	struct adpd410x_dev *dev = device;
+	uint32_t configured = 0;
+	uint8_t i;
+	int32_t ret;
+
+	ret = adpd410x_stream_start(dev, 0);
+	if (ret != 0)
+		return ret;
+
+	for (i = 0; i < dev->stream.nb_chan; i++)
+		configured |= NO_OS_BIT(dev->stream.chan_idx[i]);
+
+	/* Channels of disabled time slots are never stored in the FIFO */
+	if (mask & ~configured) {
+		ret = -EINVAL;
+		goto error;
+	}
+
+	ret = adpd410x_set_opmode(dev, ADPD410X_GOMODE);
+	if (ret != 0)
+		goto error;
+
+	return 0;
+error:
+	adpd410x_stream_stop(dev);
+
+	return ret;
+}
+
+/**
+ * @brief Stop FIFO streaming.
+ * @param device - Device driver descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int adpd410x_iio_stream_post_disable(void *device)
+{
+	struct adpd410x_dev *dev = device;
+	int32_t ret;
+
+	ret = adpd410x_set_opmode(dev, ADPD410X_STANDBY);
+	if (ret != 0)
+		return ret;
+
+	return adpd410x_stream_stop(dev);
+}
+
+/**
+ * @brief Fill the IIO buffer with FIFO packets. Each FIFO drain is
+ *        demultiplexed once, the packets left over by a request are used by
+ *        the next one.
+ * @param iio_dev_data - IIO device data.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int adpd410x_iio_stream_submit(struct iio_device_data *iio_dev_data)
+{
+	struct adpd410x_dev *dev = iio_dev_data->dev;
+	struct adpd410x_stream *stream = &dev->stream;
+	uint32_t mask = iio_dev_data->buffer->active_mask;
+	uint32_t scan[ADPD410X_MAX_CHANNELS];
+	uint32_t *packet;
+	uint32_t i, timeout;
+	uint8_t c, k;
+	bool ready;
+	int ret;
+
+	for (i = 0; i < iio_dev_data->buffer->samples; i++) {
+		if (stream->pos == stream->avail) {
+			timeout = ADPD410X_IIO_STREAM_TIMEOUT;
+			do {
+				ret = adpd410x_stream_ready(dev, &ready);
+				if (ret != 0)
+					return ret;
+				if (ready)
+					break;
+				no_os_mdelay(1);
+			} while (--timeout);
+			if (!ready)
+				return -ETIMEDOUT;
+
+			ret = adpd410x_stream_read(dev, stream->samples,
+						   &stream->avail);
+			if (ret != 0)
+				return ret;
+			stream->pos = 0;
+		}
+
+		packet = &stream->samples[stream->pos++ * stream->nb_chan];
+		for (c = 0, k = 0; c < stream->nb_chan; c++)
+			if (mask & NO_OS_BIT(stream->chan_idx[c]))
+				scan[k++] = packet[c];
+
+		ret = iio_buffer_push_scan(iio_dev_data->buffer, scan);
+		if (ret != 0)
+			return ret;
+	}
+
+	return 0;
+}
+
+enum adpd410x_iio_stream_stat {
+	ADPD410X_IIO_FIFO_DRAINS,
+	ADPD410X_IIO_FIFO_OVERFLOWS,
+	ADPD410X_IIO_FIFO_DROPPED,
+};
+
+/**
+ * @brief Get a FIFO streaming statistic.
+ * @param device - Device driver descriptor.
+ * @param buf - Output buffer.
+ * @param len - Length of the output buffer.
+ * @param channel - IIO channel information.
+ * @param priv - Statistic identifier.
+ * @return Number of bytes printed in the output buffer, or negative error code.
+ */
+static int adpd410x_iio_get_stream_stat(void *device, char *buf, uint32_t len,
+					const struct iio_ch_info *channel,
+					intptr_t priv)
+{
+	struct adpd410x_dev *dev = device;
+	uint32_t val;
+
+	switch (priv) {
+	case ADPD410X_IIO_FIFO_DRAINS:
+		val = dev->stream.drains;
+		break;
+	case ADPD410X_IIO_FIFO_OVERFLOWS:
+		val = dev->stream.overflows;
+		break;
+	case ADPD410X_IIO_FIFO_DROPPED:
+		val = dev->stream.dropped;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	return snprintf(buf, len, "%"PRIu32, val);
+}
+
+#define ADPD410X_IIO_STREAM_CHANN_DEF(nm, idx) \
+	{ \
+		.name = nm, \
+		.ch_type = IIO_VOLTAGE, \
+		.channel = idx, \
+		.scan_type = &channel_scan_type, \
+		.scan_index = idx, \
+		.ch_out = false, \
+		.indexed = 1, \
+		.diferential = false, \
+	}
+
+/** IIO Channels of the streaming descriptor, one per time slot channel */
+static struct iio_channel adpd410x_iio_stream_channels[] = {
+	ADPD410X_IIO_STREAM_CHANN_DEF("slotA_ch1", 0),
+	ADPD410X_IIO_STREAM_CHANN_DEF("slotA_ch2", 1),
+	ADPD410X_IIO_STREAM_CHANN_DEF("slotB_ch1", 2),
+	ADPD410X_IIO_STREAM_CHANN_DEF("slotB_ch2", 3),
+	ADPD410X_IIO_STREAM_CHANN_DEF("slotC_ch1", 4),
+	ADPD410X_IIO_STREAM_CHANN_DEF("slotC_ch2", 5),
+	ADPD410X_IIO_STREAM_CHANN_DEF("slotD_ch1", 6),
+	ADPD410X_IIO_STREAM_CHANN_DEF("slotD_ch2", 7),
+	ADPD410X_IIO_STREAM_CHANN_DEF("slotE_ch1", 8),
+	ADPD410X_IIO_STREAM_CHANN_DEF("slotE_ch2", 9),
+	ADPD410X_IIO_STREAM_CHANN_DEF("slotF_ch1", 10),
+	ADPD410X_IIO_STREAM_CHANN_DEF("slotF_ch2", 11),
+	ADPD410X_IIO_STREAM_CHANN_DEF("slotG_ch1", 12),
+	ADPD410X_IIO_STREAM_CHANN_DEF("slotG_ch2", 13),
+	ADPD410X_IIO_STREAM_CHANN_DEF("slotH_ch1", 14),
+	ADPD410X_IIO_STREAM_CHANN_DEF("slotH_ch2", 15),
+	ADPD410X_IIO_STREAM_CHANN_DEF("slotI_ch1", 16),
+	ADPD410X_IIO_STREAM_CHANN_DEF("slotI_ch2", 17),
+	ADPD410X_IIO_STREAM_CHANN_DEF("slotJ_ch1", 18),
+	ADPD410X_IIO_STREAM_CHANN_DEF("slotJ_ch2", 19),
+	ADPD410X_IIO_STREAM_CHANN_DEF("slotK_ch1", 20),
+	ADPD410X_IIO_STREAM_CHANN_DEF("slotK_ch2", 21),
+	ADPD410X_IIO_STREAM_CHANN_DEF("slotL_ch1", 22),
+	ADPD410X_IIO_STREAM_CHANN_DEF("slotL_ch2", 23),
+};
+
+/** IIO debug attributes of the streaming descriptor */
+static struct iio_attribute adpd410x_iio_stream_debug_attributes[] = {
+	{
+		.name = "fifo_drains",
+		.show = adpd410x_iio_get_stream_stat,
+		.priv = ADPD410X_IIO_FIFO_DRAINS,
+	},
+	{
+		.name = "fifo_overflows",
+		.show = adpd410x_iio_get_stream_stat,
+		.priv = ADPD410X_IIO_FIFO_OVERFLOWS,
+	},
+	{
+		.name = "fifo_dropped",
+		.show = adpd410x_iio_get_stream_stat,
+		.priv = ADPD410X_IIO_FIFO_DROPPED,
+	},
+	END_ATTRIBUTES_ARRAY,
+};
+
 /** IIO Descriptor */
 struct iio_device const adpd410x_iio_descriptor = {
 	.num_ch = ADPD410X_IIO_NUM_CH,
@@ -389,3 +600,16 @@ struct iio_device const adpd410x_iio_descriptor = {
 	.debug_reg_read = (int32_t (*)())adpd410x_reg_read,
 	.debug_reg_write = (int32_t (*)())adpd410x_reg_write,
 };
+
+/** IIO Descriptor streaming the FIFO, with one channel per time slot channel */
+struct iio_device const adpd410x_iio_stream_descriptor = {
+	.num_ch = NO_OS_ARRAY_SIZE(adpd410x_iio_stream_channels),
+	.channels = adpd410x_iio_stream_channels,
+	.attributes = adpd410x_iio_attributes,
+	.debug_attributes = adpd410x_iio_stream_debug_attributes,
+	.pre_enable = adpd410x_iio_stream_pre_enable,
+	.post_disable = adpd410x_iio_stream_post_disable,
+	.submit = adpd410x_iio_stream_submit,
+	.debug_reg_read = (int32_t (*)())adpd410x_reg_read,
+	.debug_reg_write = (int32_t (*)())adpd410x_reg_write,
+};
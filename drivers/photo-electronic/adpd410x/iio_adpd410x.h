@@ -38,5 +38,7 @@
 
 /** IIO Descriptor */
 extern struct iio_device const adpd410x_iio_descriptor;
+/** IIO Descriptor streaming the FIFO */
+extern struct iio_device const adpd410x_iio_stream_descriptor;
 
 #endif //IIO_ADPD410X_H
@@ -48,6 +48,15 @@ static struct no_os_timer_desc *dummy_timer;
 /** Used for counting milliseconds */
 static struct no_os_timer_desc *ms_timer;
 
+/** Used by no_os_get_time(), counts microseconds since its first call */
+static struct no_os_timer_desc *time_timer;
+
+/** Microseconds counted by time_timer, extended to 64 bits */
+static uint64_t time_us;
+
+/** Last value read from time_timer */
+static uint32_t time_last;
+
 /**
  * @brief Initialize the timer descriptor
  * @param timer - Value where the instance of the new initialized timer is
@@ -118,3 +127,38 @@ void no_os_mdelay(uint32_t msecs)
 			return ;
 	start_and_wait(ms_timer, msecs);
 }
+
+/**
+ * @brief Get current time.
+ *
+ * The time is counted from the first call with a microsecond timer. The 32 bit
+ * counter wraps every 71 minutes, so the function must be called at least
+ * once in this interval.
+ * @return Current time structure (seconds, microseconds).
+ */
+struct no_os_time no_os_get_time(void)
+{
+	struct no_os_timer_init_param param = {
+		.id = 0,
+		.freq_hz = 1000000u,
+		.ticks_count = 0,
+		.platform_ops = &aducm_timer_ops,
+	};
+	struct no_os_time t = {0};
+	uint32_t count;
+
+	if (!time_timer) {
+		if (no_os_timer_init(&time_timer, &param))
+			return t;
+		no_os_timer_start(time_timer);
+	}
+
+	no_os_timer_counter_get(time_timer, &count);
+	time_us += (uint32_t)(count - time_last);
+	time_last = count;
+
+	t.s = time_us / 1000000u;
+	t.us = time_us % 1000000u;
+
+	return t;
+}
@@ -36,6 +36,7 @@
 #include "no_os_gpio.h"
 #include "no_os_delay.h"
 #include "no_os_alloc.h"
+#include "linux_gpio.h"
 
 #include <errno.h>
 #include <fcntl.h>
@@ -59,6 +60,54 @@ struct linux_gpio_desc {
 
 #define GPIO_TIMEOUT_MS 1000
 
+/**
+ * @brief Open a GPIO chip, waiting for the device node to show up.
+ * @param port - The GPIO chip number.
+ * @return The chip file descriptor in case of success, -1 otherwise.
+ */
+static int linux_gpio_open_chip(uint32_t port)
+{
+	char path[64];
+	int timeout;
+	int fd = -1;
+
+	sprintf(path, "/dev/gpiochip%u", port);
+	timeout = GPIO_TIMEOUT_MS;
+	while (--timeout) {
+		fd = open(path, O_RDONLY);
+		if (fd >= 0)
+			break;
+		no_os_mdelay(1);
+	}
+	if (fd < 0)
+		printf("%s: Can't open %s\n\r", __func__, path);
+
+	return fd;
+}
+
+/**
+ * @brief Fill a line configuration with a per line direction.
+ * @param config - The line configuration.
+ * @param output_mask - Lines configured as outputs, the others are inputs.
+ * @param values - Values of the output lines.
+ */
+static void linux_gpio_fill_config(struct gpio_v2_line_config *config,
+				   uint64_t output_mask, uint64_t values)
+{
+	memset(config, 0, sizeof(*config));
+	config->flags = GPIO_V2_LINE_FLAG_INPUT;
+	if (!output_mask)
+		return;
+
+	config->attrs[0].attr.id = GPIO_V2_LINE_ATTR_ID_FLAGS;
+	config->attrs[0].attr.flags = GPIO_V2_LINE_FLAG_OUTPUT;
+	config->attrs[0].mask = output_mask;
+	config->attrs[1].attr.id = GPIO_V2_LINE_ATTR_ID_OUTPUT_VALUES;
+	config->attrs[1].attr.values = values;
+	config->attrs[1].mask = output_mask;
+	config->num_attrs = 2;
+}
+
 /**
  * @brief Obtain the GPIO decriptor.
  * @param desc - The GPIO descriptor.
@@ -70,9 +119,7 @@ int32_t linux_gpio_get(struct no_os_gpio_desc **desc,
 {
 	struct linux_gpio_desc *linux_desc;
 	struct no_os_gpio_desc *descriptor;
-	char path[64];
 	int ret;
-	int timeout;
 	struct gpiochip_info chip_info = {0};
 	struct gpio_v2_line_info line_info = {0};
 	struct gpio_v2_line_request line_request = {0};
@@ -86,20 +133,12 @@ int32_t linux_gpio_get(struct no_os_gpio_desc **desc,
 		goto free_desc;
 
 	descriptor->extra = linux_desc;
+	descriptor->port = param->port;
 	descriptor->number = param->number;
 
-	sprintf(path, "/dev/gpiochip%d", descriptor->port);
-	timeout = GPIO_TIMEOUT_MS;
-	while (--timeout) {
-		linux_desc->chip_fd = open(path, O_RDONLY);
-		if (linux_desc->chip_fd >= 0)
-			break;
-		no_os_mdelay(1);
-	}
-	if (linux_desc->chip_fd < 0) {
-		printf("%s: Can't open %s\n\r", __func__, path);
-		goto close_dir;
-	}
+	linux_desc->chip_fd = linux_gpio_open_chip(descriptor->port);
+	if (linux_desc->chip_fd < 0)
+		goto free_linux_desc;
 
 	/* Get Chip Info */
 	ret = ioctl(linux_desc->chip_fd, GPIO_GET_CHIPINFO_IOCTL, &chip_info);
@@ -287,16 +326,14 @@ int32_t linux_gpio_direction_output(struct no_os_gpio_desc *desc,
 
 	linux_desc = desc->extra;
 
-	/* Set Line Config */
-	line_config.flags = GPIO_V2_LINE_FLAG_OUTPUT;
+	/* Set Line Config, the value is applied along with the direction */
+	linux_gpio_fill_config(&line_config, 1, value ? 1 : 0);
 	ret = ioctl(linux_desc->line_fd, GPIO_V2_LINE_SET_CONFIG_IOCTL, &line_config);
 	if (ret < 0) {
 		printf("%s: Can't config line\n\r", __func__);
 		return -1;
 	}
 
-	linux_gpio_set_value(desc, value);
-
 	return 0;
 }
 
@@ -334,6 +371,162 @@ int32_t linux_gpio_get_direction(struct no_os_gpio_desc *desc,
 	return 0;
 }
 
+/**
+ * @brief Request a group of lines of the same GPIO chip.
+ * @param desc - The bulk GPIO descriptor.
+ * @param param - Bulk GPIO initialization parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int linux_gpio_bulk_get(struct linux_gpio_bulk_desc **desc,
+			const struct linux_gpio_bulk_init_param *param)
+{
+	struct gpio_v2_line_request line_request = {0};
+	struct linux_gpio_bulk_desc *descriptor;
+	uint64_t all;
+	uint32_t i;
+	int chip_fd;
+	int ret;
+
+	if (!desc || !param || !param->offsets || !param->nb_lines ||
+	    param->nb_lines > LINUX_GPIO_BULK_MAX_LINES)
+		return -EINVAL;
+
+	all = param->nb_lines == 64 ? ~0ULL : (1ULL << param->nb_lines) - 1;
+
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	chip_fd = linux_gpio_open_chip(param->port);
+	if (chip_fd < 0) {
+		ret = -ENODEV;
+		goto free_desc;
+	}
+
+	for (i = 0; i < param->nb_lines; i++)
+		line_request.offsets[i] = param->offsets[i];
+	line_request.num_lines = param->nb_lines;
+	strncpy(line_request.consumer, "no-OS", sizeof(line_request.consumer) - 1);
+	linux_gpio_fill_config(&line_request.config, param->output_mask & all,
+			       param->values);
+
+	ret = ioctl(chip_fd, GPIO_V2_GET_LINE_IOCTL, &line_request);
+	if (ret < 0) {
+		ret = -errno;
+		printf("%s: Can't get line request\n\r", __func__);
+		goto close_chip;
+	}
+
+	/* The line request stays valid after the chip is closed. */
+	close(chip_fd);
+
+	descriptor->line_fd = line_request.fd;
+	descriptor->nb_lines = param->nb_lines;
+	descriptor->output_mask = param->output_mask & all;
+	*desc = descriptor;
+
+	return 0;
+
+close_chip:
+	close(chip_fd);
+free_desc:
+	no_os_free(descriptor);
+
+	return ret;
+}
+
+/**
+ * @brief Release the lines requested by linux_gpio_bulk_get().
+ * @param desc - The bulk GPIO descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int linux_gpio_bulk_remove(struct linux_gpio_bulk_desc *desc)
+{
+	if (!desc)
+		return -EINVAL;
+
+	close(desc->line_fd);
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Change the direction of the lines of a group with a single request.
+ * @param desc - The bulk GPIO descriptor.
+ * @param output_mask - Lines configured as outputs, the others are inputs.
+ * @param values - Values of the output lines.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int linux_gpio_bulk_set_direction(struct linux_gpio_bulk_desc *desc,
+				  uint64_t output_mask, uint64_t values)
+{
+	struct gpio_v2_line_config line_config;
+	uint64_t all;
+
+	if (!desc)
+		return -EINVAL;
+
+	all = desc->nb_lines == 64 ? ~0ULL : (1ULL << desc->nb_lines) - 1;
+	linux_gpio_fill_config(&line_config, output_mask & all, values);
+	if (ioctl(desc->line_fd, GPIO_V2_LINE_SET_CONFIG_IOCTL, &line_config) < 0)
+		return -errno;
+
+	desc->output_mask = output_mask & all;
+
+	return 0;
+}
+
+/**
+ * @brief Atomically set the value of several output lines of a group.
+ * @param desc - The bulk GPIO descriptor.
+ * @param mask - Lines to be updated, bit i refers to the offsets[i] line.
+ * @param values - The new values of the lines in mask.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int linux_gpio_bulk_set_values(struct linux_gpio_bulk_desc *desc,
+			       uint64_t mask, uint64_t values)
+{
+	struct gpio_v2_line_values line_values = {0};
+
+	if (!desc || (mask & ~desc->output_mask))
+		return -EINVAL;
+
+	if (!mask)
+		return 0;
+
+	line_values.mask = mask;
+	line_values.bits = values & mask;
+	if (ioctl(desc->line_fd, GPIO_V2_LINE_SET_VALUES_IOCTL, &line_values) < 0)
+		return -errno;
+
+	return 0;
+}
+
+/**
+ * @brief Atomically get the value of several lines of a group.
+ * @param desc - The bulk GPIO descriptor.
+ * @param mask - Lines to be read, bit i refers to the offsets[i] line.
+ * @param values - The values of the lines in mask, the other bits are 0.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int linux_gpio_bulk_get_values(struct linux_gpio_bulk_desc *desc,
+			       uint64_t mask, uint64_t *values)
+{
+	struct gpio_v2_line_values line_values = {0};
+
+	if (!desc || !values)
+		return -EINVAL;
+
+	line_values.mask = mask;
+	if (ioctl(desc->line_fd, GPIO_V2_LINE_GET_VALUES_IOCTL, &line_values) < 0)
+		return -errno;
+
+	*values = line_values.bits & mask;
+
+	return 0;
+}
+
 /**
  * @brief Linux platform specific GPIO platform ops structure
  */
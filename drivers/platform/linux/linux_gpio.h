@@ -33,9 +33,64 @@
 #ifndef LINUX_GPIO_H_
 #define LINUX_GPIO_H_
 
+#include <stdint.h>
+
+/** Maximum number of lines of a bulk request */
+#define LINUX_GPIO_BULK_MAX_LINES	64
+
+/**
+ * @struct linux_gpio_bulk_init_param
+ * @brief Linux bulk GPIO initialization parameters. Bit i of the masks and
+ * values refers to the offsets[i] line.
+ */
+struct linux_gpio_bulk_init_param {
+	/** GPIO chip number */
+	uint32_t port;
+	/** Line offsets within the chip */
+	const uint32_t *offsets;
+	/** Number of lines, at most LINUX_GPIO_BULK_MAX_LINES */
+	uint32_t nb_lines;
+	/** Lines configured as outputs, the others are inputs */
+	uint64_t output_mask;
+	/** Initial values of the output lines */
+	uint64_t values;
+};
+
+/**
+ * @struct linux_gpio_bulk_desc
+ * @brief Linux bulk GPIO descriptor, all the lines share one line request.
+ */
+struct linux_gpio_bulk_desc {
+	/** Line request file descriptor */
+	int line_fd;
+	/** Number of lines */
+	uint32_t nb_lines;
+	/** Lines configured as outputs */
+	uint64_t output_mask;
+};
+
 /**
  * @brief Linux specific GPIO platform ops structure
  */
 extern const struct no_os_gpio_platform_ops linux_gpio_ops;
 
+/* Request a group of lines of the same GPIO chip. */
+int linux_gpio_bulk_get(struct linux_gpio_bulk_desc **desc,
+			const struct linux_gpio_bulk_init_param *param);
+
+/* Release the lines requested by linux_gpio_bulk_get(). */
+int linux_gpio_bulk_remove(struct linux_gpio_bulk_desc *desc);
+
+/* Change the direction of the lines of a group with a single request. */
+int linux_gpio_bulk_set_direction(struct linux_gpio_bulk_desc *desc,
+				  uint64_t output_mask, uint64_t values);
+
+/* Atomically set the value of several output lines of a group. */
+int linux_gpio_bulk_set_values(struct linux_gpio_bulk_desc *desc,
+			       uint64_t mask, uint64_t values);
+
+/* Atomically get the value of several lines of a group. */
+int linux_gpio_bulk_get_values(struct linux_gpio_bulk_desc *desc,
+			       uint64_t mask, uint64_t *values);
+
 #endif // LINUX_GPIO_H_
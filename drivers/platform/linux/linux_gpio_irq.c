@@ -0,0 +1,819 @@
+/***************************************************************************//**
+ *   @file   linux_gpio_irq.c
+ *   @brief  Linux GPIO edge event IRQ controller.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <linux/gpio.h>
+
+#include "no_os_alloc.h"
+#include "no_os_error.h"
+#include "no_os_irq.h"
+#include "linux_gpio_irq.h"
+
+/** Number of events read from a line at once */
+#define LINUX_GPIO_IRQ_EVENTS	16
+
+/**
+ * @struct linux_gpio_irq_line
+ * @brief State of a GPIO line used as interrupt source.
+ */
+struct linux_gpio_irq_line {
+	/** Line request file descriptor, -1 until the line is requested */
+	int fd;
+	/** Edge detection configured, kept while the line is masked */
+	bool armed;
+	/** Line unmasked, callbacks are called */
+	bool enabled;
+	/** Event received while masked, delivered once unmasked */
+	bool pending;
+	/** Edge(s) generating events */
+	enum no_os_irq_trig_level trig;
+	/** Registered callback */
+	void (*callback)(void *context);
+	/** Parameter passed to the callback */
+	void *ctx;
+	/** Sequence number of the last event */
+	uint32_t line_seqno;
+	/** Last event */
+	struct linux_gpio_irq_event event;
+};
+
+/**
+ * @struct linux_gpio_irq_desc
+ * @brief Linux GPIO IRQ controller descriptor.
+ */
+struct linux_gpio_irq_desc {
+	/** GPIO chip file descriptor */
+	int chip_fd;
+	/** Used to wake up the event thread on configuration changes */
+	int wake_fd;
+	/** Number of lines of the chip */
+	uint32_t nb_lines;
+	/** Line states */
+	struct linux_gpio_irq_line *lines;
+	/** Use CLOCK_REALTIME timestamps */
+	bool realtime_clock;
+	/** Kernel event buffer size per line */
+	uint32_t event_buffer_size;
+	/** Callbacks are only called while set */
+	bool global_enabled;
+	/** Cleared to stop the event thread */
+	bool running;
+	/** Protects the fields above */
+	pthread_mutex_t lock;
+	/** Event thread */
+	pthread_t thread;
+	/** Poll set of the event thread */
+	struct pollfd *pfds;
+	/** Line index of each poll set entry */
+	uint32_t *pfd_line;
+};
+
+/**
+ * @brief Wake up the event thread so that it rebuilds its poll set.
+ * @param irq - Controller descriptor.
+ */
+static void linux_gpio_irq_wake(struct linux_gpio_irq_desc *irq)
+{
+	uint64_t val = 1;
+
+	if (write(irq->wake_fd, &val, sizeof(val)) < 0)
+		return;
+}
+
+/**
+ * @brief Get the line flags matching the state of a line.
+ * @param irq - Controller descriptor.
+ * @param line - Line state.
+ * @return The GPIO v2 line flags.
+ */
+static uint64_t linux_gpio_irq_flags(struct linux_gpio_irq_desc *irq,
+				     struct linux_gpio_irq_line *line)
+{
+	uint64_t flags = GPIO_V2_LINE_FLAG_INPUT;
+
+	if (!line->armed)
+		return flags;
+
+	switch (line->trig) {
+	case NO_OS_IRQ_EDGE_RISING:
+		flags |= GPIO_V2_LINE_FLAG_EDGE_RISING;
+		break;
+	case NO_OS_IRQ_EDGE_FALLING:
+		flags |= GPIO_V2_LINE_FLAG_EDGE_FALLING;
+		break;
+	default:
+		flags |= GPIO_V2_LINE_FLAG_EDGE_RISING |
+			 GPIO_V2_LINE_FLAG_EDGE_FALLING;
+		break;
+	}
+
+	if (irq->realtime_clock)
+		flags |= GPIO_V2_LINE_FLAG_EVENT_CLOCK_REALTIME;
+
+	return flags;
+}
+
+/**
+ * @brief Apply the state of a line, requesting it on first use. Must be
+ * called with the controller lock held.
+ * @param irq - Controller descriptor.
+ * @param irq_id - Line offset.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int linux_gpio_irq_apply(struct linux_gpio_irq_desc *irq,
+				uint32_t irq_id)
+{
+	struct linux_gpio_irq_line *line = &irq->lines[irq_id];
+	struct gpio_v2_line_request request = {0};
+	struct gpio_v2_line_config config = {0};
+	int ret;
+
+	if (line->fd >= 0) {
+		config.flags = linux_gpio_irq_flags(irq, line);
+		ret = ioctl(line->fd, GPIO_V2_LINE_SET_CONFIG_IOCTL, &config);
+		if (ret < 0)
+			return -errno;
+
+		return 0;
+	}
+
+	request.offsets[0] = irq_id;
+	request.num_lines = 1;
+	request.event_buffer_size = irq->event_buffer_size;
+	request.config.flags = linux_gpio_irq_flags(irq, line);
+	strncpy(request.consumer, "no-OS irq", sizeof(request.consumer) - 1);
+
+	ret = ioctl(irq->chip_fd, GPIO_V2_GET_LINE_IOCTL, &request);
+	if (ret < 0) {
+		printf("%s: Can't get line %u\n\r", __func__, irq_id);
+		return -errno;
+	}
+
+	fcntl(request.fd, F_SETFL, fcntl(request.fd, F_GETFL) | O_NONBLOCK);
+	line->fd = request.fd;
+
+	return 0;
+}
+
+/**
+ * @brief Record an edge event and call the line callback.
+ * @param irq - Controller descriptor.
+ * @param irq_id - Line offset.
+ * @param ev - The event read from the line.
+ */
+static void linux_gpio_irq_dispatch(struct linux_gpio_irq_desc *irq,
+				    uint32_t irq_id,
+				    struct gpio_v2_line_event *ev)
+{
+	struct linux_gpio_irq_line *line = &irq->lines[irq_id];
+	void (*callback)(void *context);
+	void *ctx;
+
+	pthread_mutex_lock(&irq->lock);
+
+	if (line->line_seqno && ev->line_seqno > line->line_seqno + 1)
+		line->event.missed += ev->line_seqno - line->line_seqno - 1;
+	line->line_seqno = ev->line_seqno;
+
+	line->event.timestamp_ns = ev->timestamp_ns;
+	line->event.edge = ev->id == GPIO_V2_LINE_EVENT_RISING_EDGE ?
+			   NO_OS_IRQ_EDGE_RISING : NO_OS_IRQ_EDGE_FALLING;
+	line->event.count++;
+
+	callback = NULL;
+	ctx = line->ctx;
+	if (irq->global_enabled && line->enabled)
+		callback = line->callback;
+	else
+		line->pending = true;
+
+	pthread_mutex_unlock(&irq->lock);
+
+	if (callback)
+		callback(ctx);
+}
+
+/**
+ * @brief Call the callbacks of the unmasked lines having a pending event.
+ * @param irq - Controller descriptor.
+ */
+static void linux_gpio_irq_flush_pending(struct linux_gpio_irq_desc *irq)
+{
+	struct linux_gpio_irq_line *line;
+	void (*callback)(void *context);
+	void *ctx;
+	uint32_t i;
+
+	for (i = 0; i < irq->nb_lines; i++) {
+		line = &irq->lines[i];
+
+		pthread_mutex_lock(&irq->lock);
+		callback = NULL;
+		ctx = line->ctx;
+		if (line->pending && irq->global_enabled && line->enabled) {
+			line->pending = false;
+			callback = line->callback;
+		}
+		pthread_mutex_unlock(&irq->lock);
+
+		if (callback)
+			callback(ctx);
+	}
+}
+
+/**
+ * @brief Event thread, waits for edge events on all the armed lines, masked
+ * or not.
+ * @param arg - Controller descriptor.
+ * @return NULL
+ */
+static void *linux_gpio_irq_thread(void *arg)
+{
+	struct gpio_v2_line_event events[LINUX_GPIO_IRQ_EVENTS];
+	struct linux_gpio_irq_desc *irq = arg;
+	uint32_t nfds;
+	uint64_t val;
+	uint32_t i;
+	ssize_t len;
+	ssize_t j;
+	int ret;
+
+	while (true) {
+		pthread_mutex_lock(&irq->lock);
+		if (!irq->running) {
+			pthread_mutex_unlock(&irq->lock);
+			break;
+		}
+
+		irq->pfds[0].fd = irq->wake_fd;
+		irq->pfds[0].events = POLLIN;
+		nfds = 1;
+		/*
+		 * Masked lines keep their edge detection and are still read,
+		 * so that the kernel buffers don't overflow. Their events are
+		 * held as pending and delivered on unmask.
+		 */
+		for (i = 0; i < irq->nb_lines; i++) {
+			if (irq->lines[i].fd < 0 || !irq->lines[i].armed)
+				continue;
+
+			irq->pfds[nfds].fd = irq->lines[i].fd;
+			irq->pfds[nfds].events = POLLIN;
+			irq->pfd_line[nfds] = i;
+			nfds++;
+		}
+		pthread_mutex_unlock(&irq->lock);
+
+		ret = poll(irq->pfds, nfds, -1);
+		if (ret < 0) {
+			if (errno == EINTR)
+				continue;
+			break;
+		}
+
+		if (irq->pfds[0].revents & POLLIN) {
+			if (read(irq->wake_fd, &val, sizeof(val)) < 0)
+				val = 0;
+			linux_gpio_irq_flush_pending(irq);
+		}
+
+		for (i = 1; i < nfds; i++) {
+			if (!(irq->pfds[i].revents & POLLIN))
+				continue;
+
+			len = read(irq->pfds[i].fd, events, sizeof(events));
+			if (len <= 0)
+				continue;
+
+			for (j = 0; j < len / (ssize_t)sizeof(*events); j++)
+				linux_gpio_irq_dispatch(irq, irq->pfd_line[i],
+							&events[j]);
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Initialize the GPIO IRQ controller and start its event thread.
+ * @param desc - The IRQ controller descriptor.
+ * @param param - The IRQ controller initialization parameters, irq_ctrl_id
+ *                is the GPIO chip number.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int linux_gpio_irq_ctrl_init(struct no_os_irq_ctrl_desc **desc,
+				    const struct no_os_irq_init_param *param)
+{
+	struct linux_gpio_irq_init_param *extra;
+	struct gpiochip_info chip_info = {0};
+	struct no_os_irq_ctrl_desc *descriptor;
+	struct linux_gpio_irq_desc *irq;
+	char path[64];
+	uint32_t i;
+	int ret;
+
+	if (!desc || !param)
+		return -EINVAL;
+
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	irq = no_os_calloc(1, sizeof(*irq));
+	if (!irq) {
+		ret = -ENOMEM;
+		goto free_desc;
+	}
+
+	extra = param->extra;
+	if (extra) {
+		irq->realtime_clock = extra->realtime_clock;
+		irq->event_buffer_size = extra->event_buffer_size;
+	}
+
+	sprintf(path, "/dev/gpiochip%u", param->irq_ctrl_id);
+	irq->chip_fd = open(path, O_RDONLY | O_CLOEXEC);
+	if (irq->chip_fd < 0) {
+		printf("%s: Can't open %s\n\r", __func__, path);
+		ret = -errno;
+		goto free_irq;
+	}
+
+	ret = ioctl(irq->chip_fd, GPIO_GET_CHIPINFO_IOCTL, &chip_info);
+	if (ret < 0) {
+		ret = -errno;
+		goto close_chip;
+	}
+
+	irq->nb_lines = chip_info.lines;
+	irq->lines = no_os_calloc(irq->nb_lines, sizeof(*irq->lines));
+	irq->pfds = no_os_calloc(irq->nb_lines + 1, sizeof(*irq->pfds));
+	irq->pfd_line = no_os_calloc(irq->nb_lines + 1, sizeof(*irq->pfd_line));
+	if (!irq->lines || !irq->pfds || !irq->pfd_line) {
+		ret = -ENOMEM;
+		goto free_lines;
+	}
+
+	for (i = 0; i < irq->nb_lines; i++) {
+		irq->lines[i].fd = -1;
+		irq->lines[i].trig = NO_OS_IRQ_EDGE_RISING;
+	}
+
+	irq->wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (irq->wake_fd < 0) {
+		ret = -errno;
+		goto free_lines;
+	}
+
+	ret = -pthread_mutex_init(&irq->lock, NULL);
+	if (ret)
+		goto close_wake;
+
+	irq->global_enabled = true;
+	irq->running = true;
+	ret = -pthread_create(&irq->thread, NULL, linux_gpio_irq_thread, irq);
+	if (ret)
+		goto destroy_lock;
+
+	descriptor->irq_ctrl_id = param->irq_ctrl_id;
+	descriptor->platform_ops = param->platform_ops;
+	descriptor->extra = irq;
+	*desc = descriptor;
+
+	return 0;
+
+destroy_lock:
+	pthread_mutex_destroy(&irq->lock);
+close_wake:
+	close(irq->wake_fd);
+free_lines:
+	no_os_free(irq->pfd_line);
+	no_os_free(irq->pfds);
+	no_os_free(irq->lines);
+close_chip:
+	close(irq->chip_fd);
+free_irq:
+	no_os_free(irq);
+free_desc:
+	no_os_free(descriptor);
+
+	return ret;
+}
+
+/**
+ * @brief Stop the event thread and free the resources allocated by
+ * linux_gpio_irq_ctrl_init(). Must not be called from a callback.
+ * @param desc - The IRQ controller descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int linux_gpio_irq_ctrl_remove(struct no_os_irq_ctrl_desc *desc)
+{
+	struct linux_gpio_irq_desc *irq;
+	uint32_t i;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	irq = desc->extra;
+
+	pthread_mutex_lock(&irq->lock);
+	irq->running = false;
+	pthread_mutex_unlock(&irq->lock);
+	linux_gpio_irq_wake(irq);
+	pthread_join(irq->thread, NULL);
+
+	for (i = 0; i < irq->nb_lines; i++)
+		if (irq->lines[i].fd >= 0)
+			close(irq->lines[i].fd);
+
+	pthread_mutex_destroy(&irq->lock);
+	close(irq->wake_fd);
+	close(irq->chip_fd);
+	no_os_free(irq->pfd_line);
+	no_os_free(irq->pfds);
+	no_os_free(irq->lines);
+	no_os_free(irq);
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Register a line callback. The line is requested as input, events
+ * are generated once it is enabled.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Line offset.
+ * @param cb - Descriptor of the callback.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int linux_gpio_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
+		uint32_t irq_id,
+		struct no_os_callback_desc *cb)
+{
+	struct linux_gpio_irq_desc *irq;
+	int ret;
+
+	if (!desc || !desc->extra || !cb)
+		return -EINVAL;
+
+	irq = desc->extra;
+	if (irq_id >= irq->nb_lines)
+		return -EINVAL;
+
+	pthread_mutex_lock(&irq->lock);
+	irq->lines[irq_id].callback = cb->callback;
+	irq->lines[irq_id].ctx = cb->ctx;
+	ret = 0;
+	if (irq->lines[irq_id].fd < 0)
+		ret = linux_gpio_irq_apply(irq, irq_id);
+	pthread_mutex_unlock(&irq->lock);
+
+	return ret;
+}
+
+/**
+ * @brief Unregister a line callback and disable its events.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Line offset.
+ * @param cb - Descriptor of the callback.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int linux_gpio_irq_unregister_callback(struct no_os_irq_ctrl_desc *desc,
+		uint32_t irq_id,
+		struct no_os_callback_desc *cb)
+{
+	struct linux_gpio_irq_desc *irq;
+	int ret = 0;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	irq = desc->extra;
+	if (irq_id >= irq->nb_lines)
+		return -EINVAL;
+
+	pthread_mutex_lock(&irq->lock);
+	irq->lines[irq_id].callback = NULL;
+	irq->lines[irq_id].ctx = NULL;
+	irq->lines[irq_id].pending = false;
+	irq->lines[irq_id].enabled = false;
+	if (irq->lines[irq_id].armed) {
+		irq->lines[irq_id].armed = false;
+		ret = linux_gpio_irq_apply(irq, irq_id);
+	}
+	pthread_mutex_unlock(&irq->lock);
+	linux_gpio_irq_wake(irq);
+
+	return ret;
+}
+
+/**
+ * @brief Deliver the queued and new events to the callbacks.
+ * @param desc - The IRQ controller descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int linux_gpio_irq_global_enable(struct no_os_irq_ctrl_desc *desc)
+{
+	struct linux_gpio_irq_desc *irq;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	irq = desc->extra;
+	pthread_mutex_lock(&irq->lock);
+	irq->global_enabled = true;
+	pthread_mutex_unlock(&irq->lock);
+	linux_gpio_irq_wake(irq);
+
+	return 0;
+}
+
+/**
+ * @brief Hold the events as pending until re-enabled.
+ * @param desc - The IRQ controller descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int linux_gpio_irq_global_disable(struct no_os_irq_ctrl_desc *desc)
+{
+	struct linux_gpio_irq_desc *irq;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	irq = desc->extra;
+	pthread_mutex_lock(&irq->lock);
+	irq->global_enabled = false;
+	pthread_mutex_unlock(&irq->lock);
+	linux_gpio_irq_wake(irq);
+
+	return 0;
+}
+
+/**
+ * @brief Set the edge(s) generating events. Level triggers are not supported
+ * by the GPIO character device.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Line offset.
+ * @param trig - The trigger condition.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int linux_gpio_irq_trigger_level_set(struct no_os_irq_ctrl_desc *desc,
+		uint32_t irq_id,
+		enum no_os_irq_trig_level trig)
+{
+	struct linux_gpio_irq_desc *irq;
+	int ret = 0;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	irq = desc->extra;
+	if (irq_id >= irq->nb_lines)
+		return -EINVAL;
+
+	switch (trig) {
+	case NO_OS_IRQ_EDGE_RISING:
+	case NO_OS_IRQ_EDGE_FALLING:
+	case NO_OS_IRQ_EDGE_BOTH:
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	pthread_mutex_lock(&irq->lock);
+	irq->lines[irq_id].trig = trig;
+	if (irq->lines[irq_id].fd >= 0)
+		ret = linux_gpio_irq_apply(irq, irq_id);
+	pthread_mutex_unlock(&irq->lock);
+
+	return ret;
+}
+
+/**
+ * @brief Enable the edge detection of a line and deliver the event received
+ * while it was masked, if any.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Line offset.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int linux_gpio_irq_enable(struct no_os_irq_ctrl_desc *desc,
+				 uint32_t irq_id)
+{
+	struct linux_gpio_irq_desc *irq;
+	int ret;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	irq = desc->extra;
+	if (irq_id >= irq->nb_lines)
+		return -EINVAL;
+
+	pthread_mutex_lock(&irq->lock);
+	ret = 0;
+	if (!irq->lines[irq_id].armed) {
+		irq->lines[irq_id].armed = true;
+		ret = linux_gpio_irq_apply(irq, irq_id);
+		if (ret)
+			irq->lines[irq_id].armed = false;
+	}
+	if (!ret)
+		irq->lines[irq_id].enabled = true;
+	pthread_mutex_unlock(&irq->lock);
+	linux_gpio_irq_wake(irq);
+
+	return ret;
+}
+
+/**
+ * @brief Mask a line. The edge detection stays configured, an edge received
+ * while masked is held as pending and delivered by linux_gpio_irq_enable().
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Line offset.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int linux_gpio_irq_disable(struct no_os_irq_ctrl_desc *desc,
+				  uint32_t irq_id)
+{
+	struct linux_gpio_irq_desc *irq;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	irq = desc->extra;
+	if (irq_id >= irq->nb_lines)
+		return -EINVAL;
+
+	pthread_mutex_lock(&irq->lock);
+	irq->lines[irq_id].enabled = false;
+	pthread_mutex_unlock(&irq->lock);
+
+	return 0;
+}
+
+/**
+ * @brief Set the priority of the event thread, shared by all the lines. A
+ * non zero priority selects the SCHED_FIFO policy.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Line offset (unused).
+ * @param priority_level - The SCHED_FIFO priority, 0 for SCHED_OTHER.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int linux_gpio_irq_set_priority(struct no_os_irq_ctrl_desc *desc,
+				       uint32_t irq_id,
+				       uint32_t priority_level)
+{
+	struct linux_gpio_irq_desc *irq;
+	struct sched_param sp = {0};
+	int policy;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	irq = desc->extra;
+	policy = priority_level ? SCHED_FIFO : SCHED_OTHER;
+	sp.sched_priority = priority_level;
+
+	return -pthread_setschedparam(irq->thread, policy, &sp);
+}
+
+/**
+ * @brief Get the priority of the event thread.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Line offset (unused).
+ * @param priority_level - The SCHED_FIFO priority, 0 for SCHED_OTHER.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int linux_gpio_irq_get_priority(struct no_os_irq_ctrl_desc *desc,
+				       uint32_t irq_id,
+				       uint32_t *priority_level)
+{
+	struct linux_gpio_irq_desc *irq;
+	struct sched_param sp;
+	int policy;
+	int ret;
+
+	if (!desc || !desc->extra || !priority_level)
+		return -EINVAL;
+
+	irq = desc->extra;
+	ret = pthread_getschedparam(irq->thread, &policy, &sp);
+	if (ret)
+		return -ret;
+
+	*priority_level = sp.sched_priority;
+
+	return 0;
+}
+
+/**
+ * @brief Drop the events queued on a line.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Line offset.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int linux_gpio_irq_clear_pending(struct no_os_irq_ctrl_desc *desc,
+					uint32_t irq_id)
+{
+	struct gpio_v2_line_event events[LINUX_GPIO_IRQ_EVENTS];
+	struct linux_gpio_irq_desc *irq;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	irq = desc->extra;
+	if (irq_id >= irq->nb_lines)
+		return -EINVAL;
+
+	pthread_mutex_lock(&irq->lock);
+	irq->lines[irq_id].pending = false;
+	if (irq->lines[irq_id].fd >= 0)
+		while (read(irq->lines[irq_id].fd, events, sizeof(events)) > 0)
+			;
+	pthread_mutex_unlock(&irq->lock);
+
+	return 0;
+}
+
+/**
+ * @brief Get the last edge event of a line. When called from the line
+ * callback, the event is the one which triggered the call.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Line offset.
+ * @param event - The last event.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int linux_gpio_irq_get_event(struct no_os_irq_ctrl_desc *desc, uint32_t irq_id,
+			     struct linux_gpio_irq_event *event)
+{
+	struct linux_gpio_irq_desc *irq;
+
+	if (!desc || !desc->extra || !event)
+		return -EINVAL;
+
+	irq = desc->extra;
+	if (irq_id >= irq->nb_lines)
+		return -EINVAL;
+
+	pthread_mutex_lock(&irq->lock);
+	*event = irq->lines[irq_id].event;
+	pthread_mutex_unlock(&irq->lock);
+
+	return 0;
+}
+
+/**
+ * @brief Linux GPIO edge event IRQ platform ops structure
+ */
+const struct no_os_irq_platform_ops linux_gpio_irq_ops = {
+	.init = &linux_gpio_irq_ctrl_init,
+	.register_callback = &linux_gpio_irq_register_callback,
+	.unregister_callback = &linux_gpio_irq_unregister_callback,
+	.global_enable = &linux_gpio_irq_global_enable,
+	.global_disable = &linux_gpio_irq_global_disable,
+	.trigger_level_set = &linux_gpio_irq_trigger_level_set,
+	.enable = &linux_gpio_irq_enable,
+	.disable = &linux_gpio_irq_disable,
+	.set_priority = &linux_gpio_irq_set_priority,
+	.get_priority = &linux_gpio_irq_get_priority,
+	.clear_pending = &linux_gpio_irq_clear_pending,
+	.remove = &linux_gpio_irq_ctrl_remove,
+};
@@ -0,0 +1,75 @@
+/***************************************************************************//**
+ *   @file   linux_gpio_irq.h
+ *   @brief  Header file for Linux GPIO edge event IRQ controller.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef LINUX_GPIO_IRQ_H_
+#define LINUX_GPIO_IRQ_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "no_os_irq.h"
+
+/**
+ * @struct linux_gpio_irq_init_param
+ * @brief Linux GPIO IRQ controller specific parameters. The irq_ctrl_id is
+ * the GPIO chip number and the irq_id is the line offset within the chip.
+ */
+struct linux_gpio_irq_init_param {
+	/** Timestamp events with CLOCK_REALTIME instead of CLOCK_MONOTONIC */
+	bool realtime_clock;
+	/** Kernel event buffer size per line, 0 for the kernel default */
+	uint32_t event_buffer_size;
+};
+
+/**
+ * @struct linux_gpio_irq_event
+ * @brief Last edge event of a line.
+ */
+struct linux_gpio_irq_event {
+	/** Kernel timestamp of the edge, in nanoseconds */
+	uint64_t timestamp_ns;
+	/** NO_OS_IRQ_EDGE_RISING or NO_OS_IRQ_EDGE_FALLING */
+	enum no_os_irq_trig_level edge;
+	/** Number of events received on the line */
+	uint32_t count;
+	/** Number of events dropped by the kernel event buffer */
+	uint32_t missed;
+};
+
+/**
+ * @brief Linux GPIO edge event IRQ platform ops structure
+ */
+extern const struct no_os_irq_platform_ops linux_gpio_irq_ops;
+
+/* Get the last edge event of a line. */
+int linux_gpio_irq_get_event(struct no_os_irq_ctrl_desc *desc, uint32_t irq_id,
+			     struct linux_gpio_irq_event *event);
+
+#endif // LINUX_GPIO_IRQ_H_
@@ -32,19 +32,28 @@
  * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 *******************************************************************************/
 
+
 #include "no_os_error.h"
 #include "no_os_i2c.h"
 #include "no_os_alloc.h"
+#include "no_os_util.h"
 #include "linux_i2c.h"
 
+#include <errno.h>
 #include <fcntl.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 #include <sys/ioctl.h>
 #include <linux/i2c.h>
 #include <linux/i2c-dev.h>
 
+#ifndef I2C_RDWR_IOCTL_MAX_MSGS
+#define I2C_RDWR_IOCTL_MAX_MSGS	42
+#endif
+
 /**
  * @struct linux_i2c_desc
  * @brief Linux platform specific I2C descriptor
@@ -56,81 +65,231 @@ struct linux_i2c_desc {
 	struct i2c_msg *messages;
 	/** count of i2c messages in array */
 	int len_messages;
+	/** allocated size of the message array */
+	int size_messages;
+	/** copy of the data of the queued writes */
+	uint8_t *tx_buff;
+	/** used bytes of tx_buff */
+	uint32_t tx_len;
+	/** allocated size of tx_buff */
+	uint32_t tx_size;
+	/** stop bits only mark the end of a transaction while batching */
+	bool batch;
+	/** the adapter is able to generate a stop condition between messages */
+	bool stop_support;
+	/** number of I2C_RDWR ioctls issued */
+	uint32_t ioctl_cnt;
 };
 
 /**
- * @brief Add I2C messages for a combined I2C R/W transaction.
- * @param desc - The I2C descriptor.
+ * @brief Queue an I2C message. The data of writes is copied, so the caller's
+ * buffer may be reused right away; read buffers must stay valid until the
+ * messages are sent.
+ * @param linux_desc - The Linux I2C descriptor.
+ * @param addr - Slave address.
  * @param data - Buffer that stores the received/transmission data.
  * @param bytes_number - Number of bytes to read/write.
  * @param read - 0 to write, otherwise read.
- * @return 0 in case of success.
+ * @param stop_bit - 1 if a stop condition follows the message.
+ * @return 0 in case of success, negative error code otherwise.
  */
-int linux_i2c_add_msg(struct no_os_i2c_desc *desc,
-		      uint8_t *data,
-		      uint8_t bytes_number,
-		      uint8_t read)
+static int linux_i2c_queue_msg(struct linux_i2c_desc *linux_desc,
+			       uint16_t addr, uint8_t *data,
+			       uint8_t bytes_number, uint8_t read,
+			       uint8_t stop_bit)
 {
-	struct linux_i2c_desc *linux_desc;
-	struct i2c_msg msg;
+	struct i2c_msg *msg;
+	uint32_t size;
 	void *ptr;
 
-	linux_desc = desc->extra;
-
-	msg.addr = desc->slave_address;
-	msg.len = bytes_number;
-	msg.buf = data;
-
-	if (read)
-		msg.flags = I2C_M_RD;
-	else
-		msg.flags = 0;  // Write
-
-
-	if (linux_desc->messages) {
-		ptr = realloc(linux_desc->messages, sizeof(struct i2c_msg) *
-			      (linux_desc->len_messages + 1));
+	if (linux_desc->len_messages == linux_desc->size_messages) {
+		size = linux_desc->size_messages ? 2 * linux_desc->size_messages : 4;
+		ptr = realloc(linux_desc->messages, size * sizeof(struct i2c_msg));
 		if (!ptr)
 			return -ENOMEM;
+
 		linux_desc->messages = ptr;
+		linux_desc->size_messages = size;
+	}
+
+	msg = &linux_desc->messages[linux_desc->len_messages];
+	msg->addr = addr;
+	msg->len = bytes_number;
+	msg->flags = stop_bit ? I2C_M_STOP : 0;
+
+	if (read) {
+		msg->flags |= I2C_M_RD;
+		msg->buf = data;
 	} else {
-		linux_desc->messages = no_os_malloc(sizeof(struct i2c_msg));
-		linux_desc->len_messages = 0;
-		if (!linux_desc->messages)
-			return -ENOMEM;
+		if (linux_desc->tx_len + bytes_number > linux_desc->tx_size) {
+			size = no_os_max(2 * linux_desc->tx_size,
+					 linux_desc->tx_len + bytes_number);
+			ptr = realloc(linux_desc->tx_buff, size);
+			if (!ptr)
+				return -ENOMEM;
+
+			linux_desc->tx_buff = ptr;
+			linux_desc->tx_size = size;
+		}
+
+		memcpy(&linux_desc->tx_buff[linux_desc->tx_len], data, bytes_number);
+		/* tx_buff may move until the messages are sent, keep the offset */
+		msg->buf = (uint8_t *)(uintptr_t)linux_desc->tx_len;
+		linux_desc->tx_len += bytes_number;
 	}
 
-	linux_desc->messages[linux_desc->len_messages] = msg;
 	linux_desc->len_messages++;
 
 	return 0;
 }
 
+/**
+ * @brief Send the queued messages, using as few I2C_RDWR ioctls as possible.
+ * A combined transaction is never split between two ioctls. When the adapter
+ * can't generate a stop condition between messages, each transaction is sent
+ * with its own ioctl.
+ * @param linux_desc - The Linux I2C descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int linux_i2c_flush(struct linux_i2c_desc *linux_desc)
+{
+	struct i2c_rdwr_ioctl_data packets;
+	struct i2c_msg *msgs = linux_desc->messages;
+	int start, end, i;
+	int ret = 0;
+
+	for (i = 0; i < linux_desc->len_messages; i++) {
+		if (!(msgs[i].flags & I2C_M_RD))
+			msgs[i].buf = linux_desc->tx_buff + (uintptr_t)msgs[i].buf;
+		/* The transaction ends with the last message anyway */
+		if (i == linux_desc->len_messages - 1)
+			msgs[i].flags |= I2C_M_STOP;
+	}
+
+	for (start = 0; start < linux_desc->len_messages; start = end) {
+		if (linux_desc->stop_support) {
+			end = no_os_min(start + I2C_RDWR_IOCTL_MAX_MSGS,
+					linux_desc->len_messages);
+
+			/* Cut after the last stop condition which fits */
+			while (end > start && !(msgs[end - 1].flags & I2C_M_STOP))
+				end--;
+		} else {
+			/* Cut after the first stop condition */
+			end = start + 1;
+			while (!(msgs[end - 1].flags & I2C_M_STOP))
+				end++;
+			if (end - start > I2C_RDWR_IOCTL_MAX_MSGS)
+				end = start;
+		}
+		if (end == start) {
+			ret = -E2BIG;
+			break;
+		}
+
+		/* The stop after the last message is implicit */
+		msgs[end - 1].flags &= ~I2C_M_STOP;
+
+		packets.msgs = &msgs[start];
+		packets.nmsgs = end - start;
+
+		linux_desc->ioctl_cnt++;
+		if (ioctl(linux_desc->fd, I2C_RDWR, &packets) < 0) {
+			ret = -errno;
+			break;
+		}
+	}
+
+	linux_desc->len_messages = 0;
+	linux_desc->tx_len = 0;
+
+	return ret;
+}
+
+/**
+ * @brief Add I2C messages for a combined I2C R/W transaction.
+ * @param desc - The I2C descriptor.
+ * @param data - Buffer that stores the received/transmission data.
+ * @param bytes_number - Number of bytes to read/write.
+ * @param read - 0 to write, otherwise read.
+ * @return 0 in case of success.
+ */
+int linux_i2c_add_msg(struct no_os_i2c_desc *desc,
+		      uint8_t *data,
+		      uint8_t bytes_number,
+		      uint8_t read)
+{
+	return linux_i2c_queue_msg(desc->extra, desc->slave_address, data,
+				   bytes_number, read, 0);
+}
+
 /**
  * @brief Send a combined I2C R/W transaction with only one stop bit.
  * @param desc - The I2C descriptor.
  * @return 0 in case of success, -1 otherwise.
  */
 int linux_i2c_send_msg(struct no_os_i2c_desc *desc)
+{
+	if (linux_i2c_flush(desc->extra))
+		return -1;
+
+	return 0;
+}
+
+/**
+ * @brief Start queuing messages: writes are only sent by linux_i2c_batch_end()
+ * or by the next read ending with a stop condition, together with that read,
+ * in a single I2C_RDWR ioctl where possible. Stop conditions between the
+ * queued messages need an adapter supporting protocol mangling, otherwise
+ * each transaction is sent with its own ioctl.
+ * @param desc - The I2C descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int linux_i2c_batch_begin(struct no_os_i2c_desc *desc)
 {
 	struct linux_i2c_desc *linux_desc;
-	struct i2c_rdwr_ioctl_data packets;
-	int32_t ret;
+
+	if (!desc)
+		return -EINVAL;
 
 	linux_desc = desc->extra;
+	if (linux_desc->batch)
+		return -EBUSY;
 
-	packets.msgs = linux_desc->messages;
-	packets.nmsgs = linux_desc->len_messages;
+	linux_desc->batch = true;
 
-	ret = ioctl(linux_desc->fd, I2C_RDWR, &packets);
-	if (ret <= 0)  // True if error or no messages sent.
-		return -1;
+	return 0;
+}
 
-	no_os_free(linux_desc->messages);
-	linux_desc->len_messages = 0;
-	linux_desc->messages = NULL;
+/**
+ * @brief Send the messages queued since linux_i2c_batch_begin() and stop
+ * queuing.
+ * @param desc - The I2C descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int linux_i2c_batch_end(struct no_os_i2c_desc *desc)
+{
+	struct linux_i2c_desc *linux_desc;
 
-	return 0;
+	if (!desc)
+		return -EINVAL;
+
+	linux_desc = desc->extra;
+	linux_desc->batch = false;
+
+	return linux_i2c_flush(linux_desc);
+}
+
+/**
+ * @brief Get the number of I2C_RDWR ioctls issued by a descriptor.
+ * @param desc - The I2C descriptor.
+ * @return The number of ioctls.
+ */
+uint32_t linux_i2c_get_ioctl_count(struct no_os_i2c_desc *desc)
+{
+	struct linux_i2c_desc *linux_desc = desc->extra;
+
+	return linux_desc->ioctl_cnt;
 }
 
 /**
@@ -145,14 +304,14 @@ int linux_i2c_init(struct no_os_i2c_desc **desc,
 	struct linux_i2c_init_param *linux_init;
 	struct linux_i2c_desc *linux_desc;
 	struct no_os_i2c_desc *descriptor;
+	unsigned long funcs;
 	char path[64];
 
 	descriptor = no_os_malloc(sizeof(*descriptor));
 	if (!descriptor)
 		return -1;
 
-	linux_desc = (struct linux_i2c_desc*) no_os_malloc(sizeof(
-				struct linux_i2c_desc));
+	linux_desc = no_os_calloc(1, sizeof(*linux_desc));
 	if (!linux_desc)
 		goto free_desc;
 
@@ -167,6 +326,9 @@ int linux_i2c_init(struct no_os_i2c_desc **desc,
 		goto free;
 	}
 
+	if (!ioctl(linux_desc->fd, I2C_FUNCS, &funcs))
+		linux_desc->stop_support = funcs & I2C_FUNC_PROTOCOL_MANGLING;
+
 	descriptor->slave_address = param->slave_address;
 
 	*desc = descriptor;
@@ -199,6 +361,8 @@ int linux_i2c_remove(struct no_os_i2c_desc *desc)
 		return -1;
 	}
 
+	free(linux_desc->messages);
+	free(linux_desc->tx_buff);
 	no_os_free(desc->extra);
 	no_os_free(desc);
 
@@ -220,16 +384,18 @@ int linux_i2c_write(struct no_os_i2c_desc *desc,
 		    uint8_t bytes_number,
 		    uint8_t stop_bit)
 {
+	struct linux_i2c_desc *linux_desc = desc->extra;
 	int32_t ret;
 
-	ret = linux_i2c_add_msg(desc, data, bytes_number, 0);
+	ret = linux_i2c_queue_msg(linux_desc, desc->slave_address, data,
+				  bytes_number, 0, stop_bit);
 	if (ret) {
 		printf("%s: Can't allocate memory\n\r", __func__);
 		return -1;
 	}
 
-	if (stop_bit) {
-		ret = linux_i2c_send_msg(desc);
+	if (stop_bit && !linux_desc->batch) {
+		ret = linux_i2c_flush(linux_desc);
 		if (ret) {
 			printf("%s: Can't write to file\n\r", __func__);
 			return -1;
@@ -254,16 +420,19 @@ int linux_i2c_read(struct no_os_i2c_desc *desc,
 		   uint8_t bytes_number,
 		   uint8_t stop_bit)
 {
+	struct linux_i2c_desc *linux_desc = desc->extra;
 	int32_t ret;
 
-	ret = linux_i2c_add_msg(desc, data, bytes_number, 1);
+	ret = linux_i2c_queue_msg(linux_desc, desc->slave_address, data,
+				  bytes_number, 1, stop_bit);
 	if (ret) {
 		printf("%s: Can't allocate memory\n\r", __func__);
 		return -1;
 	}
 
+	/* The data is returned right away, even while batching */
 	if (stop_bit) {
-		ret = linux_i2c_send_msg(desc);
+		ret = linux_i2c_flush(linux_desc);
 		if (ret) {
 			printf("%s: Can't read from file\n\r", __func__);
 			return -1;
@@ -273,6 +442,40 @@ int linux_i2c_read(struct no_os_i2c_desc *desc,
 	return 0;
 }
 
+/**
+ * @brief Perform a sequence of reads and writes in a single I2C_RDWR ioctl
+ * (or as few as the kernel limit on the number of messages allows). While
+ * batching, sequences without reads are only queued.
+ * @param desc - The I2C descriptor.
+ * @param msgs - The I2C messages.
+ * @param len - Number of messages.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int linux_i2c_transfer(struct no_os_i2c_desc *desc,
+		       struct no_os_i2c_msg *msgs,
+		       uint32_t len)
+{
+	struct linux_i2c_desc *linux_desc = desc->extra;
+	bool read = false;
+	uint32_t i;
+	int ret;
+
+	for (i = 0; i < len; i++) {
+		ret = linux_i2c_queue_msg(linux_desc, desc->slave_address,
+					  msgs[i].data, msgs[i].bytes_number,
+					  msgs[i].read, msgs[i].stop_bit);
+		if (ret)
+			return ret;
+		read |= msgs[i].read;
+	}
+
+	/* Read data must be available on return, even while batching */
+	if (linux_desc->batch && !read)
+		return 0;
+
+	return linux_i2c_flush(linux_desc);
+}
+
 /**
  * @brief Linux platform specific I2C platform ops structure
  */
@@ -280,5 +483,6 @@ const struct no_os_i2c_platform_ops linux_i2c_ops = {
 	.i2c_ops_init = &linux_i2c_init,
 	.i2c_ops_write = &linux_i2c_write,
 	.i2c_ops_read = &linux_i2c_read,
-	.i2c_ops_remove = &linux_i2c_remove
+	.i2c_ops_remove = &linux_i2c_remove,
+	.i2c_ops_transfer = &linux_i2c_transfer
 };
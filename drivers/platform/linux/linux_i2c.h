@@ -35,6 +35,7 @@
 #define LINUX_I2C_H_
 
 #include <stdint.h>
+#include "no_os_i2c.h"
 
 /**
  * @struct linux_i2c_init_param
@@ -51,4 +52,13 @@ struct linux_i2c_init_param {
  */
 extern const struct no_os_i2c_platform_ops linux_i2c_ops;
 
+/* Start queuing I2C messages instead of sending them. */
+int linux_i2c_batch_begin(struct no_os_i2c_desc *desc);
+
+/* Send the queued I2C messages and stop queuing. */
+int linux_i2c_batch_end(struct no_os_i2c_desc *desc);
+
+/* Get the number of I2C_RDWR ioctls issued by a descriptor. */
+uint32_t linux_i2c_get_ioctl_count(struct no_os_i2c_desc *desc);
+
 #endif // LINUX_I2C_H_
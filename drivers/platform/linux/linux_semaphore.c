@@ -0,0 +1,120 @@
+/***************************************************************************//**
+ *   @file   linux_semaphore.c
+ *   @brief  Implementation of no-OS semaphore functionality using pthreads.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <pthread.h>
+#include <stdbool.h>
+#include "no_os_alloc.h"
+#include "no_os_semaphore.h"
+
+/**
+ * @struct linux_semaphore
+ * @brief Binary semaphore, created with its token available.
+ */
+struct linux_semaphore {
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	bool token;
+};
+
+/**
+ * @brief Initialize semaphore.
+ * @param semaphore - Pointer toward the semaphore, left unchanged if already
+ *                    set.
+ */
+void no_os_semaphore_init(void **semaphore)
+{
+	struct linux_semaphore *sem;
+
+	if (!semaphore || *semaphore)
+		return;
+
+	sem = no_os_calloc(1, sizeof(*sem));
+	if (!sem)
+		return;
+
+	pthread_mutex_init(&sem->lock, NULL);
+	pthread_cond_init(&sem->cond, NULL);
+	sem->token = true;
+
+	*semaphore = sem;
+}
+
+/**
+ * @brief Take token from semaphore, waiting for it to be available.
+ * @param semaphore - Pointer toward the semaphore.
+ */
+void no_os_semaphore_take(void *semaphore)
+{
+	struct linux_semaphore *sem = semaphore;
+
+	if (!sem)
+		return;
+
+	pthread_mutex_lock(&sem->lock);
+	while (!sem->token)
+		pthread_cond_wait(&sem->cond, &sem->lock);
+	sem->token = false;
+	pthread_mutex_unlock(&sem->lock);
+}
+
+/**
+ * @brief Give token to semaphore.
+ * @param semaphore - Pointer toward the semaphore.
+ */
+void no_os_semaphore_give(void *semaphore)
+{
+	struct linux_semaphore *sem = semaphore;
+
+	if (!sem)
+		return;
+
+	pthread_mutex_lock(&sem->lock);
+	sem->token = true;
+	pthread_cond_signal(&sem->cond);
+	pthread_mutex_unlock(&sem->lock);
+}
+
+/**
+ * @brief Remove semaphore.
+ * @param semaphore - Pointer toward the semaphore.
+ */
+void no_os_semaphore_remove(void *semaphore)
+{
+	struct linux_semaphore *sem = semaphore;
+
+	if (!sem)
+		return;
+
+	pthread_cond_destroy(&sem->cond);
+	pthread_mutex_destroy(&sem->lock);
+	no_os_free(sem);
+}
@@ -30,21 +30,29 @@
  * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
  * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 *******************************************************************************/
-
 #include "no_os_error.h"
 #include "no_os_spi.h"
 #include "no_os_alloc.h"
+#include "no_os_print_log.h"
 #include "linux_spi.h"
 
+#include <errno.h>
 #include <fcntl.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/ioctl.h>
 #include <unistd.h>
 #include <linux/spi/spidev.h>
 
 #warning SPI cs_delay_first and cs_delay_last delays are not supported on the linux platform
 
+/* Largest n accepted by SPI_IOC_MESSAGE(n) */
+#define LINUX_SPI_MAX_MSGS	((1 << _IOC_SIZEBITS) / sizeof(struct spi_ioc_transfer) - 1)
+/* spidev default buffer size, used when it can't be read from sysfs */
+#define LINUX_SPI_BUFSIZ	4096
+
 /**
  * @struct linux_spi_desc
  * @brief Linux platform specific SPI descriptor
@@ -52,8 +60,145 @@
 struct linux_spi_desc {
 	/** /dev/spidev"device_id"."chip_select" file descriptor */
 	int spidev_fd;
+	/** Transfer array, reused across calls */
+	struct spi_ioc_transfer *tr;
+	/** Number of allocated transfers */
+	uint32_t tr_size;
+	/** Number of queued transfers */
+	uint32_t tr_len;
+	/** Largest amount of data spidev accepts in a single message */
+	uint32_t bufsiz;
+	/** Queue transfers until linux_spi_batch_end() */
+	bool batch;
+	/** Number of SPI_IOC_MESSAGE ioctls issued */
+	uint32_t ioctl_cnt;
 };
 
+/**
+ * @brief Read the spidev buffer size module parameter.
+ * @return The buffer size in bytes.
+ */
+static uint32_t linux_spi_get_bufsiz(void)
+{
+	unsigned int bufsiz;
+	FILE *f;
+
+	f = fopen("/sys/module/spidev/parameters/bufsiz", "r");
+	if (!f)
+		return LINUX_SPI_BUFSIZ;
+
+	if (fscanf(f, "%u", &bufsiz) != 1 || !bufsiz)
+		bufsiz = LINUX_SPI_BUFSIZ;
+	fclose(f);
+
+	return bufsiz;
+}
+
+/**
+ * @brief Make room for more transfers in the transfer array.
+ * @param linux_desc - The Linux SPI descriptor.
+ * @param len - Number of transfers to be added.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int linux_spi_reserve(struct linux_spi_desc *linux_desc, uint32_t len)
+{
+	struct spi_ioc_transfer *tr;
+	uint32_t size;
+
+	if (linux_desc->tr_len + len <= linux_desc->tr_size)
+		return 0;
+
+	size = linux_desc->tr_size ? linux_desc->tr_size : 8;
+	while (size < linux_desc->tr_len + len)
+		size *= 2;
+
+	tr = realloc(linux_desc->tr, size * sizeof(*tr));
+	if (!tr)
+		return -ENOMEM;
+
+	linux_desc->tr = tr;
+	linux_desc->tr_size = size;
+
+	return 0;
+}
+
+/**
+ * @brief Queue a message at the end of the transfer array.
+ * @param desc - The SPI descriptor.
+ * @param msg - The message.
+ * @param cs_change - Deassert CS after the message.
+ */
+static void linux_spi_queue_msg(struct no_os_spi_desc *desc,
+				const struct no_os_spi_msg *msg,
+				bool cs_change)
+{
+	struct linux_spi_desc *linux_desc = desc->extra;
+	struct spi_ioc_transfer *tr = &linux_desc->tr[linux_desc->tr_len++];
+
+	memset(tr, 0, sizeof(*tr));
+	tr->tx_buf = (unsigned long)msg->tx_buff;
+	tr->rx_buf = (unsigned long)msg->rx_buff;
+	tr->len = msg->bytes_number;
+	tr->cs_change = cs_change;
+	tr->delay_usecs = msg->cs_change_delay;
+	tr->speed_hz = msg->speed_hz ? msg->speed_hz : desc->max_speed_hz;
+	tr->bits_per_word = msg->bits_per_word;
+}
+
+/**
+ * @brief Send the queued transfers, using as few SPI_IOC_MESSAGE ioctls as
+ * the spidev limits allow. Messages are only split where CS is deasserted.
+ * @param linux_desc - The Linux SPI descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int linux_spi_flush(struct linux_spi_desc *linux_desc)
+{
+	struct spi_ioc_transfer *tr;
+	uint32_t bytes;
+	uint32_t start;
+	uint32_t last;
+	uint32_t n;
+	uint32_t i;
+	int ret = 0;
+
+	for (start = 0; start < linux_desc->tr_len; start += n) {
+		tr = &linux_desc->tr[start];
+		bytes = 0;
+		last = 0;
+		for (i = 0; start + i < linux_desc->tr_len; i++) {
+			bytes += tr[i].len;
+			if (i == LINUX_SPI_MAX_MSGS || bytes > linux_desc->bufsiz)
+				break;
+			if (tr[i].cs_change || start + i == linux_desc->tr_len - 1)
+				last = i + 1;
+		}
+
+		n = last;
+		if (!n) {
+			ret = -E2BIG;
+			break;
+		}
+
+		/*
+		 * Until here, cs_change means deassert CS after the transfer.
+		 * spidev inverts it on the last transfer of a message, where
+		 * cs_change keeps CS asserted.
+		 */
+		tr[n - 1].cs_change = !tr[n - 1].cs_change;
+
+		linux_desc->ioctl_cnt++;
+		if (ioctl(linux_desc->spidev_fd, SPI_IOC_MESSAGE(n), tr) < 0) {
+			ret = -errno;
+			pr_err("Can't send spi message (%d)\n", errno);
+			break;
+		}
+	}
+
+	linux_desc->tr_len = 0;
+
+	return ret;
+}
+
 /**
  * @brief Initialize the SPI communication peripheral.
  * @param desc - The SPI descriptor.
@@ -65,20 +210,25 @@ int32_t linux_spi_init(struct no_os_spi_desc **desc,
 {
 	struct linux_spi_desc *linux_desc;
 	struct no_os_spi_desc *descriptor;
+	uint8_t mode = param->mode;
 	uint8_t bits = 8;
 	char path[64];
 	int ret;
 
-	descriptor = no_os_malloc(sizeof(*descriptor));
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
 	if (!descriptor)
 		return -1;
 
-	linux_desc = (struct linux_spi_desc*) no_os_malloc(sizeof(
-				struct linux_spi_desc));
+	linux_desc = no_os_calloc(1, sizeof(*linux_desc));
 	if (!linux_desc)
 		goto free_desc;
 
 	descriptor->extra = linux_desc;
+	descriptor->device_id = param->device_id;
+	descriptor->max_speed_hz = param->max_speed_hz;
+	descriptor->chip_select = param->chip_select;
+	descriptor->mode = param->mode;
+	descriptor->bit_order = param->bit_order;
 
 	snprintf(path, sizeof(path), "/dev/spidev%d.%d",
 		 param->device_id, param->chip_select);
@@ -89,30 +239,33 @@ int32_t linux_spi_init(struct no_os_spi_desc **desc,
 		goto free;
 	}
 
-	ret = ioctl(linux_desc->spidev_fd, SPI_IOC_WR_MODE,
-		    &param->mode);
+	ret = ioctl(linux_desc->spidev_fd, SPI_IOC_WR_MODE, &mode);
 	if (ret == -1) {
 		printf("%s: Can't set SPI mode\n\r", __func__);
-		goto free;
+		goto close_fd;
 	}
 
 	ret = ioctl(linux_desc->spidev_fd, SPI_IOC_WR_BITS_PER_WORD,
 		    &bits);
 	if (ret == -1) {
 		printf("%s: Can't set SPI bits per word\n\r", __func__);
-		goto free;
+		goto close_fd;
 	}
 
 	ret = ioctl(linux_desc->spidev_fd, SPI_IOC_WR_MAX_SPEED_HZ,
 		    &param->max_speed_hz);
 	if (ret == -1) {
 		printf("%s: Can't set SPI max speed hz\n\r", __func__);
-		goto free;
+		goto close_fd;
 	}
 
+	linux_desc->bufsiz = linux_spi_get_bufsiz();
+
 	*desc = descriptor;
 
 	return 0;
+close_fd:
+	close(linux_desc->spidev_fd);
 free:
 	no_os_free(linux_desc);
 free_desc:
@@ -122,33 +275,37 @@ free_desc:
 }
 
 /**
- * @brief Write and read data to/from SPI.
+ * @brief Write and read data to/from SPI. In batch mode, the transfer is
+ * queued and data is only valid after linux_spi_batch_end().
  * @param desc - The SPI descriptor.
  * @param data - The buffer with the transmitted/received data.
  * @param bytes_number - Number of bytes to write/read.
- * @return 0 in case of success, -1 otherwise.
+ * @return 0 in case of success, negative error code otherwise.
  */
 int32_t linux_spi_write_and_read(struct no_os_spi_desc *desc,
 				 uint8_t *data,
 				 uint16_t bytes_number)
 {
-	struct spi_ioc_transfer tr = {
-		.tx_buf = (unsigned long)data,
-		.rx_buf = (unsigned long)data,
-		.len = bytes_number,
+	struct no_os_spi_msg msg = {
+		.tx_buff = data,
+		.rx_buff = data,
+		.bytes_number = bytes_number,
 	};
 	struct linux_spi_desc *linux_desc;
 	int ret;
 
 	linux_desc = desc->extra;
 
-	ret = ioctl(linux_desc->spidev_fd, SPI_IOC_MESSAGE(1), &tr);
-	if (ret == 1) {
-		printf("%s: Can't send spi message\n\r", __func__);
-		return -1;
-	}
+	ret = linux_spi_reserve(linux_desc, 1);
+	if (ret)
+		return ret;
 
-	return 0;
+	linux_spi_queue_msg(desc, &msg, true);
+
+	if (linux_desc->batch)
+		return 0;
+
+	return linux_spi_flush(linux_desc);
 }
 
 /**
@@ -169,47 +326,109 @@ int32_t linux_spi_remove(struct no_os_spi_desc *desc)
 		return -1;
 	}
 
+	free(linux_desc->tr);
 	no_os_free(desc->extra);
 	no_os_free(desc);
 
 	return 0;
 }
 
+/**
+ * @brief Send a chain of messages, CS stays asserted after a message unless
+ * its cs_change is set, including after the last one. In batch mode, the
+ * chain is queued.
+ * @param desc - The SPI descriptor.
+ * @param msgs - Array of messages.
+ * @param len - Number of messages in the array.
+ * @return 0 in case of success, negative error code otherwise.
+ */
 static int32_t linux_spi_transfer(struct no_os_spi_desc *desc,
 				  struct no_os_spi_msg *msgs,
 				  uint32_t len)
 
 {
-	struct spi_ioc_transfer *tr;
 	struct linux_spi_desc	*linux_desc;
 	int			ret;
 	uint32_t		i;
 
+	if (!len)
+		return 0;
+
 	linux_desc = desc->extra;
 
-	tr = (struct spi_ioc_transfer *)no_os_calloc(len, sizeof(*tr));
-	if (!tr)
-		return -ENOMEM;
+	ret = linux_spi_reserve(linux_desc, len);
+	if (ret)
+		return ret;
 
-	for (i = 0; i < len; i++) {
-		tr[i].tx_buf = (unsigned long) msgs[i].tx_buff;
-		tr[i].rx_buf = (unsigned long) msgs[i].rx_buff;
-		tr[i].len = msgs[i].bytes_number;
-		tr[i].cs_change = msgs[i].cs_change;
-		tr[i].word_delay_usecs = msgs[i].cs_change_delay;
-	}
+	for (i = 0; i < len; i++)
+		linux_spi_queue_msg(desc, &msgs[i], msgs[i].cs_change);
 
-	ret = ioctl(linux_desc->spidev_fd, SPI_IOC_MESSAGE(len), tr);
+	if (linux_desc->batch)
+		return 0;
 
-	no_os_free(tr);
+	return linux_spi_flush(linux_desc);
+}
 
-	if (ret < 0) {
-		printf("%s: Can't send spi message (%d)\n\r", __func__, errno);
-		return ret;
-	}
+/**
+ * @brief Start queueing the transfers of a descriptor. Until
+ * linux_spi_batch_end(), write and read calls and message chains are only
+ * queued, so the buffers must stay valid and the received data is not
+ * available yet.
+ * @param desc - The SPI descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int linux_spi_batch_begin(struct no_os_spi_desc *desc)
+{
+	struct linux_spi_desc *linux_desc;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	linux_desc = desc->extra;
+	if (linux_desc->batch)
+		return -EBUSY;
+
+	linux_desc->batch = true;
 
 	return 0;
 }
+
+/**
+ * @brief Send the transfers queued since linux_spi_batch_begin(), in as few
+ * SPI_IOC_MESSAGE ioctls as possible, and leave the batch mode.
+ * @param desc - The SPI descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int linux_spi_batch_end(struct no_os_spi_desc *desc)
+{
+	struct linux_spi_desc *linux_desc;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	linux_desc = desc->extra;
+	linux_desc->batch = false;
+
+	return linux_spi_flush(linux_desc);
+}
+
+/**
+ * @brief Get the number of SPI_IOC_MESSAGE ioctls issued by a descriptor.
+ * @param desc - The SPI descriptor.
+ * @return The ioctl count.
+ */
+uint32_t linux_spi_get_ioctl_count(struct no_os_spi_desc *desc)
+{
+	struct linux_spi_desc *linux_desc;
+
+	if (!desc || !desc->extra)
+		return 0;
+
+	linux_desc = desc->extra;
+
+	return linux_desc->ioctl_cnt;
+}
+
 /**
  * @brief Linux platform specific SPI platform ops structure
  */
@@ -34,9 +34,21 @@
 #ifndef LINUX_SPI_H_
 #define LINUX_SPI_H_
 
+#include <stdint.h>
+#include "no_os_spi.h"
+
 /**
  * @brief Linux specific SPI platform ops structure
  */
 extern const struct no_os_spi_platform_ops linux_spi_ops;
 
+/* Start queueing the transfers of a descriptor. */
+int linux_spi_batch_begin(struct no_os_spi_desc *desc);
+
+/* Send the queued transfers and leave the batch mode. */
+int linux_spi_batch_end(struct no_os_spi_desc *desc);
+
+/* Get the number of SPI_IOC_MESSAGE ioctls issued by a descriptor. */
+uint32_t linux_spi_get_ioctl_count(struct no_os_spi_desc *desc);
+
 #endif // LINUX_SPI_H_
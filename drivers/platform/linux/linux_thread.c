@@ -0,0 +1,389 @@
+/***************************************************************************//**
+ *   @file   linux_thread.c
+ *   @brief  Implementation of Linux threads and work queues.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include "no_os_alloc.h"
+#include "linux_thread.h"
+
+/**
+ * @struct linux_thread
+ * @brief Linux thread descriptor.
+ */
+struct linux_thread {
+	/** POSIX thread */
+	pthread_t thread;
+	/** Thread function */
+	void (*func)(void *ctx);
+	/** Parameter passed to the thread function */
+	void *ctx;
+};
+
+/**
+ * @struct linux_workqueue
+ * @brief Linux work queue descriptor.
+ */
+struct linux_workqueue {
+	/** Protects the fields below */
+	pthread_mutex_t lock;
+	/** Signaled when work is queued or the workers must stop */
+	pthread_cond_t work_cond;
+	/** Signaled when the queue becomes idle */
+	pthread_cond_t idle_cond;
+	/** First queued work item */
+	struct linux_work *head;
+	/** Last queued work item */
+	struct linux_work *tail;
+	/** Number of work items being run */
+	uint32_t busy;
+	/** Set to stop the workers */
+	bool stop;
+	/** Number of workers */
+	uint32_t nb_workers;
+	/** Worker threads */
+	struct linux_thread **workers;
+};
+
+/**
+ * @brief Thread entry point, calls the thread function.
+ * @param arg - Thread descriptor.
+ * @return NULL
+ */
+static void *linux_thread_entry(void *arg)
+{
+	struct linux_thread *thread = arg;
+
+	thread->func(thread->ctx);
+
+	return NULL;
+}
+
+/**
+ * @brief Create a thread.
+ * @param thread - The thread descriptor.
+ * @param param - The thread initialization parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int linux_thread_create(struct linux_thread **thread,
+			const struct linux_thread_init_param *param)
+{
+	struct sched_param sp = {0};
+	struct linux_thread *t;
+	pthread_attr_t attr;
+	cpu_set_t cpus;
+	int ret;
+
+	if (!thread || !param || !param->func)
+		return -EINVAL;
+
+	t = no_os_calloc(1, sizeof(*t));
+	if (!t)
+		return -ENOMEM;
+
+	t->func = param->func;
+	t->ctx = param->ctx;
+
+	ret = pthread_attr_init(&attr);
+	if (ret)
+		goto free_thread;
+
+	if (param->cpu != LINUX_THREAD_ANY_CPU) {
+		CPU_ZERO(&cpus);
+		CPU_SET(param->cpu, &cpus);
+		ret = pthread_attr_setaffinity_np(&attr, sizeof(cpus), &cpus);
+		if (ret)
+			goto destroy_attr;
+	}
+
+	if (param->priority) {
+		sp.sched_priority = param->priority;
+		ret = pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+		if (!ret)
+			ret = pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+		if (!ret)
+			ret = pthread_attr_setschedparam(&attr, &sp);
+		if (ret)
+			goto destroy_attr;
+	}
+
+	ret = pthread_create(&t->thread, &attr, linux_thread_entry, t);
+	if (ret)
+		goto destroy_attr;
+
+	if (param->name)
+		pthread_setname_np(t->thread, param->name);
+
+	pthread_attr_destroy(&attr);
+	*thread = t;
+
+	return 0;
+
+destroy_attr:
+	pthread_attr_destroy(&attr);
+free_thread:
+	no_os_free(t);
+
+	return -ret;
+}
+
+/**
+ * @brief Change the scheduling priority of a running thread.
+ * @param thread - The thread descriptor.
+ * @param priority - SCHED_FIFO priority, 0 for SCHED_OTHER.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int linux_thread_set_priority(struct linux_thread *thread, uint32_t priority)
+{
+	struct sched_param sp = {0};
+	int policy = SCHED_OTHER;
+
+	if (!thread)
+		return -EINVAL;
+
+	if (priority) {
+		if (priority > (uint32_t)sched_get_priority_max(SCHED_FIFO))
+			return -EINVAL;
+		policy = SCHED_FIFO;
+		sp.sched_priority = priority;
+	}
+
+	return -pthread_setschedparam(thread->thread, policy, &sp);
+}
+
+/**
+ * @brief Wait for a thread to return and free its resources.
+ * @param thread - The thread descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int linux_thread_join(struct linux_thread *thread)
+{
+	int ret;
+
+	if (!thread)
+		return -EINVAL;
+
+	ret = pthread_join(thread->thread, NULL);
+	if (ret)
+		return -ret;
+
+	no_os_free(thread);
+
+	return 0;
+}
+
+/**
+ * @brief Worker thread, runs the queued work items in order.
+ * @param ctx - The work queue.
+ */
+static void linux_workqueue_worker(void *ctx)
+{
+	struct linux_workqueue *wq = ctx;
+	struct linux_work *work;
+
+	pthread_mutex_lock(&wq->lock);
+	while (true) {
+		while (!wq->head && !wq->stop)
+			pthread_cond_wait(&wq->work_cond, &wq->lock);
+
+		if (!wq->head)
+			break;
+
+		work = wq->head;
+		wq->head = work->next;
+		if (!wq->head)
+			wq->tail = NULL;
+		/* The work item may be queued again by its own function. */
+		work->next = NULL;
+		work->queued = false;
+		wq->busy++;
+		pthread_mutex_unlock(&wq->lock);
+
+		work->func(work->ctx);
+
+		pthread_mutex_lock(&wq->lock);
+		wq->busy--;
+		if (!wq->head && !wq->busy)
+			pthread_cond_broadcast(&wq->idle_cond);
+	}
+	pthread_mutex_unlock(&wq->lock);
+}
+
+/**
+ * @brief Stop the workers and free the work queue.
+ * @param wq - The work queue.
+ * @param nb_workers - Number of workers started.
+ */
+static void linux_workqueue_free(struct linux_workqueue *wq,
+				 uint32_t nb_workers)
+{
+	uint32_t i;
+
+	pthread_mutex_lock(&wq->lock);
+	wq->stop = true;
+	pthread_cond_broadcast(&wq->work_cond);
+	pthread_mutex_unlock(&wq->lock);
+
+	for (i = 0; i < nb_workers; i++)
+		linux_thread_join(wq->workers[i]);
+
+	pthread_cond_destroy(&wq->idle_cond);
+	pthread_cond_destroy(&wq->work_cond);
+	pthread_mutex_destroy(&wq->lock);
+	no_os_free(wq->workers);
+	no_os_free(wq);
+}
+
+/**
+ * @brief Create a work queue and start its workers.
+ * @param wq - The work queue.
+ * @param param - The work queue initialization parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int linux_workqueue_init(struct linux_workqueue **wq,
+			 const struct linux_workqueue_init_param *param)
+{
+	struct linux_thread_init_param thread_param;
+	struct linux_workqueue *q;
+	uint32_t i;
+	int ret;
+
+	if (!wq || !param || !param->nb_workers)
+		return -EINVAL;
+
+	q = no_os_calloc(1, sizeof(*q));
+	if (!q)
+		return -ENOMEM;
+
+	q->workers = no_os_calloc(param->nb_workers, sizeof(*q->workers));
+	if (!q->workers) {
+		no_os_free(q);
+		return -ENOMEM;
+	}
+
+	pthread_mutex_init(&q->lock, NULL);
+	pthread_cond_init(&q->work_cond, NULL);
+	pthread_cond_init(&q->idle_cond, NULL);
+	q->nb_workers = param->nb_workers;
+
+	thread_param.func = linux_workqueue_worker;
+	thread_param.ctx = q;
+	thread_param.name = param->name;
+	thread_param.cpu = param->cpu;
+	thread_param.priority = param->priority;
+
+	for (i = 0; i < param->nb_workers; i++) {
+		ret = linux_thread_create(&q->workers[i], &thread_param);
+		if (ret) {
+			linux_workqueue_free(q, i);
+			return ret;
+		}
+	}
+
+	*wq = q;
+
+	return 0;
+}
+
+/**
+ * @brief Queue a work item.
+ * @param wq - The work queue.
+ * @param work - The work item, must stay valid until it is run.
+ * @return 0 in case of success, -EBUSY if the work item is already queued,
+ *         negative error code otherwise.
+ */
+int linux_workqueue_queue(struct linux_workqueue *wq, struct linux_work *work)
+{
+	int ret = 0;
+
+	if (!wq || !work || !work->func)
+		return -EINVAL;
+
+	pthread_mutex_lock(&wq->lock);
+	if (wq->stop) {
+		ret = -ESHUTDOWN;
+	} else if (work->queued) {
+		ret = -EBUSY;
+	} else {
+		work->queued = true;
+		work->next = NULL;
+		if (wq->tail)
+			wq->tail->next = work;
+		else
+			wq->head = work;
+		wq->tail = work;
+		pthread_cond_signal(&wq->work_cond);
+	}
+	pthread_mutex_unlock(&wq->lock);
+
+	return ret;
+}
+
+/**
+ * @brief Wait until all the queued work items are done. Must not be called
+ * from a work item.
+ * @param wq - The work queue.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int linux_workqueue_flush(struct linux_workqueue *wq)
+{
+	if (!wq)
+		return -EINVAL;
+
+	pthread_mutex_lock(&wq->lock);
+	while (wq->head || wq->busy)
+		pthread_cond_wait(&wq->idle_cond, &wq->lock);
+	pthread_mutex_unlock(&wq->lock);
+
+	return 0;
+}
+
+/**
+ * @brief Run the queued work items, then stop the workers and free the queue.
+ * @param wq - The work queue.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int linux_workqueue_remove(struct linux_workqueue *wq)
+{
+	int ret;
+
+	ret = linux_workqueue_flush(wq);
+	if (ret)
+		return ret;
+
+	linux_workqueue_free(wq, wq->nb_workers);
+
+	return 0;
+}
@@ -0,0 +1,114 @@
+/***************************************************************************//**
+ *   @file   linux_thread.h
+ *   @brief  Header file for Linux threads and work queues.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef LINUX_THREAD_H_
+#define LINUX_THREAD_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** Run on any CPU */
+#define LINUX_THREAD_ANY_CPU	-1
+
+struct linux_thread;
+struct linux_workqueue;
+
+/**
+ * @struct linux_thread_init_param
+ * @brief Linux thread initialization parameters.
+ */
+struct linux_thread_init_param {
+	/** Thread function */
+	void (*func)(void *ctx);
+	/** Parameter passed to the thread function */
+	void *ctx;
+	/** Thread name, at most 15 characters, may be NULL */
+	const char *name;
+	/** CPU the thread is pinned to, or LINUX_THREAD_ANY_CPU */
+	int32_t cpu;
+	/** SCHED_FIFO priority, 0 for SCHED_OTHER */
+	uint32_t priority;
+};
+
+/**
+ * @struct linux_work
+ * @brief Work item, owned by the caller and queued without allocation.
+ */
+struct linux_work {
+	/** Work function */
+	void (*func)(void *ctx);
+	/** Parameter passed to the work function */
+	void *ctx;
+	/** Next queued work item, private to the work queue */
+	struct linux_work *next;
+	/** Set while the work item is queued, private to the work queue */
+	bool queued;
+};
+
+/**
+ * @struct linux_workqueue_init_param
+ * @brief Linux work queue initialization parameters.
+ */
+struct linux_workqueue_init_param {
+	/** Number of worker threads */
+	uint32_t nb_workers;
+	/** Worker thread name, at most 15 characters, may be NULL */
+	const char *name;
+	/** CPU the workers are pinned to, or LINUX_THREAD_ANY_CPU */
+	int32_t cpu;
+	/** SCHED_FIFO priority of the workers, 0 for SCHED_OTHER */
+	uint32_t priority;
+};
+
+/* Create a thread. */
+int linux_thread_create(struct linux_thread **thread,
+			const struct linux_thread_init_param *param);
+
+/* Change the scheduling priority of a running thread. */
+int linux_thread_set_priority(struct linux_thread *thread, uint32_t priority);
+
+/* Wait for a thread to return and free its resources. */
+int linux_thread_join(struct linux_thread *thread);
+
+/* Create a work queue and start its workers. */
+int linux_workqueue_init(struct linux_workqueue **wq,
+			 const struct linux_workqueue_init_param *param);
+
+/* Queue a work item, -EBUSY if it is already queued. */
+int linux_workqueue_queue(struct linux_workqueue *wq, struct linux_work *work);
+
+/* Wait until all the queued work items are done. */
+int linux_workqueue_flush(struct linux_workqueue *wq);
+
+/* Run the queued work items, then stop the workers and free the queue. */
+int linux_workqueue_remove(struct linux_workqueue *wq);
+
+#endif // LINUX_THREAD_H_
@@ -31,28 +31,276 @@
  * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 *******************************************************************************/
 
+
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
 #include "no_os_error.h"
 #include "no_os_timer.h"
 #include "no_os_alloc.h"
+#include "no_os_util.h"
+#include "no_os_irq.h"
+#include "linux_thread.h"
+#include "linux_timer.h"
+
+/** Timers reachable through linux_timer_irq_ops, by timer ID */
+#define LINUX_TIMER_MAX_ID	8
 
 /**
  * @struct linux_timer_desc
  * @brief Linux platform specific timer descriptor
  */
 struct linux_timer_desc {
-	timer_t		timer_id;
 	bool		enable;
 	struct timespec	start_time;
+	/** Timer ID */
+	uint16_t	id;
+	/** Protects the callback fields, not held while the callback runs */
+	pthread_mutex_t	cb_lock;
+	/** Signaled when the callback returns */
+	pthread_cond_t	cb_done;
+	/** Callback called on every period */
+	void		(*handler)(void *ctx);
+	/** Parameter passed to the callback */
+	void		*ctx;
+	/** Callback disabled through linux_timer_irq_ops */
+	bool		masked;
+	/** The callback is running */
+	bool		running;
+	/** Thread running the callback, valid while running is set */
+	pthread_t	cb_thread;
+	/** Set while the callback thread is being stopped */
+	bool		stopping;
+	/** timerfd expiring on every period */
+	int		timer_fd;
+	/** eventfd used to stop the callback thread */
+	int		stop_fd;
+	/** Callback thread, NULL when not running */
+	struct linux_thread *thread;
+	/** Callback thread settings */
+	struct linux_timer_init_param thread_param;
+	/** Period, 0 if the timer only counts */
+	uint64_t	period_ns;
+	/** Next expiration, CLOCK_MONOTONIC */
+	uint64_t	next_ns;
+	/** Protects the statistics */
+	pthread_mutex_t	lock;
+	struct linux_timer_stats stats;
+	/** Sum of the latencies, for the average */
+	uint64_t	latency_sum_ns;
 };
 
+/** Timers by ID, for linux_timer_irq_ops */
+static struct linux_timer_desc *linux_timers[LINUX_TIMER_MAX_ID];
+static pthread_mutex_t linux_timers_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * Lock held while a timer callback runs, the equivalent of an interrupt
+ * context: callbacks of all the timers run one at a time, and the
+ * global_disable of linux_timer_irq_ops takes it to keep them out of the code
+ * running on the other threads, such as the IIO loop. It is recursive, and a
+ * waiting callback goes before a waiting global_disable, the way pending
+ * interrupts run as soon as they are enabled.
+ */
+static struct {
+	pthread_mutex_t	lock;
+	pthread_cond_t	cond;
+	pthread_t	owner;
+	uint32_t	depth;
+	uint32_t	waiting;
+} linux_timer_irq_lock = {
+	.lock = PTHREAD_MUTEX_INITIALIZER,
+	.cond = PTHREAD_COND_INITIALIZER,
+};
+
+/**
+ * @brief Read CLOCK_MONOTONIC.
+ * @return Current time in nanoseconds.
+ */
+static uint64_t linux_timer_now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/**
+ * @brief Take the timer callback lock.
+ * @param cb_desc - Timer whose callback is about to run, NULL when called
+ * outside of the callback threads.
+ * @return true if the lock is held, false if cb_desc is being stopped.
+ */
+static bool linux_timer_irq_lock_get(struct linux_timer_desc *cb_desc)
+{
+	bool locked = true;
+
+	pthread_mutex_lock(&linux_timer_irq_lock.lock);
+
+	if (linux_timer_irq_lock.depth &&
+	    pthread_equal(linux_timer_irq_lock.owner, pthread_self())) {
+		linux_timer_irq_lock.depth++;
+		goto unlock;
+	}
+
+	if (cb_desc)
+		linux_timer_irq_lock.waiting++;
+
+	while (linux_timer_irq_lock.depth ||
+	       (!cb_desc && linux_timer_irq_lock.waiting)) {
+		if (cb_desc && cb_desc->stopping)
+			break;
+		pthread_cond_wait(&linux_timer_irq_lock.cond,
+				  &linux_timer_irq_lock.lock);
+	}
+
+	if (cb_desc) {
+		linux_timer_irq_lock.waiting--;
+		if (cb_desc->stopping) {
+			locked = false;
+			/* A global_disable may wait for this callback */
+			pthread_cond_broadcast(&linux_timer_irq_lock.cond);
+			goto unlock;
+		}
+	}
+
+	linux_timer_irq_lock.owner = pthread_self();
+	linux_timer_irq_lock.depth = 1;
+unlock:
+	pthread_mutex_unlock(&linux_timer_irq_lock.lock);
+
+	return locked;
+}
+
+/**
+ * @brief Release the timer callback lock, if held by the calling thread.
+ */
+static void linux_timer_irq_lock_put(void)
+{
+	pthread_mutex_lock(&linux_timer_irq_lock.lock);
+	if (linux_timer_irq_lock.depth &&
+	    pthread_equal(linux_timer_irq_lock.owner, pthread_self()) &&
+	    !--linux_timer_irq_lock.depth)
+		pthread_cond_broadcast(&linux_timer_irq_lock.cond);
+	pthread_mutex_unlock(&linux_timer_irq_lock.lock);
+}
+
+/**
+ * @brief Wait until the callback of a timer returns, unless called from it.
+ * Must be called with cb_lock held.
+ * @param linux_desc - Linux timer descriptor.
+ */
+static void linux_timer_cb_wait(struct linux_timer_desc *linux_desc)
+{
+	while (linux_desc->running &&
+	       !pthread_equal(linux_desc->cb_thread, pthread_self()))
+		pthread_cond_wait(&linux_desc->cb_done, &linux_desc->cb_lock);
+}
+
+/**
+ * @brief Callback thread. Waits for the timerfd expirations, updates the
+ * statistics and calls the callback once per wakeup. Expirations which passed
+ * while the callback was running are counted as overruns, not replayed.
+ * The callback runs with the timer callback lock held, and without cb_lock,
+ * so that it may change the callbacks and interrupts of any timer.
+ * @param ctx - Linux timer descriptor.
+ */
+static void linux_timer_thread(void *ctx)
+{
+	struct linux_timer_desc *linux_desc = ctx;
+	struct pollfd fds[2] = {
+		{.fd = linux_desc->timer_fd, .events = POLLIN},
+		{.fd = linux_desc->stop_fd, .events = POLLIN},
+	};
+	void (*handler)(void *ctx);
+	void *handler_ctx;
+	uint64_t expirations;
+	uint64_t expiry;
+	uint64_t latency;
+	uint64_t now;
+	ssize_t ret;
+
+	while (1) {
+		if (poll(fds, NO_OS_ARRAY_SIZE(fds), -1) < 0) {
+			if (errno == EINTR)
+				continue;
+			return;
+		}
+
+		if (fds[1].revents)
+			return;
+
+		ret = read(linux_desc->timer_fd, &expirations,
+			   sizeof(expirations));
+		if (ret != sizeof(expirations) || !expirations)
+			continue;
+
+		now = linux_timer_now_ns();
+
+		/* Latest expiration, the others were missed */
+		expiry = linux_desc->next_ns +
+			 (expirations - 1) * linux_desc->period_ns;
+		linux_desc->next_ns = expiry + linux_desc->period_ns;
+		latency = now > expiry ? now - expiry : 0;
+
+		if (!linux_timer_irq_lock_get(linux_desc))
+			return;
+
+		pthread_mutex_lock(&linux_desc->cb_lock);
+		handler = linux_desc->handler;
+		handler_ctx = linux_desc->ctx;
+		if (!handler || linux_desc->masked) {
+			pthread_mutex_unlock(&linux_desc->cb_lock);
+			linux_timer_irq_lock_put();
+			continue;
+		}
+		linux_desc->running = true;
+		linux_desc->cb_thread = pthread_self();
+		pthread_mutex_unlock(&linux_desc->cb_lock);
+
+		pthread_mutex_lock(&linux_desc->lock);
+		if (!linux_desc->stats.ticks ||
+		    latency < linux_desc->stats.latency_min_ns)
+			linux_desc->stats.latency_min_ns = latency;
+		if (latency > linux_desc->stats.latency_max_ns)
+			linux_desc->stats.latency_max_ns = latency;
+		linux_desc->latency_sum_ns += latency;
+		linux_desc->stats.overruns += expirations - 1;
+		linux_desc->stats.ticks++;
+		pthread_mutex_unlock(&linux_desc->lock);
+
+		handler(handler_ctx);
+
+		pthread_mutex_lock(&linux_desc->cb_lock);
+		linux_desc->running = false;
+		pthread_cond_broadcast(&linux_desc->cb_done);
+		pthread_mutex_unlock(&linux_desc->cb_lock);
+		linux_timer_irq_lock_put();
+
+		latency = linux_timer_now_ns() - now;
+		pthread_mutex_lock(&linux_desc->lock);
+		if (latency > linux_desc->stats.callback_max_ns)
+			linux_desc->stats.callback_max_ns = latency;
+		pthread_mutex_unlock(&linux_desc->lock);
+	}
+}
+
 /**
  * @brief Timer driver init function
  * @param desc - timer descriptor to be initialized
- * @param param - initialization parameter for the desc
+ * @param param - initialization parameter for the desc. The period of the
+ * callbacks is ticks_count / freq_hz. extra may point to a
+ * struct linux_timer_init_param.
  * @return 0 in case of success, negative errno error codes otherwise.
  */
 int linux_timer_init(struct no_os_timer_desc **desc,
@@ -60,14 +308,65 @@ int linux_timer_init(struct no_os_timer_desc **desc,
 {
 	struct no_os_timer_desc *descriptor;
 	struct linux_timer_desc *linux_desc;
+	int ret;
+
+	if (!desc || !param)
+		return -EINVAL;
 
 	descriptor = no_os_calloc(1, sizeof(*descriptor));
 	if (!descriptor)
 		return -ENOMEM;
 
 	linux_desc = no_os_calloc(1, sizeof(*linux_desc));
-	if (!linux_desc)
+	if (!linux_desc) {
+		ret = -ENOMEM;
 		goto free_desc;
+	}
+
+	linux_desc->thread_param.cpu = LINUX_THREAD_ANY_CPU;
+	if (param->extra)
+		linux_desc->thread_param = *(struct linux_timer_init_param *)
+					   param->extra;
+
+	if (param->freq_hz)
+		linux_desc->period_ns = (uint64_t)param->ticks_count *
+					1000000000 / param->freq_hz;
+
+	linux_desc->timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+	if (linux_desc->timer_fd < 0) {
+		ret = -errno;
+		goto free_linux_desc;
+	}
+
+	linux_desc->stop_fd = eventfd(0, EFD_CLOEXEC);
+	if (linux_desc->stop_fd < 0) {
+		ret = -errno;
+		goto close_timer;
+	}
+
+	ret = pthread_mutex_init(&linux_desc->lock, NULL);
+	if (ret) {
+		ret = -ret;
+		goto close_stop;
+	}
+
+	ret = pthread_mutex_init(&linux_desc->cb_lock, NULL);
+	if (ret) {
+		ret = -ret;
+		goto destroy_lock;
+	}
+
+	ret = pthread_cond_init(&linux_desc->cb_done, NULL);
+	if (ret) {
+		ret = -ret;
+		goto destroy_cb_lock;
+	}
+
+	linux_desc->id = param->id;
+	pthread_mutex_lock(&linux_timers_lock);
+	if (param->id < LINUX_TIMER_MAX_ID && !linux_timers[param->id])
+		linux_timers[param->id] = linux_desc;
+	pthread_mutex_unlock(&linux_timers_lock);
 
 	descriptor->extra = linux_desc;
 
@@ -79,60 +378,194 @@ int linux_timer_init(struct no_os_timer_desc **desc,
 
 	return 0;
 
+destroy_cb_lock:
+	pthread_mutex_destroy(&linux_desc->cb_lock);
+destroy_lock:
+	pthread_mutex_destroy(&linux_desc->lock);
+close_stop:
+	close(linux_desc->stop_fd);
+close_timer:
+	close(linux_desc->timer_fd);
+free_linux_desc:
+	no_os_free(linux_desc);
 free_desc:
 	no_os_free(descriptor);
 
-	return -ENOMEM;
+	return ret;
 }
 
 /**
- * @brief Timer driver remove function
+ * @brief Register the callback called on every period. Unless called from
+ * the callback, returns after the previous callback, if running, is done.
  * @param desc - timer descriptor
- * @return 0 in case of success, -EINVAL otherwise.
+ * @param handler - callback, called from a dedicated thread
+ * @param ctx - parameter passed to the callback
+ * @return 0 in case of success, negative errno error codes otherwise.
  */
-int linux_timer_remove(struct no_os_timer_desc *desc)
+int linux_timer_set_callback(struct no_os_timer_desc *desc,
+			     void (*handler)(void *), void *ctx)
 {
-	no_os_free(desc->extra);
-	no_os_free(desc);
+	struct linux_timer_desc *linux_desc;
+
+	linux_desc = desc->extra;
+
+	pthread_mutex_lock(&linux_desc->cb_lock);
+	linux_desc->handler = handler;
+	linux_desc->ctx = ctx;
+	linux_timer_cb_wait(linux_desc);
+	pthread_mutex_unlock(&linux_desc->cb_lock);
 
 	return 0;
 }
 
 /**
- * @brief Timer count start function
+ * @brief Timer count stop function. Must not be called from the callback.
  * @param desc - timer descriptor
  * @return 0 in case of success, -EINVAL otherwise.
  */
-int linux_timer_start(struct no_os_timer_desc *desc)
+int linux_timer_stop(struct no_os_timer_desc *desc)
 {
 	struct linux_timer_desc *linux_desc;
+	struct itimerspec its = {0};
+	uint64_t val = 1;
 
 	linux_desc = desc->extra;
 
-	clock_gettime(CLOCK_REALTIME, &linux_desc->start_time);
-	linux_desc->enable = true;
+	if (linux_desc->thread) {
+		/* The thread may wait for a global_disable of the caller */
+		pthread_mutex_lock(&linux_timer_irq_lock.lock);
+		linux_desc->stopping = true;
+		pthread_cond_broadcast(&linux_timer_irq_lock.cond);
+		pthread_mutex_unlock(&linux_timer_irq_lock.lock);
+
+		if (write(linux_desc->stop_fd, &val, sizeof(val)) != sizeof(val))
+			return -errno;
+
+		linux_thread_join(linux_desc->thread);
+		linux_desc->thread = NULL;
+		linux_desc->stopping = false;
+
+		timerfd_settime(linux_desc->timer_fd, 0, &its, NULL);
+		/* Clear the stop request */
+		if (read(linux_desc->stop_fd, &val, sizeof(val)) != sizeof(val))
+			return -errno;
+	}
+
+	linux_desc->enable = false;
 
 	return 0;
 }
 
 /**
- * @brief Timer count stop function
+ * @brief Timer driver remove function
  * @param desc - timer descriptor
  * @return 0 in case of success, -EINVAL otherwise.
  */
-int linux_timer_stop(struct no_os_timer_desc *desc)
+int linux_timer_remove(struct no_os_timer_desc *desc)
 {
 	struct linux_timer_desc *linux_desc;
+	int ret;
 
 	linux_desc = desc->extra;
 
-	linux_desc->enable = false;
+	ret = linux_timer_stop(desc);
+	if (ret)
+		return ret;
+
+	pthread_mutex_lock(&linux_timers_lock);
+	if (linux_desc->id < LINUX_TIMER_MAX_ID &&
+	    linux_timers[linux_desc->id] == linux_desc)
+		linux_timers[linux_desc->id] = NULL;
+	pthread_mutex_unlock(&linux_timers_lock);
+
+	pthread_cond_destroy(&linux_desc->cb_done);
+	pthread_mutex_destroy(&linux_desc->cb_lock);
+	pthread_mutex_destroy(&linux_desc->lock);
+	close(linux_desc->stop_fd);
+	close(linux_desc->timer_fd);
+	no_os_free(desc->extra);
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Timer count start function. If the timer has a period, the callback
+ * thread is started as well.
+ * @param desc - timer descriptor
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int linux_timer_start(struct no_os_timer_desc *desc)
+{
+	struct linux_thread_init_param thread_param = {0};
+	struct linux_timer_desc *linux_desc;
+	struct itimerspec its;
+	int ret;
+
+	linux_desc = desc->extra;
+
+	if (linux_desc->enable)
+		return 0;
+
+	clock_gettime(CLOCK_MONOTONIC, &linux_desc->start_time);
+	linux_desc->enable = true;
+
+	if (!linux_desc->period_ns)
+		return 0;
+
+	linux_desc->next_ns = (uint64_t)linux_desc->start_time.tv_sec *
+			      1000000000 + linux_desc->start_time.tv_nsec +
+			      linux_desc->period_ns;
+	its.it_value.tv_sec = linux_desc->next_ns / 1000000000;
+	its.it_value.tv_nsec = linux_desc->next_ns % 1000000000;
+	its.it_interval.tv_sec = linux_desc->period_ns / 1000000000;
+	its.it_interval.tv_nsec = linux_desc->period_ns % 1000000000;
+
+	ret = linux_timer_reset_stats(desc);
+	if (ret)
+		goto disable;
+
+	ret = timerfd_settime(linux_desc->timer_fd, TFD_TIMER_ABSTIME, &its,
+			      NULL);
+	if (ret) {
+		ret = -errno;
+		goto disable;
+	}
+
+	thread_param.func = linux_timer_thread;
+	thread_param.ctx = linux_desc;
+	thread_param.name = "no-os-timer";
+	thread_param.cpu = linux_desc->thread_param.cpu;
+	thread_param.priority = linux_desc->thread_param.priority;
+	ret = linux_thread_create(&linux_desc->thread, &thread_param);
+	if (ret)
+		goto disarm;
 
 	return 0;
+
+disarm:
+	memset(&its, 0, sizeof(its));
+	timerfd_settime(linux_desc->timer_fd, 0, &its, NULL);
+disable:
+	linux_desc->enable = false;
+
+	return ret;
 }
 
 /**
- * @brief Function to get the current timer counter value
+ * @brief Frequency of the timer counter.
+ * @param desc - timer descriptor
+ * @return freq_hz of the init parameters, LINUX_TIMER_COUNT_HZ if it is 0.
+ */
+static uint32_t linux_timer_count_hz(struct no_os_timer_desc *desc)
+{
+	return desc->freq_hz ? desc->freq_hz : LINUX_TIMER_COUNT_HZ;
+}
+
+/**
+ * @brief Function to get the current timer counter value, in periods of the
+ * counter clock (see linux_timer_count_clk_get()) since the timer start.
+ * The counter wraps around at 32 bits.
  * @param desc - timer descriptor
  * @param counter - the timer counter value
  * @return 0 in case of success, -EINVAL otherwise.
@@ -142,10 +575,11 @@ int linux_timer_counter_get(struct no_os_timer_desc *desc,
 {
 	struct linux_timer_desc *linux_desc;
 	struct timespec curr_value;
+	uint32_t hz;
 
 	linux_desc = desc->extra;
 
-	clock_gettime(CLOCK_REALTIME, &curr_value);
+	clock_gettime(CLOCK_MONOTONIC, &curr_value);
 
 	curr_value.tv_sec -= linux_desc->start_time.tv_sec;
 
@@ -160,7 +594,9 @@ int linux_timer_counter_get(struct no_os_timer_desc *desc,
 		curr_value.tv_nsec -= linux_desc->start_time.tv_nsec;
 	}
 
-	*counter = curr_value.tv_sec * 1000 + curr_value.tv_nsec / 1000000;
+	hz = linux_timer_count_hz(desc);
+	*counter = (uint64_t)curr_value.tv_sec * hz +
+		   (uint64_t)curr_value.tv_nsec * hz / 1000000000;
 
 	return 0;
 }
@@ -175,25 +611,23 @@ int linux_timer_counter_set(struct no_os_timer_desc *desc,
 			    uint32_t new_val)
 {
 	struct linux_timer_desc *linux_desc;
-	struct timespec curr_value;
+	uint64_t start_ns;
 
 	linux_desc = desc->extra;
 
-	clock_gettime(CLOCK_REALTIME, &curr_value);
-
-	linux_desc->start_time.tv_sec = curr_value.tv_sec + new_val / 1000;
-	linux_desc->start_time.tv_nsec = curr_value.tv_nsec +
-					 (new_val % 1000) * 1000000;
-	if (linux_desc->start_time.tv_nsec >= 1000000000) {
-		linux_desc->start_time.tv_nsec -= 1000000000;
-		linux_desc->start_time.tv_sec++;
-	}
+	/* Move the start back, so that the counter reads new_val */
+	start_ns = linux_timer_now_ns() - (uint64_t)new_val * 1000000000 /
+		   linux_timer_count_hz(desc);
+	linux_desc->start_time.tv_sec = start_ns / 1000000000;
+	linux_desc->start_time.tv_nsec = start_ns % 1000000000;
 
 	return 0;
 }
 
 /**
- * @brief Function to get the timer frequency
+ * @brief Function to get the timer frequency. The counter is derived from
+ * CLOCK_MONOTONIC and runs at the freq_hz of the init parameters, or at
+ * LINUX_TIMER_COUNT_HZ if it was 0.
  * @param desc - timer descriptor
  * @param freq_hz - the timer frequency value
  * @return 0 in case of success, -EINVAL otherwise.
@@ -201,7 +635,10 @@ int linux_timer_counter_set(struct no_os_timer_desc *desc,
 int linux_timer_count_clk_get(struct no_os_timer_desc *desc,
 			      uint32_t *freq_hz)
 {
-	*freq_hz = 1000;
+	if (!desc || !freq_hz)
+		return -EINVAL;
+
+	*freq_hz = linux_timer_count_hz(desc);
 
 	return 0;
 }
@@ -219,7 +656,7 @@ int linux_timer_count_clk_set(struct no_os_timer_desc *desc,
 }
 
 /**
- * @brief Not implemented
+ * @brief Get the time elapsed since the timer was started.
  * @param desc - timer descriptor
  * @param elapsed_time - time in nanoseconds
  * @return 0 in case of success, negative errno error codes otherwise.
@@ -228,24 +665,309 @@ int linux_timer_get_elapsed_time_nsec(struct no_os_timer_desc *desc,
 				      uint64_t *elapsed_time)
 {
 	struct linux_timer_desc *linux_desc;
-	struct timespec curr_value;
 
 	linux_desc = desc->extra;
 
-	clock_gettime(CLOCK_REALTIME, &curr_value);
-
-	*elapsed_time = curr_value.tv_sec * 1000000000 + curr_value.tv_nsec -
-			linux_desc->start_time.tv_sec * 1000000000 -
+	*elapsed_time = linux_timer_now_ns() -
+			(uint64_t)linux_desc->start_time.tv_sec * 1000000000 -
 			linux_desc->start_time.tv_nsec;
 
 	return 0;
 }
 
+/**
+ * @brief Get the periodic timer statistics.
+ * @param desc - timer descriptor
+ * @param stats - statistics since the timer was started or the last reset
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int linux_timer_get_stats(struct no_os_timer_desc *desc,
+			  struct linux_timer_stats *stats)
+{
+	struct linux_timer_desc *linux_desc;
+
+	if (!desc || !stats)
+		return -EINVAL;
+
+	linux_desc = desc->extra;
+
+	pthread_mutex_lock(&linux_desc->lock);
+	*stats = linux_desc->stats;
+	if (stats->ticks)
+		stats->latency_avg_ns = linux_desc->latency_sum_ns / stats->ticks;
+	pthread_mutex_unlock(&linux_desc->lock);
+
+	stats->period_ns = linux_desc->period_ns;
+
+	return 0;
+}
+
+/**
+ * @brief Clear the periodic timer statistics.
+ * @param desc - timer descriptor
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int linux_timer_reset_stats(struct no_os_timer_desc *desc)
+{
+	struct linux_timer_desc *linux_desc;
+
+	if (!desc)
+		return -EINVAL;
+
+	linux_desc = desc->extra;
+
+	pthread_mutex_lock(&linux_desc->lock);
+	memset(&linux_desc->stats, 0, sizeof(linux_desc->stats));
+	linux_desc->latency_sum_ns = 0;
+	pthread_mutex_unlock(&linux_desc->lock);
+
+	return 0;
+}
+
+/**
+ * @brief Find the timer of an interrupt of linux_timer_irq_ops.
+ * @param irq_id - Interrupt ID, the timer ID.
+ * @return The timer descriptor, NULL if there is none.
+ */
+static struct linux_timer_desc *linux_timer_irq_get(uint32_t irq_id)
+{
+	struct linux_timer_desc *linux_desc = NULL;
+
+	pthread_mutex_lock(&linux_timers_lock);
+	if (irq_id < LINUX_TIMER_MAX_ID)
+		linux_desc = linux_timers[irq_id];
+	pthread_mutex_unlock(&linux_timers_lock);
+
+	return linux_desc;
+}
+
+/**
+ * @brief Initialize the timer interrupt controller.
+ * @param desc - The IRQ controller descriptor.
+ * @param param - The IRQ controller parameters.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int linux_timer_irq_ctrl_init(struct no_os_irq_ctrl_desc **desc,
+				     const struct no_os_irq_init_param *param)
+{
+	struct no_os_irq_ctrl_desc *descriptor;
+
+	if (!desc || !param)
+		return -EINVAL;
+
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	descriptor->irq_ctrl_id = param->irq_ctrl_id;
+
+	*desc = descriptor;
+
+	return 0;
+}
+
+/**
+ * @brief Register the callback of a timer interrupt. The interrupt stays
+ * disabled until no_os_irq_enable() is called.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - The timer ID.
+ * @param cb - Callback descriptor.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int linux_timer_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
+		uint32_t irq_id,
+		struct no_os_callback_desc *cb)
+{
+	struct linux_timer_desc *linux_desc;
+
+	if (!cb)
+		return -EINVAL;
+
+	linux_desc = linux_timer_irq_get(irq_id);
+	if (!linux_desc)
+		return -ENODEV;
+
+	pthread_mutex_lock(&linux_desc->cb_lock);
+	linux_desc->handler = cb->callback;
+	linux_desc->ctx = cb->ctx;
+	linux_desc->masked = true;
+	pthread_mutex_unlock(&linux_desc->cb_lock);
+
+	return 0;
+}
+
+/**
+ * @brief Unregister the callback of a timer interrupt. Unless called from the
+ * callback, returns after the callback, if running, is done.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - The timer ID.
+ * @param cb - Callback descriptor.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int linux_timer_irq_unregister_callback(struct no_os_irq_ctrl_desc *desc,
+		uint32_t irq_id,
+		struct no_os_callback_desc *cb)
+{
+	struct linux_timer_desc *linux_desc;
+
+	linux_desc = linux_timer_irq_get(irq_id);
+	if (!linux_desc)
+		return -ENODEV;
+
+	pthread_mutex_lock(&linux_desc->cb_lock);
+	linux_desc->handler = NULL;
+	linux_desc->ctx = NULL;
+	linux_timer_cb_wait(linux_desc);
+	pthread_mutex_unlock(&linux_desc->cb_lock);
+
+	return 0;
+}
+
+/**
+ * @brief Enable or disable the callback of a timer interrupt. Unless called
+ * from the callback, disabling returns after the callback, if running, is
+ * done.
+ * @param irq_id - The timer ID.
+ * @param enable - true to enable the callback.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int linux_timer_irq_set(uint32_t irq_id, bool enable)
+{
+	struct linux_timer_desc *linux_desc;
+
+	linux_desc = linux_timer_irq_get(irq_id);
+	if (!linux_desc)
+		return -ENODEV;
+
+	pthread_mutex_lock(&linux_desc->cb_lock);
+	linux_desc->masked = !enable;
+	if (!enable)
+		linux_timer_cb_wait(linux_desc);
+	pthread_mutex_unlock(&linux_desc->cb_lock);
+
+	return 0;
+}
+
+/**
+ * @brief Enable a timer interrupt.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - The timer ID.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int linux_timer_irq_enable(struct no_os_irq_ctrl_desc *desc,
+				  uint32_t irq_id)
+{
+	return linux_timer_irq_set(irq_id, true);
+}
+
+/**
+ * @brief Disable a timer interrupt.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - The timer ID.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int linux_timer_irq_disable(struct no_os_irq_ctrl_desc *desc,
+				   uint32_t irq_id)
+{
+	return linux_timer_irq_set(irq_id, false);
+}
+
+/**
+ * @brief Let the timer callbacks run again, after linux_timer_irq_global_disable().
+ * @param desc - The IRQ controller descriptor.
+ * @return 0
+ */
+static int linux_timer_irq_global_enable(struct no_os_irq_ctrl_desc *desc)
+{
+	linux_timer_irq_lock_put();
+
+	return 0;
+}
+
+/**
+ * @brief Keep the callbacks of all the timers from running, until
+ * linux_timer_irq_global_enable(). Returns once the running callback, if any,
+ * is done. Calls may be nested, and are allowed from a callback.
+ * @param desc - The IRQ controller descriptor.
+ * @return 0
+ */
+static int linux_timer_irq_global_disable(struct no_os_irq_ctrl_desc *desc)
+{
+	linux_timer_irq_lock_get(NULL);
+
+	return 0;
+}
+
+/**
+ * @brief Set the priority of a timer interrupt: the SCHED_FIFO priority of
+ * the thread running its callbacks (higher is more urgent), 0 for
+ * SCHED_OTHER. Applied to the running thread and kept for the next starts,
+ * in place of the priority of struct linux_timer_init_param. Must not be
+ * called concurrently with the start or stop of the timer.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - The timer ID.
+ * @param priority_level - SCHED_FIFO priority, 0 for SCHED_OTHER.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int linux_timer_irq_set_priority(struct no_os_irq_ctrl_desc *desc,
+					uint32_t irq_id,
+					uint32_t priority_level)
+{
+	struct linux_timer_desc *linux_desc;
+	int ret;
+
+	linux_desc = linux_timer_irq_get(irq_id);
+	if (!linux_desc)
+		return -ENODEV;
+
+	if (priority_level > (uint32_t)sched_get_priority_max(SCHED_FIFO))
+		return -EINVAL;
+
+	if (linux_desc->thread) {
+		ret = linux_thread_set_priority(linux_desc->thread,
+						priority_level);
+		if (ret)
+			return ret;
+	}
+
+	linux_desc->thread_param.priority = priority_level;
+
+	return 0;
+}
+
+/**
+ * @brief Free the timer interrupt controller.
+ * @param desc - The IRQ controller descriptor.
+ * @return 0
+ */
+static int linux_timer_irq_ctrl_remove(struct no_os_irq_ctrl_desc *desc)
+{
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Linux timer interrupt controller platform ops structure
+ */
+const struct no_os_irq_platform_ops linux_timer_irq_ops = {
+	.init = linux_timer_irq_ctrl_init,
+	.register_callback = linux_timer_irq_register_callback,
+	.unregister_callback = linux_timer_irq_unregister_callback,
+	.enable = linux_timer_irq_enable,
+	.disable = linux_timer_irq_disable,
+	.global_enable = linux_timer_irq_global_enable,
+	.global_disable = linux_timer_irq_global_disable,
+	.set_priority = linux_timer_irq_set_priority,
+	.remove = linux_timer_irq_ctrl_remove,
+};
+
 /**
  * @brief linux platform specific timer platform ops structure
  */
 const struct no_os_timer_platform_ops linux_timer_ops = {
 	.init = (int32_t (*)())linux_timer_init,
+	.set_callback = (int32_t (*)())linux_timer_set_callback,
 	.start = (int32_t (*)())linux_timer_start,
 	.stop = (int32_t (*)())linux_timer_stop,
 	.counter_get = (int32_t (*)())linux_timer_counter_get,
@@ -256,4 +978,3 @@ const struct no_os_timer_platform_ops linux_timer_ops = {
 	(int32_t (*)())linux_timer_get_elapsed_time_nsec,
 	.remove = (int32_t (*)())linux_timer_remove
 };
-
@@ -34,12 +34,66 @@
 #ifndef LINUX_TIMER_H_
 #define LINUX_TIMER_H_
 
+#include <stdint.h>
+#include "no_os_irq.h"
 #include "no_os_timer.h"
 
+/** Counter frequency of the timers initialized with a freq_hz of 0 */
+#define LINUX_TIMER_COUNT_HZ	1000
+
+/**
+ * @struct linux_timer_init_param
+ * @brief Linux timer specific parameters, used for the thread calling the
+ * timer callback. May be omitted (extra set to NULL).
+ */
+struct linux_timer_init_param {
+	/** CPU the callback thread is pinned to, or LINUX_THREAD_ANY_CPU */
+	int32_t cpu;
+	/** SCHED_FIFO priority of the callback thread, 0 for SCHED_OTHER */
+	uint32_t priority;
+};
+
+/**
+ * @struct linux_timer_stats
+ * @brief Periodic timer statistics. The latency is the delay between the
+ * ideal expiration time and the wakeup of the callback thread, its spread
+ * (latency_max_ns - latency_min_ns) is the jitter of the callbacks.
+ */
+struct linux_timer_stats {
+	/** Timer period */
+	uint64_t period_ns;
+	/** Number of callbacks */
+	uint64_t ticks;
+	/** Expirations missed because the previous callback was late */
+	uint64_t overruns;
+	/** Minimum wakeup latency */
+	uint64_t latency_min_ns;
+	/** Maximum wakeup latency */
+	uint64_t latency_max_ns;
+	/** Average wakeup latency */
+	uint64_t latency_avg_ns;
+	/** Longest callback run time */
+	uint64_t callback_max_ns;
+};
+
 /**
  * @brief Linux specific timer platform ops.
  */
 extern const struct no_os_timer_platform_ops linux_timer_ops;
 
+/**
+ * @brief Linux timer interrupt controller platform ops. The interrupt ID is
+ * the timer ID: callbacks registered on it are called on every period of the
+ * timer, while the interrupt is enabled.
+ */
+extern const struct no_os_irq_platform_ops linux_timer_irq_ops;
+
+/* Get the periodic timer statistics. */
+int linux_timer_get_stats(struct no_os_timer_desc *desc,
+			  struct linux_timer_stats *stats);
+
+/* Clear the periodic timer statistics. */
+int linux_timer_reset_stats(struct no_os_timer_desc *desc);
+
 #endif //LINUX_TIMER_H_
 
@@ -0,0 +1,87 @@
+/***************************************************************************//**
+ *   @file   linux_trace.c
+ *   @brief  Linux trace clock and Chrome trace export.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <errno.h>
+#include <stdio.h>
+#include <time.h>
+#include "no_os_error.h"
+#include "linux_trace.h"
+
+/**
+ * @brief Trace clock, to be used as no_os_trace_init_param.get_cycles with
+ * a frequency of LINUX_TRACE_CLOCK_HZ.
+ * @return CLOCK_MONOTONIC time in nanoseconds, truncated to 32 bits.
+ */
+uint32_t linux_trace_clock(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint32_t)((uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec);
+}
+
+/**
+ * @brief Write a string to the export file.
+ * @param ctx - FILE pointer.
+ * @param str - String.
+ */
+static void linux_trace_write(void *ctx, const char *str)
+{
+	fputs(str, ctx);
+}
+
+/**
+ * @brief Save the recorded trace events to a file which can be opened with
+ * chrome://tracing or https://ui.perfetto.dev.
+ * @param path - File path.
+ * @return Number of exported events, negative error code otherwise.
+ */
+int linux_trace_export(const char *path)
+{
+	FILE *f;
+	int ret;
+
+	if (!path)
+		return -EINVAL;
+
+	f = fopen(path, "w");
+	if (!f)
+		return -errno;
+
+	ret = no_os_trace_export(linux_trace_write, f);
+
+	if (fclose(f) && ret >= 0)
+		ret = -errno;
+
+	return ret;
+}
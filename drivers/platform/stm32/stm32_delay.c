@@ -75,20 +75,33 @@ void no_os_mdelay(uint32_t msecs)
 
 /**
  * @brief Get current time.
+ *
+ * The millisecond HAL tick is refined with the SysTick down counter, so the
+ * time has a microsecond resolution.
  * @return Current time structure from system start (seconds, microseconds).
  */
 struct no_os_time no_os_get_time(void)
 {
-	unsigned long long Xtime_Global;
-	float fractional_part = 0;
+	uint32_t load = SysTick->LOAD + 1;
 	struct no_os_time t;
+	uint32_t sub_us;
+	uint32_t tick;
+	uint32_t val;
+
+	/* Read again if the tick was incremented meanwhile */
+	do {
+		tick = HAL_GetTick();
+		val = SysTick->VAL;
+	} while (tick != HAL_GetTick());
 
-	Xtime_Global = HAL_GetTick();
-	t.s = Xtime_Global / 1000; // milliseconds
+	sub_us = (uint64_t)(load - 1 - val) * HAL_GetTickFreq() * 1000 / load;
 
-	fractional_part = (float)Xtime_Global / 1000 - Xtime_Global / 1000;
-	t.us = fractional_part * 1000;
-	t.us *= 1000;
+	t.s = tick / 1000;
+	t.us = (tick % 1000) * 1000 + sub_us;
+	if (t.us >= 1000000) {
+		t.s++;
+		t.us -= 1000000;
+	}
 
 	return t;
 }
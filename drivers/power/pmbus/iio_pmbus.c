@@ -0,0 +1,402 @@
+/***************************************************************************//**
+ *   @file   iio_pmbus.c
+ *   @brief  Implementation of the PMBus telemetry scanner IIO driver
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include "no_os_alloc.h"
+#include "no_os_error.h"
+#include "no_os_units.h"
+#include "no_os_util.h"
+
+#include "pmbus.h"
+#include "iio_pmbus.h"
+#include "iio_types.h"
+
+/* Maximum number of channels which can be part of a buffered capture */
+#define PMBUS_IIO_MAX_SCAN_CH		32
+
+static struct scan_type pmbus_iio_scan_type = {
+	.sign = 's',
+	.realbits = 32,
+	.storagebits = 32,
+	.shift = 0,
+	.is_big_endian = false,
+};
+
+static const enum iio_chan_type pmbus_iio_ch_type[] = {
+	[PMBUS_SENSOR_VOLTAGE] = IIO_VOLTAGE,
+	[PMBUS_SENSOR_CURRENT] = IIO_CURRENT,
+	[PMBUS_SENSOR_POWER] = IIO_POWER,
+	[PMBUS_SENSOR_TEMP] = IIO_TEMP,
+	[PMBUS_SENSOR_FREQUENCY] = IIO_ALTVOLTAGE,
+	[PMBUS_SENSOR_STATUS] = IIO_COUNT,
+};
+
+/**
+ * @brief Read the raw attribute of a channel from the last snapshot.
+ * @param device - The iio device structure.
+ * @param buf	 - Buffer to store the read data.
+ * @param len	 - Buffer length.
+ * @param channel - IIO channel.
+ * @param priv   - IIO private data.
+ * @return ret   - Result of the reading procedure.
+ */
+static int pmbus_iio_read_raw(void *device, char *buf, uint32_t len,
+			      const struct iio_ch_info *channel,
+			      intptr_t priv)
+{
+	struct pmbus_iio_desc *desc = device;
+	int32_t val;
+	int ret;
+
+	ret = pmbus_scan_poll(desc->scan);
+	if (ret)
+		return ret;
+
+	ret = pmbus_scan_read(desc->scan, channel->address, &val);
+	if (ret)
+		return ret;
+
+	return iio_format_value(buf, len, IIO_VAL_INT, 1, &val);
+}
+
+/**
+ * @brief Read the scale attribute of a channel.
+ * @param device - The iio device structure.
+ * @param buf	 - Buffer to store the read data.
+ * @param len	 - Buffer length.
+ * @param channel - IIO channel.
+ * @param priv   - IIO private data.
+ * @return ret   - Result of the reading procedure.
+ */
+static int pmbus_iio_read_scale(void *device, char *buf, uint32_t len,
+				const struct iio_ch_info *channel,
+				intptr_t priv)
+{
+	struct pmbus_iio_desc *desc = device;
+	int32_t vals[2] = {1, 1};
+
+	/* LINEAR values are decoded to milli-units, raw values are not scaled */
+	switch (desc->scan->sensors[channel->address].format) {
+	case PMBUS_FORMAT_LINEAR11:
+	case PMBUS_FORMAT_LINEAR16:
+		vals[1] = MILLI;
+		break;
+	default:
+		break;
+	}
+
+	return iio_format_value(buf, len, IIO_VAL_FRACTIONAL, 2, vals);
+}
+
+/**
+ * @brief Read a device attribute.
+ * @param device - The iio device structure.
+ * @param buf	 - Buffer to store the read data.
+ * @param len	 - Buffer length.
+ * @param channel - IIO channel.
+ * @param priv   - IIO private data.
+ * @return ret   - Result of the reading procedure.
+ */
+static int pmbus_iio_read_attr(void *device, char *buf, uint32_t len,
+			       const struct iio_ch_info *channel,
+			       intptr_t priv)
+{
+	struct pmbus_iio_desc *desc = device;
+	struct pmbus_stats *stats = &desc->scan->dev->stats;
+	uint32_t val;
+
+	switch (priv) {
+	case PMBUS_IIO_SCAN_PERIOD:
+		val = desc->scan->period_ms;
+		break;
+	case PMBUS_IIO_SCAN_SEQUENCE:
+		val = desc->scan->seq;
+		break;
+	case PMBUS_IIO_I2C_TRANSFERS:
+		val = stats->transfers;
+		break;
+	case PMBUS_IIO_PAGE_WRITES:
+		val = stats->page_writes;
+		break;
+	case PMBUS_IIO_PAGE_HITS:
+		val = stats->page_hits;
+		break;
+	case PMBUS_IIO_VOUT_MODE_HITS:
+		val = stats->vout_mode_hits;
+		break;
+	case PMBUS_IIO_BLOCK_READS:
+		val = stats->block_reads;
+		break;
+	case PMBUS_IIO_SCAN_ERRORS:
+		val = desc->scan->errors;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	return iio_format_value(buf, len, IIO_VAL_INT, 1, (int32_t *)&val);
+}
+
+/**
+ * @brief Write a device attribute.
+ * @param device - The iio device structure.
+ * @param buf	 - Buffer containing the value.
+ * @param len	 - Buffer length.
+ * @param channel - IIO channel.
+ * @param priv   - IIO private data.
+ * @return ret   - Result of the writing procedure.
+ */
+static int pmbus_iio_write_attr(void *device, char *buf, uint32_t len,
+				const struct iio_ch_info *channel,
+				intptr_t priv)
+{
+	struct pmbus_iio_desc *desc = device;
+
+	switch (priv) {
+	case PMBUS_IIO_SCAN_PERIOD:
+		desc->scan->period_ms = no_os_str_to_uint32(buf);
+		return len;
+	default:
+		return -EINVAL;
+	}
+}
+
+/**
+ * @brief Capture one fresh snapshot per sample into the IIO buffer.
+ * @param dev - IIO device data.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int pmbus_iio_submit(struct iio_device_data *dev)
+{
+	struct pmbus_iio_desc *desc = dev->dev;
+	int32_t data[PMBUS_IIO_MAX_SCAN_CH];
+	uint32_t mask = dev->buffer->active_mask;
+	uint32_t i, s, n;
+	int ret;
+
+	for (s = 0; s < dev->buffer->samples; s++) {
+		ret = pmbus_scan_run(desc->scan);
+		if (ret)
+			return ret;
+
+		ret = pmbus_scan_get(desc->scan, desc->snap, NULL);
+		if (ret)
+			return ret;
+
+		n = 0;
+		for (i = 0; i < no_os_min(desc->scan->nb_sensors,
+					  PMBUS_IIO_MAX_SCAN_CH); i++)
+			if (mask & NO_OS_BIT(i))
+				data[n++] = desc->snap[i];
+
+		ret = iio_buffer_push_scan(dev->buffer, data);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+static struct iio_attribute pmbus_iio_ch_attrs[] = {
+	{
+		.name = "raw",
+		.show = pmbus_iio_read_raw,
+	},
+	{
+		.name = "scale",
+		.show = pmbus_iio_read_scale,
+	},
+	END_ATTRIBUTES_ARRAY
+};
+
+static struct iio_attribute pmbus_iio_dev_attrs[] = {
+	{
+		.name = "scan_period_ms",
+		.priv = PMBUS_IIO_SCAN_PERIOD,
+		.show = pmbus_iio_read_attr,
+		.store = pmbus_iio_write_attr,
+	},
+	{
+		.name = "scan_sequence",
+		.priv = PMBUS_IIO_SCAN_SEQUENCE,
+		.show = pmbus_iio_read_attr,
+	},
+	END_ATTRIBUTES_ARRAY
+};
+
+static struct iio_attribute pmbus_iio_debug_attrs[] = {
+	{
+		.name = "i2c_transfers",
+		.priv = PMBUS_IIO_I2C_TRANSFERS,
+		.show = pmbus_iio_read_attr,
+	},
+	{
+		.name = "page_writes",
+		.priv = PMBUS_IIO_PAGE_WRITES,
+		.show = pmbus_iio_read_attr,
+	},
+	{
+		.name = "page_hits",
+		.priv = PMBUS_IIO_PAGE_HITS,
+		.show = pmbus_iio_read_attr,
+	},
+	{
+		.name = "vout_mode_hits",
+		.priv = PMBUS_IIO_VOUT_MODE_HITS,
+		.show = pmbus_iio_read_attr,
+	},
+	{
+		.name = "block_reads",
+		.priv = PMBUS_IIO_BLOCK_READS,
+		.show = pmbus_iio_read_attr,
+	},
+	{
+		.name = "scan_errors",
+		.priv = PMBUS_IIO_SCAN_ERRORS,
+		.show = pmbus_iio_read_attr,
+	},
+	END_ATTRIBUTES_ARRAY
+};
+
+/**
+ * @brief Run a scan if the scan period elapsed.
+ * @param arg - PMBus IIO descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int pmbus_iio_step(void *arg)
+{
+	struct pmbus_iio_desc *desc = arg;
+
+	if (!desc)
+		return -EINVAL;
+
+	return pmbus_scan_poll(desc->scan);
+}
+
+/**
+ * @brief Initializes the PMBus IIO driver. One IIO channel is created for
+ * each sensor of the scanner.
+ * @param iio_desc - The iio device descriptor.
+ * @param init_param - The structure that contains the device initial
+ * 		       parameters.
+ * @return 0 in case of success, an error code otherwise.
+ */
+int pmbus_iio_init(struct pmbus_iio_desc **iio_desc,
+		   struct pmbus_iio_desc_init_param *init_param)
+{
+	const struct pmbus_sensor *sensor;
+	struct pmbus_iio_desc *descriptor;
+	struct iio_channel *channels;
+	uint16_t i;
+	int ret;
+
+	if (!iio_desc || !init_param || !init_param->scan)
+		return -EINVAL;
+
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	descriptor->scan = init_param->scan;
+
+	descriptor->snap = no_os_calloc(descriptor->scan->nb_sensors,
+					sizeof(*descriptor->snap));
+	if (!descriptor->snap) {
+		ret = -ENOMEM;
+		goto error;
+	}
+
+	descriptor->iio_dev = no_os_calloc(1, sizeof(*descriptor->iio_dev));
+	if (!descriptor->iio_dev) {
+		ret = -ENOMEM;
+		goto error_snap;
+	}
+
+	channels = no_os_calloc(descriptor->scan->nb_sensors, sizeof(*channels));
+	if (!channels) {
+		ret = -ENOMEM;
+		goto error_iio_dev;
+	}
+
+	for (i = 0; i < descriptor->scan->nb_sensors; i++) {
+		sensor = &descriptor->scan->sensors[i];
+
+		channels[i].name = sensor->name;
+		channels[i].ch_type = pmbus_iio_ch_type[sensor->type];
+		channels[i].channel = i;
+		channels[i].address = i;
+		channels[i].indexed = true;
+		channels[i].attributes = pmbus_iio_ch_attrs;
+		if (i < PMBUS_IIO_MAX_SCAN_CH) {
+			channels[i].scan_index = i;
+			channels[i].scan_type = &pmbus_iio_scan_type;
+		}
+	}
+
+	descriptor->iio_dev->num_ch = descriptor->scan->nb_sensors;
+	descriptor->iio_dev->channels = channels;
+	descriptor->iio_dev->attributes = pmbus_iio_dev_attrs;
+	descriptor->iio_dev->debug_attributes = pmbus_iio_debug_attrs;
+	descriptor->iio_dev->submit = pmbus_iio_submit;
+
+	*iio_desc = descriptor;
+
+	return 0;
+
+error_iio_dev:
+	no_os_free(descriptor->iio_dev);
+error_snap:
+	no_os_free(descriptor->snap);
+error:
+	no_os_free(descriptor);
+
+	return ret;
+}
+
+/**
+ * @brief Free resources allocated by the init function
+ * @param desc - The iio device descriptor.
+ * @return 0 in case of success, an error code otherwise.
+ */
+int pmbus_iio_remove(struct pmbus_iio_desc *desc)
+{
+	if (!desc)
+		return -EINVAL;
+
+	no_os_free(desc->iio_dev->channels);
+	no_os_free(desc->iio_dev);
+	no_os_free(desc->snap);
+	no_os_free(desc);
+
+	return 0;
+}
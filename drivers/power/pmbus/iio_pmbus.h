@@ -0,0 +1,92 @@
+/***************************************************************************//**
+ *   @file   iio_pmbus.h
+ *   @brief  Header file of the PMBus telemetry scanner IIO driver
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef __IIO_PMBUS_H__
+#define __IIO_PMBUS_H__
+
+#include "iio.h"
+#include "pmbus.h"
+
+/**
+ * @brief Structure holding the PMBus IIO device descriptor
+ */
+struct pmbus_iio_desc {
+	struct pmbus_scan *scan;
+	struct iio_device *iio_dev;
+	/** Snapshot copy used by the buffered capture */
+	int32_t *snap;
+};
+
+/**
+ * @brief Structure holding the PMBus IIO initialization parameter.
+ */
+struct pmbus_iio_desc_init_param {
+	/** Telemetry scanner publishing the values, not owned by the IIO driver */
+	struct pmbus_scan *scan;
+};
+
+/* PMBus IIO attributes */
+enum pmbus_iio_attr_id {
+	PMBUS_IIO_SCAN_PERIOD,
+	PMBUS_IIO_SCAN_SEQUENCE,
+	PMBUS_IIO_I2C_TRANSFERS,
+	PMBUS_IIO_PAGE_WRITES,
+	PMBUS_IIO_PAGE_HITS,
+	PMBUS_IIO_VOUT_MODE_HITS,
+	PMBUS_IIO_BLOCK_READS,
+	PMBUS_IIO_SCAN_ERRORS,
+};
+
+/**
+ * @brief Initialize the PMBus IIO driver
+ * @param iio_desc - Pointer to IIO descriptor pointer
+ * @param init_param - Initialization parameters
+ * @return 0 in case of success, negative error code otherwise
+ */
+int pmbus_iio_init(struct pmbus_iio_desc **iio_desc,
+		   struct pmbus_iio_desc_init_param *init_param);
+
+/**
+ * @brief Run a scan if the scan period elapsed. Meant to be used as the IIO
+ * application post step callback.
+ * @param arg - PMBus IIO descriptor
+ * @return 0 in case of success, negative error code otherwise
+ */
+int pmbus_iio_step(void *arg);
+
+/**
+ * @brief Free resources allocated by the init function
+ * @param desc - IIO descriptor to free
+ * @return 0 in case of success, negative error code otherwise
+ */
+int pmbus_iio_remove(struct pmbus_iio_desc *desc);
+
+#endif /* __IIO_PMBUS_H__ */
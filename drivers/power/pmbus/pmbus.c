@@ -0,0 +1,934 @@
+/***************************************************************************//**
+ *   @file   pmbus.c
+ *   @brief  Implementation of the shared PMBus core
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include "no_os_units.h"
+#include "no_os_util.h"
+#include "no_os_delay.h"
+#include "no_os_alloc.h"
+#include "no_os_i2c.h"
+
+#include "pmbus.h"
+
+/*
+ * Values are scaled by 2^16 before the LINEAR exponent is applied, so that
+ * both positive and negative exponents are handled by a single right shift.
+ */
+#define PMBUS_LIN_SHIFT			16
+
+/**
+ * @brief Apply a LINEAR exponent to a mantissa and convert to milli-units.
+ * @param mantissa - LINEAR mantissa.
+ * @param exp - LINEAR exponent, between -16 and 15.
+ * @return Value in milli-units, saturated to the int32_t range.
+ */
+static inline int32_t pmbus_lin_to_milli(int32_t mantissa, int exp)
+{
+	int64_t val;
+
+	val = ((int64_t)mantissa * (int64_t)MILLI * (1LL << (exp + PMBUS_LIN_SHIFT)))
+	      >> PMBUS_LIN_SHIFT;
+
+	return (int32_t)no_os_clamp(val, (int64_t)INT32_MIN, (int64_t)INT32_MAX);
+}
+
+/**
+ * @brief Convert a LINEAR11 value to milli-units.
+ * @param data - LINEAR11 value.
+ * @return Value in milli-units (mV, mA, mW, m°C, etc.).
+ */
+int32_t pmbus_lin11_to_milli(uint16_t data)
+{
+	return pmbus_lin_to_milli(PMBUS_LIN11_MANTISSA(data),
+				  PMBUS_LIN11_EXPONENT(data));
+}
+
+/**
+ * @brief Convert milli-units to a LINEAR11 value, using the smallest exponent
+ * for which the mantissa fits.
+ * @param val - Value in milli-units (mV, mA, mW, m°C, etc.).
+ * @return LINEAR11 value.
+ */
+uint16_t pmbus_milli_to_lin11(int32_t val)
+{
+	int64_t mantissa = 0;
+	int exp;
+
+	for (exp = PMBUS_LIN11_EXPONENT_MIN; exp <= PMBUS_LIN11_EXPONENT_MAX;
+	     exp++) {
+		if (exp < 0)
+			mantissa = (int64_t)val * (1LL << -exp) / (int64_t)MILLI;
+		else
+			mantissa = (int64_t)val / ((int64_t)MILLI << exp);
+
+		if (mantissa <= PMBUS_LIN11_MANTISSA_MAX &&
+		    mantissa >= PMBUS_LIN11_MANTISSA_MIN)
+			break;
+	}
+
+	if (exp > PMBUS_LIN11_EXPONENT_MAX) {
+		exp = PMBUS_LIN11_EXPONENT_MAX;
+		mantissa = no_os_clamp(mantissa, (int64_t)PMBUS_LIN11_MANTISSA_MIN,
+				       (int64_t)PMBUS_LIN11_MANTISSA_MAX);
+	}
+
+	return (uint16_t)((((unsigned int)exp << 11) & 0xF800) |
+			  (mantissa & PMBUS_LIN11_MANTISSA_MSK));
+}
+
+/**
+ * @brief Convert a LINEAR16 value to milli-units.
+ * @param data - LINEAR16 mantissa.
+ * @param exp - Exponent from VOUT_MODE.
+ * @return Value in milli-units (mV).
+ */
+int32_t pmbus_lin16_to_milli(uint16_t data, int exp)
+{
+	return pmbus_lin_to_milli(data, exp);
+}
+
+/**
+ * @brief Convert milli-units to a LINEAR16 value.
+ * @param val - Value in milli-units (mV).
+ * @param exp - Exponent from VOUT_MODE.
+ * @return LINEAR16 mantissa, saturated to the 16 bit unsigned range.
+ */
+uint16_t pmbus_milli_to_lin16(int32_t val, int exp)
+{
+	int64_t mantissa;
+
+	if (exp < 0)
+		mantissa = (int64_t)val * (1LL << -exp) / (int64_t)MILLI;
+	else
+		mantissa = (int64_t)val / ((int64_t)MILLI << exp);
+
+	return (uint16_t)no_os_clamp(mantissa, 0, (int64_t)UINT16_MAX);
+}
+
+/**
+ * @brief Convert an array of LINEAR11 values to milli-units.
+ *
+ * The conversion is branch free, so that the compiler is able to vectorize
+ * the loop on targets which support it.
+ *
+ * @param raw - LINEAR11 values.
+ * @param vals - Values in milli-units.
+ * @param len - Number of values.
+ */
+void pmbus_lin11_decode(const uint16_t *raw, int32_t *vals, uint32_t len)
+{
+	uint32_t i;
+
+	for (i = 0; i < len; i++)
+		vals[i] = pmbus_lin_to_milli(PMBUS_LIN11_MANTISSA(raw[i]),
+					     PMBUS_LIN11_EXPONENT(raw[i]));
+}
+
+/**
+ * @brief Convert an array of LINEAR16 values sharing the same exponent to
+ * milli-units.
+ * @param raw - LINEAR16 mantissas.
+ * @param exp - Exponent from VOUT_MODE.
+ * @param vals - Values in milli-units.
+ * @param len - Number of values.
+ */
+void pmbus_lin16_decode(const uint16_t *raw, int exp, int32_t *vals,
+			uint32_t len)
+{
+	int64_t scale = (int64_t)MILLI * (1LL << (exp + PMBUS_LIN_SHIFT));
+	uint32_t i;
+
+	/* The mantissa is unsigned and at most 16 bits wide: no saturation */
+	if (exp <= 0) {
+		for (i = 0; i < len; i++)
+			vals[i] = (int32_t)((raw[i] * scale) >> PMBUS_LIN_SHIFT);
+		return;
+	}
+
+	for (i = 0; i < len; i++)
+		vals[i] = pmbus_lin_to_milli(raw[i], exp);
+}
+
+/**
+ * @brief Initialize the PMBus core.
+ * @param device - The device structure.
+ * @param init_param - Initialization parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int pmbus_init(struct pmbus_dev **device, struct pmbus_init_param *init_param)
+{
+	struct pmbus_dev *dev;
+	uint8_t i;
+	int ret;
+
+	if (!device || !init_param || !init_param->i2c_init)
+		return -EINVAL;
+
+	if (init_param->num_pages > PMBUS_MAX_PAGES ||
+	    init_param->nb_blocks > PMBUS_MAX_BLOCKS ||
+	    (init_param->nb_blocks && !init_param->blocks))
+		return -EINVAL;
+
+	for (i = 0; i < init_param->nb_blocks; i++)
+		if (!init_param->blocks[i].cmds ||
+		    init_param->blocks[i].nb_cmds * 2 > PMBUS_BLOCK_MAX)
+			return -EINVAL;
+
+	dev = no_os_calloc(1, sizeof(*dev));
+	if (!dev)
+		return -ENOMEM;
+
+	ret = no_os_i2c_init(&dev->i2c_desc, init_param->i2c_init);
+	if (ret)
+		goto error;
+
+	dev->num_pages = init_param->num_pages;
+	dev->blocks = init_param->blocks;
+	dev->nb_blocks = init_param->nb_blocks;
+	pmbus_invalidate(dev);
+
+	*device = dev;
+
+	return 0;
+
+error:
+	no_os_free(dev);
+
+	return ret;
+}
+
+/**
+ * @brief Free the resources allocated by pmbus_init().
+ * @param dev - The device structure.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int pmbus_remove(struct pmbus_dev *dev)
+{
+	int ret;
+
+	if (!dev)
+		return -EINVAL;
+
+	ret = no_os_i2c_remove(dev->i2c_desc);
+	if (ret)
+		return ret;
+
+	no_os_free(dev);
+
+	return 0;
+}
+
+/**
+ * @brief Drop the cached PAGE and VOUT_MODE state. Must be called if the
+ * device is accessed other than through the core (e.g. by another driver
+ * sharing the same address) or after a reset.
+ * @param dev - The device structure.
+ */
+void pmbus_invalidate(struct pmbus_dev *dev)
+{
+	if (!dev)
+		return;
+
+	dev->page = -1;
+	dev->vout_exp_valid = 0;
+}
+
+/**
+ * @brief Select a page. The write is skipped if the page is already selected.
+ * @param dev - The device structure.
+ * @param page - Page number, PMBUS_PAGE_ALL or PMBUS_NO_PAGE for commands
+ * 		 which are not paged.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int pmbus_set_page(struct pmbus_dev *dev, int page)
+{
+	uint8_t buff[2];
+	int ret;
+
+	if (!dev)
+		return -EINVAL;
+
+	if (page < 0 || !dev->num_pages)
+		return 0;
+
+	if (page != PMBUS_PAGE_ALL && page >= dev->num_pages)
+		return -EINVAL;
+
+	if (dev->page == page) {
+		dev->stats.page_hits++;
+		return 0;
+	}
+
+	buff[0] = PMBUS_PAGE;
+	buff[1] = page;
+
+	dev->stats.transfers++;
+	dev->stats.page_writes++;
+	ret = no_os_i2c_write(dev->i2c_desc, buff, 2, 1);
+	if (ret) {
+		dev->page = -1;
+		return ret;
+	}
+
+	dev->page = page;
+
+	return 0;
+}
+
+/**
+ * @brief Drop the cached VOUT_MODE exponent of a page.
+ * @param dev - The device structure.
+ * @param page - Page number, PMBUS_PAGE_ALL or PMBUS_NO_PAGE.
+ */
+static void pmbus_invalidate_vout_exp(struct pmbus_dev *dev, int page)
+{
+	if (page == PMBUS_PAGE_ALL)
+		dev->vout_exp_valid = 0;
+	else
+		dev->vout_exp_valid &= ~NO_OS_BIT(page < 0 ? 0 : page);
+}
+
+/**
+ * @brief Send a PMBus command without data.
+ * @param dev - The device structure.
+ * @param page - Page number or PMBUS_NO_PAGE.
+ * @param cmd - PMBus command.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int pmbus_send_byte(struct pmbus_dev *dev, int page, uint8_t cmd)
+{
+	int ret;
+
+	ret = pmbus_set_page(dev, page);
+	if (ret)
+		return ret;
+
+	dev->stats.transfers++;
+	ret = no_os_i2c_write(dev->i2c_desc, &cmd, 1, 1);
+	if (ret)
+		return ret;
+
+	/* Restoring the stored settings may change both PAGE and VOUT_MODE */
+	if (cmd == PMBUS_RESTORE_DEFAULT_ALL || cmd == PMBUS_RESTORE_USER_ALL)
+		pmbus_invalidate(dev);
+
+	return 0;
+}
+
+/**
+ * @brief Perform a PMBus read byte operation.
+ * @param dev - The device structure.
+ * @param page - Page number or PMBUS_NO_PAGE.
+ * @param cmd - PMBus command.
+ * @param data - Read data.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int pmbus_read_byte(struct pmbus_dev *dev, int page, uint8_t cmd,
+		    uint8_t *data)
+{
+	int ret;
+
+	if (!data)
+		return -EINVAL;
+
+	ret = pmbus_set_page(dev, page);
+	if (ret)
+		return ret;
+
+	dev->stats.transfers++;
+	ret = no_os_i2c_write(dev->i2c_desc, &cmd, 1, 0);
+	if (ret)
+		return ret;
+
+	return no_os_i2c_read(dev->i2c_desc, data, 1, 1);
+}
+
+/**
+ * @brief Perform a PMBus write byte operation.
+ * @param dev - The device structure.
+ * @param page - Page number or PMBUS_NO_PAGE.
+ * @param cmd - PMBus command.
+ * @param data - Data to write.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int pmbus_write_byte(struct pmbus_dev *dev, int page, uint8_t cmd,
+		     uint8_t data)
+{
+	uint8_t buff[2] = {cmd, data};
+	int ret;
+
+	if (cmd == PMBUS_PAGE)
+		return pmbus_set_page(dev, data);
+
+	ret = pmbus_set_page(dev, page);
+	if (ret)
+		return ret;
+
+	if (cmd == PMBUS_VOUT_MODE)
+		pmbus_invalidate_vout_exp(dev, page);
+
+	dev->stats.transfers++;
+
+	return no_os_i2c_write(dev->i2c_desc, buff, 2, 1);
+}
+
+/**
+ * @brief Perform a PMBus read word operation.
+ * @param dev - The device structure.
+ * @param page - Page number or PMBUS_NO_PAGE.
+ * @param cmd - PMBus command.
+ * @param word - Read word.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int pmbus_read_word(struct pmbus_dev *dev, int page, uint8_t cmd,
+		    uint16_t *word)
+{
+	uint8_t buff[2];
+	int ret;
+
+	if (!word)
+		return -EINVAL;
+
+	ret = pmbus_set_page(dev, page);
+	if (ret)
+		return ret;
+
+	dev->stats.transfers++;
+	ret = no_os_i2c_write(dev->i2c_desc, &cmd, 1, 0);
+	if (ret)
+		return ret;
+
+	ret = no_os_i2c_read(dev->i2c_desc, buff, 2, 1);
+	if (ret)
+		return ret;
+
+	*word = no_os_get_unaligned_le16(buff);
+
+	return 0;
+}
+
+/**
+ * @brief Perform a PMBus write word operation.
+ * @param dev - The device structure.
+ * @param page - Page number or PMBUS_NO_PAGE.
+ * @param cmd - PMBus command.
+ * @param word - Word to write.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int pmbus_write_word(struct pmbus_dev *dev, int page, uint8_t cmd,
+		     uint16_t word)
+{
+	uint8_t buff[3] = {cmd, word & 0xFF, word >> 8};
+	int ret;
+
+	ret = pmbus_set_page(dev, page);
+	if (ret)
+		return ret;
+
+	dev->stats.transfers++;
+
+	return no_os_i2c_write(dev->i2c_desc, buff, 3, 1);
+}
+
+/**
+ * @brief Perform an SMBus block read operation.
+ * @param dev - The device structure.
+ * @param page - Page number or PMBUS_NO_PAGE.
+ * @param cmd - PMBus command.
+ * @param data - Read data, without the byte count.
+ * @param len - Size of the data buffer as input, number of bytes returned by
+ * 		the device as output.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int pmbus_read_block(struct pmbus_dev *dev, int page, uint8_t cmd,
+		     uint8_t *data, uint8_t *len)
+{
+	uint8_t buff[PMBUS_BLOCK_MAX + 1];
+	uint8_t size;
+	int ret;
+
+	if (!data || !len || !*len)
+		return -EINVAL;
+
+	ret = pmbus_set_page(dev, page);
+	if (ret)
+		return ret;
+
+	size = no_os_min(*len, PMBUS_BLOCK_MAX);
+
+	dev->stats.transfers++;
+	dev->stats.block_reads++;
+	ret = no_os_i2c_write(dev->i2c_desc, &cmd, 1, 0);
+	if (ret)
+		return ret;
+
+	ret = no_os_i2c_read(dev->i2c_desc, buff, size + 1, 1);
+	if (ret)
+		return ret;
+
+	if (buff[0] > size)
+		return -EMSGSIZE;
+
+	memcpy(data, &buff[1], buff[0]);
+	*len = buff[0];
+
+	return 0;
+}
+
+/**
+ * @brief Get the LINEAR16 exponent of a page. VOUT_MODE is only read the
+ * first time, the value is cached until it is written or the cache is
+ * invalidated.
+ * @param dev - The device structure.
+ * @param page - Page number or PMBUS_NO_PAGE.
+ * @param exp - LINEAR16 exponent.
+ * @return 0 in case of success, -EOPNOTSUPP if the page does not use the
+ * 	   LINEAR16 format, negative error code otherwise.
+ */
+int pmbus_get_vout_exp(struct pmbus_dev *dev, int page, int *exp)
+{
+	uint8_t mode;
+	int idx;
+	int ret;
+
+	if (!dev || !exp || page == PMBUS_PAGE_ALL)
+		return -EINVAL;
+
+	idx = page < 0 ? 0 : page;
+	if (idx >= PMBUS_MAX_PAGES)
+		return -EINVAL;
+
+	if (dev->vout_exp_valid & NO_OS_BIT(idx)) {
+		dev->stats.vout_mode_hits++;
+		*exp = dev->vout_exp[idx];
+		return 0;
+	}
+
+	ret = pmbus_read_byte(dev, page, PMBUS_VOUT_MODE, &mode);
+	if (ret)
+		return ret;
+
+	if (no_os_field_get(PMBUS_VOUT_MODE_MODE_MSK, mode) !=
+	    PMBUS_VOUT_MODE_LINEAR)
+		return -EOPNOTSUPP;
+
+	/* Sign extend the 5 bit exponent */
+	dev->vout_exp[idx] = (int8_t)(no_os_field_get(PMBUS_VOUT_MODE_EXP_MSK,
+					     mode) << 3) >> 3;
+	dev->vout_exp_valid |= NO_OS_BIT(idx);
+	*exp = dev->vout_exp[idx];
+
+	return 0;
+}
+
+/**
+ * @brief Check if a sensor sorts before another one in scan order.
+ * @param a - First sensor.
+ * @param b - Second sensor.
+ * @return true if a must be read before b.
+ */
+static bool pmbus_scan_before(const struct pmbus_sensor *a,
+			      const struct pmbus_sensor *b)
+{
+	if (a->page != b->page)
+		return a->page < b->page;
+
+	return a->format < b->format;
+}
+
+/**
+ * @brief Build the scan order: values are grouped by page, so that PAGE is
+ * written once per page and scan, then by format, so that values are decoded
+ * in runs. Values returned by a block command are mapped to the block.
+ * @param scan - The scanner descriptor.
+ */
+static void pmbus_scan_plan(struct pmbus_scan *scan)
+{
+	const struct pmbus_sensor *s = scan->sensors;
+	const struct pmbus_block *blk;
+	struct pmbus_scan_run *run;
+	uint16_t i, j, tmp;
+	uint8_t b, k;
+
+	for (i = 0; i < scan->nb_sensors; i++)
+		scan->order[i] = i;
+
+	/* Stable insertion sort, the sensor list is short */
+	for (i = 1; i < scan->nb_sensors; i++) {
+		tmp = scan->order[i];
+		for (j = i; j > 0 && pmbus_scan_before(&s[tmp],
+						       &s[scan->order[j - 1]]); j--)
+			scan->order[j] = scan->order[j - 1];
+		scan->order[j] = tmp;
+	}
+
+	scan->nb_runs = 0;
+	scan->block_mask = 0;
+	for (i = 0; i < scan->nb_sensors; i++) {
+		const struct pmbus_sensor *sensor = &s[scan->order[i]];
+
+		scan->pos[scan->order[i]] = i;
+		scan->block[i] = -1;
+
+		for (b = 0; b < scan->dev->nb_blocks &&
+		     sensor->format != PMBUS_FORMAT_BYTE; b++) {
+			blk = &scan->dev->blocks[b];
+			if (blk->page != sensor->page)
+				continue;
+
+			for (k = 0; k < blk->nb_cmds; k++)
+				if (blk->cmds[k] == sensor->cmd)
+					break;
+
+			if (k == blk->nb_cmds)
+				continue;
+
+			scan->block[i] = b;
+			scan->block_off[i] = k;
+			scan->block_mask |= NO_OS_BIT(b);
+			break;
+		}
+
+		run = scan->nb_runs ? &scan->runs[scan->nb_runs - 1] : NULL;
+		if (!run || run->page != sensor->page ||
+		    run->format != sensor->format) {
+			run = &scan->runs[scan->nb_runs++];
+			run->start = i;
+			run->len = 0;
+			run->page = sensor->page;
+			run->format = sensor->format;
+		}
+		run->len++;
+	}
+}
+
+/**
+ * @brief Initialize a telemetry scanner.
+ * @param scan - The scanner descriptor.
+ * @param init_param - Initialization parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int pmbus_scan_init(struct pmbus_scan **scan,
+		    struct pmbus_scan_init_param *init_param)
+{
+	struct pmbus_scan *desc;
+	uint16_t i;
+
+	if (!scan || !init_param || !init_param->dev || !init_param->sensors ||
+	    !init_param->nb_sensors)
+		return -EINVAL;
+
+	for (i = 0; i < init_param->nb_sensors; i++)
+		if (init_param->dev->num_pages &&
+		    init_param->sensors[i].page >= init_param->dev->num_pages)
+			return -EINVAL;
+
+	desc = no_os_calloc(1, sizeof(*desc));
+	if (!desc)
+		return -ENOMEM;
+
+	desc->dev = init_param->dev;
+	desc->sensors = init_param->sensors;
+	desc->nb_sensors = init_param->nb_sensors;
+	desc->period_ms = init_param->period_ms;
+
+	desc->order = no_os_calloc(desc->nb_sensors, sizeof(*desc->order));
+	desc->pos = no_os_calloc(desc->nb_sensors, sizeof(*desc->pos));
+	desc->block = no_os_calloc(desc->nb_sensors, sizeof(*desc->block));
+	desc->block_off = no_os_calloc(desc->nb_sensors, sizeof(*desc->block_off));
+	desc->runs = no_os_calloc(desc->nb_sensors, sizeof(*desc->runs));
+	desc->raw = no_os_calloc(desc->nb_sensors, sizeof(*desc->raw));
+	desc->vals[0] = no_os_calloc(desc->nb_sensors, sizeof(*desc->vals[0]));
+	desc->vals[1] = no_os_calloc(desc->nb_sensors, sizeof(*desc->vals[1]));
+	if (!desc->order || !desc->pos || !desc->block || !desc->block_off ||
+	    !desc->runs || !desc->raw || !desc->vals[0] || !desc->vals[1]) {
+		pmbus_scan_remove(desc);
+		return -ENOMEM;
+	}
+
+	pmbus_scan_plan(desc);
+
+	*scan = desc;
+
+	return 0;
+}
+
+/**
+ * @brief Free the resources allocated by pmbus_scan_init().
+ * @param scan - The scanner descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int pmbus_scan_remove(struct pmbus_scan *scan)
+{
+	if (!scan)
+		return -EINVAL;
+
+	no_os_free(scan->vals[1]);
+	no_os_free(scan->vals[0]);
+	no_os_free(scan->raw);
+	no_os_free(scan->runs);
+	no_os_free(scan->block_off);
+	no_os_free(scan->block);
+	no_os_free(scan->pos);
+	no_os_free(scan->order);
+	no_os_free(scan);
+
+	return 0;
+}
+
+/**
+ * @brief Read the block commands of a page and scatter the returned words to
+ * the scan slots.
+ * @param scan - The scanner descriptor.
+ * @param page - Page of the blocks.
+ * @param start - First scan slot of the page.
+ * @param end - Scan slot following the last one of the page.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int pmbus_scan_read_blocks(struct pmbus_scan *scan, int8_t page,
+				  uint16_t start, uint16_t end)
+{
+	const struct pmbus_block *blk;
+	uint8_t buff[PMBUS_BLOCK_MAX];
+	uint8_t len;
+	uint16_t i;
+	uint8_t b;
+	int ret;
+
+	for (b = 0; b < scan->dev->nb_blocks; b++) {
+		blk = &scan->dev->blocks[b];
+		if (!(scan->block_mask & NO_OS_BIT(b)) || blk->page != page)
+			continue;
+
+		len = blk->nb_cmds * 2;
+		ret = pmbus_read_block(scan->dev, page, blk->cmd, buff, &len);
+		if (ret)
+			return ret;
+
+		if (len < blk->nb_cmds * 2)
+			return -EIO;
+
+		for (i = start; i < end; i++)
+			if (scan->block[i] == b)
+				scan->raw[i] = no_os_get_unaligned_le16(
+						       &buff[scan->block_off[i] * 2]);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Read the raw values of all sensors. PAGE is written at most once per
+ * page, block commands are used where the device provides them and the
+ * remaining values are read one command at a time.
+ * @param scan - The scanner descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int pmbus_scan_read_raw(struct pmbus_scan *scan)
+{
+	struct pmbus_scan_run *first, *run;
+	uint16_t r, n, i, end;
+	uint8_t byte;
+	int exp;
+	int ret;
+
+	for (r = 0; r < scan->nb_runs; r = n) {
+		first = &scan->runs[r];
+		for (n = r; n < scan->nb_runs && scan->runs[n].page == first->page; n++)
+			;
+		end = scan->runs[n - 1].start + scan->runs[n - 1].len;
+
+		ret = pmbus_scan_read_blocks(scan, first->page, first->start, end);
+		if (ret)
+			return ret;
+
+		for (run = first; run < &scan->runs[n]; run++) {
+			if (run->format == PMBUS_FORMAT_LINEAR16) {
+				ret = pmbus_get_vout_exp(scan->dev, run->page, &exp);
+				if (ret)
+					return ret;
+				run->exp = exp;
+			}
+
+			for (i = run->start; i < run->start + run->len; i++) {
+				if (scan->block[i] >= 0)
+					continue;
+
+				if (run->format == PMBUS_FORMAT_BYTE) {
+					ret = pmbus_read_byte(scan->dev, run->page,
+							      scan->sensors[scan->order[i]].cmd,
+							      &byte);
+					scan->raw[i] = byte;
+				} else {
+					ret = pmbus_read_word(scan->dev, run->page,
+							      scan->sensors[scan->order[i]].cmd,
+							      &scan->raw[i]);
+				}
+				if (ret)
+					return ret;
+			}
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Read all values, decode them and publish a new snapshot. The
+ * previous snapshot stays published if the scan fails.
+ * @param scan - The scanner descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int pmbus_scan_run(struct pmbus_scan *scan)
+{
+	struct pmbus_scan_run *run;
+	int32_t *vals;
+	uint16_t r, i;
+	int ret;
+
+	if (!scan)
+		return -EINVAL;
+
+	ret = pmbus_scan_read_raw(scan);
+	if (ret) {
+		scan->errors++;
+		return ret;
+	}
+
+	vals = scan->vals[!scan->active];
+	for (r = 0; r < scan->nb_runs; r++) {
+		run = &scan->runs[r];
+
+		switch (run->format) {
+		case PMBUS_FORMAT_LINEAR11:
+			pmbus_lin11_decode(&scan->raw[run->start],
+					   &vals[run->start], run->len);
+			break;
+		case PMBUS_FORMAT_LINEAR16:
+			pmbus_lin16_decode(&scan->raw[run->start], run->exp,
+					   &vals[run->start], run->len);
+			break;
+		default:
+			for (i = run->start; i < run->start + run->len; i++)
+				vals[i] = scan->raw[i];
+			break;
+		}
+	}
+
+	scan->timestamp = no_os_get_time();
+	scan->active = !scan->active;
+	scan->seq++;
+
+	return 0;
+}
+
+/**
+ * @brief Run a scan if no snapshot was published yet or if the scan period
+ * has elapsed since the last one.
+ * @param scan - The scanner descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int pmbus_scan_poll(struct pmbus_scan *scan)
+{
+	struct no_os_time now;
+	int64_t elapsed;
+
+	if (!scan)
+		return -EINVAL;
+
+	if (scan->seq) {
+		now = no_os_get_time();
+		elapsed = ((int64_t)now.s - scan->timestamp.s) * (int64_t)MILLI +
+			  ((int64_t)now.us - scan->timestamp.us) / (int64_t)MILLI;
+		if (elapsed < scan->period_ms)
+			return 0;
+	}
+
+	return pmbus_scan_run(scan);
+}
+
+/**
+ * @brief Copy the last published snapshot. The copy is retried if a new
+ * snapshot gets published meanwhile, so all values belong to the same scan.
+ * @param scan - The scanner descriptor.
+ * @param vals - Values in sensor order, nb_sensors elements.
+ * @param seq - Sequence number of the snapshot, may be NULL.
+ * @return 0 in case of success, -EAGAIN if no snapshot was published yet,
+ * 	   negative error code otherwise.
+ */
+int pmbus_scan_get(struct pmbus_scan *scan, int32_t *vals, uint32_t *seq)
+{
+	const int32_t *snap;
+	uint32_t cnt;
+	uint16_t i;
+
+	if (!scan || !vals)
+		return -EINVAL;
+
+	do {
+		cnt = scan->seq;
+		if (!cnt)
+			return -EAGAIN;
+
+		snap = scan->vals[scan->active];
+		for (i = 0; i < scan->nb_sensors; i++)
+			vals[i] = snap[scan->pos[i]];
+	} while (cnt != scan->seq);
+
+	if (seq)
+		*seq = cnt;
+
+	return 0;
+}
+
+/**
+ * @brief Get one value of the last published snapshot.
+ * @param scan - The scanner descriptor.
+ * @param idx - Sensor index.
+ * @param val - Value.
+ * @return 0 in case of success, -EAGAIN if no snapshot was published yet,
+ * 	   negative error code otherwise.
+ */
+int pmbus_scan_read(struct pmbus_scan *scan, uint16_t idx, int32_t *val)
+{
+	if (!scan || !val || idx >= scan->nb_sensors)
+		return -EINVAL;
+
+	if (!scan->seq)
+		return -EAGAIN;
+
+	*val = scan->vals[scan->active][scan->pos[idx]];
+
+	return 0;
+}
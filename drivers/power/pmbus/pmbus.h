@@ -0,0 +1,326 @@
+/***************************************************************************//**
+ *   @file   pmbus.h
+ *   @brief  Header file of the shared PMBus core
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef __PMBUS_H__
+#define __PMBUS_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "no_os_delay.h"
+#include "no_os_i2c.h"
+#include "no_os_util.h"
+
+/* Standard PMBus commands handled by the core */
+#define PMBUS_PAGE				0x00
+#define PMBUS_RESTORE_DEFAULT_ALL		0x12
+#define PMBUS_RESTORE_USER_ALL			0x16
+#define PMBUS_VOUT_MODE				0x20
+
+/* PAGE values */
+#define PMBUS_PAGE_ALL				0xFF
+#define PMBUS_NO_PAGE				(-1)
+#define PMBUS_MAX_PAGES				32
+
+/* VOUT_MODE fields */
+#define PMBUS_VOUT_MODE_MODE_MSK		NO_OS_GENMASK(7, 5)
+#define PMBUS_VOUT_MODE_EXP_MSK			NO_OS_GENMASK(4, 0)
+#define PMBUS_VOUT_MODE_LINEAR			0
+
+/* LINEAR11 fields */
+#define PMBUS_LIN11_MANTISSA_MAX		1023
+#define PMBUS_LIN11_MANTISSA_MIN		(-1024)
+#define PMBUS_LIN11_EXPONENT_MAX		15
+#define PMBUS_LIN11_EXPONENT_MIN		(-16)
+#define PMBUS_LIN11_MANTISSA_MSK		NO_OS_GENMASK(10, 0)
+#define PMBUS_LIN11_EXPONENT(x)			((int16_t)(x) >> 11)
+#define PMBUS_LIN11_MANTISSA(x)			(((int16_t)(((x) & PMBUS_LIN11_MANTISSA_MSK) << 5)) >> 5)
+
+/* SMBus block read limits (byte count excluded) */
+#define PMBUS_BLOCK_MAX				32
+
+/* Maximum number of block telemetry commands per device */
+#define PMBUS_MAX_BLOCKS			32
+
+/**
+ * @enum pmbus_format
+ * @brief Data format of a PMBus telemetry command.
+ */
+enum pmbus_format {
+	/** Raw 8 bit value, read using READ_BYTE */
+	PMBUS_FORMAT_BYTE,
+	/** Raw 16 bit value, read using READ_WORD */
+	PMBUS_FORMAT_WORD,
+	/** LINEAR11 value, decoded to milli-units */
+	PMBUS_FORMAT_LINEAR11,
+	/** LINEAR16 value using the VOUT_MODE exponent, decoded to milli-units */
+	PMBUS_FORMAT_LINEAR16,
+};
+
+/**
+ * @enum pmbus_sensor_type
+ * @brief Physical quantity reported by a PMBus telemetry command.
+ */
+enum pmbus_sensor_type {
+	PMBUS_SENSOR_VOLTAGE,
+	PMBUS_SENSOR_CURRENT,
+	PMBUS_SENSOR_POWER,
+	PMBUS_SENSOR_TEMP,
+	PMBUS_SENSOR_FREQUENCY,
+	PMBUS_SENSOR_STATUS,
+};
+
+/**
+ * @struct pmbus_sensor
+ * @brief PMBus telemetry value descriptor.
+ */
+struct pmbus_sensor {
+	/** Sensor name */
+	const char *name;
+	/** Physical quantity */
+	enum pmbus_sensor_type type;
+	/** Page of the command or PMBUS_NO_PAGE for unpaged commands */
+	int8_t page;
+	/** PMBus command */
+	uint8_t cmd;
+	/** Data format */
+	enum pmbus_format format;
+};
+
+/**
+ * @struct pmbus_block
+ * @brief Device specific block command returning several telemetry words of a
+ * page at once, in little endian order.
+ */
+struct pmbus_block {
+	/** Page of the block or PMBUS_NO_PAGE for unpaged blocks */
+	int8_t page;
+	/** Block read command */
+	uint8_t cmd;
+	/** Commands whose values are returned by the block, in order */
+	const uint8_t *cmds;
+	/** Number of words in the block */
+	uint8_t nb_cmds;
+};
+
+/**
+ * @struct pmbus_stats
+ * @brief I2C traffic issued by the core.
+ */
+struct pmbus_stats {
+	/** I2C transactions, a command write and a repeated start read count once */
+	uint32_t transfers;
+	/** PAGE writes */
+	uint32_t page_writes;
+	/** PAGE writes avoided by the cache */
+	uint32_t page_hits;
+	/** VOUT_MODE reads avoided by the cache */
+	uint32_t vout_mode_hits;
+	/** Block reads */
+	uint32_t block_reads;
+};
+
+/**
+ * @struct pmbus_init_param
+ * @brief PMBus core initialization parameters.
+ */
+struct pmbus_init_param {
+	/** I2C initialization parameters */
+	struct no_os_i2c_init_param *i2c_init;
+	/** Number of pages, 0 for unpaged devices */
+	uint8_t num_pages;
+	/** Block telemetry commands supported by the device, may be NULL */
+	const struct pmbus_block *blocks;
+	/** Number of block telemetry commands */
+	uint8_t nb_blocks;
+};
+
+/**
+ * @struct pmbus_dev
+ * @brief PMBus core descriptor.
+ */
+struct pmbus_dev {
+	struct no_os_i2c_desc *i2c_desc;
+	uint8_t num_pages;
+	/** Currently selected page, -1 if unknown */
+	int page;
+	/** Cached VOUT_MODE exponent of each page */
+	int8_t vout_exp[PMBUS_MAX_PAGES];
+	/** Mask of the pages whose VOUT_MODE exponent is cached */
+	uint32_t vout_exp_valid;
+	const struct pmbus_block *blocks;
+	uint8_t nb_blocks;
+	struct pmbus_stats stats;
+};
+
+/**
+ * @struct pmbus_scan_init_param
+ * @brief PMBus scanner initialization parameters.
+ */
+struct pmbus_scan_init_param {
+	/** PMBus core descriptor */
+	struct pmbus_dev *dev;
+	/** Telemetry values to be scanned */
+	const struct pmbus_sensor *sensors;
+	/** Number of telemetry values */
+	uint16_t nb_sensors;
+	/** Minimum time between two scans in milliseconds */
+	uint32_t period_ms;
+};
+
+/**
+ * @struct pmbus_scan_run
+ * @brief Run of values sharing the same page and format in scan order.
+ */
+struct pmbus_scan_run {
+	uint16_t start;
+	uint16_t len;
+	int8_t page;
+	/** VOUT_MODE exponent used by LINEAR16 runs */
+	int8_t exp;
+	enum pmbus_format format;
+};
+
+/**
+ * @struct pmbus_scan
+ * @brief PMBus scanner descriptor.
+ *
+ * Values are stored in scan order, grouped by page and format. The decoded
+ * values are double buffered and published together with a sequence number,
+ * so that readers always observe the values of a single scan.
+ */
+struct pmbus_scan {
+	struct pmbus_dev *dev;
+	const struct pmbus_sensor *sensors;
+	uint16_t nb_sensors;
+	uint32_t period_ms;
+	/** Sensor index of each scan slot */
+	uint16_t *order;
+	/** Scan slot of each sensor */
+	uint16_t *pos;
+	/** Block index of each scan slot, -1 if read using a word read */
+	int8_t *block;
+	/** Word offset in the block of each scan slot */
+	uint8_t *block_off;
+	/** Mask of the blocks holding at least one scanned value */
+	uint32_t block_mask;
+	struct pmbus_scan_run *runs;
+	uint16_t nb_runs;
+	/** Raw values of the last scan */
+	uint16_t *raw;
+	/** Decoded snapshots */
+	int32_t *vals[2];
+	/** Snapshot published to readers */
+	volatile uint8_t active;
+	/** Number of published snapshots */
+	volatile uint32_t seq;
+	/** Time of the last published snapshot */
+	struct no_os_time timestamp;
+	/** Number of failed scans */
+	uint32_t errors;
+};
+
+/* Initialize the PMBus core. */
+int pmbus_init(struct pmbus_dev **device, struct pmbus_init_param *init_param);
+
+/* Free the resources allocated by pmbus_init(). */
+int pmbus_remove(struct pmbus_dev *dev);
+
+/* Drop the cached PAGE and VOUT_MODE state. */
+void pmbus_invalidate(struct pmbus_dev *dev);
+
+/* Select a page, skipping the write if already selected. */
+int pmbus_set_page(struct pmbus_dev *dev, int page);
+
+/* Send a PMBus command without data. */
+int pmbus_send_byte(struct pmbus_dev *dev, int page, uint8_t cmd);
+
+/* Perform a PMBus read byte operation. */
+int pmbus_read_byte(struct pmbus_dev *dev, int page, uint8_t cmd,
+		    uint8_t *data);
+
+/* Perform a PMBus write byte operation. */
+int pmbus_write_byte(struct pmbus_dev *dev, int page, uint8_t cmd,
+		     uint8_t data);
+
+/* Perform a PMBus read word operation. */
+int pmbus_read_word(struct pmbus_dev *dev, int page, uint8_t cmd,
+		    uint16_t *word);
+
+/* Perform a PMBus write word operation. */
+int pmbus_write_word(struct pmbus_dev *dev, int page, uint8_t cmd,
+		     uint16_t word);
+
+/* Perform an SMBus block read operation. */
+int pmbus_read_block(struct pmbus_dev *dev, int page, uint8_t cmd,
+		     uint8_t *data, uint8_t *len);
+
+/* Get the LINEAR16 exponent of a page, reading VOUT_MODE only once. */
+int pmbus_get_vout_exp(struct pmbus_dev *dev, int page, int *exp);
+
+/* Convert a LINEAR11 value to milli-units. */
+int32_t pmbus_lin11_to_milli(uint16_t data);
+
+/* Convert milli-units to a LINEAR11 value. */
+uint16_t pmbus_milli_to_lin11(int32_t val);
+
+/* Convert a LINEAR16 value to milli-units. */
+int32_t pmbus_lin16_to_milli(uint16_t data, int exp);
+
+/* Convert milli-units to a LINEAR16 value. */
+uint16_t pmbus_milli_to_lin16(int32_t val, int exp);
+
+/* Convert an array of LINEAR11 values to milli-units. */
+void pmbus_lin11_decode(const uint16_t *raw, int32_t *vals, uint32_t len);
+
+/* Convert an array of LINEAR16 values to milli-units. */
+void pmbus_lin16_decode(const uint16_t *raw, int exp, int32_t *vals,
+			uint32_t len);
+
+/* Initialize a telemetry scanner. */
+int pmbus_scan_init(struct pmbus_scan **scan,
+		    struct pmbus_scan_init_param *init_param);
+
+/* Free the resources allocated by pmbus_scan_init(). */
+int pmbus_scan_remove(struct pmbus_scan *scan);
+
+/* Read all values grouped by page, decode them and publish a snapshot. */
+int pmbus_scan_run(struct pmbus_scan *scan);
+
+/* Run a scan if the scan period has elapsed. */
+int pmbus_scan_poll(struct pmbus_scan *scan);
+
+/* Copy the last published snapshot. */
+int pmbus_scan_get(struct pmbus_scan *scan, int32_t *vals, uint32_t *seq);
+
+/* Get one value of the last published snapshot. */
+int pmbus_scan_read(struct pmbus_scan *scan, uint16_t idx, int32_t *val);
+
+#endif /* __PMBUS_H__ */
@@ -1108,7 +1108,7 @@ int adrv904x_setup(struct adrv904x_rf_phy *phy)
 	struct no_os_clk_desc *orx_sample_clk = NULL;
 	struct no_os_clk_desc *rx_sample_clk = NULL;
 	struct no_os_clk_desc *tx_sample_clk = NULL;
-	struct no_os_clk_init_param clk_init;
+	struct no_os_clk_init_param clk_init = { 0 };
 	const char *dev_name = "ADRV9040";
 	adi_adrv904x_Version_t apiVersion;
 	adi_common_ErrData_t* errPtr;
@@ -1341,7 +1341,7 @@ int adrv9025_setup(struct adrv9025_rf_phy *phy)
 	struct no_os_clk_desc *orx_sample_clk = NULL;
 	struct no_os_clk_desc *rx_sample_clk = NULL;
 	struct no_os_clk_desc *tx_sample_clk = NULL;
-	struct no_os_clk_init_param clk_init;
+	struct no_os_clk_init_param clk_init = { 0 };
 	adi_adrv9025_ApiVersion_t apiVersion;
 	int ret, i;
 
@@ -36,6 +36,7 @@
 #include "iio.h"
 #include "iio_types.h"
 #include "iiod.h"
+#include "iio_dsp.h"
 #include "ctype.h"
 #include "no_os_util.h"
 #include "no_os_list.h"
@@ -44,6 +45,7 @@
 #include "no_os_error.h"
 #include "no_os_alloc.h"
 #include "no_os_circular_buffer.h"
+#include "no_os_trace.h"
 #include <inttypes.h>
 #include <stdio.h>
 #include <string.h>
@@ -70,6 +72,9 @@
 
 static char uart_buff[IIOD_CONN_BUFFER_SIZE];
 
+NO_OS_TRACE_POINT(iio_step_tp, "iio_step");
+NO_OS_TRACE_POINT(iio_trigger_handler_tp, "iio_trigger_handler");
+
 static const char header[] =
 	"<?xml version=\"1.0\" encoding=\"utf-8\"?>"
 	"<!DOCTYPE context ["
@@ -173,6 +178,8 @@ struct iio_dev_priv {
 	struct iio_buffer_priv buffer;
 	/* Set to -1 when no trigger is set*/
 	uint32_t		trig_idx;
+	/* Optional processing stage of the input scans */
+	struct iio_dsp		*dsp;
 };
 
 /**
@@ -470,6 +477,9 @@ static int iio_rd_wr_attribute(struct attr_fun_params *params,
 {
 	int16_t i = 0;
 
+	if (!attributes)
+		return -ENOENT;
+
 	/* Search attribute */
 	while (attributes[i].name) {
 		if (!strcmp(attr_name, attributes[i].name))
@@ -812,6 +822,21 @@ static struct iio_attribute *get_trig_attributes(enum iio_attr_type type,
 	return NULL;
 }
 
+/**
+ * @brief Check if an attribute is the sampling frequency of a device whose
+ * input scans go through a processing stage.
+ * @param dev - IIO device.
+ * @param attr - Attribute.
+ * @return true if the value has to be scaled by the decimation ratio.
+ */
+static bool iio_is_dsp_rate_attr(struct iio_dev_priv *dev,
+				 struct iiod_attr *attr)
+{
+	return dev->dsp && !strcmp(attr->name, "sampling_frequency") &&
+	       (attr->type == IIO_ATTR_TYPE_DEVICE ||
+		attr->type == IIO_ATTR_TYPE_CH_IN);
+}
+
 /**
  * @brief Read global attribute of a device.
  * @param ctx - IIO instance and conn instance
@@ -875,6 +900,15 @@ static int iio_read_attr(struct iiod_ctx *ctx, const char *device,
 				ret = iio_rd_wr_shared_attr(&params,
 							    dev->dev_descriptor,
 							    attr->name, 0);
+			if (ret == -ENOENT && dev->dsp &&
+			    attr->type == IIO_ATTR_TYPE_BUFFER) {
+				params.dev_instance = dev->dsp;
+				ret = iio_rd_wr_attribute(&params,
+							  iio_dsp_buffer_attributes,
+							  attr->name, 0);
+			}
+			if (iio_is_dsp_rate_attr(dev, attr))
+				ret = iio_dsp_rate_read(dev->dsp, buf, len, ret);
 			return ret;
 		}
 	}
@@ -954,8 +988,20 @@ static int iio_write_attr(struct iiod_ctx *ctx, const char *device,
 		if (!strcmp(attr->name, ""))
 			return iio_write_all_attr(&params, attributes);
 		{
+			char rate[32];
 			int ret;
 
+			if (iio_is_dsp_rate_attr(dev, attr)) {
+				ret = iio_dsp_rate_write(dev->dsp, buf, rate,
+							 sizeof(rate));
+				if (NO_OS_IS_ERR_VALUE(ret))
+					return ret;
+				if (ret) {
+					params.buf = rate;
+					params.len = ret;
+				}
+			}
+
 			ret = iio_rd_wr_attribute(&params, attributes,
 						  attr->name, 1);
 			if (ret == -ENOENT &&
@@ -963,6 +1009,15 @@ static int iio_write_attr(struct iiod_ctx *ctx, const char *device,
 				ret = iio_rd_wr_shared_attr(&params,
 							    dev->dev_descriptor,
 							    attr->name, 1);
+			if (ret == -ENOENT && dev->dsp &&
+			    attr->type == IIO_ATTR_TYPE_BUFFER) {
+				params.dev_instance = dev->dsp;
+				ret = iio_rd_wr_attribute(&params,
+							  iio_dsp_buffer_attributes,
+							  attr->name, 1);
+			}
+			if (ret > 0 && params.buf == rate)
+				ret = len;
 			return ret;
 		}
 	}
@@ -1124,7 +1179,9 @@ static void iio_process_async_triggers(struct iio_desc *desc)
 			continue;
 
 		if (dev->dev_descriptor->trigger_handler) {
+			NO_OS_TRACE_BEGIN(ts);
 			dev->dev_descriptor->trigger_handler(&dev->dev_data);
+			NO_OS_TRACE_END(iio_trigger_handler_tp, ts);
 			desc->trigs[i].triggered = 0;
 		}
 	}
@@ -1156,8 +1213,11 @@ int iio_process_trigger_type(struct iio_desc *desc, char *trigger_name)
 		if (dev->trig_idx == trig_id) {
 			trig = &desc->trigs[trig_id];
 			if (trig->descriptor->is_synchronous) {
-				if (dev->dev_descriptor->trigger_handler)
+				if (dev->dev_descriptor->trigger_handler) {
+					NO_OS_TRACE_BEGIN(ts);
 					dev->dev_descriptor->trigger_handler(&dev->dev_data);
+					NO_OS_TRACE_END(iio_trigger_handler_tp, ts);
+				}
 			} else {
 				trig->triggered = 1;
 			}
@@ -1214,6 +1274,7 @@ static int iio_open_dev(struct iiod_ctx *ctx, const char *device,
 	int32_t ret;
 	int8_t *buf;
 	uint32_t buf_size;
+	uint32_t cb_size;
 
 	dev = get_iio_device(ctx->instance, device);
 	if (!dev)
@@ -1235,12 +1296,28 @@ static int iio_open_dev(struct iiod_ctx *ctx, const char *device,
 		bytes_per_scan(dev->dev_descriptor->channels, mask);
 	dev->buffer.public.size = dev->buffer.public.bytes_per_scan * samples;
 	dev->buffer.public.samples = samples;
+	dev->buffer.public.buf = &dev->buffer.cb;
+	cb_size = dev->buffer.public.size;
+	if (dev->dsp) {
+		/*
+		 * If processing is needed, the device writes its scans to the
+		 * stage and cb holds the processed scans.
+		 */
+		ret = iio_dsp_open(dev->dsp, &dev->buffer.public, &cb_size);
+		if (NO_OS_IS_ERR_VALUE(ret)) {
+			iio_dsp_close(dev->dsp);
+			return ret;
+		}
+	}
+
 	if (dev->buffer.raw_buf && dev->buffer.raw_buf_len) {
-		if (dev->buffer.raw_buf_len < dev->buffer.public.size)
+		if (dev->buffer.raw_buf_len < cb_size) {
 			/* Need a bigger buffer or to allocate */
+			iio_dsp_close(dev->dsp);
 			return -ENOMEM;
+		}
 		buf_size = dev->buffer.raw_buf_len - (dev->buffer.raw_buf_len %
-						      dev->buffer.public.size);
+						      cb_size);
 		buf = dev->buffer.raw_buf;
 	} else {
 		if (dev->buffer.allocated) {
@@ -1248,10 +1325,12 @@ static int iio_open_dev(struct iiod_ctx *ctx, const char *device,
 			no_os_free(dev->buffer.cb.buff);
 			dev->buffer.allocated = 0;
 		}
-		buf_size = dev->buffer.public.size;
-		buf = (int8_t *)no_os_calloc(dev->buffer.public.size, sizeof(*buf));
-		if (!buf)
+		buf_size = cb_size;
+		buf = (int8_t *)no_os_calloc(cb_size, sizeof(*buf));
+		if (!buf) {
+			iio_dsp_close(dev->dsp);
 			return -ENOMEM;
+		}
 		dev->buffer.allocated = 1;
 	}
 
@@ -1261,6 +1340,7 @@ static int iio_open_dev(struct iiod_ctx *ctx, const char *device,
 			no_os_free(dev->buffer.cb.buff);
 			dev->buffer.allocated = 0;
 		}
+		iio_dsp_close(dev->dsp);
 
 		return ret;
 	}
@@ -1272,6 +1352,7 @@ static int iio_open_dev(struct iiod_ctx *ctx, const char *device,
 				no_os_free(dev->buffer.cb.buff);
 				dev->buffer.allocated = 0;
 			}
+			iio_dsp_close(dev->dsp);
 			return ret;
 		}
 	}
@@ -1326,6 +1407,10 @@ static int iio_close_dev(struct iiod_ctx *ctx, const char *device)
 	if (dev->dev_descriptor->post_disable)
 		ret = dev->dev_descriptor->post_disable(dev->dev_instance);
 
+	/* The device no longer writes to the stage */
+	iio_dsp_close(dev->dsp);
+	dev->buffer.public.buf = &dev->buffer.cb;
+
 	return ret;
 }
 
@@ -1376,7 +1461,33 @@ static int iio_push_buffer(struct iiod_ctx *ctx, const char *device)
 
 static int iio_refill_buffer(struct iiod_ctx *ctx, const char *device)
 {
-	return iio_call_submit(ctx, device, IIO_DIRECTION_INPUT);
+	struct iio_dev_priv *dev;
+	uint32_t i, blocks;
+	int ret;
+
+	dev = get_iio_device(ctx->instance, device);
+	if (!dev || !dev->buffer.initalized)
+		return -EINVAL;
+
+	/*
+	 * With a decimating processing stage, a client block is made of
+	 * several device blocks, each one processed to make room for the next.
+	 */
+	blocks = iio_dsp_blocks(dev->dsp);
+	for (i = 0; i < blocks; i++) {
+		ret = iio_call_submit(ctx, device, IIO_DIRECTION_INPUT);
+		if (NO_OS_IS_ERR_VALUE(ret) || blocks == 1)
+			return ret;
+
+		ret = iio_dsp_process(dev->dsp, &dev->buffer.cb);
+#ifdef IIO_IGNORE_BUFF_OVERRUN_ERR
+		if (ret != -NO_OS_EOVERRUN)
+#endif
+			if (NO_OS_IS_ERR_VALUE(ret))
+				return ret;
+	}
+
+	return 0;
 }
 
 /**
@@ -1399,6 +1510,16 @@ static int iio_read_buffer(struct iiod_ctx *ctx, const char *device, char *buf,
 	if (!dev || !dev->buffer.initalized)
 		return -EINVAL;
 
+	/* Process the scans pushed by the device since the last read */
+	if (dev->dsp) {
+		ret = iio_dsp_process(dev->dsp, &dev->buffer.cb);
+#ifdef IIO_IGNORE_BUFF_OVERRUN_ERR
+		if (ret != -NO_OS_EOVERRUN)
+#endif
+			if (NO_OS_IS_ERR_VALUE(ret))
+				return ret;
+	}
+
 	ret = no_os_cb_size(&dev->buffer.cb, &size);
 #ifdef IIO_IGNORE_BUFF_OVERRUN_ERR
 	/* NOTE: Buffer overrun error checking is disabled. */
@@ -1557,7 +1678,7 @@ close_socket:
  * @param desc - IIo descriptor
  * @return 0 in case of success or negative value otherwise.
  */
-int iio_step(struct iio_desc *desc)
+static int _iio_step(struct iio_desc *desc)
 {
 	uint32_t conn_id;
 	int32_t ret;
@@ -1610,6 +1731,22 @@ int iio_step(struct iio_desc *desc)
 	return ret;
 }
 
+/**
+ * @brief Execute an iio step
+ * @param desc - IIo descriptor
+ * @return 0 in case of success or negative value otherwise.
+ */
+int iio_step(struct iio_desc *desc)
+{
+	int ret;
+
+	NO_OS_TRACE_BEGIN(ts);
+	ret = _iio_step(desc);
+	NO_OS_TRACE_END(iio_step_tp, ts);
+
+	return ret;
+}
+
 /**
  * @brief Add context attributes into xml string buffer.
  * @param desc - IIo descriptor.
@@ -1658,13 +1795,16 @@ static uint32_t iio_add_ctx_attr_in_xml(struct iio_desc *desc, char *buff,
  * Generate an xml describing a device and write it to buff.
  * Will return the size of the xml.
  * If buff_size is 0, no data will be written to buff, but size will be returned
+ * If dsp is set, the scan elements describe the processed scans.
  */
-static uint32_t iio_generate_device_xml(struct iio_device *device, char *name,
+static uint32_t iio_generate_device_xml(struct iio_device *device,
+					struct iio_dsp *dsp, char *name,
 					char *id, char *buff,
 					uint32_t buff_size)
 {
 	struct iio_channel	*ch;
 	struct iio_attribute	*attr;
+	struct scan_type	*scan_type;
 	char			ch_id[50];
 	int32_t			i;
 	int32_t			j;
@@ -1703,16 +1843,18 @@ static uint32_t iio_generate_device_xml(struct iio_device *device, char *name,
 				      " type=\"%s\" >",
 				      ch->ch_out ? "output" : "input");
 
-			if (ch->scan_type)
+			scan_type = dsp ? iio_dsp_scan_type(dsp, j) :
+				    ch->scan_type;
+			if (scan_type)
 				i += snprintf(buff + i, no_os_max(n - i, 0),
 					      "<scan-element index=\"%d\""
 					      " format=\"%s:%c%d/%d>>%d\" />",
 					      ch->scan_index,
-					      ch->scan_type->is_big_endian ? "be" : "le",
-					      ch->scan_type->sign,
-					      ch->scan_type->realbits,
-					      ch->scan_type->storagebits,
-					      ch->scan_type->shift);
+					      scan_type->is_big_endian ? "be" : "le",
+					      scan_type->sign,
+					      scan_type->realbits,
+					      scan_type->storagebits,
+					      scan_type->shift);
 
 			/* Write channel attributes */
 			if (ch->attributes)
@@ -1855,13 +1997,19 @@ static uint32_t iio_generate_device_xml(struct iio_device *device, char *name,
 	 */
 	if (device->read_dev || device->write_dev || device->submit ||
 	    device->trigger_handler) {
-		if (device->buffer_attributes) {
+		if (device->buffer_attributes || dsp) {
 			i += snprintf(buff + i, no_os_max(n - i, 0),
 				      "<buffer index=\"0\">");
-			for (j = 0; device->buffer_attributes[j].name; j++)
-				i += snprintf(buff + i, no_os_max(n - i, 0),
-					      "<attribute name=\"%s\" />",
-					      device->buffer_attributes[j].name);
+			if (device->buffer_attributes)
+				for (j = 0; device->buffer_attributes[j].name; j++)
+					i += snprintf(buff + i, no_os_max(n - i, 0),
+						      "<attribute name=\"%s\" />",
+						      device->buffer_attributes[j].name);
+			if (dsp)
+				for (j = 0; iio_dsp_buffer_attributes[j].name; j++)
+					i += snprintf(buff + i, no_os_max(n - i, 0),
+						      "<attribute name=\"%s\" />",
+						      iio_dsp_buffer_attributes[j].name);
 			i += snprintf(buff + i, no_os_max(n - i, 0),
 				      "</buffer>");
 		} else {
@@ -1887,15 +2035,15 @@ static int32_t iio_init_xml(struct iio_desc *desc)
 	size += iio_add_ctx_attr_in_xml(desc, NULL, -1);
 	for (i = 0; i < desc->nb_devs; i++) {
 		dev = desc->devs + i;
-		size += iio_generate_device_xml(dev->dev_descriptor,
+		size += iio_generate_device_xml(dev->dev_descriptor, dev->dsp,
 						(char *)dev->name,
 						dev->dev_id, NULL, -1);
 	}
 	for (i = 0; i < desc->nb_trigs; i++) {
 		trig = desc->trigs + i;
 		dummy.attributes = trig->descriptor->attributes;
-		size += iio_generate_device_xml(&dummy, trig->name, trig->id,
-						NULL, -1);
+		size += iio_generate_device_xml(&dummy, NULL, trig->name,
+						trig->id, NULL, -1);
 	}
 
 	desc->xml_desc = (char *)no_os_calloc(size + 1, sizeof(*desc->xml_desc));
@@ -1909,15 +2057,16 @@ static int32_t iio_init_xml(struct iio_desc *desc)
 	of += iio_add_ctx_attr_in_xml(desc, desc->xml_desc + of, size - of);
 	for (i = 0; i < desc->nb_devs; i++) {
 		dev = desc->devs + i;
-		of += iio_generate_device_xml(dev->dev_descriptor,
+		of += iio_generate_device_xml(dev->dev_descriptor, dev->dsp,
 					      (char *)dev->name, dev->dev_id,
 					      desc->xml_desc + of, size - of);
 	}
 	for (i = 0; i < desc->nb_trigs; i++) {
 		trig = desc->trigs + i;
 		dummy.attributes = trig->descriptor->attributes;
-		of += iio_generate_device_xml(&dummy, trig->name, trig->id,
-					      desc->xml_desc + of, size - of);
+		of += iio_generate_device_xml(&dummy, NULL, trig->name,
+					      trig->id, desc->xml_desc + of,
+					      size - of);
 	}
 
 	strcpy(desc->xml_desc + of, header_end);
@@ -1925,10 +2074,28 @@ static int32_t iio_init_xml(struct iio_desc *desc)
 	return 0;
 }
 
+/**
+ * @brief Free the processing stages of the devices.
+ * @param desc - IIO descriptor.
+ */
+static void iio_remove_dsp(struct iio_desc *desc)
+{
+	uint32_t i;
+
+	if (!desc->devs)
+		return;
+
+	for (i = 0; i < desc->nb_devs; i++) {
+		iio_dsp_remove(desc->devs[i].dsp);
+		desc->devs[i].dsp = NULL;
+	}
+}
+
 static int32_t iio_init_devs(struct iio_desc *desc,
 			     struct iio_device_init *devs, uint32_t n)
 {
 	uint32_t i;
+	int ret;
 	struct iio_dev_priv *ldev;
 	struct iio_device_init *ndev;
 
@@ -1959,6 +2126,17 @@ static int32_t iio_init_devs(struct iio_desc *desc,
 		} else {
 			ldev->buffer.initalized = 0;
 		}
+
+		if (ndev->dsp && ldev->buffer.initalized) {
+			ret = iio_dsp_init(&ldev->dsp, ndev->dsp,
+					   ndev->dev_descriptor);
+			if (NO_OS_IS_ERR_VALUE(ret)) {
+				iio_remove_dsp(desc);
+				no_os_free(desc->devs);
+				desc->devs = NULL;
+				return ret;
+			}
+		}
 	}
 
 	return 0;
@@ -2155,6 +2333,7 @@ free_xml:
 free_trigs:
 	no_os_free(ldesc->trigs);
 free_devs:
+	iio_remove_dsp(ldesc);
 	no_os_free(ldesc->devs);
 free_desc:
 	no_os_free(ldesc);
@@ -2186,6 +2365,7 @@ int iio_remove(struct iio_desc *desc)
 #endif
 	no_os_cb_remove(desc->conns);
 	iiod_remove(desc->iiod);
+	iio_remove_dsp(desc);
 	no_os_free(desc->devs);
 	no_os_free(desc->trigs);
 	no_os_free(desc->xml_desc);
@@ -48,6 +48,7 @@ enum physical_link_type {
 };
 
 struct iio_desc;
+struct iio_dsp_init_param;
 
 struct iio_device_init {
 	char *name;
@@ -63,6 +64,11 @@ struct iio_device_init {
 	uint32_t raw_buf_len;
 	/* If set, trigger will be linked to this device */
 	char *trigger_id;
+	/*
+	 * If set, the input scans are decimated, filtered and converted
+	 * before being sent to the client. Requires CONFIG_IIO_DSP.
+	 */
+	struct iio_dsp_init_param *dsp;
 };
 
 struct iio_trigger_init {
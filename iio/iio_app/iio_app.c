@@ -339,6 +339,8 @@ int iio_app_init(struct iio_app_desc **app,
 	}
 
 	application->irq_desc = irq_desc;
+#elif defined(LINUX_PLATFORM)
+	application->irq_desc = app_init_param.irq_desc;
 #endif
 
 	status = uart_setup(&uart_desc, &app_init_param.uart_init_params);
@@ -394,6 +396,7 @@ int iio_app_init(struct iio_app_desc **app,
 		iio_init_devs[i].dev = app_init_param.devices[i].dev;
 		iio_init_devs[i].dev_descriptor = app_init_param.devices[i].dev_descriptor;
 		iio_init_devs[i].trigger_id = app_init_param.devices[i].default_trigger_id;
+		iio_init_devs[i].dsp = app_init_param.devices[i].dsp;
 		buff = app_init_param.devices[i].read_buff ?
 		       app_init_param.devices[i].read_buff :
 		       app_init_param.devices[i].write_buff;
@@ -448,7 +451,16 @@ int iio_app_run(struct iio_app_desc *app)
 	int status;
 
 	do {
+#ifdef LINUX_PLATFORM
+		/* Keep the callbacks, run by other threads, out of the step */
+		if (app->irq_desc)
+			no_os_irq_global_disable(app->irq_desc);
+#endif
 		status = iio_step(app->iio_desc);
+#ifdef LINUX_PLATFORM
+		if (app->irq_desc)
+			no_os_irq_global_enable(app->irq_desc);
+#endif
 		if (status && status != -EAGAIN && status != -ENOTCONN
 		    && status != -NO_OS_EOVERRUN)
 			return status;
@@ -76,6 +76,8 @@ struct iio_app_device {
 	struct iio_data_buffer *read_buff;
 	struct iio_data_buffer *write_buff;
 	char *default_trigger_id;
+	/** Optional in-stream processing of the input buffer */
+	struct iio_dsp_init_param *dsp;
 };
 
 /**
@@ -118,7 +120,11 @@ struct iio_app_init_param {
 	int32_t nb_trigs;
 	/** UART init params */
 	struct no_os_uart_init_param uart_init_params;
-	/** IRQ descriptor to be used */
+	/**
+	 * IRQ descriptor to be used. On Linux, where interrupt callbacks run on
+	 * their own threads, its interrupts are globally disabled during each
+	 * iio_step().
+	 */
 	void *irq_desc;
 	/** Function to be called each step */
 	int (*post_step_callback)(void *arg);
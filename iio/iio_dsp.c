@@ -0,0 +1,935 @@
+/***************************************************************************//**
+ *   @file   iio_dsp.c
+ *   @brief  In-stream processing stage of the IIO buffers
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include "no_os_alloc.h"
+#include "no_os_error.h"
+#include "no_os_util.h"
+
+#include "iio_dsp.h"
+
+/* Processing stage buffer attributes */
+enum iio_dsp_attr_id {
+	IIO_DSP_DECIMATION,
+	IIO_DSP_FILTER,
+	IIO_DSP_FILTER_AVAILABLE,
+	IIO_DSP_CIC_ORDER,
+	IIO_DSP_FORMAT,
+};
+
+static const char * const iio_dsp_filter_names[] = {
+	[IIO_DSP_FILTER_NONE] = "none",
+	[IIO_DSP_FILTER_AVERAGE] = "average",
+	[IIO_DSP_FILTER_CIC] = "cic",
+	[IIO_DSP_FILTER_FIR] = "fir",
+};
+
+static const char * const iio_dsp_format_names[] = {
+	[IIO_DSP_FORMAT_NATIVE] = "native",
+	[IIO_DSP_FORMAT_16BIT] = "16bit",
+	[IIO_DSP_FORMAT_32BIT] = "32bit",
+};
+
+/**
+ * @brief Number of bits needed to represent values up to x - 1.
+ * @param x - Value.
+ * @return ceil(log2(x)).
+ */
+static uint32_t iio_dsp_clog2(uint32_t x)
+{
+	uint32_t bits = 0;
+
+	while (bits < 32 && (1ULL << bits) < x)
+		bits++;
+
+	return bits;
+}
+
+/**
+ * @brief Compute the channel offsets of a scan, with the alignment rules of
+ * the IIO buffers.
+ * @param dsp - Processing stage descriptor.
+ * @param mask - Active channels.
+ * @param out - true for the output scans, false for the device scans.
+ * @return Scan size in bytes.
+ */
+static uint32_t iio_dsp_layout(struct iio_dsp *dsp, uint32_t mask, bool out)
+{
+	uint32_t cnt = 0, largest = 1;
+	uint32_t i, length;
+
+	for (i = 0; mask; i++, mask >>= 1) {
+		if (!(mask & 1))
+			continue;
+
+		if (out)
+			length = dsp->ch[i].out_type.storagebits / 8;
+		else
+			length = dsp->dev->channels[i].scan_type->storagebits / 8;
+
+		if (length > largest)
+			largest = length;
+		if (cnt % length)
+			cnt += length - (cnt % length);
+
+		if (out)
+			dsp->ch[i].out_offset = cnt;
+		else
+			dsp->ch[i].in_offset = cnt;
+		cnt += length;
+	}
+
+	if (cnt % largest)
+		cnt += largest - (cnt % largest);
+
+	return cnt;
+}
+
+/**
+ * @brief Extract the samples of one channel from a block of device scans.
+ * @param scans - Address of the channel in the first scan.
+ * @param bps - Scan size in bytes.
+ * @param n - Number of scans.
+ * @param type - Scan type of the channel.
+ * @param out - Sign extended samples.
+ */
+static void iio_dsp_decode(const uint8_t *scans, uint32_t bps, uint32_t n,
+			   const struct scan_type *type, int32_t *restrict out)
+{
+	uint32_t *raw = (uint32_t *)out;
+	uint32_t sign, mask;
+	uint16_t v16;
+	uint32_t i;
+
+	/* The native loads assume a little endian target, like the rest of
+	 * the IIO buffer code. */
+	switch (type->storagebits) {
+	case 8:
+		for (i = 0; i < n; i++)
+			raw[i] = scans[i * bps];
+		break;
+	case 16:
+		if (type->is_big_endian) {
+			for (i = 0; i < n; i++)
+				raw[i] = no_os_get_unaligned_be16((uint8_t *)scans +
+								  i * bps);
+			break;
+		}
+		for (i = 0; i < n; i++) {
+			memcpy(&v16, scans + i * bps, sizeof(v16));
+			raw[i] = v16;
+		}
+		break;
+	case 24:
+		for (i = 0; i < n; i++)
+			raw[i] = type->is_big_endian ?
+				 no_os_get_unaligned_be24((uint8_t *)scans + i * bps) :
+				 no_os_get_unaligned_le24((uint8_t *)scans + i * bps);
+		break;
+	default:
+		if (type->is_big_endian) {
+			for (i = 0; i < n; i++)
+				raw[i] = no_os_get_unaligned_be32((uint8_t *)scans +
+								  i * bps);
+			break;
+		}
+		for (i = 0; i < n; i++)
+			memcpy(&raw[i], scans + i * bps, sizeof(raw[i]));
+		break;
+	}
+
+	mask = type->realbits < 32 ? (1U << type->realbits) - 1 : UINT32_MAX;
+	sign = type->sign == 's' ? 1U << (type->realbits - 1) : 0;
+	for (i = 0; i < n; i++)
+		out[i] = (int32_t)((((raw[i] >> type->shift) & mask) ^ sign) - sign);
+}
+
+/**
+ * @brief Store the samples of one channel into a block of output scans.
+ * @param in - Samples.
+ * @param n - Number of samples.
+ * @param ch - Channel state.
+ * @param scans - Address of the channel in the first output scan.
+ * @param bps - Output scan size in bytes.
+ */
+static void iio_dsp_encode(int32_t *restrict in, uint32_t n,
+			   const struct iio_dsp_ch *ch, uint8_t *scans,
+			   uint32_t bps)
+{
+	const struct scan_type *type = &ch->out_type;
+	int32_t min, max;
+	int16_t v16;
+	uint32_t i;
+
+	if (type->sign == 's') {
+		max = (int32_t)((1ULL << (type->realbits - 1)) - 1);
+		min = -max - 1;
+	} else {
+		max = (int32_t)((1ULL << type->realbits) - 1);
+		min = 0;
+	}
+
+	if (ch->drop_bits)
+		for (i = 0; i < n; i++)
+			in[i] = (int32_t)(((int64_t)in[i] +
+					   (1 << (ch->drop_bits - 1))) >> ch->drop_bits);
+	for (i = 0; i < n; i++)
+		in[i] = no_os_clamp(in[i], min, max);
+
+	switch (type->storagebits) {
+	case 8:
+		for (i = 0; i < n; i++)
+			scans[i * bps] = (uint8_t)in[i];
+		break;
+	case 16:
+		for (i = 0; i < n; i++) {
+			v16 = (int16_t)in[i];
+			memcpy(scans + i * bps, &v16, sizeof(v16));
+		}
+		break;
+	case 24:
+		for (i = 0; i < n; i++)
+			no_os_put_unaligned_le24((uint32_t)in[i], scans + i * bps);
+		break;
+	default:
+		for (i = 0; i < n; i++)
+			memcpy(scans + i * bps, &in[i], sizeof(in[i]));
+		break;
+	}
+}
+
+/**
+ * @brief Divide by the gain of the filter.
+ * @param dsp - Processing stage descriptor.
+ * @param val - Filter output.
+ * @return Normalized value.
+ */
+static inline int32_t iio_dsp_norm(struct iio_dsp *dsp, int64_t val)
+{
+	if (dsp->norm_div)
+		return (int32_t)(val / (int64_t)dsp->norm_div);
+
+	return (int32_t)(val >> dsp->norm_shift);
+}
+
+/**
+ * @brief Dot product of the FIR window and taps.
+ * @param x - Samples, newest first.
+ * @param h - Q15 taps.
+ * @param len - Number of taps.
+ * @return Q15 result.
+ */
+static int64_t iio_dsp_dot(const int32_t *restrict x,
+			   const int16_t *restrict h, uint32_t len)
+{
+	int64_t acc = 0;
+	uint32_t i;
+
+	for (i = 0; i < len; i++)
+		acc += (int64_t)x[i] * h[i];
+
+	return acc;
+}
+
+/**
+ * @brief Filter and decimate the samples of one channel.
+ * @param dsp - Processing stage descriptor.
+ * @param ch - Channel state.
+ * @param in - Input samples.
+ * @param out - Output samples.
+ * @param n - Number of input samples.
+ * @return Number of output samples.
+ */
+static uint32_t iio_dsp_filter(struct iio_dsp *dsp, struct iio_dsp_ch *ch,
+			       const int32_t *restrict in,
+			       int32_t *restrict out, uint32_t n)
+{
+	uint32_t d = dsp->decimation;
+	uint32_t m = 0;
+	uint32_t i, k;
+	uint64_t v, t;
+	int64_t acc;
+
+	switch (dsp->filter) {
+	case IIO_DSP_FILTER_AVERAGE:
+		for (i = 0; i < n; i++) {
+			ch->acc += in[i];
+			if (++ch->phase < d)
+				continue;
+			out[m++] = iio_dsp_norm(dsp, ch->acc);
+			ch->acc = 0;
+			ch->phase = 0;
+		}
+		break;
+	case IIO_DSP_FILTER_CIC:
+		/* Wrapping arithmetic, the output is exact as long as the
+		 * registers can hold the bit growth (checked on enable). */
+		for (i = 0; i < n; i++) {
+			v = (uint64_t)(int64_t)in[i];
+			for (k = 0; k < dsp->cic_order; k++) {
+				ch->integ[k] += v;
+				v = ch->integ[k];
+			}
+			if (++ch->phase < d)
+				continue;
+			ch->phase = 0;
+			for (k = 0; k < dsp->cic_order; k++) {
+				t = v;
+				v -= ch->comb[k];
+				ch->comb[k] = t;
+			}
+			out[m++] = iio_dsp_norm(dsp, (int64_t)v);
+		}
+		break;
+	case IIO_DSP_FILTER_FIR:
+		for (i = 0; i < n; i++) {
+			ch->fir_pos = ch->fir_pos ? ch->fir_pos - 1 :
+				      dsp->fir_len - 1;
+			ch->fir_hist[ch->fir_pos] = in[i];
+			ch->fir_hist[ch->fir_pos + dsp->fir_len] = in[i];
+			if (++ch->phase < d)
+				continue;
+			ch->phase = 0;
+			acc = iio_dsp_dot(&ch->fir_hist[ch->fir_pos],
+					  dsp->fir_taps, dsp->fir_len);
+			acc = (acc + (1 << 14)) >> 15;
+			out[m++] = no_os_clamp(acc, INT32_MIN, INT32_MAX);
+		}
+		break;
+	default:
+		if (d == 1) {
+			memcpy(out, in, n * sizeof(*in));
+			return n;
+		}
+		for (i = d - 1 - ch->phase; i < n; i += d)
+			out[m++] = in[i];
+		ch->phase = (ch->phase + n) % d;
+		break;
+	}
+
+	return m;
+}
+
+/**
+ * @brief Process the device scans available so far into the client buffer.
+ * Runs the kernels on up to dsp->chunk scans at a time, directly on the
+ * storage of the device scans.
+ * @param dsp - Processing stage descriptor.
+ * @param out - Client buffer.
+ * @return 0 in case of success, -NO_OS_EOVERRUN if scans were lost, negative
+ * error code otherwise.
+ */
+int iio_dsp_process(struct iio_dsp *dsp, struct no_os_circular_buffer *out)
+{
+	uint32_t size, avail, mask, n, m = 0;
+	struct iio_dsp_ch *ch;
+	bool overrun = false;
+	uint8_t *scans;
+	uint32_t i;
+	int ret;
+
+	if (!dsp || !out)
+		return -EINVAL;
+
+	if (!dsp->active)
+		return 0;
+
+	while (true) {
+		ret = no_os_cb_size(&dsp->raw_cb, &size);
+		if (ret == -NO_OS_EOVERRUN)
+			overrun = true;
+		else if (ret)
+			return ret;
+
+		n = no_os_min(size / dsp->in_bytes_per_scan, dsp->chunk);
+		if (!n)
+			break;
+
+		avail = 0;
+		ret = no_os_cb_prepare_async_read(&dsp->raw_cb,
+						  n * dsp->in_bytes_per_scan,
+						  (void **)&scans, &avail);
+		if (ret == -NO_OS_EOVERRUN)
+			overrun = true;
+		else if (ret)
+			return ret;
+		if (!avail)
+			break;
+
+		n = avail / dsp->in_bytes_per_scan;
+		for (i = 0, mask = dsp->mask; mask; i++, mask >>= 1) {
+			if (!(mask & 1))
+				continue;
+
+			ch = &dsp->ch[i];
+			iio_dsp_decode(scans + ch->in_offset,
+				       dsp->in_bytes_per_scan, n,
+				       dsp->dev->channels[i].scan_type,
+				       dsp->work_in);
+			/* Channels are decimated in lockstep */
+			m = iio_dsp_filter(dsp, ch, dsp->work_in,
+					   dsp->work_out, n);
+			iio_dsp_encode(dsp->work_out, m, ch,
+				       dsp->out_scans + ch->out_offset,
+				       dsp->out_bytes_per_scan);
+		}
+
+		ret = no_os_cb_end_async_read(&dsp->raw_cb);
+		if (ret)
+			return ret;
+
+		if (!m)
+			continue;
+
+		ret = no_os_cb_write(out, dsp->out_scans,
+				     m * dsp->out_bytes_per_scan);
+		if (ret == -NO_OS_EOVERRUN)
+			overrun = true;
+		else if (ret)
+			return ret;
+	}
+
+	return overrun ? -NO_OS_EOVERRUN : 0;
+}
+
+/**
+ * @brief Check if two scan types describe the same encoding.
+ * @param a - First scan type.
+ * @param b - Second scan type.
+ * @return true if they are equal.
+ */
+static bool iio_dsp_same_type(const struct scan_type *a,
+			      const struct scan_type *b)
+{
+	return a->sign == b->sign && a->realbits == b->realbits &&
+	       a->storagebits == b->storagebits && a->shift == b->shift &&
+	       a->is_big_endian == b->is_big_endian;
+}
+
+/**
+ * @brief Allocate the processing stage of a device.
+ * @param dsp - Processing stage descriptor.
+ * @param param - Initial configuration.
+ * @param dev - IIO device whose input buffer is processed.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int iio_dsp_init(struct iio_dsp **dsp, struct iio_dsp_init_param *param,
+		 struct iio_device *dev)
+{
+	const struct scan_type *type;
+	struct iio_dsp_ch *ch;
+	struct iio_dsp *d;
+	uint32_t i;
+	int ret;
+
+	if (!dsp || !param || !dev || !dev->channels || !dev->num_ch ||
+	    dev->num_ch > 32)
+		return -EINVAL;
+
+	if (param->format > IIO_DSP_FORMAT_32BIT ||
+	    param->filter > IIO_DSP_FILTER_FIR ||
+	    param->decimation > IIO_DSP_MAX_DECIMATION ||
+	    param->cic_order > IIO_DSP_CIC_MAX_ORDER ||
+	    param->fir_len > IIO_DSP_FIR_MAX_TAPS ||
+	    (param->fir_taps && !param->fir_len) ||
+	    (param->filter == IIO_DSP_FILTER_FIR && !param->fir_taps))
+		return -EINVAL;
+
+	for (i = 0; i < dev->num_ch; i++) {
+		type = dev->channels[i].scan_type;
+		if (dev->channels[i].ch_out || !type)
+			continue;
+
+		if (type->storagebits % 8 || !type->storagebits ||
+		    type->storagebits > 32 || !type->realbits ||
+		    type->realbits + type->shift > type->storagebits ||
+		    (type->sign != 's' && type->realbits == 32))
+			return -EINVAL;
+	}
+
+	d = no_os_calloc(1, sizeof(*d));
+	if (!d)
+		return -ENOMEM;
+
+	d->dev = dev;
+	d->format = param->format;
+	d->filter = param->filter;
+	d->decimation = param->decimation ? param->decimation : 1;
+	d->cic_order = param->cic_order ? param->cic_order : 1;
+	d->fir_taps = param->fir_taps;
+	d->fir_len = param->fir_taps ? param->fir_len : 0;
+	d->chunk = param->chunk ? param->chunk : IIO_DSP_DEFAULT_CHUNK;
+
+	d->ch = no_os_calloc(dev->num_ch, sizeof(*d->ch));
+	d->work_in = no_os_calloc(d->chunk, sizeof(*d->work_in));
+	d->work_out = no_os_calloc(d->chunk, sizeof(*d->work_out));
+	d->out_scans = no_os_calloc(d->chunk, dev->num_ch * sizeof(int32_t));
+	if (!d->ch || !d->work_in || !d->work_out || !d->out_scans) {
+		ret = -ENOMEM;
+		goto error;
+	}
+
+	for (i = 0; i < dev->num_ch; i++) {
+		ch = &d->ch[i];
+		type = dev->channels[i].scan_type;
+		if (dev->channels[i].ch_out || !type)
+			continue;
+
+		if (d->fir_len) {
+			ch->fir_hist = no_os_calloc(2 * d->fir_len,
+						    sizeof(*ch->fir_hist));
+			if (!ch->fir_hist) {
+				ret = -ENOMEM;
+				goto error;
+			}
+		}
+
+		ch->out_type.sign = type->sign;
+		ch->out_type.realbits = type->realbits;
+		ch->out_type.storagebits = type->storagebits;
+		if (d->format == IIO_DSP_FORMAT_16BIT) {
+			ch->out_type.storagebits = 16;
+			if (type->realbits > 16) {
+				ch->out_type.realbits = 16;
+				ch->drop_bits = type->realbits - 16;
+			}
+		} else if (d->format == IIO_DSP_FORMAT_32BIT) {
+			ch->out_type.storagebits = 32;
+		}
+	}
+
+	*dsp = d;
+
+	return 0;
+
+error:
+	iio_dsp_remove(d);
+
+	return ret;
+}
+
+/**
+ * @brief Free the processing stage.
+ * @param dsp - Processing stage descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int iio_dsp_remove(struct iio_dsp *dsp)
+{
+	uint32_t i;
+
+	if (!dsp)
+		return -EINVAL;
+
+	iio_dsp_close(dsp);
+	if (dsp->ch)
+		for (i = 0; i < dsp->dev->num_ch; i++)
+			no_os_free(dsp->ch[i].fir_hist);
+	no_os_free(dsp->ch);
+	no_os_free(dsp->work_in);
+	no_os_free(dsp->work_out);
+	no_os_free(dsp->out_scans);
+	no_os_free(dsp);
+
+	return 0;
+}
+
+/**
+ * @brief Insert the stage between the device and the client buffer.
+ * If processing is needed, the device scans are redirected to a buffer of
+ * the stage holding one device block, of as many scans as a client block.
+ * A client block is then made of iio_dsp_blocks() device blocks, each one
+ * processed before the next is requested.
+ * @param dsp - Processing stage descriptor.
+ * @param buffer - IIO buffer being enabled, describing the client scans.
+ * @param out_size - Size of the client buffer, updated if processing is
+ * needed.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int iio_dsp_open(struct iio_dsp *dsp, struct iio_buffer *buffer,
+		 uint32_t *out_size)
+{
+	struct iio_channel *channels;
+	uint32_t i, mask, growth;
+	bool needed = false;
+	struct iio_dsp_ch *ch;
+	int8_t *buf;
+	int ret;
+
+	if (!dsp || !buffer || !out_size)
+		return -EINVAL;
+
+	iio_dsp_close(dsp);
+	dsp->mask = buffer->active_mask;
+	channels = dsp->dev->channels;
+
+	for (i = 0, mask = dsp->mask; mask; i++, mask >>= 1) {
+		if (!(mask & 1))
+			continue;
+		/* Output buffers are not processed */
+		if (channels[i].ch_out)
+			return 0;
+		if (!channels[i].scan_type)
+			return -EINVAL;
+		if (!iio_dsp_same_type(&dsp->ch[i].out_type,
+				       channels[i].scan_type))
+			needed = true;
+	}
+	if (dsp->decimation > 1 || dsp->filter == IIO_DSP_FILTER_FIR)
+		needed = true;
+	if (!needed || buffer->cyclic_info.is_cyclic)
+		return 0;
+
+	dsp->norm_div = 0;
+	dsp->norm_shift = 0;
+	growth = iio_dsp_clog2(dsp->decimation);
+	if (dsp->filter == IIO_DSP_FILTER_AVERAGE) {
+		if (dsp->decimation & (dsp->decimation - 1))
+			dsp->norm_div = dsp->decimation;
+		else
+			dsp->norm_shift = growth;
+	} else if (dsp->filter == IIO_DSP_FILTER_CIC) {
+		for (i = 0, mask = dsp->mask; mask; i++, mask >>= 1)
+			if ((mask & 1) && channels[i].scan_type->realbits +
+			    dsp->cic_order * growth > 64)
+				return -EINVAL;
+
+		if (dsp->decimation & (dsp->decimation - 1)) {
+			dsp->norm_div = 1;
+			for (i = 0; i < dsp->cic_order; i++)
+				dsp->norm_div *= dsp->decimation;
+		} else {
+			dsp->norm_shift = dsp->cic_order * growth;
+		}
+	}
+
+	dsp->in_bytes_per_scan = iio_dsp_layout(dsp, dsp->mask, false);
+	dsp->out_bytes_per_scan = iio_dsp_layout(dsp, dsp->mask, true);
+
+	buf = no_os_calloc(buffer->size, sizeof(*buf));
+	if (!buf)
+		return -ENOMEM;
+
+	ret = no_os_cb_cfg(&dsp->raw_cb, buf, buffer->size);
+	if (ret) {
+		no_os_free(buf);
+		return ret;
+	}
+
+	for (i = 0; i < dsp->dev->num_ch; i++) {
+		ch = &dsp->ch[i];
+		ch->phase = 0;
+		ch->acc = 0;
+		memset(ch->integ, 0, sizeof(ch->integ));
+		memset(ch->comb, 0, sizeof(ch->comb));
+		ch->fir_pos = 0;
+		if (ch->fir_hist)
+			memset(ch->fir_hist, 0,
+			       2 * dsp->fir_len * sizeof(*ch->fir_hist));
+	}
+
+	*out_size = dsp->out_bytes_per_scan * buffer->samples;
+	buffer->buf = &dsp->raw_cb;
+	dsp->active = true;
+
+	return 0;
+}
+
+/**
+ * @brief Free the resources of the enabled buffer.
+ * @param dsp - Processing stage descriptor.
+ */
+void iio_dsp_close(struct iio_dsp *dsp)
+{
+	if (!dsp)
+		return;
+
+	if (dsp->active)
+		no_os_free(dsp->raw_cb.buff);
+	dsp->raw_cb.buff = NULL;
+	dsp->active = false;
+	dsp->mask = 0;
+}
+
+/**
+ * @brief Scan type of a channel, as seen by the client.
+ * @param dsp - Processing stage descriptor.
+ * @param ch - Channel index.
+ * @return Scan type.
+ */
+struct scan_type *iio_dsp_scan_type(struct iio_dsp *dsp, uint32_t ch)
+{
+	if (!dsp || ch >= dsp->dev->num_ch)
+		return NULL;
+
+	if (dsp->dev->channels[ch].ch_out || !dsp->dev->channels[ch].scan_type)
+		return dsp->dev->channels[ch].scan_type;
+
+	return &dsp->ch[ch].out_type;
+}
+
+/**
+ * @brief Number of device blocks making up one client block.
+ * @param dsp - Processing stage descriptor.
+ * @return Decimation ratio while the stage is active, 1 otherwise.
+ */
+uint32_t iio_dsp_blocks(struct iio_dsp *dsp)
+{
+	if (!dsp || !dsp->active)
+		return 1;
+
+	return dsp->decimation;
+}
+
+/**
+ * @brief Parse a sampling frequency, with up to 6 decimals.
+ * @param buf - Value, as a string.
+ * @param urate - Rate in micro Hz.
+ * @param frac - Set if the value has a fractional part.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int iio_dsp_parse_rate(const char *buf, uint64_t *urate, bool *frac)
+{
+	uint64_t scale = 1000000;
+	uint64_t val = 0;
+	uint32_t i = 0;
+
+	while (buf[i] == ' ')
+		i++;
+	if (buf[i] < '0' || buf[i] > '9')
+		return -EINVAL;
+
+	for (; buf[i] >= '0' && buf[i] <= '9'; i++) {
+		if (val > (UINT64_MAX / 1000000 - 9) / 10)
+			return -EINVAL;
+		val = val * 10 + buf[i] - '0';
+	}
+	val *= scale;
+
+	*frac = buf[i] == '.';
+	if (*frac)
+		for (i++; buf[i] >= '0' && buf[i] <= '9' && scale > 1; i++) {
+			scale /= 10;
+			val += (buf[i] - '0') * scale;
+		}
+
+	*urate = val;
+
+	return 0;
+}
+
+/**
+ * @brief Print a sampling frequency.
+ * @param buf - Buffer to store the value.
+ * @param len - Buffer length.
+ * @param urate - Rate in micro Hz.
+ * @param frac - Print the fractional part even if it is 0.
+ * @return Length of the value.
+ */
+static int iio_dsp_print_rate(char *buf, uint32_t len, uint64_t urate,
+			      bool frac)
+{
+	if (!frac && !(urate % 1000000))
+		return snprintf(buf, len, "%" PRIu64, urate / 1000000);
+
+	return snprintf(buf, len, "%" PRIu64 ".%06" PRIu64, urate / 1000000,
+			urate % 1000000);
+}
+
+/**
+ * @brief Convert a sampling frequency read from the device to the rate of
+ * the processed stream, by dividing it by the decimation ratio.
+ * @param dsp - Processing stage descriptor.
+ * @param buf - Value read from the device, replaced by the output rate.
+ * @param len - Buffer length.
+ * @param ret - Length of the value read from the device.
+ * @return Length of the output rate, or ret if it is left unchanged.
+ */
+int iio_dsp_rate_read(struct iio_dsp *dsp, char *buf, uint32_t len, int ret)
+{
+	uint64_t urate;
+	bool frac;
+
+	if (!dsp || dsp->decimation <= 1 || ret <= 0 || (uint32_t)ret >= len)
+		return ret;
+
+	buf[ret] = '\0';
+	if (iio_dsp_parse_rate(buf, &urate, &frac))
+		return ret;
+
+	urate = (urate + dsp->decimation / 2) / dsp->decimation;
+
+	return iio_dsp_print_rate(buf, len, urate, frac);
+}
+
+/**
+ * @brief Convert a sampling frequency requested by the client to the rate
+ * of the device, by multiplying it by the decimation ratio.
+ * @param dsp - Processing stage descriptor.
+ * @param buf - Output rate requested by the client.
+ * @param dev_buf - Buffer to store the device rate.
+ * @param len - Length of dev_buf.
+ * @return Length of the device rate, 0 if the value is to be written
+ * unchanged.
+ */
+int iio_dsp_rate_write(struct iio_dsp *dsp, const char *buf, char *dev_buf,
+		       uint32_t len)
+{
+	uint64_t urate;
+	bool frac;
+
+	if (!dsp || dsp->decimation <= 1)
+		return 0;
+
+	if (iio_dsp_parse_rate(buf, &urate, &frac))
+		return 0;
+
+	if (urate > UINT64_MAX / dsp->decimation)
+		return -EINVAL;
+
+	return iio_dsp_print_rate(dev_buf, len, urate * dsp->decimation, frac);
+}
+
+/**
+ * @brief Read a processing stage attribute.
+ * @param device - Processing stage descriptor.
+ * @param buf - Buffer to store the read data.
+ * @param len - Buffer length.
+ * @param channel - IIO channel.
+ * @param priv - Attribute id.
+ * @return Length of the value, negative error code otherwise.
+ */
+static int iio_dsp_read_attr(void *device, char *buf, uint32_t len,
+			     const struct iio_ch_info *channel, intptr_t priv)
+{
+	struct iio_dsp *dsp = device;
+
+	switch (priv) {
+	case IIO_DSP_DECIMATION:
+		return snprintf(buf, len, "%" PRIu32, dsp->decimation);
+	case IIO_DSP_FILTER:
+		return snprintf(buf, len, "%s",
+				iio_dsp_filter_names[dsp->filter]);
+	case IIO_DSP_FILTER_AVAILABLE:
+		return snprintf(buf, len, "none average cic%s",
+				dsp->fir_len ? " fir" : "");
+	case IIO_DSP_CIC_ORDER:
+		return snprintf(buf, len, "%u", dsp->cic_order);
+	case IIO_DSP_FORMAT:
+		return snprintf(buf, len, "%s",
+				iio_dsp_format_names[dsp->format]);
+	default:
+		return -EINVAL;
+	}
+}
+
+/**
+ * @brief Write a processing stage attribute. The settings can only be
+ * changed while the buffer is disabled.
+ * @param device - Processing stage descriptor.
+ * @param buf - Value to be written.
+ * @param len - Value length.
+ * @param channel - IIO channel.
+ * @param priv - Attribute id.
+ * @return Length of the value, negative error code otherwise.
+ */
+static int iio_dsp_write_attr(void *device, char *buf, uint32_t len,
+			      const struct iio_ch_info *channel,
+			      intptr_t priv)
+{
+	struct iio_dsp *dsp = device;
+	uint32_t val, i;
+
+	if (dsp->mask)
+		return -EBUSY;
+
+	switch (priv) {
+	case IIO_DSP_DECIMATION:
+		val = no_os_str_to_uint32(buf);
+		if (!val || val > IIO_DSP_MAX_DECIMATION)
+			return -EINVAL;
+		dsp->decimation = val;
+		break;
+	case IIO_DSP_FILTER:
+		for (i = 0; i < NO_OS_ARRAY_SIZE(iio_dsp_filter_names); i++)
+			if (!strncmp(buf, iio_dsp_filter_names[i],
+				     strlen(iio_dsp_filter_names[i])))
+				break;
+		if (i == NO_OS_ARRAY_SIZE(iio_dsp_filter_names) ||
+		    (i == IIO_DSP_FILTER_FIR && !dsp->fir_len))
+			return -EINVAL;
+		dsp->filter = i;
+		break;
+	case IIO_DSP_CIC_ORDER:
+		val = no_os_str_to_uint32(buf);
+		if (!val || val > IIO_DSP_CIC_MAX_ORDER)
+			return -EINVAL;
+		dsp->cic_order = val;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	return len;
+}
+
+struct iio_attribute iio_dsp_buffer_attributes[] = {
+	{
+		.name = "dsp_decimation",
+		.priv = IIO_DSP_DECIMATION,
+		.show = iio_dsp_read_attr,
+		.store = iio_dsp_write_attr,
+	},
+	{
+		.name = "dsp_filter",
+		.priv = IIO_DSP_FILTER,
+		.show = iio_dsp_read_attr,
+		.store = iio_dsp_write_attr,
+	},
+	{
+		.name = "dsp_filter_available",
+		.priv = IIO_DSP_FILTER_AVAILABLE,
+		.show = iio_dsp_read_attr,
+	},
+	{
+		.name = "dsp_cic_order",
+		.priv = IIO_DSP_CIC_ORDER,
+		.show = iio_dsp_read_attr,
+		.store = iio_dsp_write_attr,
+	},
+	{
+		.name = "dsp_format",
+		.priv = IIO_DSP_FORMAT,
+		.show = iio_dsp_read_attr,
+	},
+	END_ATTRIBUTES_ARRAY
+};
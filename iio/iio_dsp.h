@@ -0,0 +1,246 @@
+/***************************************************************************//**
+ *   @file   iio_dsp.h
+ *   @brief  In-stream processing stage of the IIO buffers
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef __IIO_DSP_H__
+#define __IIO_DSP_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "iio_types.h"
+#include "no_os_circular_buffer.h"
+#include "no_os_error.h"
+
+/** Maximum decimation ratio of the processing stage */
+#define IIO_DSP_MAX_DECIMATION	4096
+/** Maximum order of the CIC filter */
+#define IIO_DSP_CIC_MAX_ORDER	5
+/** Maximum number of FIR filter taps */
+#define IIO_DSP_FIR_MAX_TAPS	128
+/** Number of scans processed by each kernel call, if not specified */
+#define IIO_DSP_DEFAULT_CHUNK	64
+
+/**
+ * @enum iio_dsp_filter
+ * @brief Filter applied before dropping the samples of a decimated stream.
+ */
+enum iio_dsp_filter {
+	/** Keep every N-th sample */
+	IIO_DSP_FILTER_NONE,
+	/** Average of N samples (boxcar) */
+	IIO_DSP_FILTER_AVERAGE,
+	/** Cascaded integrator-comb filter, normalized to unity gain */
+	IIO_DSP_FILTER_CIC,
+	/** FIR filter with user provided Q15 taps, computed at the output rate */
+	IIO_DSP_FILTER_FIR,
+};
+
+/**
+ * @enum iio_dsp_format
+ * @brief Sample format sent to the client.
+ */
+enum iio_dsp_format {
+	/** Storage size of the device, unshifted little endian values */
+	IIO_DSP_FORMAT_NATIVE,
+	/** 16-bit storage, the extra bits are rounded off */
+	IIO_DSP_FORMAT_16BIT,
+	/** 32-bit storage, sign extended */
+	IIO_DSP_FORMAT_32BIT,
+};
+
+/**
+ * @struct iio_dsp_init_param
+ * @brief Processing stage configuration, set in iio_device_init.dsp.
+ * The filter, decimation and CIC order may be changed at runtime through the
+ * buffer attributes. The format describes the scan elements of the IIO
+ * context and is fixed.
+ */
+struct iio_dsp_init_param {
+	/** Sample format sent to the client */
+	enum iio_dsp_format format;
+	/** Initial filter */
+	enum iio_dsp_filter filter;
+	/** Initial decimation ratio, 0 or 1 when not decimating */
+	uint32_t decimation;
+	/** Initial CIC filter order, 1 if not set */
+	uint8_t cic_order;
+	/** FIR taps in Q15 format, newest sample first. Optional. */
+	const int16_t *fir_taps;
+	/** Number of FIR taps */
+	uint32_t fir_len;
+	/** Scans processed by each kernel call, IIO_DSP_DEFAULT_CHUNK if 0 */
+	uint32_t chunk;
+};
+
+/**
+ * @struct iio_dsp_ch
+ * @brief Per channel layout and filter state.
+ */
+struct iio_dsp_ch {
+	/** Scan type reported to the client */
+	struct scan_type out_type;
+	/** Byte offset of the channel in a device scan */
+	uint32_t in_offset;
+	/** Byte offset of the channel in an output scan */
+	uint32_t out_offset;
+	/** Bits rounded off by the format conversion */
+	uint8_t drop_bits;
+	/** Position in the decimation period */
+	uint32_t phase;
+	/** Averaging accumulator */
+	int64_t acc;
+	/** CIC integrator and comb stages */
+	uint64_t integ[IIO_DSP_CIC_MAX_ORDER];
+	uint64_t comb[IIO_DSP_CIC_MAX_ORDER];
+	/** FIR history, stored twice so that the window is contiguous */
+	int32_t *fir_hist;
+	/** Index of the newest sample in fir_hist */
+	uint32_t fir_pos;
+};
+
+/**
+ * @struct iio_dsp
+ * @brief Processing stage descriptor.
+ */
+struct iio_dsp {
+	/** Device whose input buffer is processed */
+	struct iio_device *dev;
+	/** Channel layouts and states, one per device channel */
+	struct iio_dsp_ch *ch;
+	enum iio_dsp_format format;
+	enum iio_dsp_filter filter;
+	uint32_t decimation;
+	uint8_t cic_order;
+	const int16_t *fir_taps;
+	uint32_t fir_len;
+	uint32_t chunk;
+	/** Filter gain normalization: divider, or shift if the divider is 0 */
+	uint64_t norm_div;
+	uint8_t norm_shift;
+	/** Kernel work areas, chunk samples each */
+	int32_t *work_in;
+	int32_t *work_out;
+	/** Output scans of one chunk */
+	uint8_t *out_scans;
+	/** Holds the device scans while the buffer is enabled */
+	struct no_os_circular_buffer raw_cb;
+	/** Active channels of the enabled buffer */
+	uint32_t mask;
+	uint32_t in_bytes_per_scan;
+	uint32_t out_bytes_per_scan;
+	/** Set when the device scans go through the stage */
+	bool active;
+};
+
+#ifdef NO_OS_IIO_DSP
+
+/* Buffer attributes controlling the processing stage */
+extern struct iio_attribute iio_dsp_buffer_attributes[];
+
+/* Allocate the processing stage of a device. */
+int iio_dsp_init(struct iio_dsp **dsp, struct iio_dsp_init_param *param,
+		 struct iio_device *dev);
+/* Free the processing stage. */
+int iio_dsp_remove(struct iio_dsp *dsp);
+/* Insert the stage between the device and the client buffer. */
+int iio_dsp_open(struct iio_dsp *dsp, struct iio_buffer *buffer,
+		 uint32_t *out_size);
+/* Free the resources of the enabled buffer. */
+void iio_dsp_close(struct iio_dsp *dsp);
+/* Process the device scans available so far into the client buffer. */
+int iio_dsp_process(struct iio_dsp *dsp, struct no_os_circular_buffer *out);
+/* Scan type of a channel, as seen by the client. */
+struct scan_type *iio_dsp_scan_type(struct iio_dsp *dsp, uint32_t ch);
+/* Number of device blocks making up one client block. */
+uint32_t iio_dsp_blocks(struct iio_dsp *dsp);
+/* Divide a sampling frequency read from the device by the decimation. */
+int iio_dsp_rate_read(struct iio_dsp *dsp, char *buf, uint32_t len, int ret);
+/* Multiply a sampling frequency written by the client by the decimation. */
+int iio_dsp_rate_write(struct iio_dsp *dsp, const char *buf, char *dev_buf,
+		       uint32_t len);
+
+#else
+
+#define iio_dsp_buffer_attributes ((struct iio_attribute *)NULL)
+
+static inline int iio_dsp_init(struct iio_dsp **dsp,
+			       struct iio_dsp_init_param *param,
+			       struct iio_device *dev)
+{
+	return -ENOSYS;
+}
+
+static inline int iio_dsp_remove(struct iio_dsp *dsp)
+{
+	return 0;
+}
+
+static inline int iio_dsp_open(struct iio_dsp *dsp, struct iio_buffer *buffer,
+			       uint32_t *out_size)
+{
+	return 0;
+}
+
+static inline void iio_dsp_close(struct iio_dsp *dsp)
+{
+}
+
+static inline int iio_dsp_process(struct iio_dsp *dsp,
+				  struct no_os_circular_buffer *out)
+{
+	return 0;
+}
+
+static inline struct scan_type *iio_dsp_scan_type(struct iio_dsp *dsp,
+		uint32_t ch)
+{
+	return NULL;
+}
+
+static inline uint32_t iio_dsp_blocks(struct iio_dsp *dsp)
+{
+	return 1;
+}
+
+static inline int iio_dsp_rate_read(struct iio_dsp *dsp, char *buf,
+				    uint32_t len, int ret)
+{
+	return ret;
+}
+
+static inline int iio_dsp_rate_write(struct iio_dsp *dsp, const char *buf,
+				     char *dev_buf, uint32_t len)
+{
+	return 0;
+}
+
+#endif /* NO_OS_IIO_DSP */
+
+#endif /* __IIO_DSP_H__ */
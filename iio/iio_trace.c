@@ -0,0 +1,245 @@
+/***************************************************************************//**
+ *   @file   iio_trace.c
+ *   @brief  Implementation of the trace point IIO device.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <stdarg.h>
+#include <inttypes.h>
+#include "no_os_alloc.h"
+#include "no_os_error.h"
+#include "no_os_util.h"
+
+#include "iio_trace.h"
+#include "iio_types.h"
+
+/**
+ * @brief Append to an attribute value.
+ * @param buf - Attribute buffer.
+ * @param len - Buffer length.
+ * @param n - Current length of the value.
+ * @param fmt - printf() like format.
+ * @return New length of the value.
+ */
+static uint32_t iio_trace_append(char *buf, uint32_t len, uint32_t n,
+				 const char *fmt, ...)
+{
+	va_list ap;
+	int ret;
+
+	if (n >= len)
+		return n;
+
+	va_start(ap, fmt);
+	ret = vsnprintf(buf + n, len - n, fmt, ap);
+	va_end(ap);
+	if (ret < 0)
+		return n;
+
+	return no_os_min(n + ret, len - 1);
+}
+
+/**
+ * @brief Read a debug attribute.
+ * @param device - The iio device structure.
+ * @param buf	 - Buffer to store the read data.
+ * @param len	 - Buffer length.
+ * @param channel - IIO channel.
+ * @param priv   - IIO private data.
+ * @return ret   - Result of the reading procedure.
+ */
+static int iio_trace_read_attr(void *device, char *buf, uint32_t len,
+			       const struct iio_ch_info *channel,
+			       intptr_t priv)
+{
+	struct iio_trace_desc *desc = device;
+	struct no_os_trace_point *tp = desc->sel;
+	uint32_t n = 0;
+	uint32_t i;
+
+	buf[0] = '\0';
+
+	switch (priv) {
+	case IIO_TRACE_POINTS:
+		for (tp = no_os_trace_first(); tp; tp = tp->next)
+			n = iio_trace_append(buf, len, n, "%s%s", n ? " " : "",
+					     tp->name);
+		return n;
+	case IIO_TRACE_SELECT:
+		return iio_trace_append(buf, len, 0, "%s", tp ? tp->name : "");
+	case IIO_TRACE_STATS:
+		if (!tp)
+			return -ENODEV;
+		return iio_trace_append(buf, len, 0,
+					"%" PRIu32 " %" PRIu64 " %" PRIu64 " %" PRIu64,
+					tp->count,
+					no_os_trace_ticks_to_ns(tp->min),
+					tp->count ? no_os_trace_ticks_to_ns(tp->total) /
+					tp->count : 0,
+					no_os_trace_ticks_to_ns(tp->max));
+	case IIO_TRACE_HISTOGRAM:
+		if (!tp)
+			return -ENODEV;
+		for (i = 0; i < NO_OS_TRACE_BUCKETS; i++)
+			n = iio_trace_append(buf, len, n, "%s%" PRIu32,
+					     i ? " " : "", tp->hist[i]);
+		return n;
+	case IIO_TRACE_BUCKETS:
+		for (i = 0; i < NO_OS_TRACE_BUCKETS - 1; i++)
+			n = iio_trace_append(buf, len, n, "%" PRIu64 " ",
+					     no_os_trace_ticks_to_ns(no_os_trace_bucket_limit(i)));
+		return iio_trace_append(buf, len, n, "inf");
+	case IIO_TRACE_ENABLE:
+		return iio_trace_append(buf, len, 0, "%d",
+					no_os_trace_is_enabled());
+	default:
+		return -EINVAL;
+	}
+}
+
+/**
+ * @brief Write a debug attribute.
+ * @param device - The iio device structure.
+ * @param buf	 - Buffer containing the value.
+ * @param len	 - Buffer length.
+ * @param channel - IIO channel.
+ * @param priv   - IIO private data.
+ * @return ret   - Result of the writing procedure.
+ */
+static int iio_trace_write_attr(void *device, char *buf, uint32_t len,
+				const struct iio_ch_info *channel,
+				intptr_t priv)
+{
+	struct iio_trace_desc *desc = device;
+	struct no_os_trace_point *tp;
+
+	switch (priv) {
+	case IIO_TRACE_SELECT:
+		tp = no_os_trace_find(buf);
+		if (!tp)
+			return -EINVAL;
+		desc->sel = tp;
+		return len;
+	case IIO_TRACE_ENABLE:
+		no_os_trace_enable(no_os_str_to_uint32(buf));
+		return len;
+	case IIO_TRACE_RESET:
+		no_os_trace_reset();
+		return len;
+	default:
+		return -EINVAL;
+	}
+}
+
+static struct iio_attribute iio_trace_debug_attrs[] = {
+	{
+		.name = "trace_points",
+		.priv = IIO_TRACE_POINTS,
+		.show = iio_trace_read_attr,
+	},
+	{
+		.name = "trace_select",
+		.priv = IIO_TRACE_SELECT,
+		.show = iio_trace_read_attr,
+		.store = iio_trace_write_attr,
+	},
+	{
+		.name = "trace_stats",
+		.priv = IIO_TRACE_STATS,
+		.show = iio_trace_read_attr,
+	},
+	{
+		.name = "trace_histogram",
+		.priv = IIO_TRACE_HISTOGRAM,
+		.show = iio_trace_read_attr,
+	},
+	{
+		.name = "trace_buckets_ns",
+		.priv = IIO_TRACE_BUCKETS,
+		.show = iio_trace_read_attr,
+	},
+	{
+		.name = "trace_enable",
+		.priv = IIO_TRACE_ENABLE,
+		.show = iio_trace_read_attr,
+		.store = iio_trace_write_attr,
+	},
+	{
+		.name = "trace_reset",
+		.priv = IIO_TRACE_RESET,
+		.store = iio_trace_write_attr,
+	},
+	END_ATTRIBUTES_ARRAY
+};
+
+/**
+ * @brief Initializes the trace point IIO device.
+ * @param iio_desc - The iio device descriptor.
+ * @return 0 in case of success, an error code otherwise.
+ */
+int iio_trace_init(struct iio_trace_desc **iio_desc)
+{
+	struct iio_trace_desc *descriptor;
+
+	if (!iio_desc)
+		return -EINVAL;
+
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	descriptor->iio_dev = no_os_calloc(1, sizeof(*descriptor->iio_dev));
+	if (!descriptor->iio_dev) {
+		no_os_free(descriptor);
+		return -ENOMEM;
+	}
+
+	descriptor->iio_dev->debug_attributes = iio_trace_debug_attrs;
+
+	*iio_desc = descriptor;
+
+	return 0;
+}
+
+/**
+ * @brief Free resources allocated by the init function
+ * @param desc - The iio device descriptor.
+ * @return 0 in case of success, an error code otherwise.
+ */
+int iio_trace_remove(struct iio_trace_desc *desc)
+{
+	if (!desc)
+		return -EINVAL;
+
+	no_os_free(desc->iio_dev);
+	no_os_free(desc);
+
+	return 0;
+}
@@ -0,0 +1,73 @@
+/***************************************************************************//**
+ *   @file   iio_trace.h
+ *   @brief  Header file of the trace point IIO device.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef __IIO_TRACE_H__
+#define __IIO_TRACE_H__
+
+#include "iio.h"
+#include "no_os_trace.h"
+
+/**
+ * @brief Structure holding the trace point IIO device descriptor
+ */
+struct iio_trace_desc {
+	struct iio_device *iio_dev;
+	/** Trace point reported by the statistics and histogram attributes */
+	struct no_os_trace_point *sel;
+};
+
+/* Trace IIO attributes */
+enum iio_trace_attr_id {
+	IIO_TRACE_POINTS,
+	IIO_TRACE_SELECT,
+	IIO_TRACE_STATS,
+	IIO_TRACE_HISTOGRAM,
+	IIO_TRACE_BUCKETS,
+	IIO_TRACE_ENABLE,
+	IIO_TRACE_RESET,
+};
+
+/**
+ * @brief Initialize the trace point IIO device, which reports the trace
+ * point statistics and histograms through debug attributes.
+ * @param iio_desc - Pointer to IIO descriptor pointer
+ * @return 0 in case of success, negative error code otherwise
+ */
+int iio_trace_init(struct iio_trace_desc **iio_desc);
+
+/**
+ * @brief Free resources allocated by the init function
+ * @param desc - IIO descriptor to free
+ * @return 0 in case of success, negative error code otherwise
+ */
+int iio_trace_remove(struct iio_trace_desc *desc);
+
+#endif /* __IIO_TRACE_H__ */
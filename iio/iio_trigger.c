@@ -38,7 +38,6 @@
 #include "iio.h"
 #include "iio_trigger.h"
 
-#ifndef LINUX_PLATFORM
 /**
  * @brief Initialize hardware trigger.
  *
@@ -168,7 +167,6 @@ int iio_hw_trig_remove(struct iio_hw_trig *trig)
 
 	return 0;
 }
-#endif
 
 /**
  * @brief Initialize software trigger.
@@ -42,6 +42,7 @@
 
 #include "no_os_error.h"
 #include "no_os_util.h"
+#include "no_os_trace.h"
 
 #define SET_DUMMY_IF_NULL(func, dummy) ((func) ? (func) : (dummy))
 
@@ -909,6 +910,8 @@ static int32_t iiod_run_state(struct iiod_desc *desc,
 	}
 }
 
+NO_OS_TRACE_POINT(iiod_conn_step_tp, "iiod_conn_step");
+
 int32_t iiod_conn_step(struct iiod_desc *desc, uint32_t conn_id)
 {
 	struct iiod_conn_priv *conn;
@@ -918,17 +921,21 @@ int32_t iiod_conn_step(struct iiod_desc *desc, uint32_t conn_id)
 	    !desc->conns[conn_id].used)
 		return -EINVAL;
 
+	NO_OS_TRACE_BEGIN(ts);
 	conn = &desc->conns[conn_id];
 	do {
 		ret = iiod_run_state(desc, conn);
-		if (ret == -EAGAIN)
+		if (ret == -EAGAIN) {
+			NO_OS_TRACE_END(iiod_conn_step_tp, ts);
 			return ret;
+		}
 		if (NO_OS_IS_ERR_VALUE(ret) || conn->state == IIOD_LINE_DONE)
 			break;
 		//The loop will continue because the state was changed.
 	} while (true);
 
 	conn_clean_state(conn);
+	NO_OS_TRACE_END(iiod_conn_step_tp, ts);
 
 	return ret;
 }
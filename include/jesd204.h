@@ -244,11 +244,30 @@ struct jesd204_topology_dev {
 	unsigned int		links_number;
 };
 
+/* no-OS specific */
+struct jesd204_fsm_step;
+
 /* no-OS specific */
 struct jesd204_topology {
 	struct jesd204_dev_top		*dev_top;
 	struct jesd204_topology_dev	*devs;
 	unsigned int			devs_number;
+
+	/* Call sequences of one op, built on the first transition */
+	struct jesd204_fsm_step		*fsm_init_steps;
+	unsigned int			fsm_init_steps_number;
+	struct jesd204_fsm_step		*fsm_uninit_steps;
+	unsigned int			fsm_uninit_steps_number;
+	/* Duration in us of each op on each device, top device last */
+	uint32_t			*fsm_time_us;
+	/* Duration in us of the last transition */
+	uint32_t			fsm_total_us;
+	/* Number of ops completed, in order, since DEVICE_INIT */
+	unsigned int			fsm_ops_done;
+	/* Error returned by the last transition and where it occurred */
+	int				fsm_err;
+	enum jesd204_dev_op		fsm_err_op;
+	unsigned int			fsm_err_dev;
 };
 
 /* no-OS specific */
@@ -269,9 +288,23 @@ int jesd204_topology_remove(struct jesd204_topology *topology);
 /* no-OS specific */
 int jesd204_fsm_start(struct jesd204_topology *topology, unsigned int link_idx);
 
+/* no-OS specific */
+int jesd204_fsm_start_from(struct jesd204_topology *topology,
+			   unsigned int link_idx, enum jesd204_dev_op first_op);
+
 /* no-OS specific */
 int jesd204_fsm_stop(struct jesd204_topology *topology, unsigned int link_idx);
 
+/* no-OS specific */
+const char *jesd204_fsm_op_name(enum jesd204_dev_op op);
+
+/* no-OS specific */
+int jesd204_fsm_op_find(const char *name, enum jesd204_dev_op *op);
+
+/* no-OS specific */
+int jesd204_fsm_timing_show(struct jesd204_topology *topology, char *buf,
+			    uint32_t len);
+
 void *jesd204_dev_priv(struct jesd204_dev *jdev);
 
 int jesd204_link_get_lmfc_lemc_rate(struct jesd204_link *lnk,
@@ -34,6 +34,59 @@
 #define _NO_OS_CLK_H_
 
 #include <stdint.h>
+#include <stdbool.h>
+#include "no_os_util.h"
+
+/** The rate read from the hardware is cached until the rate of the clock or
+ *  of one of its parents is changed through this API. */
+#define NO_OS_CLK_CACHE_RATE		NO_OS_BIT(0)
+/** Clocks without a set rate operation forward the request to the parent. */
+#define NO_OS_CLK_SET_RATE_PARENT	NO_OS_BIT(1)
+
+struct no_os_clk_desc;
+
+/**
+ * @enum no_os_clk_event
+ * @brief Events delivered to the clock rate change notifiers.
+ */
+enum no_os_clk_event {
+	/** The rate is about to change, the notifier may veto the change. */
+	NO_OS_CLK_PRE_RATE_CHANGE,
+	/** The rate has changed. */
+	NO_OS_CLK_POST_RATE_CHANGE,
+	/** A change announced by NO_OS_CLK_PRE_RATE_CHANGE did not happen. */
+	NO_OS_CLK_ABORT_RATE_CHANGE,
+};
+
+/**
+ * @struct no_os_clk_notifier_data
+ * @brief Rate change information passed to the notifiers.
+ */
+struct no_os_clk_notifier_data {
+	/** Clock whose rate changes */
+	struct no_os_clk_desc	*clk;
+	/** Rate before the change */
+	uint64_t		old_rate;
+	/** Rate after the change. For NO_OS_CLK_PRE_RATE_CHANGE this is the
+	 *  requested rate of the clock being set and 0 for its children. */
+	uint64_t		new_rate;
+};
+
+/**
+ * @struct no_os_clk_notifier
+ * @brief Rate change notifier, allocated by the consumer.
+ */
+struct no_os_clk_notifier {
+	/** Called for every event. A non zero return value for
+	 *  NO_OS_CLK_PRE_RATE_CHANGE aborts the change. */
+	int (*notifier_call)(struct no_os_clk_notifier *nb,
+			     enum no_os_clk_event event,
+			     struct no_os_clk_notifier_data *data);
+	/** Consumer context */
+	void				*ctx;
+	/** Next notifier of the same clock */
+	struct no_os_clk_notifier	*next;
+};
 
 struct no_os_clk_init_param {
 	/** Device name */
@@ -44,6 +97,10 @@ struct no_os_clk_init_param {
 	const struct no_os_clk_platform_ops *platform_ops;
 	/**  CLK hardware device descriptor */
 	void		*dev_desc;
+	/** Parent clock, NULL for a root clock */
+	struct no_os_clk_desc	*parent;
+	/** NO_OS_CLK_* flags */
+	uint32_t	flags;
 };
 
 struct no_os_clk_hw {
@@ -75,6 +132,24 @@ typedef struct no_os_clk_desc {
 	const struct no_os_clk_platform_ops *platform_ops;
 	/**  CLK hardware device descriptor */
 	void		*dev_desc;
+	/** Parent clock, NULL for a root clock */
+	struct no_os_clk_desc	*parent;
+	/** First child clock */
+	struct no_os_clk_desc	*children;
+	/** Next clock having the same parent */
+	struct no_os_clk_desc	*sibling;
+	/** NO_OS_CLK_* flags */
+	uint32_t	flags;
+	/** Last rate read from the hardware */
+	uint64_t	rate;
+	/** Set while rate holds the current rate of the clock */
+	bool		rate_valid;
+	/** Number of no_os_clk_prepare() calls not yet undone */
+	uint32_t	prepare_count;
+	/** Number of no_os_clk_enable() calls not yet undone */
+	uint32_t	enable_count;
+	/** Rate change notifiers */
+	struct no_os_clk_notifier	*notifiers;
 } no_os_clk_desc;
 
 /**
@@ -97,6 +172,12 @@ struct no_os_clk_platform_ops {
 	int (*clk_set_rate)(struct no_os_clk_desc *, uint64_t);
 	/** CLK remove function pointer */
 	int (*remove)(struct no_os_clk_desc *);
+	/** Prepare CLK function pointer, may sleep. */
+	int (*clk_prepare)(struct no_os_clk_desc *);
+	/** Unprepare CLK function pointer. */
+	int (*clk_unprepare)(struct no_os_clk_desc *);
+	/** Select the CLK parent function pointer. */
+	int (*clk_set_parent)(struct no_os_clk_desc *, struct no_os_clk_desc *);
 };
 
 /* Initialize CLK ops. */
@@ -125,4 +206,37 @@ int32_t no_os_clk_round_rate(struct no_os_clk_desc *desc,
 int32_t no_os_clk_set_rate(struct no_os_clk_desc *desc,
 			   uint64_t rate);
 
+/* Prepare the clock and its parents. */
+int32_t no_os_clk_prepare(struct no_os_clk_desc *desc);
+
+/* Undo a no_os_clk_prepare() call. */
+int32_t no_os_clk_unprepare(struct no_os_clk_desc *desc);
+
+/* Prepare and start the clock. */
+int32_t no_os_clk_prepare_enable(struct no_os_clk_desc *desc);
+
+/* Stop and unprepare the clock. */
+int32_t no_os_clk_disable_unprepare(struct no_os_clk_desc *desc);
+
+/* Move the clock under a new parent. */
+int32_t no_os_clk_set_parent(struct no_os_clk_desc *desc,
+			     struct no_os_clk_desc *parent);
+
+/* Get the parent of the clock. */
+struct no_os_clk_desc *no_os_clk_get_parent(struct no_os_clk_desc *desc);
+
+/* Drop the cached rate of the clock and of its children. */
+void no_os_clk_invalidate_rate(struct no_os_clk_desc *desc);
+
+/* Register a rate change notifier. */
+int32_t no_os_clk_notifier_register(struct no_os_clk_desc *desc,
+				    struct no_os_clk_notifier *nb);
+
+/* Unregister a rate change notifier. */
+int32_t no_os_clk_notifier_unregister(struct no_os_clk_desc *desc,
+				      struct no_os_clk_notifier *nb);
+
+/* Print the clock tree starting from the given clock. */
+void no_os_clk_tree_dump(struct no_os_clk_desc *root);
+
 #endif // _NO_OS_CLK_H_
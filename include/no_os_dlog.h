@@ -0,0 +1,151 @@
+/***************************************************************************//**
+ *   @file   no_os_dlog.h
+ *   @brief  Deferred binary logger.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef _NO_OS_DLOG_H_
+#define _NO_OS_DLOG_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "no_os_print_log.h"
+
+/*
+ * Deferred logging: a call site only stores the address of a constant
+ * descriptor (format string, file, function, line and level) and the raw
+ * arguments in a ring buffer. Formatting is done later, either on target by
+ * no_os_dlog_flush() called from a low priority context, or on a host by
+ * tools/scripts/no_os_dlog_decode.py from the no_os_dlog_dump() stream and
+ * the ELF file of the application.
+ *
+ * The ring may be written concurrently from several threads or interrupts
+ * (compare and swap reservation), while a single context consumes it. On
+ * cores without compare and swap instructions (e.g. ARMv6-M), the
+ * __atomic_compare_exchange_4 helper has to be provided.
+ *
+ * %s arguments are recorded as pointers, so they must point to strings that
+ * are still valid when the entry is formatted (e.g. string literals or device
+ * names). At most NO_OS_DLOG_MAX_ARGS arguments are recorded and long double
+ * and %n conversions are not supported.
+ */
+
+#define NO_OS_DLOG_MAX_ARGS	10
+#define NO_OS_DLOG_LINE_MAX	160
+
+/**
+ * @struct no_os_dlog_fmt
+ * @brief Constant descriptor of a log call site, its address is the ID
+ * recorded in the ring.
+ */
+struct no_os_dlog_fmt {
+	/** Format string */
+	const char *fmt;
+	/** Source file */
+	const char *file;
+	/** Calling function */
+	const char *func;
+	/** Source line */
+	uint32_t line;
+	/** NO_OS_LOG_* level */
+	uint32_t level;
+};
+
+/**
+ * @struct no_os_dlog_init_param
+ * @brief Deferred logger initialization parameters.
+ */
+struct no_os_dlog_init_param {
+	/** Ring buffer, must stay valid until no_os_dlog_remove() */
+	uint32_t *buffer;
+	/** Ring size in 32 bit words, power of 2 */
+	uint32_t size;
+	/** Maximum level recorded */
+	uint8_t level;
+	/** Optional timestamp recorded with every entry */
+	uint32_t (*timestamp)(void);
+	/** Optional output of the formatted lines, printf() if NULL */
+	void (*output)(const char *line);
+};
+
+/**
+ * @struct no_os_dlog_bench_result
+ * @brief Cycles per log call, as measured by no_os_dlog_bench().
+ */
+struct no_os_dlog_bench_result {
+	/** Deferred call */
+	uint32_t dlog_cycles;
+	/** Deferred call of a filtered out level */
+	uint32_t filtered_cycles;
+	/** printf() of the same message */
+	uint32_t printf_cycles;
+	/** Deferred formatting by no_os_dlog_flush() */
+	uint32_t flush_cycles;
+};
+
+/** Bit mask of the levels recorded, one bit per NO_OS_LOG_* level. */
+extern volatile uint32_t no_os_dlog_levels;
+
+/**
+ * @brief Record a message in the deferred log.
+ * @param level - NO_OS_LOG_* level.
+ * @param fmt - printf() like format, must be a string literal.
+ */
+#define no_os_dlog(level, fmt, args...) do {					\
+	static const struct no_os_dlog_fmt _dlog_fmt = {			\
+		fmt, __FILE__, __func__, __LINE__, level			\
+	};									\
+	static uint32_t _dlog_sig;						\
+	if ((level) <= NO_OS_LOG_LEVEL &&					\
+	    (no_os_dlog_levels & (1u << (level))))				\
+		no_os_dlog_record(&_dlog_fmt, &_dlog_sig, ##args);		\
+} while (0)
+
+/* Initialize the deferred logger. */
+int no_os_dlog_init(struct no_os_dlog_init_param *param);
+/* Stop recording, pending entries are dropped. */
+void no_os_dlog_remove(void);
+/* Record all levels up to and including level. */
+void no_os_dlog_set_level(uint8_t level);
+/* Enable or disable recording of a single level. */
+void no_os_dlog_enable_level(uint8_t level, bool enable);
+/* Record an entry, called through no_os_dlog(). */
+int no_os_dlog_record(const struct no_os_dlog_fmt *id, uint32_t *sig, ...);
+/* Format and output up to max entries (0 for all). */
+int no_os_dlog_flush(uint32_t max);
+/* Write up to max entries (0 for all) in binary form, for a host decoder. */
+int no_os_dlog_dump(uint32_t max, void (*write)(const void *data,
+		    uint32_t len));
+/* Number of entries lost because the ring was full. */
+uint32_t no_os_dlog_dropped(void);
+/* Measure the cost of a log call compared with printf(). */
+int no_os_dlog_bench(uint32_t count, uint32_t (*cycles)(void),
+		     struct no_os_dlog_bench_result *result);
+
+#endif // _NO_OS_DLOG_H_
@@ -127,6 +127,9 @@ struct no_os_dma_ch {
 	 * even if it's free. Used as a synchronization mechanism between channels.
 	 */
 	bool sync_lock;
+
+	/** Start timestamp of the transfer in progress, used by the tracing */
+	uint32_t xfer_ts;
 };
 
 /**
@@ -82,6 +82,22 @@ struct no_os_i2cbus_desc {
 };
 
 
+/**
+ * @struct no_os_i2c_msg
+ * @brief I2C message, part of a combined transaction.
+ */
+struct no_os_i2c_msg {
+	/** Data to write or buffer storing the read data */
+	uint8_t		*data;
+	/** Number of bytes to read/write */
+	uint8_t		bytes_number;
+	/** 0 to write, otherwise read */
+	uint8_t		read;
+	/** 1 to generate a stop condition after the message, 0 for a
+	 *  repeated start */
+	uint8_t		stop_bit;
+};
+
 /**
  * @struct no_os_i2c_desc
  * @brief Structure holding I2C address descriptor
@@ -116,6 +132,9 @@ struct no_os_i2c_platform_ops {
 	int32_t (*i2c_ops_read)(struct no_os_i2c_desc *, uint8_t *, uint8_t, uint8_t);
 	/** i2c remove function pointer */
 	int32_t (*i2c_ops_remove)(struct no_os_i2c_desc *);
+	/** i2c combined transaction function pointer (optional) */
+	int32_t (*i2c_ops_transfer)(struct no_os_i2c_desc *, struct no_os_i2c_msg *,
+				    uint32_t);
 };
 
 /* Initialize the I2C communication peripheral. */
@@ -137,6 +156,11 @@ int32_t no_os_i2c_read(struct no_os_i2c_desc *desc,
 		       uint8_t bytes_number,
 		       uint8_t stop_bit);
 
+/* Perform a sequence of reads and writes. */
+int32_t no_os_i2c_transfer(struct no_os_i2c_desc *desc,
+			   struct no_os_i2c_msg *msgs,
+			   uint32_t len);
+
 /* Initialize I2C bus descriptor*/
 int32_t no_os_i2cbus_init(const struct no_os_i2c_init_param *param);
 
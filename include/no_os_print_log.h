@@ -49,6 +49,23 @@
 #define NO_OS_LOG_LEVEL NO_OS_LOG_INFO
 #endif
 
+#if defined(NO_OS_DLOG)
+/*
+ * Record the messages in the deferred logger instead of printing them, the
+ * application has to call no_os_dlog_init() and no_os_dlog_flush().
+ */
+#include "no_os_dlog.h"
+
+#define pr_emerg(fmt, args...)		no_os_dlog(NO_OS_LOG_EMERG, fmt, ##args)
+#define pr_alert(fmt, args...)		no_os_dlog(NO_OS_LOG_ALERT, fmt, ##args)
+#define pr_crit(fmt, args...)		no_os_dlog(NO_OS_LOG_CRIT, fmt, ##args)
+#define pr_err(fmt, args...)		no_os_dlog(NO_OS_LOG_ERR, fmt, ##args)
+#define pr_warning(fmt, args...)	no_os_dlog(NO_OS_LOG_WARNING, fmt, ##args)
+#define pr_notice(fmt, args...)		no_os_dlog(NO_OS_LOG_NOTICE, fmt, ##args)
+#define pr_info(fmt, args...)		no_os_dlog(NO_OS_LOG_INFO, fmt, ##args)
+#define pr_debug(fmt, args...)		no_os_dlog(NO_OS_LOG_DEBUG, fmt, ##args)
+#else
+
 #if defined(PRINT_TIME)
 #define pr_time			{ struct no_os_time _t = no_os_get_time();	\
 	printf("[%5d.%06d] ", _t.s, _t.us);					\
@@ -129,4 +146,6 @@
 #define pr_debug(fmt, args...)
 #endif
 
+#endif // NO_OS_DLOG
+
 #endif // _NO_OS_PRINT_LOG_H_
@@ -103,6 +103,16 @@ struct no_os_spi_msg {
 	uint32_t		cs_delay_first;
 	/** Delay (in us) between the last SCLK edge and the CS deassert */
 	uint32_t		cs_delay_last;
+	/**
+	 * SCLK frequency of this message, 0 to use the descriptor max_speed_hz.
+	 * Only used by the platforms supporting it.
+	 */
+	uint32_t		speed_hz;
+	/**
+	 * Bits per word of this message, 0 for 8 bits. Only used by the
+	 * platforms supporting it.
+	 */
+	uint8_t			bits_per_word;
 };
 
 /**
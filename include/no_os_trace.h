@@ -0,0 +1,155 @@
+/***************************************************************************//**
+ *   @file   no_os_trace.h
+ *   @brief  Trace points and latency histograms.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef _NO_OS_TRACE_H_
+#define _NO_OS_TRACE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "no_os_timer.h"
+
+/*
+ * Trace points measure the time spent between a begin and an end timestamp,
+ * taken from a cycle counter or from a running no_os_timer. Each trace point
+ * keeps its count, minimum, maximum and total duration and a histogram with
+ * NO_OS_TRACE_BUCKETS power of 2 buckets: with d the duration in ticks
+ * divided by 2^hist_shift, bucket 0 counts d = 0 and bucket i counts
+ * d in [2^(i-1), 2^i). The last bucket also counts the longer durations.
+ *
+ * The instrumentation is only built when NO_OS_TRACE is defined
+ * (CONFIG_TRACE), otherwise the NO_OS_TRACE_* macros expand to nothing.
+ * Trace points are registered on their first hit.
+ *
+ * The counter must be 32 bits wide, so that durations are computed modulo
+ * 2^32. The statistics of a trace point hit concurrently from several
+ * contexts may lose updates.
+ */
+
+#define NO_OS_TRACE_BUCKETS	16
+
+/**
+ * @struct no_os_trace_point
+ * @brief Trace point state.
+ */
+struct no_os_trace_point {
+	/** Trace point name */
+	const char *name;
+	/** Number of hits */
+	uint32_t count;
+	/** Minimum duration (ticks) */
+	uint32_t min;
+	/** Maximum duration (ticks) */
+	uint32_t max;
+	/** Total duration (ticks) */
+	uint64_t total;
+	/** Duration histogram */
+	uint32_t hist[NO_OS_TRACE_BUCKETS];
+	/** Set once the trace point is in the list */
+	uint32_t registered;
+	/** Next registered trace point */
+	struct no_os_trace_point *next;
+};
+
+/**
+ * @struct no_os_trace_event
+ * @brief Recorded trace point hit, used for the trace export.
+ */
+struct no_os_trace_event {
+	struct no_os_trace_point *tp;
+	/** Begin timestamp (ticks) */
+	uint32_t start;
+	/** Duration (ticks) */
+	uint32_t duration;
+};
+
+/**
+ * @struct no_os_trace_init_param
+ * @brief Tracing initialization parameters.
+ */
+struct no_os_trace_init_param {
+	/** Cycle counter, used when set */
+	uint32_t (*get_cycles)(void);
+	/** Running 32 bit timer, used when get_cycles is NULL */
+	struct no_os_timer_desc *timer;
+	/** Counter frequency (Hz), the timer frequency is used if 0 */
+	uint32_t freq_hz;
+	/** Histogram resolution, the first bucket limit is 2^hist_shift ticks */
+	uint8_t hist_shift;
+	/** Optional event buffer for no_os_trace_export(), power of 2 size */
+	struct no_os_trace_event *events;
+	/** Number of events of the buffer */
+	uint32_t nb_events;
+};
+
+#ifdef NO_OS_TRACE
+/** Define a trace point */
+#define NO_OS_TRACE_POINT(tp, tp_name) \
+	static struct no_os_trace_point tp = { .name = tp_name }
+/** Take the begin timestamp of a trace point */
+#define NO_OS_TRACE_BEGIN(ts)		uint32_t ts = no_os_trace_now()
+/** Store the begin timestamp in an existing variable */
+#define NO_OS_TRACE_STAMP(ts)		(ts) = no_os_trace_now()
+/** Account the time elapsed since the begin timestamp */
+#define NO_OS_TRACE_END(tp, ts)		no_os_trace_end(&(tp), ts)
+#else
+#define NO_OS_TRACE_POINT(tp, tp_name)	struct no_os_trace_point
+#define NO_OS_TRACE_BEGIN(ts)
+#define NO_OS_TRACE_STAMP(ts)
+#define NO_OS_TRACE_END(tp, ts)
+#endif
+
+/* Initialize the tracing and enable it. */
+int no_os_trace_init(struct no_os_trace_init_param *param);
+/* Stop the tracing. */
+void no_os_trace_remove(void);
+/* Enable or disable the tracing. */
+void no_os_trace_enable(bool enable);
+/* Check whether the tracing is enabled. */
+bool no_os_trace_is_enabled(void);
+/* Get the current timestamp (ticks). */
+uint32_t no_os_trace_now(void);
+/* Account a trace point hit. */
+void no_os_trace_end(struct no_os_trace_point *tp, uint32_t start);
+/* Get the first registered trace point. */
+struct no_os_trace_point *no_os_trace_first(void);
+/* Find a registered trace point by name. */
+struct no_os_trace_point *no_os_trace_find(const char *name);
+/* Clear the statistics of all trace points and the recorded events. */
+void no_os_trace_reset(void);
+/* Convert ticks to nanoseconds. */
+uint64_t no_os_trace_ticks_to_ns(uint64_t ticks);
+/* Get the upper bound (ticks) of a histogram bucket. */
+uint32_t no_os_trace_bucket_limit(uint32_t bucket);
+/* Export the recorded events in Chrome trace event JSON format. */
+int no_os_trace_export(void (*write)(void *ctx, const char *str), void *ctx);
+
+#endif // _NO_OS_TRACE_H_
@@ -0,0 +1,69 @@
+/**
+ * The JESD204 framework - IIO interface of the finite state machine
+ *
+ * Copyright (c) 2026 Analog Devices Inc.
+ */
+
+#include <stdio.h>
+#include "no_os_error.h"
+#include "jesd204.h"
+#include "iio_jesd204_fsm.h"
+
+static int jesd204_fsm_iio_timing_show(void *device, char *buf, uint32_t len,
+				       const struct iio_ch_info *channel,
+				       intptr_t priv)
+{
+	return jesd204_fsm_timing_show(device, buf, len);
+}
+
+static int jesd204_fsm_iio_state_show(void *device, char *buf, uint32_t len,
+				      const struct iio_ch_info *channel,
+				      intptr_t priv)
+{
+	struct jesd204_topology *topology = device;
+
+	if (!topology->fsm_ops_done)
+		return snprintf(buf, len, "uninit");
+
+	return snprintf(buf, len, "%s",
+			jesd204_fsm_op_name(topology->fsm_ops_done - 1));
+}
+
+/*
+ * Writing an op name re-runs the transitions starting from that op, e.g.
+ * "link_setup" to retrain the links without resetting the devices.
+ */
+static int jesd204_fsm_iio_state_store(void *device, char *buf, uint32_t len,
+				       const struct iio_ch_info *channel,
+				       intptr_t priv)
+{
+	enum jesd204_dev_op op;
+	int ret;
+
+	ret = jesd204_fsm_op_find(buf, &op);
+	if (ret)
+		return ret;
+
+	ret = jesd204_fsm_start_from(device, JESD204_LINKS_ALL, op);
+	if (ret)
+		return ret;
+
+	return len;
+}
+
+static struct iio_attribute jesd204_fsm_iio_debug_attrs[] = {
+	{
+		.name = "fsm_timing",
+		.show = jesd204_fsm_iio_timing_show,
+	},
+	{
+		.name = "fsm_state",
+		.show = jesd204_fsm_iio_state_show,
+		.store = jesd204_fsm_iio_state_store,
+	},
+	END_ATTRIBUTES_ARRAY
+};
+
+struct iio_device jesd204_fsm_iio_descriptor = {
+	.debug_attributes = jesd204_fsm_iio_debug_attrs,
+};
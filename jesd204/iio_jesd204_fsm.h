@@ -0,0 +1,18 @@
+/**
+ * The JESD204 framework - IIO interface of the finite state machine
+ *
+ * Copyright (c) 2026 Analog Devices Inc.
+ */
+
+#ifndef _IIO_JESD204_FSM_H_
+#define _IIO_JESD204_FSM_H_
+
+#include "iio_types.h"
+
+/*
+ * IIO device exposing the state transitions of a JESD204 topology. The device
+ * pointer passed to IIO must be the struct jesd204_topology.
+ */
+extern struct iio_device jesd204_fsm_iio_descriptor;
+
+#endif /* _IIO_JESD204_FSM_H_ */
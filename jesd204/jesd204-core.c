@@ -129,6 +129,10 @@ int jesd204_topology_remove(struct jesd204_topology *topology)
 	if (!topology)
 		return -EINVAL;
 
+	no_os_free(topology->fsm_time_us);
+	no_os_free(topology->fsm_uninit_steps);
+	no_os_free(topology->fsm_init_steps);
+	no_os_free(topology->devs);
 	no_os_free(topology->dev_top);
 	no_os_free(topology);
 
@@ -4,98 +4,419 @@
  * Copyright (c) 2022 Analog Devices Inc.
  */
 
+#include <stdio.h>
+#include <string.h>
 #include "no_os_error.h"
+#include "no_os_alloc.h"
+#include "no_os_delay.h"
+#include "no_os_util.h"
 #include "jesd204-priv.h"
 
 /* no-OS specific */
-int jesd204_fsm_start(struct jesd204_topology *topology, unsigned int link_idx)
+static const char *const jesd204_op_names[__JESD204_MAX_OPS] = {
+	[JESD204_OP_DEVICE_INIT] = "device_init",
+	[JESD204_OP_LINK_INIT] = "link_init",
+	[JESD204_OP_LINK_SUPPORTED] = "link_supported",
+	[JESD204_OP_LINK_PRE_SETUP] = "link_pre_setup",
+	[JESD204_OP_CLK_SYNC_STAGE1] = "clk_sync_stage1",
+	[JESD204_OP_CLK_SYNC_STAGE2] = "clk_sync_stage2",
+	[JESD204_OP_CLK_SYNC_STAGE3] = "clk_sync_stage3",
+	[JESD204_OP_LINK_SETUP] = "link_setup",
+	[JESD204_OP_OPT_SETUP_STAGE1] = "opt_setup_stage1",
+	[JESD204_OP_OPT_SETUP_STAGE2] = "opt_setup_stage2",
+	[JESD204_OP_OPT_SETUP_STAGE3] = "opt_setup_stage3",
+	[JESD204_OP_OPT_SETUP_STAGE4] = "opt_setup_stage4",
+	[JESD204_OP_OPT_SETUP_STAGE5] = "opt_setup_stage5",
+	[JESD204_OP_CLOCKS_ENABLE] = "clocks_enable",
+	[JESD204_OP_LINK_ENABLE] = "link_enable",
+	[JESD204_OP_LINK_RUNNING] = "link_running",
+	[JESD204_OP_OPT_POST_RUNNING_STAGE] = "opt_post_running_stage",
+};
+
+/* no-OS specific */
+const char *jesd204_fsm_op_name(enum jesd204_dev_op op)
+{
+	if (op >= __JESD204_MAX_OPS)
+		return "unknown";
+
+	return jesd204_op_names[op];
+}
+
+/* no-OS specific */
+int jesd204_fsm_op_find(const char *name, enum jesd204_dev_op *op)
+{
+	size_t len = strlen(name);
+	int i;
+
+	/* Ignore the trailing new line of values written through IIO */
+	while (len && (name[len - 1] == '\n' || name[len - 1] == '\r'))
+		len--;
+
+	for (i = 0; i < __JESD204_MAX_OPS; i++) {
+		if (strlen(jesd204_op_names[i]) == len &&
+		    !strncmp(jesd204_op_names[i], name, len)) {
+			*op = i;
+			return 0;
+		}
+	}
+
+	return -EINVAL;
+}
+
+/* no-OS specific */
+static void jesd204_fsm_add_step(struct jesd204_fsm_step *steps,
+				 unsigned int *steps_number, unsigned int dev,
+				 unsigned int lnk_id, enum jesd204_fsm_call call)
+{
+	if (steps) {
+		steps[*steps_number].dev = dev;
+		steps[*steps_number].lnk_id = lnk_id;
+		steps[*steps_number].call = call;
+	}
+
+	(*steps_number)++;
+}
+
+/* no-OS specific */
+static void jesd204_fsm_add_dev_steps(struct jesd204_topology *topology,
+				      struct jesd204_fsm_step *steps,
+				      unsigned int *steps_number,
+				      bool *per_device_done, unsigned int dev,
+				      unsigned int lnk_id, bool reverse)
+{
+	struct jesd204_topology_dev *tdev = &topology->devs[dev];
+	unsigned int link_id = topology->dev_top->link_ids[lnk_id];
+	unsigned int i, lnk_dev;
+
+	for (i = 0; i < tdev->links_number; i++) {
+		lnk_dev = reverse ? tdev->links_number - 1 - i : i;
+		if (tdev->link_ids[lnk_dev] != link_id)
+			continue;
+
+		if (!per_device_done[dev]) {
+			jesd204_fsm_add_step(steps, steps_number, dev, lnk_id,
+					     JESD204_FSM_PER_DEVICE);
+			per_device_done[dev] = true;
+		}
+		jesd204_fsm_add_step(steps, steps_number, dev, lnk_id,
+				     JESD204_FSM_PER_LINK);
+	}
+}
+
+/* no-OS specific */
+static int jesd204_fsm_build(struct jesd204_topology *topology, bool reverse,
+			     struct jesd204_fsm_step **steps,
+			     unsigned int *steps_number)
 {
-	enum jesd204_state_op_reason reason = JESD204_STATE_OP_REASON_INIT;
 	struct jesd204_dev_top *jdev_top = topology->dev_top;
-	bool per_device_op_done[16];
-	enum jesd204_dev_op op;
-	int lnk_dev;
-	int lnk_id;
-	int dev;
+	unsigned int top = topology->devs_number;
+	struct jesd204_fsm_step *table = NULL;
+	bool *per_device_done;
+	unsigned int lnk_id;
+	unsigned int dev;
+	unsigned int n;
+	int pass;
 
-	for (op = 0; op < __JESD204_MAX_OPS; op++) {
-		for (dev = 0; dev < topology->devs_number; dev++)
-			per_device_op_done[dev] = false;
+	per_device_done = no_os_calloc(topology->devs_number + 1,
+				       sizeof(*per_device_done));
+	if (!per_device_done)
+		return -ENOMEM;
+
+	/* The first pass counts the steps, the second one fills the table */
+	for (pass = 0; pass < 2; pass++) {
+		memset(per_device_done, 0,
+		       (topology->devs_number + 1) * sizeof(*per_device_done));
+		n = 0;
+
+		if (reverse)
+			jesd204_fsm_add_step(table, &n, top, 0,
+					     JESD204_FSM_PER_DEVICE);
 
 		for (lnk_id = 0; lnk_id < jdev_top->num_links; lnk_id++) {
-			for (dev = 0; dev < topology->devs_number; dev++) {
-				for (lnk_dev = 0; lnk_dev < topology->devs[dev].links_number; lnk_dev++) {
-					if (topology->devs[dev].link_ids[lnk_dev] == jdev_top->link_ids[lnk_id]) {
-						if (topology->devs[dev].jdev->dev_data->state_ops[op].per_device
-						    && !per_device_op_done[dev]) {
-							topology->devs[dev].jdev->dev_data->state_ops[op].per_device(
-								topology->devs[dev].jdev, reason);
-							per_device_op_done[dev] = true;
-						}
-						if (topology->devs[dev].jdev->dev_data->state_ops[op].per_link)
-							topology->devs[dev].jdev->dev_data->state_ops[op].per_link(
-								topology->devs[dev].jdev, reason,
-								&jdev_top->active_links[lnk_id].link);
-					}
-				}
-			}
-			if (jdev_top->jdev->dev_data->state_ops[op].per_link) {
-				jdev_top->jdev->dev_data->state_ops[op].per_link(jdev_top->jdev, reason,
-						&jdev_top->active_links[lnk_id].link);
-				if (jdev_top->jdev->dev_data->state_ops[op].post_state_sysref)
-					jesd204_sysref_async(jdev_top->jdev);
+			if (!reverse) {
+				for (dev = 0; dev < topology->devs_number; dev++)
+					jesd204_fsm_add_dev_steps(topology, table, &n,
+								  per_device_done,
+								  dev, lnk_id, false);
+				jesd204_fsm_add_step(table, &n, top, lnk_id,
+						     JESD204_FSM_PER_LINK);
+				continue;
 			}
+
+			jesd204_fsm_add_step(table, &n, top,
+					     jdev_top->num_links - 1 - lnk_id,
+					     JESD204_FSM_PER_LINK);
+			for (dev = topology->devs_number; dev > 0; dev--)
+				jesd204_fsm_add_dev_steps(topology, table, &n,
+							  per_device_done, dev - 1,
+							  jdev_top->num_links - 1 - lnk_id,
+							  true);
 		}
-		if (jdev_top->jdev->dev_data->state_ops[op].per_device) {
-			jdev_top->jdev->dev_data->state_ops[op].per_device(jdev_top->jdev, reason);
-			if (jdev_top->jdev->dev_data->state_ops[op].post_state_sysref)
-				jesd204_sysref_async(jdev_top->jdev);
+
+		if (!reverse)
+			jesd204_fsm_add_step(table, &n, top, 0,
+					     JESD204_FSM_PER_DEVICE);
+
+		if (pass)
+			break;
+
+		table = no_os_calloc(n, sizeof(*table));
+		if (!table) {
+			no_os_free(per_device_done);
+			return -ENOMEM;
 		}
 	}
 
+	no_os_free(per_device_done);
+	*steps = table;
+	*steps_number = n;
+
 	return 0;
 }
 
 /* no-OS specific */
-int jesd204_fsm_stop(struct jesd204_topology *topology, unsigned int link_idx)
+static int jesd204_fsm_prepare(struct jesd204_topology *topology)
+{
+	int ret;
+
+	if (topology->fsm_time_us)
+		return 0;
+
+	ret = jesd204_fsm_build(topology, false, &topology->fsm_init_steps,
+				&topology->fsm_init_steps_number);
+	if (ret)
+		return ret;
+
+	ret = jesd204_fsm_build(topology, true, &topology->fsm_uninit_steps,
+				&topology->fsm_uninit_steps_number);
+	if (ret)
+		goto free_init;
+
+	topology->fsm_time_us = no_os_calloc(__JESD204_MAX_OPS *
+					     (topology->devs_number + 1),
+					     sizeof(*topology->fsm_time_us));
+	if (!topology->fsm_time_us) {
+		ret = -ENOMEM;
+		goto free_uninit;
+	}
+
+	return 0;
+
+free_uninit:
+	no_os_free(topology->fsm_uninit_steps);
+	topology->fsm_uninit_steps = NULL;
+free_init:
+	no_os_free(topology->fsm_init_steps);
+	topology->fsm_init_steps = NULL;
+
+	return ret;
+}
+
+/* no-OS specific */
+static uint32_t jesd204_fsm_elapsed_us(struct no_os_time start)
+{
+	struct no_os_time now = no_os_get_time();
+
+	return (now.s - start.s) * 1000000 + now.us - start.us;
+}
+
+/* no-OS specific */
+static int jesd204_fsm_run_op(struct jesd204_topology *topology,
+			      enum jesd204_dev_op op,
+			      enum jesd204_state_op_reason reason)
 {
-	enum jesd204_state_op_reason reason = JESD204_STATE_OP_REASON_UNINIT;
 	struct jesd204_dev_top *jdev_top = topology->dev_top;
-	bool per_device_op_done[16];
-	int lnk_dev;
-	int lnk_id;
-	int dev;
+	const struct jesd204_state_op *state_op;
+	const struct jesd204_fsm_step *steps;
+	unsigned int steps_number;
+	struct jesd204_dev *jdev;
+	struct no_os_time start;
+	uint32_t *time_us;
+	unsigned int i;
+	int ret;
+
+	if (reason == JESD204_STATE_OP_REASON_INIT) {
+		steps = topology->fsm_init_steps;
+		steps_number = topology->fsm_init_steps_number;
+	} else {
+		steps = topology->fsm_uninit_steps;
+		steps_number = topology->fsm_uninit_steps_number;
+	}
+
+	time_us = &topology->fsm_time_us[op * (topology->devs_number + 1)];
+	if (reason == JESD204_STATE_OP_REASON_INIT)
+		memset(time_us, 0, (topology->devs_number + 1) * sizeof(*time_us));
+
+	for (i = 0; i < steps_number; i++) {
+		if (steps[i].dev == topology->devs_number)
+			jdev = jdev_top->jdev;
+		else
+			jdev = topology->devs[steps[i].dev].jdev;
+		state_op = &jdev->dev_data->state_ops[op];
+
+		if (steps[i].call == JESD204_FSM_PER_DEVICE && !state_op->per_device)
+			continue;
+		if (steps[i].call == JESD204_FSM_PER_LINK && !state_op->per_link)
+			continue;
+
+		start = no_os_get_time();
+
+		if (steps[i].call == JESD204_FSM_PER_DEVICE)
+			ret = state_op->per_device(jdev, reason);
+		else
+			ret = state_op->per_link(jdev, reason,
+						 &jdev_top->active_links[steps[i].lnk_id].link);
+
+		if (ret >= 0 && reason == JESD204_STATE_OP_REASON_INIT &&
+		    jdev == jdev_top->jdev && state_op->post_state_sysref)
+			ret = jesd204_sysref_async(jdev);
+
+		if (reason == JESD204_STATE_OP_REASON_INIT)
+			time_us[steps[i].dev] += jesd204_fsm_elapsed_us(start);
+
+		if (ret < 0) {
+			topology->fsm_err = ret == JESD204_STATE_CHANGE_ERROR ?
+					    -EIO : ret;
+			topology->fsm_err_op = op;
+			topology->fsm_err_dev = steps[i].dev;
+			return topology->fsm_err;
+		}
+	}
+
+	return 0;
+}
+
+/* no-OS specific */
+int jesd204_fsm_start_from(struct jesd204_topology *topology,
+			   unsigned int link_idx, enum jesd204_dev_op first_op)
+{
+	struct no_os_time start;
+	int op;
+	int ret;
+
+	if (!topology || first_op >= __JESD204_MAX_OPS)
+		return -EINVAL;
+
+	/* All the ops before the first one must have completed */
+	if (first_op > topology->fsm_ops_done)
+		return -EINVAL;
+
+	ret = jesd204_fsm_prepare(topology);
+	if (ret)
+		return ret;
+
+	start = no_os_get_time();
+	topology->fsm_err = 0;
+
+	/* Roll back the ops that already ran, down to the first one */
+	for (op = (int)topology->fsm_ops_done - 1; op >= (int)first_op; op--) {
+		ret = jesd204_fsm_run_op(topology, op,
+					 JESD204_STATE_OP_REASON_UNINIT);
+		if (ret)
+			goto out;
+		topology->fsm_ops_done = op;
+	}
+
+	for (op = first_op; op < __JESD204_MAX_OPS; op++) {
+		ret = jesd204_fsm_run_op(topology, op,
+					 JESD204_STATE_OP_REASON_INIT);
+		if (ret)
+			goto out;
+		topology->fsm_ops_done = op + 1;
+	}
+
+out:
+	topology->fsm_total_us = jesd204_fsm_elapsed_us(start);
+
+	return ret;
+}
+
+/* no-OS specific */
+int jesd204_fsm_start(struct jesd204_topology *topology, unsigned int link_idx)
+{
+	return jesd204_fsm_start_from(topology, link_idx, JESD204_OP_DEVICE_INIT);
+}
+
+/* no-OS specific */
+int jesd204_fsm_stop(struct jesd204_topology *topology, unsigned int link_idx)
+{
 	int op;
+	int ret;
+
+	if (!topology)
+		return -EINVAL;
+
+	ret = jesd204_fsm_prepare(topology);
+	if (ret)
+		return ret;
+
+	topology->fsm_err = 0;
 
 	for (op = __JESD204_MAX_OPS - 1; op >= 0; op--) {
-		for (dev = topology->devs_number - 1; dev >= 0 ; dev--)
-			per_device_op_done[dev] = false;
-
-		if (jdev_top->jdev->dev_data->state_ops[op].per_device)
-			jdev_top->jdev->dev_data->state_ops[op].per_device(jdev_top->jdev, reason);
-
-		for (lnk_id = jdev_top->num_links - 1; lnk_id >= 0; lnk_id--) {
-			if (jdev_top->jdev->dev_data->state_ops[op].per_link)
-				jdev_top->jdev->dev_data->state_ops[op].per_link(jdev_top->jdev, reason,
-						&jdev_top->active_links[lnk_id].link);
-			for (dev = topology->devs_number - 1; dev >= 0; dev--) {
-				for (lnk_dev = topology->devs[dev].links_number - 1; lnk_dev >= 0; lnk_dev--) {
-					if (topology->devs[dev].link_ids[lnk_dev] == jdev_top->link_ids[lnk_id]) {
-						if (topology->devs[dev].jdev->dev_data->state_ops[op].per_device
-						    && !per_device_op_done[dev]) {
-							topology->devs[dev].jdev->dev_data->state_ops[op].per_device(
-								topology->devs[dev].jdev, reason);
-							per_device_op_done[dev] = true;
-						}
-						if (topology->devs[dev].jdev->dev_data->state_ops[op].per_link)
-							topology->devs[dev].jdev->dev_data->state_ops[op].per_link(
-								topology->devs[dev].jdev, reason,
-								&jdev_top->active_links[lnk_id].link);
-					}
-				}
-			}
-		}
+		ret = jesd204_fsm_run_op(topology, op,
+					 JESD204_STATE_OP_REASON_UNINIT);
+		if (ret)
+			return ret;
+		if (topology->fsm_ops_done > (unsigned int)op)
+			topology->fsm_ops_done = op;
 	}
 
 	return 0;
 }
+
+/* no-OS specific */
+int jesd204_fsm_timing_show(struct jesd204_topology *topology, char *buf,
+			    uint32_t len)
+{
+	unsigned int cols;
+	unsigned int dev;
+	uint32_t total;
+	uint32_t pos;
+	int op;
+
+	if (!topology || !buf)
+		return -EINVAL;
+
+	if (!topology->fsm_time_us)
+		return snprintf(buf, len, "not started");
+
+	cols = topology->devs_number + 1;
+
+#define JESD204_FSM_PRINT(...) \
+	pos += snprintf(buf + no_os_min(pos, len), len - no_os_min(pos, len), \
+			__VA_ARGS__)
+
+	pos = 0;
+	JESD204_FSM_PRINT("%-24s%10s", "op [us]", "total");
+	for (dev = 0; dev < topology->devs_number; dev++)
+		JESD204_FSM_PRINT(" %8s%-2u", "dev", dev);
+	JESD204_FSM_PRINT(" %10s\n", "top");
+
+	for (op = 0; op < __JESD204_MAX_OPS; op++) {
+		total = 0;
+		for (dev = 0; dev < cols; dev++)
+			total += topology->fsm_time_us[op * cols + dev];
+
+		JESD204_FSM_PRINT("%-24s%10lu", jesd204_op_names[op],
+				  (unsigned long)total);
+		for (dev = 0; dev < cols; dev++)
+			JESD204_FSM_PRINT(" %10lu",
+					  (unsigned long)topology->fsm_time_us[op * cols + dev]);
+		JESD204_FSM_PRINT("\n");
+	}
+
+	JESD204_FSM_PRINT("last transition %lu us, %u/%u ops done",
+			  (unsigned long)topology->fsm_total_us,
+			  topology->fsm_ops_done, __JESD204_MAX_OPS);
+	if (topology->fsm_err && topology->fsm_err_dev == topology->devs_number)
+		JESD204_FSM_PRINT(", error %d in %s on top", topology->fsm_err,
+				  jesd204_op_names[topology->fsm_err_op]);
+	else if (topology->fsm_err)
+		JESD204_FSM_PRINT(", error %d in %s on dev%u", topology->fsm_err,
+				  jesd204_op_names[topology->fsm_err_op],
+				  topology->fsm_err_dev);
+
+#undef JESD204_FSM_PRINT
+
+	return no_os_min(pos, len ? len - 1 : 0);
+}
@@ -65,6 +65,24 @@ struct jesd204_dev_top {
 	struct jesd204_link_opaque	*active_links;
 };
 
+/* no-OS specific */
+enum jesd204_fsm_call {
+	JESD204_FSM_PER_DEVICE,
+	JESD204_FSM_PER_LINK,
+};
+
+/**
+ * struct jesd204_fsm_step - one callback of a JESD204 state transition
+ * @dev			index in the topology devices, devs_number for the top device
+ * @lnk_id		index in the active links of the top device (per_link only)
+ * @call		which of the op callbacks is called
+ */
+struct jesd204_fsm_step {
+	unsigned int			dev;
+	unsigned int			lnk_id;
+	enum jesd204_fsm_call		call;
+};
+
 struct jesd204_dev_top *jesd204_dev_get_topology_top_dev(
 	struct jesd204_dev *jdev);
 
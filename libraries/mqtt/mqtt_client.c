@@ -36,12 +36,78 @@
 #include "mqtt_client.h"
 #include "MQTTClient.h"
 #include "no_os_error.h"
+#include "no_os_util.h"
+
+#ifdef NO_OS_LWIP_NETWORKING
+#include "lwip_socket.h"
+#endif
 
 struct mqtt_desc {
 	MQTTClient		mqtt_client[1];
 	Network			network;
 };
 
+/* Size of the buffer used by the publisher to receive broker replies */
+#define MQTT_PUB_RX_LEN		128
+/* Fixed header (5) + topic length (2) + packet id (2) */
+#define MQTT_PUB_PKT_OVERHEAD	9
+
+enum mqtt_pub_slot_state {
+	MQTT_PUB_SLOT_FREE,
+	/* Encoded, waiting to be written to the socket */
+	MQTT_PUB_SLOT_QUEUED,
+	/* Written to the socket, waiting for a PUBACK */
+	MQTT_PUB_SLOT_INFLIGHT,
+};
+
+struct mqtt_pub_topic {
+	char			name[MQTT_PUB_MAX_TOPIC_LEN + 1];
+	uint8_t			sample_size;
+	uint16_t		count;
+	uint32_t		len;
+	uint8_t			*batch;
+};
+
+struct mqtt_pub_slot {
+	enum mqtt_pub_slot_state	state;
+	/* Set once the packet was sent and is waiting for a PUBACK */
+	bool			dup;
+	/* PUBACK received while the packet was being sent again */
+	bool			acked;
+	uint16_t		packet_id;
+	/* Queue order */
+	uint32_t		seq;
+	uint32_t		len;
+	uint32_t		sent;
+	Timer			retry;
+	uint8_t			*buf;
+};
+
+struct mqtt_pub_desc {
+	struct mqtt_desc	*mqtt;
+	enum mqtt_qos		qos;
+	uint32_t		max_payload;
+	uint32_t		flush_ms;
+	uint32_t		retry_ms;
+	uint8_t			max_inflight;
+	uint8_t			inflight;
+	struct mqtt_pub_topic	*topics;
+	uint32_t		max_topics;
+	uint32_t		nb_topics;
+	struct mqtt_pub_slot	*slots;
+	uint32_t		queue_len;
+	uint32_t		slot_size;
+	uint32_t		next_seq;
+	/* Slot partially written to the socket */
+	struct mqtt_pub_slot	*tx;
+	uint8_t			rx_buf[MQTT_PUB_RX_LEN];
+	uint32_t		rx_len;
+	/* Bytes of an oversized packet still to be discarded */
+	uint32_t		rx_skip;
+	Timer			ping;
+	struct mqtt_pub_stats	stats;
+};
+
 /* TODO: After initial commit, modify MQTT to support context to enable handler
  * for multiple clients */
 static void (*app_handler)(struct mqtt_message_data *);
@@ -271,3 +337,631 @@ int32_t mqtt_yield(struct mqtt_desc *desc, uint32_t timeout_ms)
 {
 	return MQTTYield(desc->mqtt_client, timeout_ms);
 }
+
+/* Get the next packet identifier of the client session, as Paho does */
+static uint16_t mqtt_pub_next_packet_id(struct mqtt_desc *mqtt)
+{
+	MQTTClient *c = mqtt->mqtt_client;
+
+	c->next_packetid = (c->next_packetid == MAX_PACKET_ID) ?
+			   1 : c->next_packetid + 1;
+
+	return c->next_packetid;
+}
+
+/* Restart the keep alive countdown after a packet was written */
+static void mqtt_pub_sent(struct mqtt_pub_desc *desc)
+{
+	MQTTClient *c = desc->mqtt->mqtt_client;
+
+	TimerCountdown(&c->last_sent, c->keepAliveInterval);
+	TimerCountdown(&desc->ping, c->keepAliveInterval);
+}
+
+/**
+ * @brief Initialize the MQTT publisher
+ *
+ * The publisher groups the samples of each topic in batches and publishes a
+ * batch when it is full or older than \ref mqtt_pub_init_param.flush_ms. At
+ * QoS1 up to \ref mqtt_pub_init_param.max_inflight packets are sent before
+ * waiting for the first PUBACK. While the publisher is in use,
+ * \ref mqtt_pub_step should be called from the main loop instead of
+ * \ref mqtt_yield, since it also dispatches the received messages and keeps
+ * the connection alive.
+ * @param desc - Address where to store the publisher reference
+ * @param param - Parameter used to configure the publisher
+ * @return 0 in case of success, negative error code otherwise
+ */
+int mqtt_pub_init(struct mqtt_pub_desc **desc,
+		  struct mqtt_pub_init_param *param)
+{
+	struct mqtt_pub_desc	*ldesc;
+	uint32_t		i;
+
+	if (!desc || !param || !param->mqtt)
+		return -EINVAL;
+
+	if (param->qos > MQTT_QOS1 || !param->max_topics || !param->queue_len ||
+	    param->max_payload <= MQTT_PUB_BATCH_HDR_LEN)
+		return -EINVAL;
+
+	if (param->qos == MQTT_QOS1 && (!param->max_inflight ||
+					param->max_inflight > MQTT_PUB_MAX_INFLIGHT))
+		return -EINVAL;
+
+	ldesc = (struct mqtt_pub_desc *)calloc(1, sizeof(*ldesc));
+	if (!ldesc)
+		return -ENOMEM;
+
+	ldesc->mqtt = param->mqtt;
+	ldesc->qos = param->qos;
+	ldesc->max_payload = param->max_payload;
+	ldesc->flush_ms = param->flush_ms;
+	ldesc->retry_ms = param->retry_ms;
+	ldesc->max_inflight = param->max_inflight;
+	ldesc->max_topics = param->max_topics;
+	ldesc->queue_len = param->queue_len;
+	ldesc->slot_size = MQTT_PUB_PKT_OVERHEAD + MQTT_PUB_MAX_TOPIC_LEN +
+			   param->max_payload;
+
+	ldesc->topics = (struct mqtt_pub_topic *)calloc(param->max_topics,
+			sizeof(*ldesc->topics));
+	if (!ldesc->topics)
+		goto error;
+
+	ldesc->slots = (struct mqtt_pub_slot *)calloc(param->queue_len,
+			sizeof(*ldesc->slots));
+	if (!ldesc->slots)
+		goto error;
+
+	/* The batches and the queued packets are carved from single blocks */
+	ldesc->topics[0].batch = (uint8_t *)calloc(param->max_topics,
+				 param->max_payload);
+	if (!ldesc->topics[0].batch)
+		goto error;
+
+	ldesc->slots[0].buf = (uint8_t *)calloc(param->queue_len,
+						ldesc->slot_size);
+	if (!ldesc->slots[0].buf)
+		goto error;
+
+	for (i = 1; i < param->max_topics; i++)
+		ldesc->topics[i].batch = ldesc->topics[0].batch +
+					 i * param->max_payload;
+
+	for (i = 1; i < param->queue_len; i++)
+		ldesc->slots[i].buf = ldesc->slots[0].buf + i * ldesc->slot_size;
+
+	TimerCountdown(&ldesc->ping, ldesc->mqtt->mqtt_client->keepAliveInterval);
+
+	*desc = ldesc;
+
+	return 0;
+
+error:
+	mqtt_pub_remove(ldesc);
+
+	return -ENOMEM;
+}
+
+/**
+ * @brief Remove MQTT publisher resources
+ *
+ * Queued and unacknowledged packets are discarded.
+ * @param desc - Reference to MQTT publisher
+ * @return 0 in case of success, negative error code otherwise
+ */
+int mqtt_pub_remove(struct mqtt_pub_desc *desc)
+{
+	if (!desc)
+		return -EINVAL;
+
+	if (desc->slots)
+		free(desc->slots[0].buf);
+	if (desc->topics)
+		free(desc->topics[0].batch);
+	free(desc->slots);
+	free(desc->topics);
+	free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Register a topic with the publisher
+ * @param desc - Reference to MQTT publisher
+ * @param topic - Topic name, without wildcards
+ * @param sample_size - Size of a sample published on this topic
+ * @param id - Address where to store the identifier used by
+ * \ref mqtt_pub_sample
+ * @return 0 in case of success, negative error code otherwise
+ */
+int mqtt_pub_add_topic(struct mqtt_pub_desc *desc, const char *topic,
+		       uint8_t sample_size, uint32_t *id)
+{
+	struct mqtt_pub_topic *t;
+
+	if (!desc || !topic || !id || !sample_size)
+		return -EINVAL;
+
+	if (strlen(topic) > MQTT_PUB_MAX_TOPIC_LEN ||
+	    sample_size > desc->max_payload - MQTT_PUB_BATCH_HDR_LEN)
+		return -EINVAL;
+
+	if (desc->nb_topics == desc->max_topics)
+		return -ENOMEM;
+
+	t = &desc->topics[desc->nb_topics];
+	strcpy(t->name, topic);
+	t->sample_size = sample_size;
+	t->count = 0;
+	t->len = MQTT_PUB_BATCH_HDR_LEN;
+
+	*id = desc->nb_topics++;
+
+	return 0;
+}
+
+/* Encode the batch of a topic as a PUBLISH packet in a free queue slot */
+static int mqtt_pub_close_batch(struct mqtt_pub_desc *desc,
+				struct mqtt_pub_topic *t)
+{
+	MQTTString		topic_name = MQTTString_initializer;
+	struct mqtt_pub_slot	*slot = NULL;
+	uint32_t		queued = 0;
+	uint32_t		i;
+	int			len;
+
+	if (!t->count)
+		return 0;
+
+	for (i = 0; i < desc->queue_len; i++) {
+		if (desc->slots[i].state != MQTT_PUB_SLOT_FREE)
+			queued++;
+		else if (!slot)
+			slot = &desc->slots[i];
+	}
+
+	if (!slot)
+		return -EAGAIN;
+
+	t->batch[0] = MQTT_PUB_BATCH_FORMAT;
+	t->batch[1] = t->sample_size;
+	no_os_put_unaligned_le16(t->count, &t->batch[2]);
+
+	slot->packet_id = 0;
+	if (desc->qos == MQTT_QOS1)
+		slot->packet_id = mqtt_pub_next_packet_id(desc->mqtt);
+
+	topic_name.cstring = t->name;
+	len = MQTTSerialize_publish(slot->buf, desc->slot_size, 0, desc->qos, 0,
+				    slot->packet_id, topic_name, t->batch,
+				    t->len);
+	if (len <= 0)
+		return -EINVAL;
+
+	slot->len = len;
+	slot->sent = 0;
+	slot->dup = false;
+	slot->acked = false;
+	slot->seq = desc->next_seq++;
+	slot->state = MQTT_PUB_SLOT_QUEUED;
+
+	desc->stats.max_queued = no_os_max(desc->stats.max_queued, queued + 1);
+
+	t->count = 0;
+	t->len = MQTT_PUB_BATCH_HDR_LEN;
+
+	return 0;
+}
+
+/**
+ * @brief Add a sample to the batch of a topic
+ *
+ * The batch is queued for publishing once it is full. When the outbound
+ * queue has no room for a full batch, the sample is dropped.
+ * @param desc - Reference to MQTT publisher
+ * @param id - Topic identifier returned by \ref mqtt_pub_add_topic
+ * @param sample - Sample of the size given at registration
+ * @return 0 in case of success, -EAGAIN if the sample was dropped, other
+ * negative error code otherwise
+ */
+int mqtt_pub_sample(struct mqtt_pub_desc *desc, uint32_t id,
+		    const void *sample)
+{
+	struct mqtt_pub_topic	*t;
+	uint32_t		now;
+	int			ret;
+
+	if (!desc || !sample || id >= desc->nb_topics)
+		return -EINVAL;
+
+	t = &desc->topics[id];
+	if (t->len + t->sample_size > desc->max_payload) {
+		ret = mqtt_pub_close_batch(desc, t);
+		if (ret) {
+			desc->stats.dropped++;
+			return ret;
+		}
+	}
+
+	now = mqtt_timer_get_ms();
+	if (!t->count)
+		no_os_put_unaligned_le32(now, &t->batch[4]);
+	no_os_put_unaligned_le32(now, &t->batch[8]);
+
+	memcpy(&t->batch[t->len], sample, t->sample_size);
+	t->len += t->sample_size;
+	t->count++;
+	desc->stats.samples++;
+
+	/* Queue it right away if the next sample won't fit */
+	if (t->len + t->sample_size > desc->max_payload)
+		mqtt_pub_close_batch(desc, t);
+
+	return 0;
+}
+
+/**
+ * @brief Queue the open batches for publishing
+ *
+ * The packets are written to the socket by \ref mqtt_pub_step.
+ * @param desc - Reference to MQTT publisher
+ * @return 0 in case of success, -EAGAIN if the outbound queue is full
+ */
+int mqtt_pub_flush(struct mqtt_pub_desc *desc)
+{
+	uint32_t	i;
+	int		ret;
+
+	if (!desc)
+		return -EINVAL;
+
+	for (i = 0; i < desc->nb_topics; i++) {
+		ret = mqtt_pub_close_batch(desc, &desc->topics[i]);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+/* Queue the batches older than flush_ms */
+static void mqtt_pub_flush_aged(struct mqtt_pub_desc *desc)
+{
+	struct mqtt_pub_topic	*t;
+	uint32_t		now;
+	uint32_t		i;
+
+	now = mqtt_timer_get_ms();
+	for (i = 0; i < desc->nb_topics; i++) {
+		t = &desc->topics[i];
+		if (t->count &&
+		    now - no_os_get_unaligned_le32(&t->batch[4]) >= desc->flush_ms)
+			mqtt_pub_close_batch(desc, t);
+	}
+}
+
+/* Pick the oldest queued packet allowed to be sent */
+static struct mqtt_pub_slot *mqtt_pub_next_tx(struct mqtt_pub_desc *desc)
+{
+	struct mqtt_pub_slot	*slot;
+	struct mqtt_pub_slot	*next = NULL;
+	uint32_t		i;
+
+	for (i = 0; i < desc->queue_len; i++) {
+		slot = &desc->slots[i];
+
+		if (slot->state == MQTT_PUB_SLOT_INFLIGHT &&
+		    TimerIsExpired(&slot->retry)) {
+			/* Send it again, with the DUP flag set */
+			slot->buf[0] |= 0x08;
+			slot->sent = 0;
+			slot->state = MQTT_PUB_SLOT_QUEUED;
+			desc->stats.retries++;
+		}
+
+		if (slot->state != MQTT_PUB_SLOT_QUEUED)
+			continue;
+
+		/* Retransmissions don't take an additional inflight slot */
+		if (desc->qos == MQTT_QOS1 && !slot->dup &&
+		    desc->inflight >= desc->max_inflight)
+			continue;
+
+		if (!next || (int32_t)(slot->seq - next->seq) < 0)
+			next = slot;
+	}
+
+	return next;
+}
+
+/* Write queued packets until the socket would block */
+static int mqtt_pub_tx(struct mqtt_pub_desc *desc)
+{
+	struct tcp_socket_desc	*sock = desc->mqtt->network.sock;
+	struct mqtt_pub_slot	*slot;
+	int32_t			ret;
+
+	while (true) {
+		slot = desc->tx ? desc->tx : mqtt_pub_next_tx(desc);
+		if (!slot)
+			return 0;
+
+		ret = socket_send(sock, slot->buf + slot->sent,
+				  slot->len - slot->sent);
+		if (ret == -EAGAIN || ret == 0) {
+			desc->tx = slot;
+			return 0;
+		}
+		if (ret < 0)
+			return ret;
+
+		slot->sent += ret;
+		desc->stats.bytes += ret;
+		if (slot->sent < slot->len) {
+			desc->tx = slot;
+			return 0;
+		}
+
+		desc->tx = NULL;
+		mqtt_pub_sent(desc);
+
+		if (!slot->dup)
+			desc->stats.packets++;
+
+		if (desc->qos == MQTT_QOS0 || slot->acked) {
+			slot->state = MQTT_PUB_SLOT_FREE;
+			continue;
+		}
+
+		if (!slot->dup) {
+			slot->dup = true;
+			desc->inflight++;
+		}
+		TimerCountdownMS(&slot->retry, desc->retry_ms);
+		slot->state = MQTT_PUB_SLOT_INFLIGHT;
+	}
+}
+
+/* Handle a complete packet received from the broker */
+static int mqtt_pub_handle(struct mqtt_pub_desc *desc, uint8_t *buf,
+			   uint32_t len)
+{
+	MQTTClient		*c = desc->mqtt->mqtt_client;
+	struct mqtt_pub_slot	*slot;
+	MQTTString		topic_name;
+	MQTTMessage		msg;
+	MessageData		data;
+	uint8_t			type, dup;
+	uint16_t		packet_id;
+	uint8_t			ack[4];
+	uint32_t		i;
+	int			payload_len;
+	int			qos;
+
+	switch (buf[0] >> 4) {
+	case PUBACK:
+		if (MQTTDeserialize_ack(&type, &dup, &packet_id, buf, len) != 1)
+			return -EINVAL;
+
+		for (i = 0; i < desc->queue_len; i++) {
+			slot = &desc->slots[i];
+			if (slot->state == MQTT_PUB_SLOT_FREE || !slot->dup ||
+			    slot->acked || slot->packet_id != packet_id)
+				continue;
+
+			desc->inflight--;
+			desc->stats.acked++;
+
+			/* Let a partially written retransmission complete */
+			if (desc->tx == slot)
+				slot->acked = true;
+			else
+				slot->state = MQTT_PUB_SLOT_FREE;
+			break;
+		}
+
+		return 0;
+	case PINGRESP:
+		c->ping_outstanding = 0;
+
+		return 0;
+	case PUBLISH:
+		if (MQTTDeserialize_publish(&msg.dup, &qos, &msg.retained, &msg.id,
+					    &topic_name, (uint8_t **)&msg.payload,
+					    &payload_len, buf, len) != 1)
+			return -EINVAL;
+
+		msg.qos = (enum QoS)qos;
+		msg.payloadlen = payload_len;
+		if (app_handler) {
+			data.message = &msg;
+			data.topicName = &topic_name;
+			mqtt_default_message_handler(&data);
+		}
+
+		if (qos == QOS1) {
+			i = MQTTSerialize_puback(ack, sizeof(ack), msg.id);
+			socket_send(desc->mqtt->network.sock, ack, i);
+		}
+
+		return 0;
+	default:
+		return 0;
+	}
+}
+
+/*
+ * Decode the fixed header at the start of the receive buffer.
+ * Returns the size of the fixed header, 0 if more bytes are needed, or a
+ * negative error code for a malformed length.
+ */
+static int mqtt_pub_decode_hdr(struct mqtt_pub_desc *desc, uint32_t *rem_len)
+{
+	uint32_t	mult = 1;
+	uint32_t	i;
+
+	*rem_len = 0;
+	for (i = 1; i < desc->rx_len; i++) {
+		if (i > 4)
+			return -EINVAL;
+
+		*rem_len += (desc->rx_buf[i] & 0x7F) * mult;
+		if (!(desc->rx_buf[i] & 0x80))
+			return i + 1;
+
+		mult <<= 7;
+	}
+
+	return 0;
+}
+
+/* Read and handle the packets received from the broker */
+static int mqtt_pub_rx(struct mqtt_pub_desc *desc)
+{
+	struct tcp_socket_desc	*sock = desc->mqtt->network.sock;
+	uint32_t		rem_len, pkt_len, skip;
+	int32_t			ret;
+
+	while (true) {
+		ret = socket_recv(sock, desc->rx_buf + desc->rx_len,
+				  MQTT_PUB_RX_LEN - desc->rx_len);
+		if (ret == -EAGAIN || ret == 0)
+			return 0;
+		if (ret < 0)
+			return ret;
+
+		if (desc->rx_skip) {
+			skip = no_os_min((uint32_t)ret, desc->rx_skip);
+			desc->rx_skip -= skip;
+			ret -= skip;
+			memmove(desc->rx_buf + desc->rx_len,
+				desc->rx_buf + desc->rx_len + skip, ret);
+		}
+		desc->rx_len += ret;
+
+		while (true) {
+			ret = mqtt_pub_decode_hdr(desc, &rem_len);
+			if (ret < 0)
+				return ret;
+			if (!ret)
+				break;
+
+			pkt_len = ret + rem_len;
+			if (pkt_len > MQTT_PUB_RX_LEN) {
+				/* Doesn't fit, discard it */
+				desc->rx_skip = pkt_len - desc->rx_len;
+				desc->rx_len = 0;
+				break;
+			}
+
+			if (pkt_len > desc->rx_len)
+				break;
+
+			ret = mqtt_pub_handle(desc, desc->rx_buf, pkt_len);
+			if (ret)
+				return ret;
+
+			desc->rx_len -= pkt_len;
+			memmove(desc->rx_buf, desc->rx_buf + pkt_len, desc->rx_len);
+		}
+	}
+}
+
+/* Send a PINGREQ if nothing was sent for a keep alive interval */
+static int mqtt_pub_keep_alive(struct mqtt_pub_desc *desc)
+{
+	MQTTClient	*c = desc->mqtt->mqtt_client;
+	uint8_t		buf[2];
+	int32_t		ret;
+	int		len;
+
+	if (!c->keepAliveInterval || !TimerIsExpired(&desc->ping))
+		return 0;
+
+	if (c->ping_outstanding)
+		return -ENOTCONN;
+
+	len = MQTTSerialize_pingreq(buf, sizeof(buf));
+	ret = socket_send(c->ipstack->sock, buf, len);
+	if (ret == -EAGAIN)
+		return 0;
+	if (ret < 0)
+		return ret;
+
+	c->ping_outstanding = 1;
+	mqtt_pub_sent(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Send queued packets and process the broker replies, without blocking
+ *
+ * Publishes the batches older than \ref mqtt_pub_init_param.flush_ms, writes
+ * the queued packets until the socket would block, handles the PUBACKs and
+ * the incoming messages and sends the keep alive pings.
+ * @param desc - Reference to MQTT publisher
+ * @return 0 in case of success, negative error code otherwise
+ */
+int mqtt_pub_step(struct mqtt_pub_desc *desc)
+{
+	int ret;
+
+	if (!desc)
+		return -EINVAL;
+
+#ifdef NO_OS_LWIP_NETWORKING
+	no_os_lwip_step(desc->mqtt->network.sock->net->net, NULL);
+#endif
+
+	ret = mqtt_pub_rx(desc);
+	if (ret)
+		return ret;
+
+	mqtt_pub_flush_aged(desc);
+
+	ret = mqtt_pub_tx(desc);
+	if (ret)
+		return ret;
+
+	return mqtt_pub_keep_alive(desc);
+}
+
+/**
+ * @brief Get the number of packets queued or waiting for a PUBACK
+ * @param desc - Reference to MQTT publisher
+ * @return Number of packets. Samples in open batches are not counted.
+ */
+uint32_t mqtt_pub_pending(struct mqtt_pub_desc *desc)
+{
+	uint32_t pending = 0;
+	uint32_t i;
+
+	if (!desc)
+		return 0;
+
+	for (i = 0; i < desc->queue_len; i++)
+		if (desc->slots[i].state != MQTT_PUB_SLOT_FREE)
+			pending++;
+
+	return pending;
+}
+
+/**
+ * @brief Get the publisher counters
+ * @param desc - Reference to MQTT publisher
+ * @param stats - Address where to store the counters
+ * @return 0 in case of success, negative error code otherwise
+ */
+int mqtt_pub_get_stats(struct mqtt_pub_desc *desc,
+		       struct mqtt_pub_stats *stats)
+{
+	if (!desc || !stats)
+		return -EINVAL;
+
+	*stats = desc->stats;
+
+	return 0;
+}
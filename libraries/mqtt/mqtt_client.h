@@ -224,6 +224,74 @@ struct mqtt_init_param {
  */
 struct mqtt_desc;
 
+/** Maximum number of QoS1 publish packets waiting for a PUBACK */
+#define MQTT_PUB_MAX_INFLIGHT		8
+/** Maximum length of a topic handled by the publisher */
+#define MQTT_PUB_MAX_TOPIC_LEN		64
+/** Format byte of a batched payload */
+#define MQTT_PUB_BATCH_FORMAT		1
+/**
+ * Size of the header of a batched payload:
+ * - byte 0: \ref MQTT_PUB_BATCH_FORMAT
+ * - byte 1: size of a sample
+ * - bytes 2..3: number of samples, little endian
+ * - bytes 4..7: timestamp of the first sample in ms, little endian
+ * - bytes 8..11: timestamp of the last sample in ms, little endian
+ *
+ * The samples follow the header back to back, as they were added.
+ */
+#define MQTT_PUB_BATCH_HDR_LEN		12
+
+/**
+ * @struct mqtt_pub_init_param
+ * @brief Parameter used to initialize an MQTT publisher
+ */
+struct mqtt_pub_init_param {
+	/** Reference to a connected MQTT client */
+	struct mqtt_desc	*mqtt;
+	/** Quality of service of the published batches: QOS0 or QOS1 */
+	enum mqtt_qos		qos;
+	/** Maximum number of topics */
+	uint32_t		max_topics;
+	/** Size of a batched payload, including the batch header */
+	uint32_t		max_payload;
+	/** Number of packets the outbound queue can hold */
+	uint32_t		queue_len;
+	/** QoS1 packets sent before waiting for a PUBACK */
+	uint8_t			max_inflight;
+	/** Maximum age of a batch before it is published, in ms */
+	uint32_t		flush_ms;
+	/** Time after which an unacknowledged packet is sent again, in ms */
+	uint32_t		retry_ms;
+};
+
+/**
+ * @struct mqtt_pub_stats
+ * @brief Publisher counters
+ */
+struct mqtt_pub_stats {
+	/** Samples added to a batch */
+	uint32_t	samples;
+	/** Samples dropped because the outbound queue was full */
+	uint32_t	dropped;
+	/** Packets written to the socket, retransmissions excluded */
+	uint32_t	packets;
+	/** Bytes written to the socket */
+	uint32_t	bytes;
+	/** QoS1 packets acknowledged by the broker */
+	uint32_t	acked;
+	/** QoS1 packets sent again after \ref mqtt_pub_init_param.retry_ms */
+	uint32_t	retries;
+	/** Highest number of packets held by the outbound queue */
+	uint32_t	max_queued;
+};
+
+/**
+ * @struct mqtt_pub_desc
+ * @brief Reference to MQTT publisher
+ */
+struct mqtt_pub_desc;
+
 /* Init MQTT client */
 int32_t mqtt_init(struct mqtt_desc **desc,
 		  struct mqtt_init_param *param);
@@ -248,4 +316,25 @@ int32_t mqtt_unsubscribe(struct mqtt_desc *desc, const char *topic);
 /* Allow messages to be received */
 int32_t mqtt_yield(struct mqtt_desc *desc, uint32_t timeout_ms);
 
+/* Init MQTT publisher */
+int mqtt_pub_init(struct mqtt_pub_desc **desc,
+		  struct mqtt_pub_init_param *param);
+/* Uninit MQTT publisher */
+int mqtt_pub_remove(struct mqtt_pub_desc *desc);
+/* Register a topic with the publisher */
+int mqtt_pub_add_topic(struct mqtt_pub_desc *desc, const char *topic,
+		       uint8_t sample_size, uint32_t *id);
+/* Add a sample to the batch of a topic */
+int mqtt_pub_sample(struct mqtt_pub_desc *desc, uint32_t id,
+		    const void *sample);
+/* Queue the open batches for publishing */
+int mqtt_pub_flush(struct mqtt_pub_desc *desc);
+/* Send queued packets and process the broker replies, without blocking */
+int mqtt_pub_step(struct mqtt_pub_desc *desc);
+/* Get the number of packets queued or waiting for a PUBACK */
+uint32_t mqtt_pub_pending(struct mqtt_pub_desc *desc);
+/* Get the publisher counters */
+int mqtt_pub_get_stats(struct mqtt_pub_desc *desc,
+		       struct mqtt_pub_stats *stats);
+
 #endif
@@ -82,6 +82,16 @@ void mqtt_timer_remove()
 	}
 }
 
+/* Get the current value of the timer used by the functions */
+uint32_t mqtt_timer_get_ms(void)
+{
+	uint32_t ms = 0;
+
+	no_os_timer_counter_get(timer, &ms);
+
+	return ms;
+}
+
 /* Implementation of TimerInit used by MQTTClient.c */
 void TimerInit(Timer* t)
 {
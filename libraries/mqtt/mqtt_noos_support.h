@@ -73,6 +73,8 @@ struct network_port_noos {
 int32_t mqtt_timer_init(struct no_os_timer_init_param *timer_init_param);
 /* Uninit porting file */
 void mqtt_timer_remove();
+/* Get the current value of the porting timer, in ms */
+uint32_t mqtt_timer_get_ms(void);
 
 /* Function to be linked to Network.mqttread */
 int mqtt_noos_read(Network*, unsigned char*, int, int);
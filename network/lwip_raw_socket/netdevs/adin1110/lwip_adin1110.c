@@ -60,34 +60,33 @@
 static uint8_t lwip_buff[ADIN1110_LWIP_BUFF_SIZE];
 
 /**
- * @brief Read a frame from the RX FIFO.
- * @param desc - ADIN1110 descriptor.
- * @param p - the received pbuf.
+ * @brief Pass a frame received from the RX FIFO to the network interface.
+ * @param ctx - netif to RX data.
+ * @param frame - the received frame.
  * @param len - length of the frame.
  * @return 0 in case of success, negative error otherwise.
  */
-static int adin1110_read_frames(struct adin1110_desc *desc, struct pbuf **p,
-				uint32_t *len)
+static int adin1110_rx_frame(void *ctx, uint8_t *frame, uint32_t len)
 {
-	struct adin1110_eth_buff mac_buff = {0};
+	struct netif *netif_desc = ctx;
+	struct pbuf *p;
 	int ret;
 
-	mac_buff.payload = &lwip_buff[ADIN1110_ETH_HDR_LEN];
-
-	ret = adin1110_read_fifo(desc, 0, &mac_buff);
-	if (ret)
-		return ret;
-
-	*len = mac_buff.len;
-	if (!mac_buff.len)
+	if (!len)
 		return 0;
 
-	memcpy(lwip_buff, mac_buff.mac_dest, ADIN1110_ETH_HDR_LEN);
-	*p = pbuf_alloc(PBUF_RAW, mac_buff.len, PBUF_POOL);
-	if (!*p)
+	p = pbuf_alloc(PBUF_RAW, len, PBUF_POOL);
+	if (!p)
 		return -ENOMEM;
 
-	pbuf_take(*p, lwip_buff, mac_buff.len);
+	pbuf_take(p, frame, len);
+
+	LINK_STATS_INC(link.recv);
+	ret = netif_desc->input(p, netif_desc);
+	if (ret) {
+		if (p->ref)
+			pbuf_free(p);
+	}
 
 	return 0;
 }
@@ -100,31 +99,8 @@ static int adin1110_read_frames(struct adin1110_desc *desc, struct pbuf **p,
  */
 static int32_t adin1110_step(struct lwip_network_desc *desc, void *data)
 {
-	struct adin1110_desc *mac_desc;
-	struct netif *netif_desc;
-	struct pbuf *p;
-	uint32_t len;
-	int ret;
-
-	netif_desc = desc->lwip_netif;
-	mac_desc = desc->mac_desc;
-
-	do {
-		ret = adin1110_read_frames(mac_desc, &p, &len);
-		if (ret)
-			return ret;
-
-		if (len) {
-			LINK_STATS_INC(link.recv);
-			ret = netif_desc->input(p, netif_desc);
-			if (ret) {
-				if (p->ref)
-					pbuf_free(p);
-			}
-		}
-	} while(len);
-
-	return 0;
+	return adin1110_read_fifo_all(desc->mac_desc, 0, adin1110_rx_frame,
+				      desc->lwip_netif, NULL);
 }
 
 /**
@@ -135,23 +111,30 @@ static int32_t adin1110_step(struct lwip_network_desc *desc, void *data)
  */
 static int32_t adin1110_netif_output(struct netif *net, struct pbuf *p)
 {
+	struct adin1110_tx_seg segs[ADIN1110_TX_MAX_SEGS];
 	struct lwip_network_desc *lwip_desc;
 	struct adin1110_desc *mac_desc;
-	struct adin1110_eth_buff buff;
-	uint32_t frame_len;
+	uint32_t num_segs = 0;
+	struct pbuf *q;
 
 	lwip_desc = net->state;
 	mac_desc = lwip_desc->mac_desc;
 
 	LINK_STATS_INC(link.xmit);
-	frame_len = pbuf_copy_partial(p, lwip_buff, p->tot_len, 0);
 
-	memcpy(&buff.mac_dest, lwip_buff, ADIN1110_ETH_HDR_LEN);
+	/* Send the pbuf chain in place, unless it has too many segments */
+	for (q = p; q && num_segs < ADIN1110_TX_MAX_SEGS; q = q->next) {
+		segs[num_segs].buff = q->payload;
+		segs[num_segs++].len = q->len;
+	}
 
-	buff.len = frame_len;
-	buff.payload = &lwip_buff[ADIN1110_ETH_HDR_LEN];
+	if (q) {
+		segs[0].buff = lwip_buff;
+		segs[0].len = pbuf_copy_partial(p, lwip_buff, p->tot_len, 0);
+		num_segs = 1;
+	}
 
-	return adin1110_write_fifo(mac_desc, 0, &buff);
+	return adin1110_write_fifo_sg(mac_desc, 0, segs, num_segs);
 }
 
 /**
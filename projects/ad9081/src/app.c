@@ -58,6 +58,7 @@
 #include "iio_app.h"
 #include "iio_axi_adc.h"
 #include "iio_axi_dac.h"
+#include "iio_jesd204_fsm.h"
 #include "xilinx_uart.h"
 #endif
 
@@ -443,7 +444,9 @@ int main(void)
 	jesd204_topology_init(&topology, devs,
 			      sizeof(devs) / sizeof(*devs));
 
-	jesd204_fsm_start(topology, JESD204_LINKS_ALL);
+	status = jesd204_fsm_start(topology, JESD204_LINKS_ALL);
+	if (status)
+		printf("jesd204_fsm_start() error: %" PRId32 "\n", status);
 
 	axi_jesd204_rx_watchdog(rx_jesd);
 
@@ -544,7 +547,9 @@ int main(void)
 
 	struct iio_app_device devices[] = {
 		IIO_APP_DEVICE("axi_adc", iio_axi_adc_desc, adc_dev_desc, &read_buff, NULL, NULL),
-		IIO_APP_DEVICE("axi_dac", iio_axi_dac_desc, dac_dev_desc, NULL, &write_buff, NULL)
+		IIO_APP_DEVICE("axi_dac", iio_axi_dac_desc, dac_dev_desc, NULL, &write_buff, NULL),
+		IIO_APP_DEVICE("jesd204-fsm", topology, &jesd204_fsm_iio_descriptor,
+			       NULL, NULL, NULL)
 	};
 
 	app_init_param.devices = devices;
@@ -32,6 +32,7 @@
  * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 *******************************************************************************/
 
+#include <inttypes.h>
 #include "xil_cache.h"
 #include "xparameters.h"
 #include "axi_adc_core.h"
@@ -50,6 +51,28 @@
 
 #include "no_os_print_log.h"
 
+#ifdef NO_OS_DLOG
+#include "no_os_dlog.h"
+
+/* Ring of the deferred log, in 32 bit words */
+#define DLOG_RING_SIZE	1024
+
+static uint32_t dlog_ring[DLOG_RING_SIZE];
+#endif
+
+/**
+ * @struct delay_cal_record
+ * @brief Lane delay calibration kept in DDR at DELAY_CAL_BASEADDR. The DDR
+ * content is retained across a processor reset or a reload of the program, so
+ * the next boot restores the lane delays instead of searching them again.
+ */
+struct delay_cal_record {
+	/** Validated by axi_adc_delay_calibrate_cached() */
+	struct axi_adc_delay_cal cal;
+	/** Duration of the full calibration, in us */
+	uint32_t full_us;
+};
+
 /***************************************************************************//**
 * @brief main
 *******************************************************************************/
@@ -98,6 +121,32 @@ int main(void)
 	};
 	struct ad9434_dev *ad9434_device;
 
+	/* Per-lane interface delays, reused on the next boot if still valid */
+	struct delay_cal_record *delay_cal =
+		(struct delay_cal_record *)DELAY_CAL_BASEADDR;
+	struct axi_adc_delay_cal_report delay_cal_report;
+	struct axi_adc_delay_cal_param delay_cal_param = {
+		.sel = AXI_ADC_PN9,
+		.board_id = 0,
+	};
+
+#ifdef NO_OS_DLOG
+	struct no_os_dlog_init_param dlog_param = {
+		.buffer = dlog_ring,
+		.size = DLOG_RING_SIZE,
+		.level = NO_OS_LOG_LEVEL,
+	};
+
+	/*
+	 * The pr_* messages, including the ones of the delay calibration and
+	 * of the DMA transfers, are only recorded and printed by
+	 * no_os_dlog_flush().
+	 */
+	status = no_os_dlog_init(&dlog_param);
+	if (status)
+		return status;
+#endif
+
 	/* Instruction cache should be enabled for usleep functions to work. */
 	/* Enable the instruction cache. */
 	Xil_ICacheEnable();
@@ -107,44 +156,60 @@ int main(void)
 	status = ad9434_setup(&ad9434_device, ad9434_param);
 	if (status != 0) {
 		pr_info("ad9434_setup() failed!\n");
-		return -1;
+		goto error;
 	}
 
 	status = axi_adc_init(&ad9434_core,  &ad9434_core_param);
 	if (status != 0) {
 		pr_info("axi_adc_init() error: %s\n", ad9434_core->name);
-		return -1;
+		goto error;
 	}
 
 	status = axi_dmac_init(&ad9434_dmac, &ad9434_dmac_param);
 	if (status != 0) {
 		pr_info("axi_dmac_init() error: %s\n", ad9434_dmac->name);
-		return -1;
+		goto error;
 	}
 
 	status = ad9434_testmode_set(ad9434_device, TESTMODE_PN9_SEQ);
 	if (status != 0) {
 		pr_info("ad9434_testmode_set() PN9_SEQ failed!");
-		return -1;
+		goto error;
 	}
 
-	status = axi_adc_delay_calibrate(ad9434_core, nr_of_lanes + over_range_signal,
-					 AXI_ADC_PN9);
-	if (status != 0) {
-		pr_info("axi_adc_delay_calibrate() failed!");
-		return -1;
+	delay_cal_param.no_of_lanes = nr_of_lanes + over_range_signal;
+	Xil_DCacheInvalidateRange((uintptr_t)delay_cal, sizeof(*delay_cal));
+	status = axi_adc_delay_calibrate_cached(ad9434_core, &delay_cal_param,
+						&delay_cal->cal, &delay_cal_report);
+	if (status < 0) {
+		pr_info("axi_adc_delay_calibrate_cached() failed!");
+		goto error;
+	}
+
+	if (status) {
+		/* New result, keep it for the next boot */
+		delay_cal->full_us = delay_cal_report.duration_us;
+		Xil_DCacheFlushRange((uintptr_t)delay_cal, sizeof(*delay_cal));
+		pr_info("Delay calibration done: %" PRIu32 " us, %" PRIu32
+			" PN checks, saved\n", delay_cal_report.duration_us,
+			delay_cal_report.pn_checks);
+	} else {
+		pr_info("Delay calibration restored: %" PRIu32 " us, %" PRIu32
+			" PN checks (full calibration: %" PRIu32 " us)\n",
+			delay_cal_report.duration_us, delay_cal_report.pn_checks,
+			delay_cal->full_us);
 	}
 
 	status = ad9434_testmode_set(ad9434_device, TESTMODE_OFF);
 	if (status != 0) {
 		pr_info("ad9434_testmode_set() TESTMODE_OFF failed!");
-		return -1;
+		goto error;
 	}
 
 	status = ad9434_outputmode_set(ad9434_device, OUTPUT_MODE_TWOS_COMPLEMENT);
 	if (status != 0) {
 		pr_info("ad9434_outputmode_set() OUTPUT_MODE_TWOS_COMPLEMENT failed!");
-		return -1;
+		goto error;
 	}
 
 	struct axi_dma_transfer transfer = {
@@ -162,11 +227,11 @@ int main(void)
 	status = axi_dmac_transfer_start(ad9434_dmac, &transfer);
 	if (status != 0) {
 		pr_info("axi_dmac_transfer_start() failed!");
-		return -1;
+		goto error;
 	}
 	status = axi_dmac_transfer_wait_completion(ad9434_dmac, 500);
 	if (status)
-		return status;
+		goto error;
 	/* Flush cache data. */
 	Xil_DCacheInvalidateRange((uintptr_t)ADC_DDR_BASEADDR, 16384 * 2);
 
@@ -224,6 +289,10 @@ int main(void)
 	if (status)
 		return status;
 
+#ifdef NO_OS_DLOG
+	no_os_dlog_flush(0);
+#endif
+
 	return iio_app_run(app);
 #endif
 
@@ -234,5 +303,16 @@ int main(void)
 	/* Disable the data cache. */
 	Xil_DCacheDisable();
 
+#ifdef NO_OS_DLOG
+	no_os_dlog_flush(0);
+#endif
+
 	return 0;
+
+error:
+#ifdef NO_OS_DLOG
+	no_os_dlog_flush(0);
+#endif
+
+	return status;
 }
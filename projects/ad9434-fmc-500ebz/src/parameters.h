@@ -40,6 +40,7 @@
 #define RX_CORE_BASEADDR			XPAR_AXI_AD9434_BASEADDR
 #define RX_DMA_BASEADDR				XPAR_AXI_AD9434_DMA_BASEADDR
 #define ADC_DDR_BASEADDR			XPAR_DDR_MEM_BASEADDR + 0x800000
+#define DELAY_CAL_BASEADDR			XPAR_DDR_MEM_BASEADDR + 0x7F0000
 #define UART_DEVICE_ID				XPAR_XUARTPS_0_DEVICE_ID
 #define UART_IRQ_ID				XPAR_XUARTPS_1_INTR
 #define UART_BAUDRATE                           115200
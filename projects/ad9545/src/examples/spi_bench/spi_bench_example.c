@@ -0,0 +1,199 @@
+/***************************************************************************//**
+ *   @file   spi_bench_example.c
+ *   @brief  Linux spidev register read throughput benchmark for ad9545 project
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <inttypes.h>
+#include <string.h>
+#include <time.h>
+#include "common_data.h"
+#include "ad9545.h"
+#include "linux_spi.h"
+#include "no_os_print_log.h"
+#include "no_os_spi.h"
+#include "no_os_util.h"
+
+/* Registers read per iteration, starting at AD9545_PRODUCT_ID_LOW */
+#define SPI_BENCH_REGS		64
+#define SPI_BENCH_LOOPS		200
+
+/**
+ * @brief Register read method.
+ */
+enum spi_bench_method {
+	/* One write and read call, hence one ioctl, per register */
+	SPI_BENCH_SINGLE,
+	/* One message chain per iteration, CS toggled between registers */
+	SPI_BENCH_TRANSFER,
+	/* Unmodified write and read calls queued until the end of a batch */
+	SPI_BENCH_BATCH,
+};
+
+static const char *const spi_bench_names[] = {
+	[SPI_BENCH_SINGLE] = "no_os_spi_write_and_read",
+	[SPI_BENCH_TRANSFER] = "no_os_spi_transfer",
+	[SPI_BENCH_BATCH] = "linux_spi batch",
+};
+
+static uint8_t spi_bench_buf[SPI_BENCH_REGS][3];
+static struct no_os_spi_msg spi_bench_msgs[SPI_BENCH_REGS];
+
+/**
+ * @brief Get the monotonic time.
+ * @return Time in ns.
+ */
+static uint64_t spi_bench_now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/**
+ * @brief Prepare the read frames of all the registers.
+ */
+static void spi_bench_prepare(void)
+{
+	uint16_t addr;
+	uint32_t i;
+
+	for (i = 0; i < SPI_BENCH_REGS; i++) {
+		addr = AD9545_PRODUCT_ID_LOW + i;
+		spi_bench_buf[i][0] = no_os_field_get(BYTE_ADDR_H, addr) |
+				      NO_OS_BIT(7);
+		spi_bench_buf[i][1] = no_os_field_get(BYTE_ADDR_L, addr);
+		spi_bench_buf[i][2] = 0;
+	}
+}
+
+/**
+ * @brief Read all the registers once.
+ * @param spi - SPI descriptor.
+ * @param method - Register read method.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int spi_bench_read(struct no_os_spi_desc *spi,
+			  enum spi_bench_method method)
+{
+	uint32_t i;
+	int ret = 0;
+
+	spi_bench_prepare();
+
+	switch (method) {
+	case SPI_BENCH_SINGLE:
+		for (i = 0; i < SPI_BENCH_REGS && !ret; i++)
+			ret = no_os_spi_write_and_read(spi, spi_bench_buf[i], 3);
+		break;
+	case SPI_BENCH_TRANSFER:
+		for (i = 0; i < SPI_BENCH_REGS; i++) {
+			spi_bench_msgs[i].tx_buff = spi_bench_buf[i];
+			spi_bench_msgs[i].rx_buff = spi_bench_buf[i];
+			spi_bench_msgs[i].bytes_number = 3;
+			spi_bench_msgs[i].cs_change = 1;
+		}
+		ret = no_os_spi_transfer(spi, spi_bench_msgs, SPI_BENCH_REGS);
+		break;
+	case SPI_BENCH_BATCH:
+		ret = linux_spi_batch_begin(spi);
+		if (ret)
+			return ret;
+
+		for (i = 0; i < SPI_BENCH_REGS && !ret; i++)
+			ret = no_os_spi_write_and_read(spi, spi_bench_buf[i], 3);
+
+		if (ret) {
+			linux_spi_batch_end(spi);
+			return ret;
+		}
+
+		ret = linux_spi_batch_end(spi);
+		break;
+	}
+
+	return ret;
+}
+
+/**
+ * @brief Linux spidev register read benchmark.
+ *
+ * Reads SPI_BENCH_REGS AD9545 registers SPI_BENCH_LOOPS times with each
+ * method, checking that all the methods read the same values and reporting
+ * the register reads per second and the ioctls used.
+ *
+ * @return ret - Result of the example execution.
+ */
+int example_main()
+{
+	uint8_t ref[SPI_BENCH_REGS];
+	struct no_os_spi_desc *spi;
+	uint32_t ioctls;
+	uint64_t start;
+	uint64_t ns;
+	uint32_t i;
+	int method;
+	int ret;
+
+	ret = no_os_spi_init(&spi, ad9545_ip.spi_init);
+	if (ret)
+		return ret;
+
+	for (method = SPI_BENCH_SINGLE; method <= SPI_BENCH_BATCH; method++) {
+		ioctls = linux_spi_get_ioctl_count(spi);
+		start = spi_bench_now_ns();
+		for (i = 0; i < SPI_BENCH_LOOPS; i++) {
+			ret = spi_bench_read(spi, method);
+			if (ret)
+				goto remove_spi;
+		}
+		ns = spi_bench_now_ns() - start;
+		ioctls = linux_spi_get_ioctl_count(spi) - ioctls;
+
+		for (i = 0; i < SPI_BENCH_REGS; i++) {
+			if (method == SPI_BENCH_SINGLE)
+				ref[i] = spi_bench_buf[i][2];
+			else if (ref[i] != spi_bench_buf[i][2])
+				pr_warning("%s: register 0x%04x mismatch\n",
+					   spi_bench_names[method],
+					   AD9545_PRODUCT_ID_LOW + i);
+		}
+
+		pr_info("%-26s %8" PRIu64 " reads/s, %" PRIu32 " ioctls\n",
+			spi_bench_names[method],
+			(uint64_t)(SPI_BENCH_REGS * SPI_BENCH_LOOPS * 1000000000ULL /
+				   (ns ? ns : 1)), ioctls);
+	}
+
+remove_spi:
+	no_os_spi_remove(spi);
+
+	return ret;
+}
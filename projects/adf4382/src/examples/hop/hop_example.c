@@ -0,0 +1,234 @@
+/***************************************************************************//**
+ *   @file   hop_example.c
+ *   @brief  Frequency hop table example for the ADF4382 project
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <inttypes.h>
+#include "common_data.h"
+#include "no_os_delay.h"
+#include "no_os_print_log.h"
+#include "no_os_util.h"
+
+#define HOP_ENTRIES		16
+#define HOP_ROUNDS		8
+#define HOP_FREQ_START		12000000000ULL
+#define HOP_FREQ_STEP		500000000ULL
+#define HOP_LOCK_TIMEOUT	1000
+
+/**
+ * @brief Get the time elapsed since a given moment, in microseconds.
+ * @param start - Start moment.
+ * @return Elapsed time.
+ */
+static uint32_t hop_elapsed_us(struct no_os_time start)
+{
+	struct no_os_time now = no_os_get_time();
+
+	return (now.s - start.s) * 1000000 + now.us - start.us;
+}
+
+/**
+ * @brief Poll the lock status of the PLL.
+ * @param dev - The device structure.
+ * @param unlocked - Incremented if the PLL did not lock in time.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int hop_wait_lock(struct adf4382_dev *dev, uint32_t *unlocked)
+{
+	uint32_t timeout = HOP_LOCK_TIMEOUT;
+	bool locked = false;
+	int ret;
+
+	do {
+		ret = adf4382_get_lock(dev, &locked);
+		if (ret || locked)
+			break;
+		no_os_udelay(1);
+	} while (--timeout);
+
+	*unlocked += !locked;
+
+	return ret;
+}
+
+/**
+ * @brief Retune using adf4382_set_freq(), which also waits for the lock.
+ * @param dev - The device structure.
+ * @param index - Index of the frequency in the hop table.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int hop_set_freq(struct adf4382_dev *dev, uint32_t index)
+{
+	dev->freq = dev->hop_table->entries[index].freq;
+
+	return adf4382_set_freq(dev);
+}
+
+/**
+ * @brief Retune using the register by register path, without the fixed lock
+ * detect delay of adf4382_set_freq().
+ * @param dev - The device structure.
+ * @param index - Index of the frequency in the hop table.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int hop_change_freq(struct adf4382_dev *dev, uint32_t index)
+{
+	int ret;
+
+	dev->freq = dev->hop_table->entries[index].freq;
+	ret = adf4382_set_change_freq(dev);
+	if (ret)
+		return ret;
+
+	return adf4382_set_start_calibration(dev);
+}
+
+/**
+ * @brief Sweep the hop table using a given retune path and print the latency.
+ * @param dev - The device structure.
+ * @param name - Name of the measured path.
+ * @param hop - Retune function.
+ * @param total_us - Time spent for the whole sweep, until the last lock.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int hop_measure(struct adf4382_dev *dev, const char *name,
+		       int (*hop)(struct adf4382_dev *, uint32_t),
+		       uint32_t *total_us)
+{
+	uint32_t hops = HOP_ENTRIES * HOP_ROUNDS;
+	struct no_os_time sweep_start;
+	uint32_t program_us = 0;
+	struct no_os_time start;
+	uint32_t unlocked = 0;
+	uint32_t lock_us = 0;
+	uint32_t i;
+	int ret;
+
+	sweep_start = no_os_get_time();
+	for (i = 0; i < hops; i++) {
+		start = no_os_get_time();
+		ret = hop(dev, i % HOP_ENTRIES);
+		if (ret)
+			return ret;
+		program_us += hop_elapsed_us(start);
+
+		ret = hop_wait_lock(dev, &unlocked);
+		if (ret)
+			return ret;
+		lock_us += hop_elapsed_us(start);
+	}
+	*total_us = hop_elapsed_us(sweep_start);
+
+	pr_info("%-10s program %6" PRIu32 " us/hop, to lock %6" PRIu32
+		" us/hop, %" PRIu32 " hops in %" PRIu32 " us, %" PRIu32
+		" unlocked\n", name, program_us / hops, lock_us / hops, hops,
+		*total_us, unlocked);
+
+	return 0;
+}
+
+/**
+ * @brief Print how much faster a sweep was than the adf4382_set_freq() one.
+ * @param name - Name of the measured path.
+ * @param ref_us - Time of the adf4382_set_freq() sweep.
+ * @param us - Time of the sweep of the measured path.
+ */
+static void hop_print_speedup(const char *name, uint32_t ref_us, uint32_t us)
+{
+	us = no_os_max(us, 1u);
+
+	pr_info("%-10s sweep %" PRIu32 ".%02" PRIu32 "x faster than set_freq\n",
+		name, ref_us / us, (uint32_t)((uint64_t)(ref_us % us) * 100 / us));
+}
+
+/**
+ * @brief Frequency hop table example main execution.
+ *
+ * The same frequency list is swept using adf4382_set_freq(), using the
+ * register by register path without its fixed lock detect delay and using the
+ * precomputed hop table. For each path the average time spent programming the
+ * device, the average time until the PLL reports lock and the time of the
+ * whole sweep are printed, followed by the speedup of the other paths over
+ * adf4382_set_freq().
+ *
+ * @return ret - Result of the example execution.
+ */
+int example_main()
+{
+	uint64_t freqs[HOP_ENTRIES];
+	struct no_os_uart_desc *uart_desc;
+	struct adf4382_dev *dev;
+	uint32_t set_freq_us;
+	uint32_t change_us;
+	uint32_t table_us;
+	uint32_t i;
+	int ret;
+
+	ret = no_os_uart_init(&uart_desc, &adf4382_uart_ip);
+	if (ret)
+		return ret;
+
+	no_os_uart_stdio(uart_desc);
+
+	pr_info("Enter hop example \n");
+
+	ret = adf4382_init(&dev, &adf4382_ip);
+	if (ret)
+		goto error;
+
+	for (i = 0; i < HOP_ENTRIES; i++)
+		freqs[i] = HOP_FREQ_START + i * HOP_FREQ_STEP;
+
+	ret = adf4382_hop_table_load(dev, freqs, HOP_ENTRIES);
+	if (ret)
+		goto remove_adf4382;
+
+	ret = hop_measure(dev, "set_freq", hop_set_freq, &set_freq_us);
+	if (ret)
+		goto remove_adf4382;
+
+	ret = hop_measure(dev, "change", hop_change_freq, &change_us);
+	if (ret)
+		goto remove_adf4382;
+
+	ret = hop_measure(dev, "hop_table", adf4382_hop, &table_us);
+	if (ret)
+		goto remove_adf4382;
+
+	hop_print_speedup("change", set_freq_us, change_us);
+	hop_print_speedup("hop_table", set_freq_us, table_us);
+
+remove_adf4382:
+	adf4382_remove(dev);
+error:
+	if (ret)
+		pr_info("Error!\n");
+	return ret;
+}
@@ -0,0 +1,313 @@
+/***************************************************************************//**
+ *   @file   frame_bench_example.c
+ *   @brief  SPI efficiency benchmark for the ADIN1110 frame FIFO paths
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <string.h>
+#include <inttypes.h>
+#include "common_data.h"
+#include "no_os_error.h"
+#include "no_os_print_log.h"
+
+#include "adin1110.h"
+
+/* Number of frames sent for each frame size */
+#define BENCH_FRAME_CNT		200
+#define BENCH_MI_LOOPBACK	NO_OS_BIT(14)
+
+/**
+ * @brief SPI traffic counters.
+ */
+struct bench_stats {
+	uint32_t bytes;
+	uint32_t transfers;
+	uint32_t payload;
+};
+
+static const struct no_os_spi_platform_ops *bench_ops;
+static struct bench_stats stats;
+
+static uint8_t bench_frame[ADIN1110_ETH_HDR_LEN + 1500];
+static uint8_t bench_rx_buff[ADIN1110_BUFF_LEN];
+
+static const uint32_t bench_sizes[] = {64, 256, 1024, 1500};
+
+/**
+ * @brief Initialize the SPI using the platform ops being measured.
+ * @param desc - SPI descriptor.
+ * @param param - SPI initialization parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t bench_spi_init(struct no_os_spi_desc **desc,
+			      const struct no_os_spi_init_param *param)
+{
+	struct no_os_spi_init_param bench_param = *param;
+
+	bench_param.platform_ops = bench_ops;
+
+	return bench_ops->init(desc, &bench_param);
+}
+
+/**
+ * @brief Count and forward a write and read call.
+ * @param desc - SPI descriptor.
+ * @param data - SPI buffer.
+ * @param bytes_number - number of bytes.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t bench_spi_write_and_read(struct no_os_spi_desc *desc,
+					uint8_t *data, uint16_t bytes_number)
+{
+	stats.bytes += bytes_number;
+	stats.transfers++;
+
+	return bench_ops->write_and_read(desc, data, bytes_number);
+}
+
+/**
+ * @brief Count and forward a chain of SPI messages.
+ * @param desc - SPI descriptor.
+ * @param msgs - SPI messages.
+ * @param len - number of messages.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t bench_spi_transfer(struct no_os_spi_desc *desc,
+				  struct no_os_spi_msg *msgs, uint32_t len)
+{
+	uint32_t i;
+
+	for (i = 0; i < len; i++)
+		stats.bytes += msgs[i].bytes_number;
+	stats.transfers++;
+
+	return bench_ops->transfer(desc, msgs, len);
+}
+
+/**
+ * @brief Forward the SPI remove call.
+ * @param desc - SPI descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t bench_spi_remove(struct no_os_spi_desc *desc)
+{
+	return bench_ops->remove(desc);
+}
+
+static const struct no_os_spi_platform_ops bench_spi_ops = {
+	.init = bench_spi_init,
+	.write_and_read = bench_spi_write_and_read,
+	.transfer = bench_spi_transfer,
+	.remove = bench_spi_remove,
+};
+
+/**
+ * @brief Count the payload of a frame drained from the RX FIFO.
+ * @param ctx - unused.
+ * @param frame - the received frame.
+ * @param len - length of the frame.
+ * @return 0
+ */
+static int bench_rx_frame(void *ctx, uint8_t *frame, uint32_t len)
+{
+	stats.payload += len;
+
+	return 0;
+}
+
+/**
+ * @brief Send frames of a given size using adin1110_write_fifo() and read
+ * them back using adin1110_read_fifo().
+ * @param desc - the device descriptor.
+ * @param size - frame size, including the MAC header.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int bench_legacy(struct adin1110_desc *desc, uint32_t size)
+{
+	struct adin1110_eth_buff tx_buff = {
+		.len = size,
+		.payload = &bench_frame[ADIN1110_ETH_HDR_LEN],
+	};
+	struct adin1110_eth_buff rx_buff = {
+		.payload = bench_rx_buff,
+	};
+	uint32_t i;
+	int ret;
+
+	memcpy(tx_buff.mac_dest, bench_frame, ADIN1110_ETH_HDR_LEN);
+
+	for (i = 0; i < BENCH_FRAME_CNT; i++) {
+		ret = adin1110_write_fifo(desc, 0, &tx_buff);
+		if (ret && ret != -EAGAIN)
+			return ret;
+
+		stats.payload += ret ? 0 : size;
+
+		do {
+			rx_buff.len = 0;
+			ret = adin1110_read_fifo(desc, 0, &rx_buff);
+			if (ret)
+				return ret;
+
+			stats.payload += rx_buff.len;
+		} while (rx_buff.len);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Send frames of a given size using adin1110_write_fifo_sg() and read
+ * them back using adin1110_read_fifo_all().
+ * @param desc - the device descriptor.
+ * @param size - frame size, including the MAC header.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int bench_fast(struct adin1110_desc *desc, uint32_t size)
+{
+	struct adin1110_tx_seg segs[2] = {
+		{
+			.buff = bench_frame,
+			.len = ADIN1110_ETH_HDR_LEN,
+		},
+		{
+			.buff = &bench_frame[ADIN1110_ETH_HDR_LEN],
+			.len = size - ADIN1110_ETH_HDR_LEN,
+		},
+	};
+	uint32_t i;
+	int ret;
+
+	for (i = 0; i < BENCH_FRAME_CNT; i++) {
+		ret = adin1110_write_fifo_sg(desc, 0, segs, NO_OS_ARRAY_SIZE(segs));
+		if (ret && ret != -EAGAIN)
+			return ret;
+
+		stats.payload += ret ? 0 : size;
+
+		ret = adin1110_read_fifo_all(desc, 0, bench_rx_frame, NULL, NULL);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Print the SPI bytes transferred per payload byte.
+ * @param name - name of the measured path.
+ * @param size - frame size.
+ */
+static void bench_report(const char *name, uint32_t size)
+{
+	uint32_t ratio = 0;
+
+	if (stats.payload)
+		ratio = (uint64_t)stats.bytes * 1000 / stats.payload;
+
+	pr_info("%-7s %4" PRIu32 " bytes: %" PRIu32 " SPI transfers, %" PRIu32
+		" SPI bytes, %" PRIu32 ".%03" PRIu32 " SPI bytes/payload byte\n",
+		name, size, stats.transfers, stats.bytes, ratio / 1000,
+		ratio % 1000);
+}
+
+/***************************************************************************//**
+ * @brief SPI efficiency benchmark for the ADIN1110 frame FIFO paths.
+ *
+ * The PHY is put in loopback, so every transmitted frame is received back.
+ * The SPI traffic is counted by a stand-in layer placed between the driver
+ * and the platform SPI ops.
+ *
+ * @return ret - Result of the example execution.
+*******************************************************************************/
+int example_main()
+{
+	uint8_t mac_source[ADIN1110_ETH_ALEN] = {0xCA, 0x2F, 0xB7, 0x10, 0x23, 0x63};
+	struct adin1110_desc *adin1110;
+	struct adin1110_init_param adin1110_ip = {
+		.chip_type = ADIN1110,
+		.comm_param = adin1110_spi_ip,
+		.reset_param = adin1110_reset_gpio_ip,
+		.append_crc = false,
+	};
+	uint16_t mi_control;
+	size_t i;
+	int ret;
+
+	bench_ops = adin1110_spi_ip.platform_ops;
+	adin1110_ip.comm_param.platform_ops = &bench_spi_ops;
+	memcpy(adin1110_ip.mac_address, mac_source, ADIN1110_ETH_ALEN);
+
+	memset(bench_frame, 0xFF, ADIN1110_ETH_ALEN);
+	memcpy(&bench_frame[ADIN1110_ETH_ALEN], mac_source, ADIN1110_ETH_ALEN);
+	bench_frame[12] = 0x88;
+	bench_frame[13] = 0xB5;
+	for (i = ADIN1110_ETH_HDR_LEN; i < sizeof(bench_frame); i++)
+		bench_frame[i] = i;
+
+	ret = adin1110_init(&adin1110, &adin1110_ip);
+	if (ret)
+		return ret;
+
+	ret = adin1110_set_promisc(adin1110, 0, true);
+	if (ret)
+		goto error;
+
+	ret = adin1110_mdio_read(adin1110, ADIN1110_MDIO_PHY_ID(0),
+				 ADIN1110_MI_CONTROL_REG, &mi_control);
+	if (ret)
+		goto error;
+
+	ret = adin1110_mdio_write(adin1110, ADIN1110_MDIO_PHY_ID(0),
+				  ADIN1110_MI_CONTROL_REG,
+				  mi_control | BENCH_MI_LOOPBACK);
+	if (ret)
+		goto error;
+
+	for (i = 0; i < NO_OS_ARRAY_SIZE(bench_sizes); i++) {
+		memset(&stats, 0, sizeof(stats));
+		ret = bench_legacy(adin1110, bench_sizes[i]);
+		if (ret)
+			goto error;
+		bench_report("legacy", bench_sizes[i]);
+
+		memset(&stats, 0, sizeof(stats));
+		ret = bench_fast(adin1110, bench_sizes[i]);
+		if (ret)
+			goto error;
+		bench_report("fast", bench_sizes[i]);
+	}
+
+	return 0;
+
+error:
+	pr_err("Error %d!\n", ret);
+	adin1110_remove(adin1110);
+
+	return ret;
+}
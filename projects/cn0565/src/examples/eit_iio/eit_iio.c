@@ -32,6 +32,7 @@
 *******************************************************************************/
 
 #include "common_data.h"
+#include "no_os_delay.h"
 #include "no_os_i2c.h"
 #include "no_os_util.h"
 #include "ad5940.h"
@@ -55,6 +56,7 @@ int example_main()
 	struct ad5940_iio_dev *ad5940_iio = NULL;
 	struct ad5940_iio_init_param ad5940_iio_ip = {
 		.ad5940_init = &cn0565_ad5940_ip,
+		.get_time = no_os_get_time,
 	};
 	struct adg2128_iio_dev *adg2128_iio = NULL;
 
@@ -87,7 +87,7 @@ int example_main()
 {
 	int ret;
 	struct adxl355_iio_dev *adxl355_iio_desc;
-	struct adxl355_iio_dev_init_param adxl355_iio_ip;
+	struct adxl355_iio_dev_init_param adxl355_iio_ip = { 0 };
 	struct iio_data_buffer accel_buff = {
 		.buff = (void *)iio_data_buffer,
 		.size = DATA_BUFFER_SIZE * 3 * sizeof(int)
@@ -99,6 +99,9 @@ int example_main()
 
 	/* Initialize IIO device */
 	adxl355_iio_ip.adxl355_dev_init = &adxl355_ip;
+#ifdef CONFIG_ADXL355_PMDZ_FIFO_WATERMARK
+	adxl355_iio_ip.fifo_watermark = CONFIG_ADXL355_PMDZ_FIFO_WATERMARK;
+#endif
 	ret = adxl355_iio_init(&adxl355_iio_desc, &adxl355_iio_ip);
 	if (ret)
 		return ret;
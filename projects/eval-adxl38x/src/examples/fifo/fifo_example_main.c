@@ -39,7 +39,11 @@
 #include <stdlib.h>
 #include <string.h>
 
-static char getaxis(uint8_t chID);
+/* Output data rate of the HP mode, in mHz. Only used for the timestamps. */
+#define FIFO_EXAMPLE_ODR_MHZ	16000000
+/* FIFO watermark, 4 sets of x, y, z entries. */
+#define FIFO_EXAMPLE_ENTRIES	12
+#define FIFO_EXAMPLE_SETS	(FIFO_EXAMPLE_ENTRIES / 3)
 
 /***************************************************************************//**
  * @brief Example main execution.
@@ -49,15 +53,18 @@ static char getaxis(uint8_t chID);
 *******************************************************************************/
 int example_main()
 {
+	static const char axis[] = { 'x', 'y', 'z' };
 	struct adxl38x_dev *adxl38x_desc;
+	struct adxl_fifo *fifo = NULL;
 	int ret;
 	uint8_t register_value;
 	uint8_t status0;
 	uint8_t fifo_status[2];
-	uint8_t fifo_data[36];
-	uint8_t set_fifo_entries = 0x0C;
+	uint8_t raw[2];
 	uint16_t fifo_entries;
-	struct adxl38x_fractional_val data_frac[15];
+	int32_t sets[FIFO_EXAMPLE_SETS * 3];
+	uint32_t nb_sets, i, j;
+	struct adxl38x_fractional_val data_frac;
 	enum adxl38x_id devID;
 
 	ret = adxl38x_init(&adxl38x_desc, adxl38x_ip);
@@ -97,8 +104,16 @@ int example_main()
 		goto error;
 
 	// Set FIFO_CFG0 to 0x60 (Channel ID enable and FIFO stream mode)
-	ret = adxl38x_accel_set_FIFO(adxl38x_desc, set_fifo_entries,
+	ret = adxl38x_accel_set_FIFO(adxl38x_desc, FIFO_EXAMPLE_ENTRIES,
 				     false, ADXL38X_FIFO_STREAM, true, false);
+	if (ret)
+		goto error;
+
+	// Each drain reads the watermark worth of entries in one burst
+	ret = adxl38x_fifo_init(adxl38x_desc, ADXL38X_CH_EN_XYZ,
+				FIFO_EXAMPLE_ENTRIES, FIFO_EXAMPLE_ODR_MHZ, &fifo);
+	if (ret)
+		goto error;
 
 	// Set INT0_MAP0 to 0x08 (FIFO_WATERMARK_INT0)
 	register_value = 0x08;
@@ -130,47 +145,38 @@ int example_main()
 		// Read FIFO status and data if FIFO_WATERMARK is set
 		if (status0 & NO_OS_BIT(3)) {
 			pr_info(" FIFO_WATERMARK is set. Total fifo entries =  %d\n", fifo_entries);
-			if (fifo_entries < set_fifo_entries)
+			if (fifo_entries < FIFO_EXAMPLE_ENTRIES)
 				goto unmatch_error;
 
-			// Read data from FIFO (can read at least upto 12 samples * 3 bytes (chID, data))
-			ret = adxl38x_read_device_data(adxl38x_desc, ADXL38X_FIFO_DATA, 36, fifo_data);
+			// Read the watermark entries and reassemble them into x, y, z sets
+			ret = adxl_fifo_drain(fifo, sets, NULL, FIFO_EXAMPLE_SETS, &nb_sets);
 			if (ret)
 				goto error;
 
-			// Parse Data for fist five samples
-			pr_info("First four entries (absolute values printed for magnitude between -1g & 1g):\n");
-			for (int b = 0; b < 36; b += 3) {
-				ret = adxl38x_data_raw_to_gees(adxl38x_desc, (fifo_data + b + 1), data_frac);
-				if (ret)
-					goto error;
-				pr_info("%c : %lld.%07dg\n", getaxis(fifo_data[b]), data_frac->integer,
-					abs(data_frac->fractional));
+			pr_info("%u sets (absolute values printed for magnitude between -1g & 1g):\n",
+				(unsigned int)nb_sets);
+			for (i = 0; i < nb_sets; i++) {
+				for (j = 0; j < NO_OS_ARRAY_SIZE(axis); j++) {
+					no_os_put_unaligned_be16(sets[i * 3 + j], raw);
+					ret = adxl38x_data_raw_to_gees(adxl38x_desc, raw, &data_frac);
+					if (ret)
+						goto error;
+					pr_info("%c : %lld.%07dg\n", axis[j], data_frac.integer,
+						abs(data_frac.fractional));
+				}
 			}
 		}
 	}
 
 error:
+	adxl_fifo_remove(fifo);
 	if (ret)
 		pr_info("Error occurred!");
 	else
 		pr_info("The program has ended after successful execution\n");
 	return 0;
 unmatch_error:
+	adxl_fifo_remove(fifo);
 	pr_info("Number of entries in FIFO not matching the number set in FIFO config\n");
 	return 0;
 }
-
-/***************************************************************************//**
- * @brief Assigns axis based on channel index
- *
- * @param chID         - Channel index
- *
- * @return ret         - Corresponding channel ID for channel index provided
-*******************************************************************************/
-static char getaxis(uint8_t chID)
-{
-	if (chID)
-		return chID > 1 ? 'z' : 'y';
-	return 'x';
-}
@@ -68,6 +68,7 @@
 
 #define TOTAL_PQM_CHANNELS 11
 #define VOLTAGE_CH_NUMBER 3
+#define CURRENT_CH_NUMBER 4
 #define MAX_CH_ATTRS 23
 #define PQM_DEVICE_ATTR_NUMBER 63
 #define WAVEFORM_BUFFER_LENGTH (256 * 7)
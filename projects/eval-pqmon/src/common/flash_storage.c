@@ -44,15 +44,56 @@
 #include <stdio.h>
 #include <string.h>
 
-/* Use last two pages of internal flash for calibration storage */
+/* Use last two pages of internal flash for the record store */
 #define FLASH_CAL_PAGE_ADDR     ((MXC_FLASH_MEM_BASE + MXC_FLASH_MEM_SIZE) - (2 * MXC_FLASH_PAGE_SIZE))
 #define FLASH_CAL_BACKUP_ADDR   ((MXC_FLASH_MEM_BASE + MXC_FLASH_MEM_SIZE) - (1 * MXC_FLASH_PAGE_SIZE))
+#define FLASH_STORE_PAGE_ADDR(p) ((p) ? FLASH_CAL_BACKUP_ADDR : FLASH_CAL_PAGE_ADDR)
+#define FLASH_STORE_PAGE_SIZE   MXC_FLASH_PAGE_SIZE
+
+/* Changed bytes closer than this are stored in the same delta segment */
+#define FLASH_DELTA_MERGE_GAP   8
+#define FLASH_DELTA_SEG_HDR     4
+
+#define FLASH_ALIGN4(x)         (((x) + 3) & ~3u)
+#define FLASH_ERASED_MAGIC      0xFFFF
 
 /* CRC32 polynomial (IEEE 802.3) */
 #define CRC32_POLYNOMIAL        0xEDB88320
 
+/**
+ * @brief RAM copy of the latest image of a record
+ */
+typedef struct {
+	uint16_t id;                /* Record ID */
+	uint16_t version;           /* Current image structure version */
+	uint16_t size;              /* Image size */
+	void *image;                /* Latest image */
+	int status;                 /* FLASH_STATUS_OK if image is valid */
+} FLASH_RECORD;
+
 static bool flash_initialized = false;
 
+static FLASH_CALIBRATION_DATA calibration_image;
+
+static FLASH_RECORD flash_records[] = {
+	{
+		.id = FLASH_RECORD_ID_CALIBRATION,
+		.version = FLASH_VERSION_CALIBRATION,
+		.size = sizeof(FLASH_CALIBRATION_DATA),
+		.image = &calibration_image,
+	},
+};
+
+/* Active page state */
+static int8_t active_page = -1;
+static uint32_t active_generation;
+static uint32_t write_offset;
+static uint32_t record_count;
+static uint32_t delta_count;
+
+/* Record payload, word aligned for programming */
+static uint32_t record_buf[FLASH_RECORD_MAX_SIZE / 4];
+
 /* CRC32 lookup table */
 static uint32_t crc32_table[256];
 static bool crc32_table_initialized = false;
@@ -76,10 +117,9 @@ static void crc32_init_table(void)
 	crc32_table_initialized = true;
 }
 
-uint32_t flash_calculate_crc32(const void *data, uint32_t len)
+static uint32_t crc32_update(uint32_t crc, const void *data, uint32_t len)
 {
 	const uint8_t *buf = (const uint8_t *)data;
-	uint32_t crc = 0xFFFFFFFF;
 	uint32_t i;
 
 	if (!crc32_table_initialized)
@@ -88,9 +128,359 @@ uint32_t flash_calculate_crc32(const void *data, uint32_t len)
 	for (i = 0; i < len; i++)
 		crc = (crc >> 8) ^ crc32_table[(crc ^ buf[i]) & 0xFF];
 
+	return crc;
+}
+
+uint32_t flash_calculate_crc32(const void *data, uint32_t len)
+{
+	return crc32_update(0xFFFFFFFF, data, len) ^ 0xFFFFFFFF;
+}
+
+/*******************************************************************************
+ * Private Functions - Record store
+ ******************************************************************************/
+
+static FLASH_RECORD *flash_find_record(uint16_t id)
+{
+	uint32_t i;
+
+	for (i = 0; i < sizeof(flash_records) / sizeof(flash_records[0]); i++)
+		if (flash_records[i].id == id)
+			return &flash_records[i];
+
+	return NULL;
+}
+
+static uint32_t flash_record_crc(const FLASH_RECORD_HEADER *hdr,
+				 const void *payload)
+{
+	uint32_t crc;
+
+	crc = crc32_update(0xFFFFFFFF, hdr, offsetof(FLASH_RECORD_HEADER, crc32));
+	crc = crc32_update(crc, payload, hdr->length);
+
 	return crc ^ 0xFFFFFFFF;
 }
 
+static int flash_page_erase(uint8_t page)
+{
+	int ret;
+
+	MXC_ICC_Disable();
+	MXC_CRITICAL(
+		ret = MXC_FLC_PageErase(FLASH_STORE_PAGE_ADDR(page));
+	)
+	MXC_ICC_Enable();
+
+	return (ret == E_NO_ERROR) ? FLASH_STATUS_OK : FLASH_STATUS_ERASE_FAILED;
+}
+
+static int flash_program(uint32_t addr, const void *data, uint32_t len)
+{
+	const uint8_t *src = (const uint8_t *)data;
+	uint32_t word;
+	uint32_t i;
+	int ret = E_NO_ERROR;
+
+	MXC_ICC_Disable();
+	for (i = 0; i < len; i += 4) {
+		memcpy(&word, &src[i], sizeof(word));
+		MXC_CRITICAL(
+			ret = MXC_FLC_Write32(addr + i, word);
+		)
+		if (ret != E_NO_ERROR)
+			break;
+	}
+	MXC_ICC_Enable();
+
+	return (ret == E_NO_ERROR) ? FLASH_STATUS_OK : FLASH_STATUS_WRITE_FAILED;
+}
+
+static bool flash_read_page_header(uint8_t page, FLASH_PAGE_HEADER *hdr)
+{
+	MXC_FLC_Read(FLASH_STORE_PAGE_ADDR(page), hdr, sizeof(*hdr));
+
+	return hdr->magic == FLASH_STORE_MAGIC &&
+	       hdr->format == FLASH_STORE_FORMAT &&
+	       hdr->crc32 == flash_calculate_crc32(hdr,
+			       offsetof(FLASH_PAGE_HEADER, crc32));
+}
+
+/**
+ * Encode the bytes of new_image which differ from old_image as a list of
+ * segments. Returns the payload length, or 0 if a full image is not larger.
+ */
+static uint16_t flash_delta_encode(const uint8_t *old_image,
+				   const uint8_t *new_image, uint16_t size,
+				   uint8_t *out)
+{
+	uint16_t start, end, seg_len, need, j;
+	uint16_t out_len = 0;
+	uint16_t i = 0;
+
+	while (i < size) {
+		if (old_image[i] == new_image[i]) {
+			i++;
+			continue;
+		}
+
+		start = i;
+		end = i + 1;
+		for (j = end; j < size && j - end < FLASH_DELTA_MERGE_GAP; j++)
+			if (old_image[j] != new_image[j])
+				end = j + 1;
+
+		seg_len = end - start;
+		need = FLASH_DELTA_SEG_HDR + FLASH_ALIGN4(seg_len);
+		if (out_len + need >= size)
+			return 0;
+
+		memcpy(&out[out_len], &start, sizeof(start));
+		memcpy(&out[out_len + 2], &seg_len, sizeof(seg_len));
+		memcpy(&out[out_len + FLASH_DELTA_SEG_HDR], &new_image[start], seg_len);
+		memset(&out[out_len + FLASH_DELTA_SEG_HDR + seg_len], 0xFF,
+		       FLASH_ALIGN4(seg_len) - seg_len);
+		out_len += need;
+		i = end;
+	}
+
+	return out_len;
+}
+
+static int flash_delta_apply(FLASH_RECORD *rec, const uint8_t *payload,
+			     uint16_t len)
+{
+	uint16_t off = 0;
+	uint16_t seg_off, seg_len;
+
+	while (off + FLASH_DELTA_SEG_HDR <= len) {
+		memcpy(&seg_off, &payload[off], sizeof(seg_off));
+		memcpy(&seg_len, &payload[off + 2], sizeof(seg_len));
+		off += FLASH_DELTA_SEG_HDR;
+
+		if (seg_off + seg_len > rec->size || off + seg_len > len)
+			return FLASH_STATUS_INVALID_CRC;
+
+		memcpy((uint8_t *)rec->image + seg_off, &payload[off], seg_len);
+		off += FLASH_ALIGN4(seg_len);
+	}
+
+	return FLASH_STATUS_OK;
+}
+
+static void flash_replay_record(const FLASH_RECORD_HEADER *hdr,
+				const uint8_t *payload)
+{
+	FLASH_RECORD *rec;
+
+	/* Records of unknown IDs are dropped at the next compaction */
+	rec = flash_find_record(hdr->id);
+	if (!rec)
+		return;
+
+	if (hdr->version != rec->version || hdr->image_size != rec->size) {
+		rec->status = FLASH_STATUS_INVALID_VERSION;
+		return;
+	}
+
+	if (hdr->type == FLASH_RECORD_FULL && hdr->length == rec->size) {
+		memcpy(rec->image, payload, rec->size);
+		rec->status = FLASH_STATUS_OK;
+	} else if (hdr->type == FLASH_RECORD_DELTA &&
+		   rec->status == FLASH_STATUS_OK) {
+		rec->status = flash_delta_apply(rec, payload, hdr->length);
+	} else {
+		rec->status = FLASH_STATUS_INVALID_CRC;
+	}
+
+	if (rec->status == FLASH_STATUS_OK &&
+	    flash_calculate_crc32(rec->image, rec->size) != hdr->image_crc32)
+		rec->status = FLASH_STATUS_INVALID_CRC;
+}
+
+static void flash_import_legacy(void)
+{
+	FLASH_RECORD *rec = flash_find_record(FLASH_RECORD_ID_CALIBRATION);
+	const uint32_t addr[] = {FLASH_CAL_PAGE_ADDR, FLASH_CAL_BACKUP_ADDR};
+	uint32_t crc_offset = offsetof(FLASH_CALIBRATION_DATA, crc32);
+	uint32_t i;
+
+	/* Calibration written by firmware without the record store */
+	for (i = 0; i < 2; i++) {
+		MXC_FLC_Read(addr[i], &calibration_image,
+			     sizeof(FLASH_CALIBRATION_DATA));
+		if (calibration_image.magic != FLASH_MAGIC_CALIBRATION)
+			continue;
+
+		if (calibration_image.version != FLASH_VERSION_CALIBRATION)
+			rec->status = FLASH_STATUS_INVALID_VERSION;
+		else if (flash_calculate_crc32(&calibration_image, crc_offset) !=
+			 calibration_image.crc32)
+			rec->status = FLASH_STATUS_INVALID_CRC;
+		else
+			rec->status = FLASH_STATUS_OK;
+		return;
+	}
+}
+
+/**
+ * Find the active page and rebuild the RAM images from its records.
+ */
+static void flash_mount(void)
+{
+	FLASH_PAGE_HEADER page_hdr[2];
+	FLASH_RECORD_HEADER hdr;
+	bool valid[2];
+	uint32_t base, off, i;
+
+	for (i = 0; i < sizeof(flash_records) / sizeof(flash_records[0]); i++)
+		flash_records[i].status = FLASH_STATUS_NO_DATA;
+
+	active_page = -1;
+	active_generation = 0;
+	write_offset = 0;
+	record_count = 0;
+	delta_count = 0;
+
+	valid[0] = flash_read_page_header(0, &page_hdr[0]);
+	valid[1] = flash_read_page_header(1, &page_hdr[1]);
+	if (valid[0] && valid[1])
+		active_page = (page_hdr[1].generation > page_hdr[0].generation) ? 1 : 0;
+	else if (valid[0] || valid[1])
+		active_page = valid[1] ? 1 : 0;
+
+	if (active_page < 0) {
+		flash_import_legacy();
+		return;
+	}
+
+	active_generation = page_hdr[active_page].generation;
+	base = FLASH_STORE_PAGE_ADDR(active_page);
+	off = sizeof(FLASH_PAGE_HEADER);
+
+	while (off + sizeof(hdr) <= FLASH_STORE_PAGE_SIZE) {
+		MXC_FLC_Read(base + off, &hdr, sizeof(hdr));
+		if (hdr.magic == FLASH_ERASED_MAGIC)
+			break;
+
+		/* A torn record ends the log, the next write compacts the page */
+		if (hdr.magic != FLASH_RECORD_MAGIC ||
+		    hdr.length > sizeof(record_buf) ||
+		    off + sizeof(hdr) + FLASH_ALIGN4(hdr.length) > FLASH_STORE_PAGE_SIZE) {
+			off = FLASH_STORE_PAGE_SIZE;
+			break;
+		}
+
+		MXC_FLC_Read(base + off + sizeof(hdr), record_buf,
+			     FLASH_ALIGN4(hdr.length));
+		if (flash_record_crc(&hdr, record_buf) != hdr.crc32) {
+			off = FLASH_STORE_PAGE_SIZE;
+			break;
+		}
+
+		flash_replay_record(&hdr, (const uint8_t *)record_buf);
+		record_count++;
+		if (hdr.type == FLASH_RECORD_DELTA)
+			delta_count++;
+
+		off += sizeof(hdr) + FLASH_ALIGN4(hdr.length);
+	}
+
+	write_offset = off;
+}
+
+/**
+ * Program a record header followed by the payload held in record_buf.
+ */
+static int flash_program_record(uint32_t addr, const FLASH_RECORD *rec,
+				uint8_t type, uint16_t len)
+{
+	FLASH_RECORD_HEADER hdr = {
+		.magic = FLASH_RECORD_MAGIC,
+		.type = type,
+		.reserved = 0xFF,
+		.id = rec->id,
+		.version = rec->version,
+		.length = len,
+		.image_size = rec->size,
+	};
+	int ret;
+
+	hdr.image_crc32 = flash_calculate_crc32(rec->image, rec->size);
+	hdr.crc32 = flash_record_crc(&hdr, record_buf);
+
+	/* Header first: a torn payload then fails the record CRC */
+	ret = flash_program(addr, &hdr, sizeof(hdr));
+	if (ret != FLASH_STATUS_OK)
+		return ret;
+
+	return flash_program(addr + sizeof(hdr), record_buf, FLASH_ALIGN4(len));
+}
+
+static void flash_pad_record_buf(uint16_t len)
+{
+	memset((uint8_t *)record_buf + len, 0xFF, FLASH_ALIGN4(len) - len);
+}
+
+/**
+ * Write the latest full images to the other page. The page header is written
+ * last, so the old page stays active until the new one is complete.
+ */
+static int flash_compact(void)
+{
+	FLASH_PAGE_HEADER page_hdr = {
+		.magic = FLASH_STORE_MAGIC,
+		.generation = active_generation + 1,
+		.format = FLASH_STORE_FORMAT,
+		.reserved = 0xFFFF,
+	};
+	uint8_t page = (active_page == 0) ? 1 : 0;
+	uint32_t base = FLASH_STORE_PAGE_ADDR(page);
+	uint32_t off = sizeof(FLASH_PAGE_HEADER);
+	uint32_t count = 0;
+	uint32_t i;
+	int ret;
+
+	ret = flash_page_erase(page);
+	if (ret != FLASH_STATUS_OK)
+		return ret;
+
+	for (i = 0; i < sizeof(flash_records) / sizeof(flash_records[0]); i++) {
+		FLASH_RECORD *rec = &flash_records[i];
+
+		if (rec->status != FLASH_STATUS_OK)
+			continue;
+
+		memcpy(record_buf, rec->image, rec->size);
+		flash_pad_record_buf(rec->size);
+		ret = flash_program_record(base + off, rec, FLASH_RECORD_FULL,
+					   rec->size);
+		if (ret != FLASH_STATUS_OK)
+			return ret;
+
+		off += sizeof(FLASH_RECORD_HEADER) + FLASH_ALIGN4(rec->size);
+		count++;
+	}
+
+	page_hdr.crc32 = flash_calculate_crc32(&page_hdr,
+					       offsetof(FLASH_PAGE_HEADER, crc32));
+	ret = flash_program(base, &page_hdr, sizeof(page_hdr));
+	if (ret != FLASH_STATUS_OK)
+		return ret;
+
+	active_page = page;
+	active_generation = page_hdr.generation;
+	write_offset = off;
+	record_count = count;
+	delta_count = 0;
+
+	return FLASH_STATUS_OK;
+}
+
+/*******************************************************************************
+ * Public Functions - Record store
+ ******************************************************************************/
+
 int flash_storage_init(void)
 {
 	if (flash_initialized)
@@ -100,6 +490,9 @@ int flash_storage_init(void)
 	if (!crc32_table_initialized)
 		crc32_init_table();
 
+	/* Validate the store once, reads are served from RAM afterwards */
+	flash_mount();
+
 	flash_initialized = true;
 
 	return FLASH_STATUS_OK;
@@ -116,137 +509,155 @@ bool flash_storage_is_initialized(void)
 	return flash_initialized;
 }
 
-int flash_read_calibration(FLASH_CALIBRATION_DATA *data)
+int flash_record_read(uint16_t id, void *data, uint16_t size)
 {
-	uint32_t calculated_crc;
-	uint32_t crc_offset;
+	FLASH_RECORD *rec;
+	int ret;
 
 	if (!data)
 		return FLASH_STATUS_READ_FAILED;
 
-	/* Read calibration data from internal flash */
-	MXC_FLC_Read(FLASH_CAL_PAGE_ADDR, data, sizeof(FLASH_CALIBRATION_DATA));
-
-	/* Validate magic number */
-	if (data->magic != FLASH_MAGIC_CALIBRATION) {
-		/* Try backup location */
-		MXC_FLC_Read(FLASH_CAL_BACKUP_ADDR, data,
-			     sizeof(FLASH_CALIBRATION_DATA));
-
-		if (data->magic != FLASH_MAGIC_CALIBRATION)
-			return FLASH_STATUS_NO_DATA;
+	if (!flash_initialized) {
+		ret = flash_storage_init();
+		if (ret != FLASH_STATUS_OK)
+			return ret;
 	}
 
-	/* Validate version */
-	if (data->version != FLASH_VERSION_CALIBRATION)
-		return FLASH_STATUS_INVALID_VERSION;
+	rec = flash_find_record(id);
+	if (!rec || rec->size != size)
+		return FLASH_STATUS_READ_FAILED;
 
-	/* Validate CRC (CRC is calculated over all data except the CRC field) */
-	crc_offset = offsetof(FLASH_CALIBRATION_DATA, crc32);
-	calculated_crc = flash_calculate_crc32(data, crc_offset);
-	if (calculated_crc != data->crc32)
-		return FLASH_STATUS_INVALID_CRC;
+	if (rec->status != FLASH_STATUS_OK)
+		return rec->status;
+
+	memcpy(data, rec->image, size);
 
 	return FLASH_STATUS_OK;
 }
 
-int flash_write_calibration(const FLASH_CALIBRATION_DATA *data)
+int flash_record_write(uint16_t id, const void *data, uint16_t size)
 {
-	FLASH_CALIBRATION_DATA write_data;
-	uint32_t crc_offset;
-	uint32_t *src;
-	uint32_t addr;
+	FLASH_RECORD *rec;
+	uint8_t type = FLASH_RECORD_FULL;
+	uint16_t len = 0;
 	int ret;
-	uint32_t i;
 
 	if (!data)
 		return FLASH_STATUS_WRITE_FAILED;
 
-	/* Copy data and update header */
-	memcpy(&write_data, data, sizeof(FLASH_CALIBRATION_DATA));
-	write_data.magic = FLASH_MAGIC_CALIBRATION;
-	write_data.version = FLASH_VERSION_CALIBRATION;
+	if (!flash_initialized) {
+		ret = flash_storage_init();
+		if (ret != FLASH_STATUS_OK)
+			return ret;
+	}
 
-	/* Calculate CRC */
-	crc_offset = offsetof(FLASH_CALIBRATION_DATA, crc32);
-	write_data.crc32 = flash_calculate_crc32(&write_data, crc_offset);
+	rec = flash_find_record(id);
+	if (!rec || rec->size != size)
+		return FLASH_STATUS_WRITE_FAILED;
 
-	/* Disable instruction cache before modifying flash */
-	MXC_ICC_Disable();
+	if (rec->status == FLASH_STATUS_OK) {
+		if (!memcmp(rec->image, data, size))
+			return FLASH_STATUS_OK;
 
-	/* Erase and write primary page */
-	MXC_CRITICAL(
-		ret = MXC_FLC_PageErase(FLASH_CAL_PAGE_ADDR);
-	)
-	if (ret != E_NO_ERROR) {
-		MXC_ICC_Enable();
-		return FLASH_STATUS_ERASE_FAILED;
+		len = flash_delta_encode(rec->image, data, size,
+					 (uint8_t *)record_buf);
+		if (len)
+			type = FLASH_RECORD_DELTA;
 	}
 
-	src = (uint32_t *)&write_data;
-	addr = FLASH_CAL_PAGE_ADDR;
-	for (i = 0; i < sizeof(FLASH_CALIBRATION_DATA); i += 4) {
-		MXC_CRITICAL(
-			ret = MXC_FLC_Write32(addr + i, src[i / 4]);
-		)
-		if (ret != E_NO_ERROR) {
-			MXC_ICC_Enable();
-			return FLASH_STATUS_WRITE_FAILED;
-		}
+	if (!len) {
+		memcpy(record_buf, data, size);
+		len = size;
 	}
+	flash_pad_record_buf(len);
 
-	/* Erase and write backup page */
-	MXC_CRITICAL(
-		ret = MXC_FLC_PageErase(FLASH_CAL_BACKUP_ADDR);
-	)
-	if (ret != E_NO_ERROR) {
-		MXC_ICC_Enable();
-		return FLASH_STATUS_ERASE_FAILED;
-	}
+	memcpy(rec->image, data, size);
+	rec->status = FLASH_STATUS_OK;
 
-	addr = FLASH_CAL_BACKUP_ADDR;
-	for (i = 0; i < sizeof(FLASH_CALIBRATION_DATA); i += 4) {
-		MXC_CRITICAL(
-			ret = MXC_FLC_Write32(addr + i, src[i / 4]);
-		)
-		if (ret != E_NO_ERROR) {
-			MXC_ICC_Enable();
-			return FLASH_STATUS_WRITE_FAILED;
+	if (active_page < 0 || write_offset + sizeof(FLASH_RECORD_HEADER) +
+	    FLASH_ALIGN4(len) > FLASH_STORE_PAGE_SIZE) {
+		ret = flash_compact();
+	} else {
+		ret = flash_program_record(FLASH_STORE_PAGE_ADDR(active_page) +
+					   write_offset, rec, type, len);
+		if (ret == FLASH_STATUS_OK) {
+			write_offset += sizeof(FLASH_RECORD_HEADER) + FLASH_ALIGN4(len);
+			record_count++;
+			if (type == FLASH_RECORD_DELTA)
+				delta_count++;
 		}
 	}
 
-	/* Re-enable instruction cache */
-	MXC_ICC_Enable();
+	/* Resynchronize the RAM images with what actually is in flash */
+	if (ret != FLASH_STATUS_OK)
+		flash_mount();
+
+	return ret;
+}
+
+int flash_get_store_info(FLASH_STORE_INFO *info)
+{
+	if (!info)
+		return FLASH_STATUS_READ_FAILED;
+
+	if (!flash_initialized)
+		return FLASH_STATUS_NOT_INITIALIZED;
+
+	info->active_page = active_page;
+	info->generation = active_generation;
+	info->used_bytes = (active_page < 0) ? 0 : write_offset;
+	info->page_size = FLASH_STORE_PAGE_SIZE;
+	info->records = record_count;
+	info->delta_records = delta_count;
 
 	return FLASH_STATUS_OK;
 }
 
+/*******************************************************************************
+ * Public Functions - Calibration
+ ******************************************************************************/
+
+int flash_read_calibration(FLASH_CALIBRATION_DATA *data)
+{
+	return flash_record_read(FLASH_RECORD_ID_CALIBRATION, data,
+				 sizeof(FLASH_CALIBRATION_DATA));
+}
+
+int flash_write_calibration(const FLASH_CALIBRATION_DATA *data)
+{
+	FLASH_CALIBRATION_DATA write_data;
+	uint32_t crc_offset;
+
+	if (!data)
+		return FLASH_STATUS_WRITE_FAILED;
+
+	/* Copy data and update header */
+	memcpy(&write_data, data, sizeof(FLASH_CALIBRATION_DATA));
+	write_data.magic = FLASH_MAGIC_CALIBRATION;
+	write_data.version = FLASH_VERSION_CALIBRATION;
+
+	/* Calculate CRC */
+	crc_offset = offsetof(FLASH_CALIBRATION_DATA, crc32);
+	write_data.crc32 = flash_calculate_crc32(&write_data, crc_offset);
+
+	return flash_record_write(FLASH_RECORD_ID_CALIBRATION, &write_data,
+				  sizeof(FLASH_CALIBRATION_DATA));
+}
+
 int flash_erase_calibration(void)
 {
 	int ret;
 
-	/* Disable instruction cache */
-	MXC_ICC_Disable();
-
-	/* Erase primary page */
-	MXC_CRITICAL(
-		ret = MXC_FLC_PageErase(FLASH_CAL_PAGE_ADDR);
-	)
-	if (ret != E_NO_ERROR) {
-		MXC_ICC_Enable();
-		return FLASH_STATUS_ERASE_FAILED;
-	}
+	/* Erase both pages of the store */
+	ret = flash_page_erase(0);
+	if (ret != FLASH_STATUS_OK)
+		return ret;
 
-	/* Erase backup page */
-	MXC_CRITICAL(
-		ret = MXC_FLC_PageErase(FLASH_CAL_BACKUP_ADDR);
-	)
-	if (ret != E_NO_ERROR) {
-		MXC_ICC_Enable();
-		return FLASH_STATUS_ERASE_FAILED;
-	}
+	ret = flash_page_erase(1);
+	if (ret != FLASH_STATUS_OK)
+		return ret;
 
-	MXC_ICC_Enable();
+	flash_mount();
 
 	return FLASH_STATUS_OK;
 }
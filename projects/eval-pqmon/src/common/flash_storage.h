@@ -40,14 +40,23 @@
 /*******************************************************************************
  * Flash Memory Layout (MAX32650 Internal Flash - 3MB)
  *
- * Uses last two pages of internal flash for calibration storage.
+ * Uses last two pages of internal flash as a log structured record store.
  * Page size: 8KB (8192 bytes)
  *
  * Address Range              | Size   | Content
  * ---------------------------|--------|---------------------------
  * 0x10000000 - 0x102FBFFF    | ~3MB   | Application code
- * 0x102FC000 - 0x102FDFFF    | 8KB    | Calibration Data (2nd to last page)
- * 0x102FE000 - 0x102FFFFF    | 8KB    | Calibration Backup (last page)
+ * 0x102FC000 - 0x102FDFFF    | 8KB    | Record store page 0
+ * 0x102FE000 - 0x102FFFFF    | 8KB    | Record store page 1
+ *
+ * Only one page is active: the one with a valid header and the highest
+ * generation. Updates are appended to it as full images or as deltas against
+ * the previous image. When the active page is full, the latest images are
+ * compacted into the other page, so each page is erased once per compaction
+ * and the erases alternate between the two pages.
+ *
+ * Page:   | FLASH_PAGE_HEADER | record | record | ... | erased (0xFF) |
+ * Record: | FLASH_RECORD_HEADER | payload, padded to 4 bytes |
  ******************************************************************************/
 
 /* Flash sector size (4KB for MX25U6432F) */
@@ -62,6 +71,65 @@
 /* Number of channels (phases) */
 #define FLASH_NUM_CHANNELS              3
 
+/* Record store page header magic ("PQRS") and layout version */
+#define FLASH_STORE_MAGIC               0x53525150
+#define FLASH_STORE_FORMAT              0x0001
+
+/* Record header magic */
+#define FLASH_RECORD_MAGIC              0xA55A
+
+/* Record types */
+#define FLASH_RECORD_FULL               0x01
+#define FLASH_RECORD_DELTA              0x02
+
+/* Record IDs */
+#define FLASH_RECORD_ID_CALIBRATION     0x0001
+
+/* Largest record image */
+#define FLASH_RECORD_MAX_SIZE           512
+
+/**
+ * @brief Record store page header
+ */
+typedef struct {
+	uint32_t magic;             /* FLASH_STORE_MAGIC */
+	uint32_t generation;        /* Incremented on every compaction */
+	uint16_t format;            /* FLASH_STORE_FORMAT */
+	uint16_t reserved;          /* Reserved */
+	uint32_t crc32;             /* CRC32 of the fields above */
+} FLASH_PAGE_HEADER;
+
+/**
+ * @brief Record header
+ *
+ * A full record payload is the whole image. A delta record payload is a list
+ * of segments, each made of a 16-bit offset, a 16-bit length and the new
+ * bytes padded to 4 bytes.
+ */
+typedef struct {
+	uint16_t magic;             /* FLASH_RECORD_MAGIC */
+	uint8_t type;               /* FLASH_RECORD_FULL or FLASH_RECORD_DELTA */
+	uint8_t reserved;           /* Reserved */
+	uint16_t id;                /* Record ID */
+	uint16_t version;           /* Image structure version */
+	uint16_t length;            /* Payload length */
+	uint16_t image_size;        /* Image size */
+	uint32_t image_crc32;       /* CRC32 of the image after this record */
+	uint32_t crc32;             /* CRC32 of the fields above and payload */
+} FLASH_RECORD_HEADER;
+
+/**
+ * @brief Record store usage information
+ */
+typedef struct {
+	int8_t active_page;         /* Active page, -1 if not formatted */
+	uint32_t generation;        /* Generation of the active page */
+	uint32_t used_bytes;        /* Bytes used in the active page */
+	uint32_t page_size;         /* Page size */
+	uint32_t records;           /* Records in the active page */
+	uint32_t delta_records;     /* Delta records in the active page */
+} FLASH_STORE_INFO;
+
 /**
  * @brief Calibration coefficients for a single channel (phase)
  */
@@ -161,6 +229,38 @@ int flash_write_calibration(const FLASH_CALIBRATION_DATA *data);
  */
 int flash_erase_calibration(void);
 
+/**
+ * @brief Read the latest image of a record
+ *
+ * Images are cached in RAM when the store is mounted, so this doesn't access
+ * the flash.
+ * @param id - Record ID
+ * @param data - Buffer for the image
+ * @param size - Image size
+ * @return FLASH_STATUS_OK on success, error code otherwise
+ */
+int flash_record_read(uint16_t id, void *data, uint16_t size);
+
+/**
+ * @brief Write a new image of a record
+ *
+ * Only the bytes which differ from the previous image are appended to the
+ * active page, unless a full image is smaller. Nothing is written if the
+ * image is unchanged.
+ * @param id - Record ID
+ * @param data - New image
+ * @param size - Image size
+ * @return FLASH_STATUS_OK on success, error code otherwise
+ */
+int flash_record_write(uint16_t id, const void *data, uint16_t size);
+
+/**
+ * @brief Get record store usage information
+ * @param info - Usage information
+ * @return FLASH_STATUS_OK on success, error code otherwise
+ */
+int flash_get_store_info(FLASH_STORE_INFO *info);
+
 /**
  * @brief Load calibration from flash and apply to AFE registers
  * @return FLASH_STATUS_OK on success, error code otherwise
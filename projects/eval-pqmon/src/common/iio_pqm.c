@@ -81,6 +81,106 @@
 volatile bool configChanged = false;
 volatile bool processData = true;
 
+struct pqm_snapshot pqm_snapshot;
+
+#define PQM_1012_OUT	(pqlibExample.output->params1012Cycles)
+
+/**
+ * @brief Refresh the converted measurement snapshot.
+ *
+ * Called once per PQ cycle, after the library output was updated, so that
+ * attribute reads only have to format the cached values.
+ */
+void pqm_snapshot_update(void)
+{
+	float v_scale = pqlibExample.exampleConfig.voltageScale;
+	float i_scale = pqlibExample.exampleConfig.currentScale;
+	struct pqm_chan_snapshot *snap;
+	int ch, i;
+
+	if (!pqlibExample.output)
+		return;
+
+	for (ch = 0; ch < VOLTAGE_CH_NUMBER; ch++) {
+		snap = &pqm_snapshot.voltage[ch];
+		snap->rms = convert_rms_type(PQM_1012_OUT.voltageParams[ch].mag,
+					     v_scale);
+		snap->thd = (float)PQM_1012_OUT.voltageParams[ch].thd / 100.0f;
+		snap->under_dev = convert_rms_type(
+					  PQM_1012_OUT.voltageParams[ch].udod.uRmsUnder, v_scale);
+		snap->over_dev = convert_rms_type(
+					 PQM_1012_OUT.voltageParams[ch].udod.uRmsOver, v_scale);
+		for (i = 0; i < PQLIB_MAX_HARMONICS - 1; i++)
+			snap->harmonics[i] = convert_pct_type(
+						     PQM_1012_OUT.voltageParams[ch].harmonics[i]);
+		for (i = 0; i < PQLIB_MAX_INTER_HARMONICS - 1; i++)
+			snap->inter_harmonics[i] = convert_pct_type(
+							   PQM_1012_OUT.voltageParams[ch].interHarmonics[i]);
+	}
+
+	for (ch = 0; ch < CURRENT_CH_NUMBER; ch++) {
+		snap = &pqm_snapshot.current[ch];
+		snap->rms = convert_rms_type(PQM_1012_OUT.currentParams[ch].mag,
+					     i_scale);
+		snap->thd = (float)PQM_1012_OUT.currentParams[ch].thd / 100.0f;
+		for (i = 0; i < PQLIB_MAX_HARMONICS - 1; i++)
+			snap->harmonics[i] = convert_pct_type(
+						     PQM_1012_OUT.currentParams[ch].harmonics[i]);
+		for (i = 0; i < PQLIB_MAX_INTER_HARMONICS - 1; i++)
+			snap->inter_harmonics[i] = convert_pct_type(
+							   PQM_1012_OUT.currentParams[ch].interHarmonics[i]);
+	}
+
+	/* Angles are relative to phase A */
+	pqm_snapshot.voltage[0].angle = 0;
+	pqm_snapshot.voltage[1].angle =
+		convert_angle_type(pqlibExample.inputCycle.ANGL_VA_VB);
+	pqm_snapshot.voltage[2].angle =
+		convert_angle_type(pqlibExample.inputCycle.ANGL_VA_VC);
+	pqm_snapshot.current[0].angle = 0;
+	pqm_snapshot.current[1].angle =
+		convert_angle_type(pqlibExample.inputCycle.ANGL_IA_IB);
+	pqm_snapshot.current[2].angle =
+		convert_angle_type(pqlibExample.inputCycle.ANGL_IA_IC);
+
+#if ADI_PQLIB_CFG_DISABLE_SYMM_COMP == 0
+	pqm_snapshot.unb[NEG_UNB_VOLTAGE_RATIO] =
+		convert_pct_type(PQM_1012_OUT.voltageUnb.negUnbRatio);
+	pqm_snapshot.unb[ZERO_UNB_VOLTAGE_RATIO] =
+		convert_pct_type(PQM_1012_OUT.voltageUnb.zeroUnbRatio);
+	pqm_snapshot.unb[SZRO_VOLTAGE] =
+		convert_fract_type(PQM_1012_OUT.voltageUnb.zeroSeqMag);
+	pqm_snapshot.unb[SZRO_VOLTAGE_ANGLE] =
+		convert_fract_angle_type(PQM_1012_OUT.voltageUnb.zeroSeqAngle);
+	pqm_snapshot.unb[SPOS_VOLTAGE] =
+		convert_fract_type(PQM_1012_OUT.voltageUnb.posSeqMag);
+	pqm_snapshot.unb[SPOS_VOLTAGE_ANGLE] =
+		convert_fract_angle_type(PQM_1012_OUT.voltageUnb.posSeqAngle);
+	pqm_snapshot.unb[SNEG_VOLTAGE] =
+		convert_fract_type(PQM_1012_OUT.voltageUnb.negSeqMag);
+	pqm_snapshot.unb[SNEG_VOLTAGE_ANGLE] =
+		convert_fract_angle_type(PQM_1012_OUT.voltageUnb.negSeqAngle);
+	pqm_snapshot.unb[NEG_UNB_CURRENT_RATIO] =
+		convert_pct_type(PQM_1012_OUT.currentUnb.negUnbRatio);
+	pqm_snapshot.unb[ZERO_UNB_CURRENT_RATIO] =
+		convert_pct_type(PQM_1012_OUT.currentUnb.zeroUnbRatio);
+	pqm_snapshot.unb[SZRO_CURRENT] =
+		convert_fract_type(PQM_1012_OUT.currentUnb.zeroSeqMag);
+	pqm_snapshot.unb[SZRO_CURRENT_ANGLE] =
+		convert_fract_angle_type(PQM_1012_OUT.currentUnb.zeroSeqAngle);
+	pqm_snapshot.unb[SPOS_CURRENT] =
+		convert_fract_type(PQM_1012_OUT.currentUnb.posSeqMag);
+	pqm_snapshot.unb[SPOS_CURRENT_ANGLE] =
+		convert_fract_angle_type(PQM_1012_OUT.currentUnb.posSeqAngle);
+	pqm_snapshot.unb[SNEG_CURRENT] =
+		convert_fract_type(PQM_1012_OUT.currentUnb.negSeqMag);
+	pqm_snapshot.unb[SNEG_CURRENT_ANGLE] =
+		convert_fract_angle_type(PQM_1012_OUT.currentUnb.negSeqAngle);
+#endif
+
+	pqm_snapshot.cycle++;
+}
+
 /**
  * @brief utility function for computing next upcoming channel.
  * @param ch_mask - active channels .
@@ -208,85 +308,22 @@ int read_pqm_attr(void *device, char *buf, uint32_t len,
 			/* only if zero sequence enabled */
 #if ADI_PQLIB_CFG_DISABLE_SYMM_COMP == 0
 		case NEG_UNB_VOLTAGE_RATIO:
-			return snprintf(
-				       buf, len, "%.2f",
-				       convert_pct_type(pqlibExample.output->params1012Cycles
-							.voltageUnb.negUnbRatio));
 		case ZERO_UNB_VOLTAGE_RATIO:
-			return snprintf(
-				       buf, len, "%.2f",
-				       convert_pct_type(pqlibExample.output->params1012Cycles
-							.voltageUnb.zeroUnbRatio));
 		case SZRO_VOLTAGE:
-			return snprintf(
-				       buf, len, "%.2f",
-				       convert_fract_type(pqlibExample.output->params1012Cycles
-							  .voltageUnb.zeroSeqMag));
 		case SZRO_VOLTAGE_ANGLE:
-			return snprintf(
-				       buf, len, "%.2f",
-				       convert_fract_angle_type(pqlibExample.output->params1012Cycles
-								.voltageUnb.zeroSeqAngle));
 		case SPOS_VOLTAGE:
-			return snprintf(
-				       buf, len, "%.2f",
-				       convert_fract_type(pqlibExample.output->params1012Cycles
-							  .voltageUnb.posSeqMag));
 		case SPOS_VOLTAGE_ANGLE:
-			return snprintf(
-				       buf, len, "%.2f",
-				       convert_fract_angle_type(pqlibExample.output->params1012Cycles
-								.voltageUnb.posSeqAngle));
 		case SNEG_VOLTAGE:
-			return snprintf(
-				       buf, len, "%.2f",
-				       convert_fract_type(pqlibExample.output->params1012Cycles
-							  .voltageUnb.negSeqMag));
 		case SNEG_VOLTAGE_ANGLE:
-			return snprintf(
-				       buf, len, "%.2f",
-				       convert_fract_angle_type(pqlibExample.output->params1012Cycles
-								.voltageUnb.negSeqAngle));
 		case NEG_UNB_CURRENT_RATIO:
-			return snprintf(
-				       buf, len, "%.2f",
-				       convert_pct_type(pqlibExample.output->params1012Cycles
-							.currentUnb.negUnbRatio));
 		case ZERO_UNB_CURRENT_RATIO:
-			return snprintf(
-				       buf, len, "%.2f",
-				       convert_pct_type(pqlibExample.output->params1012Cycles
-							.currentUnb.zeroUnbRatio));
 		case SZRO_CURRENT:
-			return snprintf(
-				       buf, len, "%.2f",
-				       convert_fract_type(pqlibExample.output->params1012Cycles
-							  .currentUnb.zeroSeqMag));
 		case SZRO_CURRENT_ANGLE:
-			return snprintf(
-				       buf, len, "%.2f",
-				       convert_fract_angle_type(pqlibExample.output->params1012Cycles
-								.currentUnb.zeroSeqAngle));
 		case SPOS_CURRENT:
-			return snprintf(
-				       buf, len, "%.2f",
-				       convert_fract_type(pqlibExample.output->params1012Cycles
-							  .currentUnb.posSeqMag));
 		case SPOS_CURRENT_ANGLE:
-			return snprintf(
-				       buf, len, "%.2f",
-				       convert_fract_angle_type(pqlibExample.output->params1012Cycles
-								.currentUnb.posSeqAngle));
 		case SNEG_CURRENT:
-			return snprintf(
-				       buf, len, "%.2f",
-				       convert_fract_type(pqlibExample.output->params1012Cycles
-							  .currentUnb.negSeqMag));
 		case SNEG_CURRENT_ANGLE:
-			return snprintf(
-				       buf, len, "%.2f",
-				       convert_fract_angle_type(pqlibExample.output->params1012Cycles
-								.currentUnb.negSeqAngle));
+			return snprintf(buf, len, "%.2f", pqm_snapshot.unb[attr_id]);
 #endif
 		case CAL_TYPE:
 			if (pqlibExample.exampleConfig.calibrationType < NO_OS_ARRAY_SIZE(
@@ -681,6 +718,28 @@ int write_pqm_attr(void *device, char *buf, uint32_t len,
 	}
 }
 
+/**
+ * @brief Format a (inter)harmonics attribute from the snapshot.
+ * @param buf - output buffer.
+ * @param vals - harmonics values, starting with the second order.
+ * @param cnt - number of values.
+ * @return Number of bytes written.
+ */
+static int format_harmonics(char *buf, const float *vals, int cnt)
+{
+	char buffTmp[16];
+
+	// Adding fundamental waveform, 0% & 100% always
+	sprintf(buf, "%f %f ", 0.0f, 100.0f);
+
+	for (int i = 0; i < cnt; i++) {
+		sprintf(buffTmp, "%f ", vals[i]);
+		strcat(buf, buffTmp);
+	}
+
+	return strlen(buf);
+}
+
 /**
  * @brief Read a channel attribute.
  *
@@ -695,8 +754,8 @@ int write_pqm_attr(void *device, char *buf, uint32_t len,
 int read_ch_attr(void *device, char *buf, uint32_t len,
 		 const struct iio_ch_info *channel, intptr_t attr_id)
 {
+	struct pqm_chan_snapshot *snap;
 	struct pqm_desc *desc;
-	char buffTmp[10];
 
 	if (!device)
 		return -ENODEV;
@@ -707,61 +766,18 @@ int read_ch_attr(void *device, char *buf, uint32_t len,
 
 	switch (channel->type) {
 	case IIO_VOLTAGE:
+		snap = &pqm_snapshot.voltage[channel->ch_num];
 		switch (attr_id) {
 		case CHAN_RMS:
-			return snprintf(
-				       buf, len, "%.2f",
-				       convert_rms_type(pqlibExample.output->params1012Cycles
-							.voltageParams[channel->ch_num]
-							.mag,
-							pqlibExample.exampleConfig.voltageScale));
+			return snprintf(buf, len, "%.2f", snap->rms);
 		case CHAN_ANGLE:
-			switch (channel->ch_num) {
-			case 0: // VA -> always 0
-				return snprintf(buf, len, "%" PRIu16 "", 0);
-			case 1: // VB -> ANGL_VA_VB
-				return snprintf(buf, len, "%" PRIu16 "",
-						convert_angle_type(pqlibExample.inputCycle.ANGL_VA_VB));
-			case 2: // VC -> ANGL_VA_VC
-				return snprintf(buf, len, "%" PRIu16 "",
-						convert_angle_type(pqlibExample.inputCycle.ANGL_VA_VC));
-			}
-
+			return snprintf(buf, len, "%" PRIu16 "", snap->angle);
 		case CHAN_HARMONICS:
-			strcpy(buf, "");
-			// Adding fundamental waveform, 0% & 100% always
-			sprintf(buffTmp, "%f %f", 0.0f, 100.0f);
-			strcat(buf, buffTmp);
-			strcat(buf, " ");
-
-			for (int i = 0; i < PQLIB_MAX_HARMONICS - 1; i++) {
-				sprintf(buffTmp, "%f",
-					convert_pct_type(pqlibExample.output->params1012Cycles
-							 .voltageParams[channel->ch_num]
-							 .harmonics[i]));
-				strcat(buf, buffTmp);
-				if (i != PQLIB_MAX_HARMONICS - 1)
-					strcat(buf, " ");
-			}
-			return strlen(buf);
-
+			return format_harmonics(buf, snap->harmonics,
+						PQLIB_MAX_HARMONICS - 1);
 		case CHAN_INTER_HARMONICS:
-			strcpy(buf, "");
-			// Adding fundamental waveform, 0% & 100% always
-			sprintf(buffTmp, "%f %f", 0.0f, 100.0f);
-			strcat(buf, buffTmp);
-			strcat(buf, " ");
-
-			for (int i = 0; i < PQLIB_MAX_INTER_HARMONICS - 1; i++) {
-				sprintf(buffTmp, "%f",
-					convert_pct_type(pqlibExample.output->params1012Cycles
-							 .voltageParams[channel->ch_num]
-							 .interHarmonics[i]));
-				strcat(buf, buffTmp);
-				if (i != PQLIB_MAX_INTER_HARMONICS - 1)
-					strcat(buf, " ");
-			}
-			return strlen(buf);
+			return format_harmonics(buf, snap->inter_harmonics,
+						PQLIB_MAX_INTER_HARMONICS - 1);
 
 		case CHAN_SCALE:
 			return snprintf(buf, len, "%.5f",
@@ -771,28 +787,13 @@ int read_ch_attr(void *device, char *buf, uint32_t len,
 		case CHAN_OFFSET:
 			return snprintf(buf, len, "%" PRIu32 "", 0);
 		case CHAN_THD:
-			return snprintf(
-				       buf, len, "%f",
-				       ((float)(pqlibExample.output->params1012Cycles
-						.voltageParams[channel->ch_num]
-						.thd)
-					/ 100.0f));
+			return snprintf(buf, len, "%f", snap->thd);
 
 		case CHAN_VOLTAGE_UNDER_DEV:
-			return snprintf(
-				       buf, len, "%.2f",
-				       convert_rms_type(pqlibExample.output->params1012Cycles
-							.voltageParams[channel->ch_num]
-							.udod.uRmsUnder,
-							pqlibExample.exampleConfig.voltageScale));
+			return snprintf(buf, len, "%.2f", snap->under_dev);
 
 		case CHAN_VOLTAGE_OVER_DEV:
-			return snprintf(
-				       buf, len, "%.2f",
-				       convert_rms_type(pqlibExample.output->params1012Cycles
-							.voltageParams[channel->ch_num]
-							.udod.uRmsOver,
-							pqlibExample.exampleConfig.voltageScale));
+			return snprintf(buf, len, "%.2f", snap->over_dev);
 		case CHAN_VOLTAGE_MAGNITUDE1012:
 			return snprintf(buf, len, "%" PRIu16 "",
 					pqlibExample.output->msvMagnitude[channel->ch_num].magnitude1012);
@@ -807,64 +808,24 @@ int read_ch_attr(void *device, char *buf, uint32_t len,
 		}
 
 	case IIO_CURRENT:
+		snap = &pqm_snapshot.current[channel->ch_num];
 		switch (attr_id) {
 		case CHAN_RMS:
-			return snprintf(
-				       buf, len, "%.2f",
-				       convert_rms_type(pqlibExample.output->params1012Cycles
-							.currentParams[channel->ch_num]
-							.mag,
-							pqlibExample.exampleConfig.currentScale));
+			return snprintf(buf, len, "%.2f", snap->rms);
 
 		case CHAN_ANGLE:
-			switch (channel->ch_num) {
-			case 0: // IA -> always 0
-				return snprintf(buf, len, "%" PRIu16 "", 0);
-			case 1: // IB -> ANGL_IA_IB
-				return snprintf(buf, len, "%" PRIu16 "",
-						convert_angle_type(pqlibExample.inputCycle.ANGL_IA_IB));
-			case 2: // IC -> ANGLE_IA_IC
-				return snprintf(buf, len, "%" PRIu16 "",
-						convert_angle_type(pqlibExample.inputCycle.ANGL_IA_IC));
-			default:
+			// The neutral current has no angle
+			if (channel->ch_num >= VOLTAGE_CH_NUMBER)
 				return -EINVAL;
-			}
+			return snprintf(buf, len, "%" PRIu16 "", snap->angle);
 
 		case CHAN_HARMONICS:
-			strcpy(buf, "");
-			// Adding fundamental waveform, 0% & 100% always
-			sprintf(buffTmp, "%f %f", 0.0f, 100.0f);
-			strcat(buf, buffTmp);
-			strcat(buf, " ");
-
-			for (int i = 0; i < PQLIB_MAX_HARMONICS - 1; i++) {
-				sprintf(buffTmp, "%f",
-					convert_pct_type(pqlibExample.output->params1012Cycles
-							 .currentParams[channel->ch_num]
-							 .harmonics[i]));
-				strcat(buf, buffTmp);
-				if (i != PQLIB_MAX_HARMONICS - 1)
-					strcat(buf, " ");
-			}
-			return strlen(buf);
+			return format_harmonics(buf, snap->harmonics,
+						PQLIB_MAX_HARMONICS - 1);
 
 		case CHAN_INTER_HARMONICS:
-			strcpy(buf, "");
-			// Adding fundamental waveform, 0% & 100% always
-			sprintf(buffTmp, "%f %f", 0.0f, 100.0f);
-			strcat(buf, buffTmp);
-			strcat(buf, " ");
-
-			for (int i = 0; i < PQLIB_MAX_INTER_HARMONICS - 1; i++) {
-				sprintf(buffTmp, "%f",
-					convert_pct_type(pqlibExample.output->params1012Cycles
-							 .currentParams[channel->ch_num]
-							 .interHarmonics[i]));
-				strcat(buf, buffTmp);
-				if (i != PQLIB_MAX_INTER_HARMONICS - 1)
-					strcat(buf, " ");
-			}
-			return strlen(buf);
+			return format_harmonics(buf, snap->inter_harmonics,
+						PQLIB_MAX_INTER_HARMONICS - 1);
 		case CHAN_SCALE:
 			return snprintf(buf, len, "%.5f",
 					(pqlibExample.exampleConfig.currentScale /
@@ -874,12 +835,7 @@ int read_ch_attr(void *device, char *buf, uint32_t len,
 			return snprintf(buf, len, "%" PRIu32 "", 0);
 
 		case CHAN_THD:
-			return snprintf(
-				       buf, len, "%f",
-				       (float)(pqlibExample.output->params1012Cycles
-					       .currentParams[channel->ch_num]
-					       .thd)
-				       / 100.0f);
+			return snprintf(buf, len, "%f", snap->thd);
 
 		default:
 			return snprintf(
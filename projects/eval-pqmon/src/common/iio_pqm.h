@@ -139,8 +139,48 @@
 
 #define RESAMPLED_WAVEFORM_FULL_SCALE   18196
 
+/**
+ * @struct pqm_chan_snapshot
+ * @brief Converted measurements of a voltage or current channel.
+ */
+struct pqm_chan_snapshot {
+	/** RMS value */
+	float rms;
+	/** Total harmonic distortion (%) */
+	float thd;
+	/** Underdeviation RMS (voltage channels only) */
+	float under_dev;
+	/** Overdeviation RMS (voltage channels only) */
+	float over_dev;
+	/** Angle relative to the phase A channel */
+	uint16_t angle;
+	/** Harmonics, from the 2nd one (%) */
+	float harmonics[PQLIB_MAX_HARMONICS - 1];
+	/** Interharmonics (%) */
+	float inter_harmonics[PQLIB_MAX_INTER_HARMONICS - 1];
+};
+
+/**
+ * @struct pqm_snapshot
+ * @brief Converted measurements, refreshed once per PQ cycle.
+ */
+struct pqm_snapshot {
+	/** Number of refreshes */
+	uint32_t cycle;
+	/** Voltage channels */
+	struct pqm_chan_snapshot voltage[VOLTAGE_CH_NUMBER];
+	/** Current channels */
+	struct pqm_chan_snapshot current[CURRENT_CH_NUMBER];
+	/** Unbalance and symmetrical components, indexed by attribute ID */
+	float unb[SZRO_CURRENT_ANGLE + 1];
+};
+
 extern struct iio_device pqm_iio_descriptor;
+extern struct pqm_snapshot pqm_snapshot;
 extern volatile bool configChanged;
 extern volatile bool processData;
 
+/* Refresh the converted measurement snapshot from the PQ library output. */
+void pqm_snapshot_update(void);
+
 #endif
\ No newline at end of file
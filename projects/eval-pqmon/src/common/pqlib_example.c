@@ -306,6 +306,8 @@ int process_and_prepare_output()
 			}
 		}
 
+		pqm_snapshot_update();
+
 		status = SYS_STATUS_PQLIB_RUNNING;
 		done = true;
 	}
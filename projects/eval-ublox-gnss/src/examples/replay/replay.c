@@ -0,0 +1,224 @@
+/***************************************************************************//**
+ *   @file   replay.c
+ *   @brief  Streaming parser benchmark replaying a captured GNSS log.
+********************************************************************************
+ * Copyright (c) 2026 Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include "no_os_uart.h"
+#include "no_os_delay.h"
+#include "no_os_print_log.h"
+#include "no_os_util.h"
+#include "no_os_error.h"
+#include "maxim_uart.h"
+#include "maxim_uart_stdio.h"
+#include "nmea_ubx.h"
+#include "common_data.h"
+#include "platform.h"
+
+/* Largest log which can be replayed */
+#define REPLAY_LOG_SIZE		65536
+/* Number of passes over the log for each chunk size */
+#define REPLAY_PASSES		10
+
+static uint8_t replay_log[REPLAY_LOG_SIZE];
+
+/*
+ * Number of bytes handed to the parser at once: single byte receive
+ * interrupts, a hardware FIFO, and DMA blocks.
+ */
+static const uint32_t replay_chunks[] = {1, 16, 64, 256};
+
+static uint32_t replay_pvt_cnt;
+static struct gnss_dev replay_dev;
+
+/**
+ * @brief Count the decoded NAV-PVT messages.
+ * @param ctx - unused.
+ * @param nav_data - the decoded message.
+ */
+static void replay_nav_pvt(void *ctx, const struct gnss_ubx_nav_pvt *nav_data)
+{
+	replay_pvt_cnt++;
+}
+
+/**
+ * @brief Get the time elapsed since a timestamp.
+ * @param start - the timestamp.
+ * @return elapsed time in microseconds.
+ */
+static uint64_t replay_elapsed_us(struct no_os_time start)
+{
+	struct no_os_time now = no_os_get_time();
+
+	return ((uint64_t)now.s - start.s) * 1000000 + now.us - start.us;
+}
+
+/**
+ * @brief Receive the captured log over the console UART.
+ *
+ * The host sends the log size as a 32-bit little endian value, followed by
+ * the raw bytes captured from the receiver UART.
+ * @param uart - the console UART.
+ * @param size - size of the received log.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int replay_receive_log(struct no_os_uart_desc *uart, uint32_t *size)
+{
+	uint8_t hdr[4];
+	int ret;
+
+	pr_info("Waiting for log: <size (u32 LE)><data>\n");
+
+	ret = no_os_uart_read(uart, hdr, sizeof(hdr));
+	if (ret < 0)
+		return ret;
+
+	*size = no_os_get_unaligned_le32(hdr);
+	if (!*size || *size > REPLAY_LOG_SIZE)
+		return -EFBIG;
+
+	ret = no_os_uart_read(uart, replay_log, *size);
+	if (ret < 0)
+		return ret;
+
+	return 0;
+}
+
+/**
+ * @brief Replay the log through the streaming parser.
+ * @param size - size of the log.
+ * @param chunk - number of bytes handed to the parser at once.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int replay_run(uint32_t size, uint32_t chunk)
+{
+	struct gnss_stream_init_param stream_ip = {
+		.nav_pvt_cb = replay_nav_pvt,
+	};
+	struct gnss_dev *dev = &replay_dev;
+	struct gnss_stream_stats stats;
+	struct no_os_time start;
+	uint32_t pass, i, len, frames;
+	uint64_t elapsed;
+	int ret;
+
+	memset(dev, 0, sizeof(*dev));
+	dev->device_type = GNSS_DEVICE_UBX_CAPABLE;
+
+	ret = gnss_stream_init(dev, &stream_ip);
+	if (ret)
+		return ret;
+
+	replay_pvt_cnt = 0;
+	start = no_os_get_time();
+
+	for (pass = 0; pass < REPLAY_PASSES; pass++) {
+		for (i = 0; i < size; i += len) {
+			len = no_os_min(chunk, size - i);
+			ret = gnss_stream_feed(dev, &replay_log[i], len);
+			if (ret < 0)
+				goto out;
+
+			ret = gnss_stream_process(dev);
+			if (ret)
+				goto out;
+		}
+	}
+
+	elapsed = replay_elapsed_us(start);
+
+	ret = gnss_stream_get_stats(dev, &stats);
+	if (ret)
+		goto out;
+
+	frames = stats.ubx_frames + stats.nmea_sentences;
+	pr_info("chunk %3" PRIu32 ": %" PRIu32 " us, %" PRIu32 " kB/s, %" PRIu32
+		" ns/frame\n", chunk, (uint32_t)elapsed,
+		elapsed ? (uint32_t)((uint64_t)size * REPLAY_PASSES * 1000 /
+				     elapsed) : 0,
+		frames ? (uint32_t)(elapsed * 1000 / frames) : 0);
+	pr_info("           UBX %" PRIu32 ", NMEA %" PRIu32 ", NAV-PVT %" PRIu32
+		", NAV-TIMEUTC %" PRIu32 ", checksum errors %" PRIu32
+		", discarded %" PRIu32 "\n", stats.ubx_frames,
+		stats.nmea_sentences, replay_pvt_cnt, stats.nav_timeutc,
+		stats.checksum_errors, stats.discarded);
+
+	if (stats.nav_pvt)
+		pr_info("           last fix: type %d, %d SV, lat %" PRId32
+			", lon %" PRId32 " (1e-7 deg)\n", dev->nav_data.fixType,
+			dev->nav_data.numSV, dev->nav_data.lat, dev->nav_data.lon);
+out:
+	gnss_stream_remove(dev);
+
+	return ret;
+}
+
+int main(void)
+{
+	struct no_os_uart_desc *uart_console_desc;
+	uint32_t size;
+	size_t i;
+	int ret;
+
+	ret = no_os_uart_init(&uart_console_desc, &uart_console_ip);
+	if (ret)
+		goto error;
+
+	no_os_uart_stdio(uart_console_desc);
+
+	pr_info("\n");
+	pr_info("GNSS streaming parser replay benchmark\n");
+	pr_info("======================================\n");
+
+	while (1) {
+		ret = replay_receive_log(uart_console_desc, &size);
+		if (ret) {
+			pr_err("Log reception failed: %d\n", ret);
+			continue;
+		}
+
+		pr_info("Replaying %" PRIu32 " bytes, %d passes\n", size,
+			REPLAY_PASSES);
+
+		for (i = 0; i < NO_OS_ARRAY_SIZE(replay_chunks); i++) {
+			ret = replay_run(size, replay_chunks[i]);
+			if (ret)
+				goto remove_console_uart;
+		}
+	}
+
+remove_console_uart:
+	no_os_uart_remove(uart_console_desc);
+error:
+	if (ret < 0)
+		pr_err("ERROR\n");
+	return ret;
+}
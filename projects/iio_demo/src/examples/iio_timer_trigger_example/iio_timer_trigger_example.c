@@ -39,10 +39,57 @@
 #include "iio_dac_demo.h"
 #include "common_data.h"
 #include "no_os_util.h"
+#ifdef LINUX_PLATFORM
+#include <stdio.h>
+#include <inttypes.h>
+#include "linux_timer.h"
+#endif
 
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
 /******************************************************************************/
+#ifdef LINUX_PLATFORM
+/* Timers reported by iio_timer_trigger_report() */
+static struct no_os_timer_desc *iio_timer_trigger_timers[2];
+
+/***************************************************************************//**
+ * @brief Print the statistics of the trigger timers every
+ *        IIO_DEMO_TIMER_STATS_PERIOD_MS, then clear them. Used as IIO
+ *        application post step callback.
+ *
+ * @param arg - Not used.
+ *
+ * @return 0
+*******************************************************************************/
+static int iio_timer_trigger_report(void *arg)
+{
+	static const char * const names[] = {"adc", "dac"};
+	struct linux_timer_stats stats;
+	uint64_t elapsed;
+	uint32_t i;
+
+	no_os_timer_get_elapsed_time_nsec(iio_timer_trigger_timers[0], &elapsed);
+	if (elapsed < IIO_DEMO_TIMER_STATS_PERIOD_MS * 1000000ULL)
+		return 0;
+
+	for (i = 0; i < NO_OS_ARRAY_SIZE(iio_timer_trigger_timers); i++) {
+		linux_timer_get_stats(iio_timer_trigger_timers[i], &stats);
+		linux_timer_reset_stats(iio_timer_trigger_timers[i]);
+		printf("%s trigger: %"PRIu64" Hz (period %"PRIu64" ns), "
+		       "%"PRIu64" overruns, latency min/avg/max %"PRIu64"/%"PRIu64
+		       "/%"PRIu64" ns, callback max %"PRIu64" ns\n", names[i],
+		       stats.ticks * 1000000000 / elapsed, stats.period_ns,
+		       stats.overruns, stats.latency_min_ns, stats.latency_avg_ns,
+		       stats.latency_max_ns, stats.callback_max_ns);
+	}
+
+	/* Restart the report period */
+	no_os_timer_counter_set(iio_timer_trigger_timers[0], 0);
+
+	return 0;
+}
+#endif
+
 /***************************************************************************//**
  * @brief IIO trigger example main execution.
  *
@@ -172,6 +219,16 @@ int iio_timer_trigger_example_main()
 	app_init_param.trigs = trigs;
 	app_init_param.nb_trigs = NO_OS_ARRAY_SIZE(trigs);
 	app_init_param.irq_desc = NULL;
+#ifdef LINUX_PLATFORM
+	/*
+	 * The trigger callbacks run on the timer threads. Both controllers
+	 * share the timer callback lock, so either keeps them out of iio_step().
+	 */
+	app_init_param.irq_desc = adc_demo_irq_desc;
+	iio_timer_trigger_timers[0] = adc_demo_tim_desc;
+	iio_timer_trigger_timers[1] = dac_demo_tim_desc;
+	app_init_param.post_step_callback = iio_timer_trigger_report;
+#endif
 
 	ret = iio_app_init(&app, app_init_param);
 	if (ret)
@@ -32,3 +32,11 @@
 *******************************************************************************/
 
 #include "parameters.h"
+
+#ifdef CONFIG_IIO_DEMO_IIO_TIMER_TRIGGER_EXAMPLE
+struct linux_timer_init_param iio_demo_timer_extra_ip = {
+	.cpu = LINUX_THREAD_ANY_CPU,
+	/* SCHED_FIFO needs CAP_SYS_NICE, 0 runs the timers as normal threads */
+	.priority = 0,
+};
+#endif
@@ -36,6 +36,11 @@
 
 #include "common_data.h"
 #include "no_os_util.h"
+#ifdef CONFIG_IIO_DEMO_IIO_TIMER_TRIGGER_EXAMPLE
+#include "no_os_timer.h"
+#include "linux_thread.h"
+#include "linux_timer.h"
+#endif
 
 /* This value can be modified based on the number
 of samples needed to be stored in the device buffer
@@ -48,4 +53,41 @@ and based on the available RAM memory of the platform */
 #define UART_EXTRA      NULL
 #define UART_OPS        NULL
 
+#ifdef CONFIG_IIO_DEMO_IIO_TIMER_TRIGGER_EXAMPLE
+extern struct linux_timer_init_param iio_demo_timer_extra_ip;
+
+/* Adc Demo Timer settings, 50 kHz */
+#define ADC_DEMO_TIMER_DEVICE_ID    0
+#define ADC_DEMO_TIMER_FREQ_HZ      1000000
+#define ADC_DEMO_TIMER_TICKS_COUNT  20
+#define ADC_DEMO_TIMER_EXTRA        &iio_demo_timer_extra_ip
+#define TIMER_OPS                   &linux_timer_ops
+
+/* Adc Demo Timer trigger settings, the interrupt ID is the timer ID */
+#define ADC_DEMO_TIMER_IRQ_ID       ADC_DEMO_TIMER_DEVICE_ID
+#define TIMER_IRQ_OPS               &linux_timer_irq_ops
+#define ADC_DEMO_TIMER_IRQ_EXTRA    NULL
+
+/* Adc Demo timer trigger settings */
+#define ADC_DEMO_TIMER_CB_HANDLE    NULL
+#define ADC_DEMO_TIMER_TRIG_IRQ_ID  ADC_DEMO_TIMER_DEVICE_ID
+
+/* Dac Demo Timer settings, 50 kHz */
+#define DAC_DEMO_TIMER_DEVICE_ID    1
+#define DAC_DEMO_TIMER_FREQ_HZ      1000000
+#define DAC_DEMO_TIMER_TICKS_COUNT  20
+#define DAC_DEMO_TIMER_EXTRA        &iio_demo_timer_extra_ip
+
+/* Dac Demo Timer trigger settings */
+#define DAC_DEMO_TIMER_IRQ_ID       DAC_DEMO_TIMER_DEVICE_ID
+#define DAC_DEMO_TIMER_IRQ_EXTRA    NULL
+
+/* Dac Demo timer trigger settings */
+#define DAC_DEMO_TIMER_CB_HANDLE    NULL
+#define DAC_DEMO_TIMER_TRIG_IRQ_ID  DAC_DEMO_TIMER_DEVICE_ID
+
+/* Period of the timer statistics report */
+#define IIO_DEMO_TIMER_STATS_PERIOD_MS	1000
+#endif
+
 #endif /* __PARAMETERS_H__ */
@@ -0,0 +1,426 @@
+/***************************************************************************//**
+ *   @file   scan_bench_example.c
+ *   @brief  Telemetry benchmark of the PMBus scanner against an emulated LTM4700
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <string.h>
+#include <inttypes.h>
+#include "common_data.h"
+#include "no_os_alloc.h"
+#include "no_os_error.h"
+#include "no_os_print_log.h"
+#include "no_os_util.h"
+
+#include "ltm4700.h"
+#include "pmbus.h"
+
+/* Number of telemetry sweeps for each access method */
+#define BENCH_SWEEPS		100
+
+/* Modeled I2C clock, used to convert the bus traffic to time */
+#define BENCH_I2C_HZ		400000
+
+/*
+ * Block command returning the telemetry words of the selected page. It is
+ * only implemented by the emulated target, to measure the block read path of
+ * the scanner on parts providing such a command.
+ */
+#define BENCH_BLOCK_CMD		0xF0
+
+#define BENCH_NUM_PAGES		2
+
+/**
+ * @brief Emulated PMBus target and bus traffic counters.
+ */
+struct bench_emu {
+	uint8_t page;
+	uint8_t cmd;
+	uint16_t regs[BENCH_NUM_PAGES][256];
+	/* Transactions, a command write followed by a repeated start counts once */
+	uint32_t transfers;
+	/* Bus bit times, including START, address and ACK bits */
+	uint32_t bits;
+};
+
+static struct bench_emu emu;
+
+/* Telemetry in the order of the LTM4700 IIO channels */
+static const struct pmbus_sensor bench_sensors[] = {
+	{"vin", PMBUS_SENSOR_VOLTAGE, PMBUS_NO_PAGE, LTM4700_READ_VIN, PMBUS_FORMAT_LINEAR11},
+	{"vout0", PMBUS_SENSOR_VOLTAGE, 0, LTM4700_READ_VOUT, PMBUS_FORMAT_LINEAR16},
+	{"vout1", PMBUS_SENSOR_VOLTAGE, 1, LTM4700_READ_VOUT, PMBUS_FORMAT_LINEAR16},
+	{"iin", PMBUS_SENSOR_CURRENT, PMBUS_NO_PAGE, LTM4700_READ_IIN, PMBUS_FORMAT_LINEAR11},
+	{"iout0", PMBUS_SENSOR_CURRENT, 0, LTM4700_READ_IOUT, PMBUS_FORMAT_LINEAR11},
+	{"iout1", PMBUS_SENSOR_CURRENT, 1, LTM4700_READ_IOUT, PMBUS_FORMAT_LINEAR11},
+	{"temp_ext0", PMBUS_SENSOR_TEMP, 0, LTM4700_READ_TEMPERATURE_1, PMBUS_FORMAT_LINEAR11},
+	{"temp_ext1", PMBUS_SENSOR_TEMP, 1, LTM4700_READ_TEMPERATURE_1, PMBUS_FORMAT_LINEAR11},
+	{"temp_ic", PMBUS_SENSOR_TEMP, PMBUS_NO_PAGE, LTM4700_READ_TEMPERATURE_2, PMBUS_FORMAT_LINEAR11},
+	{"frequency0", PMBUS_SENSOR_FREQUENCY, 0, LTM4700_READ_FREQUENCY, PMBUS_FORMAT_LINEAR11},
+	{"frequency1", PMBUS_SENSOR_FREQUENCY, 1, LTM4700_READ_FREQUENCY, PMBUS_FORMAT_LINEAR11},
+	{"pout0", PMBUS_SENSOR_POWER, 0, LTM4700_READ_POUT, PMBUS_FORMAT_LINEAR11},
+	{"pout1", PMBUS_SENSOR_POWER, 1, LTM4700_READ_POUT, PMBUS_FORMAT_LINEAR11},
+	{"status0", PMBUS_SENSOR_STATUS, 0, LTM4700_STATUS_WORD, PMBUS_FORMAT_WORD},
+	{"status1", PMBUS_SENSOR_STATUS, 1, LTM4700_STATUS_WORD, PMBUS_FORMAT_WORD},
+};
+
+static const uint8_t bench_block_cmds[] = {
+	LTM4700_READ_VOUT,
+	LTM4700_READ_IOUT,
+	LTM4700_READ_TEMPERATURE_1,
+	LTM4700_READ_FREQUENCY,
+	LTM4700_READ_POUT,
+	LTM4700_STATUS_WORD,
+};
+
+static const struct pmbus_block bench_blocks[] = {
+	{0, BENCH_BLOCK_CMD, bench_block_cmds, NO_OS_ARRAY_SIZE(bench_block_cmds)},
+	{1, BENCH_BLOCK_CMD, bench_block_cmds, NO_OS_ARRAY_SIZE(bench_block_cmds)},
+};
+
+/**
+ * @brief Initialize the emulated I2C descriptor.
+ * @param desc - I2C descriptor.
+ * @param param - I2C initialization parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t bench_i2c_init(struct no_os_i2c_desc **desc,
+			      const struct no_os_i2c_init_param *param)
+{
+	struct no_os_i2c_desc *descriptor;
+
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	descriptor->device_id = param->device_id;
+	descriptor->slave_address = param->slave_address;
+	*desc = descriptor;
+
+	return 0;
+}
+
+/**
+ * @brief Emulate a PMBus write: PAGE, command selection or register write.
+ * @param desc - I2C descriptor.
+ * @param data - Written bytes.
+ * @param bytes_number - Number of bytes.
+ * @param stop_bit - Stop condition control.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t bench_i2c_write(struct no_os_i2c_desc *desc, uint8_t *data,
+			       uint8_t bytes_number, uint8_t stop_bit)
+{
+	/* START, address, data and STOP, 9 bit times per byte */
+	emu.bits += 1 + 9 * (1 + bytes_number) + (stop_bit ? 1 : 0);
+	emu.transfers++;
+
+	if (!bytes_number)
+		return -EINVAL;
+
+	emu.cmd = data[0];
+	if (emu.cmd == LTM4700_PAGE && bytes_number == 2)
+		emu.page = data[1] < BENCH_NUM_PAGES ? data[1] : 0;
+	else if (bytes_number == 2)
+		emu.regs[emu.page][emu.cmd] = data[1];
+	else if (bytes_number == 3)
+		emu.regs[emu.page][emu.cmd] = no_os_get_unaligned_le16(&data[1]);
+
+	return 0;
+}
+
+/**
+ * @brief Emulate a PMBus read of the last selected command.
+ * @param desc - I2C descriptor.
+ * @param data - Read bytes.
+ * @param bytes_number - Number of bytes.
+ * @param stop_bit - Stop condition control.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t bench_i2c_read(struct no_os_i2c_desc *desc, uint8_t *data,
+			      uint8_t bytes_number, uint8_t stop_bit)
+{
+	const char *str = NULL;
+	uint8_t i;
+
+	/* Repeated START, address, data and STOP */
+	emu.bits += 1 + 9 * (1 + bytes_number) + 1;
+
+	memset(data, 0xFF, bytes_number);
+
+	switch (emu.cmd) {
+	case LTM4700_MFR_ID:
+		str = LTM4700_MFR_ID_VALUE;
+		break;
+	case LTM4700_MFR_MODEL:
+		str = LTM4700_MFR_MODEL_VALUE;
+		break;
+	case BENCH_BLOCK_CMD:
+		data[0] = 2 * NO_OS_ARRAY_SIZE(bench_block_cmds);
+		for (i = 0; i < NO_OS_ARRAY_SIZE(bench_block_cmds) &&
+		     2 * i + 2 < bytes_number; i++)
+			no_os_put_unaligned_le16(emu.regs[emu.page][bench_block_cmds[i]],
+						 &data[1 + 2 * i]);
+		return 0;
+	default:
+		data[0] = emu.regs[emu.page][emu.cmd] & 0xFF;
+		if (bytes_number > 1)
+			data[1] = emu.regs[emu.page][emu.cmd] >> 8;
+		return 0;
+	}
+
+	data[0] = strlen(str);
+	memcpy(&data[1], str, no_os_min((uint8_t)strlen(str), bytes_number - 1));
+
+	return 0;
+}
+
+/**
+ * @brief Free the emulated I2C descriptor.
+ * @param desc - I2C descriptor.
+ * @return 0
+ */
+static int32_t bench_i2c_remove(struct no_os_i2c_desc *desc)
+{
+	no_os_free(desc);
+
+	return 0;
+}
+
+static const struct no_os_i2c_platform_ops bench_i2c_ops = {
+	.i2c_ops_init = bench_i2c_init,
+	.i2c_ops_write = bench_i2c_write,
+	.i2c_ops_read = bench_i2c_read,
+	.i2c_ops_remove = bench_i2c_remove,
+};
+
+/**
+ * @brief Load the emulated LTM4700 registers with plausible telemetry.
+ */
+static void bench_emu_setup(void)
+{
+	uint8_t p;
+
+	memset(&emu, 0, sizeof(emu));
+
+	for (p = 0; p < BENCH_NUM_PAGES; p++) {
+		emu.regs[p][LTM4700_MFR_SPECIAL_ID] = LTM4700_SPECIAL_ID_VALUE;
+		emu.regs[p][LTM4700_VOUT_MODE] = (uint8_t)LTM4700_LIN16_EXPONENT &
+						 PMBUS_VOUT_MODE_EXP_MSK;
+		emu.regs[p][LTM4700_READ_VIN] = pmbus_milli_to_lin11(12000);
+		emu.regs[p][LTM4700_READ_IIN] = pmbus_milli_to_lin11(1750);
+		emu.regs[p][LTM4700_READ_TEMPERATURE_2] = pmbus_milli_to_lin11(41500);
+		emu.regs[p][LTM4700_READ_PIN] = pmbus_milli_to_lin11(21000);
+		emu.regs[p][LTM4700_READ_VOUT] = pmbus_milli_to_lin16(900 + 300 * p,
+						 LTM4700_LIN16_EXPONENT);
+		emu.regs[p][LTM4700_READ_IOUT] = pmbus_milli_to_lin11(8250 + 1000 * p);
+		emu.regs[p][LTM4700_READ_TEMPERATURE_1] = pmbus_milli_to_lin11(52250 + p * 500);
+		emu.regs[p][LTM4700_READ_FREQUENCY] = pmbus_milli_to_lin11(500000);
+		emu.regs[p][LTM4700_READ_POUT] = pmbus_milli_to_lin11(7425 + 3000 * p);
+		emu.regs[p][LTM4700_STATUS_WORD] = 0x0800 * p;
+	}
+}
+
+/**
+ * @brief Read the telemetry one attribute at a time, as done by the LTM4700
+ * driver when an IIO client reads the channels.
+ * @param dev - LTM4700 device.
+ * @param vals - Values in milli-units, in sensor order.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int bench_legacy(struct ltm4700_dev *dev, int32_t *vals)
+{
+	const struct pmbus_sensor *s;
+	uint16_t word;
+	size_t i;
+	int ret;
+
+	for (i = 0; i < NO_OS_ARRAY_SIZE(bench_sensors); i++) {
+		s = &bench_sensors[i];
+
+		if (s->format == PMBUS_FORMAT_WORD) {
+			ret = ltm4700_read_word(dev, no_os_max(s->page, 0), s->cmd,
+						&word);
+			vals[i] = word;
+		} else {
+			ret = ltm4700_read_word_data(dev, no_os_max(s->page, 0), s->cmd,
+						     (int *)&vals[i]);
+		}
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Print the bus traffic of one telemetry sweep.
+ * @param name - Name of the measured path.
+ */
+static void bench_report(const char *name)
+{
+	uint32_t us = (uint64_t)emu.bits * 1000000 / BENCH_I2C_HZ / BENCH_SWEEPS;
+
+	pr_info("%-8s %3" PRIu32 " transactions, %5" PRIu32 " bit times, %5"
+		PRIu32 " us per sweep at %d kHz\n", name,
+		emu.transfers / BENCH_SWEEPS, emu.bits / BENCH_SWEEPS, us,
+		BENCH_I2C_HZ / 1000);
+}
+
+/**
+ * @brief Scan the telemetry using the PMBus scanner.
+ * @param blocks - Block commands to use, may be NULL.
+ * @param nb_blocks - Number of block commands.
+ * @param ref - Values read using the LTM4700 driver, to compare against.
+ * @param i2c_param - I2C initialization parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int bench_scan(const struct pmbus_block *blocks, uint8_t nb_blocks,
+		      const int32_t *ref, struct no_os_i2c_init_param *i2c_param)
+{
+	int32_t vals[NO_OS_ARRAY_SIZE(bench_sensors)];
+	struct pmbus_init_param pmbus_ip = {
+		.i2c_init = i2c_param,
+		.num_pages = BENCH_NUM_PAGES,
+		.blocks = blocks,
+		.nb_blocks = nb_blocks,
+	};
+	struct pmbus_scan_init_param scan_ip = {
+		.sensors = bench_sensors,
+		.nb_sensors = NO_OS_ARRAY_SIZE(bench_sensors),
+	};
+	struct pmbus_scan *scan;
+	struct pmbus_dev *dev;
+	uint32_t i;
+	int ret;
+
+	ret = pmbus_init(&dev, &pmbus_ip);
+	if (ret)
+		return ret;
+
+	scan_ip.dev = dev;
+	ret = pmbus_scan_init(&scan, &scan_ip);
+	if (ret)
+		goto free_dev;
+
+	emu.transfers = 0;
+	emu.bits = 0;
+	for (i = 0; i < BENCH_SWEEPS; i++) {
+		ret = pmbus_scan_run(scan);
+		if (ret)
+			goto free_scan;
+	}
+	bench_report(nb_blocks ? "block" : "grouped");
+
+	ret = pmbus_scan_get(scan, vals, NULL);
+	if (ret)
+		goto free_scan;
+
+	for (i = 0; i < NO_OS_ARRAY_SIZE(bench_sensors); i++)
+		if (vals[i] != ref[i])
+			pr_info("%s: %" PRId32 " != %" PRId32 "\n",
+				bench_sensors[i].name, vals[i], ref[i]);
+
+free_scan:
+	pmbus_scan_remove(scan);
+free_dev:
+	pmbus_remove(dev);
+
+	return ret;
+}
+
+/***************************************************************************//**
+ * @brief Telemetry benchmark of the PMBus scanner.
+ *
+ * The LTM4700 is emulated by a stand-in I2C layer, which also models the bus
+ * time of each transaction. The same telemetry is read using the LTM4700
+ * driver one attribute at a time, then using the scanner with word reads
+ * grouped by page and finally using the scanner with block reads.
+ *
+ * @return ret - Result of the example execution.
+*******************************************************************************/
+int example_main()
+{
+	int32_t ref[NO_OS_ARRAY_SIZE(bench_sensors)];
+	struct no_os_i2c_init_param bench_i2c_ip = i2c_ip;
+	struct ltm4700_init_param bench_ltm4700_ip = ltm4700_ip;
+	struct no_os_uart_desc *uart_desc;
+	struct ltm4700_dev *dev;
+	uint32_t i;
+	int ret;
+
+	ret = no_os_uart_init(&uart_desc, &uart_ip);
+	if (ret)
+		return ret;
+
+	no_os_uart_stdio(uart_desc);
+	pr_info("LTM4700 PMBus scan benchmark, %d sweeps of %d values.\n",
+		BENCH_SWEEPS, (int)NO_OS_ARRAY_SIZE(bench_sensors));
+
+	bench_emu_setup();
+	bench_i2c_ip.platform_ops = &bench_i2c_ops;
+	bench_ltm4700_ip.i2c_init = &bench_i2c_ip;
+
+	ret = ltm4700_init(&dev, &bench_ltm4700_ip);
+	if (ret)
+		goto error;
+
+	emu.transfers = 0;
+	emu.bits = 0;
+	for (i = 0; i < BENCH_SWEEPS; i++) {
+		ret = bench_legacy(dev, ref);
+		if (ret)
+			goto error_ltm4700;
+	}
+	bench_report("legacy");
+
+	ret = ltm4700_remove(dev);
+	if (ret)
+		goto error;
+
+	ret = bench_scan(NULL, 0, ref, &bench_i2c_ip);
+	if (ret)
+		goto error;
+
+	ret = bench_scan(bench_blocks, NO_OS_ARRAY_SIZE(bench_blocks), ref,
+			 &bench_i2c_ip);
+	if (ret)
+		goto error;
+
+	no_os_uart_remove(uart_desc);
+
+	return 0;
+
+error_ltm4700:
+	ltm4700_remove(dev);
+error:
+	pr_err("Error %d!\n", ret);
+	no_os_uart_remove(uart_desc);
+
+	return ret;
+}
@@ -0,0 +1,5 @@
+INCS += $(PLATFORM_DRIVERS)/linux_thread.h
+
+SRCS += $(PLATFORM_DRIVERS)/linux_mutex.c	\
+	$(PLATFORM_DRIVERS)/linux_semaphore.c	\
+	$(PLATFORM_DRIVERS)/linux_thread.c
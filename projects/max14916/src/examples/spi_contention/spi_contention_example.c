@@ -0,0 +1,415 @@
+/***************************************************************************//**
+ *   @file   max14916/src/examples/spi_contention/spi_contention_example.c
+ *   @brief  Source file for the shared SPI bus contention benchmark.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <inttypes.h>
+#include <string.h>
+#include <time.h>
+#include "no_os_alloc.h"
+#include "no_os_error.h"
+#include "no_os_print_log.h"
+#include "no_os_spi.h"
+#include "no_os_util.h"
+#include "linux_thread.h"
+
+/* Emulated SCLK frequency of the shared bus */
+#define BENCH_SPI_HZ		10000000
+/* Iterations of the acquisition and IIOD clients */
+#define BENCH_ACQ_CNT		4000
+#define BENCH_IIOD_CNT		2000
+/* One storage block is queued every BENCH_STORE_DIV acquisitions */
+#define BENCH_STORE_DIV		32
+#define BENCH_STORE_LEN		256
+
+/**
+ * @brief Emulated bus state, shared by all the chip selects.
+ */
+struct bench_bus {
+	/** Chip select + 1 of the device owning the bus, 0 if idle */
+	uint32_t owner;
+	/** Bytes clocked on the bus */
+	uint64_t bytes;
+	/** Messages started while another device owned the bus */
+	uint32_t collisions;
+	/** Time spent clocking data, in ns */
+	uint64_t busy_ns;
+};
+
+/**
+ * @brief Statistics of a bus client.
+ */
+struct bench_client {
+	const char *name;
+	struct no_os_spi_desc *spi;
+	uint32_t calls;
+	uint64_t total_ns;
+	uint64_t max_ns;
+};
+
+static struct bench_bus bus;
+
+static struct bench_client acq = {.name = "acquisition"};
+static struct bench_client iiod = {.name = "iiod"};
+static struct bench_client store = {.name = "storage"};
+
+static uint8_t store_block[BENCH_STORE_LEN];
+static struct linux_workqueue *store_wq;
+static struct linux_work store_work;
+
+/**
+ * @brief Get the monotonic time.
+ * @return Time in ns.
+ */
+static uint64_t bench_now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/**
+ * @brief Clock a message on the emulated bus, flagging any message started
+ * while the bus is owned by another chip select.
+ * @param desc - SPI descriptor.
+ * @param bytes_number - Number of bytes.
+ * @param cs_change - Release the bus after the message.
+ */
+static void bench_bus_clock(struct no_os_spi_desc *desc, uint32_t bytes_number,
+			    bool cs_change)
+{
+	uint32_t owner = desc->chip_select + 1;
+	uint32_t prev = 0;
+	uint64_t ns;
+	uint64_t end;
+
+	if (!__atomic_compare_exchange_n(&bus.owner, &prev, owner, false,
+					 __ATOMIC_ACQUIRE, __ATOMIC_RELAXED) &&
+	    prev != owner)
+		__atomic_fetch_add(&bus.collisions, 1, __ATOMIC_RELAXED);
+
+	ns = (uint64_t)bytes_number * 8 * 1000000000ULL / desc->max_speed_hz;
+	end = bench_now_ns() + ns;
+	while (bench_now_ns() < end)
+		;
+	__atomic_fetch_add(&bus.busy_ns, ns, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&bus.bytes, bytes_number, __ATOMIC_RELAXED);
+
+	if (cs_change) {
+		prev = owner;
+		__atomic_compare_exchange_n(&bus.owner, &prev, 0, false,
+					    __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+	}
+}
+
+/**
+ * @brief Initialize an emulated SPI device.
+ * @param desc - SPI descriptor.
+ * @param param - SPI initialization parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t bench_spi_init(struct no_os_spi_desc **desc,
+			      const struct no_os_spi_init_param *param)
+{
+	struct no_os_spi_desc *descriptor;
+
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	descriptor->device_id = param->device_id;
+	descriptor->max_speed_hz = param->max_speed_hz;
+	descriptor->chip_select = param->chip_select;
+	descriptor->mode = param->mode;
+	*desc = descriptor;
+
+	return 0;
+}
+
+/**
+ * @brief Clock a single message, CS is released at the end.
+ * @param desc - SPI descriptor.
+ * @param data - SPI buffer.
+ * @param bytes_number - number of bytes.
+ * @return 0
+ */
+static int32_t bench_spi_write_and_read(struct no_os_spi_desc *desc,
+					uint8_t *data, uint16_t bytes_number)
+{
+	bench_bus_clock(desc, bytes_number, true);
+
+	return 0;
+}
+
+/**
+ * @brief Clock a chain of messages, CS is held between messages unless
+ * cs_change is set.
+ * @param desc - SPI descriptor.
+ * @param msgs - SPI messages.
+ * @param len - number of messages.
+ * @return 0
+ */
+static int32_t bench_spi_transfer(struct no_os_spi_desc *desc,
+				  struct no_os_spi_msg *msgs, uint32_t len)
+{
+	uint32_t i;
+
+	for (i = 0; i < len; i++)
+		bench_bus_clock(desc, msgs[i].bytes_number,
+				msgs[i].cs_change || i == len - 1);
+
+	return 0;
+}
+
+/**
+ * @brief Free an emulated SPI device.
+ * @param desc - SPI descriptor.
+ * @return 0
+ */
+static int32_t bench_spi_remove(struct no_os_spi_desc *desc)
+{
+	no_os_free(desc);
+
+	return 0;
+}
+
+static const struct no_os_spi_platform_ops bench_spi_ops = {
+	.init = bench_spi_init,
+	.write_and_read = bench_spi_write_and_read,
+	.transfer = bench_spi_transfer,
+	.remove = bench_spi_remove,
+};
+
+/**
+ * @brief Account the latency of a bus access.
+ * @param client - Bus client.
+ * @param start - Start time of the access, in ns.
+ */
+static void bench_account(struct bench_client *client, uint64_t start)
+{
+	uint64_t ns = bench_now_ns() - start;
+
+	client->calls++;
+	client->total_ns += ns;
+	client->max_ns = no_os_max(client->max_ns, ns);
+}
+
+/**
+ * @brief Storage work item, writes a block to the storage device.
+ * @param ctx - unused.
+ */
+static void bench_store(void *ctx)
+{
+	uint64_t start = bench_now_ns();
+
+	no_os_spi_write_and_read(store.spi, store_block, sizeof(store_block));
+	bench_account(&store, start);
+}
+
+/**
+ * @brief Acquisition thread: command and data phases with CS held, which
+ * must not be interleaved with other devices.
+ * @param ctx - unused.
+ */
+static void bench_acq(void *ctx)
+{
+	uint8_t cmd[2] = {0};
+	uint8_t data[6] = {0};
+	struct no_os_spi_msg msgs[] = {
+		{.tx_buff = cmd, .rx_buff = cmd, .bytes_number = sizeof(cmd)},
+		{.tx_buff = data, .rx_buff = data, .bytes_number = sizeof(data)},
+	};
+	uint64_t start;
+	uint32_t i;
+
+	for (i = 0; i < BENCH_ACQ_CNT; i++) {
+		start = bench_now_ns();
+		no_os_spi_transfer(acq.spi, msgs, NO_OS_ARRAY_SIZE(msgs));
+		bench_account(&acq, start);
+
+		if (!((i + 1) % BENCH_STORE_DIV))
+			linux_workqueue_queue(store_wq, &store_work);
+	}
+}
+
+/**
+ * @brief IIOD thread: register reads on behalf of the IIO clients.
+ * @param ctx - unused.
+ */
+static void bench_iiod(void *ctx)
+{
+	uint8_t reg[3] = {0};
+	uint64_t start;
+	uint32_t i;
+
+	for (i = 0; i < BENCH_IIOD_CNT; i++) {
+		start = bench_now_ns();
+		no_os_spi_write_and_read(iiod.spi, reg, sizeof(reg));
+		bench_account(&iiod, start);
+	}
+}
+
+/**
+ * @brief Print the statistics of a bus client.
+ * @param client - Bus client.
+ */
+static void bench_print_client(struct bench_client *client)
+{
+	pr_info("  %-12s %6" PRIu32 " calls, avg %6" PRIu64 " ns, max %8"
+		PRIu64 " ns\r\n", client->name, client->calls,
+		client->calls ? client->total_ns / client->calls : 0,
+		client->max_ns);
+}
+
+/**
+ * @brief Run the three bus clients concurrently.
+ * @param name - Name of the run.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int bench_run(const char *name)
+{
+	struct linux_thread_init_param thread_ip = {
+		.cpu = LINUX_THREAD_ANY_CPU,
+	};
+	struct linux_thread *acq_thread;
+	struct linux_thread *iiod_thread;
+	uint64_t start;
+	uint64_t elapsed;
+	int ret;
+
+	memset(&bus, 0, sizeof(bus));
+	acq.calls = iiod.calls = store.calls = 0;
+	acq.total_ns = iiod.total_ns = store.total_ns = 0;
+	acq.max_ns = iiod.max_ns = store.max_ns = 0;
+
+	start = bench_now_ns();
+
+	thread_ip.func = bench_acq;
+	thread_ip.name = "acq";
+	ret = linux_thread_create(&acq_thread, &thread_ip);
+	if (ret)
+		return ret;
+
+	thread_ip.func = bench_iiod;
+	thread_ip.name = "iiod";
+	ret = linux_thread_create(&iiod_thread, &thread_ip);
+	if (ret) {
+		linux_thread_join(acq_thread);
+		return ret;
+	}
+
+	linux_thread_join(acq_thread);
+	linux_thread_join(iiod_thread);
+	linux_workqueue_flush(store_wq);
+
+	elapsed = bench_now_ns() - start;
+
+	pr_info("%s: %" PRIu64 " us, %" PRIu64 " accesses/s, %" PRIu64
+		" kB/s, bus busy %" PRIu64 "%%, %" PRIu32 " collisions\r\n",
+		name, elapsed / 1000,
+		(uint64_t)(acq.calls + iiod.calls + store.calls) *
+		1000000000ULL / elapsed, bus.bytes * 1000000ULL / elapsed,
+		bus.busy_ns * 100 / elapsed, bus.collisions);
+	bench_print_client(&acq);
+	bench_print_client(&iiod);
+	bench_print_client(&store);
+
+	return 0;
+}
+
+/**
+ * @brief Shared SPI bus contention benchmark.
+ *
+ * An acquisition thread, an IIOD thread and a storage work queue share one
+ * emulated SPI bus with a device each. The run is done with the no_os_spi bus
+ * lock and then with the lock bypassed, the way the weak no-op mutex stubs
+ * behave, counting the messages started while another device held CS. The
+ * results are printed on stdout, no hardware is needed.
+ *
+ * @return ret - Result of the example execution.
+ */
+int example_main()
+{
+	struct linux_workqueue_init_param wq_ip = {
+		.nb_workers = 1,
+		.name = "storage",
+		.cpu = LINUX_THREAD_ANY_CPU,
+	};
+	struct no_os_spi_init_param spi_ip = {
+		.device_id = 0,
+		.max_speed_hz = BENCH_SPI_HZ,
+		.mode = NO_OS_SPI_MODE_0,
+		.platform_ops = &bench_spi_ops,
+	};
+	void *bus_lock;
+	int ret;
+
+	spi_ip.chip_select = 0;
+	ret = no_os_spi_init(&acq.spi, &spi_ip);
+	if (ret)
+		return ret;
+
+	spi_ip.chip_select = 1;
+	ret = no_os_spi_init(&iiod.spi, &spi_ip);
+	if (ret)
+		goto remove_acq;
+
+	spi_ip.chip_select = 2;
+	ret = no_os_spi_init(&store.spi, &spi_ip);
+	if (ret)
+		goto remove_iiod;
+
+	store_work.func = bench_store;
+	ret = linux_workqueue_init(&store_wq, &wq_ip);
+	if (ret)
+		goto remove_store;
+
+	ret = bench_run("bus lock");
+	if (ret)
+		goto remove_wq;
+
+	/* All the descriptors share the bus, hence its lock. */
+	bus_lock = acq.spi->bus->mutex;
+	acq.spi->bus->mutex = NULL;
+	ret = bench_run("no lock");
+	acq.spi->bus->mutex = bus_lock;
+
+remove_wq:
+	linux_workqueue_remove(store_wq);
+remove_store:
+	no_os_spi_remove(store.spi);
+remove_iiod:
+	no_os_spi_remove(iiod.spi);
+remove_acq:
+	no_os_spi_remove(acq.spi);
+
+	return ret;
+}
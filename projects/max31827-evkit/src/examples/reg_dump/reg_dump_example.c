@@ -0,0 +1,197 @@
+/*******************************************************************************
+ *   @file   reg_dump_example.c
+ *   @brief  Register dump example code for max31827 project
+ *   @author John Erasmus Mari Geronimo (johnerasmusmari.geronimo@analog.com)
+ ********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *******************************************************************************/
+#include <string.h>
+#include "common_data.h"
+#include "max31827.h"
+#include "no_os_delay.h"
+#include "no_os_i2c.h"
+#include "no_os_print_log.h"
+#include "no_os_util.h"
+
+static const uint8_t reg_dump_regs[] = {
+	MAX31827_T_REG,
+	MAX31827_CONF_REG,
+	MAX31827_TH_REG,
+	MAX31827_TL_REG,
+	MAX31827_TH_HYST_REG,
+	MAX31827_TL_HYST_REG,
+};
+
+#define REG_DUMP_NB_REGS	NO_OS_ARRAY_SIZE(reg_dump_regs)
+
+/*****************************************************************************
+ * @brief Get the number of I2C syscalls issued so far.
+ *
+ * @param dev - The device structure.
+ *
+ * @return The I2C_RDWR ioctl count.
+ *******************************************************************************/
+static uint32_t reg_dump_syscalls(struct max31827_device *dev)
+{
+	return linux_i2c_get_ioctl_count(dev->i2c_desc);
+}
+
+/*****************************************************************************
+ * @brief Print a register dump along with the syscalls it took.
+ *
+ * @param name - Name of the access method.
+ * @param vals - Register values.
+ * @param syscalls - Number of syscalls used for the dump.
+ *******************************************************************************/
+static void reg_dump_print(const char *name, uint16_t *vals, uint32_t syscalls)
+{
+	uint32_t i;
+
+	pr_info("%s: %u syscalls\r\n", name, (unsigned int)syscalls);
+	for (i = 0; i < REG_DUMP_NB_REGS; i++)
+		pr_info("  0x%02x: 0x%04x\r\n", reg_dump_regs[i], vals[i]);
+}
+
+/*****************************************************************************
+ * @brief Register dump example main execution.
+ *
+ * Reads the MAX31827 register map three ways and reports the number of I2C
+ * syscalls used by each: one register at a time, with a single
+ * no_os_i2c_transfer() holding a repeated start write-then-read per
+ * register and with the plain read/write API inside a Linux I2C batch.
+ *
+ * @return ret - Result of the example execution.
+ *******************************************************************************/
+int example_main()
+{
+	struct no_os_i2c_msg msgs[2 * REG_DUMP_NB_REGS];
+	uint8_t raw[REG_DUMP_NB_REGS][2];
+	uint8_t addr[REG_DUMP_NB_REGS];
+	uint16_t vals[REG_DUMP_NB_REGS];
+	struct max31827_device *dev;
+	struct no_os_uart_desc *uart;
+	uint32_t start;
+	uint32_t i;
+	int ret;
+
+	ret = no_os_uart_init(&uart, &uip);
+	if (ret)
+		goto error;
+
+	no_os_uart_stdio(uart);
+
+	pr_info("\r\nRunning MAX31827 Register Dump Example\r\n");
+
+	ret = max31827_init(&dev, &max31827_ip);
+	if (ret)
+		goto free_uart;
+
+	/* One I2C_RDWR per register. */
+	start = reg_dump_syscalls(dev);
+	for (i = 0; i < REG_DUMP_NB_REGS; i++) {
+		ret = max31827_reg_read(dev, reg_dump_regs[i], &vals[i]);
+		if (ret)
+			goto free_dev;
+	}
+	reg_dump_print("max31827_reg_read", vals,
+		       reg_dump_syscalls(dev) - start);
+
+	/* The whole register map in a single transfer. */
+	for (i = 0; i < REG_DUMP_NB_REGS; i++) {
+		addr[i] = reg_dump_regs[i];
+		msgs[2 * i] = (struct no_os_i2c_msg) {
+			.data = &addr[i],
+			.bytes_number = 1,
+			.read = 0,
+			.stop_bit = 0,
+		};
+		msgs[2 * i + 1] = (struct no_os_i2c_msg) {
+			.data = raw[i],
+			.bytes_number = 2,
+			.read = 1,
+			.stop_bit = 1,
+		};
+	}
+
+	start = reg_dump_syscalls(dev);
+	ret = no_os_i2c_transfer(dev->i2c_desc, msgs, NO_OS_ARRAY_SIZE(msgs));
+	if (ret)
+		goto free_dev;
+
+	for (i = 0; i < REG_DUMP_NB_REGS; i++)
+		vals[i] = no_os_get_unaligned_be16(raw[i]);
+	reg_dump_print("no_os_i2c_transfer", vals,
+		       reg_dump_syscalls(dev) - start);
+
+	/*
+	 * Unmodified read/write calls, queued until the end of the batch. The
+	 * buffers must stay valid until linux_i2c_batch_end() returns.
+	 */
+	memset(raw, 0, sizeof(raw));
+	start = reg_dump_syscalls(dev);
+	ret = linux_i2c_batch_begin(dev->i2c_desc);
+	if (ret)
+		goto free_dev;
+
+	for (i = 0; i < REG_DUMP_NB_REGS; i++) {
+		ret = no_os_i2c_write(dev->i2c_desc, &addr[i], 1, 0);
+		if (ret)
+			break;
+
+		ret = no_os_i2c_read(dev->i2c_desc, raw[i], 2, 1);
+		if (ret)
+			break;
+	}
+
+	if (ret) {
+		linux_i2c_batch_end(dev->i2c_desc);
+		goto free_dev;
+	}
+
+	ret = linux_i2c_batch_end(dev->i2c_desc);
+	if (ret)
+		goto free_dev;
+
+	for (i = 0; i < REG_DUMP_NB_REGS; i++)
+		vals[i] = no_os_get_unaligned_be16(raw[i]);
+	reg_dump_print("linux_i2c batch", vals,
+		       reg_dump_syscalls(dev) - start);
+
+	max31827_remove(dev);
+	no_os_uart_remove(uart);
+
+	return 0;
+
+free_dev:
+	max31827_remove(dev);
+free_uart:
+	no_os_uart_remove(uart);
+error:
+	pr_info("Error!\r\n");
+	return ret;
+}
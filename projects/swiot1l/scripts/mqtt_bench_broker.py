@@ -0,0 +1,150 @@
+#!/usr/bin/env python3
+# Copyright 2026(c) Analog Devices, Inc.
+# SPDX-License-Identifier: BSD-3-Clause
+"""Stand-in MQTT broker for the swiot1l MQTT publish benchmark.
+
+Accepts a single MQTT 3.1.1 client, acknowledges its packets and checks the
+benchmark samples: every topic carries a 32 bit little endian counter, either
+one per message or in batches produced by the no-OS MQTT publisher. Use
+--ack-delay to emulate the round trip time to a remote broker.
+"""
+
+import argparse
+import asyncio
+import struct
+import time
+
+CONNECT, CONNACK, PUBLISH, PUBACK = 1, 2, 3, 4
+SUBSCRIBE, SUBACK, PINGREQ, PINGRESP, DISCONNECT = 8, 9, 12, 13, 14
+
+BATCH_FORMAT = 1
+BATCH_HDR = struct.Struct("<BBHII")
+
+
+class Stats:
+    def __init__(self):
+        self.packets = 0
+        self.dups = 0
+        self.samples = 0
+        self.errors = 0
+        self.expected = {}
+        self.start = None
+
+    def sample(self, topic, value):
+        expected = self.expected.get(topic, 0)
+        if value == 0 and expected:
+            # A new benchmark run starts over
+            self.report()
+            self.__init__()
+            expected = 0
+        if value != expected:
+            self.errors += 1
+        self.expected[topic] = value + 1
+        self.samples += 1
+
+    def report(self):
+        if not self.start:
+            return
+        elapsed = time.monotonic() - self.start
+        print(f"{self.samples} samples in {self.packets} packets "
+              f"({self.dups} duplicates), {elapsed:.3f} s, "
+              f"{self.samples / elapsed:.0f} samples/s, "
+              f"{self.errors} sequence errors")
+
+
+async def read_packet(reader):
+    hdr = await reader.readexactly(1)
+    length, mult = 0, 1
+    while True:
+        byte = (await reader.readexactly(1))[0]
+        length += (byte & 0x7F) * mult
+        if not byte & 0x80:
+            break
+        mult <<= 7
+    return hdr[0], await reader.readexactly(length)
+
+
+def handle_publish(flags, body, stats):
+    qos = (flags >> 1) & 3
+    topic_len = struct.unpack_from(">H", body)[0]
+    topic = body[2:2 + topic_len].decode()
+    pos = 2 + topic_len
+    packet_id = None
+    if qos:
+        packet_id = struct.unpack_from(">H", body, pos)[0]
+        pos += 2
+    payload = body[pos:]
+
+    if flags & 0x08:
+        stats.dups += 1
+        return packet_id
+
+    if stats.start is None:
+        stats.start = time.monotonic()
+    stats.packets += 1
+
+    if len(payload) == 4:
+        stats.sample(topic, struct.unpack("<I", payload)[0])
+    elif len(payload) >= BATCH_HDR.size and payload[0] == BATCH_FORMAT:
+        _, size, count, _, _ = BATCH_HDR.unpack_from(payload)
+        for i in range(count):
+            off = BATCH_HDR.size + i * size
+            stats.sample(topic, struct.unpack_from("<I", payload, off)[0])
+    return packet_id
+
+
+async def client(reader, writer, ack_delay):
+    stats = Stats()
+    loop = asyncio.get_running_loop()
+
+    def send_ack(packet_id):
+        writer.write(struct.pack(">BBH", PUBACK << 4, 2, packet_id))
+
+    try:
+        while True:
+            hdr, body = await read_packet(reader)
+            kind = hdr >> 4
+            if kind == CONNECT:
+                writer.write(bytes([CONNACK << 4, 2, 0, 0]))
+            elif kind == PUBLISH:
+                packet_id = handle_publish(hdr & 0x0F, body, stats)
+                if packet_id is None:
+                    continue
+                if ack_delay:
+                    loop.call_later(ack_delay, send_ack, packet_id)
+                else:
+                    send_ack(packet_id)
+            elif kind == SUBSCRIBE:
+                writer.write(bytes([SUBACK << 4, 3]) + body[:2] + bytes([0]))
+            elif kind == PINGREQ:
+                writer.write(bytes([PINGRESP << 4, 0]))
+            elif kind == DISCONNECT:
+                break
+            await writer.drain()
+    except asyncio.IncompleteReadError:
+        pass
+    finally:
+        stats.report()
+        writer.close()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--host", default="0.0.0.0")
+    parser.add_argument("--port", type=int, default=1883)
+    parser.add_argument("--ack-delay", type=float, default=0,
+                        help="PUBACK delay in ms")
+    args = parser.parse_args()
+
+    async def serve():
+        server = await asyncio.start_server(
+            lambda r, w: client(r, w, args.ack_delay / 1000),
+            args.host, args.port)
+        async with server:
+            await server.serve_forever()
+
+    asyncio.run(serve())
+
+
+if __name__ == "__main__":
+    main()
@@ -220,6 +220,13 @@ int swiot1l_mqtt()
 		goto free_mqtt;
 	}
 
+#ifdef CONFIG_SWIOT1L_MQTT_BENCH
+	ret = swiot1l_mqtt_bench(mqtt);
+	if (ret)
+		pr_err("MQTT benchmark error: %d (%s)\n", ret, strerror(-ret));
+	goto free_mqtt;
+#endif
+
 	struct mqtt_message test_msg = {
 		.qos = 0,
 		.payload = val_buff,
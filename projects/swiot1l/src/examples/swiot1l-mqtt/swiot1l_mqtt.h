@@ -34,6 +34,9 @@
 #ifndef __SWIOT1L_MQTT_H__
 #define __SWIOT1L_MQTT_H__
 
+#include "mqtt_client.h"
+
 int swiot1l_mqtt();
+int swiot1l_mqtt_bench(struct mqtt_desc *mqtt);
 
 #endif // __SWIOT1L_MQTT_H__
@@ -0,0 +1,223 @@
+/***************************************************************************//**
+ *   @file   swiot1l_mqtt_bench.c
+ *   @brief  MQTT publish benchmark for the swiot1l mqtt example.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <inttypes.h>
+#include <string.h>
+
+#include "swiot1l_mqtt.h"
+#include "no_os_delay.h"
+#include "no_os_error.h"
+#include "no_os_print_log.h"
+#include "mqtt_client.h"
+
+#define BENCH_TOPICS		4
+/* Samples published on each topic by a benchmark run */
+#define BENCH_SAMPLES		2000
+#define BENCH_PAYLOAD		(MQTT_PUB_BATCH_HDR_LEN + 50 * sizeof(uint32_t))
+#define BENCH_TIMEOUT_MS	30000
+
+static const char * const bench_topics[BENCH_TOPICS] = {
+	"bench/t0", "bench/t1", "bench/t2", "bench/t3",
+};
+
+/**
+ * @brief Get the time elapsed since a reference point.
+ * @param start - reference point.
+ * @return Elapsed time in ms.
+ */
+static uint32_t bench_elapsed_ms(struct no_os_time start)
+{
+	struct no_os_time now = no_os_get_time();
+
+	return (now.s - start.s) * 1000 + now.us / 1000 - start.us / 1000;
+}
+
+/**
+ * @brief Print the result of a benchmark run.
+ * @param name - name of the run.
+ * @param ms - duration of the run.
+ * @param packets - number of PUBLISH packets.
+ */
+static void bench_report(const char *name, uint32_t ms, uint32_t packets)
+{
+	uint32_t samples = BENCH_TOPICS * BENCH_SAMPLES;
+
+	pr_info("%-9s %" PRIu32 " samples in %" PRIu32 " ms (%" PRIu32
+		" samples/s), %" PRIu32 " packets\n", name, samples, ms,
+		ms ? samples * 1000 / ms : 0, packets);
+}
+
+/**
+ * @brief Publish every sample in its own QoS1 message, using mqtt_publish().
+ * @param mqtt - MQTT client.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int bench_single(struct mqtt_desc *mqtt)
+{
+	uint32_t sample[BENCH_TOPICS] = {0};
+	struct mqtt_message msg = {
+		.qos = MQTT_QOS1,
+		.len = sizeof(uint32_t),
+		.retained = false,
+	};
+	struct no_os_time start;
+	uint32_t i, t;
+	int ret;
+
+	start = no_os_get_time();
+	for (i = 0; i < BENCH_SAMPLES; i++) {
+		for (t = 0; t < BENCH_TOPICS; t++) {
+			msg.payload = (char *)&sample[t];
+			ret = mqtt_publish(mqtt, bench_topics[t], &msg);
+			if (ret)
+				return ret;
+
+			sample[t]++;
+		}
+	}
+
+	bench_report("single", bench_elapsed_ms(start),
+		     BENCH_TOPICS * BENCH_SAMPLES);
+
+	return 0;
+}
+
+/**
+ * @brief Publish the samples in batches, using the MQTT publisher.
+ * @param mqtt - MQTT client.
+ * @param max_inflight - QoS1 packets sent before waiting for a PUBACK.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int bench_batched(struct mqtt_desc *mqtt, uint8_t max_inflight)
+{
+	struct mqtt_pub_init_param pub_ip = {
+		.mqtt = mqtt,
+		.qos = MQTT_QOS1,
+		.max_topics = BENCH_TOPICS,
+		.max_payload = BENCH_PAYLOAD,
+		.queue_len = 2 * MQTT_PUB_MAX_INFLIGHT,
+		.max_inflight = max_inflight,
+		.flush_ms = 100,
+		.retry_ms = 1000,
+	};
+	uint32_t sample[BENCH_TOPICS] = {0};
+	uint32_t id[BENCH_TOPICS];
+	struct mqtt_pub_stats stats;
+	struct mqtt_pub_desc *pub;
+	struct no_os_time start;
+	char name[16];
+	uint32_t done;
+	uint32_t t;
+	int ret;
+
+	ret = mqtt_pub_init(&pub, &pub_ip);
+	if (ret)
+		return ret;
+
+	for (t = 0; t < BENCH_TOPICS; t++) {
+		ret = mqtt_pub_add_topic(pub, bench_topics[t], sizeof(uint32_t),
+					 &id[t]);
+		if (ret)
+			goto out;
+	}
+
+	start = no_os_get_time();
+	done = 0;
+	while (done < BENCH_TOPICS) {
+		for (t = 0; t < BENCH_TOPICS; t++) {
+			if (sample[t] == BENCH_SAMPLES)
+				continue;
+
+			/* Retry the dropped samples, so the runs are comparable */
+			ret = mqtt_pub_sample(pub, id[t], &sample[t]);
+			if (!ret) {
+				if (++sample[t] == BENCH_SAMPLES)
+					done++;
+			} else if (ret != -EAGAIN) {
+				goto out;
+			}
+		}
+
+		ret = mqtt_pub_step(pub);
+		if (ret)
+			goto out;
+	}
+
+	ret = mqtt_pub_flush(pub);
+	while (ret == -EAGAIN || mqtt_pub_pending(pub)) {
+		if (bench_elapsed_ms(start) > BENCH_TIMEOUT_MS) {
+			ret = -ETIMEDOUT;
+			goto out;
+		}
+
+		ret = mqtt_pub_step(pub);
+		if (ret)
+			goto out;
+
+		ret = mqtt_pub_flush(pub);
+	}
+
+	mqtt_pub_get_stats(pub, &stats);
+	snprintf(name, sizeof(name), "batch/%u", max_inflight);
+	bench_report(name, bench_elapsed_ms(start), stats.packets);
+	pr_info("          %" PRIu32 " bytes, %" PRIu32 " retries, %" PRIu32
+		" samples retried, %" PRIu32 " max queued\n", stats.bytes,
+		stats.retries, stats.dropped, stats.max_queued);
+
+out:
+	mqtt_pub_remove(pub);
+
+	return ret;
+}
+
+/**
+ * @brief Compare per-sample publishing with the batched MQTT publisher.
+ *
+ * Every sample is a 32 bit counter, one per topic, so the receiving side can
+ * check that no sample was lost or reordered.
+ *
+ * @param mqtt - connected MQTT client.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int swiot1l_mqtt_bench(struct mqtt_desc *mqtt)
+{
+	int ret;
+
+	ret = bench_single(mqtt);
+	if (ret)
+		return ret;
+
+	ret = bench_batched(mqtt, 1);
+	if (ret)
+		return ret;
+
+	return bench_batched(mqtt, MQTT_PUB_MAX_INFLIGHT);
+}
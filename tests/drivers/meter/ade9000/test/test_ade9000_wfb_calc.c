@@ -0,0 +1,279 @@
+/***************************************************************************//**
+ *   @file   test_ade9000_wfb_calc.c
+ *   @brief  Unit tests for the ADE9000 waveform buffer calculations
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include <stdint.h>
+#include <errno.h>
+#include <math.h>
+#include "unity.h"
+#include "no_os_util.h"
+#include "ade9000_wfb_calc.h"
+
+/*******************************************************************************
+ *    TEST VECTORS
+ ******************************************************************************/
+
+/* 50 Hz line at 8 kSPS */
+#define TEST_CYCLE		160
+/* Two and a half cycles */
+#define TEST_SETS		(TEST_CYCLE * 5 / 2)
+/* Current and voltage interleaved, as in the waveform buffer */
+#define TEST_STRIDE		2
+
+#define TEST_V1			4000000
+#define TEST_V3			400000
+#define TEST_V5			200000
+#define TEST_I1			2000000
+#define TEST_I3			600000
+/* Current lagging the voltage by 30 degrees */
+#define TEST_PHI		(M_PI / 6)
+
+static int32_t wfb[TEST_SETS * TEST_STRIDE];
+
+/*******************************************************************************
+ *    HELPER FUNCTIONS
+ ******************************************************************************/
+
+/**
+ * @brief Fill the interleaved buffer with a fundamental and harmonics. The
+ * voltage starts just after a positive going zero crossing.
+ */
+static void fill_wfb(uint32_t offset)
+{
+	double w;
+	uint32_t n;
+
+	for (n = 0; n < TEST_SETS; n++) {
+		w = 2 * M_PI * (n + offset + 0.5) / TEST_CYCLE;
+		wfb[n * TEST_STRIDE] = lround(TEST_I1 * sin(w - TEST_PHI) +
+					      TEST_I3 * sin(3 * w));
+		wfb[n * TEST_STRIDE + 1] = lround(TEST_V1 * sin(w) +
+						  TEST_V3 * sin(3 * w) +
+						  TEST_V5 * sin(5 * w));
+	}
+}
+
+/**
+ * @brief Assert that a value is within a relative tolerance, in ppm
+ */
+static void assert_within_ppm(double expected, double actual, uint32_t ppm)
+{
+	TEST_ASSERT_DOUBLE_WITHIN(fabs(expected) * ppm / 1e6 + 1, expected,
+				  actual);
+}
+
+/*******************************************************************************
+ *    SETUP AND TEARDOWN
+ ******************************************************************************/
+
+/**
+ * @brief Setup function called before each test
+ */
+void setUp(void)
+{
+	fill_wfb(0);
+}
+
+/**
+ * @brief Teardown function called after each test
+ */
+void tearDown(void)
+{
+}
+
+/*******************************************************************************
+ *    CYCLE DETECTION TESTS
+ ******************************************************************************/
+
+/**
+ * @brief Test the detection of a line cycle in the interleaved buffer
+ */
+void test_ade9000_calc_find_cycle(void)
+{
+	uint32_t start, len;
+	int ret;
+
+	ret = ade9000_calc_find_cycle(&wfb[1], TEST_STRIDE, TEST_SETS, 1000,
+				      &start, &len);
+	TEST_ASSERT_EQUAL_INT(0, ret);
+	/* The first crossing is not armed, the cycle starts at the second */
+	TEST_ASSERT_EQUAL_UINT32(TEST_CYCLE, start);
+	TEST_ASSERT_EQUAL_UINT32(TEST_CYCLE, len);
+}
+
+/**
+ * @brief Test the detection when the buffer starts in the middle of a cycle
+ */
+void test_ade9000_calc_find_cycle_offset(void)
+{
+	uint32_t start, len;
+	int ret;
+
+	fill_wfb(TEST_CYCLE / 4);
+
+	ret = ade9000_calc_find_cycle(&wfb[1], TEST_STRIDE, TEST_SETS, 1000,
+				      &start, &len);
+	TEST_ASSERT_EQUAL_INT(0, ret);
+	TEST_ASSERT_EQUAL_UINT32(TEST_CYCLE * 3 / 4, start);
+	TEST_ASSERT_EQUAL_UINT32(TEST_CYCLE, len);
+}
+
+/**
+ * @brief Test that noise around zero is not taken for a new cycle
+ */
+void test_ade9000_calc_find_cycle_hysteresis(void)
+{
+	/* Negative half, crossing, noise around zero, negative half, crossing */
+	const int32_t v[] = {
+		-500, -800, 100, 600, 900, -20, 30, -40, 700, 300,
+		-300, -900, -700, 200, 800,
+	};
+	uint32_t start, len;
+	int ret;
+
+	ret = ade9000_calc_find_cycle(v, 1, NO_OS_ARRAY_SIZE(v), 100, &start,
+				      &len);
+	TEST_ASSERT_EQUAL_INT(0, ret);
+	TEST_ASSERT_EQUAL_UINT32(2, start);
+	TEST_ASSERT_EQUAL_UINT32(11, len);
+
+	/* Without hysteresis, the noise ends the cycle */
+	ret = ade9000_calc_find_cycle(v, 1, NO_OS_ARRAY_SIZE(v), 0, &start,
+				      &len);
+	TEST_ASSERT_EQUAL_INT(0, ret);
+	TEST_ASSERT_EQUAL_UINT32(2, start);
+	TEST_ASSERT_EQUAL_UINT32(4, len);
+}
+
+/**
+ * @brief Test that a buffer without a complete cycle is reported
+ */
+void test_ade9000_calc_find_cycle_no_data(void)
+{
+	uint32_t start, len;
+
+	TEST_ASSERT_EQUAL_INT(-ENODATA,
+			      ade9000_calc_find_cycle(&wfb[1], TEST_STRIDE,
+						      TEST_CYCLE, 1000, &start,
+						      &len));
+	TEST_ASSERT_EQUAL_INT(-EINVAL,
+			      ade9000_calc_find_cycle(NULL, TEST_STRIDE,
+						      TEST_SETS, 1000, &start,
+						      &len));
+	TEST_ASSERT_EQUAL_INT(-EINVAL,
+			      ade9000_calc_find_cycle(&wfb[1], 0, TEST_SETS,
+						      1000, &start, &len));
+}
+
+/*******************************************************************************
+ *    CYCLE CALCULATION TESTS
+ ******************************************************************************/
+
+/**
+ * @brief Test the rms and active power of a cycle
+ */
+void test_ade9000_calc_cycle_rms_power(void)
+{
+	struct ade9000_calc_cycle res;
+	int ret;
+
+	ret = ade9000_calc_cycle(&wfb[0], &wfb[1], TEST_STRIDE, TEST_CYCLE, 0,
+				 &res);
+	TEST_ASSERT_EQUAL_INT(0, ret);
+	TEST_ASSERT_EQUAL_UINT32(TEST_CYCLE, res.nb_samples);
+	TEST_ASSERT_EQUAL_UINT8(0, res.nb_harm);
+
+	assert_within_ppm(sqrt(((double)TEST_I1 * TEST_I1 +
+				(double)TEST_I3 * TEST_I3) / 2), res.irms, 10);
+	assert_within_ppm(sqrt(((double)TEST_V1 * TEST_V1 +
+				(double)TEST_V3 * TEST_V3 +
+				(double)TEST_V5 * TEST_V5) / 2), res.vrms, 10);
+	/* Only the fundamental and the 3rd harmonic are in both channels */
+	assert_within_ppm((double)TEST_V1 * TEST_I1 / 2 * cos(TEST_PHI) +
+			  (double)TEST_V3 * TEST_I3 / 2, (double)res.watt, 10);
+}
+
+/**
+ * @brief Test the harmonic rms values of a cycle
+ */
+void test_ade9000_calc_cycle_harmonics(void)
+{
+	const double i_pk[6] = { TEST_I1, 0, TEST_I3, 0, 0, 0 };
+	const double v_pk[6] = { TEST_V1, 0, TEST_V3, 0, TEST_V5, 0 };
+	struct ade9000_calc_cycle res;
+	uint32_t h;
+	int ret;
+
+	ret = ade9000_calc_cycle(&wfb[0], &wfb[1], TEST_STRIDE, TEST_CYCLE, 6,
+				 &res);
+	TEST_ASSERT_EQUAL_INT(0, ret);
+	TEST_ASSERT_EQUAL_UINT8(6, res.nb_harm);
+
+	/* The table has 512 points: allow 100 ppm of the fundamental */
+	for (h = 0; h < 6; h++) {
+		TEST_ASSERT_DOUBLE_WITHIN(TEST_I1 / 10000.0, i_pk[h] / M_SQRT2,
+					  res.i_harm[h]);
+		TEST_ASSERT_DOUBLE_WITHIN(TEST_V1 / 10000.0, v_pk[h] / M_SQRT2,
+					  res.v_harm[h]);
+	}
+}
+
+/**
+ * @brief Test the parameter checks of the cycle calculation
+ */
+void test_ade9000_calc_cycle_invalid(void)
+{
+	struct ade9000_calc_cycle res;
+
+	TEST_ASSERT_EQUAL_INT(-EINVAL,
+			      ade9000_calc_cycle(NULL, &wfb[1], TEST_STRIDE,
+						 TEST_CYCLE, 0, &res));
+	TEST_ASSERT_EQUAL_INT(-EINVAL,
+			      ade9000_calc_cycle(&wfb[0], &wfb[1], TEST_STRIDE,
+						 0, 0, &res));
+	TEST_ASSERT_EQUAL_INT(-EINVAL,
+			      ade9000_calc_cycle(&wfb[0], &wfb[1], TEST_STRIDE,
+						 ADE9000_CALC_MAX_SAMPLES + 1,
+						 0, &res));
+	/* More harmonics than the cycle resolves */
+	TEST_ASSERT_EQUAL_INT(-EINVAL,
+			      ade9000_calc_cycle(&wfb[0], &wfb[1], TEST_STRIDE,
+						 8, 5, &res));
+	TEST_ASSERT_EQUAL_INT(-EINVAL,
+			      ade9000_calc_cycle(&wfb[0], &wfb[1], TEST_STRIDE,
+						 TEST_CYCLE,
+						 ADE9000_CALC_MAX_HARMONICS + 1,
+						 &res));
+}
@@ -0,0 +1,279 @@
+/***************************************************************************//**
+ *   @file   test_pmbus.c
+ *   @brief  Unit tests for the PMBus LINEAR11/LINEAR16 conversions
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include "unity.h"
+#include "pmbus.h"
+#include "no_os_util.h"
+#include "mock_no_os_i2c.h"
+#include "mock_no_os_alloc.h"
+#include "mock_no_os_delay.h"
+
+/*******************************************************************************
+ *    HELPER FUNCTIONS
+ ******************************************************************************/
+
+/**
+ * @brief Build a LINEAR11 word from an exponent and a mantissa
+ */
+static uint16_t lin11(int exp, int mantissa)
+{
+	return (uint16_t)((((unsigned int)exp << 11) & 0xF800) |
+			  (mantissa & PMBUS_LIN11_MANTISSA_MSK));
+}
+
+/*******************************************************************************
+ *    SETUP AND TEARDOWN
+ ******************************************************************************/
+
+/**
+ * @brief Setup function called before each test
+ */
+void setUp(void)
+{
+	// The conversions do not access the bus
+}
+
+/**
+ * @brief Teardown function called after each test
+ */
+void tearDown(void)
+{
+}
+
+/*******************************************************************************
+ *    LINEAR11 TESTS
+ ******************************************************************************/
+
+/**
+ * @brief Test the decoding of zero with every exponent
+ */
+void test_pmbus_lin11_zero(void)
+{
+	int exp;
+
+	for (exp = PMBUS_LIN11_EXPONENT_MIN; exp <= PMBUS_LIN11_EXPONENT_MAX; exp++)
+		TEST_ASSERT_EQUAL_INT32(0, pmbus_lin11_to_milli(lin11(exp, 0)));
+
+	TEST_ASSERT_EQUAL_HEX16(0, pmbus_milli_to_lin11(0) &
+				PMBUS_LIN11_MANTISSA_MSK);
+	TEST_ASSERT_EQUAL_INT32(0, pmbus_lin11_to_milli(pmbus_milli_to_lin11(0)));
+}
+
+/**
+ * @brief Test the decoding of values with a negative exponent
+ */
+void test_pmbus_lin11_negative_exponent(void)
+{
+	/* 768 * 2^-6 = 12 */
+	TEST_ASSERT_EQUAL_HEX16(0xD300, lin11(-6, 768));
+	TEST_ASSERT_EQUAL_INT32(12000, pmbus_lin11_to_milli(0xD300));
+	/* -4 * 2^-2 = -1 */
+	TEST_ASSERT_EQUAL_HEX16(0xF7FC, lin11(-2, -4));
+	TEST_ASSERT_EQUAL_INT32(-1000, pmbus_lin11_to_milli(0xF7FC));
+	/* 1 * 2^-16, below the milli-unit resolution */
+	TEST_ASSERT_EQUAL_INT32(0, pmbus_lin11_to_milli(lin11(-16, 1)));
+	/* 1023 * 2^-16 */
+	TEST_ASSERT_EQUAL_INT32(15, pmbus_lin11_to_milli(lin11(-16, 1023)));
+}
+
+/**
+ * @brief Test the decoding of values with a positive exponent
+ */
+void test_pmbus_lin11_positive_exponent(void)
+{
+	TEST_ASSERT_EQUAL_INT32(10000, pmbus_lin11_to_milli(lin11(1, 5)));
+	TEST_ASSERT_EQUAL_INT32(-40000, pmbus_lin11_to_milli(lin11(3, -5)));
+	TEST_ASSERT_EQUAL_INT32(1000000, pmbus_lin11_to_milli(lin11(0, 1000)));
+}
+
+/**
+ * @brief Test that out of range values saturate to the int32_t range
+ */
+void test_pmbus_lin11_saturation(void)
+{
+	/* 1023 * 2^15 and -1024 * 2^15 do not fit in milli-units */
+	TEST_ASSERT_EQUAL_INT32(INT32_MAX,
+				pmbus_lin11_to_milli(lin11(15, 1023)));
+	TEST_ASSERT_EQUAL_INT32(INT32_MIN,
+				pmbus_lin11_to_milli(lin11(15, -1024)));
+	/* 1023 * 2^6 still fits */
+	TEST_ASSERT_EQUAL_INT32(65472000, pmbus_lin11_to_milli(lin11(6, 1023)));
+}
+
+/**
+ * @brief Test that encoding then decoding keeps the value within the
+ * LINEAR11 resolution
+ */
+void test_pmbus_lin11_round_trip(void)
+{
+	const int32_t vals[] = {
+		1, 5, 25, 999, 1000, 1200, 3300, 12000, 65535, 1000000,
+		-1, -25, -1000, -12000, -1000000, INT32_MAX, INT32_MIN + 1,
+	};
+	uint16_t raw;
+	int32_t val;
+	uint32_t i;
+
+	for (i = 0; i < NO_OS_ARRAY_SIZE(vals); i++) {
+		raw = pmbus_milli_to_lin11(vals[i]);
+		val = pmbus_lin11_to_milli(raw);
+
+		/* The mantissa keeps at least 10 significant bits */
+		TEST_ASSERT_INT32_WITHIN(labs(vals[i]) / 1024 + 1, vals[i], val);
+	}
+
+	/* Exactly representable values */
+	TEST_ASSERT_EQUAL_INT32(12000,
+				pmbus_lin11_to_milli(pmbus_milli_to_lin11(12000)));
+	TEST_ASSERT_EQUAL_INT32(-1000,
+				pmbus_lin11_to_milli(pmbus_milli_to_lin11(-1000)));
+}
+
+/**
+ * @brief Test that the array decoder matches the single value decoder
+ */
+void test_pmbus_lin11_decode_array(void)
+{
+	const uint16_t raw[] = {
+		0x0000, 0xD300, 0xF7FC, 0x0805, 0x7BFF, 0x7C00, 0x8001, 0xBA00,
+	};
+	int32_t vals[NO_OS_ARRAY_SIZE(raw)];
+	uint32_t i;
+
+	pmbus_lin11_decode(raw, vals, NO_OS_ARRAY_SIZE(raw));
+
+	for (i = 0; i < NO_OS_ARRAY_SIZE(raw); i++)
+		TEST_ASSERT_EQUAL_INT32(pmbus_lin11_to_milli(raw[i]), vals[i]);
+}
+
+/*******************************************************************************
+ *    LINEAR16 TESTS
+ ******************************************************************************/
+
+/**
+ * @brief Test the conversion of zero
+ */
+void test_pmbus_lin16_zero(void)
+{
+	TEST_ASSERT_EQUAL_INT32(0, pmbus_lin16_to_milli(0, -12));
+	TEST_ASSERT_EQUAL_INT32(0, pmbus_lin16_to_milli(0, 15));
+	TEST_ASSERT_EQUAL_HEX16(0, pmbus_milli_to_lin16(0, -12));
+	TEST_ASSERT_EQUAL_HEX16(0, pmbus_milli_to_lin16(0, 3));
+}
+
+/**
+ * @brief Test the conversions with a negative exponent, as set by VOUT_MODE
+ */
+void test_pmbus_lin16_negative_exponent(void)
+{
+	/* 4096 * 2^-12 = 1 */
+	TEST_ASSERT_EQUAL_INT32(1000, pmbus_lin16_to_milli(0x1000, -12));
+	TEST_ASSERT_EQUAL_HEX16(0x1000, pmbus_milli_to_lin16(1000, -12));
+	/* 4915 * 2^-12 = 1.19995 */
+	TEST_ASSERT_EQUAL_INT32(1199, pmbus_lin16_to_milli(0x1333, -12));
+	/* 3.3 * 2^13 = 27033.6 */
+	TEST_ASSERT_EQUAL_HEX16(0x6999, pmbus_milli_to_lin16(3300, -13));
+	/* 65535 * 2^-16, below one unit */
+	TEST_ASSERT_EQUAL_INT32(999, pmbus_lin16_to_milli(0xFFFF, -16));
+}
+
+/**
+ * @brief Test that out of range values saturate
+ */
+void test_pmbus_lin16_saturation(void)
+{
+	/* The mantissa is unsigned */
+	TEST_ASSERT_EQUAL_HEX16(0, pmbus_milli_to_lin16(-1, -12));
+	TEST_ASSERT_EQUAL_HEX16(0, pmbus_milli_to_lin16(INT32_MIN, -12));
+	/* 100 * 2^12 does not fit in 16 bits */
+	TEST_ASSERT_EQUAL_HEX16(0xFFFF, pmbus_milli_to_lin16(100000, -12));
+	TEST_ASSERT_EQUAL_HEX16(0xFFFF, pmbus_milli_to_lin16(INT32_MAX, -16));
+	/* 65535 * 2^15 does not fit in milli-units */
+	TEST_ASSERT_EQUAL_INT32(INT32_MAX, pmbus_lin16_to_milli(0xFFFF, 15));
+}
+
+/**
+ * @brief Test that encoding then decoding keeps the value within one LSB
+ */
+void test_pmbus_lin16_round_trip(void)
+{
+	const int exps[] = { -16, -13, -12, -9, 0, 2 };
+	int64_t max_mv;
+	int32_t lsb;
+	int32_t val;
+	int32_t mv;
+	uint32_t i;
+
+	for (i = 0; i < NO_OS_ARRAY_SIZE(exps); i++) {
+		if (exps[i] < 0) {
+			/* Both conversions truncate */
+			lsb = (1000 >> -exps[i]) + 2;
+			max_mv = ((int64_t)UINT16_MAX * 1000) >> -exps[i];
+		} else {
+			lsb = 1000 << exps[i];
+			max_mv = ((int64_t)UINT16_MAX * 1000) << exps[i];
+		}
+
+		for (mv = 0; mv <= 15000 && mv <= max_mv; mv += 250) {
+			val = pmbus_lin16_to_milli(pmbus_milli_to_lin16(mv, exps[i]),
+						   exps[i]);
+			TEST_ASSERT_INT32_WITHIN(lsb, mv, val);
+		}
+	}
+}
+
+/**
+ * @brief Test that the array decoder matches the single value decoder, on
+ * both its negative and positive exponent paths
+ */
+void test_pmbus_lin16_decode_array(void)
+{
+	const uint16_t raw[] = { 0x0000, 0x0001, 0x1000, 0x1333, 0x8000, 0xFFFF };
+	const int exps[] = { -16, -12, 0, 3, 15 };
+	int32_t vals[NO_OS_ARRAY_SIZE(raw)];
+	uint32_t i;
+	uint32_t j;
+
+	for (j = 0; j < NO_OS_ARRAY_SIZE(exps); j++) {
+		pmbus_lin16_decode(raw, exps[j], vals, NO_OS_ARRAY_SIZE(raw));
+
+		for (i = 0; i < NO_OS_ARRAY_SIZE(raw); i++)
+			TEST_ASSERT_EQUAL_INT32(pmbus_lin16_to_milli(raw[i], exps[j]),
+						vals[i]);
+	}
+}
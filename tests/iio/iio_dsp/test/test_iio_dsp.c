@@ -0,0 +1,409 @@
+/***************************************************************************//**
+ *   @file   test_iio_dsp.c
+ *   @brief  Unit tests for the in-stream processing stage of the IIO buffers
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+#include "unity.h"
+#include "iio_dsp.h"
+#include "iio_types.h"
+#include "no_os_circular_buffer.h"
+#include "no_os_util.h"
+
+/*******************************************************************************
+ *    TEST DATA
+ ******************************************************************************/
+
+/* Client block, in scans */
+#define SAMPLES		8
+/* Device scan: 12-bit sample in 16 bits, padding, 24-bit sample in 32 bits */
+#define IN_BPS		8
+/* Output scan with IIO_DSP_FORMAT_16BIT: two 16-bit samples */
+#define OUT_BPS		4
+
+static struct scan_type adc12_type = {
+	.sign = 's',
+	.realbits = 12,
+	.storagebits = 16,
+};
+
+static struct scan_type adc24_type = {
+	.sign = 's',
+	.realbits = 24,
+	.storagebits = 32,
+};
+
+static struct iio_channel channels[] = {
+	{
+		.name = "voltage0",
+		.ch_type = IIO_VOLTAGE,
+		.channel = 0,
+		.scan_index = 0,
+		.scan_type = &adc12_type,
+		.indexed = true,
+	},
+	{
+		.name = "voltage1",
+		.ch_type = IIO_VOLTAGE,
+		.channel = 1,
+		.scan_index = 1,
+		.scan_type = &adc24_type,
+		.indexed = true,
+	},
+};
+
+static struct iio_device adc_dev = {
+	.num_ch = NO_OS_ARRAY_SIZE(channels),
+	.channels = channels,
+};
+
+static struct iio_dsp *dsp;
+static struct no_os_circular_buffer out_cb;
+static struct iio_buffer buffer;
+static int8_t out_buf[SAMPLES * OUT_BPS];
+
+/*******************************************************************************
+ *    HELPER FUNCTIONS
+ ******************************************************************************/
+
+/**
+ * @brief Initialize the stage and enable the buffer, as iio_open_dev does.
+ */
+static void dsp_open(enum iio_dsp_filter filter, uint32_t decimation,
+		     uint32_t chunk)
+{
+	struct iio_dsp_init_param param = {
+		.format = IIO_DSP_FORMAT_16BIT,
+		.filter = filter,
+		.decimation = decimation,
+		.cic_order = 2,
+		.chunk = chunk,
+	};
+	uint32_t out_size = 0;
+
+	TEST_ASSERT_EQUAL_INT(0, iio_dsp_init(&dsp, &param, &adc_dev));
+
+	buffer.active_mask = 0x3;
+	buffer.bytes_per_scan = IN_BPS;
+	buffer.samples = SAMPLES;
+	buffer.size = IN_BPS * SAMPLES;
+	buffer.dir = IIO_DIRECTION_INPUT;
+	buffer.buf = &out_cb;
+
+	TEST_ASSERT_EQUAL_INT(0, iio_dsp_open(dsp, &buffer, &out_size));
+	TEST_ASSERT_TRUE(buffer.buf == &dsp->raw_cb);
+	TEST_ASSERT_EQUAL_UINT32(OUT_BPS * SAMPLES, out_size);
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_cfg(&out_cb, out_buf, out_size));
+}
+
+/**
+ * @brief Write one device block, as a driver submit would.
+ * @param first - Index of the first scan of the block.
+ * @param ch0 - Sample of channel 0 for a scan index.
+ * @param ch1 - Sample of channel 1 for a scan index.
+ */
+static void dsp_push_block(uint32_t first, int32_t (*ch0)(uint32_t),
+			   int32_t (*ch1)(uint32_t))
+{
+	uint8_t *block;
+	uint32_t size, i;
+	int16_t v16;
+	int32_t v32;
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_prepare_async_write(buffer.buf,
+			      buffer.size, (void **)&block, &size));
+	TEST_ASSERT_EQUAL_UINT32(buffer.size, size);
+
+	for (i = 0; i < buffer.samples; i++) {
+		v16 = ch0(first + i);
+		v32 = ch1(first + i) & 0xFFFFFF;
+		memcpy(block + i * IN_BPS, &v16, sizeof(v16));
+		memcpy(block + i * IN_BPS + 4, &v32, sizeof(v32));
+	}
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_end_async_write(buffer.buf));
+}
+
+/**
+ * @brief Read one processed sample from the client buffer.
+ */
+static int16_t dsp_out_sample(uint32_t scan, uint32_t ch)
+{
+	int16_t v16;
+
+	memcpy(&v16, out_buf + scan * OUT_BPS + ch * 2, sizeof(v16));
+
+	return v16;
+}
+
+/* Averages to 100 * (i / 4) over each group of 4 scans */
+static int32_t ramp12(uint32_t i)
+{
+	return 100 * (i / 4) + (i % 2 ? 3 : -3);
+}
+
+/* Averages to -1000 * (i / 4) once rounded to 16 bits */
+static int32_t ramp24(uint32_t i)
+{
+	return -256000 * (int32_t)(i / 4) + (i % 2 ? 512 : -512);
+}
+
+static int32_t index12(uint32_t i)
+{
+	return i;
+}
+
+static int32_t index24(uint32_t i)
+{
+	return -(int32_t)i * 256;
+}
+
+static int32_t const12(uint32_t i)
+{
+	return -1234;
+}
+
+static int32_t const24(uint32_t i)
+{
+	return 0x123456;
+}
+
+/*******************************************************************************
+ *    SETUP AND TEARDOWN
+ ******************************************************************************/
+
+/**
+ * @brief Setup function called before each test
+ */
+void setUp(void)
+{
+	dsp = NULL;
+	memset(&buffer, 0, sizeof(buffer));
+	memset(out_buf, 0, sizeof(out_buf));
+}
+
+/**
+ * @brief Teardown function called after each test
+ */
+void tearDown(void)
+{
+	if (dsp)
+		iio_dsp_remove(dsp);
+}
+
+/*******************************************************************************
+ *    BUFFER TESTS
+ ******************************************************************************/
+
+/**
+ * @brief The device block is the size of a client block, the client block
+ * is made of decimation device blocks.
+ */
+void test_iio_dsp_open_block_size(void)
+{
+	dsp_open(IIO_DSP_FILTER_AVERAGE, 4, 0);
+
+	TEST_ASSERT_EQUAL_UINT32(SAMPLES, buffer.samples);
+	TEST_ASSERT_EQUAL_UINT32(IN_BPS * SAMPLES, buffer.size);
+	TEST_ASSERT_EQUAL_UINT32(IN_BPS * SAMPLES, dsp->raw_cb.size);
+	TEST_ASSERT_EQUAL_UINT32(4, iio_dsp_blocks(dsp));
+
+	iio_dsp_close(dsp);
+	TEST_ASSERT_EQUAL_UINT32(1, iio_dsp_blocks(dsp));
+}
+
+/**
+ * @brief Without decimation nor conversion, the scans bypass the stage.
+ */
+void test_iio_dsp_open_not_needed(void)
+{
+	struct iio_dsp_init_param param = {
+		.format = IIO_DSP_FORMAT_NATIVE,
+	};
+	uint32_t out_size = IN_BPS * SAMPLES;
+
+	TEST_ASSERT_EQUAL_INT(0, iio_dsp_init(&dsp, &param, &adc_dev));
+
+	buffer.active_mask = 0x3;
+	buffer.samples = SAMPLES;
+	buffer.size = IN_BPS * SAMPLES;
+	buffer.buf = &out_cb;
+
+	TEST_ASSERT_EQUAL_INT(0, iio_dsp_open(dsp, &buffer, &out_size));
+	TEST_ASSERT_EQUAL_UINT32(IN_BPS * SAMPLES, out_size);
+	TEST_ASSERT_TRUE(buffer.buf == &out_cb);
+	TEST_ASSERT_EQUAL_UINT32(1, iio_dsp_blocks(dsp));
+}
+
+/*******************************************************************************
+ *    FILTER TESTS
+ ******************************************************************************/
+
+/**
+ * @brief One client block of averages from four device blocks, each one
+ * processed before the next is written, in chunks smaller than a block.
+ */
+void test_iio_dsp_average(void)
+{
+	uint32_t i, size;
+
+	dsp_open(IIO_DSP_FILTER_AVERAGE, 4, 3);
+
+	for (i = 0; i < iio_dsp_blocks(dsp); i++) {
+		dsp_push_block(i * SAMPLES, ramp12, ramp24);
+		TEST_ASSERT_EQUAL_INT(0, iio_dsp_process(dsp, &out_cb));
+		TEST_ASSERT_EQUAL_INT(0, no_os_cb_size(&out_cb, &size));
+		TEST_ASSERT_EQUAL_UINT32((i + 1) * OUT_BPS * SAMPLES / 4, size);
+	}
+
+	for (i = 0; i < SAMPLES; i++) {
+		TEST_ASSERT_EQUAL_INT(100 * i, dsp_out_sample(i, 0));
+		TEST_ASSERT_EQUAL_INT(-1000 * (int32_t)i, dsp_out_sample(i, 1));
+	}
+}
+
+/**
+ * @brief Keep every N-th scan, across the device blocks.
+ */
+void test_iio_dsp_keep_nth(void)
+{
+	uint32_t i;
+
+	dsp_open(IIO_DSP_FILTER_NONE, 4, 5);
+
+	for (i = 0; i < iio_dsp_blocks(dsp); i++) {
+		dsp_push_block(i * SAMPLES, index12, index24);
+		TEST_ASSERT_EQUAL_INT(0, iio_dsp_process(dsp, &out_cb));
+	}
+
+	for (i = 0; i < SAMPLES; i++) {
+		TEST_ASSERT_EQUAL_INT(4 * i + 3, dsp_out_sample(i, 0));
+		TEST_ASSERT_EQUAL_INT(-(int32_t)(4 * i + 3),
+				      dsp_out_sample(i, 1));
+	}
+}
+
+/**
+ * @brief A CIC filter has unity gain once its combs are filled.
+ */
+void test_iio_dsp_cic_dc_gain(void)
+{
+	uint32_t i;
+
+	dsp_open(IIO_DSP_FILTER_CIC, 4, 0);
+
+	for (i = 0; i < iio_dsp_blocks(dsp); i++) {
+		dsp_push_block(i * SAMPLES, const12, const24);
+		TEST_ASSERT_EQUAL_INT(0, iio_dsp_process(dsp, &out_cb));
+	}
+
+	/* Only the first output of an order 2 filter is still settling */
+	for (i = 1; i < SAMPLES; i++) {
+		TEST_ASSERT_EQUAL_INT(-1234, dsp_out_sample(i, 0));
+		TEST_ASSERT_EQUAL_INT(0x1234, dsp_out_sample(i, 1));
+	}
+}
+
+/*******************************************************************************
+ *    SAMPLING FREQUENCY TESTS
+ ******************************************************************************/
+
+/**
+ * @brief The client sees the rate of the processed stream.
+ */
+void test_iio_dsp_rate_read(void)
+{
+	char buf[32];
+	int ret;
+
+	dsp_open(IIO_DSP_FILTER_AVERAGE, 4, 0);
+
+	strcpy(buf, "1000000");
+	ret = iio_dsp_rate_read(dsp, buf, sizeof(buf), strlen(buf));
+	TEST_ASSERT_EQUAL_INT(strlen("250000"), ret);
+	TEST_ASSERT_EQUAL_STRING("250000", buf);
+
+	strcpy(buf, "1001.5");
+	ret = iio_dsp_rate_read(dsp, buf, sizeof(buf), strlen(buf));
+	TEST_ASSERT_EQUAL_INT(strlen("250.375000"), ret);
+	TEST_ASSERT_EQUAL_STRING("250.375000", buf);
+
+	/* Not a rate: left to the device */
+	strcpy(buf, "auto");
+	ret = iio_dsp_rate_read(dsp, buf, sizeof(buf), strlen(buf));
+	TEST_ASSERT_EQUAL_INT(strlen("auto"), ret);
+	TEST_ASSERT_EQUAL_STRING("auto", buf);
+
+	TEST_ASSERT_EQUAL_INT(-EIO, iio_dsp_rate_read(dsp, buf, sizeof(buf),
+			      -EIO));
+}
+
+/**
+ * @brief The rate requested by the client is the one of the processed
+ * stream.
+ */
+void test_iio_dsp_rate_write(void)
+{
+	char buf[32];
+	int ret;
+
+	dsp_open(IIO_DSP_FILTER_AVERAGE, 4, 0);
+
+	ret = iio_dsp_rate_write(dsp, "250000", buf, sizeof(buf));
+	TEST_ASSERT_EQUAL_INT(strlen("1000000"), ret);
+	TEST_ASSERT_EQUAL_STRING("1000000", buf);
+
+	ret = iio_dsp_rate_write(dsp, "0.25", buf, sizeof(buf));
+	TEST_ASSERT_EQUAL_INT(strlen("1.000000"), ret);
+	TEST_ASSERT_EQUAL_STRING("1.000000", buf);
+
+	TEST_ASSERT_EQUAL_INT(0, iio_dsp_rate_write(dsp, "auto", buf,
+			      sizeof(buf)));
+}
+
+/**
+ * @brief Without decimation the rate is unchanged.
+ */
+void test_iio_dsp_rate_no_decimation(void)
+{
+	char buf[32] = "1000000";
+
+	dsp_open(IIO_DSP_FILTER_NONE, 1, 0);
+
+	TEST_ASSERT_EQUAL_INT(7, iio_dsp_rate_read(dsp, buf, sizeof(buf), 7));
+	TEST_ASSERT_EQUAL_STRING("1000000", buf);
+	TEST_ASSERT_EQUAL_INT(0, iio_dsp_rate_write(dsp, "1000000", buf,
+			      sizeof(buf)));
+}
@@ -0,0 +1,310 @@
+#!/usr/bin/env python3
+"""
+Decode a no_os_dlog_dump() stream.
+
+The deferred logger only records the address of a constant call site
+descriptor (struct no_os_dlog_fmt) and the raw arguments. This script reads
+the descriptors and the strings they point to from the ELF file of the
+application and formats the entries like no_os_dlog_flush() does.
+
+The dump header holds the run time address of no_os_dlog_levels. For position
+independent executables (e.g. Linux applications built as PIE), the difference
+with its address in the ELF file is the load address, which is subtracted from
+the recorded addresses. The pointers of the descriptors are read from the
+relative relocations in that case.
+
+Usage:
+    no_os_dlog_decode.py build/app.elf dump.bin
+    cat /dev/ttyUSB0 | no_os_dlog_decode.py build/app.elf -
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+DLOG_MAGIC = 0x474F4C44
+DLOG_FLAG_TIMESTAMP = 0x1
+DLOG_VALID = 0x80000000
+
+ANCHOR_SYMBOL = "no_os_dlog_levels"
+
+# R_*_RELATIVE relocation type, by ELF machine
+RELATIVE_TYPES = {3: 8, 62: 8, 40: 23, 183: 1027, 243: 3}
+
+LABELS = ["EMERG", "ALERT", "CRIT", "ERR", "WARNING", "NOTICE", "INFO", "DEBUG"]
+
+CONV_RE = re.compile(r"%([-+ #0']*)(\*|\d+)?(?:\.(\*|\d*))?"
+                     r"(hh|h|ll|l|j|z|t|L)?([diuoxXcfFeEgGaAspn%])")
+
+
+class Elf:
+    """Minimal little endian ELF reader, enough to read initialized data."""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            self.data = f.read()
+        if self.data[:4] != b"\x7fELF":
+            raise ValueError(f"{path} is not an ELF file")
+        if self.data[5] != 1:
+            raise ValueError("only little endian ELF files are supported")
+
+        self.is64 = self.data[4] == 2
+        self.ptr_size = 8 if self.is64 else 4
+        machine, = struct.unpack_from("<H", self.data, 0x12)
+        if self.is64:
+            shoff, = struct.unpack_from("<Q", self.data, 0x28)
+            shentsize, shnum = struct.unpack_from("<HH", self.data, 0x3A)
+            sh_fmt = "<IIQQQQIIQQ"
+        else:
+            shoff, = struct.unpack_from("<I", self.data, 0x20)
+            shentsize, shnum = struct.unpack_from("<HH", self.data, 0x2E)
+            sh_fmt = "<IIIIIIIIII"
+
+        headers = [struct.unpack_from(sh_fmt, self.data, shoff + i * shentsize)
+                   for i in range(shnum)]
+
+        self.sections = []
+        for _, sh_type, flags, addr, offset, size, *_ in headers:
+            # SHF_ALLOC sections with contents (not SHT_NOBITS)
+            if flags & 0x2 and sh_type != 8 and addr:
+                self.sections.append((addr, size, offset))
+
+        self.symbols = {}
+        self.relocs = {}
+        for _, sh_type, _, _, offset, size, link, _, _, entsize in headers:
+            if sh_type == 2 and entsize:
+                self._read_symbols(offset, size, entsize, headers[link])
+            elif sh_type in (4, 9) and entsize:
+                self._read_relocs(offset, size, entsize, sh_type == 4,
+                                  RELATIVE_TYPES.get(machine))
+
+    def _read_symbols(self, offset, size, entsize, strtab):
+        str_offset = strtab[4]
+        for pos in range(offset, offset + size, entsize):
+            if self.is64:
+                name, _, _, _, value, _ = struct.unpack_from(
+                    "<IBBHQQ", self.data, pos)
+            else:
+                name, value, _, _, _, _ = struct.unpack_from(
+                    "<IIIBBH", self.data, pos)
+            if not name:
+                continue
+            start = str_offset + name
+            end = self.data.index(b"\0", start)
+            self.symbols[self.data[start:end].decode("utf-8", "replace")] = value
+
+    def _read_relocs(self, offset, size, entsize, rela, relative):
+        if relative is None:
+            return
+        for pos in range(offset, offset + size, entsize):
+            if self.is64:
+                addr, info = struct.unpack_from("<QQ", self.data, pos)
+                rtype = info & 0xFFFFFFFF
+            else:
+                addr, info = struct.unpack_from("<II", self.data, pos)
+                rtype = info & 0xFF
+            if rtype != relative:
+                continue
+            if rela:
+                self.relocs[addr] = struct.unpack_from(
+                    "<q" if self.is64 else "<i", self.data,
+                    pos + 2 * self.ptr_size)[0]
+            else:
+                # REL: the addend is stored in place
+                self.relocs[addr] = None
+
+    def read(self, addr, size):
+        for start, length, offset in self.sections:
+            if start <= addr and addr + size <= start + length:
+                pos = offset + addr - start
+                return self.data[pos:pos + size]
+        return None
+
+    def read_ptr(self, addr):
+        """Read a pointer, as set by the relative relocations if any."""
+        if self.relocs.get(addr) is not None:
+            return self.relocs[addr]
+        raw = self.read(addr, self.ptr_size)
+        if raw is None:
+            return None
+        return struct.unpack("<Q" if self.is64 else "<I", raw)[0]
+
+    def read_str(self, addr):
+        for start, length, offset in self.sections:
+            if start <= addr < start + length:
+                pos = offset + addr - start
+                end = self.data.index(b"\0", pos)
+                return self.data[pos:end].decode("utf-8", "replace")
+        return None
+
+
+class Decoder:
+    def __init__(self, elf):
+        self.elf = elf
+        self.calls = {}
+        self.load_addr = 0
+
+    def call_site(self, addr):
+        if addr in self.calls:
+            return self.calls[addr]
+
+        ptr = self.elf.ptr_size
+        raw = self.elf.read(addr, 3 * ptr + 8)
+        if raw is None:
+            site = None
+        else:
+            fmt, file, func = (self.elf.read_ptr(addr + i * ptr)
+                               for i in range(3))
+            line, level = struct.unpack_from("<II", raw, 3 * ptr)
+            site = (self.elf.read_str(fmt) or "", self.elf.read_str(file)
+                    or "?", self.elf.read_str(func) or "?", line, level)
+        self.calls[addr] = site
+
+        return site
+
+    def arg_words(self, length, conv):
+        if conv in "fFeEgGaA":
+            return 2
+        if conv in "sp":
+            return self.elf.ptr_size // 4
+        if length in ("ll", "j"):
+            return 2
+        if length in ("l", "z", "t"):
+            return self.elf.ptr_size // 4
+        return 1
+
+    def format(self, fmt, words):
+        out = []
+        pos = 0
+        last = 0
+        for m in CONV_RE.finditer(fmt):
+            out.append(fmt[last:m.start()])
+            last = m.end()
+            flags, width, prec, length, conv = m.groups()
+            if conv == "%":
+                out.append("%")
+                continue
+            if conv == "n" or length == "L":
+                out.append(fmt[m.start():])
+                return "".join(out)
+
+            spec = "%" + flags.replace("'", "")
+            for field, sep in ((width, ""), (prec, ".")):
+                if field == "*":
+                    if pos >= len(words):
+                        out.append(fmt[m.start():])
+                        return "".join(out)
+                    spec += sep + str(struct.unpack("<i", struct.pack(
+                        "<I", words[pos]))[0])
+                    pos += 1
+                elif field is not None:
+                    spec += sep + field
+
+            nb = self.arg_words(length, conv)
+            if pos + nb > len(words):
+                out.append(fmt[m.start():])
+                return "".join(out)
+            val = words[pos] if nb == 1 else words[pos] | (words[pos + 1] << 32)
+            pos += nb
+
+            if conv in "fFeEgGaA":
+                dbl = struct.unpack("<d", struct.pack("<Q", val))[0]
+                out.append((spec + (conv if conv not in "aA" else "e")) % dbl)
+            elif conv == "s":
+                s = self.elf.read_str(val - self.load_addr)
+                out.append((spec + "s") % (s if s is not None
+                                           else f"<0x{val:x}>"))
+            elif conv == "p":
+                out.append(f"0x{val:x}")
+            elif conv == "c":
+                out.append((spec + "c") % chr(val & 0xFF))
+            else:
+                if conv in "di" and val >> (nb * 32 - 1):
+                    val -= 1 << (nb * 32)
+                out.append((spec + ("d" if conv in "iu" else conv)) % val)
+
+        out.append(fmt[last:])
+
+        return "".join(out)
+
+    def set_anchor(self, anchor, out):
+        """Compute the load address from the run time anchor address."""
+        sym = self.elf.symbols.get(ANCHOR_SYMBOL)
+        if sym is None:
+            if anchor:
+                out.write(f"*** {ANCHOR_SYMBOL} not found in the ELF "
+                          "symbols, assuming a load address of 0 ***\n")
+            self.load_addr = 0
+            return
+        if anchor - sym != self.load_addr:
+            self.calls = {}
+        self.load_addr = anchor - sym
+
+    def decode(self, data, out):
+        words = struct.unpack("<%dI" % (len(data) // 4), data[:len(data) & ~3])
+        timestamp = False
+        ptr_words = self.elf.ptr_size // 4
+        i = 0
+        while i < len(words):
+            hdr = words[i]
+            if hdr == DLOG_MAGIC and i + 3 <= len(words):
+                timestamp = bool(words[i + 1] & DLOG_FLAG_TIMESTAMP)
+                ptr_words = (words[i + 1] >> 8) & 0xFF
+                if words[i + 2]:
+                    out.write(f"*** {words[i + 2]} entries dropped ***\n")
+                anchor = words[i + 3] | ((words[i + 4] << 32)
+                                         if ptr_words > 1 else 0)
+                self.set_anchor(anchor, out)
+                i += 3 + ptr_words
+                continue
+            if not hdr & DLOG_VALID:
+                out.write(f"*** bad entry header 0x{hdr:08x} ***\n")
+                i += 1
+                continue
+
+            length = hdr & 0xFF
+            entry = words[i:i + length]
+            i += length
+            if len(entry) < length:
+                out.write("*** truncated entry ***\n")
+                break
+
+            addr = entry[1] | ((entry[2] << 32) if ptr_words > 1 else 0)
+            pos = 1 + ptr_words
+            prefix = ""
+            if timestamp:
+                prefix = f"[{entry[pos]:10d}] "
+                pos += 1
+
+            site = self.call_site(addr - self.load_addr)
+            if site is None:
+                out.write(f"{prefix}<unknown call site 0x{addr:x}>\n")
+                continue
+
+            fmt, file, func, line, level = site
+            if level <= 3:
+                prefix += f"{LABELS[level]}: {file}:{line}:{func}(): "
+            elif level != 6 and level < len(LABELS):
+                prefix += f"{LABELS[level]}: "
+            out.write(prefix + self.format(fmt, list(entry[pos:])))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Decode a no-OS deferred log dump.")
+    parser.add_argument("elf", help="ELF file of the application")
+    parser.add_argument("dump", help="binary dump file, - for stdin")
+    args = parser.parse_args()
+
+    if args.dump == "-":
+        data = sys.stdin.buffer.read()
+    else:
+        with open(args.dump, "rb") as f:
+            data = f.read()
+
+    Decoder(Elf(args.elf)).decode(data, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
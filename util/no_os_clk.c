@@ -34,13 +34,53 @@
 /******************************************************************************/
 /***************************** Include Files **********************************/
 /******************************************************************************/
+#include <inttypes.h>
 #include "no_os_alloc.h"
 #include "no_os_error.h"
+#include "no_os_print_log.h"
 #include "no_os_clk.h"
 
 /******************************************************************************/
 /************************** Functions Implementation **************************/
 /******************************************************************************/
+/**
+ * @brief Add a clock to the children of its parent.
+ * @param desc - The clock descriptor.
+ * @param parent - The new parent, may be NULL.
+ */
+static void no_os_clk_link(struct no_os_clk_desc *desc,
+			   struct no_os_clk_desc *parent)
+{
+	desc->parent = parent;
+	if (!parent)
+		return;
+
+	desc->sibling = parent->children;
+	parent->children = desc;
+}
+
+/**
+ * @brief Remove a clock from the children of its parent.
+ * @param desc - The clock descriptor.
+ */
+static void no_os_clk_unlink(struct no_os_clk_desc *desc)
+{
+	struct no_os_clk_desc **p;
+
+	if (!desc->parent)
+		return;
+
+	for (p = &desc->parent->children; *p; p = &(*p)->sibling) {
+		if (*p == desc) {
+			*p = desc->sibling;
+			break;
+		}
+	}
+
+	desc->parent = NULL;
+	desc->sibling = NULL;
+}
+
 /**
  * Initialize clock.
  * @param desc - CLK descriptor.
@@ -64,6 +104,7 @@ int32_t no_os_clk_init(struct no_os_clk_desc **desc,
 	clk->hw_ch_num = param->hw_ch_num;
 	clk->dev_desc = param->dev_desc;
 	clk->platform_ops = param->platform_ops;
+	clk->flags = param->flags;
 
 	if (param->platform_ops->init) {
 		ret = param->platform_ops->init(desc, param);
@@ -71,6 +112,8 @@ int32_t no_os_clk_init(struct no_os_clk_desc **desc,
 			goto error;
 	}
 
+	no_os_clk_link(clk, param->parent);
+
 	*desc = clk;
 
 	return 0;
@@ -84,7 +127,8 @@ error:
 /**
  * @brief Free the resources allocated by no_os_clk_init().
  * @param desc - The clock descriptor.
- * @return 0 in case of success, -1 otherwise.
+ * @return 0 in case of success, -EBUSY if the clock still has children,
+ * 	   negative error code otherwise.
  */
 int32_t no_os_clk_remove(struct no_os_clk_desc *desc)
 {
@@ -93,6 +137,18 @@ int32_t no_os_clk_remove(struct no_os_clk_desc *desc)
 	if (!desc || !desc->platform_ops)
 		return -EINVAL;
 
+	if (desc->children)
+		return -EBUSY;
+
+	if (desc->enable_count && desc->parent)
+		no_os_clk_disable(desc->parent);
+	if (desc->prepare_count && desc->parent)
+		no_os_clk_unprepare(desc->parent);
+	desc->enable_count = 0;
+	desc->prepare_count = 0;
+
+	no_os_clk_unlink(desc);
+
 	if (desc->platform_ops->remove) {
 		ret = desc->platform_ops->remove(desc);
 		if (ret)
@@ -105,39 +161,216 @@ int32_t no_os_clk_remove(struct no_os_clk_desc *desc)
 }
 
 /**
- * Start the clock.
+ * @brief Prepare the clock. The parents are prepared first and the hardware
+ * is only accessed for the first of several no_os_clk_prepare() calls.
+ * @param desc - The clock descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_clk_prepare(struct no_os_clk_desc *desc)
+{
+	int ret;
+
+	if (!desc || !desc->platform_ops)
+		return -EINVAL;
+
+	if (desc->prepare_count) {
+		desc->prepare_count++;
+		return 0;
+	}
+
+	if (desc->parent) {
+		ret = no_os_clk_prepare(desc->parent);
+		if (ret)
+			return ret;
+	}
+
+	if (desc->platform_ops->clk_prepare) {
+		ret = desc->platform_ops->clk_prepare(desc);
+		if (ret) {
+			if (desc->parent)
+				no_os_clk_unprepare(desc->parent);
+			return ret;
+		}
+	}
+
+	desc->prepare_count = 1;
+
+	return 0;
+}
+
+/**
+ * @brief Undo a no_os_clk_prepare() call. The clock is unprepared, followed
+ * by its parents, when the last preparation is undone.
+ * @param desc - The clock descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_clk_unprepare(struct no_os_clk_desc *desc)
+{
+	int ret = 0;
+
+	if (!desc || !desc->platform_ops)
+		return -EINVAL;
+
+	if (!desc->prepare_count || --desc->prepare_count)
+		return 0;
+
+	if (desc->platform_ops->clk_unprepare)
+		ret = desc->platform_ops->clk_unprepare(desc);
+
+	if (desc->parent)
+		no_os_clk_unprepare(desc->parent);
+
+	return ret;
+}
+
+/**
+ * Start the clock. The parents are started first and the hardware is only
+ * accessed for the first of several no_os_clk_enable() calls. Clocks without
+ * an enable operation are considered always running.
  * @param clk - The clock descriptor.
  * @return 0 in case of success, negative error code otherwise.
  */
 int32_t no_os_clk_enable(struct no_os_clk_desc *desc)
 {
+	int ret;
+
 	if (!desc || !desc->platform_ops)
 		return -EINVAL;
 
-	if (!desc->platform_ops->clk_enable)
-		return -ENOSYS;
+	if (desc->enable_count) {
+		desc->enable_count++;
+		return 0;
+	}
+
+	if (desc->parent) {
+		ret = no_os_clk_enable(desc->parent);
+		if (ret)
+			return ret;
+	}
+
+	if (desc->platform_ops->clk_enable) {
+		ret = desc->platform_ops->clk_enable(desc);
+		if (ret) {
+			if (desc->parent)
+				no_os_clk_disable(desc->parent);
+			return ret;
+		}
+	}
+
+	desc->enable_count = 1;
 
-	return desc->platform_ops->clk_enable(desc);
+	return 0;
 }
 
 /**
- * Stop the clock.
+ * Stop the clock. The clock is stopped, followed by its parents, when the
+ * last no_os_clk_enable() call is undone.
  * @param clk - The clock descriptor.
  * @return 0 in case of success, negative error code otherwise.
  */
 int32_t no_os_clk_disable(struct no_os_clk_desc *desc)
 {
+	int ret = 0;
+
 	if (!desc || !desc->platform_ops)
 		return -EINVAL;
 
-	if (!desc->platform_ops->clk_disable)
+	if (!desc->enable_count || --desc->enable_count)
+		return 0;
+
+	if (desc->platform_ops->clk_disable)
+		ret = desc->platform_ops->clk_disable(desc);
+
+	if (desc->parent)
+		no_os_clk_disable(desc->parent);
+
+	return ret;
+}
+
+/**
+ * @brief Prepare and start the clock.
+ * @param desc - The clock descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_clk_prepare_enable(struct no_os_clk_desc *desc)
+{
+	int ret;
+
+	ret = no_os_clk_prepare(desc);
+	if (ret)
+		return ret;
+
+	ret = no_os_clk_enable(desc);
+	if (ret)
+		no_os_clk_unprepare(desc);
+
+	return ret;
+}
+
+/**
+ * @brief Stop and unprepare the clock.
+ * @param desc - The clock descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_clk_disable_unprepare(struct no_os_clk_desc *desc)
+{
+	int ret;
+
+	ret = no_os_clk_disable(desc);
+	if (ret)
+		return ret;
+
+	return no_os_clk_unprepare(desc);
+}
+
+/**
+ * @brief Drop the cached rate of the clock and of its children. Drivers call
+ * this when the rate is changed without no_os_clk_set_rate().
+ * @param desc - The clock descriptor.
+ */
+void no_os_clk_invalidate_rate(struct no_os_clk_desc *desc)
+{
+	struct no_os_clk_desc *child;
+
+	if (!desc)
+		return;
+
+	desc->rate_valid = false;
+	for (child = desc->children; child; child = child->sibling)
+		no_os_clk_invalidate_rate(child);
+}
+
+/**
+ * @brief Read the rate of a clock, from the cache if allowed.
+ * @param desc - The clock descriptor.
+ * @param rate - The current frequency.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int no_os_clk_get_rate(struct no_os_clk_desc *desc, uint64_t *rate)
+{
+	int ret;
+
+	if (desc->rate_valid && (desc->flags & NO_OS_CLK_CACHE_RATE)) {
+		*rate = desc->rate;
+		return 0;
+	}
+
+	if (!desc->platform_ops->clk_recalc_rate)
 		return -ENOSYS;
 
-	return desc->platform_ops->clk_disable(desc);
+	ret = desc->platform_ops->clk_recalc_rate(desc, rate);
+	if (ret)
+		return ret;
+
+	desc->rate = *rate;
+	desc->rate_valid = true;
+
+	return 0;
 }
 
 /**
- * Get the current frequency of the clock.
+ * Get the current frequency of the clock. Clocks flagged with
+ * NO_OS_CLK_CACHE_RATE only access the hardware after a rate change.
  * @param clk - The clock descriptor.
  * @param rate - The current frequency.
  * @return 0 in case of success, negative error code otherwise.
@@ -148,10 +381,7 @@ int32_t no_os_clk_recalc_rate(struct no_os_clk_desc *desc,
 	if (!desc || !desc->platform_ops || !rate)
 		return -EINVAL;
 
-	if (!desc->platform_ops->clk_recalc_rate)
-		return -ENOSYS;
-
-	return desc->platform_ops->clk_recalc_rate(desc, rate);
+	return no_os_clk_get_rate(desc, rate);
 }
 
 /**
@@ -175,7 +405,86 @@ int32_t no_os_clk_round_rate(struct no_os_clk_desc *desc,
 }
 
 /**
- * Change the frequency of the clock.
+ * @brief Record the rate of the clocks having notifiers before a change.
+ * @param desc - The root of the subtree being changed.
+ */
+static void no_os_clk_snapshot_rate(struct no_os_clk_desc *desc)
+{
+	struct no_os_clk_desc *child;
+	uint64_t rate;
+
+	if (desc->notifiers && no_os_clk_get_rate(desc, &rate))
+		desc->rate = 0;
+
+	for (child = desc->children; child; child = child->sibling)
+		no_os_clk_snapshot_rate(child);
+}
+
+/**
+ * @brief Deliver an event to the notifiers of a clock subtree.
+ * @param desc - The root of the subtree.
+ * @param event - NO_OS_CLK_PRE_RATE_CHANGE or NO_OS_CLK_ABORT_RATE_CHANGE.
+ * @param rate - The requested rate of the root clock.
+ * @return 0 in case of success, the veto of a notifier otherwise.
+ */
+static int no_os_clk_notify(struct no_os_clk_desc *desc,
+			    enum no_os_clk_event event, uint64_t rate)
+{
+	struct no_os_clk_notifier_data data;
+	struct no_os_clk_notifier *nb;
+	struct no_os_clk_desc *child;
+	int ret;
+
+	data.clk = desc;
+	data.old_rate = desc->rate;
+	data.new_rate = rate;
+
+	for (nb = desc->notifiers; nb; nb = nb->next) {
+		ret = nb->notifier_call(nb, event, &data);
+		if (ret && event == NO_OS_CLK_PRE_RATE_CHANGE)
+			return ret;
+	}
+
+	for (child = desc->children; child; child = child->sibling) {
+		ret = no_os_clk_notify(child, event, 0);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Drop the cached rates of a subtree after a change and deliver the
+ * new rates to the notifiers.
+ * @param desc - The root of the subtree.
+ */
+static void no_os_clk_propagate_rate(struct no_os_clk_desc *desc)
+{
+	struct no_os_clk_notifier_data data;
+	struct no_os_clk_notifier *nb;
+	struct no_os_clk_desc *child;
+
+	data.old_rate = desc->rate;
+	desc->rate_valid = false;
+
+	if (desc->notifiers) {
+		data.clk = desc;
+		if (no_os_clk_get_rate(desc, &data.new_rate))
+			data.new_rate = 0;
+
+		for (nb = desc->notifiers; nb; nb = nb->next)
+			nb->notifier_call(nb, NO_OS_CLK_POST_RATE_CHANGE, &data);
+	}
+
+	for (child = desc->children; child; child = child->sibling)
+		no_os_clk_propagate_rate(child);
+}
+
+/**
+ * Change the frequency of the clock. The notifiers of the clock and of its
+ * children are called before and after the change and the cached rates of
+ * the subtree are dropped.
  * @param clk - The clock descriptor.
  * @param rate - The desired frequency.
  * @return 0 in case of success, negative error code otherwise.
@@ -183,11 +492,195 @@ int32_t no_os_clk_round_rate(struct no_os_clk_desc *desc,
 int32_t no_os_clk_set_rate(struct no_os_clk_desc *desc,
 			   uint64_t rate)
 {
+	int ret;
+
 	if (!desc || !desc->platform_ops)
 		return -EINVAL;
 
-	if (!desc->platform_ops->clk_set_rate)
+	if (!desc->platform_ops->clk_set_rate) {
+		if ((desc->flags & NO_OS_CLK_SET_RATE_PARENT) && desc->parent)
+			return no_os_clk_set_rate(desc->parent, rate);
+
 		return -ENOSYS;
+	}
+
+	no_os_clk_snapshot_rate(desc);
+
+	ret = no_os_clk_notify(desc, NO_OS_CLK_PRE_RATE_CHANGE, rate);
+	if (ret)
+		goto abort;
+
+	ret = desc->platform_ops->clk_set_rate(desc, rate);
+	if (ret)
+		goto abort;
+
+	no_os_clk_propagate_rate(desc);
+
+	return 0;
+
+abort:
+	no_os_clk_notify(desc, NO_OS_CLK_ABORT_RATE_CHANGE, rate);
+	no_os_clk_invalidate_rate(desc);
+
+	return ret;
+}
+
+/**
+ * @brief Move the clock under a new parent. The new parent takes over the
+ * preparation and enable references held on the old one.
+ * @param desc - The clock descriptor.
+ * @param parent - The new parent, NULL to make the clock a root clock.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_clk_set_parent(struct no_os_clk_desc *desc,
+			     struct no_os_clk_desc *parent)
+{
+	struct no_os_clk_desc *old_parent;
+	struct no_os_clk_desc *p;
+	int ret;
+
+	if (!desc || !desc->platform_ops)
+		return -EINVAL;
+
+	if (desc->parent == parent)
+		return 0;
+
+	/* The clock can not become the child of one of its children. */
+	for (p = parent; p; p = p->parent)
+		if (p == desc)
+			return -EINVAL;
+
+	if (desc->prepare_count && parent) {
+		ret = no_os_clk_prepare(parent);
+		if (ret)
+			return ret;
+	}
+
+	if (desc->enable_count && parent) {
+		ret = no_os_clk_enable(parent);
+		if (ret)
+			goto unprepare;
+	}
+
+	if (desc->platform_ops->clk_set_parent) {
+		ret = desc->platform_ops->clk_set_parent(desc, parent);
+		if (ret)
+			goto disable;
+	}
+
+	old_parent = desc->parent;
+	no_os_clk_unlink(desc);
+	no_os_clk_link(desc, parent);
+
+	if (desc->enable_count && old_parent)
+		no_os_clk_disable(old_parent);
+	if (desc->prepare_count && old_parent)
+		no_os_clk_unprepare(old_parent);
+
+	no_os_clk_invalidate_rate(desc);
+
+	return 0;
+
+disable:
+	if (desc->enable_count && parent)
+		no_os_clk_disable(parent);
+unprepare:
+	if (desc->prepare_count && parent)
+		no_os_clk_unprepare(parent);
+
+	return ret;
+}
+
+/**
+ * @brief Get the parent of the clock.
+ * @param desc - The clock descriptor.
+ * @return The parent clock, NULL for a root clock.
+ */
+struct no_os_clk_desc *no_os_clk_get_parent(struct no_os_clk_desc *desc)
+{
+	return desc ? desc->parent : NULL;
+}
+
+/**
+ * @brief Register a rate change notifier.
+ * @param desc - The clock descriptor.
+ * @param nb - The notifier, kept by the consumer until it is unregistered.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_clk_notifier_register(struct no_os_clk_desc *desc,
+				    struct no_os_clk_notifier *nb)
+{
+	if (!desc || !nb || !nb->notifier_call)
+		return -EINVAL;
+
+	nb->next = desc->notifiers;
+	desc->notifiers = nb;
+
+	return 0;
+}
+
+/**
+ * @brief Unregister a rate change notifier.
+ * @param desc - The clock descriptor.
+ * @param nb - The notifier.
+ * @return 0 in case of success, -ENOENT if the notifier is not registered.
+ */
+int32_t no_os_clk_notifier_unregister(struct no_os_clk_desc *desc,
+				      struct no_os_clk_notifier *nb)
+{
+	struct no_os_clk_notifier **p;
+
+	if (!desc || !nb)
+		return -EINVAL;
+
+	for (p = &desc->notifiers; *p; p = &(*p)->next) {
+		if (*p == nb) {
+			*p = nb->next;
+			nb->next = NULL;
+			return 0;
+		}
+	}
+
+	return -ENOENT;
+}
+
+/**
+ * @brief Print a clock and its children.
+ * @param desc - The clock descriptor.
+ * @param level - Depth of the clock in the printed tree.
+ */
+static void no_os_clk_dump(struct no_os_clk_desc *desc, uint32_t level)
+{
+	struct no_os_clk_desc *child;
+	uint64_t rate;
+	bool cached;
+
+	cached = desc->rate_valid && (desc->flags & NO_OS_CLK_CACHE_RATE);
+
+	if (no_os_clk_get_rate(desc, &rate))
+		pr_info("%*s%-*s %6" PRIu32 " %7" PRIu32 " %20s\n", (int)level * 2,
+			"", 32 - (int)level * 2, desc->name ? desc->name : "?",
+			desc->enable_count, desc->prepare_count, "-");
+	else
+		pr_info("%*s%-*s %6" PRIu32 " %7" PRIu32 " %20" PRIu64 "%s\n",
+			(int)level * 2, "", 32 - (int)level * 2,
+			desc->name ? desc->name : "?", desc->enable_count,
+			desc->prepare_count, rate, cached ? " (cached)" : "");
+
+	for (child = desc->children; child; child = child->sibling)
+		no_os_clk_dump(child, level + 1);
+}
+
+/**
+ * @brief Print the clock tree starting from the given clock, with the
+ * enable and prepare counts and the rate of each clock.
+ * @param root - The clock descriptor.
+ */
+void no_os_clk_tree_dump(struct no_os_clk_desc *root)
+{
+	if (!root)
+		return;
 
-	return desc->platform_ops->clk_set_rate(desc, rate);
+	pr_info("%-32s %6s %7s %20s\n", "clock", "enable", "prepare", "rate");
+	no_os_clk_dump(root, 0);
 }
@@ -0,0 +1,669 @@
+/***************************************************************************//**
+ *   @file   no_os_dlog.c
+ *   @brief  Deferred binary logger.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include "no_os_dlog.h"
+#include "no_os_error.h"
+#include "no_os_util.h"
+
+#define NO_OS_DLOG_VALID		0x80000000
+#define NO_OS_DLOG_LEVEL_POS		8
+#define NO_OS_DLOG_LEN_MSK		NO_OS_GENMASK(7, 0)
+#define NO_OS_DLOG_MAGIC		0x474F4C44
+#define NO_OS_DLOG_FLAG_TIMESTAMP	NO_OS_BIT(0)
+#define NO_OS_DLOG_PTR_WORDS		(sizeof(uintptr_t) / sizeof(uint32_t))
+#define NO_OS_DLOG_ENTRY_MAX		(1 + NO_OS_DLOG_PTR_WORDS + 1 + \
+					 2 * NO_OS_DLOG_MAX_ARGS)
+
+#define NO_OS_DLOG_ARG_BITS		3
+#define NO_OS_DLOG_ARG_MSK		NO_OS_GENMASK(2, 0)
+#define NO_OS_DLOG_SPEC_MAX		12
+
+/** Types of the recorded arguments, 3 bits each in the call site signature */
+enum no_os_dlog_arg {
+	NO_OS_DLOG_ARG_END,
+	NO_OS_DLOG_ARG_INT,
+	NO_OS_DLOG_ARG_LL,
+	NO_OS_DLOG_ARG_DBL,
+	NO_OS_DLOG_ARG_PTR,
+};
+
+/**
+ * @struct no_os_dlog_desc
+ * @brief Deferred logger state.
+ */
+static struct no_os_dlog_desc {
+	uint32_t *ring;
+	uint32_t mask;
+	/** Reservation index, shared by the producers */
+	uint32_t head;
+	/** Consumer index */
+	uint32_t tail;
+	uint32_t dropped;
+	uint32_t (*timestamp)(void);
+	void (*output)(const char *line);
+} dlog;
+
+volatile uint32_t no_os_dlog_levels;
+
+static const char *const no_os_dlog_labels[] = {
+	"EMERG", "ALERT", "CRIT", "ERR", "WARNING", "NOTICE", "INFO", "DEBUG"
+};
+
+/**
+ * @brief Initialize the deferred logger.
+ * @param param - Initialization parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_dlog_init(struct no_os_dlog_init_param *param)
+{
+	if (!param || !param->buffer || param->size < NO_OS_DLOG_ENTRY_MAX ||
+	    (param->size & (param->size - 1)) || param->level > NO_OS_LOG_DEBUG)
+		return -EINVAL;
+
+	no_os_dlog_levels = 0;
+	memset(param->buffer, 0, param->size * sizeof(uint32_t));
+
+	dlog.ring = param->buffer;
+	dlog.mask = param->size - 1;
+	dlog.head = 0;
+	dlog.tail = 0;
+	dlog.dropped = 0;
+	dlog.timestamp = param->timestamp;
+	dlog.output = param->output;
+
+	no_os_dlog_set_level(param->level);
+
+	return 0;
+}
+
+/**
+ * @brief Stop the deferred logger. Must not race with the log calls.
+ */
+void no_os_dlog_remove(void)
+{
+	no_os_dlog_levels = 0;
+	dlog.ring = NULL;
+}
+
+/**
+ * @brief Record all the levels up to and including a given level.
+ * @param level - NO_OS_LOG_* level.
+ */
+void no_os_dlog_set_level(uint8_t level)
+{
+	if (level > NO_OS_LOG_DEBUG)
+		level = NO_OS_LOG_DEBUG;
+
+	no_os_dlog_levels = NO_OS_GENMASK(level, 0);
+}
+
+/**
+ * @brief Enable or disable the recording of a single level.
+ * @param level - NO_OS_LOG_* level.
+ * @param enable - true to record the level.
+ */
+void no_os_dlog_enable_level(uint8_t level, bool enable)
+{
+	if (level > NO_OS_LOG_DEBUG)
+		return;
+
+	if (enable)
+		no_os_dlog_levels |= NO_OS_BIT(level);
+	else
+		no_os_dlog_levels &= ~NO_OS_BIT(level);
+}
+
+/**
+ * @brief Parse a conversion specification.
+ * @param fmt - Format, just after the '%' character.
+ * @param args - Types of the arguments used by the conversion ('*' width and
+ *		 precision first).
+ * @param nb_args - Number of arguments used by the conversion.
+ * @return Format after the conversion, NULL if the conversion is not
+ *	   supported.
+ */
+static const char *no_os_dlog_conv(const char *fmt, uint8_t *args,
+				   uint8_t *nb_args)
+{
+	uint8_t size = NO_OS_DLOG_ARG_INT;
+	bool long_dbl = false;
+
+	*nb_args = 0;
+	if (*fmt == '%')
+		return fmt + 1;
+
+	while (*fmt && strchr("-+ #0'", *fmt))
+		fmt++;
+	while ((*fmt >= '0' && *fmt <= '9') || *fmt == '*' || *fmt == '.') {
+		if (*fmt == '*')
+			args[(*nb_args)++] = NO_OS_DLOG_ARG_INT;
+		fmt++;
+	}
+
+	switch (*fmt) {
+	case 'h':
+		fmt += (fmt[1] == 'h') ? 2 : 1;
+		break;
+	case 'l':
+		if (fmt[1] == 'l') {
+			size = NO_OS_DLOG_ARG_LL;
+			fmt += 2;
+			break;
+		}
+		if (sizeof(long) == sizeof(uint64_t))
+			size = NO_OS_DLOG_ARG_LL;
+		fmt++;
+		break;
+	case 'j':
+		size = NO_OS_DLOG_ARG_LL;
+		fmt++;
+		break;
+	case 'z':
+	case 't':
+		if (sizeof(size_t) == sizeof(uint64_t))
+			size = NO_OS_DLOG_ARG_LL;
+		fmt++;
+		break;
+	case 'L':
+		long_dbl = true;
+		fmt++;
+		break;
+	default:
+		break;
+	}
+
+	switch (*fmt) {
+	case 'd':
+	case 'i':
+	case 'u':
+	case 'o':
+	case 'x':
+	case 'X':
+	case 'c':
+		args[(*nb_args)++] = size;
+		break;
+	case 'f':
+	case 'F':
+	case 'e':
+	case 'E':
+	case 'g':
+	case 'G':
+	case 'a':
+	case 'A':
+		if (long_dbl)
+			return NULL;
+		args[(*nb_args)++] = NO_OS_DLOG_ARG_DBL;
+		break;
+	case 's':
+	case 'p':
+		args[(*nb_args)++] = NO_OS_DLOG_ARG_PTR;
+		break;
+	default:
+		return NULL;
+	}
+
+	return fmt + 1;
+}
+
+/**
+ * @brief Compute the argument signature of a format.
+ * @param fmt - Format.
+ * @return Signature, 3 bits per argument and bit 31 set.
+ */
+static uint32_t no_os_dlog_signature(const char *fmt)
+{
+	uint32_t sig = NO_OS_DLOG_VALID;
+	uint8_t args[3];
+	uint8_t nb_args;
+	uint8_t n = 0;
+	uint8_t i;
+
+	while (*fmt) {
+		if (*fmt++ != '%')
+			continue;
+
+		fmt = no_os_dlog_conv(fmt, args, &nb_args);
+		if (!fmt || n + nb_args > NO_OS_DLOG_MAX_ARGS)
+			break;
+
+		for (i = 0; i < nb_args; i++, n++)
+			sig |= (uint32_t)args[i] << (n * NO_OS_DLOG_ARG_BITS);
+	}
+
+	return sig;
+}
+
+/**
+ * @brief Get the number of words of an argument.
+ * @param arg - Argument type.
+ * @return Number of 32 bit words.
+ */
+static uint32_t no_os_dlog_arg_words(uint8_t arg)
+{
+	switch (arg) {
+	case NO_OS_DLOG_ARG_INT:
+		return 1;
+	case NO_OS_DLOG_ARG_PTR:
+		return NO_OS_DLOG_PTR_WORDS;
+	default:
+		return 2;
+	}
+}
+
+/**
+ * @brief Record an entry. Safe to call from several threads and interrupts.
+ * @param id - Call site descriptor.
+ * @param sig - Call site signature cache, computed on the first call.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_dlog_record(const struct no_os_dlog_fmt *id, uint32_t *sig, ...)
+{
+	uint32_t *ring = dlog.ring;
+	uint32_t head, tail, len, pos, s;
+	uintptr_t ptr;
+	uint64_t val;
+	double dbl;
+	uint8_t arg;
+	va_list ap;
+
+	if (!ring)
+		return -ENODEV;
+
+	s = __atomic_load_n(sig, __ATOMIC_RELAXED);
+	if (!s) {
+		s = no_os_dlog_signature(id->fmt);
+		__atomic_store_n(sig, s, __ATOMIC_RELAXED);
+	}
+
+	len = 1 + NO_OS_DLOG_PTR_WORDS + (dlog.timestamp ? 1 : 0);
+	for (pos = 0; pos < NO_OS_DLOG_MAX_ARGS; pos++) {
+		arg = (s >> (pos * NO_OS_DLOG_ARG_BITS)) & NO_OS_DLOG_ARG_MSK;
+		if (arg == NO_OS_DLOG_ARG_END)
+			break;
+		len += no_os_dlog_arg_words(arg);
+	}
+
+	head = __atomic_load_n(&dlog.head, __ATOMIC_RELAXED);
+	do {
+		tail = __atomic_load_n(&dlog.tail, __ATOMIC_ACQUIRE);
+		if (head - tail + len > dlog.mask + 1) {
+			__atomic_fetch_add(&dlog.dropped, 1, __ATOMIC_RELAXED);
+			return -ENOSPC;
+		}
+	} while (!__atomic_compare_exchange_n(&dlog.head, &head, head + len,
+					      true, __ATOMIC_RELAXED,
+					      __ATOMIC_RELAXED));
+
+	pos = head + 1;
+	ptr = (uintptr_t)id;
+	ring[pos++ & dlog.mask] = (uint32_t)ptr;
+	if (NO_OS_DLOG_PTR_WORDS > 1)
+		ring[pos++ & dlog.mask] = (uint32_t)((uint64_t)ptr >> 32);
+	if (dlog.timestamp)
+		ring[pos++ & dlog.mask] = dlog.timestamp();
+
+	va_start(ap, sig);
+	for (s &= ~NO_OS_DLOG_VALID; s; s >>= NO_OS_DLOG_ARG_BITS) {
+		arg = s & NO_OS_DLOG_ARG_MSK;
+		switch (arg) {
+		case NO_OS_DLOG_ARG_INT:
+			ring[pos++ & dlog.mask] = va_arg(ap, unsigned int);
+			continue;
+		case NO_OS_DLOG_ARG_LL:
+			val = va_arg(ap, unsigned long long);
+			break;
+		case NO_OS_DLOG_ARG_DBL:
+			dbl = va_arg(ap, double);
+			memcpy(&val, &dbl, sizeof(val));
+			break;
+		default:
+			ptr = (uintptr_t)va_arg(ap, void *);
+			ring[pos++ & dlog.mask] = (uint32_t)ptr;
+			if (NO_OS_DLOG_PTR_WORDS > 1)
+				ring[pos++ & dlog.mask] = (uint32_t)((uint64_t)ptr >> 32);
+			continue;
+		}
+		ring[pos++ & dlog.mask] = (uint32_t)val;
+		ring[pos++ & dlog.mask] = (uint32_t)(val >> 32);
+	}
+	va_end(ap);
+
+	/* The consumer stops at a zero header, publish the entry last. */
+	__atomic_store_n(&ring[head & dlog.mask], NO_OS_DLOG_VALID |
+			 (id->level << NO_OS_DLOG_LEVEL_POS) | len,
+			 __ATOMIC_RELEASE);
+
+	return 0;
+}
+
+/**
+ * @brief Remove the oldest complete entry from the ring.
+ * @param entry - Entry words, header first.
+ * @return Number of words of the entry, 0 if there is none.
+ */
+static uint32_t no_os_dlog_pop(uint32_t *entry)
+{
+	uint32_t tail = dlog.tail;
+	uint32_t len, i;
+
+	entry[0] = __atomic_load_n(&dlog.ring[tail & dlog.mask],
+				   __ATOMIC_ACQUIRE);
+	if (!entry[0])
+		return 0;
+
+	len = no_os_field_get(NO_OS_DLOG_LEN_MSK, entry[0]);
+	dlog.ring[tail & dlog.mask] = 0;
+	for (i = 1; i < len; i++) {
+		entry[i] = dlog.ring[(tail + i) & dlog.mask];
+		dlog.ring[(tail + i) & dlog.mask] = 0;
+	}
+
+	__atomic_store_n(&dlog.tail, tail + len, __ATOMIC_RELEASE);
+
+	return len;
+}
+
+/**
+ * @brief Get a pointer stored in an entry.
+ * @param words - Entry words.
+ * @return Pointer.
+ */
+static uintptr_t no_os_dlog_get_ptr(const uint32_t *words)
+{
+	uint64_t ptr = words[0];
+
+	if (NO_OS_DLOG_PTR_WORDS > 1)
+		ptr |= (uint64_t)words[1] << 32;
+
+	return (uintptr_t)ptr;
+}
+
+/**
+ * @brief Format an entry.
+ * @param entry - Entry words, header first.
+ * @param len - Number of words of the entry.
+ * @param line - Output buffer of NO_OS_DLOG_LINE_MAX characters.
+ */
+static void no_os_dlog_format(const uint32_t *entry, uint32_t len, char *line)
+{
+	const struct no_os_dlog_fmt *id;
+	const char *fmt, *conv;
+	uint32_t size = NO_OS_DLOG_LINE_MAX;
+	uint32_t pos = 1 + NO_OS_DLOG_PTR_WORDS;
+	uint8_t args[3];
+	uint8_t nb_args;
+	uint32_t n = 0;
+	char spec[NO_OS_DLOG_SPEC_MAX + 24];
+	uint64_t val;
+	double dbl;
+	uint32_t i, j, k;
+	int ret;
+
+	id = (const struct no_os_dlog_fmt *)no_os_dlog_get_ptr(&entry[1]);
+
+	line[0] = '\0';
+	if (dlog.timestamp)
+		n += snprintf(line, size, "[%10lu] ",
+			      (unsigned long)entry[pos++]);
+
+	if (id->level <= NO_OS_LOG_ERR)
+		n += snprintf(line + n, size - n, "%s: %s:%d:%s(): ",
+			      no_os_dlog_labels[id->level], id->file,
+			      (int)id->line, id->func);
+	else if (id->level != NO_OS_LOG_INFO)
+		n += snprintf(line + n, size - n, "%s: ",
+			      no_os_dlog_labels[id->level]);
+
+	fmt = id->fmt;
+	while (*fmt && n < size - 1) {
+		if (*fmt != '%') {
+			line[n++] = *fmt++;
+			continue;
+		}
+
+		conv = no_os_dlog_conv(fmt + 1, args, &nb_args);
+		if (!conv || conv - fmt > NO_OS_DLOG_SPEC_MAX)
+			break;
+		if (!nb_args) {
+			line[n++] = '%';
+			fmt = conv;
+			continue;
+		}
+
+		/* Replace '*' width and precision with the recorded values. */
+		for (i = 0, j = 0, k = 0; fmt + i < conv; i++) {
+			if (fmt[i] != '*') {
+				spec[j++] = fmt[i];
+				continue;
+			}
+			if (pos >= len)
+				break;
+			j += snprintf(&spec[j], sizeof(spec) - j, "%d",
+				      (int)entry[pos++]);
+			k++;
+		}
+		spec[j] = '\0';
+
+		if (pos + no_os_dlog_arg_words(args[k]) > len)
+			break;
+		fmt = conv;
+
+		switch (args[k]) {
+		case NO_OS_DLOG_ARG_INT:
+			ret = snprintf(line + n, size - n, spec, entry[pos]);
+			break;
+		case NO_OS_DLOG_ARG_LL:
+			val = entry[pos] | ((uint64_t)entry[pos + 1] << 32);
+			ret = snprintf(line + n, size - n, spec,
+				       (unsigned long long)val);
+			break;
+		case NO_OS_DLOG_ARG_DBL:
+			val = entry[pos] | ((uint64_t)entry[pos + 1] << 32);
+			memcpy(&dbl, &val, sizeof(dbl));
+			ret = snprintf(line + n, size - n, spec, dbl);
+			break;
+		default:
+			ret = snprintf(line + n, size - n, spec,
+				       (void *)no_os_dlog_get_ptr(&entry[pos]));
+			break;
+		}
+		pos += no_os_dlog_arg_words(args[k]);
+		if (ret > 0)
+			n += ret;
+	}
+
+	/* Unsupported conversion or missing arguments, show the raw format. */
+	while (*fmt && n < size - 1)
+		line[n++] = *fmt++;
+
+	if (n > size - 1)
+		n = size - 1;
+	line[n] = '\0';
+}
+
+/**
+ * @brief Format and output the recorded entries. Must be called from a
+ * single context, typically a low priority task or the main loop.
+ * @param max - Maximum number of entries, 0 for all.
+ * @return Number of entries output, negative error code otherwise.
+ */
+int no_os_dlog_flush(uint32_t max)
+{
+	uint32_t entry[NO_OS_DLOG_ENTRY_MAX];
+	char line[NO_OS_DLOG_LINE_MAX];
+	uint32_t len;
+	int cnt = 0;
+
+	if (!dlog.ring)
+		return -ENODEV;
+
+	while (!max || (uint32_t)cnt < max) {
+		len = no_os_dlog_pop(entry);
+		if (!len)
+			break;
+
+		no_os_dlog_format(entry, len, line);
+		if (dlog.output)
+			dlog.output(line);
+		else
+			printf("%s", line);
+		cnt++;
+	}
+
+	return cnt;
+}
+
+/**
+ * @brief Write the recorded entries in binary form, preceded by a header
+ * (magic, flags, number of dropped entries, run time address of
+ * no_os_dlog_levels). The stream is decoded on a host by
+ * tools/scripts/no_os_dlog_decode.py using the application ELF file, the
+ * address letting it find the load address of position independent
+ * executables.
+ * @param max - Maximum number of entries, 0 for all.
+ * @param write - Output function, e.g. a UART write.
+ * @return Number of entries written, negative error code otherwise.
+ */
+int no_os_dlog_dump(uint32_t max, void (*write)(const void *data,
+		    uint32_t len))
+{
+	uint32_t entry[NO_OS_DLOG_ENTRY_MAX];
+	uint32_t hdr[3 + NO_OS_DLOG_PTR_WORDS];
+	uintptr_t anchor = (uintptr_t)&no_os_dlog_levels;
+	uint32_t len;
+	int cnt = 0;
+
+	if (!dlog.ring)
+		return -ENODEV;
+	if (!write)
+		return -EINVAL;
+
+	hdr[0] = NO_OS_DLOG_MAGIC;
+	hdr[1] = no_os_field_prep(NO_OS_GENMASK(15, 8), NO_OS_DLOG_PTR_WORDS);
+	if (dlog.timestamp)
+		hdr[1] |= NO_OS_DLOG_FLAG_TIMESTAMP;
+	hdr[2] = __atomic_exchange_n(&dlog.dropped, 0, __ATOMIC_RELAXED);
+	memcpy(&hdr[3], &anchor, sizeof(anchor));
+	write(hdr, sizeof(hdr));
+
+	while (!max || (uint32_t)cnt < max) {
+		len = no_os_dlog_pop(entry);
+		if (!len)
+			break;
+
+		write(entry, len * sizeof(uint32_t));
+		cnt++;
+	}
+
+	return cnt;
+}
+
+/**
+ * @brief Get the number of entries lost because the ring was full.
+ * @return Number of dropped entries.
+ */
+uint32_t no_os_dlog_dropped(void)
+{
+	return __atomic_load_n(&dlog.dropped, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Measure the cycles per log call of the deferred logger and of
+ * printf(), for the same message. The messages are output.
+ * @param count - Number of calls of each kind.
+ * @param cycles - Cycle (or other high resolution time) counter.
+ * @param result - Average cycles per call.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_dlog_bench(uint32_t count, uint32_t (*cycles)(void),
+		     struct no_os_dlog_bench_result *result)
+{
+	uint32_t levels = no_os_dlog_levels;
+	uint32_t dlog_cycles = 0;
+	uint32_t flush_cycles = 0;
+	uint32_t start, i;
+	int ret = 0;
+
+	if (!dlog.ring)
+		return -ENODEV;
+	if (!count || !cycles || !result)
+		return -EINVAL;
+
+	no_os_dlog_flush(0);
+	no_os_dlog_enable_level(NO_OS_LOG_ERR, true);
+
+	for (i = 0; i < count; i++) {
+		start = cycles();
+		no_os_dlog(NO_OS_LOG_ERR, "bench %lu: 0x%08lx %s\n",
+			   (unsigned long)i, (unsigned long)(i * 3), "dlog");
+		dlog_cycles += cycles() - start;
+
+		/* Keep room in the ring, a dropped entry costs less. */
+		if (no_os_dlog_dropped()) {
+			ret = -ENOSPC;
+			goto out;
+		}
+		if (((dlog.head - dlog.tail) * 2) > dlog.mask) {
+			start = cycles();
+			ret = no_os_dlog_flush(0);
+			flush_cycles += cycles() - start;
+		}
+	}
+	start = cycles();
+	no_os_dlog_flush(0);
+	flush_cycles += cycles() - start;
+
+	no_os_dlog_enable_level(NO_OS_LOG_ERR, false);
+	start = cycles();
+	for (i = 0; i < count; i++)
+		no_os_dlog(NO_OS_LOG_ERR, "bench %lu: 0x%08lx %s\n",
+			   (unsigned long)i, (unsigned long)(i * 3), "dlog");
+	result->filtered_cycles = (cycles() - start) / count;
+
+	start = cycles();
+	for (i = 0; i < count; i++)
+		printf("ERR: %s:%d:%s(): bench %lu: 0x%08lx %s\n", __FILE__,
+		       __LINE__, __func__, (unsigned long)i,
+		       (unsigned long)(i * 3), "printf");
+	result->printf_cycles = (cycles() - start) / count;
+
+	result->dlog_cycles = dlog_cycles / count;
+	result->flush_cycles = flush_cycles / count;
+	ret = 0;
+out:
+	no_os_dlog_levels = levels;
+
+	return ret;
+}
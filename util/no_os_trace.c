@@ -0,0 +1,344 @@
+/***************************************************************************//**
+ *   @file   no_os_trace.c
+ *   @brief  Trace points and latency histograms.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include "no_os_trace.h"
+#include "no_os_error.h"
+#include "no_os_util.h"
+
+/**
+ * @struct no_os_trace_desc
+ * @brief Tracing state.
+ */
+static struct no_os_trace_desc {
+	uint32_t (*get_cycles)(void);
+	struct no_os_timer_desc *timer;
+	uint32_t freq_hz;
+	uint8_t hist_shift;
+	struct no_os_trace_event *events;
+	uint32_t events_mask;
+	/** Number of events recorded since the last reset */
+	uint32_t event_idx;
+	bool enabled;
+	struct no_os_trace_point *points;
+} trace;
+
+/**
+ * @brief Initialize the tracing and enable it.
+ * @param param - Initialization parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_trace_init(struct no_os_trace_init_param *param)
+{
+	if (!param || (!param->get_cycles && !param->timer) ||
+	    param->hist_shift > 31 - NO_OS_TRACE_BUCKETS)
+		return -EINVAL;
+
+	if (param->events && (!param->nb_events ||
+			      (param->nb_events & (param->nb_events - 1))))
+		return -EINVAL;
+
+	trace.enabled = false;
+	trace.get_cycles = param->get_cycles;
+	trace.timer = param->timer;
+	trace.freq_hz = param->freq_hz;
+	if (!trace.freq_hz && !trace.get_cycles)
+		trace.freq_hz = param->timer->freq_hz;
+	if (!trace.freq_hz)
+		return -EINVAL;
+
+	trace.hist_shift = param->hist_shift;
+	trace.events = param->events;
+	trace.events_mask = param->events ? param->nb_events - 1 : 0;
+	no_os_trace_reset();
+
+	trace.enabled = true;
+
+	return 0;
+}
+
+/**
+ * @brief Stop the tracing. The trace points keep their statistics.
+ */
+void no_os_trace_remove(void)
+{
+	trace.enabled = false;
+	trace.get_cycles = NULL;
+	trace.timer = NULL;
+	trace.events = NULL;
+}
+
+/**
+ * @brief Enable or disable the tracing.
+ * @param enable - true to account the trace point hits.
+ */
+void no_os_trace_enable(bool enable)
+{
+	trace.enabled = enable && (trace.get_cycles || trace.timer);
+}
+
+/**
+ * @brief Check whether the tracing is enabled.
+ * @return true if the trace point hits are accounted.
+ */
+bool no_os_trace_is_enabled(void)
+{
+	return trace.enabled;
+}
+
+/**
+ * @brief Get the current timestamp.
+ * @return Counter value (ticks), 0 if the tracing is disabled.
+ */
+uint32_t no_os_trace_now(void)
+{
+	uint32_t cnt = 0;
+
+	if (!trace.enabled)
+		return 0;
+
+	if (trace.get_cycles)
+		return trace.get_cycles();
+
+	no_os_timer_counter_get(trace.timer, &cnt);
+
+	return cnt;
+}
+
+/**
+ * @brief Add a trace point to the list, once.
+ * @param tp - Trace point.
+ */
+static void no_os_trace_register(struct no_os_trace_point *tp)
+{
+	struct no_os_trace_point *head;
+
+	if (__atomic_exchange_n(&tp->registered, 1, __ATOMIC_RELAXED))
+		return;
+
+	head = __atomic_load_n(&trace.points, __ATOMIC_RELAXED);
+	do {
+		tp->next = head;
+	} while (!__atomic_compare_exchange_n(&trace.points, &head, tp, true,
+					      __ATOMIC_RELEASE,
+					      __ATOMIC_RELAXED));
+}
+
+/**
+ * @brief Account a trace point hit.
+ * @param tp - Trace point.
+ * @param start - Begin timestamp, from no_os_trace_now().
+ */
+void no_os_trace_end(struct no_os_trace_point *tp, uint32_t start)
+{
+	struct no_os_trace_event *ev;
+	uint32_t duration;
+	uint32_t bucket;
+
+	if (!trace.enabled)
+		return;
+
+	duration = no_os_trace_now() - start;
+
+	if (!tp->registered)
+		no_os_trace_register(tp);
+
+	if (!tp->count || duration < tp->min)
+		tp->min = duration;
+	if (duration > tp->max)
+		tp->max = duration;
+	tp->total += duration;
+	tp->count++;
+
+	bucket = duration >> trace.hist_shift;
+	bucket = bucket ? 32 - __builtin_clz(bucket) : 0;
+	if (bucket >= NO_OS_TRACE_BUCKETS)
+		bucket = NO_OS_TRACE_BUCKETS - 1;
+	tp->hist[bucket]++;
+
+	if (trace.events) {
+		ev = &trace.events[__atomic_fetch_add(&trace.event_idx, 1,
+						      __ATOMIC_RELAXED) &
+				   trace.events_mask];
+		ev->tp = tp;
+		ev->start = start;
+		ev->duration = duration;
+	}
+}
+
+/**
+ * @brief Get the first registered trace point, the others are linked through
+ * the next field.
+ * @return Trace point, NULL if none was hit yet.
+ */
+struct no_os_trace_point *no_os_trace_first(void)
+{
+	return __atomic_load_n(&trace.points, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * @brief Find a registered trace point by name.
+ * @param name - Trace point name.
+ * @return Trace point, NULL if not found.
+ */
+struct no_os_trace_point *no_os_trace_find(const char *name)
+{
+	struct no_os_trace_point *tp;
+
+	if (!name)
+		return NULL;
+
+	for (tp = no_os_trace_first(); tp; tp = tp->next)
+		if (!strcmp(tp->name, name))
+			return tp;
+
+	return NULL;
+}
+
+/**
+ * @brief Clear the statistics of all trace points and the recorded events.
+ */
+void no_os_trace_reset(void)
+{
+	struct no_os_trace_point *tp;
+	bool enabled = trace.enabled;
+
+	trace.enabled = false;
+
+	for (tp = no_os_trace_first(); tp; tp = tp->next) {
+		tp->count = 0;
+		tp->min = 0;
+		tp->max = 0;
+		tp->total = 0;
+		memset(tp->hist, 0, sizeof(tp->hist));
+	}
+	trace.event_idx = 0;
+
+	trace.enabled = enabled;
+}
+
+/**
+ * @brief Convert ticks to nanoseconds.
+ * @param ticks - Number of ticks.
+ * @return Nanoseconds, 0 if the tracing was not initialized.
+ */
+uint64_t no_os_trace_ticks_to_ns(uint64_t ticks)
+{
+	if (!trace.freq_hz)
+		return 0;
+
+	if (ticks > UINT64_MAX / 1000000000)
+		return ticks / trace.freq_hz * 1000000000;
+
+	return ticks * 1000000000 / trace.freq_hz;
+}
+
+/**
+ * @brief Get the upper bound of a histogram bucket.
+ * @param bucket - Bucket index.
+ * @return First duration (ticks) not counted in the bucket, UINT32_MAX for
+ *	   the last bucket.
+ */
+uint32_t no_os_trace_bucket_limit(uint32_t bucket)
+{
+	if (bucket >= NO_OS_TRACE_BUCKETS - 1)
+		return UINT32_MAX;
+
+	return NO_OS_BIT(bucket + trace.hist_shift);
+}
+
+/**
+ * @brief Export the recorded events in Chrome trace event JSON format
+ * (chrome://tracing, Perfetto). The tracing is suspended during the export.
+ * @param write - Output function, called with NULL terminated strings.
+ * @param ctx - Output function context.
+ * @return Number of exported events, negative error code otherwise.
+ */
+int no_os_trace_export(void (*write)(void *ctx, const char *str), void *ctx)
+{
+	bool enabled = trace.enabled;
+	struct no_os_trace_event *ev;
+	uint32_t first, last, i;
+	uint32_t prev = 0;
+	int64_t ts = 0;
+	int64_t min = 0;
+	uint64_t start_ns, dur_ns;
+	char str[160];
+
+	if (!write)
+		return -EINVAL;
+	if (!trace.events)
+		return -ENODEV;
+
+	trace.enabled = false;
+
+	last = trace.event_idx;
+	first = last > trace.events_mask ? last - trace.events_mask - 1 : 0;
+
+	/*
+	 * Extend the 32 bit timestamps relative to the first event. Events are
+	 * recorded at their end, so a nested one may start earlier.
+	 */
+	for (i = first; i != last; i++) {
+		ev = &trace.events[i & trace.events_mask];
+		if (i != first)
+			ts += (int32_t)(ev->start - prev);
+		prev = ev->start;
+		if (ts < min)
+			min = ts;
+	}
+
+	write(ctx, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+	for (i = first, ts = 0; i != last; i++) {
+		ev = &trace.events[i & trace.events_mask];
+		if (i != first)
+			ts += (int32_t)(ev->start - prev);
+		prev = ev->start;
+
+		start_ns = no_os_trace_ticks_to_ns(ts - min);
+		dur_ns = no_os_trace_ticks_to_ns(ev->duration);
+		snprintf(str, sizeof(str),
+			 "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":0,"
+			 "\"ts\":%" PRIu64 ".%03u,\"dur\":%" PRIu64 ".%03u}\n",
+			 i != first ? "," : "", ev->tp->name,
+			 start_ns / 1000, (unsigned int)(start_ns % 1000),
+			 dur_ns / 1000, (unsigned int)(dur_ns % 1000));
+		write(ctx, str);
+	}
+	write(ctx, "]}\n");
+
+	trace.enabled = enabled;
+
+	return last - first;
+}